@@ -0,0 +1,130 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_ANIMATIONCLIP_HPP
+#define OJOIE_ANIMATIONCLIP_HPP
+
+#include <ojoie/Asset/ImportAnimation.hpp>
+#include <ojoie/Math/Math.hpp>
+#include <ojoie/Object/NamedObject.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace AN {
+
+/// unit quaternion in 6 bytes, the largest component is dropped and rebuilt from the unit length,
+/// the others are 15 bit each, the index of the dropped one lives in the top bits of values[0] and values[1]
+struct QuantizedQuaternion {
+    UInt16 values[3];
+
+    AN_SERIALIZE_NO_IDPTR(QuantizedQuaternion)
+};
+
+template<typename Coder>
+void QuantizedQuaternion::transfer(Coder &coder) {
+    TRANSFER(values);
+}
+
+AN_API QuantizedQuaternion QuantizeQuaternion(const Quaternionf &rotation);
+AN_API Quaternionf DequantizeQuaternion(const QuantizedQuaternion &rotation);
+
+/// keys of one bone, frames are at the clip sample rate and increasing, every channel has at least one key
+struct AnimationCurve {
+    std::string path;   // name of the bone actor
+
+    std::vector<UInt16>              positionFrames;
+    std::vector<Vector3f>            positions;
+    std::vector<UInt16>              rotationFrames;
+    std::vector<QuantizedQuaternion> rotations;
+    std::vector<UInt16>              scaleFrames;
+    std::vector<Vector3f>            scales;
+
+    AN_SERIALIZE_NO_IDPTR(AnimationCurve)
+};
+
+template<typename Coder>
+void AnimationCurve::transfer(Coder &coder) {
+    TRANSFER(path);
+    TRANSFER(positionFrames);
+    TRANSFER(positions);
+    TRANSFER(rotationFrames);
+    TRANSFER(rotations);
+    TRANSFER(scaleFrames);
+    TRANSFER(scales);
+}
+
+/// a key is dropped when interpolating its neighbours stays within these errors
+struct AnimationCompressionSettings {
+    float positionError = 0.001f;    // meters
+    float rotationError = 0.5f;      // degrees
+    float scaleError    = 0.001f;
+};
+
+/// local pose of bones in structure of arrays form, each component array is padded to a multiple of 4 bones
+struct AN_API AnimationPose {
+
+    enum Component {
+        kPositionX, kPositionY, kPositionZ,
+        kRotationX, kRotationY, kRotationZ, kRotationW,
+        kScaleX, kScaleY, kScaleZ,
+        kComponentCount
+    };
+
+    UInt32             boneCount = 0;
+    UInt32             stride    = 0;
+    std::vector<float> data;
+
+    /// all bones become identity
+    void resize(UInt32 count);
+
+    float       *get(Component component) { return data.data() + component * stride; }
+    const float *get(Component component) const { return data.data() + component * stride; }
+
+    void setBone(UInt32 bone, const Vector3f &position, const Quaternionf &rotation, const Vector3f &scale);
+
+    Vector3f    getPosition(UInt32 bone) const;
+    Quaternionf getRotation(UInt32 bone) const;
+    Vector3f    getScale(UInt32 bone) const;
+};
+
+/// pose = lerp(pose, other, weight), rotations are nlerped along the shortest path, both poses have the same bones
+AN_API void BlendPoses(AnimationPose &pose, const AnimationPose &other, float weight);
+
+class AN_API AnimationClip : public NamedObject {
+
+    float  m_SampleRate;
+    UInt32 m_FrameCount;
+    std::vector<AnimationCurve> m_Curves;
+
+    AN_CLASS(AnimationClip, NamedObject)
+    AN_OBJECT_SERIALIZE(AnimationClip)
+
+public:
+
+    explicit AnimationClip(ObjectCreationMode mode);
+
+    /// compress the uniformly sampled tracks, key reduction follows the settings
+    bool initWithImportAnimation(const ImportAnimation &animation,
+                                 const AnimationCompressionSettings &settings = {});
+
+    float  getSampleRate() const { return m_SampleRate; }
+    UInt32 getFrameCount() const { return m_FrameCount; }
+
+    /// seconds between the first and the last frame
+    float getLength() const { return m_FrameCount > 1 ? (float) (m_FrameCount - 1) / m_SampleRate : 0.f; }
+
+    std::span<const AnimationCurve> getCurves() const { return m_Curves; }
+
+    /// keys of all channels after reduction
+    UInt32 getKeyCount() const;
+
+    /// sample at time (seconds, clamped to the clip) into the pose, curveToBone maps each curve to a pose bone,
+    /// curves mapped to a negative bone are skipped, bones without a curve keep their values, thread safe
+    void sample(float time, std::span<const int> curveToBone, AnimationPose &pose) const;
+};
+
+}
+
+#endif//OJOIE_ANIMATIONCLIP_HPP
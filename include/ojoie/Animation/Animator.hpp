@@ -0,0 +1,150 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_ANIMATOR_HPP
+#define OJOIE_ANIMATOR_HPP
+
+#include <ojoie/Animation/AnimationClip.hpp>
+#include <ojoie/Core/Component.hpp>
+#include <ojoie/Template/LinkedList.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace AN {
+
+class Transform;
+
+class Animator;
+typedef ListNode<Animator> AnimatorListNode;
+typedef List<AnimatorListNode> AnimatorList;
+
+/// plays clips on the transforms under its actor, curves bind to descendants by actor name,
+/// layers are blended in order over the rest pose, each layer can cross fade between two clips
+class AN_API Animator : public Component {
+
+    struct ClipState {
+        AnimationClip *clip;
+        float          time;
+    };
+
+    struct Layer {
+        ClipState current;
+        ClipState previous;     // faded out over fadeDuration
+        float     fadeElapsed;
+        float     fadeDuration;
+        float     weight;
+        float     speed;
+        bool      bLoop;
+    };
+
+    AnimatorListNode m_ListNode;
+
+    AnimationClip *m_Clip;      // played on the base layer when loaded
+    bool           m_Loop;
+
+    std::vector<Layer> m_Layers;
+
+    /// descendants, parents before children
+    std::vector<Transform *> m_Bones;
+    std::vector<int>         m_BoneParents;  // -1 for children of the actor
+    std::unordered_map<std::string_view, int> m_BoneIndices;
+    std::unordered_map<AnimationClip *, std::vector<int>> m_Bindings;
+    bool m_Bound;
+
+    /// bones some bound clip animates and the topmost of them, only those are written
+    std::vector<UInt8>  m_AnimatedMask;
+    std::vector<UInt32> m_AnimatedBones;
+    std::vector<UInt32> m_RootBones;
+
+    AnimationPose m_RestPose;
+    AnimationPose m_Pose;
+    AnimationPose m_LayerPose;
+    AnimationPose m_FadePose;
+
+    bool bAddToManager;
+
+    AN_CLASS(Animator, Component)
+    AN_OBJECT_SERIALIZE(Animator)
+
+    static void InitializeClass();
+
+    void onAddAnimator();
+
+    const std::vector<int> &getBinding(AnimationClip *clip);
+
+    void updateAnimatedBones();
+
+    void advance(ClipState &state, const Layer &layer, float deltaTime);
+
+    void sampleLayer(Layer &layer, AnimationPose &pose);
+
+public:
+
+    explicit Animator(ObjectCreationMode mode);
+
+    virtual bool initAfterDecode() override;
+
+    virtual void dealloc() override;
+
+    virtual void getResourceReferences(std::vector<Object *> &references) const override;
+
+    /// clip saved with the animator and played on the base layer when loaded
+    void setClip(AnimationClip *clip);
+    AnimationClip *getClip() const { return m_Clip; }
+
+    /// play the clip on the layer, the clip playing there fades out over fadeDuration seconds
+    void play(AnimationClip *clip, UInt32 layer = 0, float fadeDuration = 0.f);
+    void stop(UInt32 layer);
+
+    void setLayerWeight(UInt32 layer, float weight);
+    void setLayerSpeed(UInt32 layer, float speed);
+    void setLayerLoop(UInt32 layer, bool loop);
+    void setLayerTime(UInt32 layer, float time);
+
+    UInt32 getLayerCount() const { return m_Layers.size(); }
+    float getLayerTime(UInt32 layer) const { return m_Layers[layer].current.time; }
+    AnimationClip *getLayerClip(UInt32 layer) const { return m_Layers[layer].current.clip; }
+
+    /// collect the descendants again and capture their current local pose as the rest pose,
+    /// call after the hierarchy under the actor changes
+    void rebind();
+
+    bool isBound() const { return m_Bound; }
+
+    std::span<Transform *const> getBones() const { return m_Bones; }
+
+    /// pose of the last evaluate, indexed like getBones
+    const AnimationPose &getPose() const { return m_Pose; }
+
+    /// advance the layers and sample them into the pose, animators can be evaluated on worker threads,
+    /// does nothing until rebind, which touches the hierarchy and stays on the main thread
+    void evaluate(float deltaTime);
+
+    /// write the pose into the animated bones, each root of them is invalidated once
+    void applyPose();
+
+    virtual void onInspectorGUI() override;
+};
+
+class AN_API AnimationManager {
+
+    AnimatorList             m_List;
+    std::vector<Animator *> m_Animators;
+
+public:
+
+    void addAnimator(AnimatorListNode &node);
+    void removeAnimator(AnimatorListNode &node);
+
+    /// evaluate active animators on worker threads and write their poses, called once per frame after behaviors
+    void update(float deltaTime);
+
+    UInt32 getAnimatorCount() const { return m_Animators.size(); }
+};
+
+AN_API AnimationManager &GetAnimationManager();
+
+}
+
+#endif//OJOIE_ANIMATOR_HPP
@@ -5,6 +5,7 @@
 #ifndef OJOIE_AN_FBXIMPORTER_HPP
 #define OJOIE_AN_FBXIMPORTER_HPP
 
+#include <ojoie/Asset/ImportAnimation.hpp>
 #include <ojoie/Asset/ImportMesh.hpp>
 #include <ojoie/Core/Exception.hpp>
 
@@ -23,6 +24,11 @@ public:
 
     virtual std::span<const AN::ImportMesh> getImportMeshes() = 0;
 
+    /// sample every animation stack of the scene at the scene frame rate
+    virtual bool importAnimation(Error *error) = 0;
+
+    virtual std::span<const AN::ImportAnimation> getImportAnimations() = 0;
+
     virtual UInt8 *getTextureData(UInt32 id, UInt64 &size) = 0;
 
 };
@@ -49,6 +55,14 @@ public:
         return impl->getImportMeshes();
     }
 
+    bool importAnimation(Error *error) {
+        return impl->importAnimation(error);
+    }
+
+    std::span<const AN::ImportAnimation> getImportAnimations() {
+        return impl->getImportAnimations();
+    }
+
     UInt8 *getTextureData(UInt32 id, UInt64 &size) {
         return impl->getTextureData(id, size);
     }
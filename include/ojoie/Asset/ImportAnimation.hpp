@@ -0,0 +1,33 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_IMPORTANIMATION_HPP
+#define OJOIE_IMPORTANIMATION_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Math/Math.hpp>
+
+#include <string>
+#include <vector>
+
+namespace AN {
+
+/// local transform of one bone sampled at every frame of the animation
+struct ImportAnimationTrack {
+    std::string              boneName;
+    std::vector<Vector3f>    positions;
+    std::vector<Quaternionf> rotations;
+    std::vector<Vector3f>    scales;
+};
+
+struct ImportAnimation {
+    std::string name;
+    float       sampleRate = 30.f;  // frames per second
+    UInt32      frameCount = 0;
+    std::vector<ImportAnimationTrack> tracks;
+};
+
+}
+
+#endif//OJOIE_IMPORTANIMATION_HPP
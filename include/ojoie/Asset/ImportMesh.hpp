@@ -7,6 +7,7 @@
 
 #include "ojoie/Configuration/typedef.h"
 #include <ojoie/Math/Math.hpp>
+#include <ojoie/Render/RenderTypes.hpp>
 
 #include <vector>
 
@@ -21,7 +22,7 @@ struct ImportMaterial {
 };
 
 struct ImportSubMesh {
-    std::vector<UInt16> indices;
+    std::vector<UInt32> indices;
     ImportMaterial material;
 };
 
@@ -49,6 +50,9 @@ struct ImportMesh {
 
     std::vector<ImportSubMesh> subMeshes;
 
+    /// 32 bit only when the vertices do not fit 16 bit indices
+    IndexFormat indexFormat = kIndexFormatUInt16;
+
     Vector3f    localPosition;
     Quaternionf localRotation;
     Vector3f    localScale;
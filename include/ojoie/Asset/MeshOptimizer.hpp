@@ -0,0 +1,64 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_MESHOPTIMIZER_HPP
+#define OJOIE_MESHOPTIMIZER_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Asset/ImportMesh.hpp>
+#include <span>
+#include <vector>
+
+namespace AN {
+
+/// size of the simulated fifo post transform cache
+inline static constexpr UInt32 kDefaultVertexCacheSize = 16;
+
+struct VertexCacheStatistics {
+    UInt32 triangleCount;
+    UInt32 vertexCount;            // unique vertices referenced by the indices
+    UInt32 transformedVertexCount; // cache misses
+    float  acmr;                   // transformed vertices per triangle, 0.5 is the best for a regular grid, 3 the worst
+    float  atvr;                   // transformed vertices per vertex, 1 is the best
+};
+
+struct MeshOptimizationSettings {
+    bool   optimizeVertexCache = true;
+    bool   optimizeOverdraw    = true;
+    bool   optimizeVertexFetch = true;
+    UInt32 cacheSize           = kDefaultVertexCacheSize;
+    float  overdrawThreshold   = 1.05f; // acmr a cluster may lose so that it can be split into smaller ones for sorting
+};
+
+struct MeshOptimizationStats {
+    VertexCacheStatistics before;
+    VertexCacheStatistics after;
+    float                 optimizeMs;
+};
+
+/// simulate a fifo cache over triangle list indices
+AN_API VertexCacheStatistics AnalyzeVertexCache(std::span<const UInt32> indices, UInt32 cacheSize = kDefaultVertexCacheSize);
+
+/// reorder triangles for the post transform cache with tipsify,
+/// outClusters receives the first triangle of every run that restarted at a dead end
+AN_API void OptimizeVertexCache(std::span<UInt32> indices, UInt32 vertexCount,
+                                UInt32 cacheSize = kDefaultVertexCacheSize,
+                                std::vector<UInt32> *outClusters = nullptr);
+
+/// reorder clusters of cache optimized triangles so that outward facing ones come first,
+/// clusters are split further as long as each keeps an acmr within threshold of its source cluster
+AN_API void OptimizeOverdraw(std::span<UInt32> indices, std::span<const Vector3f> positions,
+                             std::span<const UInt32> clusters,
+                             UInt32 cacheSize = kDefaultVertexCacheSize, float threshold = 1.05f);
+
+/// number vertices in order of first use, unreferenced vertices go to the end,
+/// indices are rewritten and outRemap maps the old vertex to the new one
+AN_API void OptimizeVertexFetch(std::span<UInt32> indices, UInt32 vertexCount, std::vector<UInt32> &outRemap);
+
+/// optimize every sub mesh and reorder the vertex streams of an imported mesh before creating the Mesh
+AN_API MeshOptimizationStats OptimizeImportMesh(ImportMesh &mesh, const MeshOptimizationSettings &settings = {});
+
+}
+
+#endif//OJOIE_MESHOPTIMIZER_HPP
@@ -14,10 +14,16 @@
 #include <ojoie/Render/UniformBuffers.hpp>
 #include <ojoie/Template/LinkedList.hpp>
 #include <ojoie/Render/RenderTarget.hpp>
+#include <ojoie/Render/ShadowCascades.hpp>
+#include <ojoie/Render/LightClusters.hpp>
+#include <ojoie/Render/LODSelection.hpp>
+#include <ojoie/Render/OcclusionCulling.hpp>
+#include <ojoie/Render/Texture2D.hpp>
 
 namespace AN {
 
 class Camera;
+class Light;
 typedef ListNode<Camera> CameraListNode;
 typedef List<CameraListNode> CameraList;
 
@@ -31,6 +37,57 @@ class AN_API Camera final : public Component {
 
     std::unique_ptr<RenderLoop> _renderLoop;
 
+    /// renderers gathered from the list this frame, encoded in chunks on worker threads
+    std::vector<Renderer *> m_Renderers;
+    ParallelRenderEncoder   m_ForwardEncoder;
+
+    /// main light shadow cascades, casters are culled against every cascade volume
+    ShadowCascade           m_ShadowCascades[kMaxShadowCascades];
+    UInt32                  m_ShadowCascadeCount{};
+    std::vector<AABB>       m_ShadowCasterBounds;
+    std::vector<UInt32>     m_BoundedCasters;  // renderer index of every caster bounds
+    std::vector<UInt32>     m_UnboundedCasters;// renderers without bounds go to every cascade
+    std::vector<UInt32>     m_CascadeCasters[kMaxShadowCascades];
+    ParallelRenderEncoder   m_ShadowEncoders[kMaxShadowCascades];
+
+    void encodeRenderers(ParallelRenderEncoder &encoder, UInt32 frameIndex, const char *pass);
+    void encodeRenderers(ParallelRenderEncoder &encoder, std::span<const UInt32> indices, UInt32 frameIndex, const char *pass);
+
+    void updateShadowMap(const ShadowCascadeSettings &settings);
+    void cullShadowCasters(const ShadowCascadeSettings &settings, const Vector3f &lightDirection, UInt32 frameIndex);
+    void drawMainLightShadow(RenderContext &context, Light *mainLight);
+
+    /// point and spot light lists, uploaded once per frame for forward shaders
+    LightClusters m_LightClusters;
+    Texture2D    *m_ClusterLightData;
+    Texture2D    *m_ClusterLightGrid;
+    Texture2D    *m_ClusterLightIndices;
+
+    void buildLightClusters();
+
+    /// lod selection of every group seen by this camera, kept for hysteresis
+    std::vector<LODSelectionState> m_LODStates;
+
+    void selectLODs();
+
+    /// cpu occlusion culling of forward renderers, shadow casters are not occlusion culled
+    OcclusionCulling               m_OcclusionCulling;
+    bool                           bOcclusionCulling;
+    std::vector<OccluderCandidate> m_OccluderCandidates;
+    std::vector<UInt32>            m_OccluderRenderers; // renderer index of every candidate
+    std::vector<UInt32>            m_SelectedOccluders;
+    std::vector<OccluderMesh>      m_Occluders;
+    std::vector<std::vector<Vector3f>> m_DecodedOccluderVertices; // positions of compressed occluder meshes
+    std::vector<AABB>              m_OccludeeBounds;
+    std::vector<UInt32>            m_OccludeeRenderers;
+    std::vector<OcclusionResult>   m_OcclusionResults;
+    std::vector<UInt32>            m_VisibleRenderers;  // renderers drawn in the forward pass
+
+    void cullRenderers(UInt32 frameIndex);
+
+    /// visible renderers ask the texture streamer for the mips they need at this frame size
+    void requestTextureMips(UInt32 frameIndex, float frameHeight);
+
     float _fovyDegree{ 60.f }, _nearZ{ 0.03f }, _farZ{ 10000.f };
     float viewportRatio{ 1.f };
 
@@ -73,6 +130,24 @@ public:
 
     RenderTarget *getShadowMap() const { return m_ShadowMap; }
 
+    UInt32 getShadowCascadeCount() const { return m_ShadowCascadeCount; }
+    const ShadowCascade &getShadowCascade(UInt32 index) const { return m_ShadowCascades[index]; }
+
+    /// casters drawn into the cascade last frame
+    UInt32 getShadowCasterCount(UInt32 cascade) const { return m_CascadeCasters[cascade].size(); }
+
+    const LightClusters &getLightClusters() const { return m_LightClusters; }
+
+    std::span<const LODSelectionState> getLODSelectionStates() const { return m_LODStates; }
+
+    bool isOcclusionCulling() const { return bOcclusionCulling; }
+    void setOcclusionCulling(bool enable) { bOcclusionCulling = enable; }
+
+    OcclusionCulling &getOcclusionCulling() { return m_OcclusionCulling; }
+
+    /// culled counts and stage timings of the last frame
+    const OcclusionCullingStats &getOcclusionCullingStats() const { return m_OcclusionCulling.getStats(); }
+
     void drawSkyBox(RenderContext &renderContext);
 
     /// this method will VP matrix
@@ -88,6 +88,17 @@ public:
     void setLocalPosition(const Vector3f &localPosition);
     void setLocalEulerAngles(const Vector3f &angles);
 
+    /// set the local pose without invalidating the hierarchy, for writing many transforms at once,
+    /// call notifyLocalPoseChanged on the topmost written transforms afterwards
+    void setLocalPoseNoNotify(const Vector3f &position, const Quaternionf &rotation, const Vector3f &scale) {
+        _localPosition = position;
+        _localRotation = rotation;
+        _localScale    = scale;
+    }
+
+    /// invalidate this transform and its children once after setLocalPoseNoNotify
+    void notifyLocalPoseChanged() { sendTransformMessage(kPositionChanged | kRotationChanged | kScaleChanged); }
+
     void setRotation(const Quaternionf &localRotation);
     void setPosition(const Vector3f &localPosition);
     void setWorldRotationAndScale(const Matrix3x3f &worldRotationAndScale);
@@ -0,0 +1,39 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_MESHPROCESSING_HPP
+#define OJOIE_MESHPROCESSING_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Math/Math.hpp>
+#include <ojoie/Math/AABB.hpp>
+#include <ojoie/Render/VertexBuffer.hpp>
+#include <ojoie/Template/StrideIterator.hpp>
+
+namespace AN {
+
+/// bounds of count positions, empty when count is 0
+AN_API AABB CalculateBounds(StrideIterator<Vector3f> vertices, size_t count);
+
+/// area weighted vertex normals, vertices at the same position are smoothed together so uv seams do not show,
+/// a face only contributes to a corner when it is within smoothingAngle degrees of the corner's face,
+/// 0 gives flat normals on meshes whose faces do not share vertices
+AN_API void CalculateNormals(StrideIterator<Vector3f> vertices, size_t vertexCount, const IndexBufferData &indices,
+                             StrideIterator<Vector3f> outNormals, float smoothingAngle = 180.f);
+
+/// mikktspace style tangents, per face tangents are projected onto the vertex normal and weighted by the corner angle,
+/// w is the bitangent sign so that bitangent = w * cross(normal, tangent),
+/// vertices are not split, a vertex shared by mirrored faces takes the side with the larger weight
+AN_API void CalculateTangents(StrideIterator<Vector3f> vertices, StrideIterator<Vector3f> normals,
+                              StrideIterator<Vector2f> uvs, size_t vertexCount, const IndexBufferData &indices,
+                              StrideIterator<Vector4f> outTangents);
+
+/// world area covered by one unit of uv area over all triangles, texture streaming derives the needed mip from it,
+/// 0 when the uvs are degenerate
+AN_API float CalculateUVDistributionMetric(StrideIterator<Vector3f> vertices, StrideIterator<Vector2f> uvs,
+                                           const IndexBufferData &indices);
+
+}
+
+#endif//OJOIE_MESHPROCESSING_HPP
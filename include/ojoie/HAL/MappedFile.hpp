@@ -0,0 +1,49 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_MAPPEDFILE_HPP
+#define OJOIE_MAPPEDFILE_HPP
+
+#include <ojoie/Configuration/platform.h>
+#include <ojoie/Configuration/typedef.h>
+
+#ifdef AN_WIN
+typedef void *HANDLE;
+#endif
+
+namespace AN {
+
+/// a whole file mapped read only, pages are read from disk when first touched
+class AN_API MappedFile {
+
+#ifdef AN_WIN
+    HANDLE _fileHandle;
+    HANDLE _mappingHandle;
+#else
+    int _fd;
+#endif
+    const UInt8 *_data;
+    size_t       _size;
+
+public:
+
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator = (const MappedFile &) = delete;
+
+    bool Open(const char *path);
+    void Close();
+
+    bool IsOpen() const { return _data != nullptr; }
+
+    /// valid until Close
+    const UInt8 *GetData() const { return _data; }
+    size_t GetSize() const { return _size; }
+};
+
+}// namespace AN
+
+#endif//OJOIE_MAPPEDFILE_HPP
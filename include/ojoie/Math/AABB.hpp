@@ -0,0 +1,134 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_AABB_HPP
+#define OJOIE_AABB_HPP
+
+#include <ojoie/Math/Math.hpp>
+#include <limits>
+
+namespace AN {
+
+/// axis aligned bounding box stored as center and half extent
+struct AABB {
+    Vector3f center;
+    Vector3f extent;
+
+    AABB() : center(0.f), extent(0.f) {}
+    AABB(const Vector3f &center, const Vector3f &extent) : center(center), extent(extent) {}
+
+    static AABB FromMinMax(const Vector3f &min, const Vector3f &max) {
+        return { (max + min) * 0.5f, (max - min) * 0.5f };
+    }
+
+    /// an empty box, encapsulate anything will make it valid
+    static AABB Empty() {
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        return { Vector3f(0.f), Vector3f(-inf) };
+    }
+
+    Vector3f getMin() const { return center - extent; }
+    Vector3f getMax() const { return center + extent; }
+
+    bool isEmpty() const { return extent.x < 0.f || extent.y < 0.f || extent.z < 0.f; }
+
+    void encapsulate(const Vector3f &point) {
+        if (isEmpty()) {
+            center = point;
+            extent = Vector3f(0.f);
+            return;
+        }
+        *this = FromMinMax(Math::min(getMin(), point), Math::max(getMax(), point));
+    }
+
+    void encapsulate(const AABB &other) {
+        if (other.isEmpty()) return;
+        if (isEmpty()) {
+            *this = other;
+            return;
+        }
+        *this = FromMinMax(Math::min(getMin(), other.getMin()), Math::max(getMax(), other.getMax()));
+    }
+
+    bool contains(const Vector3f &point) const {
+        Vector3f d = Math::abs(point - center);
+        return d.x <= extent.x && d.y <= extent.y && d.z <= extent.z;
+    }
+
+    bool operator == (const AABB &) const = default;
+};
+
+/// transform the box and return the box bounding the result
+inline AABB TransformAABB(const AABB &aabb, const Matrix4x4f &matrix) {
+    Vector3f center = matrix * Vector4f(aabb.center, 1.f);
+    Vector3f extent;
+    for (int row = 0; row < 3; ++row) {
+        extent[row] = std::abs(matrix[0][row]) * aabb.extent.x +
+                      std::abs(matrix[1][row]) * aabb.extent.y +
+                      std::abs(matrix[2][row]) * aabb.extent.z;
+    }
+    return { center, extent };
+}
+
+namespace Math {
+
+/// plane with dot(normal, p) + distance >= 0 on the positive side,
+/// in Math so it does not clash with the plane mesh geometry AN::Plane
+struct Plane {
+    Vector3f normal;
+    float    distance;
+
+    Plane() : normal(0.f, 1.f, 0.f), distance() {}
+    Plane(const Vector3f &normal, float distance) : normal(normal), distance(distance) {}
+
+    float getDistanceToPoint(const Vector3f &point) const { return Math::dot(normal, point) + distance; }
+
+    void normalize() {
+        float invLength = 1.f / Math::length(normal);
+        normal *= invLength;
+        distance *= invLength;
+    }
+};
+
+}
+
+enum FrustumPlane {
+    kPlaneFrustumLeft = 0,
+    kPlaneFrustumRight,
+    kPlaneFrustumBottom,
+    kPlaneFrustumTop,
+    kPlaneFrustumNear,
+    kPlaneFrustumFar,
+    kPlaneFrustumNum
+};
+
+/// extract the 6 frustum planes facing inside from a view projection matrix with 0 ~ 1 clip depth
+inline void ExtractProjectionPlanes(const Matrix4x4f &viewProj, Math::Plane *outPlanes) {
+    auto row = [&viewProj](int i) {
+        return Vector4f(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+    };
+
+    Vector4f r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+    Vector4f planes[kPlaneFrustumNum] = { r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2 };
+
+    for (int i = 0; i < kPlaneFrustumNum; ++i) {
+        outPlanes[i] = Math::Plane(Vector3f(planes[i]), planes[i].w);
+        outPlanes[i].normalize();
+    }
+}
+
+/// return false only if the box is fully on the negative side of any plane
+inline bool IntersectAABBPlaneBounds(const AABB &aabb, const Math::Plane *planes, int planeCount) {
+    for (int i = 0; i < planeCount; ++i) {
+        const Math::Plane &plane = planes[i];
+        float dist   = plane.getDistanceToPoint(aabb.center);
+        float radius = Math::dot(Math::abs(plane.normal), aabb.extent);
+        if (dist + radius < 0.f) return false;
+    }
+    return true;
+}
+
+}
+
+#endif//OJOIE_AABB_HPP
@@ -12,66 +12,92 @@
 
 namespace AN {
 
+/// values live in the list nodes, touching an entry splices its node to the front without copying the value
 template<typename K, typename V>
 class LRUCache {
 
-    std::list<K> items;
-    std::unordered_map<K, std::pair<V, typename std::list<K>::iterator>> keyValuesMap;
+    typedef std::list<std::pair<const K, V>> ItemList;
+
+    ItemList items; // most recently used first
+    std::unordered_map<K, typename ItemList::iterator> keyValuesMap;
 
 public:
 
     constexpr LRUCache() = default;
 
-    void set(const K &key, const V &value) {
+    /// the list iterators in the map do not survive a copy
+    LRUCache(const LRUCache &) = delete;
+    LRUCache &operator = (const LRUCache &) = delete;
+
+    LRUCache(LRUCache &&) = default;
+    LRUCache &operator = (LRUCache &&) = default;
+
+    void set(const K &key, V value) {
         auto pos = keyValuesMap.find(key);
         if (pos == keyValuesMap.end()) {
-            items.push_front(key);
-            keyValuesMap[key] = { value, items.begin() };
+            items.emplace_front(key, std::move(value));
+            keyValuesMap.emplace(key, items.begin());
         } else {
-            items.erase(pos->second.second);
-            items.push_front(key);
-            keyValuesMap[key] = { value, items.begin() };
+            pos->second->second = std::move(value);
+            items.splice(items.begin(), items, pos->second);
         }
     }
 
-    bool get(const K &key, V &value) {
+    /// the value of key made the most recently used, nullptr if absent
+    V *find(const K &key) {
         auto pos = keyValuesMap.find(key);
         if (pos == keyValuesMap.end())
+            return nullptr;
+        items.splice(items.begin(), items, pos->second);
+        return &pos->second->second;
+    }
+
+    /// the value of key without changing the order
+    const V *peek(const K &key) const {
+        auto pos = keyValuesMap.find(key);
+        return pos == keyValuesMap.end() ? nullptr : &pos->second->second;
+    }
+
+    bool get(const K &key, V &value) {
+        V *found = find(key);
+        if (found == nullptr)
             return false;
-        items.erase(pos->second.second);
-        items.push_front(key);
-        keyValuesMap[key] = { pos->second.first, items.begin() };
-        value = pos->second.first;
+        value = *found;
         return true;
     }
 
+    bool contains(const K &key) const { return keyValuesMap.contains(key); }
+
+    /// least recently used entry, nullptr if empty
+    const std::pair<const K, V> *leastRecent() const {
+        return items.empty() ? nullptr : &items.back();
+    }
+
     void clear() {
         items.clear();
         keyValuesMap.clear();
     }
 
-    void erase(const K &key) {
+    bool erase(const K &key) {
         auto pos = keyValuesMap.find(key);
-        if (pos != keyValuesMap.end()) {
-            items.erase(pos->second.second);
-            keyValuesMap.erase(pos);
-        }
+        if (pos == keyValuesMap.end())
+            return false;
+        items.erase(pos->second);
+        keyValuesMap.erase(pos);
+        return true;
     }
 
     size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
 
-    /// view like [k, v], unordered
+    /// view like [k, v], most recently used first order
     auto mapView() {
-        return keyValuesMap | std::views::transform([](auto &&pair) {
-                   return std::make_pair(pair.first, pair.second.first);
-               });
+        return items | std::views::all;
     }
 
     /// view like [k, v], least recently used first order
     auto mapLRUView() {
-        return items | std::views::reverse | std::views::transform([this](auto &&key) {
-                   return std::make_pair(key, keyValuesMap[key].first);
-               });
+        return items | std::views::reverse;
     }
 };
 
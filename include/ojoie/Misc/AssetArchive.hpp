@@ -0,0 +1,134 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_ASSETARCHIVE_HPP
+#define OJOIE_ASSETARCHIVE_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/HAL/MappedFile.hpp>
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AN {
+
+static constexpr UInt32 kAssetArchiveMagic     = 0x4B504E41; // "ANPK"
+static constexpr UInt32 kAssetArchiveVersion   = 1;
+static constexpr UInt32 kAssetArchiveBlockSize = 64 * 1024;
+static constexpr UInt32 kAssetArchiveAlignment = 16;
+
+/// the archive file is the header, the entry data, then the tables the header points to
+struct AssetArchiveHeader {
+    UInt32 magic;
+    UInt32 version;
+    UInt32 entryCount;
+    UInt32 slotCount;   // of the path hash table, a power of two
+    UInt32 blockSize;
+    UInt32 blockCount;
+    UInt64 entriesOffset;
+    UInt64 slotsOffset;
+    UInt64 blocksOffset;
+    UInt64 stringsOffset;
+    UInt64 stringsSize;
+};
+
+struct AssetArchiveEntry {
+    UInt64 pathHash;
+    UInt64 dataOffset;  // of the aligned bytes when stored uncompressed
+    UInt64 size;        // uncompressed
+    UInt32 pathOffset;
+    UInt32 pathLength;
+    UInt32 firstBlock;
+    UInt32 blockCount;  // 0 when stored uncompressed
+};
+
+/// a block of blockSize bytes of an entry compressed on its own, the last one may be shorter
+struct AssetArchiveBlock {
+    UInt64 offset;
+    UInt32 storedSize;  // the uncompressed size when compressing did not help
+    UInt32 reserved;
+};
+
+/// a packed archive mapped read only, entries are found by path through the hash table and
+/// uncompressed ones are read in place, see tools/utils/AssetPacker
+class AN_API AssetArchive {
+
+    MappedFile                _file;
+    std::string               _root;
+    std::string               _foldedRoot;
+    const AssetArchiveHeader *_header;
+    const AssetArchiveEntry  *_entries;
+    const UInt32             *_slots;   // entry index + 1, 0 is empty
+    const AssetArchiveBlock  *_blocks;
+    const char               *_strings;
+
+public:
+
+    AssetArchive();
+
+    AssetArchive(const AssetArchive &) = delete;
+    AssetArchive &operator = (const AssetArchive &) = delete;
+
+    /// entry paths are relative to rootDirectory, paths under it are found by their absolute path too
+    bool open(const char *path, std::string_view rootDirectory = {});
+    void close();
+
+    bool isOpen() const { return _header != nullptr; }
+
+    const std::string &getRootDirectory() const { return _root; }
+
+    UInt32 getEntryCount() const { return isOpen() ? _header->entryCount : 0; }
+
+    /// index of the entry at path, -1 if none, paths compare ignoring case and slash direction
+    int find(std::string_view path) const;
+
+    std::string_view getPath(int index) const;
+    UInt64 getSize(int index) const { return _entries[index].size; }
+    bool isCompressed(int index) const { return _entries[index].blockCount != 0; }
+
+    /// the bytes of an uncompressed entry inside the mapping, nullptr if compressed
+    const UInt8 *getData(int index) const;
+
+    /// copy or decompress the entry into getSize(index) bytes of buffer
+    bool read(int index, void *buffer) const;
+
+    bool readText(int index, std::string &text) const;
+
+    /// text points into the mapping for an uncompressed entry, else at the entry decompressed into buffer,
+    /// an in place view is valid until the archive is closed
+    bool readView(int index, std::string &buffer, std::string_view &text) const;
+};
+
+/// builds an archive file, data is compressed per block unless it barely shrinks,
+/// then it is stored aligned so readers can use it without a copy
+class AN_API AssetArchiveWriter {
+
+    struct PendingEntry {
+        std::string        path;
+        std::vector<UInt8> data;
+        bool               bCompress;
+    };
+
+    std::vector<PendingEntry>               _entries;
+    std::unordered_map<std::string, size_t> _indices; // by folded path
+    UInt32                                  _blockSize;
+    UInt32                                  _alignment;
+
+public:
+
+    explicit AssetArchiveWriter(UInt32 blockSize = kAssetArchiveBlockSize, UInt32 alignment = kAssetArchiveAlignment);
+
+    /// path is relative to the archive root, an entry with the same path is replaced
+    void add(std::string_view path, std::vector<UInt8> data, bool bCompress = true);
+
+    size_t getEntryCount() const { return _entries.size(); }
+
+    bool write(const char *path, UInt64 *outArchiveSize = nullptr) const;
+};
+
+}
+
+#endif//OJOIE_ASSETARCHIVE_HPP
@@ -0,0 +1,155 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_ASYNCRESOURCELOADER_HPP
+#define OJOIE_ASYNCRESOURCELOADER_HPP
+
+#include <ojoie/Configuration/typedef.h>
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace AN {
+
+typedef UInt32 ResourceLoadID;
+inline static constexpr ResourceLoadID kInvalidResourceLoadID = 0;
+
+enum ResourceLoadStep {
+    kResourceLoadStepMore = 0,
+    kResourceLoadStepDone,
+    kResourceLoadStepFailed
+};
+
+/// loading of one resource, read runs on the I/O thread, decode on a worker thread,
+/// finalizeStep on the thread calling AsyncResourceLoader::update
+class ResourceLoadJob {
+public:
+    virtual ~ResourceLoadJob() = default;
+
+    /// read the file, return false if it cannot be read
+    virtual bool read() = 0;
+
+    /// parse what read returned, outDependencies are paths of resources to finalize before this one
+    virtual bool decode(std::vector<std::string> &outDependencies) = 0;
+
+    /// a bounded piece of the main thread work, called until it is done or failed
+    virtual ResourceLoadStep finalizeStep() = 0;
+
+    /// [0, 1] of the finalization
+    virtual float getFinalizeProgress() const = 0;
+};
+
+/// makes the jobs, called on the thread calling update
+class ResourceLoadBackend {
+public:
+    virtual ~ResourceLoadBackend() = default;
+
+    virtual std::unique_ptr<ResourceLoadJob> createJob(const std::string &path) = 0;
+
+    /// a loaded dependency is not loaded again
+    virtual bool isLoaded(const std::string &path) = 0;
+};
+
+struct AsyncResourceLoadOptions {
+    int                        priority = 0; // greater loads first, dependencies take the priority of what needs them
+    std::function<void(float)> progress;     // called in update when the progress changes
+};
+
+/// called in update, bSucceeded is false when the resource could not be read, decoded or finalized
+typedef std::function<void(bool bSucceeded)> ResourceLoadCompletion;
+
+/// reads resources on an I/O thread, decodes them on worker threads and finalizes them in a time budget
+/// on the thread calling update, resources finalize after their dependencies
+class AN_API AsyncResourceLoader {
+
+    enum State {
+        kStateReading = 0,
+        kStateDecoding,
+        kStateWaiting,    // for dependencies
+        kStateFinalizing,
+        kStateFailed
+    };
+
+    struct Load {
+        ResourceLoadID                      id;
+        std::string                         path;
+        std::unique_ptr<ResourceLoadJob>    job;
+        int                                 priority;
+        State                               state;
+        bool                                bSucceeded;           // of read and decode, set by the threads
+        std::vector<std::string>            dependencyPaths;
+        std::vector<Load *>                 dependencies;         // not finished yet
+        std::vector<Load *>                 dependents;           // waiting for this load
+        UInt32                              pendingDependencies;
+        float                               reportedProgress;
+        std::vector<ResourceLoadCompletion> completions;
+        std::vector<std::function<void(float)>> progressCallbacks;
+    };
+
+    ResourceLoadBackend *_backend;
+    UInt32               _workerCount;
+
+    std::unordered_map<ResourceLoadID, Load *> _loads;
+    std::unordered_map<std::string, Load *>    _pathLoads;
+    std::vector<Load *>                        _resolveQueue;  // decoded, dependencies not looked up yet
+    std::vector<Load *>                        _finalizeQueue; // dependencies finalized, heap on priority
+    ResourceLoadID                             _nextID;
+
+    std::vector<std::thread> _threads;
+    mutable std::mutex       _mutex;
+    std::condition_variable  _readCondition;
+    std::condition_variable  _decodeCondition;
+    std::condition_variable  _doneCondition;
+    std::vector<Load *>      _readQueue;   // heaps on priority
+    std::vector<Load *>      _decodeQueue;
+    std::vector<Load *>      _decoded;     // read and decode finished, success or not
+    bool                     bStop;
+
+    Load *startLoad(const std::string &path, int priority);
+    bool  raisePriority(Load *load, int priority);
+    void  sortQueues();
+    bool  dependsOn(Load *load, Load *dependency) const;
+    bool  resolveDependencies(Load *load);
+    void  finish(Load *load, bool bSucceeded);
+    void  reportProgress(Load *load);
+    void  ioThread();
+    void  workerThread();
+
+public:
+
+    /// workerCount 0 uses half of the hardware threads
+    explicit AsyncResourceLoader(ResourceLoadBackend *backend, UInt32 workerCount = 0);
+    ~AsyncResourceLoader();
+
+    AsyncResourceLoader(const AsyncResourceLoader &) = delete;
+    AsyncResourceLoader &operator = (const AsyncResourceLoader &) = delete;
+
+    /// a path already loading takes one more completion and returns the same id
+    ResourceLoadID load(const char *path, const AsyncResourceLoadOptions &options, ResourceLoadCompletion completion);
+
+    /// return false if the load finished
+    bool setPriority(ResourceLoadID id, int priority);
+
+    /// [0, 1], 1 when the load finished
+    float getProgress(ResourceLoadID id) const;
+
+    /// finalize loads until budgetSeconds is spent, at least one step runs if any load is ready,
+    /// return the steps run
+    UInt32 update(float budgetSeconds);
+
+    /// finish every load
+    void flush();
+
+    UInt32 getPendingCount() const { return (UInt32) _loads.size(); }
+};
+
+}
+
+#endif//OJOIE_ASYNCRESOURCELOADER_HPP
@@ -2,37 +2,202 @@
 
 
 #include <ojoie/Object/Object.hpp>
-
+#include <ojoie/Misc/AssetArchive.hpp>
+#include <ojoie/Misc/AsyncResourceLoader.hpp>
+#include <ojoie/Misc/ResourceResidency.hpp>
+#include <ojoie/Template/FlatHashMap.hpp>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace AN {
 
+class YamlDecoder;
+
 class AN_API ResourceManager {
 
-    std::unordered_map<std::string, Object *> resourceMap;
-    std::unordered_map<std::string, Object *> resourcePathMap;
+    /// what an object is registered under, 0 if nothing
+    struct ResourceEntry {
+        UInt64 nameKey; // class id and name id
+        UInt32 pathID;
+    };
+
+    /// interned names and paths, id 0 is no name
+    std::deque<std::string>                      _names;
+    std::unordered_map<std::string_view, UInt32> _nameIDs;
+
+    FlatHashMap<UInt64, Object *>       _resources;     // by class id and name id
+    FlatHashMap<UInt32, Object *>       _pathResources; // by path id
+    FlatHashMap<int, ResourceEntry>     _entries;       // by instance id
+
+    ResourceResidency             _residency;
+    FlatHashMap<UInt32, bool>     _evictedPaths; // path ids of evicted resources, loaded again on demand
+    bool                          bReloadEvicted;
+
+    /// state the last trim that evicted nothing saw, the reference scan waits for it to change or the backoff
+    UInt64 _residencyReleaseTick;
+    UInt64 _residencyObjectsVersion;
+    UInt32 _residencyBackoff; // frames between scans while nothing changes, 0 scan every frame
+    UInt32 _residencySkipped;
+
+    static constexpr UInt32 kMaxResidencyBackoff = 64;
+
+    std::vector<std::unique_ptr<AssetArchive>> _archives; // the last mounted is searched first
+    mutable std::shared_mutex                  _archiveMutex;
+
+    std::unique_ptr<ResourceLoadBackend> _loadBackend;
+    std::unique_ptr<AsyncResourceLoader> _asyncLoader;
+
+    std::unordered_map<std::string, std::string> _uuidPathMap; // asset uuid to path, from the metas
+    std::once_flag                               _uuidPathFlag;
 
     void RegisterResource(Object *object, const char *name);
 
+    UInt32 internName(std::string_view name);
+    UInt32 findName(std::string_view name) const;
+    UInt32 findPath(const char *path) const;
+
+    static UInt64 GetNameKey(int classID, UInt32 nameID) { return (UInt64) (UInt32) classID << 32 | nameID; }
+
+    void bindName(Object *object, UInt64 nameKey);
+    void bindPath(Object *object, UInt32 pathID);
+    void removeEntry(Object *object);
+
+    /// false if the object failed to init, it is destroyed then
+    bool initLoadedObject(Object *object);
+    void registerResourceAtPath(Object *mainObject, const char *path);
+
+    /// decoder of the archived file of className named name under rootDir, nullptr if none
+    std::unique_ptr<YamlDecoder> decodeArchivedResource(const char *className, const char *name,
+                                                        std::string_view rootDir) const;
+
+    /// the resource loaded at path, an evicted one is not loaded again
+    Object *findResourceAtPath(const char *path) const;
+    void evictResource(int instanceID);
+
+    friend class SerializedAssetLoadJob;
+    friend class SerializedAssetLoadBackend;
+
 public:
 
+    ResourceManager();
+    ~ResourceManager();
+
     void loadBuiltinResources();
 
+    /// entries of a mounted archive stand in for the loose files at the same paths under rootDirectory,
+    /// the working directory by default, mount before loading so the uuid index sees the archived metas
+    bool mountArchive(const char *path, const char *rootDirectory = nullptr);
+
+    /// the file at path from the mounted archives, false if none has it, any thread may call it,
+    /// text is read in place for an uncompressed entry, else decompressed into buffer
+    bool readArchivedFile(const char *path, std::string &buffer, std::string_view &text) const;
+
+    /// the file named name is looked up in the mounted archives under searchPath first, then in the directory,
     /// if resource with specific className and name exist, this method will unload the existing resource
     Object *loadResource(const char *className, const char *name, const char *searchPath = nullptr);
 
     Object *loadResourceAtPath(const char *path);
 
+    /// load like loadResourceAtPath with reading and decoding on background threads and the rest
+    /// in updateAsyncLoads, the assets it references load first, completion gets nullptr on failure
+    ResourceLoadID loadResourceAsync(const char *path, const AsyncResourceLoadOptions &options = {},
+                                     std::function<void(Object *)> completion = {});
+
+    /// [0, 1], 1 when the load finished
+    float getResourceLoadProgress(ResourceLoadID id) const;
+
+    bool setResourceLoadPriority(ResourceLoadID id, int priority);
+
+    /// finalize async loads for about budgetSeconds, the game calls it each frame
+    void updateAsyncLoads(float budgetSeconds);
+
+    /// finish every async load
+    void flushAsyncLoads();
+
+    /// path of the asset with the uuid among the metas of Data/Assets, empty if none, any thread may call it
+    std::string getPathOfUUID(const std::string &uuid);
+
     void resetResourcePath(Object *object, const char *path);
 
+    /// path the object was loaded from or saved to, empty if none
+    std::string getResourcePath(Object *object);
+
     Object* getResource(const char *className, const char *name);
 
+    Object *getResource(int classID, const char *name);
+
+    template<typename T>
+    T *getResource(const char *name) {
+        return (T *) getResource(T::GetClassIDStatic(), name);
+    }
+
     Object *getResourceAtPath(const char *path);
 
     void unloadResource(Object *asset);
 
+    /// resources loaded from assets that no handle or live object references are unloaded once their class or all
+    /// of them use more bytes than the budget, least recently released first, 0 is no budget, the default
+    void setResidencyBudget(size_t bytes);
+    void setResidencyBudget(int classID, size_t bytes);
+
+    /// getResourceAtPath loads an evicted resource again, default true
+    void setReloadEvicted(bool reload) { bReloadEvicted = reload; }
+
+    /// a strong reference keeps a resource loaded from an asset resident, see ResourceHandle
+    void retainResource(Object *object);
+    void releaseResource(Object *object);
+
+    /// evict over the budgets, the game calls it each frame so a resource loaded this frame can be retained first,
+    /// resources live objects reference are kept, see Object::getResourceReferences
+    void updateResidency();
+
+    const ResourceMemoryStats &getMemoryStats() const { return _residency.getStats(); }
+    ResourceMemoryStats getMemoryStats(int classID) const { return _residency.getStats(classID); }
+
 };
 
 AN_API ResourceManager &GetResourceManager();
 
+/// a strong reference to a resource, it stays resident while any handle holds it
+template<typename T>
+class ResourceHandle {
+
+    T *_object;
+
+public:
+
+    ResourceHandle() : _object() {}
+
+    explicit ResourceHandle(T *object) : _object(object) {
+        if (_object) GetResourceManager().retainResource(_object);
+    }
+
+    ResourceHandle(const ResourceHandle &other) : ResourceHandle(other._object) {}
+
+    ResourceHandle(ResourceHandle &&other) noexcept : _object(other._object) { other._object = nullptr; }
+
+    ResourceHandle &operator = (ResourceHandle other) noexcept {
+        std::swap(_object, other._object);
+        return *this;
+    }
+
+    ~ResourceHandle() { reset(); }
+
+    void reset() {
+        if (_object) GetResourceManager().releaseResource(_object);
+        _object = nullptr;
+    }
+
+    T *get() const { return _object; }
+    T *operator -> () const { return _object; }
+    explicit operator bool () const { return _object != nullptr; }
+};
+
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_RESOURCERESIDENCY_HPP
+#define OJOIE_RESOURCERESIDENCY_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Math/LRUCache.hpp>
+#include <ojoie/Template/FlatHashMap.hpp>
+
+#include <functional>
+#include <unordered_map>
+
+namespace AN {
+
+struct ResourceMemoryStats {
+    size_t residentBytes;  // of tracked resources, referenced or not
+    size_t cachedBytes;    // of those no handle references, the ones eviction may unload
+    UInt32 residentCount;
+    UInt32 cachedCount;
+    UInt32 evictions;
+    size_t evictedBytes;
+    UInt32 reloads;        // evicted resources loaded again
+};
+
+/// counts the strong references of resources loaded from assets, keeps the unreferenced ones
+/// in least recently released order and picks which to evict once a class or the total is over budget
+class AN_API ResourceResidency {
+
+    struct Entry {
+        int    classID;
+        size_t size;
+        UInt32 refCount;
+    };
+
+    struct ClassResidency {
+        size_t                  budget = 0;
+        ResourceMemoryStats     stats{};
+        LRUCache<int, UInt64>   cached; // instance id to release tick
+    };
+
+    FlatHashMap<int, Entry>                 _entries;
+    std::unordered_map<int, ClassResidency> _classes;
+    ResourceMemoryStats                     _stats;
+    size_t                                  _budget;
+    UInt64                                  _tick;
+
+    void cache(int instanceID, Entry &entry);
+    void uncache(int instanceID, Entry &entry);
+    bool evictOne(ClassResidency *classResidency, const std::function<void(int)> &evict);
+
+public:
+
+    ResourceResidency();
+
+    /// 0 is no budget, the default
+    void setBudget(size_t bytes) { _budget = bytes; }
+    size_t getBudget() const { return _budget; }
+
+    void setClassBudget(int classID, size_t bytes) { _classes[classID].budget = bytes; }
+
+    /// start tracking a loaded resource, it is unreferenced until retained
+    void add(int instanceID, int classID, size_t size, bool bReloaded = false);
+
+    void remove(int instanceID);
+
+    bool isTracked(int instanceID) const { return _entries.contains(instanceID); }
+
+    /// false if the resource is not tracked
+    bool retain(int instanceID);
+
+    /// size is measured again when the last reference goes
+    bool release(int instanceID, size_t size);
+
+    UInt32 getRefCount(int instanceID) const;
+
+    /// advances whenever a resource becomes unreferenced
+    UInt64 getReleaseTick() const { return _tick; }
+
+    /// true if a class or the total is over its budget
+    bool isOverBudget() const;
+
+    /// unreferenced resources over the budgets, least recently released first, evict unloads each one
+    UInt32 trim(const std::function<void(int instanceID)> &evict);
+
+    const ResourceMemoryStats &getStats() const { return _stats; }
+
+    ResourceMemoryStats getStats(int classID) const;
+};
+
+}
+
+#endif//OJOIE_RESOURCERESIDENCY_HPP
@@ -55,6 +55,9 @@ public:
 
     static std::vector<Object *> FindObjectsOfType(int type);
 
+    /// changes whenever an object is created or destroyed
+    static UInt64 GetObjectsVersion();
+
     template<typename T>
     static std::vector<T *> FindObjectsOfType() {
         std::vector<Object *> results = FindObjectsOfType(T::GetClassIDStatic());
@@ -125,6 +128,12 @@ public:
     /// dealloc is called only the object is inited
     virtual void dealloc();
 
+    /// bytes the object holds in CPU and GPU memory, resource residency budgets are measured with it
+    virtual size_t getRuntimeMemorySize() const { return (size_t) isa->getSize(); }
+
+    /// objects this one points to, resources a live object references are never evicted
+    virtual void getResourceReferences(std::vector<Object *> &references) const {}
+
     /// sending unknown message will not throw but will increase performance overhead
     /// override this method for good reason
     virtual void sendMessage(Message &message);
@@ -26,6 +26,8 @@ public:
     explicit MeshCollider(ObjectCreationMode mode);
 
     void setMesh(Mesh *mesh);
+
+    virtual void getResourceReferences(std::vector<Object *> &references) const override;
     void setConvex(bool convex);
 
     virtual void onInspectorGUI() override;
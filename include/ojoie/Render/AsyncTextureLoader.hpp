@@ -0,0 +1,93 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_ASYNCTEXTURELOADER_HPP
+#define OJOIE_ASYNCTEXTURELOADER_HPP
+
+#include <ojoie/Render/TextureLoader.hpp>
+
+#include <climits>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace AN {
+
+typedef UInt32 TextureLoadID;
+inline static constexpr TextureLoadID kInvalidTextureLoadID = 0;
+
+struct AsyncTextureLoadOptions {
+    bool sRGB           = true;
+    bool bBuildMipChain = true; // filter the levels on the worker, see TextureLoader::LoadTexture
+    int  priority       = 0;    // greater loads first, equal priorities load in submission order
+};
+
+/// receives the decoded image, an invalid result when the file could not be loaded
+typedef std::function<void(LoadTextureResult &result)> TextureLoadCompletion;
+
+/// reads and decodes texture files on worker threads,
+/// completions run in update on the thread that owns the loader, the game thread for GetAsyncTextureLoader
+class AN_API AsyncTextureLoader {
+
+    struct Job {
+        TextureLoadID           id;
+        std::string             path;
+        AsyncTextureLoadOptions options;
+        TextureLoadCompletion   completion;
+        LoadTextureResult       result;
+        bool                    bCancelled;
+    };
+
+    std::vector<std::thread> _threads;
+    UInt32                   _threadCount;
+
+    mutable std::mutex      _mutex;
+    std::condition_variable _workCondition;
+    std::condition_variable _doneCondition;
+
+    std::vector<Job *>                      _queue; // heap on priority
+    std::vector<Job *>                      _completed;
+    std::unordered_map<TextureLoadID, Job *> _jobs;  // queued, decoding and completed jobs
+    TextureLoadID                           _nextID;
+    UInt32                                  _decoding;
+    bool                                    bStop;
+
+    void workerThread();
+
+public:
+
+    /// threadCount 0 uses half of the hardware threads
+    explicit AsyncTextureLoader(UInt32 threadCount = 0);
+    ~AsyncTextureLoader();
+
+    AsyncTextureLoader(const AsyncTextureLoader &) = delete;
+    AsyncTextureLoader &operator = (const AsyncTextureLoader &) = delete;
+
+    TextureLoadID load(const char *path, const AsyncTextureLoadOptions &options, TextureLoadCompletion completion);
+
+    /// the completion will not run, return false if it already ran
+    bool cancel(TextureLoadID id);
+
+    /// reorder a load that has not started, return false if it started
+    bool setPriority(TextureLoadID id, int priority);
+
+    /// run the completions of finished loads, at most maxCount, return how many ran
+    UInt32 update(UInt32 maxCount = UINT_MAX);
+
+    /// wait for every submitted load and run the completions
+    void flush();
+
+    /// loads whose completion has not run yet
+    UInt32 getPendingCount() const;
+};
+
+AN_API AsyncTextureLoader &GetAsyncTextureLoader();
+
+}
+
+#endif//OJOIE_ASYNCTEXTURELOADER_HPP
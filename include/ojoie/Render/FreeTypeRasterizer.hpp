@@ -0,0 +1,56 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_FREETYPERASTERIZER_HPP
+#define OJOIE_FREETYPERASTERIZER_HPP
+
+#include <ojoie/Render/GlyphCache.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AN {
+
+/// rasterizes glyphs of font files with FreeType, faces are pooled so that every worker thread owns the one it uses
+class AN_API FreeTypeRasterizer : public GlyphRasterizer {
+
+    struct FontData {
+        std::string         name;
+        std::vector<UInt8>  file;  // faces read from it as long as they live
+        std::vector<void *> faces; // idle FT_Face
+    };
+
+    void                                   *_library; // FT_Library
+    UInt32                                  _sdfSpread;
+    std::mutex                              _mutex;
+    std::vector<std::unique_ptr<FontData>>  _fonts;
+
+    void *acquireFace(FontID font);
+    void  releaseFace(FontID font, void *face);
+
+public:
+
+    /// sdfSpread is the distance in pixels encoded on each side of the edge of SDF glyphs
+    explicit FreeTypeRasterizer(UInt32 sdfSpread = 6);
+    virtual ~FreeTypeRasterizer() override;
+
+    /// kInvalidFontID if FreeType cannot read the file
+    FontID loadFont(const char *path);
+
+    const char *getFontName(FontID font);
+
+    UInt32 getSDFSpread() const { return _sdfSpread; }
+
+    virtual bool rasterize(FontID font, UInt32 codepoint, UInt32 pixelSize, bool bSDF, GlyphBitmap &outBitmap) override;
+
+    virtual FontLineMetrics getLineMetrics(FontID font, UInt32 pixelSize) override;
+
+    virtual float getKerning(FontID font, UInt32 left, UInt32 right, UInt32 pixelSize) override;
+};
+
+}
+
+#endif//OJOIE_FREETYPERASTERIZER_HPP
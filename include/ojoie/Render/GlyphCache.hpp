@@ -0,0 +1,195 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_GLYPHCACHE_HPP
+#define OJOIE_GLYPHCACHE_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Render/SkylinePacker.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace AN {
+
+typedef UInt32 FontID;
+inline static constexpr FontID kInvalidFontID = 0xFFFFFFFF;
+
+struct GlyphMetrics {
+    float  advance;  // pixels to the next pen position
+    Int16  bearingX; // bitmap left of the pen
+    Int16  bearingY; // bitmap top above the baseline
+    UInt16 width, height;
+};
+
+struct FontLineMetrics {
+    float ascender;  // above the baseline
+    float descender; // below the baseline, negative
+    float lineHeight;
+};
+
+/// R8 coverage, or distance for SDF glyphs where 128 is the edge and greater is inside
+struct GlyphBitmap {
+    GlyphMetrics       metrics;
+    std::vector<UInt8> pixels; // width * height
+};
+
+/// turns glyphs of loaded fonts into bitmaps, see FreeTypeRasterizer
+class GlyphRasterizer {
+public:
+    virtual ~GlyphRasterizer() = default;
+
+    /// called on the glyph cache threads at once, return false if the font has no glyph for codepoint
+    virtual bool rasterize(FontID font, UInt32 codepoint, UInt32 pixelSize, bool bSDF, GlyphBitmap &outBitmap) = 0;
+
+    virtual FontLineMetrics getLineMetrics(FontID font, UInt32 pixelSize) = 0;
+
+    /// pen adjustment in pixels between two codepoints
+    virtual float getKerning(FontID font, UInt32 left, UInt32 right, UInt32 pixelSize) { return 0.f; }
+};
+
+struct GlyphKey {
+    FontID font;
+    UInt32 codepoint;
+    UInt16 pixelSize;
+    bool   bSDF;
+
+    bool operator == (const GlyphKey &other) const {
+        return font == other.font && codepoint == other.codepoint && pixelSize == other.pixelSize && bSDF == other.bSDF;
+    }
+};
+
+struct GlyphKeyHash {
+    size_t operator () (const GlyphKey &key) const {
+        UInt64 value = ((UInt64) key.font << 40) ^ ((UInt64) key.pixelSize << 24) ^ ((UInt64) key.bSDF << 23) ^ key.codepoint;
+        return std::hash<UInt64>()(value * 0x9E3779B97F4A7C15ULL);
+    }
+};
+
+inline static constexpr UInt32 kNoGlyphPage = 0xFFFFFFFF;
+
+struct CachedGlyph {
+    GlyphMetrics metrics; // at the rasterized size, SDF glyphs scale by GlyphCache::getScale
+    UInt32       page;    // kNoGlyphPage for glyphs without pixels like spaces
+    UInt16       x, y;    // bitmap in the page
+};
+
+enum GlyphStatus {
+    kGlyphReady = 0,
+    kGlyphPending, // queued for rasterization or waiting for page space
+    kGlyphMissing  // the font has no such glyph
+};
+
+struct GlyphCacheSettings {
+    UInt32 pageSize     = 1024;
+    UInt32 maxPages     = 4;
+    UInt32 padding      = 1;  // empty pixels between glyphs so filtering does not bleed
+    UInt32 sdfPixelSize = 48; // SDF glyphs rasterize once at this size and scale to any size
+    UInt32 threadCount  = 0;  // 0 uses half of the hardware threads
+};
+
+struct GlyphAtlasPage {
+    std::vector<UInt8> pixels;        // R8, pageSize * pageSize
+    SkylinePacker      packer;
+    UInt32             generation;    // bumped on eviction, glyphs cached from the page before are gone
+    UInt32             lastUsedFrame;
+    bool               bDirty;        // pixels changed since the last clearDirty
+};
+
+struct GlyphCacheStats {
+    UInt32 glyphCount;    // resident
+    UInt32 rasterized;    // totals since the cache started
+    UInt32 evictedPages;
+    UInt32 evictedGlyphs;
+};
+
+/// glyphs rasterized on demand on worker threads and packed into R8 atlas pages,
+/// when the pages are full the least recently used page is cleared, pages used this or the last frame are kept,
+/// not thread safe but for the rasterization, use it from one thread
+class AN_API GlyphCache {
+
+    struct Entry {
+        CachedGlyph glyph;
+        GlyphStatus status;
+    };
+
+    struct Job {
+        GlyphKey    key;
+        GlyphBitmap bitmap;
+        bool        bSucceeded;
+    };
+
+    GlyphRasterizer   *_rasterizer;
+    GlyphCacheSettings _settings;
+    GlyphCacheStats    _stats;
+    UInt32             _frame;
+
+    std::unordered_map<GlyphKey, Entry, GlyphKeyHash> _glyphs;
+    std::vector<GlyphAtlasPage>                       _pages;
+    std::vector<Job *>                                _deferred; // rasterized but no page could take them
+
+    std::vector<std::thread> _threads;
+    UInt32                   _threadCount;
+    std::mutex               _mutex;
+    std::condition_variable  _workCondition;
+    std::condition_variable  _doneCondition;
+    std::deque<Job *>        _queue;
+    std::vector<Job *>       _completed;
+    UInt32                   _rasterizing;
+    bool                     bStop;
+
+    GlyphKey normalizeKey(const GlyphKey &key) const;
+    void     placeCompleted();
+    bool     place(Job *job);
+    UInt32   evictPage();
+    void     workerThread();
+
+public:
+
+    explicit GlyphCache(GlyphRasterizer *rasterizer, const GlyphCacheSettings &settings = {});
+    ~GlyphCache();
+
+    GlyphCache(const GlyphCache &) = delete;
+    GlyphCache &operator = (const GlyphCache &) = delete;
+
+    /// outGlyph is set when ready, a glyph not seen before is queued and pending until an update places it,
+    /// marks the glyph and its page used this frame
+    GlyphStatus getGlyph(const GlyphKey &key, const CachedGlyph *&outGlyph);
+
+    /// metrics of SDF glyphs are at sdfPixelSize, multiply them by this to get the key pixel size
+    float getScale(const GlyphKey &key) const {
+        return key.bSDF ? (float) key.pixelSize / (float) _settings.sdfPixelSize : 1.f;
+    }
+
+    /// place the rasterized glyphs into pages, once a frame
+    void update(UInt32 frameIndex);
+
+    /// wait for every queued glyph and place it
+    void flush();
+
+    /// drop all glyphs and pages
+    void clear();
+
+    UInt32 getPageCount() const { return (UInt32) _pages.size(); }
+    const GlyphAtlasPage &getPage(UInt32 index) const { return _pages[index]; }
+    void clearDirty(UInt32 index) { _pages[index].bDirty = false; }
+
+    /// mark a page used this frame, for glyphs drawn from a layout made in an earlier frame
+    void touchPage(UInt32 index) { _pages[index].lastUsedFrame = _frame; }
+
+    /// packed area over the area of all pages
+    float getOccupancy() const;
+
+    GlyphRasterizer *getRasterizer() const { return _rasterizer; }
+    const GlyphCacheSettings &getSettings() const { return _settings; }
+    const GlyphCacheStats &getStats() const { return _stats; }
+};
+
+}
+
+#endif//OJOIE_GLYPHCACHE_HPP
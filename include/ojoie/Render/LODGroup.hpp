@@ -0,0 +1,116 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_LODGROUP_HPP
+#define OJOIE_LODGROUP_HPP
+
+#include <ojoie/Core/Component.hpp>
+#include <ojoie/Render/LODSelection.hpp>
+#include <ojoie/Render/Renderer.hpp>
+#include <ojoie/Template/LinkedList.hpp>
+#include <span>
+#include <vector>
+
+namespace AN {
+
+/// one detail level, drawn while the group's screen relative height is above the threshold
+struct LOD {
+    float                   screenRelativeHeight;
+    std::vector<Renderer *> renderers;
+
+    AN_SERIALIZE(LOD)
+};
+
+template<typename Coder>
+void LOD::transfer(Coder &coder) {
+    TRANSFER(screenRelativeHeight);
+    TRANSFER(renderers);
+}
+
+class LODGroup;
+typedef ListNode<LODGroup> LODGroupListNode;
+typedef List<LODGroupListNode> LODGroupList;
+
+class AN_API LODGroup : public Component {
+
+    LODGroupListNode m_ListNode;
+
+    Vector3f m_LocalReferencePoint;
+    float    m_Size;                // local size of the group, scaled by the largest transform axis
+    float    m_FadeTransitionWidth; // 0 disable cross fade
+    std::vector<LOD> m_LODs;        // finest level first
+
+    bool bAddToManager;
+
+    AN_CLASS(LODGroup, Component)
+    AN_OBJECT_SERIALIZE(LODGroup)
+
+    static void InitializeClass();
+
+    void onAddLODGroup();
+
+    /// reset renderers of all levels to always visible
+    void resetRenderers();
+
+    /// link renderers of all levels back to this group so they can leave it when destroyed
+    void registerRenderers();
+    void unregisterRenderers();
+
+public:
+
+    explicit LODGroup(ObjectCreationMode mode);
+
+    virtual void dealloc() override;
+
+    /// at most kMaxLODLevels levels are used, thresholds should be decreasing
+    void setLODs(std::span<const LOD> lods);
+    std::span<const LOD> getLODs() const { return m_LODs; }
+
+    /// drop renderer from all levels, called when the renderer is destroyed
+    void removeRenderer(Renderer *renderer);
+
+    UInt32 getLODCount() const { return m_LODs.size(); }
+
+    const Vector3f &getLocalReferencePoint() const { return m_LocalReferencePoint; }
+    void setLocalReferencePoint(const Vector3f &point) { m_LocalReferencePoint = point; }
+
+    float getSize() const { return m_Size; }
+    void setSize(float size) { m_Size = size; }
+
+    float getFadeTransitionWidth() const { return m_FadeTransitionWidth; }
+    void setFadeTransitionWidth(float width) { m_FadeTransitionWidth = width; }
+
+    LODGroupData getLODGroupData() const;
+
+    /// show renderers of the selected levels and hide others
+    void applySelection(const LODSelectionState &state);
+
+    virtual void onInspectorGUI() override;
+};
+
+class AN_API LODGroupManager {
+
+    LODGroupList              m_List;
+    std::vector<LODGroup *>   m_Groups;
+    std::vector<LODGroupData> m_GroupData;
+
+public:
+
+    void addLODGroup(LODGroupListNode &node);
+    void removeLODGroup(LODGroupListNode &node);
+
+    /// gather world space data of all groups, called once per frame before cameras draw
+    void update();
+
+    /// select levels for one camera and apply them to renderers, states are owned by the camera
+    void selectLODs(const LODSelectionParams &params, std::vector<LODSelectionState> &states);
+
+    UInt32 getLODGroupCount() const { return m_Groups.size(); }
+};
+
+AN_API LODGroupManager &GetLODGroupManager();
+
+}
+
+#endif//OJOIE_LODGROUP_HPP
@@ -0,0 +1,55 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_LODSELECTION_HPP
+#define OJOIE_LODSELECTION_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Math/Math.hpp>
+#include <span>
+
+namespace AN {
+
+enum {
+    kMaxLODLevels = 8,
+    kLODCulled    = 0xFF // no level is drawn
+};
+
+struct LODSelectionParams {
+    Vector3f cameraPosition;
+    float    screenHeightScale; // 1 / (2 * tan(fovy / 2)), relative height is size / distance * scale
+    float    lodBias;           // relative height is multiplied by bias, greater prefers more detail
+    UInt32   maxLOD;            // finest level allowed
+    float    hysteresis;        // fraction a height must cross a threshold by before switching back
+};
+
+/// one lod group in world space
+struct LODGroupData {
+    Vector3f worldCenter;
+    float    worldSize;
+    UInt32   groupID;
+    UInt32   lodCount;
+    float    screenRelativeHeights[kMaxLODLevels]; // decreasing, lowest relative height a level is used at
+    float    fadeTransitionWidth;                  // fraction of a level band used to cross fade, 0 disable
+};
+
+/// per camera selection of one group, kept between frames for hysteresis
+struct LODSelectionState {
+    UInt32 groupID;       // state is reset when it does not match the group
+    UInt8  lod;           // selected level, kLODCulled if none
+    UInt8  fadeLOD;       // coarser level cross faded in, kLODCulled if none
+    float  fade;          // weight of lod, fadeLOD uses 1 - fade
+    float  relativeHeight;
+};
+
+AN_API float ComputeLODRelativeHeight(const LODSelectionParams &params, const LODGroupData &group);
+
+/// select levels of all groups, states must have the same count as groups, large batches run on worker threads
+AN_API void SelectLODs(const LODSelectionParams &params,
+                       std::span<const LODGroupData> groups,
+                       std::span<LODSelectionState> states);
+
+}
+
+#endif//OJOIE_LODSELECTION_HPP
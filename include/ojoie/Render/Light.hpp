@@ -7,13 +7,17 @@
 #include <ojoie/Core/Component.hpp>
 #include <ojoie/Template/LinkedList.hpp>
 #include <ojoie/Math/Math.hpp>
+#include <ojoie/Render/LightClusters.hpp>
+#include <span>
+#include <vector>
 
 namespace AN {
 
 
 enum LightType {
     kLightDirectional,
-    kLightPoint
+    kLightPoint,
+    kLightSpot
 };
 
 class Light;
@@ -27,6 +31,9 @@ class AN_API Light : public Component {
     Vector4f m_Color;
     float m_DepthBias;
     float m_NormalBias;
+    float m_Range;
+    float m_SpotAngle;      // full outer angle in degrees
+    float m_InnerSpotAngle; // full inner angle in degrees
 
     bool bAddToManager;
 
@@ -52,11 +59,24 @@ public:
     float getNormalBias() const { return m_NormalBias; }
     void setNormalBias(float mNormalBias) { m_NormalBias = mNormalBias; }
 
+    float getRange() const { return m_Range; }
+    void setRange(float range) { m_Range = range; }
+
+    float getSpotAngle() const { return m_SpotAngle; }
+    void setSpotAngle(float angle) { m_SpotAngle = angle; }
+
+    float getInnerSpotAngle() const { return m_InnerSpotAngle; }
+    void setInnerSpotAngle(float angle) { m_InnerSpotAngle = angle; }
+
+    /// point and spot light data used by light clusters
+    LocalLightData getLocalLightData() const;
+
     virtual void onInspectorGUI() override;
 };
 
 class AN_API LightManager {
     LightList m_List;
+    std::vector<LocalLightData> m_LocalLights;
 public:
 
     LightManager();
@@ -68,6 +88,9 @@ public:
 
     Light *getMainLight();
 
+    /// point and spot lights gathered in update
+    std::span<const LocalLightData> getLocalLights() const { return m_LocalLights; }
+
 };
 
 AN_API LightManager &GetLightManager();
@@ -0,0 +1,122 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_LIGHTCLUSTERS_HPP
+#define OJOIE_LIGHTCLUSTERS_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Math/Math.hpp>
+#include <span>
+#include <vector>
+
+namespace AN {
+
+/// packed cluster entry is offset << kLightClusterCountBits | count
+enum {
+    kLightClusterCountBits     = 8,
+    kLightClusterMaxLights     = (1 << kLightClusterCountBits) - 1,
+    kLightClusterIndexRowWidth = 4096 // width of the index texture
+};
+
+struct LightClusterSettings {
+    UInt32 tilesX              = 16;
+    UInt32 tilesY              = 9;
+    UInt32 slices              = 24;  // exponential depth slices
+    UInt32 maxLightsPerCluster = 64;  // lights exceed this are dropped, bound the shading cost
+    UInt32 maxLights           = 4096;// lights exceed this are not clustered
+    float  maxDistance         = 500.f;
+};
+
+/// point or spot light in world space
+struct LocalLightData {
+    Vector3f position;
+    float    range;
+    Vector3f spotDirection; // normalized, unused for point light
+    float    spotCosOuter;  // cos of half outer angle, -2 for point light
+    Vector4f color;
+    float    spotCosInner;
+};
+
+struct LightClusterViewParams {
+    Matrix4x4f worldToCamera; // camera looks down -z
+    float      fovyRadians;
+    float      aspect;
+    float      nearZ;
+    float      farZ;
+};
+
+/// assign lights to a froxel grid of the camera view,
+/// slices are processed on worker threads and sphere versus froxel tests use SIMD
+class AN_API LightClusters : private NonCopyable {
+
+    LightClusterSettings m_Settings;
+    UInt32 m_ClusterCount{};
+    UInt32 m_PaddedTilesX{};
+    float  m_TanX{}, m_TanY{};
+    float  m_NearZ{}, m_FarZ{};
+    float  m_LogScale{}, m_LogBias{};
+
+    /// froxel bounds in view space, x bounds only depend on tile x and slice, y on tile y and slice
+    std::vector<float> m_SliceMinX, m_SliceMaxX; // slices * paddedTilesX
+    std::vector<float> m_SliceMinY, m_SliceMaxY; // slices * tilesY
+    std::vector<float> m_SliceDepth;             // slices + 1
+
+    /// view space bounding sphere and slice range of every light
+    std::vector<Vector4f> m_LightSpheres;
+    std::vector<UInt32>   m_LightSliceRanges; // first << 16 | last, empty if first > last
+
+    /// fixed capacity per cluster list, written by one slice worker only
+    std::vector<UInt32> m_ClusterCounts;
+    std::vector<UInt32> m_ClusterSlots;
+    std::vector<UInt32> m_DroppedCounts;      // per slice
+
+    std::vector<UInt32> m_ClusterGrid;        // packed offset and count
+    std::vector<UInt32> m_LightIndices;
+
+    void updateGrid(const LightClusterViewParams &viewParams);
+    void assignSlice(UInt32 slice);
+
+public:
+
+    LightClusters();
+
+    void setSettings(const LightClusterSettings &settings);
+    const LightClusterSettings &getSettings() const { return m_Settings; }
+
+    /// rebuild light lists, only the first settings.maxLights lights are used
+    void build(const LightClusterViewParams &viewParams, std::span<const LocalLightData> lights);
+
+    UInt32 getClusterCount() const { return m_ClusterCount; }
+
+    UInt32 getClusterIndex(UInt32 x, UInt32 y, UInt32 slice) const {
+        return (slice * m_Settings.tilesY + y) * m_Settings.tilesX + x;
+    }
+
+    /// slice of a positive view depth, the shader does the same computation
+    UInt32 getSliceIndex(float viewDepth) const;
+
+    /// cluster containing a view space position, return false if outside the grid
+    bool getClusterIndex(const Vector3f &positionVS, UInt32 &outCluster) const;
+
+    std::span<const UInt32> getClusterLights(UInt32 cluster) const {
+        UInt32 packed = m_ClusterGrid[cluster];
+        return { m_LightIndices.data() + (packed >> kLightClusterCountBits), packed & kLightClusterMaxLights };
+    }
+
+    std::span<const UInt32> getClusterGrid() const { return m_ClusterGrid; }
+    std::span<const UInt32> getLightIndices() const { return m_LightIndices; }
+
+    /// light references dropped because a cluster was full in the last build
+    UInt32 getDroppedLightCount() const;
+
+    /// x: tilesX, y: tilesY, z: slices, w: index row width
+    Vector4f getShaderParams0() const;
+
+    /// x: tan half fov x, y: tan half fov y, z: log depth scale, w: log depth bias
+    Vector4f getShaderParams1() const;
+};
+
+}
+
+#endif//OJOIE_LIGHTCLUSTERS_HPP
@@ -12,13 +12,18 @@
 #include <ojoie/Render/Texture2D.hpp>
 #include <ojoie/Render/UniformBuffers.hpp>
 
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace AN {
 
 class CommandBuffer;
+class Material;
+class RenderCommandList;
+class RenderPipelineState;
 struct RenderContext;
+struct PerDrawData;
 
 // Properties with their current values. These are used inside the actual materials.
 class AN_API PropertySheet {
@@ -131,11 +136,72 @@ public:
 };
 
 
+/// uniform buffer an encoded material writes, bound again when replayed
+struct EncodedUniformBuffer {
+    int         id;
+    int         size;
+    int         binding;
+    ShaderStage stage;
+};
+
+/// one constant of an encoded material, source tells where its bytes come from when replayed
+struct EncodedConstant {
+    enum Source : UInt8 {
+        kSourceMaterial = 0, // copied from the material while encoding
+        kSourcePerDraw,      // read from the per draw data of the command
+        kSourceGlobal        // looked up by name when replayed, globals change between passes
+    };
+
+    Source             source;
+    ShaderPropertyType type;
+    UInt16             buffer; // index in EncodedMaterial::buffers
+    UInt32             dimension;
+    UInt32             offset;
+    UInt32             size;
+    const void        *data;          // kSourceMaterial
+    UInt32             perDrawOffset; // kSourcePerDraw, offset in PerDrawData
+    Name               name;          // kSourceGlobal
+};
+
+/// textures and samplers not found in the material are global, texID and descriptor are the defaults then
+struct EncodedTexture {
+    Name        name;
+    TextureID   texID;
+    UInt32      binding;
+    ShaderStage stage;
+    bool        bGlobal;
+};
+
+struct EncodedSampler {
+    Name              name;
+    SamplerDescriptor descriptor;
+    UInt32            binding;
+    ShaderStage       stage;
+    bool              bGlobal;
+};
+
+/// pipeline state and properties of one material pass resolved while encoding, lives in command list memory,
+/// replaying it only copies constants and binds, draws of the same material and pass in a list share it
+struct EncodedMaterial {
+    const Material                  *material;
+    const char                      *pass;
+    bool                             bPerDraw; // builtin per draw properties come from the command
+    RenderPipelineState             *pipelineState;
+    std::span<EncodedUniformBuffer>  buffers;
+    std::span<EncodedConstant>       constants;
+    std::span<EncodedTexture>        textures;
+    std::span<EncodedSampler>        samplers;
+};
+
 class AN_API Material : public NamedObject {
 
     PropertySheet         _propertySheet;
     Shader *_shader;
 
+    /// enabled keywords, the names are serialized and the set is what applyMaterial looks at
+    std::vector<Name> _keywords;
+    ShaderKeywordSet  _keywordSet;
+
 
     AN_CLASS(Material, NamedObject);
     AN_OBJECT_SERIALIZE(Material)
@@ -148,6 +214,8 @@ public:
 
     virtual bool initAfterDecode() override;
 
+    virtual void getResourceReferences(std::vector<Object *> &references) const override;
+
     void setShader(Shader *shader);
     Shader *getShader() const { return _shader; }
 
@@ -161,6 +229,11 @@ public:
     static void SetIntGlobal(Name name, UInt32 value);
     static void SetFloatGlobal(Name name, float value);
 
+    /// global keywords apply to every material together with the material keywords
+    static void EnableKeywordGlobal(Name keyword);
+    static void DisableKeywordGlobal(Name keyword);
+    static bool IsKeywordEnabledGlobal(Name keyword);
+
     /// game thread setting material properties
     void setMatrix(Name name, const Matrix4x4f &val);
     void setInt(Name name, UInt32 value);
@@ -168,10 +241,23 @@ public:
     void setVector(Name name, const Vector4f &vector);
     void setTexture(Name name, Texture *val);
 
+    /// select shader variants, see #pragma multi_compile and shader_feature
+    void enableKeyword(Name keyword);
+    void disableKeyword(Name keyword);
+    bool isKeywordEnabled(Name keyword) const;
+    const std::vector<Name> &getKeywords() const { return _keywords; }
+
     bool hasPass(const char *pass);
 
     void applyMaterial(AN::CommandBuffer *commandBuffer, const char *pass);
 
+    /// resolve pass into list memory, called while encoding and may run on worker threads,
+    /// return null if the shader variant has not been selected yet, the material is then applied when replayed
+    const EncodedMaterial *encodeMaterial(RenderCommandList &list, const char *pass, bool bPerDraw);
+
+    /// replay an encoded material, must be called during render pass
+    static void ApplyEncodedMaterial(AN::CommandBuffer *commandBuffer, const EncodedMaterial &encoded, const PerDrawData *perDraw);
+
     /// this method must be called during render pass
     /// apply properties, thus set uniform buffer or texture in pipeline
     void applyMaterial(AN::CommandBuffer *commandBuffer, UInt32 pass);
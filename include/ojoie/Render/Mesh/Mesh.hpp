@@ -7,6 +7,7 @@
 
 #include <ojoie/Object/NamedObject.hpp>
 #include <ojoie/Math/Math.hpp>
+#include <ojoie/Math/AABB.hpp>
 #include <ojoie/Render/VertexBuffer.hpp>
 #include <ojoie/Render/VertexData.hpp>
 #include <vector>
@@ -41,18 +42,65 @@ void BoneWeight::transfer(Coder &coder) {
     TRANSFER(weights);
 }
 
+/// 12 bytes instead of 32, the unorm8 weights always sum to 255
+struct PackedBoneWeight
+{
+    UInt16 boneIndices[4];
+    UInt8  weights[4];
+
+    AN_SERIALIZE_NO_IDPTR(PackedBoneWeight)
+};
+
+template<typename Coder>
+void PackedBoneWeight::transfer(Coder &coder) {
+    TRANSFER(boneIndices);
+    TRANSFER(weights);
+}
+
+/// channels setVertexCompression can quantize, color is already unorm8
+inline static constexpr UInt32 kMeshCompressibleChannels = VERTEX_FORMAT5(Vertex, Normal, TexCoord0, TexCoord1, Tangent);
+
 class AN_API Mesh : public NamedObject {
 
     VertexData _vertexData;
 
     std::vector<SubMesh> _subMeshes;
 
+    /// only the buffer of the current index format holds indices
+    IndexFormat          m_IndexFormat;
     std::vector<UInt16> _indexBuffer;
+    std::vector<UInt32> _indexBuffer32;
 
     VertexBuffer _vertexBuffer;
 
+    /// channels stored in their compressed format, see VertexDataInfo::GetCompressedChannelsLayout
+    UInt32               m_VertexCompression;
+    VertexChannelsLayout m_ChannelsLayout;
+
     std::vector<Matrix4x4f> m_Bindposes;
-    std::vector<BoneWeight> m_BoneWeights;
+
+    /// only one of them holds the weights
+    bool                          m_BoneWeightsCompressed;
+    std::vector<BoneWeight>       m_BoneWeights;
+    std::vector<PackedBoneWeight> m_PackedBoneWeights;
+
+    AABB  m_LocalAABB;
+
+    /// computed on demand since uvs and indices are usually set after the vertices
+    mutable float m_UVDistributionMetric;
+    mutable bool  m_UVDistributionMetricDirty;
+
+    /// non readable meshes release the cpu data after createVertexBuffer
+    bool   m_IsReadable;
+    bool   m_CPUDataReleased;
+    UInt64 m_GPUMemorySize;
+
+    /// float positions and indices kept through releaseCPUData for collider cooking
+    bool                  m_KeepCollisionData;
+    std::vector<Vector3f> m_CollisionVertices;
+    std::vector<UInt32>   m_CollisionIndices;
+
+    bool checkCPUData(const char *operation) const;
 
     AN_CLASS(Mesh, NamedObject)
     AN_OBJECT_SERIALIZE(Mesh)
@@ -65,8 +113,35 @@ public:
 
     virtual void dealloc() override;
 
+    virtual size_t getRuntimeMemorySize() const override;
+
+    /// upload the cpu data, non readable meshes release it afterwards
     void createVertexBuffer();
 
+    /// mesh default is readable, the flag is serialized so loading a non readable mesh releases its cpu data after upload
+    void setReadable(bool readable) { m_IsReadable = readable; }
+    bool isReadable() const { return m_IsReadable; }
+
+    /// false once a non readable mesh released its cpu data, counts, sub meshes, bounds and the gpu buffers stay valid
+    bool hasCPUData() const { return !m_CPUDataReleased; }
+
+    /// free vertices, indices and bone weights, bindposes are kept for skinning
+    void releaseCPUData();
+
+    /// decode the cpu data again from the asset the mesh was loaded from, see ResourceManager::getResourcePath
+    bool reloadFromAsset();
+
+    /// serialized, a non readable mesh keeps float positions and indices when releasing its cpu data
+    void setKeepCollisionData(bool keep) { m_KeepCollisionData = keep; }
+    bool isKeepCollisionData() const { return m_KeepCollisionData; }
+
+    /// only filled once the cpu data was released with setKeepCollisionData, indices cover all sub meshes
+    const std::vector<Vector3f> &getCollisionVertices() const { return m_CollisionVertices; }
+    const std::vector<UInt32>   &getCollisionIndices() const { return m_CollisionIndices; }
+
+    UInt64 getCPUMemorySize() const;
+    UInt64 getGPUMemorySize() const { return m_GPUMemorySize; }
+
     VertexBuffer &getVertexBuffer() { return _vertexBuffer; }
 
     SubMesh &getSubMesh(UInt32 index) { return _subMeshes[index]; }
@@ -107,25 +182,85 @@ public:
     void setTangents(Vector4f const *data, size_t count);
     void setUV(int uvIndex, Vector2f const *data, size_t count);
     bool setIndices(const UInt16* indices, unsigned count, unsigned submesh);
+    bool setIndices(const UInt32* indices, unsigned count, unsigned submesh);
+
+    IndexFormat getIndexFormat() const { return m_IndexFormat; }
+
+    /// convert the existing indices, switching to 16 bit fails when there are more than 65536 vertices
+    bool setIndexFormat(IndexFormat format);
 
     void setBindposes(const Matrix4x4f *data, size_t count);
     void setBoneWeights(const BoneWeight *boneWeight, size_t count);
 
-    UInt32 getIndicesCount() const { return _indexBuffer.size(); }
-    UInt16 *getIndicesData() { return _indexBuffer.data(); }
+    UInt32 getVertexCompression() const { return m_VertexCompression; }
+
+    /// convert the channels in compressedChannels to their compressed format and the others back to float,
+    /// positions are quantized into the current bounds, call createVertexBuffer afterwards
+    void setVertexCompression(UInt32 compressedChannels);
+
+    /// parameters the vertex shader needs to decode compressed channels
+    VertexCompressionData getVertexCompressionData() const;
+
+    bool isBoneWeightsCompressed() const { return m_BoneWeightsCompressed; }
+    void setBoneWeightsCompressed(bool compressed);
+
+    UInt32 getIndicesCount() const {
+        return m_IndexFormat == kIndexFormatUInt32 ? _indexBuffer32.size() : _indexBuffer.size();
+    }
+
+    /// indices of the current index format
+    const void *getIndicesData() const {
+        return m_IndexFormat == kIndexFormatUInt32 ? (const void *) _indexBuffer32.data() : (const void *) _indexBuffer.data();
+    }
+
+    UInt32 getIndex(UInt32 index) const {
+        return m_IndexFormat == kIndexFormatUInt32 ? _indexBuffer32[index] : _indexBuffer[index];
+    }
+
+    IndexBufferData getIndexBufferData() const {
+        IndexBufferData data;
+        data.indices = getIndicesData();
+        data.count   = getIndicesCount();
+        data.format  = m_IndexFormat;
+        return data;
+    }
 
     Matrix4x4f *getBindposesData() { return m_Bindposes.data(); }
     UInt32      getBindposesCount() const { return m_Bindposes.size(); }
 
-    BoneWeight *getBoneWeightsData() { return m_BoneWeights.data(); }
-    UInt32      getBoneWeightsCount() const { return m_BoneWeights.size(); }
+    /// nullptr when the bone weights are compressed, use getBoneWeight
+    BoneWeight *getBoneWeightsData() { return m_BoneWeightsCompressed ? nullptr : m_BoneWeights.data(); }
+    UInt32      getBoneWeightsCount() const { return m_BoneWeightsCompressed ? m_PackedBoneWeights.size() : m_BoneWeights.size(); }
+
+    BoneWeight getBoneWeight(UInt32 index) const;
+
+    /// local space bounds of the vertices
+    const AABB &getBounds() const { return m_LocalAABB; }
+    void setBounds(const AABB &aabb) { m_LocalAABB = aabb; }
+    void recalculateBounds();
+
+    /// world area per unit of uv0 area, recomputed after vertices, uv0 or indices changed, 0 without uv0
+    float getUVDistributionMetric() const;
+
+    /// see CalculateNormals, adds the normal channel when missing
+    void recalculateNormals(float smoothingAngle = 180.f);
+
+    /// see CalculateTangents, needs uv0 and computes normals first when they are missing
+    void recalculateTangents();
 
     void initChannelsToDefault(unsigned begin, unsigned count, unsigned shaderChannels);
 
     // returns a bitmask of a newly created channels
     UInt32 formatVertices(UInt32 shaderChannels);
 
+    /// decode channels of any format into vertexCount elements
+    void extractVertices(Vector3f *dst) const;
+    void extractNormals(Vector3f *dst) const;
+    void extractTangents(Vector4f *dst) const;
+    void extractUV(int uvIndex, Vector2f *dst) const;
+
     // NOTE: make sure to call SetChannelDirty and RecalculateBounds when changing the geometry!
+    // the iterators are only valid for uncompressed channels, see getVertexCompression
     StrideIterator<Vector3f> getVertexBegin() const { return _vertexData.MakeStrideIterator<Vector3f>(kShaderChannelVertex); }
     StrideIterator<Vector3f> getVertexEnd() const { return _vertexData.MakeEndIterator<Vector3f>(kShaderChannelVertex); }
 
@@ -143,6 +278,16 @@ public:
 };
 
 
+struct MeshMemoryReport {
+    UInt32 meshCount;
+    UInt32 readableCount;
+    UInt64 cpuBytes;
+    UInt64 gpuBytes;
+};
+
+/// cpu and gpu bytes of all loaded meshes
+AN_API MeshMemoryReport GetMeshMemoryReport();
+
 }// namespace AN
 
 #endif//OJOIE_MESH_HPP
@@ -17,6 +17,9 @@ class AN_API MeshRenderer : public Renderer {
 
     Mesh *_mesh;
 
+    /// always rasterized into the occlusion buffer of cameras
+    bool bOccluder;
+
     Transform              *transform;
 
     struct TransformData {
@@ -41,12 +44,23 @@ public:
     Mesh *getMesh() const { return _mesh; }
     void setMesh(Mesh *mesh);
 
+    virtual void getResourceReferences(std::vector<Object *> &references) const override;
+
+    bool isOccluder() const { return bOccluder; }
+    void setOccluder(bool occluder) { bOccluder = occluder; }
+
+    const Matrix4x4f &getObjectToWorld(UInt32 frameIndex) const { return transformData[frameIndex].objectToWorld; }
+
     /// update should called after all material prepared the pass data
     virtual void Update(UInt32 frameIndex) override;
 
     // render is called during render pass context
     virtual void Render(RenderContext &renderContext, const char *pass) override;
 
+    virtual void Encode(RenderCommandList &list, UInt32 frameIndex, const char *pass) override;
+
+    /// mips of the streamed Texture2Ds of all materials from the mesh uv density and the distance to the bounds
+    virtual void requestTextureMips(UInt32 frameIndex, const Vector3f &cameraPosition, float screenPixelScale) override;
 
     virtual void onInspectorGUI() override;
 };
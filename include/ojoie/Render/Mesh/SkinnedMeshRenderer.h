@@ -31,11 +31,19 @@ class AN_API SkinnedMeshRenderer : public Renderer
     VertexData   m_VertexData;
     VertexBuffer m_VertexBuffer;
 
+    /// skin even if the skeleton did not move, set when the mesh changes or a frame was skipped
+    bool bNeedsSkinning;
+
     AN_CLASS(SkinnedMeshRenderer, Renderer)
     AN_OBJECT_SERIALIZE(SkinnedMeshRenderer)
 
     void InitVertexBuffer();
 
+    /// upload the skinned hot stream, called by the SkinningManager
+    void UploadVertexStream();
+
+    friend class SkinningManager;
+
 public:
 
     explicit SkinnedMeshRenderer(ObjectCreationMode mode);
@@ -46,6 +54,8 @@ public:
     Mesh *GetMesh() const { return m_Mesh; }
     void SetMesh(Mesh *mesh);
 
+    virtual void getResourceReferences(std::vector<Object *> &references) const override;
+
     void SetBones(const std::vector<Transform *> &bones);
 
     Transform *GetRootBone();
@@ -53,6 +63,7 @@ public:
 
     virtual void Update(UInt32 frameIndex) override;
     virtual void Render(RenderContext &renderContext, const char *pass) override;
+    virtual void Encode(RenderCommandList &list, UInt32 frameIndex, const char *pass) override;
 };
 
 
@@ -0,0 +1,127 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_SKINNINGMANAGER_HPP
+#define OJOIE_SKINNINGMANAGER_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Math/Math.hpp>
+#include <ojoie/Render/Mesh/Mesh.hpp>
+#include <ojoie/Template/StrideIterator.hpp>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace AN {
+
+class SkinnedMeshRenderer;
+class Transform;
+
+/// vertices per batch a worker thread skins at once
+inline static constexpr UInt32 kSkinningBatchSize = 1024;
+
+/// float source streams of a skinned mesh, normals and tangents may be null when not skinned
+struct SkinningInput {
+    const Vector3f   *positions;
+    const Vector3f   *normals;
+    const Vector4f   *tangents;
+    const BoneWeight *boneWeights;
+};
+
+struct SkinningOutput {
+    StrideIterator<Vector3f> positions;
+    StrideIterator<Vector3f> normals;
+    StrideIterator<Vector4f> tangents;
+};
+
+struct SkinningJob {
+    const Matrix4x4f *palette;
+    SkinningInput     input;
+    SkinningOutput    output;
+    UInt32            vertexCount;
+    UInt32            channels;     // VERTEX_FORMAT mask of Vertex, Normal and Tangent to write
+};
+
+struct SkinningBatch {
+    UInt32 job;
+    UInt32 begin;
+    UInt32 end;
+};
+
+/// palette[i] = boneMatrices[i] * bindposes[i]
+AN_API void ComputeSkinningPalette(const Matrix4x4f *boneMatrices, const Matrix4x4f *bindposes,
+                                   size_t count, Matrix4x4f *outPalette);
+
+/// skin vertices [begin, end) of the job, the four bone matrices are blended by weight before transforming
+AN_API void SkinVertices(const SkinningJob &job, UInt32 begin, UInt32 end);
+
+/// skin all jobs in batches spread over worker threads,
+/// batches is scratch storage kept by the caller so that steady frames do not allocate
+AN_API void SkinJobs(std::span<const SkinningJob> jobs, std::vector<SkinningBatch> &batches);
+
+/// skins the visible SkinnedMeshRenderers once per frame,
+/// renderers on the same skeleton share the bone matrices and renderers of the same mesh share the decoded source
+class AN_API SkinningManager {
+
+    struct SkinningSource {
+        std::vector<Vector3f>   positions;
+        std::vector<Vector3f>   normals;
+        std::vector<Vector4f>   tangents;
+        std::vector<BoneWeight> boneWeights;
+        UInt32                  lastUsedFrame;
+    };
+
+    struct Skeleton {
+        const std::vector<Transform *> *bones;
+        UInt32 boneMatrixOffset;
+        bool   bChanged;
+
+        /// bindposes of each mesh skinned by this skeleton and the palette offset
+        std::vector<std::pair<Mesh *, UInt32>> palettes;
+    };
+
+    std::vector<SkinnedMeshRenderer *> m_Renderers;
+
+    std::unordered_map<Mesh *, SkinningSource> m_Sources;
+    std::unordered_map<Transform *, UInt32>    m_SkeletonMap;   // root bone to skeleton
+
+    /// pooled across frames
+    std::vector<Skeleton>      m_Skeletons;
+    std::vector<Matrix4x4f>    m_BoneMatrices;
+    std::vector<Matrix4x4f>    m_Palettes;
+    std::vector<SkinningJob>   m_Jobs;
+    std::vector<SkinningBatch> m_Batches;
+    std::vector<SkinnedMeshRenderer *> m_JobRenderers;
+    std::vector<UInt32>        m_RendererSkeletons;
+    std::vector<UInt32>        m_RendererPalettes;
+
+    static constexpr UInt32 kInvalidPalette = ~0U;
+
+    UInt32 m_FrameVersion;
+    UInt32 m_SkinnedVertexCount;
+
+    SkinningSource &getSource(Mesh *mesh);
+    UInt32 getSkeleton(SkinnedMeshRenderer *renderer);
+
+public:
+
+    SkinningManager();
+
+    /// called by visible renderers in their Update
+    void requestSkinning(SkinnedMeshRenderer *renderer) { m_Renderers.push_back(renderer); }
+
+    /// drop the decoded source of a mesh, call when its vertices or bone weights change
+    void invalidateMesh(Mesh *mesh) { m_Sources.erase(mesh); }
+
+    /// skin the requested renderers and upload them, called after the renderers are updated
+    void update(UInt32 frameIndex);
+
+    UInt32 getSkinnedVertexCount() const { return m_SkinnedVertexCount; }
+};
+
+AN_API SkinningManager &GetSkinningManager();
+
+}
+
+#endif//OJOIE_SKINNINGMANAGER_HPP
@@ -0,0 +1,50 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_MIPCHAIN_HPP
+#define OJOIE_MIPCHAIN_HPP
+
+#include <ojoie/Render/Image.hpp>
+#include <algorithm>
+
+namespace AN {
+
+enum MipFilter {
+    kMipFilterBox = 0,  // 2x2 average, cheapest
+    kMipFilterKaiser,   // windowed sinc over 6x6 texels, keeps small mips sharper
+    kMipFilterCount
+};
+
+struct MipChainSettings {
+    MipFilter filter = kMipFilterBox;
+
+    /// scale the alpha of every mip so the share of texels passing alphaCutoff stays that of the first level,
+    /// keeps alpha tested foliage from thinning out in the distance
+    bool  bPreserveAlphaCoverage = false;
+    float alphaCutoff            = 0.5f;
+};
+
+/// levels down to 1x1
+AN_API UInt32 CalculateMipCount(UInt32 width, UInt32 height);
+
+inline UInt32 CalculateMipSize(UInt32 size, UInt32 level) {
+    return std::max(1U, size >> level);
+}
+
+/// levels are stored one after the other starting with the largest one
+AN_API UInt64 CalculateMipOffset(PixelFormat pixelFormat, UInt32 width, UInt32 height, UInt32 level);
+
+AN_API UInt64 CalculateMipChainSize(PixelFormat pixelFormat, UInt32 width, UInt32 height, UInt32 mipCount);
+
+/// 8 bit R, RG and RGBA formats
+AN_API bool IsMipChainFormatSupported(PixelFormat pixelFormat);
+
+/// fill levels 1 to mipCount - 1 of data from level 0, data holds CalculateMipChainSize bytes,
+/// sRGB formats are averaged in linear space, rows are filtered on the worker threads
+AN_API bool GenerateMipChain(UInt8 *data, UInt32 width, UInt32 height, PixelFormat pixelFormat, UInt32 mipCount,
+                             const MipChainSettings &settings = {});
+
+}
+
+#endif//OJOIE_MIPCHAIN_HPP
@@ -0,0 +1,135 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_OCCLUSIONCULLING_HPP
+#define OJOIE_OCCLUSIONCULLING_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Math/Math.hpp>
+#include <ojoie/Math/AABB.hpp>
+#include <ojoie/Render/RenderTypes.hpp>
+#include <ojoie/Template/StrideIterator.hpp>
+#include <span>
+#include <vector>
+
+namespace AN {
+
+struct OcclusionCullingSettings {
+    UInt32 width               = 256; // depth buffer resolution, width is rounded up to a multiple of 4
+    UInt32 height              = 128;
+    UInt32 maxOccluders        = 64;
+    bool   autoSelectOccluders = true;  // renderers large on screen become occluders too
+    float  minOccluderScreenSize = 0.15f;// fraction of the screen area an auto selected occluder covers
+};
+
+/// triangles of one occluder, positions in object space
+struct OccluderMesh {
+    StrideIterator<Vector3f> vertices;
+    UInt32                   vertexCount;
+    const void              *indices;
+    UInt32                   indexCount;
+    IndexFormat              indexFormat = kIndexFormatUInt16;
+    Matrix4x4f               objectToWorld;
+};
+
+/// occluder candidate, forced candidates are always selected first
+struct OccluderCandidate {
+    AABB bounds;
+    bool bForced;
+};
+
+enum OcclusionResult : UInt8 {
+    kOcclusionVisible = 0,
+    kOcclusionFrustumCulled,
+    kOcclusionOccluded
+};
+
+struct OcclusionCullingStats {
+    UInt32 occluderCount;
+    UInt32 occluderTriangleCount;   // triangles rasterized into the depth buffer
+    UInt32 occludeeCount;
+    UInt32 frustumCulledCount;
+    UInt32 occlusionCulledCount;
+
+    /// time of every stage in milliseconds
+    float  setupMs;     // occluder transform and triangle setup
+    float  rasterizeMs;
+    float  buildHiZMs;
+    float  testMs;
+};
+
+/// cpu occlusion culling, occluders are rasterized into a low resolution depth buffer on worker threads,
+/// occludee bounds are tested against the hierarchical max depth of the buffer,
+/// clip depth is 0 at near and 1 at far
+class AN_API OcclusionCulling : private NonCopyable {
+
+    struct HiZLevel {
+        UInt32 width, height;
+        std::vector<float> depth; // farthest occluder depth of the texel
+    };
+
+    /// screen space triangle, depth is the farthest of its vertices so writes are conservative
+    struct ScreenTriangle {
+        float  x[3], y[3];
+        float  maxDepth;
+        UInt32 minY, maxY; // inclusive pixel rows
+    };
+
+    OcclusionCullingSettings m_Settings;
+    OcclusionCullingStats    m_Stats{};
+
+    Matrix4x4f  m_ViewProj;
+    Math::Plane m_FrustumPlanes[kPlaneFrustumNum];
+
+    std::vector<HiZLevel> m_HiZ; // level 0 is the full resolution buffer
+
+    std::vector<std::vector<ScreenTriangle>> m_OccluderTriangles; // per occluder, set up in parallel
+    std::vector<std::vector<const ScreenTriangle *>> m_StripBins;   // triangles touching each strip
+
+    void setupTriangles(const OccluderMesh &occluder, std::vector<ScreenTriangle> &outTriangles) const;
+    void rasterizeStrip(UInt32 strip);
+    void buildHiZLevel(UInt32 level);
+
+public:
+
+    enum { kStripHeight = 8 };
+
+    OcclusionCulling();
+
+    void setSettings(const OcclusionCullingSettings &settings);
+    const OcclusionCullingSettings &getSettings() const { return m_Settings; }
+
+    /// clear the depth buffer and stats for a new view
+    void beginFrame(const Matrix4x4f &viewProj);
+
+    /// pick at most settings.maxOccluders candidates, forced first then by screen area, indices into candidates
+    void selectOccluders(std::span<const OccluderCandidate> candidates, std::vector<UInt32> &outIndices) const;
+
+    /// rasterize occluders and build the hierarchical depth
+    void renderOccluders(std::span<const OccluderMesh> occluders);
+
+    /// classify bounds, large batches run on worker threads
+    void testOccludees(std::span<const AABB> bounds, std::span<OcclusionResult> outResults);
+
+    OcclusionResult testOccludee(const AABB &bounds) const;
+
+    /// fraction of the screen area covered by the projected bounds, 1 if bounds cross the near plane
+    float getScreenArea(const AABB &bounds) const;
+
+    UInt32 getWidth() const { return m_HiZ[0].width; }
+    UInt32 getHeight() const { return m_HiZ[0].height; }
+    UInt32 getHiZLevelCount() const { return m_HiZ.size(); }
+
+    /// depth of a texel of a level, 1 where nothing was rasterized
+    float getDepth(UInt32 level, UInt32 x, UInt32 y) const {
+        const HiZLevel &hiz = m_HiZ[level];
+        return hiz.depth[y * hiz.width + x];
+    }
+
+    const OcclusionCullingStats &getStats() const { return m_Stats; }
+};
+
+}
+
+#endif//OJOIE_OCCLUSIONCULLING_HPP
@@ -8,6 +8,8 @@
 #include <ojoie/Core/Name.hpp>
 #include <ojoie/Core/CGTypes.hpp>
 #include <ojoie/Render/RenderTypes.hpp>
+#include <ojoie/Render/ShadowCascades.hpp>
+#include <ojoie/Render/LODSelection.hpp>
 #include <vector>
 
 namespace AN {
@@ -18,6 +20,18 @@ struct QualitySetting {
     Size targetResolution;
     UInt32 vSyncCount;
     UInt32 antiAliasing;
+
+    /// main light shadow
+    UInt32 shadowCascades;
+    UInt32 shadowResolution; // resolution of one cascade
+    float  shadowDistance;
+    ShadowCascadeSplitMode shadowCascadeSplitMode;
+    float  shadowCascadeSplitLambda;
+    float  shadowCascadeSplits[kMaxShadowCascades - 1];
+
+    /// lod groups
+    float  lodBias;          // greater prefers more detail
+    UInt32 maximumLODLevel;  // finest level allowed
 };
 
 class AN_API QualitySettings {
@@ -40,6 +54,22 @@ public:
     void setVSyncCount(UInt32 count);
     void setAntiAliasing(UInt32 aa);
 
+    void setShadowCascades(UInt32 cascades);
+    void setShadowResolution(UInt32 resolution);
+    void setShadowDistance(float distance);
+    void setShadowCascadeSplitMode(ShadowCascadeSplitMode mode);
+    void setShadowCascadeSplitLambda(float lambda);
+    void setShadowCascadeSplits(const float *splits, UInt32 count);
+
+    void setLODBias(float bias);
+    void setMaximumLODLevel(UInt32 level);
+
+    float  getLODBias() const { return _settings[_current].lodBias; }
+    UInt32 getMaximumLODLevel() const { return _settings[_current].maximumLODLevel; }
+
+    /// cascade settings of the current quality level
+    ShadowCascadeSettings getShadowCascadeSettings() const;
+
 };
 
 AN_API QualitySettings &GetQualitySettings();
@@ -0,0 +1,180 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_RENDERCOMMANDLIST_HPP
+#define OJOIE_RENDERCOMMANDLIST_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Core/Name.hpp>
+#include <ojoie/Math/Math.hpp>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace AN {
+
+struct RenderContext;
+class Material;
+struct EncodedMaterial;
+class VertexBuffer;
+struct VertexCompressionData;
+
+/// linear allocator for transient per draw data, memory blocks are kept and recycled on reset
+class AN_API TransientAllocator : private NonCopyable {
+
+    struct Block {
+        UInt8 *data;
+        size_t size;
+        size_t used;
+    };
+
+    std::vector<Block> m_Blocks;
+    size_t             m_BlockSize;
+    size_t             m_CurrentBlock;
+
+public:
+
+    explicit TransientAllocator(size_t blockSize = 64 * 1024);
+
+    ~TransientAllocator();
+
+    void *allocate(size_t size, size_t align);
+
+    template<typename T>
+    T *allocate() {
+        return new (allocate(sizeof(T), alignof(T))) T();
+    }
+
+    /// all memory allocated before is invalid after reset
+    void reset();
+
+    size_t getUsedBytes() const;
+    size_t getReservedBytes() const;
+};
+
+enum RenderCommandType : UInt8 {
+    kRenderCommandDrawIndexed = 0,
+    kRenderCommandDraw,
+    kRenderCommandCallback
+};
+
+/// builtin per draw properties, read by encoded materials when the command is replayed
+struct PerDrawData {
+    Vector4f   worldTransformParams;
+    Matrix4x4f objectToWorld;
+    Matrix4x4f worldToObject;
+    Vector4f   lodFade; // x is the lod cross fade weight
+    Vector4f   vertexCompression; // decode flags of quantized vertex channels, see VertexCompressionData
+    Vector4f   vertexPositionScale;
+    Vector4f   vertexPositionOffset;
+};
+
+/// shader property name of a PerDrawData member
+struct PerDrawProperty {
+    Name   name;
+    UInt32 offset;
+    UInt32 size;
+};
+
+AN_API std::span<const PerDrawProperty> GetPerDrawProperties();
+
+typedef void (*RenderCommandCallback)(RenderContext &context, void *userdata, const char *pass);
+
+/// backend agnostic draw packet, it does not touch any graphic api until executed
+struct RenderCommand {
+    RenderCommandType     type;
+    const char           *pass;
+    Material             *material;
+    const EncodedMaterial *encoded; // null if the material is applied when replayed
+    const PerDrawData    *perDraw;
+    VertexBuffer         *vertexBuffer;
+    UInt32                count;// index count or vertex count
+    UInt32                indexOffset;
+    UInt32                vertexOffset;
+    RenderCommandCallback callback;
+    void                 *userdata;
+};
+
+/// intermediate command list which can be recorded in any thread
+class AN_API RenderCommandList : private NonCopyable {
+
+    std::vector<RenderCommand>           m_Commands;
+    TransientAllocator                   m_Allocator;
+    std::vector<const EncodedMaterial *> m_EncodedMaterials;
+
+    const EncodedMaterial *encodeMaterial(Material *material, const char *pass, bool bPerDraw);
+
+public:
+
+    void reset();
+
+    /// per draw data live until the list is reset
+    const PerDrawData *allocatePerDraw(const Matrix4x4f &objectToWorld, const Matrix4x4f &worldToObject, float lodFade = 1.f,
+                                       const VertexCompressionData *compression = nullptr);
+
+    void *allocate(size_t size, size_t align) { return m_Allocator.allocate(size, align); }
+
+    void drawIndexed(Material *material, const char *pass, const PerDrawData *perDraw,
+                     VertexBuffer *vertexBuffer, UInt32 indexCount, UInt32 indexOffset, UInt32 vertexOffset);
+
+    void draw(Material *material, const char *pass, const PerDrawData *perDraw,
+              VertexBuffer *vertexBuffer, UInt32 vertexCount);
+
+    /// callback is called when the list is executed, used by renderers which can not record draw packets
+    void callback(RenderCommandCallback callback, void *userdata, const char *pass);
+
+    /// append commands of other, other must not be reset before this list is executed
+    void append(const RenderCommandList &other);
+
+    std::span<const RenderCommand> getCommands() const { return m_Commands; }
+
+    size_t size() const { return m_Commands.size(); }
+    bool   empty() const { return m_Commands.empty(); }
+
+    const TransientAllocator &getAllocator() const { return m_Allocator; }
+
+    /// replay commands into renderContext.commandBuffer on the render thread, must be called in render pass
+    void execute(RenderContext &context) const;
+};
+
+/// called for every item, index is in [0, itemCount)
+typedef void (*RenderEncodeFunc)(RenderCommandList &list, size_t index, void *userdata);
+
+/// split items into chunks and encode them into per chunk command lists on worker threads,
+/// lists are replayed in chunk order, so the result does not depend on thread scheduling
+/// only encoding is parallel, each chunk fills its own list and transient allocator with resolved materials,
+/// execute submits on the render thread since uniforms are bound through the immediate context
+class AN_API ParallelRenderEncoder : private NonCopyable {
+
+    std::vector<std::unique_ptr<RenderCommandList>> m_Lists;
+    size_t m_ChunkCount{};
+
+public:
+
+    enum { kDefaultChunkSize = 128 };
+
+    void encode(size_t itemCount, size_t chunkSize, RenderEncodeFunc func, void *userdata);
+
+    template<typename Func>
+    void encode(size_t itemCount, size_t chunkSize, Func &&func) {
+        encode(itemCount, chunkSize, [](RenderCommandList &list, size_t index, void *userdata) {
+            (*(std::remove_reference_t<Func> *) userdata)(list, index);
+        }, (void *) &func);
+    }
+
+    size_t getChunkCount() const { return m_ChunkCount; }
+
+    const RenderCommandList &getChunk(size_t index) const { return *m_Lists[index]; }
+
+    size_t getCommandCount() const;
+
+    /// merge all chunks into one list, in chunk order
+    void merge(RenderCommandList &outList) const;
+
+    void execute(RenderContext &context) const;
+};
+
+}
+
+#endif//OJOIE_RENDERCOMMANDLIST_HPP
@@ -11,6 +11,7 @@
 #include <ojoie/Template/SmallVector.hpp>
 #include <ojoie/Serialize/SerializeDefines.h>
 #include <ojoie/Math/Math.hpp>
+#include <limits>
 #include <ranges>
 #include <unordered_map>
 #include <variant>
@@ -29,11 +30,35 @@ enum PrimitiveType {
     kPrimitiveTypeCount,
 };
 
+/// 16 bit indices are the compact default, 32 bit indices address meshes beyond 65535 vertices
+enum IndexFormat {
+    kIndexFormatUInt16 = 0,
+    kIndexFormatUInt32,
+    kIndexFormatCount
+};
+
+inline constexpr int GetIndexFormatSize(IndexFormat format) {
+    return format == kIndexFormatUInt32 ? sizeof(UInt32) : sizeof(UInt16);
+}
+
+/// max vertex count addressable with the format
+inline constexpr UInt32 GetIndexFormatMaxVertexCount(IndexFormat format) {
+    return format == kIndexFormatUInt32 ? std::numeric_limits<UInt32>::max() : std::numeric_limits<UInt16>::max() + 1U;
+}
+
+/// the compact format which can address vertexCount vertices
+inline constexpr IndexFormat GetIndexFormatForVertexCount(size_t vertexCount) {
+    return vertexCount > GetIndexFormatMaxVertexCount(kIndexFormatUInt16) ? kIndexFormatUInt32 : kIndexFormatUInt16;
+}
+
 enum VertexChannelFormat {
     kChannelFormatFloat = 0,
     kChannelFormatFloat16,
     kChannelFormatColor,
     kChannelFormatByte,
+    kChannelFormatUNorm16,     // positions are quantized into the vertex data position bounds
+    kChannelFormatSNorm16,
+    kChannelFormatOctahedral16,// 2 snorm16 octahedral encoded direction, tangents fold the sign into y
     kChannelFormatCount
 };
 
@@ -229,6 +254,10 @@ enum PixelFormat {
 
     kPixelFormatBC7_RGBAUnorm,
     kPixelFormatBC7_RGBAUnorm_sRGB,
+
+    /// uncompressed data formats, appended to keep serialized values
+    kPixelFormatRGBA32Float,
+    kPixelFormatR32Uint,
     kPixelFormatCount
 };
 
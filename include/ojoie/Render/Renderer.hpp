@@ -7,11 +7,15 @@
 
 #include <ojoie/Core/Component.hpp>
 #include <ojoie/Render/Material.hpp>
+#include <ojoie/Render/RenderCommandList.hpp>
+#include <ojoie/Render/RenderTypes.hpp>
+#include <ojoie/Math/AABB.hpp>
 #include <ojoie/Template/LinkedList.hpp>
 
 namespace AN {
 
 class Renderer;
+class LODGroup;
 typedef ListNode<Renderer> RendererListNode;
 typedef List<RendererListNode> RendererList;
 
@@ -20,10 +24,23 @@ class AN_API Renderer : public Component {
     bool bAddToManager;
     RendererListNode _rendererListNode{ this };
 
+    /// lod groups listing this renderer, they forget it when it is destroyed
+    std::vector<LODGroup *> m_LODGroups;
+
+    friend class LODGroup;
+
 protected:
 
     std::vector<Material *> _materials;
 
+    /// world bounds written in Update, renderers without bounds are never culled
+    AABB _worldAABB[kMaxFrameInFlight];
+    bool bHasWorldAABB;
+
+    /// written by the lod group selection of the camera being drawn
+    bool  bLODCulled;
+    float m_LODFade;
+
     virtual void onAddRenderer();
 
 public:
@@ -35,18 +52,44 @@ public:
 
     virtual void dealloc() override;
 
+    virtual void getResourceReferences(std::vector<Object *> &references) const override;
+
     static void InitializeClass();
 
     void setMaterial(UInt32 index, Material *material);
 
     std::span<Material *const> getMaterials() const { return _materials; }
 
+    /// return false if the renderer has no bounds
+    bool getWorldAABB(UInt32 frameIndex, AABB &outAABB) const {
+        if (!bHasWorldAABB) return false;
+        outAABB = _worldAABB[frameIndex];
+        return true;
+    }
+
+    /// fade is the cross fade weight, negative for the coarser level fading in
+    void setLODState(bool culled, float fade) {
+        bLODCulled = culled;
+        m_LODFade  = fade;
+    }
+
+    bool  isLODCulled() const { return bLODCulled; }
+    float getLODFade() const { return m_LODFade; }
+
     /// update should called after all material prepared the pass data
     virtual void Update(UInt32 frameIndex) = 0;
 
     // render is called during render pass context
     virtual void Render(RenderContext &renderContext, const char *pass) = 0;
 
+    /// record draw packets into list, may be called in worker threads after Update,
+    /// default record a callback which calls Render when the list is executed
+    virtual void Encode(RenderCommandList &list, UInt32 frameIndex, const char *pass);
+
+    /// request the mip levels of streamed textures this renderer needs when seen from cameraPosition,
+    /// screenPixelScale is the pixels one world unit covers at distance one, default requests nothing
+    virtual void requestTextureMips(UInt32 frameIndex, const Vector3f &cameraPosition, float screenPixelScale) {}
+
 };
 
 }
@@ -9,6 +9,7 @@
 #include <ojoie/Render/RenderPipelineState.hpp>
 #include <ojoie/Render/RenderTypes.hpp>
 #include <ojoie/Render/ShaderFunction.hpp>
+#include <ojoie/Render/Shader/ShaderKeywords.hpp>
 #include <ojoie/ShaderLab/Parser.hpp>
 #include <ojoie/Template/RC.hpp>
 #include <ojoie/Template/SmallVector.hpp>
@@ -16,6 +17,7 @@
 
 #include <any>
 #include <span>
+#include <unordered_map>
 
 namespace AN {
 
@@ -54,25 +56,41 @@ public:
         }
     };
 
-    struct Pass {
+    /// variant index of a keyword mask that cannot be built
+    inline static constexpr UInt32 kMissingVariant = ~0U;
 
-        RenderPipelineState           *renderPipelineState = nullptr;
+    /// compiled code and GPU objects of one keyword combination of a pass
+    struct Variant {
+
+        UInt64                          keywordMask = 0;
+        RenderPipelineState            *renderPipelineState = nullptr;
         ShaderPropertyList              propertyList;
         SmallVector<ShaderVertexInput> vertexInputs;
         std::vector<BindingInfo>       bindingInfos;
+        bool                            bUsed = false; // selected by a material since loaded
 
-
-        /// serialize data below
-        ShaderLab::ShaderPass shaderLabPass;
         /// the compiled spv code
         std::vector<UInt8> vertex_spv, fragment_spv;
 
-        constexpr static const char* GetTypeString() { return "Pass"; }
+        const BindingInfo *getUniformBufferInfo(ShaderStage stage, UInt32 binding, UInt32 set = 0) const {
+            auto it = std::find_if(bindingInfos.begin(),
+                                   bindingInfos.end(), [binding, set, stage](const BindingInfo &info) {
+                                       return info.set == set &&
+                                              info.binding == binding &&
+                                              info.stage == stage &&
+                                              info.bindingType == kBindingTypeBuffer;
+                                   });
+            if (it != bindingInfos.end()) {
+                return &*it;
+            }
+            return nullptr;
+        }
+
+        constexpr static const char* GetTypeString() { return "Variant"; }
         constexpr static bool MightContainIDPtr() { return false; }
 
         template<typename Coder>
-        void transfer(Coder &coder) {
-            TRANSFER(shaderLabPass);
+        void transferCode(Coder &coder) {
             size_t size = vertex_spv.size();
             coder.transferTypeless(size, "vertex_spv_size");
             if constexpr (Coder::IsDecoding()) {
@@ -86,6 +104,39 @@ public:
             }
             coder.transferTypelessData(fragment_spv.data(), size);
         }
+
+        template<typename Coder>
+        void transfer(Coder &coder) {
+            TRANSFER(keywordMask);
+            transferCode(coder);
+        }
+    };
+
+    /// the pass itself is the variant of a material without keywords,
+    /// other keyword combinations are compiled on first use or by prewarmVariants
+    struct Pass : Variant {
+
+        ShaderKeywordSpace keywordSpace;
+        /// keyword mask to index in variants
+        std::unordered_map<UInt64, UInt32> variantIndices;
+
+        /// serialize data below
+        ShaderLab::ShaderPass shaderLabPass;
+        /// HLSL of the pass when it declares keywords, empty once variants are stripped
+        std::string          source;
+        std::vector<Variant> variants;
+
+        constexpr static const char* GetTypeString() { return "Pass"; }
+        constexpr static bool MightContainIDPtr() { return false; }
+
+        template<typename Coder>
+        void transfer(Coder &coder) {
+            TRANSFER(shaderLabPass);
+            TRANSFER(keywordMask);
+            transferCode(coder);
+            TRANSFER(source);
+            TRANSFER(variants);
+        }
     };
 
     struct SubShader {
@@ -105,11 +156,20 @@ public:
 private:
     std::string              _scriptPath;
     SmallVector<std::string> _includes;
+    std::vector<std::string> _includeDependencies; // include files of the script, serialized so hot reload works after a restart
 
     SmallVector<SubShader> subShaders;
 
     std::vector<ShaderLab::Property> shaderLabProperties;
 
+    /// compile the stages of variants, jobs of all passes run in parallel
+    bool compileVariants(std::span<Variant *const> variants, std::span<const Pass *const> passes);
+
+    bool createVariantGPUObject(Variant &variant, const Pass &pass);
+
+    /// build the keyword spaces and the mask lookup after parsing or decoding
+    bool initKeywords();
+
     AN_CLASS(Shader, TextAsset)
     AN_OBJECT_SERIALIZE(Shader)
 
@@ -129,6 +189,9 @@ public:
 
     bool setScriptText(const char *text, std::span<const char *> includes = {});
 
+    /// whether the script includes the file, only known for shaders compiled from their script in this session
+    bool dependsOnInclude(std::string_view path) const;
+
     virtual std::string getTextAssetPath() override;
     virtual void        setTextAssetPath(std::string_view path) override;
 
@@ -154,21 +217,32 @@ public:
     }
 
     const BindingInfo *getUniformBufferInfo(UInt32 passIndex, UInt32 subShaderIndex, ShaderStage stage, UInt32 binding, UInt32 set = 0) {
-        auto &infos = subShaders[subShaderIndex].passes[passIndex].bindingInfos;
-        auto  it    = std::find_if(infos.begin(),
-                                   infos.end(), [binding, set, stage](const BindingInfo &info) {
-                                   return info.set == set &&
-                                          info.binding == binding &&
-                                          info.stage == stage &&
-                                          info.bindingType == kBindingTypeBuffer;
-                               });
-        if (it != infos.end()) {
-            return &*it;
-        }
+        return subShaders[subShaderIndex].passes[passIndex].getUniformBufferInfo(stage, binding, set);
+    }
 
-        return nullptr;
+    const ShaderKeywordSpace &getKeywordSpace(UInt32 passIndex, UInt32 subShaderIndex) const {
+        return subShaders[subShaderIndex].passes[passIndex].keywordSpace;
     }
 
+    /// variant of the pass for the enabled keywords, one hash lookup on the keyword mask,
+    /// a missing variant is compiled when the pass still has its source, otherwise the pass itself is used
+    Variant &getVariant(UInt32 passIndex, UInt32 subShaderIndex, const ShaderKeywordSet &keywords);
+
+    /// variant getVariant has already selected for the keywords, null otherwise,
+    /// never compiles so command list encoding threads can call it
+    const Variant *findVariant(UInt32 passIndex, UInt32 subShaderIndex, const ShaderKeywordSet &keywords) const;
+
+    /// compile and create the variants ahead of their first use
+    bool prewarmVariants(std::span<const ShaderVariant> variants);
+
+    /// variants selected by materials since the shader was loaded, including the passes themselves
+    void getUsedVariants(std::vector<ShaderVariant> &outVariants) const;
+
+    /// drop compiled variants not in the list together with the pass sources, nothing compiles at runtime after this
+    void stripVariants(std::span<const ShaderVariant> keep);
+
+    UInt32 getVariantCount() const;
+
     const std::vector<ShaderLab::Property> &getShaderLabProperties() const {
         return shaderLabProperties;
     }
@@ -0,0 +1,87 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_SHADERCACHE_HPP
+#define OJOIE_SHADERCACHE_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Utility/Hash128.hpp>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AN {
+
+struct ShaderCacheStats {
+    UInt32 hits;
+    UInt32 misses;
+    UInt32 evictions;
+    UInt64 size;        // bytes of all entries on disk
+    UInt32 entryCount;
+};
+
+/// compiled shader stages on disk named by the hash of everything that affects the compiler output,
+/// least recently used entries are removed when the cache grows over its size limit, thread safe
+class AN_API ShaderCache {
+
+    struct Entry {
+        UInt64 size;
+        UInt64 lastUse;
+    };
+
+    std::mutex  m_Mutex;
+    std::string m_Directory;
+    UInt64      m_MaxSize;
+    UInt64      m_TotalSize;
+    UInt64      m_UseClock;
+
+    std::unordered_map<Hash128, Entry, Hash128Hasher> m_Entries;
+
+    std::atomic<UInt32> m_Hits;
+    std::atomic<UInt32> m_Misses;
+    std::atomic<UInt32> m_Evictions;
+
+    std::string getEntryPath(const Hash128 &key) const;
+
+    /// remove least recently used entries until the cache fits, called with the mutex locked
+    void evict();
+
+public:
+
+    inline static constexpr UInt64 kDefaultMaxSize = 256ULL << 20;
+
+    ShaderCache();
+
+    /// directory of the cache, usually Library/ShaderCache of the project, empty disables the cache,
+    /// entries already there are kept and ordered by their last use
+    void setDirectory(std::string_view directory, UInt64 maxSize = kDefaultMaxSize);
+    const std::string &getDirectory() const { return m_Directory; }
+
+    bool isEnabled() const { return !m_Directory.empty(); }
+
+    /// key of one compiled stage, source has its includes expanded so include changes are part of it
+    static Hash128 ComputeKey(std::string_view source, std::string_view entry, std::string_view profile,
+                              std::span<const char *> defines, std::string_view compilerVersion);
+
+    /// false on a miss or when the entry on disk is damaged
+    bool load(const Hash128 &key, std::vector<UInt8> &outBlob);
+
+    void store(const Hash128 &key, std::span<const UInt8> blob);
+
+    /// remove all entries from disk
+    void clear();
+
+    ShaderCacheStats getStats();
+    void resetStats();
+};
+
+AN_API ShaderCache &GetShaderCache();
+
+}
+
+#endif//OJOIE_SHADERCACHE_HPP
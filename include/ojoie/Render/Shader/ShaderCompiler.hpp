@@ -7,6 +7,7 @@
 
 #include <ojoie/Render/RenderTypes.hpp>
 #include <span>
+#include <string>
 
 namespace AN::RC {
 
@@ -17,6 +18,20 @@ public:
 
     ShaderCompiler();
 
+    /// expand includes and macros, defines are "NAME" or "NAME=VALUE",
+    /// the result compiles without include paths and is what the shader cache hashes
+    bool preprocessHLSL(const char *source,
+                        std::string &outSource,
+                        const char *nameHint = nullptr,
+                        std::span<const char *> include = {},
+                        std::span<const char *> defines = {});
+
+    /// target profile of the stage, nullptr when the stage is not supported
+    static const char *GetTargetProfile(ShaderStage stage, bool spirv);
+
+    /// identifies the compiler and the flags it is called with, part of the shader cache key
+    std::string getVersionString(bool spirv);
+
     std::vector<UInt8> compileHLSLToSPIRV(ShaderStage stage,
                                           const char *source,
                                           const char *entry,
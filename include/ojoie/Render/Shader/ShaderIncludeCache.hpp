@@ -0,0 +1,116 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_SHADERINCLUDECACHE_HPP
+#define OJOIE_SHADERINCLUDECACHE_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Utility/Hash128.hpp>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace AN {
+
+struct ShaderIncludeCacheStats {
+    UInt32 fileLoads;       // include files read from disk
+    UInt32 expansions;      // include files expanded with their own includes
+    UInt32 expandedHits;    // expanded include files reused as a whole
+    UInt32 fileCount;
+};
+
+/// HLSL include files read and split at their #include lines once, the expanded text of every include file
+/// is kept as well, so the source of a pass is assembled from shared fragments instead of the preprocessor
+/// opening every include for every stage, a file guarded by #pragma once or an #ifndef guard is emitted once
+/// per source, #line directives keep compiler messages pointing into the include files, thread safe
+class AN_API ShaderIncludeCache {
+
+    /// text before an #include line and the include itself, the last part of a file has no include
+    struct Segment {
+        size_t      offset;
+        size_t      size;
+        std::string name;               // empty for the last part
+        bool        bSystem;            // <name> searches the include paths only
+        size_t      directiveOffset;    // the #include line, kept when the file is not found
+        size_t      directiveSize;
+        UInt32      nextLine;           // line after the directive
+        UInt32      conditionalDepth;   // #if blocks around the directive, the include guard not counted
+    };
+
+    struct File {
+        std::string          path;
+        std::string          name;  // file name for #line
+        std::string          text;
+        Hash128              hash;
+        bool                 bOnce;
+        std::vector<Segment> segments;
+
+        /// text with all includes expanded, valid for the include paths of expansionKey
+        bool                     bExpanded;
+        Hash128                  expansionKey;
+        std::string              expanded;
+        std::vector<std::string> expandedOnceFiles;
+        std::vector<std::string> expandedDependencies;
+    };
+
+    struct Context {
+        std::span<const char *const>    includePaths;
+        Hash128                         key;
+        std::unordered_set<std::string> emitted;        // guarded files emitted outside of #if blocks
+        std::vector<std::string>        dependencies;
+        std::vector<std::string>        stack;          // files being assembled, an include cycle stops here
+        bool                            bStackHit;
+    };
+
+    std::mutex m_Mutex;
+    std::unordered_map<std::string, std::shared_ptr<File>>           m_Files;
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_Dependents; // include to files including it
+    std::unordered_map<std::string, std::string>                     m_Resolved;   // include directive to full path
+
+    UInt32 m_FileLoads;
+    UInt32 m_Expansions;
+    UInt32 m_ExpandedHits;
+
+    static void Parse(File &file);
+
+    std::shared_ptr<File> getFile(const std::string &path);
+    std::string resolve(const Segment &segment, std::string_view directory, const Context &context);
+    void assemble(const File &file, std::string_view name, UInt32 depth, Context &context, std::string &out);
+
+    /// expanded text of file on its own, not kept when it depends on the files including it
+    void buildExpanded(File &file, Context &parent);
+
+public:
+
+    ShaderIncludeCache();
+
+    /// expand the includes of source, includes are searched next to the including file first for "name",
+    /// then in includePaths, an include that is not found stays for the preprocessor to report,
+    /// outDependencies receives the full paths of all files the source includes
+    void expand(std::string_view source, std::string_view name, std::span<const char *const> includePaths,
+                std::string &outSource, std::vector<std::string> *outDependencies = nullptr);
+
+    /// read the file again, expansions of the files including it are dropped when its content changed,
+    /// files which do not depend on it keep theirs, true if the content changed
+    bool invalidate(std::string_view path);
+
+    void clear();
+
+    /// the normalized path the cache uses for a file
+    static std::string NormalizePath(std::string_view path);
+
+    ShaderIncludeCacheStats getStats();
+    void resetStats();
+};
+
+AN_API ShaderIncludeCache &GetShaderIncludeCache();
+
+}
+
+#endif//OJOIE_SHADERINCLUDECACHE_HPP
@@ -0,0 +1,103 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_SHADERKEYWORDS_HPP
+#define OJOIE_SHADERKEYWORDS_HPP
+
+#include <ojoie/Core/Name.hpp>
+#include <ojoie/ShaderLab/ShaderInfo.hpp>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace AN {
+
+inline constexpr UInt32 kMaxShaderKeywords = 256;
+
+/// index of a keyword in every ShaderKeywordSet, keywords are registered on first use and never removed,
+/// -1 when all kMaxShaderKeywords are taken, thread safe
+AN_API int GetShaderKeywordIndex(const Name &keyword);
+
+/// enabled keywords of a material or of the globals, one bit per keyword index
+class ShaderKeywordSet {
+    UInt64 m_Bits[kMaxShaderKeywords / 64];
+
+public:
+    ShaderKeywordSet() : m_Bits() {}
+
+    void enable(UInt32 index) { m_Bits[index >> 6] |= 1ULL << (index & 63); }
+    void disable(UInt32 index) { m_Bits[index >> 6] &= ~(1ULL << (index & 63)); }
+    bool isEnabled(UInt32 index) const { return (m_Bits[index >> 6] >> (index & 63)) & 1; }
+
+    void reset() { *this = ShaderKeywordSet(); }
+
+    ShaderKeywordSet operator|(const ShaderKeywordSet &other) const {
+        ShaderKeywordSet result;
+        for (int i = 0; i < std::size(m_Bits); ++i) result.m_Bits[i] = m_Bits[i] | other.m_Bits[i];
+        return result;
+    }
+
+    bool operator==(const ShaderKeywordSet &other) const = default;
+};
+
+/// one variant of a shader named by its keywords, entry of a collected variant list
+struct ShaderVariant {
+    UInt32            subShader;
+    UInt32            pass;
+    std::vector<Name> keywords;
+
+    constexpr static const char* GetTypeString() { return "ShaderVariant"; }
+    constexpr static bool MightContainIDPtr() { return false; }
+
+    template<typename Coder>
+    void transfer(Coder &coder) {
+        TRANSFER(subShader);
+        TRANSFER(pass);
+        TRANSFER(keywords);
+    }
+};
+
+/// keywords declared by one pass, maps a keyword set to the variant mask of the pass,
+/// bit i of a mask is the i-th keyword of the declarations with "_" skipped
+class AN_API ShaderKeywordSpace {
+
+    struct Declaration {
+        UInt32 firstBit;
+        UInt32 bitCount;
+        bool   bNoneDefault;     // "_" is the first choice
+        bool   bShaderFeature;
+    };
+
+    std::vector<Declaration> m_Declarations;
+    std::vector<int>         m_KeywordIndices; // keyword index of each bit
+    std::vector<Name>        m_Keywords;       // keyword of each bit
+
+public:
+
+    /// false when the declarations hold more than kMaxPassKeywords keywords
+    bool init(std::span<const ShaderLab::KeywordDeclaration> declarations);
+
+    bool   empty() const { return m_Keywords.empty(); }
+    UInt32 getKeywordCount() const { return m_Keywords.size(); }
+    const Name &getKeyword(UInt32 bit) const { return m_Keywords[bit]; }
+
+    /// each declaration takes its first enabled keyword, or its first choice when none is enabled
+    UInt64 getMask(const ShaderKeywordSet &keywords) const;
+    UInt64 getMask(std::span<const Name> keywords) const;
+
+    /// the variant of a material without keywords
+    UInt64 getDefaultMask() const { return getMask(ShaderKeywordSet()); }
+
+    /// keywords of the mask, the names are interned so the strings stay valid
+    void getKeywords(UInt64 mask, std::vector<Name> &outKeywords) const;
+    void getDefines(UInt64 mask, std::vector<const char *> &outDefines) const;
+
+    /// every combination of the declarations, shader_feature declarations are left at their first choice
+    /// unless includeShaderFeatures is set
+    void getAllMasks(std::vector<UInt64> &outMasks, bool includeShaderFeatures = false) const;
+};
+
+}
+
+#endif//OJOIE_SHADERKEYWORDS_HPP
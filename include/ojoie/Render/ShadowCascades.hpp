@@ -0,0 +1,79 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_SHADOWCASCADES_HPP
+#define OJOIE_SHADOWCASCADES_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Math/Math.hpp>
+#include <ojoie/Math/AABB.hpp>
+#include <span>
+#include <vector>
+
+namespace AN {
+
+enum { kMaxShadowCascades = 4 };
+
+/// left, right, bottom, top, far, the near plane is dropped so the volume extends toward the light
+enum { kShadowCascadeCullingPlaneCount = 5 };
+
+enum ShadowCascadeSplitMode {
+    kShadowCascadeSplitLogarithmic = 0, // practical split scheme, blend uniform and logarithmic by splitLambda
+    kShadowCascadeSplitManual           // use manualSplits
+};
+
+struct ShadowCascadeSettings {
+    UInt32                 cascadeCount;
+    UInt32                 resolution;     // resolution of one cascade
+    float                  shadowDistance; // shadows are not rendered beyond this distance from camera
+    ShadowCascadeSplitMode splitMode;
+    float                  splitLambda;    // 0 uniform, 1 logarithmic
+    float                  manualSplits[kMaxShadowCascades - 1]; // normalized to shadowDistance, ascending
+};
+
+struct ShadowCascadeViewParams {
+    Matrix4x4f cameraToWorld;
+    float      fovyRadians;
+    float      aspect;
+    float      nearZ;
+    float      farZ;
+    Vector3f   lightDirection; // normalized, pointing toward the light
+};
+
+struct ShadowCascade {
+    Matrix4x4f  view;
+    Matrix4x4f  proj;
+    Vector4f    splitSphere; // xyz world center, w radius
+    float       splitNear;
+    float       splitFar;
+    float       texelSize;   // world size of one shadow map texel
+    UInt32      tileX;       // tile in the shadow atlas
+    UInt32      tileY;
+    Math::Plane cullingPlanes[kShadowCascadeCullingPlaneCount];
+};
+
+/// cascade count cannot exceed kMaxShadowCascades, outSplits receive cascadeCount + 1 distances
+AN_API void ComputeShadowCascadeSplits(const ShadowCascadeSettings &settings, float nearZ, float farZ, float *outSplits);
+
+/// fit one light space box for every split, cascades are texel snapped so they do not shimmer
+/// when the camera moves, returns the cascade count written to outCascades
+AN_API UInt32 ComputeShadowCascades(const ShadowCascadeSettings &settings,
+                                    const ShadowCascadeViewParams &viewParams,
+                                    ShadowCascade *outCascades);
+
+/// append index of every caster intersecting the cascade volume to outIndices
+AN_API void CullShadowCasters(const ShadowCascade &cascade, std::span<const AABB> casterBounds, std::vector<UInt32> &outIndices);
+
+/// move the near plane toward the light until it includes all the casters
+AN_API void FitShadowCascadeDepth(ShadowCascade &cascade, std::span<const AABB> casterBounds, std::span<const UInt32> indices);
+
+/// cascades are packed in a 2x2 atlas when there are more than one
+inline UInt32 GetShadowAtlasTilesPerRow(UInt32 cascadeCount) { return cascadeCount > 1 ? 2 : 1; }
+
+/// world to shadow map uv and depth, including the atlas tile scale and offset
+AN_API Matrix4x4f GetShadowCascadeWorldToShadow(const ShadowCascade &cascade, UInt32 cascadeCount);
+
+}
+
+#endif//OJOIE_SHADOWCASCADES_HPP
@@ -0,0 +1,48 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_SKYLINEPACKER_HPP
+#define OJOIE_SKYLINEPACKER_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <vector>
+
+namespace AN {
+
+/// packs rectangles bottom left into a fixed size area, keeps only the top edge of the packed rectangles,
+/// rectangles cannot be freed one by one, reset clears the whole area
+class AN_API SkylinePacker {
+
+    struct Node {
+        UInt32 x, y, width;
+    };
+
+    UInt32            _width, _height;
+    UInt64            _usedArea;
+    std::vector<Node> _skyline;
+
+    /// y where a rectangle starting at node index rests, false if it does not fit
+    bool fit(size_t index, UInt32 width, UInt32 height, UInt32 &outY) const;
+
+public:
+
+    SkylinePacker() : _width(), _height(), _usedArea() {}
+    SkylinePacker(UInt32 width, UInt32 height) { reset(width, height); }
+
+    void reset(UInt32 width, UInt32 height);
+    void reset() { reset(_width, _height); }
+
+    /// return false if the rectangle does not fit
+    bool pack(UInt32 width, UInt32 height, UInt32 &outX, UInt32 &outY);
+
+    UInt32 getWidth() const { return _width; }
+    UInt32 getHeight() const { return _height; }
+
+    /// packed area over the whole area
+    float getOccupancy() const { return _width && _height ? (float) _usedArea / ((float) _width * (float) _height) : 0.f; }
+};
+
+}
+
+#endif//OJOIE_SKYLINEPACKER_HPP
@@ -0,0 +1,145 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_TEXTLAYOUT_HPP
+#define OJOIE_TEXTLAYOUT_HPP
+
+#include <ojoie/Render/GlyphCache.hpp>
+#include <ojoie/Render/VertexData.hpp>
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AN {
+
+class CommandBuffer;
+
+/// same layout as the IMGUI vertex, y grows down
+struct TextVertex {
+    float  x, y;
+    float  u, v;
+    UInt32 color;
+};
+
+struct TextStyle {
+    FontID font      = 0;
+    UInt16 pixelSize = 16;
+    bool   bSDF      = false;
+    float  wrapWidth = 0.f; // break lines at spaces to stay in this width, 0 does not wrap
+};
+
+/// quads of one glyph page
+struct TextRun {
+    UInt32 page;
+    UInt32 pageGeneration; // the run is stale once the glyph cache evicts the page
+    UInt32 firstVertex;
+    UInt32 vertexCount;
+};
+
+struct TextLayout {
+    std::vector<TextVertex> vertices; // four per glyph, grouped by page, white, the origin is the top left
+    std::vector<TextRun>    runs;
+    float                   width, height;
+    UInt32                  lineCount;
+    bool                    bComplete; // false while glyphs are rasterizing, such a layout is not cached
+};
+
+struct TextLayoutStats {
+    UInt32 hits;
+    UInt32 misses;
+    UInt32 evictions;
+    UInt32 invalidations; // cached layouts whose glyph page was evicted
+};
+
+/// positioned glyph quads of recent strings, least recently used layouts are evicted past maxLayouts,
+/// use it on the thread of the glyph cache
+class AN_API TextLayoutCache {
+
+    /// text views the string of the entry, or the string looked up
+    struct Key {
+        std::string_view text;
+        TextStyle        style;
+
+        bool operator == (const Key &other) const {
+            return text == other.text && style.font == other.style.font && style.pixelSize == other.style.pixelSize &&
+                   style.bSDF == other.style.bSDF && style.wrapWidth == other.style.wrapWidth;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator () (const Key &key) const;
+    };
+
+    struct Entry {
+        std::string text;
+        TextStyle   style;
+        TextLayout  layout;
+    };
+
+    struct PlacedGlyph {
+        const CachedGlyph *glyph;
+        float              x;
+        UInt32             line;
+    };
+
+    typedef std::list<Entry> EntryList;
+
+    GlyphCache     *_glyphCache;
+    UInt32          _maxLayouts;
+    TextLayoutStats _stats;
+
+    EntryList                                            _entries; // most recent first
+    std::unordered_map<Key, EntryList::iterator, KeyHash> _lookup;
+    TextLayout                                           _incomplete;
+    std::vector<PlacedGlyph>                             _placed;
+    std::vector<UInt32>                                  _pageVertexCounts;
+
+    bool isValid(const TextLayout &layout) const;
+    void build(std::string_view text, const TextStyle &style, TextLayout &outLayout);
+
+public:
+
+    explicit TextLayoutCache(GlyphCache *glyphCache, UInt32 maxLayouts = 1024);
+
+    TextLayoutCache(const TextLayoutCache &) = delete;
+    TextLayoutCache &operator = (const TextLayoutCache &) = delete;
+
+    /// text is UTF-8, valid until the next layout call,
+    /// glyphs still rasterizing are left out and the text is laid out again next time
+    const TextLayout &layout(std::string_view text, const TextStyle &style);
+
+    void clear();
+
+    UInt32 getLayoutCount() const { return (UInt32) _entries.size(); }
+    const TextLayoutStats &getStats() const { return _stats; }
+};
+
+/// quads of the text drawn in a frame, one vertex array per glyph page
+class AN_API TextBatch {
+
+    std::vector<std::vector<TextVertex>> _pages;
+
+public:
+
+    /// copy the layout quads at x, y
+    void add(const TextLayout &layout, float x, float y, UInt32 color = 0xFFFFFFFF);
+
+    void clear();
+
+    UInt32 getPageCount() const { return (UInt32) _pages.size(); }
+    const std::vector<TextVertex> &getVertices(UInt32 page) const { return _pages[page]; }
+
+    static const ChannelInfoArray &GetChannelInfo();
+
+    /// draw the quads of a page from the dynamic vertex buffer of the command buffer,
+    /// the material sampling the page texture is applied by the caller
+    void draw(CommandBuffer *commandBuffer, UInt32 page) const;
+};
+
+}
+
+#endif//OJOIE_TEXTLAYOUT_HPP
@@ -6,6 +6,10 @@
 #define OJOIE_TEXTURE2D_HPP
 
 #include <ojoie/Render/Texture.hpp>
+#include <ojoie/Render/MipChain.hpp>
+#include <ojoie/Render/TextureCompressor.hpp>
+#include <ojoie/Render/TextureStreamer.hpp>
+#include <ojoie/Render/AsyncTextureLoader.hpp>
 
 namespace AN {
 
@@ -15,7 +19,7 @@ protected:
 
     struct TextureData {
         UInt8      *data;
-        size_t      size;
+        size_t      size;   // all mip levels, see CalculateMipChainSize
         UInt32      width, height;
         UInt32      mipmapLevel;
         PixelFormat pixelFormat;
@@ -24,9 +28,23 @@ protected:
     bool bIsReadable;
     bool bUploadToGPU;
     bool bSizeChanged;
+    bool bStreaming;
+
+    /// where the finer levels of a streamed texture come from when its CPU chain was released
+    struct StreamingSource {
+        std::string path;      // asset the texture was loaded from
+        UInt64      localID;
+        UInt8      *data;      // levels [firstMip, mipCount) read on the streaming thread
+        UInt32      firstMip;
+        UInt32      residentMip; // first level on the GPU
+    };
+
+    StreamingTextureID m_StreamingID;
+    StreamingSource    m_StreamingSource;
 
     TextureData	_texData;
     SamplerDescriptor _samplerDescriptor;
+    MipChainSettings  _mipChainSettings;
 
     AN_CLASS(Texture2D, Texture)
     AN_OBJECT_SERIALIZE(Texture2D)
@@ -37,6 +55,11 @@ public:
 
     explicit Texture2D(ObjectCreationMode mode);
 
+    /// decode the file on the texture loader threads, the texture is created, named after the file
+    /// and uploaded before completion runs in GetAsyncTextureLoader().update, nullptr if the file could not be loaded
+    static TextureLoadID LoadAsync(const char *path, const AsyncTextureLoadOptions &options,
+                                   std::function<void(Texture2D *)> completion);
+
     /// TextureDescriptor set the format and initial size of the texture2D
     virtual bool init(const TextureDescriptor &desc,
                       const SamplerDescriptor &samplerDescriptor = DefaultSamplerDescriptor());
@@ -45,24 +68,65 @@ public:
 
     virtual void dealloc() override;
 
+    virtual size_t getRuntimeMemorySize() const override;
+
     virtual void uploadToGPU(bool generateMipmap = false);
 
     /// texture2D default is not readable
     void setReadable(bool readable) { bIsReadable = readable; }
     bool isReadable() const { return bIsReadable; }
 
+    /// a streamed texture uploads its coarse levels first and the texture streamer adds the finer ones
+    /// when renderers need them, a texture loaded from an asset that is not readable then releases its CPU chain
+    /// and the finer levels are read from the asset again, takes effect at the next uploadToGPU, D3D11 only
+    void setStreaming(bool streaming) { bStreaming = streaming; }
+    bool isStreaming() const { return bStreaming; }
+
+    /// kInvalidStreamingTextureID until a streamed texture is uploaded
+    StreamingTextureID getStreamingID() const { return m_StreamingID; }
+
+    /// first level on the GPU, 0 if the texture is not streamed
+    UInt32 getResidentMip() const { return m_StreamingID != kInvalidStreamingTextureID ? m_StreamingSource.residentMip : 0; }
+
+    /// called by the texture streamer, see TextureStreamingBackend
+    void prepareStreamedMips();
+    bool loadStreamedMips(UInt32 firstMip);
+    void applyStreamedMips(UInt32 firstMip);
+    void discardStreamedMips();
+
     UInt32 getDataWidth() const { return _texData.width; }
     UInt32 getDataHeight() const { return _texData.height; }
 
+    /// size of the first level
     UInt32 getDataSize() const;
 
     /// resize will cause uploaded GPU texture to become invalid
     void resize(UInt32 width, UInt32 height);
 
+    /// set the first level, the lower levels are filtered from it on the CPU,
+    /// compressed formats take all levels
     void setPixelData(const UInt8 *data);
 
+    /// set all levels laid out as CalculateMipOffset describes
+    void setMipChainData(const UInt8 *data);
+
     void *getPixelData() const { return _texData.data; }
 
+    UInt32 getMipCount() const { return _texData.mipmapLevel; }
+
+    void *getMipData(UInt32 level) const;
+
+    void setMipChainSettings(const MipChainSettings &settings) { _mipChainSettings = settings; }
+    const MipChainSettings &getMipChainSettings() const { return _mipChainSettings; }
+
+    /// rebuild the lower levels after writing the first level through getPixelData,
+    /// formats GenerateMipChain cannot filter drop to a single level
+    bool buildMipChain();
+
+    /// encode all levels to settings.format, the serialized texture then uploads as it is,
+    /// D3D11 needs the size to be a multiple of 4
+    bool compress(const TextureCompressionSettings &settings);
+
     PixelFormat getPixelFormat() const { return _texData.pixelFormat; }
 
 };
@@ -0,0 +1,48 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_TEXTURECOMPRESSOR_HPP
+#define OJOIE_TEXTURECOMPRESSOR_HPP
+
+#include <ojoie/Render/Image.hpp>
+
+namespace AN {
+
+enum TextureCompressionQuality {
+    kTextureCompressionQualityFast = 0, // principal axis endpoints only
+    kTextureCompressionQualityNormal,   // least squares endpoint refinement
+    kTextureCompressionQualityHigh,     // refinement and endpoint search, several times slower
+    kTextureCompressionQualityCount
+};
+
+struct TextureCompressionSettings {
+    /// BC1, BC3, BC4 (RUnorm), BC5 (RGUnorm) or BC7, sRGB variants keep the source encoding
+    PixelFormat               format  = kPixelFormatBC1_RGBA;
+    TextureCompressionQuality quality = kTextureCompressionQualityNormal;
+
+    /// the source holds tangent space normals, texels are renormalized before encoding,
+    /// BC5 keeps XY only and needs UnpackNormalRG in the shader
+    bool bNormalMap = false;
+};
+
+/// sources are 8 bit R, RG and RGBA formats, BC7 is written in mode 6 only
+AN_API bool IsTextureCompressionSupported(PixelFormat srcFormat, PixelFormat dstFormat);
+
+/// BC4 or BC5 for one or two channels, BC1 for opaque color and normal maps, BC3 when alpha is used,
+/// BC7 in place of BC1 and BC3 at high quality
+AN_API PixelFormat SelectCompressedPixelFormat(const UInt8 *src, UInt32 width, UInt32 height, PixelFormat srcFormat,
+                                               bool bNormalMap, TextureCompressionQuality quality);
+
+/// encode mipCount levels laid out as CalculateMipOffset describes,
+/// rows of 4x4 blocks are encoded on the worker threads
+AN_API bool CompressTexture(const UInt8 *src, PixelFormat srcFormat, UInt32 width, UInt32 height, UInt32 mipCount,
+                            UInt8 *dst, const TextureCompressionSettings &settings);
+
+/// decode one level to RGBA8, missing channels read 0 and alpha 255,
+/// BC7 blocks in other modes than 6 are not decoded
+AN_API bool DecompressTexture(const UInt8 *src, PixelFormat format, UInt32 width, UInt32 height, UInt8 *dstRGBA);
+
+}
+
+#endif//OJOIE_TEXTURECOMPRESSOR_HPP
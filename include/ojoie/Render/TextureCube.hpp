@@ -22,6 +22,8 @@ public:
     virtual bool init(const TextureDescriptor &desc,
                       const SamplerDescriptor &samplerDescriptor = DefaultSamplerDescriptor()) override;
 
+    virtual bool initAfterDecode() override;
+
     void setSourceTexture(UInt32 index, Texture2D *tex);
 
     virtual void uploadToGPU(bool generateMipmap) override;
@@ -16,18 +16,23 @@ class AN_API LoadTextureResult {
     UInt32 width, height;
     PixelFormat pixelFormat;
     UInt32 mipmapLevel;
+    UInt32 dataMipCount;
+
+    void release();
 public:
     LoadTextureResult() = default;
     LoadTextureResult(bool stbFree,
                       UInt8 *data,
                       UInt32 width, UInt32 height,
                       PixelFormat pixelFormat,
-                      UInt32 mipmapLevel)
+                      UInt32 mipmapLevel,
+                      UInt32 dataMipCount = 1)
         : stb_free(stbFree),
           data(data),
           width(width), height(height),
           pixelFormat(pixelFormat),
-          mipmapLevel(mipmapLevel) {}
+          mipmapLevel(mipmapLevel),
+          dataMipCount(dataMipCount) {}
 
     LoadTextureResult(LoadTextureResult &&other) noexcept
         : stb_free(other.stb_free),
@@ -35,10 +40,26 @@ public:
           width(other.width),
           height(other.height),
           pixelFormat(other.pixelFormat),
-          mipmapLevel(other.mipmapLevel) {
+          mipmapLevel(other.mipmapLevel),
+          dataMipCount(other.dataMipCount) {
         other.data = nullptr;
     }
 
+    LoadTextureResult &operator = (LoadTextureResult &&other) noexcept {
+        if (this != &other) {
+            release();
+            stb_free     = other.stb_free;
+            data         = other.data;
+            width        = other.width;
+            height       = other.height;
+            pixelFormat  = other.pixelFormat;
+            mipmapLevel  = other.mipmapLevel;
+            dataMipCount = other.dataMipCount;
+            other.data   = nullptr;
+        }
+        return *this;
+    }
+
     ~LoadTextureResult();
 
     bool isValid() const { return data != nullptr; }
@@ -47,6 +68,9 @@ public:
     PixelFormat getPixelFormat() const { return pixelFormat; }
     UInt32      getMipmapLevel() const { return mipmapLevel; }
 
+    /// levels held by data, 1 unless the chain was built at load
+    UInt32      getDataMipCount() const { return dataMipCount; }
+
     UInt32 getWidth() const { return width; }
     UInt32 getHeight() const { return height; }
 };
@@ -54,16 +78,23 @@ public:
 enum ImageEncodeType {
     kImageEncodeTypePNG,
     kImageEncodeTypeJPG,
-    kImageEncodeTypeBMP
+    kImageEncodeTypeBMP,
+    kImageEncodeTypeTGA
 };
 
 
 namespace TextureLoader {
 
-/// \RenderActor
-AN_API LoadTextureResult LoadTexture(const char *path, bool sRgb = true);
+/// the file is read in one block, thread safe so it may run on worker threads,
+/// RGB and gray alpha images expand to RGBA,
+/// bBuildMipChain filters all levels into the result so the texture uploads without more work
+AN_API LoadTextureResult LoadTexture(const char *path, bool sRgb = true, bool bBuildMipChain = false);
+
+AN_API LoadTextureResult LoadTextureFromMemory(const unsigned char *mem, unsigned int len, bool sRgb = true,
+                                               bool bBuildMipChain = false);
 
-AN_API LoadTextureResult LoadTextureFromMemory(const unsigned char *mem, unsigned int len, bool sRgb = true);
+/// count texels of 3 bytes to 4 bytes with alpha 255
+AN_API void ExpandRGBToRGBA(const UInt8 *src, UInt8 *dst, size_t count);
 
 /// \param quality compressed format quality
 AN_API bool EncodeTexture(const char     *path,
@@ -0,0 +1,165 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_TEXTURESTREAMER_HPP
+#define OJOIE_TEXTURESTREAMER_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <ojoie/Render/RenderTypes.hpp>
+#include <ojoie/Threads/SpinLock.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AN {
+
+typedef UInt32 StreamingTextureID;
+inline static constexpr StreamingTextureID kInvalidStreamingTextureID = 0xFFFFFFFF;
+
+/// finest mip level a texture needs, uvDistributionMetric is the world area covered by one unit of uv area,
+/// screenPixelScale is the pixels one world unit covers at distance one
+AN_API float CalculateRequiredMip(float uvDistributionMetric, UInt32 width, UInt32 height,
+                                  float distance, float screenPixelScale);
+
+/// makes mip levels of a streamed texture resident, levels [firstMip, mipCount) are resident after applyMips
+class TextureStreamingBackend {
+public:
+    virtual ~TextureStreamingBackend() = default;
+
+    /// called in TextureStreamer::update before the load is queued, capture what loadMips reads
+    virtual void prepareLoad(void *texture, UInt32 firstMip) {}
+
+    /// called on the streaming thread, read or decode the levels so that applyMips does not wait,
+    /// return false if they cannot be loaded
+    virtual bool loadMips(void *texture, UInt32 firstMip) = 0;
+
+    /// called in TextureStreamer::update, both to use loaded levels and to evict finer ones
+    virtual void applyMips(void *texture, UInt32 firstMip) = 0;
+
+    /// a finished load is not applied since the target became coarser, free what loadMips read
+    virtual void discardMips(void *texture) {}
+};
+
+struct StreamingTextureDescriptor {
+    UInt32      width, height;
+    UInt32      mipCount;
+    PixelFormat pixelFormat;
+};
+
+struct TextureStreamingSettings {
+    UInt64 memoryBudget     = 512ULL << 20; // bytes of all streamed levels resident at once
+    UInt32 residentSize     = 64;           // levels up to this size are always resident
+    UInt32 maxLoadsInFlight = 4;
+    UInt32 requestFrames    = 60;           // a texture not requested for this many frames drops to its resident levels
+    float  mipBias          = 0.f;          // greater loads coarser levels
+    bool   bAsync           = true;         // load on the streaming thread, otherwise in update
+};
+
+struct TextureStreamingStats {
+    UInt64 residentMemory;
+    UInt64 requestedMemory;  // if every request was met
+    UInt32 textureCount;
+    UInt32 loadsInFlight;
+    UInt32 reducedTextures;  // textures held coarser than requested to stay in the budget
+    UInt32 loads;            // totals since the streamer started
+    UInt32 evictions;
+};
+
+/// keeps the coarse levels of streamed textures resident and loads the finer ones renderers ask for,
+/// requests are taken from any thread, update runs once a frame on the game thread
+class AN_API TextureStreamer {
+
+    struct Entry {
+        void                     *texture;
+        TextureStreamingBackend  *backend;
+        StreamingTextureDescriptor desc;
+        UInt32 generation;
+        UInt32 baseMip;          // always resident
+        UInt32 residentMip;
+        UInt32 requestedMip;     // finest request since the last update
+        UInt32 lastRequestedMip;
+        UInt32 targetMip;        // after the budget
+        UInt32 lastRequestFrame;
+        bool   bUsed;
+        bool   bRequested;
+        bool   bLoading;
+    };
+
+    struct Load {
+        StreamingTextureID       id;
+        UInt32                   generation;
+        UInt32                   firstMip;
+        void                    *texture;
+        TextureStreamingBackend *backend;
+        bool                     bSucceeded;
+    };
+
+    TextureStreamingSettings _settings;
+    TextureStreamingStats    _stats;
+    UInt32                   _frame;
+
+    std::vector<Entry>              _entries;
+    std::vector<StreamingTextureID> _freeIDs;
+    SpinLock                        _entryLock; // guards requests against add and remove
+
+    std::thread             _thread;
+    std::mutex              _loadMutex;
+    std::condition_variable _loadCondition;
+    std::condition_variable _completeCondition;
+    std::deque<Load>        _pendingLoads;
+    std::vector<Load>       _completedLoads;
+    UInt32                  _runningLoads;
+    bool                    bStop;
+
+    UInt64 levelsSize(const Entry &entry, UInt32 firstMip) const;
+    void   applyCompletedLoads();
+    void   applyLoad(const Load &load);
+    void   issueLoads();
+    void   waitLoadsOf(StreamingTextureID id);
+    void   streamingThread();
+
+public:
+
+    TextureStreamer();
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer &) = delete;
+    TextureStreamer &operator = (const TextureStreamer &) = delete;
+
+    void setSettings(const TextureStreamingSettings &settings) { _settings = settings; }
+    const TextureStreamingSettings &getSettings() const { return _settings; }
+
+    /// registers a texture and applies its always resident levels
+    StreamingTextureID addTexture(const StreamingTextureDescriptor &desc, TextureStreamingBackend *backend, void *texture);
+
+    /// waits for a load of the texture in flight, the backend is not called for it afterwards
+    void removeTexture(StreamingTextureID id);
+
+    /// ask for levels down to mip for this frame, thread safe
+    void requestMip(StreamingTextureID id, float mip);
+
+    /// apply finished loads, fit the requests into the budget, evict and start loads
+    void update(UInt32 frameIndex);
+
+    /// wait for all loads in flight and apply them
+    void flush();
+
+    /// stop the streaming thread, pending loads are dropped
+    void shutdown();
+
+    UInt32 getResidentMip(StreamingTextureID id) const;
+    UInt32 getTargetMip(StreamingTextureID id) const;
+    UInt32 getBaseMip(StreamingTextureID id) const;
+
+    const TextureStreamingStats &getStats() const { return _stats; }
+};
+
+AN_API TextureStreamer &GetTextureStreamer();
+
+}
+
+#endif//OJOIE_TEXTURESTREAMER_HPP
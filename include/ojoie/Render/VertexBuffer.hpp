@@ -28,10 +28,11 @@ struct VertexBufferData {
     int              vertexCount;
 };
 
-/// indices must UInt16
+/// indices are UInt16 or UInt32 according to format
 struct IndexBufferData {
     const void *indices;
     int         count;
+    IndexFormat format = kIndexFormatUInt16;
 };
 
 
@@ -40,6 +41,7 @@ protected:
     ChannelInfoArray     m_ChannelInfo;
     StreamMode      _streamModes[kMaxVertexStreams];
     bool            _indicesDynamic;
+    IndexFormat     _indexFormat;
     StreamInfoArray _streams;
 
 public:
@@ -51,6 +53,7 @@ public:
             _streams[i].reset();
         }
         _indicesDynamic = false;
+        _indexFormat    = kIndexFormatUInt16;
     }
 
     virtual bool init()   = 0;
@@ -73,6 +76,8 @@ public:
 
     virtual void updateIndexData(const IndexBufferData &buffer) = 0;
 
+    IndexFormat getIndexFormat() const { return _indexFormat; }
+
     /// bind buffer and draw indexed
     virtual void drawIndexed(AN::CommandBuffer *commandBuffer, UInt32 indexCount,
                              UInt32 indexOffset, UInt32 vertexOffset) = 0;
@@ -90,12 +95,13 @@ static inline int CalculateVertexStreamSize(const VertexBufferData &buffer, unsi
     return CalculateVertexStreamSize(buffer.streams[stream], buffer.vertexCount);
 }
 
+/// index size of dynamic vertex buffers, which always use 16 bit indices
 static constexpr int kVBOIndexSize = sizeof(UInt16);
 
 inline int CalculateIndexBufferSize(const IndexBufferData &buffer) {
     int size = 0;
     if (buffer.indices)
-        size += buffer.count * kVBOIndexSize;
+        size += buffer.count * GetIndexFormatSize(buffer.format);
     return size;
 }
 
@@ -94,6 +94,10 @@ public:
     static VertexStreamsLayout kVertexStreamsDefault;
     static VertexChannelsLayout kVertexChannelsDefault;
 
+    /// default layout with the channels in compressedChannels replaced by their compressed format,
+    /// unorm16 positions, octahedral normals and tangents, half texcoords
+    static VertexChannelsLayout GetCompressedChannelsLayout(UInt32 compressedChannels);
+
 
 protected:
     ChannelInfoArray m_Channels;
@@ -107,6 +111,10 @@ protected:
     uint32_t m_VertexCount;
     size_t   m_DataSize;
 
+    /// quantized positions decode to unorm * scale + offset
+    Vector3f m_PositionScale;
+    Vector3f m_PositionOffset;
+
     static size_t AlignStreamSize(size_t size) { return (size + (kVertexStreamAlign-1)) & ~(kVertexStreamAlign-1); }
 
 public:
@@ -136,6 +144,29 @@ public:
     size_t getChannelOffset (unsigned channel) const { return m_Channels[channel].calcOffset(m_Streams); }
     size_t getChannelStride (unsigned channel) const { return m_Channels[channel].calcStride(m_Streams); }
 
+    /// channel stored in another format than the default float layout
+    bool isChannelCompressed(ShaderChannel channel) const {
+        return hasChannel(channel) && m_Channels[channel].format != kVertexChannelsDefault.channels[channel].format;
+    }
+
+    const Vector3f &getPositionScale() const { return m_PositionScale; }
+    const Vector3f &getPositionOffset() const { return m_PositionOffset; }
+
+    /// set before positions are converted to unorm16, changing it afterwards moves the decoded positions
+    void setPositionQuantization(const Vector3f &scale, const Vector3f &offset) {
+        m_PositionScale  = scale;
+        m_PositionOffset = offset;
+    }
+
+    /// decode a vertex of a channel of any format, missing components are 0
+    Vector4f getChannelValue(ShaderChannel channel, size_t index) const;
+
+    /// decode a channel of any format into vertexCount * dimension floats
+    void extractChannel(ShaderChannel channel, float *dst, UInt32 dimension) const;
+
+    /// encode vertexCount * dimension floats into a channel of any format
+    void writeChannel(ShaderChannel channel, const float *src, UInt32 dimension);
+
     bool conformsToStreamsLayout(const VertexStreamsLayout& streams) const;
     bool conformsToChannelsLayout(const VertexChannelsLayout& channels) const;
 
@@ -185,6 +216,17 @@ public:
 
 size_t GetChannelFormatSize(uint8_t format);
 
+/// octahedral mapping of a unit direction to [-1, 1]^2
+AN_API Vector2f OctahedralEncode(const Vector3f &direction);
+AN_API Vector3f OctahedralDecode(const Vector2f &encoded);
+
+/// shader side decode parameters of a compressed mesh, see an_VertexCompression in Input.hlsl
+struct VertexCompressionData {
+    Vector4f compression;   // x quantized positions, y octahedral normals, z octahedral tangents
+    Vector4f positionScale;
+    Vector4f positionOffset;
+};
+
 }// namespace AN
 
 template<>
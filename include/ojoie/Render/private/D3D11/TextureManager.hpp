@@ -67,9 +67,15 @@ public:
 
     void uploadTexture2D(TextureID tid, const UInt8 *srcData,
                          UInt32 width, UInt32 height,
-                         PixelFormat format, bool generateMipmap,
+                         PixelFormat format, UInt32 mipCount, bool generateMipmap,
                          const SamplerDescriptor &samplerDescriptor);
 
+    /// make tid a texture of mipCount levels with a width x height first level, the levels it already has
+    /// are the coarsest ones and are copied on the GPU, srcData holds the finer levels it does not have, if any
+    void updateTexture2DMips(TextureID tid, const UInt8 *srcData,
+                             UInt32 width, UInt32 height,
+                             PixelFormat format, UInt32 mipCount);
+
     void uploadTextureCube(TextureID tid, UInt8 *srcData, UInt32 faceSize, UInt32 size,
                            PixelFormat format,
                            bool generateMipmap,
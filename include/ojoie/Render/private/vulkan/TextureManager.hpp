@@ -98,7 +98,7 @@ public:
 
     void uploadTexture2D(TextureID tid, const UInt8 *srcData,
                          UInt32 width, UInt32 height,
-                         PixelFormat format, bool generateMipmap,
+                         PixelFormat format, UInt32 mipCount, bool generateMipmap,
                          const SamplerDescriptor &samplerDescriptor);
 
     void registerRenderTarget(TextureID id, const Texture &tex);
@@ -13,7 +13,7 @@ namespace AN::VK {
 
 
 /// lazily allocated until you update
-/// abstraction of vertex buffer and index buffer, index will use UInt16 no matter what
+/// abstraction of vertex buffer and index buffer, index format follows the uploaded IndexBufferData
 /// when use dynamic vertexBuffer, you cannot update after draw in the same frame, this will override it
 class VertexBuffer : public VertexBufferImpl {
     typedef VertexBufferImpl Super;
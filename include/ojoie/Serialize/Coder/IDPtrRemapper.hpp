@@ -57,6 +57,8 @@ public:
         }
     }
 
+    void setError() {}
+
     void PushMetaFlag (int flag) {}
     void PopMetaFlag () {}
     void AddMetaFlag(int mask) {}
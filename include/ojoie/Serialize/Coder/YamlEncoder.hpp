@@ -50,6 +50,10 @@ public:
     void outputToStream(OutputStream &outputStream);
     void outputToString(std::string &str);
 
+    /// an object can not be encoded, nothing is output afterwards
+    void setError() { _error = true; }
+    bool hasError() const { return _error; }
+
     void startSequence();
 
     template<typename T>
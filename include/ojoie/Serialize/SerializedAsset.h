@@ -7,6 +7,11 @@
 #include <ojoie/Object/Object.hpp>
 #include <ojoie/Core/UUID.hpp>
 #include <ojoie/Serialize/SerializeManager.hpp>
+#include <ojoie/Serialize/Coder/YamlDecoder.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
 
 namespace AN
 {
@@ -40,6 +45,26 @@ struct ObjectMeta
     }
 };
 
+/// an asset file split into its objects, made without the object system so any thread can read and parse it
+struct SerializedAssetData
+{
+    struct ObjectSection
+    {
+        std::string className;
+        UInt64 localID;
+        std::unique_ptr<YamlDecoder> decoder;
+    };
+
+    std::string_view text;     // in place in a mounted archive or in textBuffer
+    std::string_view metaText; // in place in a mounted archive or in metaBuffer
+    std::string textBuffer;
+    std::string metaBuffer;
+    bool bHasMeta = false;
+    ObjectMeta meta;
+    std::vector<ObjectSection> objects;
+    std::vector<std::string> referencedUUIDs; // of other assets the objects point to
+};
+
 class SerializedAsset
 {
     UUID    m_UUID;
@@ -65,6 +90,25 @@ public:
     bool SaveAtPath(const char *path);
     bool LoadAtPath(const char *path);
 
+    /// decode only the document of object, which must have been loaded from the asset at path before
+    bool LoadObjectAtPath(const char *path, Object *object);
+
+    /// read the asset and its meta, from a mounted asset archive if one has them, see ResourceManager::mountArchive
+    static bool ReadAtPath(const char *path, SerializedAssetData &data);
+
+    /// parse only the document of localID in the asset at path, nullptr if there is none,
+    /// made without the object system so any thread can read it
+    static std::unique_ptr<YamlDecoder> DecodeObjectAtPath(const char *path, UInt64 localID);
+
+    /// decode the text ReadAtPath read
+    static bool Parse(SerializedAssetData &data);
+
+    /// create the objects of parsed data, on the main thread
+    void BeginLoad(const char *path, SerializedAssetData &data);
+
+    /// transfer one object created by BeginLoad
+    void LoadObject(SerializedAssetData &data, size_t index);
+
 };
 
 
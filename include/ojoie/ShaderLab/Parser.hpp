@@ -49,12 +49,15 @@ class AN_API Parser {
     bool parseShader(ShaderInfo &info);
     bool parseProperties(ShaderInfo &info);
     bool parseSubShader(ShaderInfo &info);
-    bool parsePass(SubShader &subShader, std::string &outSource);
+    bool parsePass(SubShader &subShader, std::string &outSource, const std::vector<KeywordDeclaration> &includeKeywords);
     bool parseTags(TagMap &tagMap);
     bool parsePassCommands(ShaderPass &pass);
     bool parseHLSLInclude(std::string &outInclude);
     bool parseHLSLSource(std::string &outSource);
 
+    /// move keyword pragmas of the source into declarations, the pragma lines are blanked
+    bool parseKeywordPragmas(std::string &source, std::vector<KeywordDeclaration> &declarations);
+
 public:
 
     explicit Parser(Lexer &aLexer) : lexer(aLexer), _hasError() {
@@ -16,6 +16,25 @@ namespace AN::ShaderLab {
 
 typedef std::unordered_map<Name, Name> TagMap;
 
+/// keywords of one pass, a variant is a mask with one bit per keyword
+inline constexpr UInt32 kMaxPassKeywords = 64;
+
+/// one "#pragma multi_compile" or "#pragma shader_feature" line, exactly one of the keywords is on in a variant,
+/// "_" stands for none of them
+struct KeywordDeclaration {
+    std::vector<Name> keywords;
+    bool              bShaderFeature; // variants are only built when a material uses them
+
+    constexpr static const char* GetTypeString() { return "KeywordDeclaration"; }
+    constexpr static bool MightContainIDPtr() { return false; }
+
+    template<typename Coder>
+    void transfer(Coder &coder) {
+        TRANSFER(keywords);
+        TRANSFER(bShaderFeature);
+    }
+};
+
 struct ShaderPass {
     TagMap tagMap;
 
@@ -35,6 +54,9 @@ struct ShaderPass {
 
     bool ZClip;
 
+    /// declarations of the subShader HLSLINCLUDE first, then of the pass
+    std::vector<KeywordDeclaration> keywordDeclarations;
+
     inline static const char* GetTypeString() { return "ShaderLabPass"; }
 
     template<typename Coder>
@@ -51,6 +73,7 @@ struct ShaderPass {
         TRANSFER(colorWriteMask);
         TRANSFER(cullMode);
         TRANSFER(ZClip);
+        TRANSFER(keywordDeclarations);
     }
 };
 
@@ -0,0 +1,69 @@
+#ifndef AN_CLUSTEREDLIGHTS_HLSL
+#define AN_CLUSTEREDLIGHTS_HLSL
+
+#include "RealtimeLights.hlsl"
+
+// light lists built on CPU every frame, see LightClusters.hpp
+Texture2D<uint>   _ClusterLightGrid;    // x: tile x + tile y * tiles x, y: slice, offset << 8 | count
+Texture2D<uint>   _ClusterLightIndices; // row width is _ClusterLightParams0.w
+Texture2D<float4> _ClusterLightData;    // x: light, y: 0 position range, 1 color spot cos inner, 2 spot direction spot cos outer
+
+CBUFFER_START(ClusteredLights)
+    float4 _ClusterLightParams0; // x: tiles x, y: tiles y, z: slices, w: index row width
+    float4 _ClusterLightParams1; // x: tan half fov x, y: tan half fov y, z: log depth scale, w: log depth bias
+CBUFFER_END
+
+#define CLUSTER_LIGHT_COUNT_BITS 8
+
+// x: first index, y: light count of the cluster containing positionVS
+uint2 GetClusterLightRange(float3 positionVS)
+{
+    float depth = -positionVS.z;
+    float2 ndc = positionVS.xy / (depth * _ClusterLightParams1.xy);
+    if (depth <= 0.0 || any(abs(ndc) > 1.0)) return uint2(0, 0);
+
+    uint3 tiles = uint3(_ClusterLightParams0.xyz);
+    uint2 tile = min(uint2((ndc * 0.5 + 0.5) * float2(tiles.xy)), tiles.xy - 1);
+    int slice = int(floor(log(depth) * _ClusterLightParams1.z + _ClusterLightParams1.w));
+    if (slice >= int(tiles.z)) return uint2(0, 0);
+    slice = max(slice, 0);
+
+    uint packed = _ClusterLightGrid.Load(int3(tile.x + tile.y * tiles.x, slice, 0));
+    return uint2(packed >> CLUSTER_LIGHT_COUNT_BITS, packed & ((1u << CLUSTER_LIGHT_COUNT_BITS) - 1u));
+}
+
+uint GetClusterLightIndex(uint index)
+{
+    uint rowWidth = uint(_ClusterLightParams0.w);
+    return _ClusterLightIndices.Load(int3(index % rowWidth, index / rowWidth, 0));
+}
+
+Light GetClusterLight(uint lightIndex, float3 positionWS)
+{
+    float4 positionRange = _ClusterLightData.Load(int3(lightIndex, 0, 0));
+    float4 colorSpotInner = _ClusterLightData.Load(int3(lightIndex, 1, 0));
+    float4 spotDirOuter = _ClusterLightData.Load(int3(lightIndex, 2, 0));
+
+    float3 lightVector = positionRange.xyz - positionWS;
+    float distanceSqr = max(dot(lightVector, lightVector), 0.0001);
+    float3 lightDirection = lightVector * rsqrt(distanceSqr);
+
+    // smooth window to zero at range
+    float factor = distanceSqr / (positionRange.w * positionRange.w);
+    float smoothFactor = saturate(1.0 - factor * factor);
+    float attenuation = smoothFactor * smoothFactor / distanceSqr;
+
+    // point light has outer cos -2 and inner cos -1, so the spot term is always 1
+    float cd = dot(spotDirOuter.xyz, -lightDirection);
+    attenuation *= saturate((cd - spotDirOuter.w) / max(colorSpotInner.w - spotDirOuter.w, 0.0001));
+
+    Light light;
+    light.direction = half3(lightDirection);
+    light.color = half3(colorSpotInner.rgb);
+    light.distanceAttenuation = attenuation;
+    light.shadowAttenuation = 1.0;
+    light.layerMask = 0xFFFFFFFF;
+    return light;
+}
+
+#endif//AN_CLUSTEREDLIGHTS_HLSL
@@ -46,6 +46,16 @@ cbuffer ANPerDraw {
     float4x4 an_ObjectToWorld;
     float4x4 an_WorldToObject;
 
+    // LOD Fade Feature
+    // X : cross fade weight, negative for the coarser level fading in
+    float4 an_LODFade;
+
+    // Vertex Compression Feature
+    // X : unorm16 positions, Y : octahedral normals, Z : octahedral tangents, 0 when the channel is float
+    float4 an_VertexCompression;
+    float4 an_VertexPositionScale;
+    float4 an_VertexPositionOffset;
+
     // Velocity
     //float4x4 an_MatrixPreviousM;
     //float4x4 an_MatrixPreviousMI;
@@ -6,4 +6,13 @@ float3 UnpackNormalRGBNoScale(float4 packedNormal)
     return packedNormal.rgb * 2.0 - 1.0;
 }
 
+/// BC5 normal maps only store XY
+float3 UnpackNormalRG(float4 packedNormal)
+{
+    float3 normal;
+    normal.xy = packedNormal.rg * 2.0 - 1.0;
+    normal.z = sqrt(saturate(1.0 - dot(normal.xy, normal.xy)));
+    return normal;
+}
+
 #endif//AN_PACKING_HLSL
\ No newline at end of file
@@ -35,4 +35,39 @@ VertexNormalInputs GetVertexNormalInputs(float3 normalOS, float4 tangentOS) {
     return tbn;
 }
 
+float3 OctahedralDecode(float2 encoded) {
+    float3 n = float3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = saturate(-n.z);
+    n.xy += n.xy >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+// decode vertex channels of a compressed mesh, see VertexDataInfo::GetCompressedChannelsLayout
+float3 DecodePositionOS(float3 positionOS) {
+    return an_VertexCompression.x > 0.0 ? positionOS * an_VertexPositionScale.xyz + an_VertexPositionOffset.xyz : positionOS;
+}
+
+float3 DecodeNormalOS(float3 normalOS) {
+    return an_VertexCompression.y > 0.0 ? OctahedralDecode(normalOS.xy) : normalOS;
+}
+
+// the tangent sign is folded into y, its magnitude is kept above 2 / 32767
+float4 DecodeTangentOS(float4 tangentOS) {
+    if (an_VertexCompression.z <= 0.0) return tangentOS;
+    const float bias = 2.0 / 32767.0;
+    float sign = tangentOS.y >= 0.0 ? 1.0 : -1.0;
+    float y = (abs(tangentOS.y) - bias) / (1.0 - bias) * 2.0 - 1.0;
+    return float4(OctahedralDecode(float2(tangentOS.x, y)), sign);
+}
+
+// dithered cross fade between two lod levels, the two levels keep complementary pixels
+void LODFadeCrossFade(float4 positionCS) {
+    float fade = an_LODFade.x;
+    if (fade >= 1.0) return;
+
+    // interleaved gradient noise
+    float dither = frac(52.9829189 * frac(dot(positionCS.xy, float2(0.06711056, 0.00583715))));
+    clip(fade >= 0.0 ? fade - dither : dither - (1.0 + fade));
+}
+
 #endif//AN_SHADER_VARIABLES_FUNCTIONS_HLSL
\ No newline at end of file
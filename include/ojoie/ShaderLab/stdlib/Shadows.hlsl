@@ -6,6 +6,8 @@
 
 #define BEYOND_SHADOW_FAR(shadowCoord) shadowCoord.z <= 0.0 || shadowCoord.z >= 1.0
 
+#define MAX_SHADOW_CASCADES 4
+
 SamplerComparisonState sampler_LinearClampCompare;
 
 Texture2D _MainLightShadowmapTexture;
@@ -15,7 +17,15 @@ CBUFFER_START(LightShadows)
     float4      _MainLightShadowParams; //  // (x: shadowStrength, y: >= 1.0 if soft shadows, 0.0 otherwise, z: main light fade scale, w: main light fade bias)
     float4      _MainLightShadowmapTexture_TexelSize;
     float4      _ShadowBias; // x: depth bias, y: normal bias
-    float4x4    _MainLightWorldToShadow;
+    float4x4    _MainLightWorldToShadow;  // cascade 0, including the atlas tile scale and offset
+    float4x4    _MainLightWorldToShadow1;
+    float4x4    _MainLightWorldToShadow2;
+    float4x4    _MainLightWorldToShadow3;
+    float4      _CascadeShadowSplitSpheres0; // xyz: center, w: radius
+    float4      _CascadeShadowSplitSpheres1;
+    float4      _CascadeShadowSplitSpheres2;
+    float4      _CascadeShadowSplitSpheres3;
+    float4      _CascadeShadowSplitSphereRadii; // squared radius, 0 for unused cascades
 CBUFFER_END
 
 
@@ -95,10 +105,34 @@ half MainLightShadow(float4 shadowCoord, float3 positionWS)
     return lerp(realtimeShadow, 1.0, shadowFade);
 }
 
+// index of the first cascade whose split sphere contains positionWS, MAX_SHADOW_CASCADES if none
+half ComputeCascadeIndex(float3 positionWS)
+{
+    float3 fromCenter0 = positionWS - _CascadeShadowSplitSpheres0.xyz;
+    float3 fromCenter1 = positionWS - _CascadeShadowSplitSpheres1.xyz;
+    float3 fromCenter2 = positionWS - _CascadeShadowSplitSpheres2.xyz;
+    float3 fromCenter3 = positionWS - _CascadeShadowSplitSpheres3.xyz;
+    float4 distances2 = float4(dot(fromCenter0, fromCenter0), dot(fromCenter1, fromCenter1), dot(fromCenter2, fromCenter2), dot(fromCenter3, fromCenter3));
+
+    half4 weights = half4(distances2 < _CascadeShadowSplitSphereRadii);
+    weights.yzw = saturate(weights.yzw - weights.xyz);
+
+    return half(4.0) - dot(weights, half4(4, 3, 2, 1));
+}
+
 float4 TransformWorldToShadowCoord(float3 positionWS)
 {
-    float4 shadowCoord = mul(_MainLightWorldToShadow, float4(positionWS, 1.0));
-    return float4(shadowCoord.xyz, 0);
+    half cascadeIndex = ComputeCascadeIndex(positionWS);
+
+    float4x4 worldToShadow = _MainLightWorldToShadow;
+    if (cascadeIndex == 1) worldToShadow = _MainLightWorldToShadow1;
+    else if (cascadeIndex == 2) worldToShadow = _MainLightWorldToShadow2;
+    else if (cascadeIndex == 3) worldToShadow = _MainLightWorldToShadow3;
+
+    float4 shadowCoord = mul(worldToShadow, float4(positionWS, 1.0));
+
+    // outside of every cascade, BEYOND_SHADOW_FAR returns no shadow
+    return cascadeIndex < MAX_SHADOW_CASCADES ? float4(shadowCoord.xyz, 0) : float4(0, 0, 1, 0);
 }
 
 float3 ApplyShadowBias(float3 positionWS, float3 normalWS, float3 lightDirection)
@@ -0,0 +1,140 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_FLATHASHMAP_HPP
+#define OJOIE_FLATHASHMAP_HPP
+
+#include <ojoie/Configuration/typedef.h>
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <vector>
+
+namespace AN {
+
+/// open addressing with linear probing over one array, for small copyable keys and values,
+/// lookups and erases never allocate, pointers from find are valid until the next insert or erase
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+
+    struct Slot {
+        Key   key;
+        Value value;
+        bool  bUsed;
+    };
+
+    std::vector<Slot> _slots;
+    size_t            _size = 0;
+    UInt32            _shift = 64;
+
+    /// fibonacci hashing spreads sequential ids over the table
+    size_t indexOf(const Key &key) const {
+        UInt64 hash = (UInt64) Hash()(key) * 0x9E3779B97F4A7C15ULL;
+        return _shift >= 64 ? 0 : (size_t) (hash >> _shift);
+    }
+
+    size_t mask() const { return _slots.size() - 1; }
+
+    void rehash(size_t capacity) {
+        std::vector<Slot> slots(capacity);
+        _slots.swap(slots);
+        _shift = 64 - std::countr_zero(capacity);
+        _size  = 0;
+        for (Slot &slot : slots) {
+            if (slot.bUsed) insert(slot.key, slot.value);
+        }
+    }
+
+public:
+
+    size_t size() const { return _size; }
+    bool   empty() const { return _size == 0; }
+
+    /// keep up to count entries without a rehash
+    void reserve(size_t count) {
+        size_t capacity = std::bit_ceil(std::max<size_t>(16, count + count / 3 + 1));
+        if (capacity > _slots.size()) rehash(capacity);
+    }
+
+    void clear() {
+        _slots.clear();
+        _size  = 0;
+        _shift = 64;
+    }
+
+    Value *find(const Key &key) {
+        if (_size == 0) return nullptr;
+        for (size_t i = indexOf(key);; i = (i + 1) & mask()) {
+            Slot &slot = _slots[i];
+            if (!slot.bUsed) return nullptr;
+            if (slot.key == key) return &slot.value;
+        }
+    }
+
+    const Value *find(const Key &key) const {
+        return const_cast<FlatHashMap *>(this)->find(key);
+    }
+
+    bool contains(const Key &key) const { return find(key) != nullptr; }
+
+    /// return false and leave the value if the key exists
+    bool insert(const Key &key, const Value &value) {
+        /// at most three quarters full so probes stay short
+        if ((_size + 1) * 4 > _slots.size() * 3) rehash(std::max<size_t>(16, _slots.size() * 2));
+
+        for (size_t i = indexOf(key);; i = (i + 1) & mask()) {
+            Slot &slot = _slots[i];
+            if (!slot.bUsed) {
+                slot = { key, value, true };
+                ++_size;
+                return true;
+            }
+            if (slot.key == key) return false;
+        }
+    }
+
+    void insertOrAssign(const Key &key, const Value &value) {
+        if (Value *existing = find(key)) {
+            *existing = value;
+        } else {
+            insert(key, value);
+        }
+    }
+
+    bool erase(const Key &key) {
+        if (_size == 0) return false;
+
+        size_t i = indexOf(key);
+        while (true) {
+            if (!_slots[i].bUsed) return false;
+            if (_slots[i].key == key) break;
+            i = (i + 1) & mask();
+        }
+
+        /// shift the following entries back instead of leaving a tombstone
+        for (size_t j = (i + 1) & mask(); _slots[j].bUsed; j = (j + 1) & mask()) {
+            size_t home = indexOf(_slots[j].key);
+            /// j may move to the hole at i only if its home is not in (i, j]
+            if (((j - home) & mask()) >= ((j - i) & mask())) {
+                _slots[i] = _slots[j];
+                i         = j;
+            }
+        }
+        _slots[i].bUsed = false;
+        --_size;
+        return true;
+    }
+
+    template<typename Func>
+    void forEach(Func &&func) {
+        for (Slot &slot : _slots) {
+            if (slot.bUsed) func(slot.key, slot.value);
+        }
+    }
+};
+
+}
+
+#endif//OJOIE_FLATHASHMAP_HPP
@@ -0,0 +1,33 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_PARALLELFOR_HPP
+#define OJOIE_PARALLELFOR_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <cstddef>
+#include <utility>
+
+namespace AN {
+
+/// body called with a half-open range [begin, end)
+typedef void (*ParallelForFunc)(void *userdata, size_t begin, size_t end);
+
+/// split [0, count) into ranges of at least grainSize elements and run them on worker threads,
+/// the call returns after all ranges are done, falls back to a serial loop when built without TBB
+AN_API void ParallelFor(size_t count, size_t grainSize, ParallelForFunc func, void *userdata);
+
+/// number of worker threads ParallelFor may use, including the calling thread
+AN_API UInt32 GetParallelWorkerCount();
+
+template<typename Func>
+void ParallelFor(size_t count, size_t grainSize, Func &&func) {
+    ParallelFor(count, grainSize, [](void *userdata, size_t begin, size_t end) {
+        (*(std::remove_reference_t<Func> *) userdata)(begin, end);
+    }, (void *) &func);
+}
+
+}
+
+#endif//OJOIE_PARALLELFOR_HPP
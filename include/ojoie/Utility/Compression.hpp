@@ -0,0 +1,26 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_COMPRESSION_HPP
+#define OJOIE_COMPRESSION_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <cstddef>
+
+namespace AN {
+
+/// LZ4 block format, slow enough to run at build time and fast to decode at load time
+
+/// dst capacity LZ4Compress needs in the worst case
+AN_API size_t LZ4CompressBound(size_t srcSize);
+
+/// compressed size, 0 if dstCapacity is below LZ4CompressBound(srcSize)
+AN_API size_t LZ4Compress(const void *src, size_t srcSize, void *dst, size_t dstCapacity);
+
+/// false if src is corrupt or does not decode to exactly dstSize bytes
+AN_API bool LZ4Decompress(const void *src, size_t srcSize, void *dst, size_t dstSize);
+
+}
+
+#endif//OJOIE_COMPRESSION_HPP
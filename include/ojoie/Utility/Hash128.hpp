@@ -0,0 +1,44 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#ifndef OJOIE_HASH128_HPP
+#define OJOIE_HASH128_HPP
+
+#include <ojoie/Configuration/typedef.h>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace AN {
+
+/// 128 bit content hash (MurmurHash3 x64 128), stable across runs and platforms so it can name files on disk
+struct Hash128 {
+    UInt64 u64[2];
+
+    bool operator==(const Hash128 &other) const { return u64[0] == other.u64[0] && u64[1] == other.u64[1]; }
+    bool operator!=(const Hash128 &other) const { return !(*this == other); }
+
+    /// 32 lower case hex characters
+    std::string toString() const;
+};
+
+AN_API Hash128 ComputeHash128(const void *data, size_t size, UInt64 seed = 0);
+
+inline Hash128 ComputeHash128(std::string_view text, UInt64 seed = 0) {
+    return ComputeHash128(text.data(), text.size(), seed);
+}
+
+/// hash of a sequence of hashes, order matters
+inline Hash128 CombineHash128(const Hash128 &a, const Hash128 &b) {
+    Hash128 pair[2] = { a, b };
+    return ComputeHash128(pair, sizeof pair);
+}
+
+struct Hash128Hasher {
+    size_t operator()(const Hash128 &hash) const { return (size_t) (hash.u64[0] ^ hash.u64[1]); }
+};
+
+}
+
+#endif//OJOIE_HASH128_HPP
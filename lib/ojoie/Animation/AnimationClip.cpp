@@ -0,0 +1,398 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Animation/AnimationClip.hpp"
+#include "Utility/Assert.h"
+#include "Utility/Log.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AN_ANIMATION_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace AN {
+
+IMPLEMENT_AN_CLASS(AnimationClip)
+LOAD_AN_CLASS(AnimationClip)
+IMPLEMENT_AN_OBJECT_SERIALIZE(AnimationClip)
+INSTANTIATE_TEMPLATE_TRANSFER(AnimationClip)
+
+static constexpr float kQuantizeRange = 0.70710678f;   // the three smallest components are within 1 / sqrt(2)
+static constexpr float kQuantizeScale = 32767.f;
+
+QuantizedQuaternion QuantizeQuaternion(const Quaternionf &rotation) {
+    float components[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::abs(components[i]) > std::abs(components[largest])) {
+            largest = i;
+        }
+    }
+    /// q and -q are the same rotation, keep the dropped component positive
+    float sign = components[largest] < 0.f ? -1.f : 1.f;
+
+    QuantizedQuaternion result;
+    for (int i = 0, j = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        float normalized = std::clamp(components[i] * sign / kQuantizeRange, -1.f, 1.f);
+        result.values[j++] = (UInt16) std::lround((normalized * 0.5f + 0.5f) * kQuantizeScale);
+    }
+    result.values[0] |= (UInt16) ((largest & 1) << 15);
+    result.values[1] |= (UInt16) ((largest >> 1) << 15);
+    return result;
+}
+
+Quaternionf DequantizeQuaternion(const QuantizedQuaternion &rotation) {
+    int largest = (rotation.values[0] >> 15) | ((rotation.values[1] >> 15) << 1);
+
+    float components[4];
+    float sum = 0.f;
+    for (int i = 0, j = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        float normalized = (float) (rotation.values[j++] & 0x7FFF) / kQuantizeScale * 2.f - 1.f;
+        components[i]    = normalized * kQuantizeRange;
+        sum += components[i] * components[i];
+    }
+    components[largest] = std::sqrt(std::max(0.f, 1.f - sum));
+    return { components[3], components[0], components[1], components[2] };
+}
+
+/// shortest path nlerp, the result is not normalized
+static Quaternionf NLerpUnnormalized(const Quaternionf &a, const Quaternionf &b, float t) {
+    float sign = Math::dot(a, b) < 0.f ? -1.f : 1.f;
+    return { a.w + (b.w * sign - a.w) * t, a.x + (b.x * sign - a.x) * t,
+             a.y + (b.y * sign - a.y) * t, a.z + (b.z * sign - a.z) * t };
+}
+
+/// greedy key reduction of a uniformly sampled channel,
+/// from the last kept key extend the segment while interpolating it reproduces every frame inside
+template<typename T, typename Interpolate, typename Error>
+static void ReduceKeys(const std::vector<T> &samples, float tolerance, Interpolate interpolate, Error error,
+                       std::vector<UInt16> &outFrames, std::vector<T> &outKeys) {
+    outFrames.clear();
+    outKeys.clear();
+    if (samples.empty()) return;
+
+    UInt32 count = samples.size();
+    outFrames.push_back(0);
+    outKeys.push_back(samples[0]);
+
+    /// constant channel keeps a single key
+    bool bConstant = true;
+    for (UInt32 i = 1; i < count && bConstant; ++i) {
+        bConstant = error(samples[0], samples[i]) <= tolerance;
+    }
+    if (bConstant) return;
+
+    UInt32 start = 0;
+    for (UInt32 end = start + 2; end < count; ++end) {
+        bool bFits = true;
+        for (UInt32 i = start + 1; i < end && bFits; ++i) {
+            float t = (float) (i - start) / (float) (end - start);
+            bFits   = error(interpolate(samples[start], samples[end], t), samples[i]) <= tolerance;
+        }
+        if (!bFits) {
+            start = end - 1;
+            outFrames.push_back(start);
+            outKeys.push_back(samples[start]);
+        }
+    }
+    if (count > 1) {
+        outFrames.push_back(count - 1);
+        outKeys.push_back(samples[count - 1]);
+    }
+}
+
+AnimationClip::AnimationClip(ObjectCreationMode mode) : Super(mode), m_SampleRate(30.f), m_FrameCount() {}
+
+AnimationClip::~AnimationClip() {}
+
+bool AnimationClip::initWithImportAnimation(const ImportAnimation &animation,
+                                            const AnimationCompressionSettings &settings) {
+    if (!Super::init()) return false;
+
+    if (animation.frameCount == 0 || animation.frameCount > 65535 || animation.sampleRate <= 0.f) {
+        AN_LOG(Error, "Animation %s has invalid frame count %u or sample rate %f",
+               animation.name.c_str(), animation.frameCount, animation.sampleRate);
+        return false;
+    }
+
+    setName(animation.name.c_str());
+    m_SampleRate = animation.sampleRate;
+    m_FrameCount = animation.frameCount;
+    m_Curves.clear();
+
+    auto lerp = [](const Vector3f &a, const Vector3f &b, float t) { return a + (b - a) * t; };
+    auto distance = [](const Vector3f &a, const Vector3f &b) { return Math::length(a - b); };
+    auto nlerp = [](const Quaternionf &a, const Quaternionf &b, float t) {
+        return Math::normalize(NLerpUnnormalized(a, b, t));
+    };
+    /// from the chord between the quaternions, acos of the dot loses small angles to float precision
+    auto angle = [](const Quaternionf &a, const Quaternionf &b) {
+        float sign = Math::dot(a, b) < 0.f ? -1.f : 1.f;
+        Vector4f chord(a.x - b.x * sign, a.y - b.y * sign, a.z - b.z * sign, a.w - b.w * sign);
+        return Math::degrees(4.f * std::asin(std::min(1.f, Math::length(chord) * 0.5f)));
+    };
+
+    std::vector<Quaternionf> rotationKeys;
+    for (const ImportAnimationTrack &track : animation.tracks) {
+        if (track.positions.size() != m_FrameCount || track.rotations.size() != m_FrameCount ||
+            track.scales.size() != m_FrameCount) {
+            AN_LOG(Error, "Animation %s track %s does not have %u frames",
+                   animation.name.c_str(), track.boneName.c_str(), m_FrameCount);
+            return false;
+        }
+
+        AnimationCurve &curve = m_Curves.emplace_back();
+        curve.path = track.boneName;
+        ReduceKeys(track.positions, settings.positionError, lerp, distance, curve.positionFrames, curve.positions);
+        ReduceKeys(track.scales, settings.scaleError, lerp, distance, curve.scaleFrames, curve.scales);
+        ReduceKeys(track.rotations, settings.rotationError, nlerp, angle, curve.rotationFrames, rotationKeys);
+
+        curve.rotations.resize(rotationKeys.size());
+        std::transform(rotationKeys.begin(), rotationKeys.end(), curve.rotations.begin(), QuantizeQuaternion);
+    }
+
+    return true;
+}
+
+UInt32 AnimationClip::getKeyCount() const {
+    UInt32 count = 0;
+    for (const AnimationCurve &curve : m_Curves) {
+        count += curve.positions.size() + curve.rotations.size() + curve.scales.size();
+    }
+    return count;
+}
+
+/// keys around the frame and the interpolation factor between them
+static void FindKeys(const std::vector<UInt16> &frames, float frame, UInt32 &first, UInt32 &second, float &t) {
+    auto it = std::upper_bound(frames.begin(), frames.end(), frame);
+    if (it == frames.begin()) {
+        first = second = 0;
+        t              = 0.f;
+    } else if (it == frames.end()) {
+        first = second = frames.size() - 1;
+        t              = 0.f;
+    } else {
+        second = it - frames.begin();
+        first  = second - 1;
+        t      = (frame - frames[first]) / (float) (frames[second] - frames[first]);
+    }
+}
+
+/// out = normalize(a + (b - a) * t) with b flipped to the hemisphere of a, count is a multiple of 4,
+/// t is per rotation when not null else weight is used, out may alias a
+static void NLerpRotations(const float *const a[4], const float *const b[4], const float *t, float weight,
+                           float *const out[4], size_t count) {
+#ifdef AN_ANIMATION_USE_SSE
+    const __m128 signMask = _mm_set1_ps(-0.f);
+    __m128       vWeight  = _mm_set1_ps(weight);
+    for (size_t i = 0; i < count; i += 4) {
+        __m128 ax = _mm_loadu_ps(a[0] + i), ay = _mm_loadu_ps(a[1] + i);
+        __m128 az = _mm_loadu_ps(a[2] + i), aw = _mm_loadu_ps(a[3] + i);
+        __m128 bx = _mm_loadu_ps(b[0] + i), by = _mm_loadu_ps(b[1] + i);
+        __m128 bz = _mm_loadu_ps(b[2] + i), bw = _mm_loadu_ps(b[3] + i);
+        __m128 vt = t ? _mm_loadu_ps(t + i) : vWeight;
+
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        __m128 sign = _mm_and_ps(dot, signMask);
+        bx = _mm_xor_ps(bx, sign);
+        by = _mm_xor_ps(by, sign);
+        bz = _mm_xor_ps(bz, sign);
+        bw = _mm_xor_ps(bw, sign);
+
+        __m128 rx = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), vt));
+        __m128 ry = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), vt));
+        __m128 rz = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), vt));
+        __m128 rw = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), vt));
+
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                               _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw))));
+        __m128 invLength = _mm_div_ps(_mm_set1_ps(1.f), length);
+        _mm_storeu_ps(out[0] + i, _mm_mul_ps(rx, invLength));
+        _mm_storeu_ps(out[1] + i, _mm_mul_ps(ry, invLength));
+        _mm_storeu_ps(out[2] + i, _mm_mul_ps(rz, invLength));
+        _mm_storeu_ps(out[3] + i, _mm_mul_ps(rw, invLength));
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        Quaternionf qa(a[3][i], a[0][i], a[1][i], a[2][i]);
+        Quaternionf qb(b[3][i], b[0][i], b[1][i], b[2][i]);
+        Quaternionf r = Math::normalize(NLerpUnnormalized(qa, qb, t ? t[i] : weight));
+        out[0][i] = r.x;
+        out[1][i] = r.y;
+        out[2][i] = r.z;
+        out[3][i] = r.w;
+    }
+#endif
+}
+
+/// out = a + (b - a) * weight, count is a multiple of 4
+static void LerpComponents(float *a, const float *b, float weight, size_t count) {
+#ifdef AN_ANIMATION_USE_SSE
+    __m128 vWeight = _mm_set1_ps(weight);
+    for (size_t i = 0; i < count; i += 4) {
+        __m128 va = _mm_loadu_ps(a + i);
+        _mm_storeu_ps(a + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b + i), va), vWeight)));
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        a[i] += (b[i] - a[i]) * weight;
+    }
+#endif
+}
+
+/// rotation keys of one sample call gathered in soa form, reused by the thread
+struct RotationSampleScratch {
+    std::vector<float> keys[8];  // xyzw of the first keys then of the second keys
+    std::vector<float> t;
+    std::vector<UInt32> bones;
+
+    void resize(size_t count) {
+        for (std::vector<float> &key : keys) key.resize(count);
+        t.resize(count);
+    }
+};
+
+void AnimationClip::sample(float time, std::span<const int> curveToBone, AnimationPose &pose) const {
+    thread_local RotationSampleScratch scratch;
+
+    float  frame = std::clamp(time * m_SampleRate, 0.f, (float) std::max<UInt32>(m_FrameCount, 1) - 1.f);
+    size_t curveCount = std::min(curveToBone.size(), m_Curves.size());
+
+    scratch.bones.clear();
+    scratch.resize((curveCount + 3) & ~3);
+
+    float *positionX = pose.get(AnimationPose::kPositionX), *positionY = pose.get(AnimationPose::kPositionY),
+          *positionZ = pose.get(AnimationPose::kPositionZ);
+    float *scaleX = pose.get(AnimationPose::kScaleX), *scaleY = pose.get(AnimationPose::kScaleY),
+          *scaleZ = pose.get(AnimationPose::kScaleZ);
+
+    UInt32 first, second;
+    float  t;
+    for (size_t i = 0; i < curveCount; ++i) {
+        int bone = curveToBone[i];
+        if (bone < 0 || (UInt32) bone >= pose.boneCount) continue;
+        const AnimationCurve &curve = m_Curves[i];
+
+        FindKeys(curve.positionFrames, frame, first, second, t);
+        Vector3f position = curve.positions[first] + (curve.positions[second] - curve.positions[first]) * t;
+        positionX[bone] = position.x;
+        positionY[bone] = position.y;
+        positionZ[bone] = position.z;
+
+        FindKeys(curve.scaleFrames, frame, first, second, t);
+        Vector3f scale = curve.scales[first] + (curve.scales[second] - curve.scales[first]) * t;
+        scaleX[bone] = scale.x;
+        scaleY[bone] = scale.y;
+        scaleZ[bone] = scale.z;
+
+        /// rotations are blended together below
+        FindKeys(curve.rotationFrames, frame, first, second, t);
+        Quaternionf q0 = DequantizeQuaternion(curve.rotations[first]);
+        Quaternionf q1 = DequantizeQuaternion(curve.rotations[second]);
+        size_t index = scratch.bones.size();
+        scratch.keys[0][index] = q0.x;
+        scratch.keys[1][index] = q0.y;
+        scratch.keys[2][index] = q0.z;
+        scratch.keys[3][index] = q0.w;
+        scratch.keys[4][index] = q1.x;
+        scratch.keys[5][index] = q1.y;
+        scratch.keys[6][index] = q1.z;
+        scratch.keys[7][index] = q1.w;
+        scratch.t[index]       = t;
+        scratch.bones.push_back(bone);
+    }
+
+    size_t count = scratch.bones.size();
+    if (count == 0) return;
+
+    /// pad to the simd width with identity
+    size_t paddedCount = (count + 3) & ~3;
+    for (size_t i = count; i < paddedCount; ++i) {
+        for (int k = 0; k < 8; ++k) scratch.keys[k][i] = (k == 3 || k == 7) ? 1.f : 0.f;
+        scratch.t[i] = 0.f;
+    }
+
+    const float *a[4] = { scratch.keys[0].data(), scratch.keys[1].data(), scratch.keys[2].data(), scratch.keys[3].data() };
+    const float *b[4] = { scratch.keys[4].data(), scratch.keys[5].data(), scratch.keys[6].data(), scratch.keys[7].data() };
+    float *const out[4] = { scratch.keys[0].data(), scratch.keys[1].data(), scratch.keys[2].data(), scratch.keys[3].data() };
+    NLerpRotations(a, b, scratch.t.data(), 0.f, out, paddedCount);
+
+    for (int k = 0; k < 4; ++k) {
+        float *component = pose.get((AnimationPose::Component) (AnimationPose::kRotationX + k));
+        for (size_t i = 0; i < count; ++i) {
+            component[scratch.bones[i]] = scratch.keys[k][i];
+        }
+    }
+}
+
+template<typename _Coder>
+void AnimationClip::transfer(_Coder &coder) {
+    Super::transfer(coder);
+    TRANSFER(m_SampleRate);
+    TRANSFER(m_FrameCount);
+    TRANSFER(m_Curves);
+}
+
+void AnimationPose::resize(UInt32 count) {
+    boneCount = count;
+    stride    = (count + 3) & ~3U;
+    data.assign((size_t) stride * kComponentCount, 0.f);
+    std::fill_n(get(kRotationW), stride, 1.f);
+    std::fill_n(get(kScaleX), stride * 3, 1.f);
+}
+
+void AnimationPose::setBone(UInt32 bone, const Vector3f &position, const Quaternionf &rotation, const Vector3f &scale) {
+    get(kPositionX)[bone] = position.x;
+    get(kPositionY)[bone] = position.y;
+    get(kPositionZ)[bone] = position.z;
+    get(kRotationX)[bone] = rotation.x;
+    get(kRotationY)[bone] = rotation.y;
+    get(kRotationZ)[bone] = rotation.z;
+    get(kRotationW)[bone] = rotation.w;
+    get(kScaleX)[bone]    = scale.x;
+    get(kScaleY)[bone]    = scale.y;
+    get(kScaleZ)[bone]    = scale.z;
+}
+
+Vector3f AnimationPose::getPosition(UInt32 bone) const {
+    return { get(kPositionX)[bone], get(kPositionY)[bone], get(kPositionZ)[bone] };
+}
+
+Quaternionf AnimationPose::getRotation(UInt32 bone) const {
+    return { get(kRotationW)[bone], get(kRotationX)[bone], get(kRotationY)[bone], get(kRotationZ)[bone] };
+}
+
+Vector3f AnimationPose::getScale(UInt32 bone) const {
+    return { get(kScaleX)[bone], get(kScaleY)[bone], get(kScaleZ)[bone] };
+}
+
+void BlendPoses(AnimationPose &pose, const AnimationPose &other, float weight) {
+    ANAssert(pose.stride == other.stride);
+    if (weight <= 0.f) return;
+    if (weight >= 1.f) {
+        pose.data = other.data;
+        return;
+    }
+
+    /// positions are the first three arrays and scales the last three, they are contiguous
+    LerpComponents(pose.get(AnimationPose::kPositionX), other.get(AnimationPose::kPositionX), weight, pose.stride * 3);
+    LerpComponents(pose.get(AnimationPose::kScaleX), other.get(AnimationPose::kScaleX), weight, pose.stride * 3);
+
+    const float *a[4] = { pose.get(AnimationPose::kRotationX), pose.get(AnimationPose::kRotationY),
+                          pose.get(AnimationPose::kRotationZ), pose.get(AnimationPose::kRotationW) };
+    const float *b[4] = { other.get(AnimationPose::kRotationX), other.get(AnimationPose::kRotationY),
+                          other.get(AnimationPose::kRotationZ), other.get(AnimationPose::kRotationW) };
+    float *const out[4] = { pose.get(AnimationPose::kRotationX), pose.get(AnimationPose::kRotationY),
+                            pose.get(AnimationPose::kRotationZ), pose.get(AnimationPose::kRotationW) };
+    NLerpRotations(a, b, nullptr, weight, out, pose.stride);
+}
+
+}
@@ -0,0 +1,313 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Animation/Animator.hpp"
+#include "Components/Transform.hpp"
+#include "Core/Actor.hpp"
+#include "Threads/ParallelFor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef OJOIE_WITH_EDITOR
+#include "IMGUI/IMGUI.hpp"
+#endif
+
+namespace AN {
+
+IMPLEMENT_AN_CLASS_INIT(Animator)
+LOAD_AN_CLASS(Animator)
+IMPLEMENT_AN_OBJECT_SERIALIZE(Animator)
+INSTANTIATE_TEMPLATE_TRANSFER(Animator)
+
+Animator::~Animator() {}
+
+Animator::Animator(ObjectCreationMode mode)
+    : Super(mode), m_ListNode(this), m_Clip(), m_Loop(true), m_Bound(), bAddToManager() {}
+
+void Animator::InitializeClass() {
+    GetClassStatic()->registerMessageCallback(kDidAddComponentMessage,
+                                              [](void *receiver, Message &message) {
+                                                  Animator *animator = (Animator *) receiver;
+                                                  if (message.getData<Component *>() == animator) {
+                                                      /// only do when the added component is self
+                                                      animator->onAddAnimator();
+                                                  }
+                                              });
+}
+
+void Animator::onAddAnimator() {
+    bAddToManager = true;
+    GetAnimationManager().addAnimator(m_ListNode);
+}
+
+bool Animator::initAfterDecode() {
+    if (!Super::initAfterDecode()) return false;
+    if (m_Clip) {
+        play(m_Clip);
+        setLayerLoop(0, m_Loop);
+    }
+    return true;
+}
+
+void Animator::getResourceReferences(std::vector<Object *> &references) const {
+    Super::getResourceReferences(references);
+    references.push_back(m_Clip);
+    for (const Layer &layer : m_Layers) {
+        references.push_back(layer.current.clip);
+        references.push_back(layer.previous.clip);
+    }
+}
+
+void Animator::dealloc() {
+    if (bAddToManager) {
+        GetAnimationManager().removeAnimator(m_ListNode);
+    }
+    Super::dealloc();
+}
+
+void Animator::setClip(AnimationClip *clip) {
+    m_Clip = clip;
+    play(clip);
+    setLayerLoop(0, m_Loop);
+}
+
+void Animator::play(AnimationClip *clip, UInt32 layer, float fadeDuration) {
+    if (layer >= m_Layers.size()) {
+        m_Layers.resize(layer + 1, Layer{ {}, {}, 0.f, 0.f, 1.f, 1.f, true });
+    }
+
+    Layer &state = m_Layers[layer];
+    if (fadeDuration > 0.f && state.current.clip && clip) {
+        state.previous     = state.current;
+        state.fadeElapsed  = 0.f;
+        state.fadeDuration = fadeDuration;
+    } else {
+        state.previous.clip = nullptr;
+    }
+    state.current = { clip, 0.f };
+
+    if (m_Bound && clip) {
+        getBinding(clip);
+    }
+}
+
+void Animator::stop(UInt32 layer) {
+    if (layer < m_Layers.size()) {
+        m_Layers[layer].current.clip  = nullptr;
+        m_Layers[layer].previous.clip = nullptr;
+    }
+}
+
+void Animator::setLayerWeight(UInt32 layer, float weight) {
+    if (layer < m_Layers.size()) m_Layers[layer].weight = std::clamp(weight, 0.f, 1.f);
+}
+
+void Animator::setLayerSpeed(UInt32 layer, float speed) {
+    if (layer < m_Layers.size()) m_Layers[layer].speed = speed;
+}
+
+void Animator::setLayerLoop(UInt32 layer, bool loop) {
+    if (layer < m_Layers.size()) m_Layers[layer].bLoop = loop;
+}
+
+void Animator::setLayerTime(UInt32 layer, float time) {
+    if (layer < m_Layers.size()) m_Layers[layer].current.time = time;
+}
+
+void Animator::rebind() {
+    m_Bones.clear();
+    m_BoneIndices.clear();
+    m_Bindings.clear();
+
+    std::vector<int> parents;
+    Transform *transform = getTransform();
+    if (transform) {
+        /// breadth first keeps parents before children
+        for (Transform *child : transform->getChildren()) {
+            m_Bones.push_back(child);
+            parents.push_back(-1);
+        }
+        for (size_t i = 0; i < m_Bones.size(); ++i) {
+            for (Transform *child : m_Bones[i]->getChildren()) {
+                m_Bones.push_back(child);
+                parents.push_back((int) i);
+            }
+        }
+    }
+
+    UInt32 boneCount = m_Bones.size();
+    m_RestPose.resize(boneCount);
+    for (UInt32 i = 0; i < boneCount; ++i) {
+        Transform *bone = m_Bones[i];
+        m_BoneIndices.emplace(bone->getActor().getName().string_view(), (int) i);
+        m_RestPose.setBone(i, bone->getLocalPosition(), bone->getLocalRotation(), bone->getLocalScale());
+    }
+    m_Pose      = m_RestPose;
+    m_LayerPose = m_RestPose;
+    m_FadePose  = m_RestPose;
+
+    m_BoneParents.swap(parents);
+    m_AnimatedMask.assign(boneCount, 0);
+    m_Bound = true;
+
+    for (Layer &layer : m_Layers) {
+        if (layer.current.clip) getBinding(layer.current.clip);
+        if (layer.previous.clip) getBinding(layer.previous.clip);
+    }
+    updateAnimatedBones();
+}
+
+const std::vector<int> &Animator::getBinding(AnimationClip *clip) {
+    auto it = m_Bindings.find(clip);
+    if (it != m_Bindings.end()) return it->second;
+
+    std::vector<int> &binding = m_Bindings[clip];
+    for (const AnimationCurve &curve : clip->getCurves()) {
+        auto boneIt = m_BoneIndices.find(curve.path);
+        int  bone   = boneIt == m_BoneIndices.end() ? -1 : boneIt->second;
+        binding.push_back(bone);
+        if (bone >= 0) m_AnimatedMask[bone] = 1;
+    }
+    updateAnimatedBones();
+    return binding;
+}
+
+void Animator::updateAnimatedBones() {
+    m_AnimatedBones.clear();
+    m_RootBones.clear();
+    for (UInt32 i = 0; i < m_Bones.size(); ++i) {
+        if (!m_AnimatedMask[i]) continue;
+        m_AnimatedBones.push_back(i);
+
+        /// a bone under an animated ancestor is invalidated by it
+        bool bRoot = true;
+        for (int parent = m_BoneParents[i]; parent >= 0 && bRoot; parent = m_BoneParents[parent]) {
+            bRoot = !m_AnimatedMask[parent];
+        }
+        if (bRoot) m_RootBones.push_back(i);
+    }
+}
+
+void Animator::advance(ClipState &state, const Layer &layer, float deltaTime) {
+    float length = state.clip->getLength();
+    state.time += deltaTime * layer.speed;
+    if (layer.bLoop && length > 0.f) {
+        state.time = std::fmod(state.time, length);
+        if (state.time < 0.f) state.time += length;
+    } else {
+        state.time = std::clamp(state.time, 0.f, length);
+    }
+}
+
+void Animator::sampleLayer(Layer &layer, AnimationPose &pose) {
+    if (layer.previous.clip) {
+        m_FadePose.data = pose.data;
+        layer.previous.clip->sample(layer.previous.time, m_Bindings.find(layer.previous.clip)->second, m_FadePose);
+    }
+
+    layer.current.clip->sample(layer.current.time, m_Bindings.find(layer.current.clip)->second, pose);
+
+    if (layer.previous.clip) {
+        BlendPoses(pose, m_FadePose, 1.f - layer.fadeElapsed / layer.fadeDuration);
+    }
+}
+
+void Animator::evaluate(float deltaTime) {
+    if (!m_Bound) return;
+
+    /// copies reuse the storage, steady frames do not allocate
+    m_Pose.data = m_RestPose.data;
+
+    for (Layer &layer : m_Layers) {
+        if (layer.current.clip == nullptr) continue;
+
+        advance(layer.current, layer, deltaTime);
+        if (layer.previous.clip) {
+            advance(layer.previous, layer, deltaTime);
+            layer.fadeElapsed += deltaTime;
+            if (layer.fadeElapsed >= layer.fadeDuration) {
+                layer.previous.clip = nullptr;
+            }
+        }
+
+        if (layer.weight <= 0.f) continue;
+
+        m_LayerPose.data = m_Pose.data;
+        sampleLayer(layer, m_LayerPose);
+        BlendPoses(m_Pose, m_LayerPose, layer.weight);
+    }
+}
+
+void Animator::applyPose() {
+    for (UInt32 bone : m_AnimatedBones) {
+        m_Bones[bone]->setLocalPoseNoNotify(m_Pose.getPosition(bone), m_Pose.getRotation(bone), m_Pose.getScale(bone));
+    }
+    for (UInt32 bone : m_RootBones) {
+        m_Bones[bone]->notifyLocalPoseChanged();
+    }
+}
+
+template<typename _Coder>
+void Animator::transfer(_Coder &coder) {
+    Super::transfer(coder);
+    TRANSFER(m_Clip);
+    TRANSFER(m_Loop);
+}
+
+void Animator::onInspectorGUI() {
+#ifdef OJOIE_WITH_EDITOR
+    ItemLabel("Loop", kItemLabelLeft);
+    ImGui::Checkbox("##Loop", &m_Loop);
+    ItemLabel(std::format("Bones {} (animated {})", m_Bones.size(), m_AnimatedBones.size()), kItemLabelLeft);
+
+    for (UInt32 i = 0; i < m_Layers.size(); ++i) {
+        Layer &layer = m_Layers[i];
+        ImGui::PushID(i);
+        ItemLabel(std::format("Layer {} {}", i, layer.current.clip ? layer.current.clip->getName().c_str() : "None"),
+                  kItemLabelLeft);
+        ImGui::SliderFloat("##Weight", &layer.weight, 0.f, 1.f);
+        ImGui::PopID();
+    }
+#endif
+}
+
+void AnimationManager::addAnimator(AnimatorListNode &node) {
+    m_List.push_back(node);
+}
+
+void AnimationManager::removeAnimator(AnimatorListNode &node) {
+    node.removeFromList();
+}
+
+void AnimationManager::update(float deltaTime) {
+    m_Animators.clear();
+    for (AnimatorListNode &node : m_List) {
+        Animator &animator = *node;
+        if (!animator.isActive() || animator.getLayerCount() == 0) continue;
+        if (!animator.isBound()) {
+            /// binding touches the hierarchy, keep it on this thread
+            animator.rebind();
+        }
+        m_Animators.push_back(&animator);
+    }
+
+    ParallelFor(m_Animators.size(), 4, [this, deltaTime](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            m_Animators[i]->evaluate(deltaTime);
+        }
+    });
+
+    /// transforms are not thread safe, write them here one character at a time
+    for (Animator *animator : m_Animators) {
+        animator->applyPose();
+    }
+}
+
+AnimationManager &GetAnimationManager() {
+    static AnimationManager animationManager;
+    return animationManager;
+}
+
+}
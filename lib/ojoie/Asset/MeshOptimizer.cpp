@@ -0,0 +1,343 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Asset/MeshOptimizer.hpp"
+#include "Threads/ParallelFor.hpp"
+#include "Utility/Assert.h"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace AN {
+
+static constexpr UInt32 kInvalidVertex = ~0U;
+
+/// fifo cache simulated with time stamps, a vertex is cached while fewer than cacheSize misses happened after it
+class VertexCacheSimulator {
+    std::vector<UInt32> m_Stamps;
+    UInt32              m_CacheSize;
+    UInt32              m_Time;
+
+public:
+    VertexCacheSimulator(UInt32 vertexCount, UInt32 cacheSize)
+        : m_Stamps(vertexCount, 0), m_CacheSize(cacheSize), m_Time(cacheSize + 1) {}
+
+    /// returns the misses of the triangle
+    UInt32 triangle(const UInt32 *tri) {
+        UInt32 misses = 0;
+        for (int k = 0; k < 3; ++k) {
+            UInt32 v = tri[k];
+            if (m_Time - m_Stamps[v] > m_CacheSize) {
+                m_Stamps[v] = m_Time++;
+                ++misses;
+            }
+        }
+        return misses;
+    }
+
+    void reset() { m_Time += m_CacheSize + 1; }
+};
+
+static UInt32 GetVertexCount(std::span<const UInt32> indices) {
+    UInt32 maxIndex = 0;
+    for (UInt32 index : indices) maxIndex = std::max(maxIndex, index);
+    return indices.empty() ? 0 : maxIndex + 1;
+}
+
+VertexCacheStatistics AnalyzeVertexCache(std::span<const UInt32> indices, UInt32 cacheSize) {
+    VertexCacheStatistics stats{};
+    stats.triangleCount = indices.size() / 3;
+    if (stats.triangleCount == 0) return stats;
+
+    UInt32               vertexCount = GetVertexCount(indices);
+    VertexCacheSimulator cache(vertexCount, cacheSize);
+    std::vector<UInt8>   referenced(vertexCount, 0);
+
+    for (UInt32 t = 0; t < stats.triangleCount; ++t) {
+        stats.transformedVertexCount += cache.triangle(&indices[t * 3]);
+    }
+    for (UInt32 index : indices) {
+        stats.vertexCount += referenced[index] == 0;
+        referenced[index] = 1;
+    }
+
+    stats.acmr = (float) stats.transformedVertexCount / (float) stats.triangleCount;
+    stats.atvr = (float) stats.transformedVertexCount / (float) stats.vertexCount;
+    return stats;
+}
+
+void OptimizeVertexCache(std::span<UInt32> indices, UInt32 vertexCount, UInt32 cacheSize, std::vector<UInt32> *outClusters) {
+    if (outClusters) outClusters->clear();
+
+    UInt32 triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    /// vertex to triangle adjacency, live counts the triangles not yet emitted
+    std::vector<UInt32> live(vertexCount, 0);
+    std::vector<UInt32> offsets(vertexCount + 1, 0);
+    std::vector<UInt32> adjacency(triangleCount * 3);
+    for (UInt32 i = 0; i < triangleCount * 3; ++i) {
+        ANAssert(indices[i] < vertexCount);
+        ++live[indices[i]];
+    }
+    for (UInt32 v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+    {
+        std::vector<UInt32> fill(offsets.begin(), offsets.end() - 1);
+        for (UInt32 i = 0; i < triangleCount * 3; ++i) {
+            adjacency[fill[indices[i]]++] = i / 3;
+        }
+    }
+
+    std::vector<UInt32> cacheTime(vertexCount, 0);
+    UInt32              time = cacheSize + 1;
+
+    std::vector<UInt8>  emitted(triangleCount, 0);
+    std::vector<UInt32> deadEnd;
+    std::vector<UInt32> candidates;
+    std::vector<UInt32> output;
+    deadEnd.reserve(triangleCount * 3);
+    output.reserve(triangleCount * 3);
+
+    UInt32 cursor = 0;
+    auto   skipDeadEnd = [&]() -> UInt32 {
+        while (!deadEnd.empty()) {
+            UInt32 v = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[v] > 0) return v;
+        }
+        while (cursor < vertexCount) {
+            if (live[cursor] > 0) return cursor;
+            ++cursor;
+        }
+        return kInvalidVertex;
+    };
+
+    UInt32 fanning   = skipDeadEnd();
+    bool   restarted = true;
+    while (fanning != kInvalidVertex) {
+        if (restarted && outClusters) {
+            outClusters->push_back(output.size() / 3);
+        }
+
+        candidates.clear();
+        for (UInt32 a = offsets[fanning]; a < offsets[fanning + 1]; ++a) {
+            UInt32 t = adjacency[a];
+            if (emitted[t]) continue;
+            emitted[t] = 1;
+
+            for (int k = 0; k < 3; ++k) {
+                UInt32 v = indices[t * 3 + k];
+                output.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+                if (time - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = time++;
+                }
+            }
+        }
+
+        /// prefer the oldest candidate that stays in the cache while its remaining triangles are fanned
+        UInt32 next         = kInvalidVertex;
+        Int64  bestPriority = -1;
+        for (UInt32 v : candidates) {
+            if (live[v] == 0) continue;
+            Int64 priority = 0;
+            if (time - cacheTime[v] + 2 * live[v] <= cacheSize) {
+                priority = time - cacheTime[v];
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next         = v;
+            }
+        }
+
+        restarted = next == kInvalidVertex;
+        fanning   = restarted ? skipDeadEnd() : next;
+    }
+
+    ANAssert(output.size() == indices.size());
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void OptimizeOverdraw(std::span<UInt32> indices, std::span<const Vector3f> positions,
+                      std::span<const UInt32> clusters, UInt32 cacheSize, float threshold) {
+    UInt32 triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    std::vector<UInt32> hardClusters(clusters.begin(), clusters.end());
+    if (hardClusters.empty() || hardClusters.front() != 0) {
+        hardClusters.insert(hardClusters.begin(), 0);
+    }
+    hardClusters.push_back(triangleCount);
+
+    /// split a cluster as soon as the acmr of its beginning is close enough to the acmr of the whole cluster
+    VertexCacheSimulator cache(positions.size(), cacheSize);
+    std::vector<UInt32>  softClusters;
+    for (size_t c = 0; c + 1 < hardClusters.size(); ++c) {
+        UInt32 begin = hardClusters[c], end = hardClusters[c + 1];
+        if (begin >= end) continue;
+
+        cache.reset();
+        UInt32 clusterMisses = 0;
+        for (UInt32 t = begin; t < end; ++t) {
+            clusterMisses += cache.triangle(&indices[t * 3]);
+        }
+        float target = (float) clusterMisses / (float) (end - begin) * threshold;
+
+        cache.reset();
+        softClusters.push_back(begin);
+        UInt32 start  = begin;
+        UInt32 misses = 0;
+        for (UInt32 t = begin; t + 1 < end; ++t) {
+            misses += cache.triangle(&indices[t * 3]);
+            if ((float) misses <= target * (float) (t + 1 - start)) {
+                softClusters.push_back(t + 1);
+                cache.reset();
+                start  = t + 1;
+                misses = 0;
+            }
+        }
+    }
+    softClusters.push_back(triangleCount);
+
+    UInt32 clusterCount = softClusters.size() - 1;
+
+    /// area weighted centroid and normal of every cluster
+    std::vector<Vector3f> centroids(clusterCount, Vector3f(0.f));
+    std::vector<Vector3f> normals(clusterCount, Vector3f(0.f));
+    std::vector<float>    areas(clusterCount, 0.f);
+    Vector3f              meshCentroid(0.f);
+    float                 meshArea = 0.f;
+
+    for (UInt32 c = 0; c < clusterCount; ++c) {
+        for (UInt32 t = softClusters[c]; t < softClusters[c + 1]; ++t) {
+            const Vector3f &p0 = positions[indices[t * 3]];
+            const Vector3f &p1 = positions[indices[t * 3 + 1]];
+            const Vector3f &p2 = positions[indices[t * 3 + 2]];
+
+            Vector3f normal = Math::cross(p1 - p0, p2 - p0);
+            float    area   = Math::length(normal);
+
+            centroids[c] += (p0 + p1 + p2) * (area / 3.f);
+            normals[c] += normal;
+            areas[c] += area;
+        }
+        meshCentroid += centroids[c];
+        meshArea += areas[c];
+        if (areas[c] > 0.f) centroids[c] /= areas[c];
+    }
+    if (meshArea > 0.f) meshCentroid /= meshArea;
+
+    std::vector<float> sortKeys(clusterCount, 0.f);
+    for (UInt32 c = 0; c < clusterCount; ++c) {
+        float length = Math::length(normals[c]);
+        if (length > 0.f) {
+            sortKeys[c] = Math::dot(centroids[c] - meshCentroid, normals[c] / length);
+        }
+    }
+
+    /// outward facing clusters are drawn first so they occlude the inner ones
+    std::vector<UInt32> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](UInt32 a, UInt32 b) { return sortKeys[a] > sortKeys[b]; });
+
+    std::vector<UInt32> output;
+    output.reserve(indices.size());
+    for (UInt32 c : order) {
+        output.insert(output.end(), indices.begin() + softClusters[c] * 3, indices.begin() + softClusters[c + 1] * 3);
+    }
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void OptimizeVertexFetch(std::span<UInt32> indices, UInt32 vertexCount, std::vector<UInt32> &outRemap) {
+    outRemap.assign(vertexCount, kInvalidVertex);
+
+    UInt32 next = 0;
+    for (UInt32 &index : indices) {
+        ANAssert(index < vertexCount);
+        if (outRemap[index] == kInvalidVertex) {
+            outRemap[index] = next++;
+        }
+        index = outRemap[index];
+    }
+
+    for (UInt32 &remap : outRemap) {
+        if (remap == kInvalidVertex) {
+            remap = next++;
+        }
+    }
+}
+
+template<typename T>
+static void RemapVertexStream(std::vector<T> &stream, const std::vector<UInt32> &remap) {
+    /// optional streams are empty
+    if (stream.size() != remap.size()) return;
+
+    std::vector<T> remapped(stream.size());
+    for (size_t i = 0; i < stream.size(); ++i) {
+        remapped[remap[i]] = std::move(stream[i]);
+    }
+    stream.swap(remapped);
+}
+
+static VertexCacheStatistics AnalyzeImportMesh(const ImportMesh &mesh, UInt32 cacheSize) {
+    std::vector<UInt32> indices;
+    for (const ImportSubMesh &subMesh : mesh.subMeshes) {
+        indices.insert(indices.end(), subMesh.indices.begin(), subMesh.indices.end());
+    }
+    return AnalyzeVertexCache(indices, cacheSize);
+}
+
+MeshOptimizationStats OptimizeImportMesh(ImportMesh &mesh, const MeshOptimizationSettings &settings) {
+    MeshOptimizationStats stats{};
+    Timer                 timer;
+
+    UInt32 vertexCount = mesh.positions.size();
+    stats.before       = AnalyzeImportMesh(mesh, settings.cacheSize);
+
+    /// sub meshes are independent draw calls
+    ParallelFor(mesh.subMeshes.size(), 1, [&](size_t begin, size_t end) {
+        std::vector<UInt32> clusters;
+        for (size_t i = begin; i < end; ++i) {
+            std::vector<UInt32> &indices = mesh.subMeshes[i].indices;
+            if (settings.optimizeVertexCache) {
+                OptimizeVertexCache(indices, vertexCount, settings.cacheSize, &clusters);
+            }
+            if (settings.optimizeOverdraw) {
+                OptimizeOverdraw(indices, mesh.positions, clusters, settings.cacheSize, settings.overdrawThreshold);
+            }
+        }
+    });
+
+    if (settings.optimizeVertexFetch && vertexCount > 0) {
+        std::vector<UInt32> indices, remap;
+        for (const ImportSubMesh &subMesh : mesh.subMeshes) {
+            indices.insert(indices.end(), subMesh.indices.begin(), subMesh.indices.end());
+        }
+        OptimizeVertexFetch(indices, vertexCount, remap);
+
+        size_t offset = 0;
+        for (ImportSubMesh &subMesh : mesh.subMeshes) {
+            std::copy_n(indices.begin() + offset, subMesh.indices.size(), subMesh.indices.begin());
+            offset += subMesh.indices.size();
+        }
+
+        RemapVertexStream(mesh.positions, remap);
+        RemapVertexStream(mesh.texcoords[0], remap);
+        RemapVertexStream(mesh.texcoords[1], remap);
+        RemapVertexStream(mesh.normals, remap);
+        RemapVertexStream(mesh.tangents, remap);
+        RemapVertexStream(mesh.boneWeights, remap);
+    }
+
+    stats.after      = AnalyzeImportMesh(mesh, settings.cacheSize);
+    stats.optimizeMs = timer.mark() * 1000.f;
+    return stats;
+}
+
+}
@@ -14,11 +14,20 @@
 #include "Geometry/Sphere.hpp"
 #include "Render/TextureCube.hpp"
 #include "Render/Light.hpp"
+#include "Render/QualitySettings.hpp"
+#include "Render/Texture2D.hpp"
+#include "Render/LODGroup.hpp"
+#include "Render/Mesh/MeshRenderer.hpp"
+
+#include <bit>
 
 namespace AN {
 
 static constexpr int ANGlobalUniformBufferSize = 400;
 
+/// fraction a group must cross a lod threshold by before switching back
+static constexpr float kLODHysteresis = 0.1f;
+
 void SetGlobalViewProjectionMatrix(const Matrix4x4f &view, const Matrix4x4f &proj) {
     Material::SetMatrixGlobal("an_MatrixV", view);
     Material::SetMatrixGlobal("an_MatrixInvV", Math::inverse(view));
@@ -35,7 +44,7 @@ LOAD_AN_CLASS(Camera);
 Camera::~Camera() {}
 
 Camera::Camera(ObjectCreationMode mode)
-    : Super(mode), _renderTarget(), _cameraListNode(this), bMatchLayerRatio(true) {}
+    : Super(mode), _renderTarget(), _cameraListNode(this), bMatchLayerRatio(true), bOcclusionCulling(true) {}
 
 static const UInt8 skyboxVertices[] = {
 #include "SkyboxMesh.inl"
@@ -263,47 +272,338 @@ void Camera::beginRender() {
     Material::SetMatrixGlobal("an_MatrixInvVP", an_MatrixInvVP);
 }
 
-#define SHADOW_MAP_WIDTH 2048
-#define SHADOW_MAP_HEIGHT 2048
+static Texture2D *NewClusterTexture(PixelFormat format, UInt32 width, UInt32 height) {
+    TextureDescriptor desc{};
+    desc.width       = width;
+    desc.height      = height;
+    desc.pixelFormat = format;
+    desc.mipmapLevel = 1;
+
+    Texture2D *texture = NewObject<Texture2D>();
+    texture->init(desc);
+    /// keep cpu data, it is rewritten every frame
+    texture->setReadable(true);
+    memset(texture->getPixelData(), 0, texture->getDataSize());
+    return texture;
+}
 
 bool Camera::init() {
     if (!Super::init()) return false;
 
     _renderLoop = std::make_unique<ForwardRenderLoop>();
 
+    m_ShadowMap = nullptr;
+    updateShadowMap(GetQualitySettings().getShadowCascadeSettings());
+
+    const LightClusterSettings &clusterSettings = m_LightClusters.getSettings();
+    m_ClusterLightData    = NewClusterTexture(kPixelFormatRGBA32Float, 64, 3);
+    m_ClusterLightGrid    = NewClusterTexture(kPixelFormatR32Uint, clusterSettings.tilesX * clusterSettings.tilesY, clusterSettings.slices);
+    m_ClusterLightIndices = NewClusterTexture(kPixelFormatR32Uint, kLightClusterIndexRowWidth, 1);
+
+    return _renderLoop->init();
+}
+
+void Camera::updateShadowMap(const ShadowCascadeSettings &settings) {
+    /// all cascades share one atlas
+    UInt32 size = GetShadowAtlasTilesPerRow(settings.cascadeCount) * settings.resolution;
+    if (m_ShadowMap) {
+        Size shadowMapSize = m_ShadowMap->getSize();
+        if (shadowMapSize.width == size && shadowMapSize.height == size) return;
+        DestroyObject(m_ShadowMap);
+    }
+
     RenderTargetDescriptor rtDesc{};
-    rtDesc.width = SHADOW_MAP_WIDTH;
-    rtDesc.height = SHADOW_MAP_HEIGHT;
+    rtDesc.width = size;
+    rtDesc.height = size;
     rtDesc.format = kRTFormatShadowMap;
     rtDesc.samples = 1;
 
     m_ShadowMap = NewObject<RenderTarget>();
     m_ShadowMap->init(rtDesc);
-
-    return _renderLoop->init();
 }
 
 void Camera::dealloc() {
+    DestroyObject(m_ClusterLightData);
+    DestroyObject(m_ClusterLightGrid);
+    DestroyObject(m_ClusterLightIndices);
     _renderLoop->deinit();
     _renderLoop.reset();
     Super::dealloc();
 }
 
-Matrix4x4f GetShadowTransform(const Matrix4x4f &proj, const Matrix4x4f &view) {
-    Matrix4x4f worldToShadow = proj * view;
+void Camera::encodeRenderers(ParallelRenderEncoder &encoder, UInt32 frameIndex, const char *pass) {
+    encoder.encode(m_Renderers.size(), ParallelRenderEncoder::kDefaultChunkSize,
+                   [this, frameIndex, pass](RenderCommandList &list, size_t index) {
+                       m_Renderers[index]->Encode(list, frameIndex, pass);
+                   });
+}
+
+void Camera::encodeRenderers(ParallelRenderEncoder &encoder, std::span<const UInt32> indices, UInt32 frameIndex, const char *pass) {
+    encoder.encode(indices.size(), ParallelRenderEncoder::kDefaultChunkSize,
+                   [this, indices, frameIndex, pass](RenderCommandList &list, size_t index) {
+                       m_Renderers[indices[index]]->Encode(list, frameIndex, pass);
+                   });
+}
+
+void Camera::cullShadowCasters(const ShadowCascadeSettings &settings, const Vector3f &lightDirection, UInt32 frameIndex) {
+    ShadowCascadeViewParams viewParams;
+    viewParams.cameraToWorld  = an_MatrixInvV;
+    viewParams.fovyRadians    = Math::radians(_fovyDegree);
+    viewParams.aspect         = viewportRatio;
+    viewParams.nearZ          = _nearZ;
+    viewParams.farZ           = _farZ;
+    viewParams.lightDirection = lightDirection;
+    m_ShadowCascadeCount = ComputeShadowCascades(settings, viewParams, m_ShadowCascades);
+
+    m_ShadowCasterBounds.clear();
+    m_BoundedCasters.clear();
+    m_UnboundedCasters.clear();
+    for (UInt32 i = 0; i < m_Renderers.size(); ++i) {
+        AABB bounds;
+        if (m_Renderers[i]->getWorldAABB(frameIndex, bounds)) {
+            m_ShadowCasterBounds.push_back(bounds);
+            m_BoundedCasters.push_back(i);
+        } else {
+            m_UnboundedCasters.push_back(i);
+        }
+    }
+
+    for (UInt32 i = 0; i < kMaxShadowCascades; ++i) {
+        std::vector<UInt32> &casters = m_CascadeCasters[i];
+        casters.clear();
+        if (i >= m_ShadowCascadeCount) continue;
+
+        /// casters behind the view frustum but between the light and the cascade are kept,
+        /// the near plane is then pulled back to include them
+        CullShadowCasters(m_ShadowCascades[i], m_ShadowCasterBounds, casters);
+        FitShadowCascadeDepth(m_ShadowCascades[i], m_ShadowCasterBounds, casters);
+
+        for (UInt32 &caster : casters) {
+            caster = m_BoundedCasters[caster];
+        }
+        casters.insert(casters.end(), m_UnboundedCasters.begin(), m_UnboundedCasters.end());
+    }
+}
+
+void Camera::drawMainLightShadow(RenderContext &context, Light *mainLight) {
+    const ShadowCascadeSettings settings = GetQualitySettings().getShadowCascadeSettings();
+    UInt32 tilesPerRow = GetShadowAtlasTilesPerRow(m_ShadowCascadeCount);
+    UInt32 atlasSize   = tilesPerRow * settings.resolution;
+
+    CommandBuffer *cmd = context.commandBuffer;
+    cmd->debugLabelBegin("MainLightShadow", Vector4f(1.f));
+
+    Vector3f lightDirection = Math::normalize(mainLight->getTransform()->getPosition());
+    Material::SetVectorGlobal("_LightDirection", Vector4f(lightDirection, 1.f));
+
+    AttachmentDescriptor attachments[1]{};
+    attachments[0].format = kRTFormatShadowMap;
+    attachments[0].loadOp = kAttachmentLoadOpClear;
+    attachments[0].storeOp = kAttachmentStoreOpStore;
+    attachments[0].loadStoreTarget = m_ShadowMap;
+    //    attachments[0].clearDepth = 0.f;
+    cmd->beginRenderPass(atlasSize, atlasSize, 1, attachments, 0);
+
+    for (UInt32 i = 0; i < m_ShadowCascadeCount; ++i) {
+        const ShadowCascade &cascade = m_ShadowCascades[i];
+        SetGlobalViewProjectionMatrix(cascade.view, cascade.proj);
+
+        float depthBias = -mainLight->getDepthBias() * cascade.texelSize;
+        float normalBias = -mainLight->getNormalBias() * cascade.texelSize;
+        float kernelRadius = 3.5f;
+        depthBias *= kernelRadius;
+        normalBias *= kernelRadius;
+        Material::SetVectorGlobal("_ShadowBias", { depthBias, normalBias, 0.f, 0.f });
+
+        float originX = (float) (cascade.tileX * settings.resolution);
+        float originY = (float) (cascade.tileY * settings.resolution);
+        cmd->setViewport({ .originX = originX, .originY = originY,
+                           .width = (float) settings.resolution, .height = (float) settings.resolution });
+
+        cmd->setScissor({ .x = (int) originX, .y = (int) originY,
+                          .width = (int) settings.resolution, .height = (int) settings.resolution });
+
+        m_ShadowEncoders[i].execute(context);
+    }
+
+    cmd->endRenderPass();
+    cmd->debugLabelEnd();
+
+    /// receivers pick the first cascade whose split sphere contains them
+    static const char *kWorldToShadowNames[kMaxShadowCascades] = {
+        "_MainLightWorldToShadow", "_MainLightWorldToShadow1", "_MainLightWorldToShadow2", "_MainLightWorldToShadow3"
+    };
+    static const char *kSplitSphereNames[kMaxShadowCascades] = {
+        "_CascadeShadowSplitSpheres0", "_CascadeShadowSplitSpheres1", "_CascadeShadowSplitSpheres2", "_CascadeShadowSplitSpheres3"
+    };
+
+    Vector4f splitSphereRadii(0.f);
+    for (UInt32 i = 0; i < kMaxShadowCascades; ++i) {
+        if (i < m_ShadowCascadeCount) {
+            const ShadowCascade &cascade = m_ShadowCascades[i];
+            Material::SetMatrixGlobal(kWorldToShadowNames[i], GetShadowCascadeWorldToShadow(cascade, m_ShadowCascadeCount));
+            Material::SetVectorGlobal(kSplitSphereNames[i], cascade.splitSphere);
+            splitSphereRadii[i] = cascade.splitSphere.w * cascade.splitSphere.w;
+        } else {
+            Material::SetMatrixGlobal(kWorldToShadowNames[i], Math::identity<Matrix4x4f>());
+            Material::SetVectorGlobal(kSplitSphereNames[i], Vector4f(0.f));
+        }
+    }
+    Material::SetVectorGlobal("_CascadeShadowSplitSphereRadii", splitSphereRadii);
+
+    /// fade out the last 10% of shadow distance
+    float shadowDistance2 = settings.shadowDistance * settings.shadowDistance;
+    float fadeStart2      = 0.81f * shadowDistance2;
+    float fadeScale       = 1.f / (shadowDistance2 - fadeStart2);
+    Material::SetVectorGlobal("_MainLightShadowParams", { 1.f, 1.f, fadeScale, -fadeStart2 * fadeScale });
+
+    Material::SetTextureGlobal("_MainLightShadowmapTexture", m_ShadowMap);
+}
+
+void Camera::buildLightClusters() {
+    std::span<const LocalLightData> lights = GetLightManager().getLocalLights();
+
+    LightClusterViewParams viewParams;
+    viewParams.worldToCamera = an_MatrixV;
+    viewParams.fovyRadians   = Math::radians(_fovyDegree);
+    viewParams.aspect        = viewportRatio;
+    viewParams.nearZ         = _nearZ;
+    viewParams.farZ          = _farZ;
+    m_LightClusters.build(viewParams, lights);
+
+    /// light data, one column per light, grow in power of two to avoid recreating every frame
+    UInt32 lightCount = (UInt32) std::min<size_t>(lights.size(), m_LightClusters.getSettings().maxLights);
+    UInt32 dataWidth  = m_ClusterLightData->getDataWidth();
+    if (dataWidth < lightCount) {
+        dataWidth = std::bit_ceil(lightCount);
+        m_ClusterLightData->resize(dataWidth, 3);
+    }
+    Vector4f *lightData = (Vector4f *) m_ClusterLightData->getPixelData();
+    for (UInt32 i = 0; i < lightCount; ++i) {
+        const LocalLightData &light = lights[i];
+        lightData[i]                 = Vector4f(light.position, light.range);
+        lightData[dataWidth + i]     = Vector4f(Vector3f(light.color), light.spotCosInner);
+        lightData[2 * dataWidth + i] = Vector4f(light.spotDirection, light.spotCosOuter);
+    }
+    m_ClusterLightData->uploadToGPU();
+
+    std::span<const UInt32> grid = m_LightClusters.getClusterGrid();
+    const LightClusterSettings &settings = m_LightClusters.getSettings();
+    m_ClusterLightGrid->resize(settings.tilesX * settings.tilesY, settings.slices);
+    memcpy(m_ClusterLightGrid->getPixelData(), grid.data(), grid.size_bytes());
+    m_ClusterLightGrid->uploadToGPU();
+
+    std::span<const UInt32> indices = m_LightClusters.getLightIndices();
+    UInt32 indexRows = (UInt32) (indices.size() + kLightClusterIndexRowWidth - 1) / kLightClusterIndexRowWidth;
+    if (m_ClusterLightIndices->getDataHeight() < indexRows) {
+        m_ClusterLightIndices->resize(kLightClusterIndexRowWidth, std::bit_ceil(indexRows));
+    }
+    memcpy(m_ClusterLightIndices->getPixelData(), indices.data(), indices.size_bytes());
+    m_ClusterLightIndices->uploadToGPU();
+
+    Material::SetTextureGlobal("_ClusterLightData", m_ClusterLightData);
+    Material::SetTextureGlobal("_ClusterLightGrid", m_ClusterLightGrid);
+    Material::SetTextureGlobal("_ClusterLightIndices", m_ClusterLightIndices);
+    Material::SetVectorGlobal("_ClusterLightParams0", m_LightClusters.getShaderParams0());
+    Material::SetVectorGlobal("_ClusterLightParams1", m_LightClusters.getShaderParams1());
+}
 
-    Matrix4x4f textureScaleAndBias = Math::identity<Matrix4x4f>();
-    textureScaleAndBias[0][0] = 0.5f;
-    textureScaleAndBias[3][0] = 0.5f;
-    textureScaleAndBias[1][1] = -0.5f;
-    textureScaleAndBias[3][1] = 0.5f;
-//    textureScaleAndBias[2][2] = 0.5f;
-//    textureScaleAndBias[3][2] = -0.5f;
+void Camera::selectLODs() {
+    const QualitySettings &qualitySettings = GetQualitySettings();
 
-    // textureScaleAndBias map- texture space coordinates from [-1,1] to [0,1]
+    LODSelectionParams params;
+    params.cameraPosition    = getTransform()->getPosition();
+    params.screenHeightScale = 0.5f / std::tan(Math::radians(_fovyDegree) * 0.5f);
+    params.lodBias           = qualitySettings.getLODBias();
+    params.maxLOD            = qualitySettings.getMaximumLODLevel();
+    params.hysteresis        = kLODHysteresis;
+    GetLODGroupManager().selectLODs(params, m_LODStates);
+}
 
-    // Apply texture scale and offset to save a MAD in shader.
-    return textureScaleAndBias * worldToShadow;
+void Camera::requestTextureMips(UInt32 frameIndex, float frameHeight) {
+    Vector3f cameraPosition   = getTransform()->getPosition();
+    float    screenPixelScale = frameHeight * 0.5f / std::tan(Math::radians(_fovyDegree) * 0.5f);
+    for (UInt32 index : m_VisibleRenderers) {
+        m_Renderers[index]->requestTextureMips(frameIndex, cameraPosition, screenPixelScale);
+    }
+}
+
+void Camera::cullRenderers(UInt32 frameIndex) {
+    m_VisibleRenderers.clear();
+    if (!bOcclusionCulling) {
+        for (UInt32 i = 0; i < m_Renderers.size(); ++i) {
+            m_VisibleRenderers.push_back(i);
+        }
+        return;
+    }
+
+    m_OcclusionCulling.beginFrame(an_MatrixVP);
+
+    /// flagged mesh renderers and large ones on screen are rasterized as occluders
+    m_OccluderCandidates.clear();
+    m_OccluderRenderers.clear();
+    for (UInt32 i = 0; i < m_Renderers.size(); ++i) {
+        MeshRenderer *meshRenderer = m_Renderers[i]->as<MeshRenderer>();
+        if (meshRenderer == nullptr) continue;
+
+        Mesh *mesh = meshRenderer->getMesh();
+        AABB  bounds;
+        /// occluders are rasterized on the cpu, non readable meshes released their vertices
+        if (mesh == nullptr || !mesh->isAvailable(kShaderChannelVertex) || !mesh->hasCPUData() ||
+            !meshRenderer->getWorldAABB(frameIndex, bounds)) continue;
+
+        m_OccluderCandidates.push_back({ bounds, meshRenderer->isOccluder() });
+        m_OccluderRenderers.push_back(i);
+    }
+    m_OcclusionCulling.selectOccluders(m_OccluderCandidates, m_SelectedOccluders);
+
+    m_Occluders.clear();
+    m_DecodedOccluderVertices.resize(m_SelectedOccluders.size());
+    for (UInt32 candidate : m_SelectedOccluders) {
+        MeshRenderer *meshRenderer = (MeshRenderer *) m_Renderers[m_OccluderRenderers[candidate]];
+        Mesh         *mesh         = meshRenderer->getMesh();
+
+        OccluderMesh occluder;
+        if (mesh->getVertexCompression() & VERTEX_FORMAT1(Vertex)) {
+            std::vector<Vector3f> &vertices = m_DecodedOccluderVertices[m_Occluders.size()];
+            vertices.resize(mesh->getVertexCount());
+            mesh->extractVertices(vertices.data());
+            occluder.vertices = StrideIterator<Vector3f>(vertices.data(), sizeof(Vector3f));
+        } else {
+            occluder.vertices = mesh->getVertexBegin();
+        }
+        occluder.vertexCount   = mesh->getVertexCount();
+        occluder.indices       = mesh->getIndicesData();
+        occluder.indexFormat   = mesh->getIndexFormat();
+        occluder.indexCount    = mesh->getIndicesCount();
+        occluder.objectToWorld = meshRenderer->getObjectToWorld(frameIndex);
+        m_Occluders.push_back(occluder);
+    }
+    m_OcclusionCulling.renderOccluders(m_Occluders);
+
+    /// renderers without bounds are always drawn
+    m_OccludeeBounds.clear();
+    m_OccludeeRenderers.clear();
+    for (UInt32 i = 0; i < m_Renderers.size(); ++i) {
+        AABB bounds;
+        if (m_Renderers[i]->getWorldAABB(frameIndex, bounds)) {
+            m_OccludeeBounds.push_back(bounds);
+            m_OccludeeRenderers.push_back(i);
+        } else {
+            m_VisibleRenderers.push_back(i);
+        }
+    }
+
+    m_OcclusionResults.resize(m_OccludeeBounds.size());
+    m_OcclusionCulling.testOccludees(m_OccludeeBounds, m_OcclusionResults);
+    for (UInt32 i = 0; i < m_OcclusionResults.size(); ++i) {
+        if (m_OcclusionResults[i] == kOcclusionVisible) {
+            m_VisibleRenderers.push_back(m_OccludeeRenderers[i]);
+        }
+    }
+
+    /// keep the renderer list order, draw order should not depend on culling
+    std::sort(m_VisibleRenderers.begin(), m_VisibleRenderers.end());
 }
 
 void Camera::drawRenderers(RenderContext &context, const RendererList &rendererList) {
@@ -314,53 +614,38 @@ void Camera::drawRenderers(RenderContext &context, const RendererList &rendererL
 
     Material::SetVectorGlobal("_WorldSpaceCameraPos", Vector4f(getTransform()->getPosition(), 1.f));
 
-    Light *mainLight = GetLightManager().getMainLight();
-    if (mainLight) {
-        /// main light shadow
-        CommandBuffer *cmd = context.commandBuffer;
-        cmd->debugLabelBegin("MainLightShadow", Vector4f(1.f));
+    /// lod selection hides renderers of unselected levels before anything is culled or encoded
+    selectLODs();
 
-        Vector3f lightPos = mainLight->getTransform()->getPosition();
-        if (Math::normalize(lightPos).y >= 0.9999) {
-            lightPos += Vector3f(0.001f, 0.f, 0.f);
-        }
-        Matrix4x4f view = Math::lookAt(lightPos, { 0.f, 0.f, 0.f }, { 0.0f, 1.0f, 0.0f });
-        Matrix4x4f proj = Math::ortho(-10.0f, 10.0f, -10.0f, 10.0f, 0.03f, 300.0f);
-        SetGlobalViewProjectionMatrix(view, proj);
-
-        float frustumSize= 2.0f / proj[0][0];
-        float texelSize = frustumSize / SHADOW_MAP_WIDTH;
-        float depthBias = -mainLight->getDepthBias() * texelSize;
-        float normalBias = -mainLight->getNormalBias() * texelSize;
-        float kernelRadius = 3.5f;
-        depthBias *= kernelRadius;
-        normalBias *= kernelRadius;
-        Material::SetVectorGlobal("_ShadowBias", { depthBias, normalBias, 0.f, 0.f });
-        Material::SetVectorGlobal("_LightDirection", Vector4f(Math::normalize(lightPos), 1.f));
-        Material::SetVectorGlobal("_MainLightShadowParams", { 1.f, 1.f, 0.002f, -4.26f  });
+    m_Renderers.clear();
+    for (auto &node : rendererList) {
+        Renderer *renderer = node.getData();
+        if (renderer->isLODCulled()) continue;
+        m_Renderers.push_back(renderer);
+    }
+
+    Light *mainLight = GetLightManager().getMainLight();
 
-        AttachmentDescriptor attachments[1]{};
-        attachments[0].format = kRTFormatShadowMap;
-        attachments[0].loadOp = kAttachmentLoadOpClear;
-        attachments[0].storeOp = kAttachmentStoreOpStore;
-        attachments[0].loadStoreTarget = m_ShadowMap;
-        //    attachments[0].clearDepth = 0.f;
-        cmd->beginRenderPass(SHADOW_MAP_WIDTH, SHADOW_MAP_HEIGHT, 1, attachments, 0);
+    buildLightClusters();
 
-        cmd->setViewport({ .originX = 0.f, .originY = 0.f, .width = (float) SHADOW_MAP_WIDTH, .height = (float) SHADOW_MAP_HEIGHT });
+    /// record draw packets on worker threads, then replay them in order below
+    if (mainLight) {
+        const ShadowCascadeSettings settings = GetQualitySettings().getShadowCascadeSettings();
+        updateShadowMap(settings);
 
-        cmd->setScissor({ .x = 0, .y = 0, .width = (int) SHADOW_MAP_WIDTH, .height = (int) SHADOW_MAP_HEIGHT });
+        Vector3f lightDirection = Math::normalize(mainLight->getTransform()->getPosition());
+        cullShadowCasters(settings, lightDirection, context.frameIndex);
 
-        for (auto &node : rendererList) {
-            Renderer &renderer = *node;
-            renderer.Render(context, "ShadowCaster");
+        for (UInt32 i = 0; i < m_ShadowCascadeCount; ++i) {
+            encodeRenderers(m_ShadowEncoders[i], m_CascadeCasters[i], context.frameIndex, "ShadowCaster");
         }
+    }
+    cullRenderers(context.frameIndex);
+    requestTextureMips(context.frameIndex, (float) context.frameHeight);
+    encodeRenderers(m_ForwardEncoder, m_VisibleRenderers, context.frameIndex, "Forward");
 
-        cmd->endRenderPass();
-        cmd->debugLabelEnd();
-
-        Material::SetTextureGlobal("_MainLightShadowmapTexture", m_ShadowMap);
-        Material::SetMatrixGlobal("_MainLightWorldToShadow", GetShadowTransform(proj, view));
+    if (mainLight) {
+        drawMainLightShadow(context, mainLight);
     }
 
 
@@ -372,10 +657,7 @@ void Camera::drawRenderers(RenderContext &context, const RendererList &rendererL
 
               param->self->drawSkyBox(renderContext);
 
-              for (auto &node : param->rendererList) {
-                  Renderer &renderer = *node;
-                  renderer.Render(renderContext, "Forward");
-              }
+              param->self->m_ForwardEncoder.execute(renderContext);
 
 #if defined(OJOIE_WITH_EDITOR) && defined(OJOIE_USE_PHYSX)
               GetPhysicsManager().renderVisualization(renderContext.commandBuffer);
@@ -7,6 +7,7 @@
 #include "Utility/Log.h"
 #include "Template/Access.hpp"
 #include "Core/Behavior.hpp"
+#include "Animation/Animator.hpp"
 
 #include "Audio/AudioManager.hpp"
 
@@ -17,6 +18,7 @@
 #include "Input/InputManager.hpp"
 #include "Render/RenderContext.hpp"
 #include "Misc/ResourceManager.hpp"
+#include "Utility/Path.hpp"
 
 #include "Physics/PhysicsManager.hpp"
 
@@ -33,6 +35,11 @@
 
 namespace AN {
 
+/// main thread time async resource loads may take each frame
+static constexpr float kAsyncLoadBudgetSeconds = 0.002f;
+
+/// shipping builds pack Data into one archive in the working directory, see tools/utils/AssetPacker
+static constexpr const char *kDataArchiveName = "Data.anpak";
 
 struct Game::Impl {
 };
@@ -54,6 +61,9 @@ Game &Game::GetSharedGame() {
 
 bool Game::init() {
     frameVersion = 0;
+    if (Path(kDataArchiveName).Exists()) {
+        GetResourceManager().mountArchive(kDataArchiveName);
+    }
     GetResourceManager().loadBuiltinResources();
     return true;
 }
@@ -90,9 +100,14 @@ void Game::tick() {
     GetPhysicsManager().update(deltaTime);
 #endif
 
+    /// evict unreferenced resources over budget, then finish async resource loads in a slice of the frame
+    GetResourceManager().updateResidency();
+    GetResourceManager().updateAsyncLoads(kAsyncLoadBudgetSeconds);
+
     /// update behavior component
     GetBehaviorManager().update();
 
+    GetAnimationManager().update(deltaTime);
 
     GetRenderManager().performUpdate(frameVersion);
 
@@ -25,6 +25,7 @@ Mesh *GetCubeMesh() {
         mesh->setUV(0, cube.texcoord0s.data(), cube.texcoord0s.size());
         mesh->setNormals(cube.normals.data(), cube.normals.size());
         mesh->setIndices(cube.indices.data(), cube.indices.size(), 0);
+        mesh->recalculateTangents();
 
         mesh->createVertexBuffer();
     });
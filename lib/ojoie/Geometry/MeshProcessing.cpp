@@ -0,0 +1,355 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Geometry/MeshProcessing.hpp"
+#include "Threads/ParallelFor.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MESH_PROCESSING_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace AN {
+
+static constexpr size_t kVertexGrainSize   = 16384;
+static constexpr size_t kTriangleGrainSize = 8192;
+
+namespace {
+
+struct IndexReader {
+    const UInt16 *indices16;
+    const UInt32 *indices32;
+
+    explicit IndexReader(const IndexBufferData &data)
+        : indices16(data.format == kIndexFormatUInt16 ? (const UInt16 *) data.indices : nullptr),
+          indices32(data.format == kIndexFormatUInt32 ? (const UInt32 *) data.indices : nullptr) {}
+
+    UInt32 operator[](size_t index) const { return indices32 ? indices32[index] : indices16[index]; }
+};
+
+/// triangles touching each row, a row is a vertex or a group of welded vertices
+struct FaceRows {
+    std::vector<UInt32> start;
+    std::vector<UInt32> faces;
+
+    std::span<const UInt32> get(size_t row) const {
+        return { faces.data() + start[row], faces.data() + start[row + 1] };
+    }
+};
+
+}
+
+static void BuildFaceRows(const IndexReader &indices, size_t triangleCount,
+                          const UInt32 *rowOfVertex, size_t rowCount, FaceRows &out) {
+    size_t cornerCount = triangleCount * 3;
+    out.start.assign(rowCount + 1, 0);
+    for (size_t i = 0; i < cornerCount; ++i) {
+        UInt32 vertex = indices[i];
+        ++out.start[(rowOfVertex ? rowOfVertex[vertex] : vertex) + 1];
+    }
+    for (size_t row = 0; row < rowCount; ++row) {
+        out.start[row + 1] += out.start[row];
+    }
+
+    out.faces.resize(cornerCount);
+    std::vector<UInt32> cursor(out.start.begin(), out.start.end() - 1);
+    for (size_t i = 0; i < cornerCount; ++i) {
+        UInt32 vertex = indices[i];
+        UInt32 row    = rowOfVertex ? rowOfVertex[vertex] : vertex;
+        out.faces[cursor[row]++] = (UInt32) (i / 3);
+    }
+}
+
+/// vertices with equal positions get the same group, returns the group count
+static size_t WeldPositions(StrideIterator<Vector3f> vertices, size_t vertexCount, std::vector<UInt32> &outGroup) {
+    struct Key {
+        float  x, y, z;
+        UInt32 vertex;
+    };
+
+    std::vector<Key> keys(vertexCount);
+    ParallelFor(vertexCount, kVertexGrainSize, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Vector3f &p = vertices[i];
+            /// adding 0 turns -0 into 0
+            keys[i] = { p.x + 0.f, p.y + 0.f, p.z + 0.f, (UInt32) i };
+        }
+    });
+    std::sort(keys.begin(), keys.end(), [](const Key &a, const Key &b) {
+        if (a.x != b.x) return a.x < b.x;
+        if (a.y != b.y) return a.y < b.y;
+        return a.z < b.z;
+    });
+
+    outGroup.resize(vertexCount);
+    size_t groupCount = 0;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        if (i > 0 && (keys[i].x != keys[i - 1].x || keys[i].y != keys[i - 1].y || keys[i].z != keys[i - 1].z)) {
+            ++groupCount;
+        }
+        outGroup[keys[i].vertex] = (UInt32) groupCount;
+    }
+    return vertexCount ? groupCount + 1 : 0;
+}
+
+/// unnormalized face normals, the length is twice the triangle area
+static void CalculateFaceNormals(StrideIterator<Vector3f> vertices, const IndexReader &indices,
+                                 size_t begin, size_t end, Vector3f *out) {
+    size_t t = begin;
+#ifdef MESH_PROCESSING_USE_SSE
+    /// four triangles at a time in structure of arrays layout
+    for (; t + 4 <= end; t += 4) {
+        alignas(16) float p[3][3][4];
+        for (int lane = 0; lane < 4; ++lane) {
+            for (int k = 0; k < 3; ++k) {
+                const Vector3f &v = vertices[indices[(t + lane) * 3 + k]];
+                p[k][0][lane]     = v.x;
+                p[k][1][lane]     = v.y;
+                p[k][2][lane]     = v.z;
+            }
+        }
+
+        __m128 e1[3], e2[3];
+        for (int c = 0; c < 3; ++c) {
+            __m128 p0 = _mm_load_ps(p[0][c]);
+            e1[c]     = _mm_sub_ps(_mm_load_ps(p[1][c]), p0);
+            e2[c]     = _mm_sub_ps(_mm_load_ps(p[2][c]), p0);
+        }
+
+        alignas(16) float n[3][4];
+        _mm_store_ps(n[0], _mm_sub_ps(_mm_mul_ps(e1[1], e2[2]), _mm_mul_ps(e1[2], e2[1])));
+        _mm_store_ps(n[1], _mm_sub_ps(_mm_mul_ps(e1[2], e2[0]), _mm_mul_ps(e1[0], e2[2])));
+        _mm_store_ps(n[2], _mm_sub_ps(_mm_mul_ps(e1[0], e2[1]), _mm_mul_ps(e1[1], e2[0])));
+        for (int lane = 0; lane < 4; ++lane) {
+            out[t + lane] = Vector3f(n[0][lane], n[1][lane], n[2][lane]);
+        }
+    }
+#endif
+    for (; t < end; ++t) {
+        const Vector3f &p0 = vertices[indices[t * 3]];
+        const Vector3f &p1 = vertices[indices[t * 3 + 1]];
+        const Vector3f &p2 = vertices[indices[t * 3 + 2]];
+        out[t] = Math::cross(p1 - p0, p2 - p0);
+    }
+}
+
+static Vector3f NormalizeOr(const Vector3f &v, const Vector3f &fallback) {
+    float length = Math::length(v);
+    return length > FLT_MIN ? v / length : fallback;
+}
+
+static Vector3f AnyPerpendicular(const Vector3f &n) {
+    Vector3f axis = std::abs(n.x) < 0.9f ? Vector3f(1.f, 0.f, 0.f) : Vector3f(0.f, 1.f, 0.f);
+    return NormalizeOr(Math::cross(n, axis), Vector3f(1.f, 0.f, 0.f));
+}
+
+AABB CalculateBounds(StrideIterator<Vector3f> vertices, size_t count) {
+    if (count == 0) return AABB::Empty();
+
+    size_t chunkCount = (count + kVertexGrainSize - 1) / kVertexGrainSize;
+    std::vector<Vector3f> mins(chunkCount), maxs(chunkCount);
+
+    ParallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; ++chunk) {
+            size_t first = chunk * kVertexGrainSize;
+            size_t last  = std::min(count, first + kVertexGrainSize);
+#ifdef MESH_PROCESSING_USE_SSE
+            __m128 minV = _mm_set1_ps(FLT_MAX);
+            __m128 maxV = _mm_set1_ps(-FLT_MAX);
+            /// the fourth lane reads into the next vertex, so the very last vertex is loaded separately
+            size_t loadEnd = last == count ? last - 1 : last;
+            for (size_t i = first; i < loadEnd; ++i) {
+                __m128 p = _mm_loadu_ps(&vertices[i].x);
+                minV     = _mm_min_ps(minV, p);
+                maxV     = _mm_max_ps(maxV, p);
+            }
+            if (loadEnd != last) {
+                const Vector3f &v = vertices[loadEnd];
+                __m128          p = _mm_setr_ps(v.x, v.y, v.z, v.z);
+                minV              = _mm_min_ps(minV, p);
+                maxV              = _mm_max_ps(maxV, p);
+            }
+            alignas(16) float minF[4], maxF[4];
+            _mm_store_ps(minF, minV);
+            _mm_store_ps(maxF, maxV);
+            mins[chunk] = Vector3f(minF[0], minF[1], minF[2]);
+            maxs[chunk] = Vector3f(maxF[0], maxF[1], maxF[2]);
+#else
+            Vector3f minV(FLT_MAX), maxV(-FLT_MAX);
+            for (size_t i = first; i < last; ++i) {
+                minV = Math::min(minV, vertices[i]);
+                maxV = Math::max(maxV, vertices[i]);
+            }
+            mins[chunk] = minV;
+            maxs[chunk] = maxV;
+#endif
+        }
+    });
+
+    Vector3f minV = mins[0], maxV = maxs[0];
+    for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+        minV = Math::min(minV, mins[chunk]);
+        maxV = Math::max(maxV, maxs[chunk]);
+    }
+    return AABB::FromMinMax(minV, maxV);
+}
+
+void CalculateNormals(StrideIterator<Vector3f> vertices, size_t vertexCount, const IndexBufferData &indices,
+                      StrideIterator<Vector3f> outNormals, float smoothingAngle) {
+    const Vector3f kDefaultNormal(0.f, 1.f, 0.f);
+
+    IndexReader reader(indices);
+    size_t      triangleCount = indices.count / 3;
+
+    std::vector<Vector3f> faceNormals(triangleCount);
+    ParallelFor(triangleCount, kTriangleGrainSize, [&](size_t begin, size_t end) {
+        CalculateFaceNormals(vertices, reader, begin, end, faceNormals.data());
+    });
+
+    std::vector<UInt32> group;
+    size_t              groupCount = WeldPositions(vertices, vertexCount, group);
+
+    FaceRows groupFaces;
+    BuildFaceRows(reader, triangleCount, group.data(), groupCount, groupFaces);
+
+    if (smoothingAngle >= 180.f) {
+        ParallelFor(vertexCount, kVertexGrainSize, [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) {
+                Vector3f normal(0.f);
+                for (UInt32 face : groupFaces.get(group[v])) {
+                    normal += faceNormals[face];
+                }
+                outNormals[v] = NormalizeOr(normal, kDefaultNormal);
+            }
+        });
+        return;
+    }
+
+    std::vector<Vector3f> unitNormals(triangleCount);
+    ParallelFor(triangleCount, kTriangleGrainSize, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            unitNormals[t] = NormalizeOr(faceNormals[t], Vector3f(0.f));
+        }
+    });
+
+    FaceRows vertexFaces;
+    BuildFaceRows(reader, triangleCount, nullptr, vertexCount, vertexFaces);
+
+    /// small bias so that coplanar faces are always smoothed with 0 degrees
+    float cosThreshold = std::cos(Math::radians(std::max(smoothingAngle, 0.f))) - 1e-5f;
+    ParallelFor(vertexCount, kVertexGrainSize, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            Vector3f normal(0.f);
+            for (UInt32 face : vertexFaces.get(v)) {
+                for (UInt32 other : groupFaces.get(group[v])) {
+                    if (Math::dot(unitNormals[face], unitNormals[other]) >= cosThreshold) {
+                        normal += faceNormals[other];
+                    }
+                }
+            }
+            outNormals[v] = NormalizeOr(normal, kDefaultNormal);
+        }
+    });
+}
+
+void CalculateTangents(StrideIterator<Vector3f> vertices, StrideIterator<Vector3f> normals,
+                       StrideIterator<Vector2f> uvs, size_t vertexCount, const IndexBufferData &indices,
+                       StrideIterator<Vector4f> outTangents) {
+    struct FaceTangent {
+        Vector3f tangent;// unit direction of increasing u
+        float    sign;   // 1 when the uv mapping keeps the orientation, 0 for degenerate uvs
+    };
+
+    IndexReader reader(indices);
+    size_t      triangleCount = indices.count / 3;
+
+    std::vector<FaceTangent> faceTangents(triangleCount);
+    ParallelFor(triangleCount, kTriangleGrainSize, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            UInt32 i0 = reader[t * 3], i1 = reader[t * 3 + 1], i2 = reader[t * 3 + 2];
+
+            Vector3f d1  = vertices[i1] - vertices[i0];
+            Vector3f d2  = vertices[i2] - vertices[i0];
+            Vector2f t21 = uvs[i1] - uvs[i0];
+            Vector2f t31 = uvs[i2] - uvs[i0];
+
+            float    signedArea = t21.x * t31.y - t21.y * t31.x;
+            Vector3f os         = t31.y * d1 - t21.y * d2;
+            float    length     = Math::length(os);
+            if (std::abs(signedArea) <= FLT_MIN || length <= FLT_MIN) {
+                faceTangents[t] = { Vector3f(0.f), 0.f };
+                continue;
+            }
+
+            float sign      = signedArea > 0.f ? 1.f : -1.f;
+            faceTangents[t] = { os * (sign / length), sign };
+        }
+    });
+
+    FaceRows vertexFaces;
+    BuildFaceRows(reader, triangleCount, nullptr, vertexCount, vertexFaces);
+
+    ParallelFor(vertexCount, kVertexGrainSize, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            Vector3f normal = NormalizeOr(normals[v], Vector3f(0.f, 1.f, 0.f));
+
+            /// accumulate both handedness separately, index 1 is the orientation preserving side
+            Vector3f sum[2]    = { Vector3f(0.f), Vector3f(0.f) };
+            float    weight[2] = { 0.f, 0.f };
+
+            for (UInt32 face : vertexFaces.get(v)) {
+                const FaceTangent &faceTangent = faceTangents[face];
+                if (faceTangent.sign == 0.f) continue;
+
+                UInt32 corner[3] = { reader[face * 3], reader[face * 3 + 1], reader[face * 3 + 2] };
+                int    k         = corner[0] == v ? 0 : (corner[1] == v ? 1 : 2);
+
+                /// corner angle measured in the tangent plane of the vertex
+                Vector3f edge0 = vertices[corner[(k + 1) % 3]] - vertices[v];
+                Vector3f edge1 = vertices[corner[(k + 2) % 3]] - vertices[v];
+                edge0          = NormalizeOr(edge0 - normal * Math::dot(normal, edge0), Vector3f(0.f));
+                edge1          = NormalizeOr(edge1 - normal * Math::dot(normal, edge1), Vector3f(0.f));
+                if (edge0 == Vector3f(0.f) || edge1 == Vector3f(0.f)) continue;
+                float angle = std::acos(std::clamp(Math::dot(edge0, edge1), -1.f, 1.f));
+
+                Vector3f tangent = faceTangent.tangent - normal * Math::dot(normal, faceTangent.tangent);
+                tangent          = NormalizeOr(tangent, Vector3f(0.f));
+                if (tangent == Vector3f(0.f)) continue;
+
+                int side = faceTangent.sign > 0.f;
+                sum[side] += tangent * angle;
+                weight[side] += angle;
+            }
+
+            int      side    = weight[1] >= weight[0];
+            Vector3f tangent = NormalizeOr(sum[side], Vector3f(0.f));
+            if (tangent == Vector3f(0.f)) {
+                tangent = AnyPerpendicular(normal);
+            }
+            outTangents[v] = Vector4f(tangent, side ? 1.f : -1.f);
+        }
+    });
+}
+
+float CalculateUVDistributionMetric(StrideIterator<Vector3f> vertices, StrideIterator<Vector2f> uvs,
+                                    const IndexBufferData &indices) {
+    IndexReader reader(indices);
+    double      worldArea = 0.0, uvArea = 0.0;
+    for (size_t face = 0; face < indices.count / 3; ++face) {
+        UInt32 i0 = reader[face * 3], i1 = reader[face * 3 + 1], i2 = reader[face * 3 + 2];
+        Vector3f edge1 = vertices[i1] - vertices[i0], edge2 = vertices[i2] - vertices[i0];
+        Vector2f uv1 = uvs[i1] - uvs[i0], uv2 = uvs[i2] - uvs[i0];
+        worldArea += Math::length(Math::cross(edge1, edge2));
+        uvArea    += std::abs(uv1.x * uv2.y - uv1.y * uv2.x);
+    }
+    return uvArea > 1e-12 ? (float) (worldArea / uvArea) : 0.f;
+}
+
+}
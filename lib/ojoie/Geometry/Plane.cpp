@@ -23,6 +23,7 @@ Mesh *GetPlaneMesh() {
         mesh->setUV(0, plane.texcoord0s.data(), plane.texcoord0s.size());
         mesh->setNormals(plane.normals.data(), plane.normals.size());
         mesh->setIndices(plane.indices.data(), plane.indices.size(), 0);
+        mesh->recalculateTangents();
 
         mesh->createVertexBuffer();
     });
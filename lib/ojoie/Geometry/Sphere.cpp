@@ -23,6 +23,7 @@ Mesh *GetSphereMesh() {
         mesh->setUV(0, sphere.uvs.data(), sphere.uvs.size());
         mesh->setNormals(sphere.normals.data(), sphere.normals.size());
         mesh->setIndices(sphere.indices.data(), sphere.indices.size(), 0);
+        mesh->recalculateTangents();
 
         mesh->createVertexBuffer();
     });
@@ -0,0 +1,12 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "HAL/MappedFile.hpp"
+#include "Utility/Log.h"
+
+#ifdef AN_WIN
+#include "win32/MappedFile.cpp"
+#else
+#include "posix/MappedFile.cpp"
+#endif
@@ -0,0 +1,68 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "HAL/MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace AN
+{
+
+MappedFile::MappedFile()
+    : _fd(-1),
+      _data(),
+      _size() {}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const char *path)
+{
+    Close();
+    _fd = open(path, O_RDONLY);
+    if (_fd < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(_fd, &status) != 0 || status.st_size == 0)
+    {
+        Close();
+        return false;
+    }
+
+    void *data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (data == MAP_FAILED)
+    {
+        AN_LOG(Error, "Failed mapping %s", path);
+        Close();
+        return false;
+    }
+    _data = (const UInt8 *)data;
+    _size = (size_t)status.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (_data)
+    {
+        munmap((void *)_data, _size);
+        _data = nullptr;
+    }
+    if (_fd >= 0)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+    _size = 0;
+}
+
+}
@@ -0,0 +1,80 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "HAL/MappedFile.hpp"
+#include "Utility/win32/Unicode.hpp"
+
+#include <Windows.h>
+
+namespace AN
+{
+
+MappedFile::MappedFile()
+    : _fileHandle(INVALID_HANDLE_VALUE),
+      _mappingHandle(),
+      _data(),
+      _size() {}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const char *path)
+{
+    Close();
+    _fileHandle = CreateFileW(Utf8ToWide(path).c_str(), FILE_GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+    if (_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_fileHandle, &size) || size.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    _mappingHandle = CreateFileMappingW(_fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (_mappingHandle == NULL)
+    {
+        AN_LOG(Error, "Failed mapping %s, error %lu", path, GetLastError());
+        Close();
+        return false;
+    }
+
+    _data = (const UInt8 *)MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (_data == nullptr)
+    {
+        AN_LOG(Error, "Failed mapping a view of %s, error %lu", path, GetLastError());
+        Close();
+        return false;
+    }
+    _size = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (_data)
+    {
+        UnmapViewOfFile(_data);
+        _data = nullptr;
+    }
+    if (_mappingHandle)
+    {
+        CloseHandle(_mappingHandle);
+        _mappingHandle = NULL;
+    }
+    if (_fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(_fileHandle);
+        _fileHandle = INVALID_HANDLE_VALUE;
+    }
+    _size = 0;
+}
+
+}
@@ -0,0 +1,307 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Misc/AssetArchive.hpp"
+#include "Utility/Compression.hpp"
+#include "Utility/Hash128.hpp"
+#include "Utility/Log.h"
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+
+namespace AN {
+
+static inline char FoldPathChar(char c) {
+    if (c == '\\') return '/';
+    return c >= 'A' && c <= 'Z' ? (char) (c - 'A' + 'a') : c;
+}
+
+/// lookups ignore case and slash direction
+static std::string FoldPath(std::string_view path) {
+    std::string folded(path);
+    for (char &c : folded) c = FoldPathChar(c);
+    while (folded.starts_with("./")) folded.erase(0, 2);
+    while (folded.ends_with('/')) folded.pop_back();
+    return folded;
+}
+
+static inline UInt64 HashPath(std::string_view foldedPath) {
+    return ComputeHash128(foldedPath).u64[0];
+}
+
+static bool FoldedEquals(std::string_view path, std::string_view foldedPath) {
+    if (path.size() != foldedPath.size()) return false;
+    for (size_t i = 0; i < path.size(); ++i) {
+        if (FoldPathChar(path[i]) != foldedPath[i]) return false;
+    }
+    return true;
+}
+
+AssetArchive::AssetArchive()
+    : _header(), _entries(), _slots(), _blocks(), _strings() {}
+
+bool AssetArchive::open(const char *path, std::string_view rootDirectory) {
+    close();
+    if (!_file.Open(path)) return false;
+
+    const UInt8 *data = _file.GetData();
+    size_t       size = _file.GetSize();
+    auto         fits = [size](UInt64 offset, UInt64 bytes) { return offset <= size && bytes <= size - offset; };
+
+    const AssetArchiveHeader *header = (const AssetArchiveHeader *) data;
+    if (size < sizeof(AssetArchiveHeader) || header->magic != kAssetArchiveMagic ||
+        header->version != kAssetArchiveVersion || !std::has_single_bit(header->slotCount) ||
+        header->slotCount <= header->entryCount || header->blockSize == 0 ||
+        !fits(header->entriesOffset, (UInt64) header->entryCount * sizeof(AssetArchiveEntry)) ||
+        !fits(header->slotsOffset, (UInt64) header->slotCount * sizeof(UInt32)) ||
+        !fits(header->blocksOffset, (UInt64) header->blockCount * sizeof(AssetArchiveBlock)) ||
+        !fits(header->stringsOffset, header->stringsSize)) {
+        AN_LOG(Error, "%s is not a valid asset archive", path);
+        _file.Close();
+        return false;
+    }
+
+    _header  = header;
+    _entries = (const AssetArchiveEntry *) (data + header->entriesOffset);
+    _slots   = (const UInt32 *) (data + header->slotsOffset);
+    _blocks  = (const AssetArchiveBlock *) (data + header->blocksOffset);
+    _strings = (const char *) (data + header->stringsOffset);
+    _root       = rootDirectory;
+    _foldedRoot = FoldPath(rootDirectory);
+    return true;
+}
+
+void AssetArchive::close() {
+    _file.Close();
+    _header  = nullptr;
+    _entries = nullptr;
+    _slots   = nullptr;
+    _blocks  = nullptr;
+    _strings = nullptr;
+    _root.clear();
+    _foldedRoot.clear();
+}
+
+int AssetArchive::find(std::string_view path) const {
+    if (!isOpen()) return -1;
+
+    std::string folded = FoldPath(path);
+    if (!_foldedRoot.empty() && folded.size() > _foldedRoot.size() && folded.starts_with(_foldedRoot) &&
+        folded[_foldedRoot.size()] == '/') {
+        folded.erase(0, _foldedRoot.size() + 1);
+    }
+
+    UInt64 hash = HashPath(folded);
+    UInt32 mask = _header->slotCount - 1;
+    for (UInt32 i = (UInt32) hash & mask, probes = 0; probes < _header->slotCount; i = (i + 1) & mask, ++probes) {
+        UInt32 slot = _slots[i];
+        if (slot == 0 || slot > _header->entryCount) return -1;
+
+        int index = (int) slot - 1;
+        if (_entries[index].pathHash == hash && FoldedEquals(getPath(index), folded)) return index;
+    }
+    return -1;
+}
+
+std::string_view AssetArchive::getPath(int index) const {
+    const AssetArchiveEntry &entry = _entries[index];
+    if ((UInt64) entry.pathOffset + entry.pathLength > _header->stringsSize) return {};
+    return { _strings + entry.pathOffset, entry.pathLength };
+}
+
+const UInt8 *AssetArchive::getData(int index) const {
+    const AssetArchiveEntry &entry = _entries[index];
+    if (entry.blockCount != 0 || entry.dataOffset > _file.GetSize() || entry.size > _file.GetSize() - entry.dataOffset) {
+        return nullptr;
+    }
+    return _file.GetData() + entry.dataOffset;
+}
+
+bool AssetArchive::read(int index, void *buffer) const {
+    const AssetArchiveEntry &entry = _entries[index];
+    if (entry.blockCount == 0) {
+        const UInt8 *data = getData(index);
+        if (data == nullptr) return false;
+        memcpy(buffer, data, entry.size);
+        return true;
+    }
+
+    if ((UInt64) entry.firstBlock + entry.blockCount > _header->blockCount) return false;
+
+    UInt8 *output    = (UInt8 *) buffer;
+    UInt64 remaining = entry.size;
+    for (UInt32 i = 0; i < entry.blockCount; ++i) {
+        const AssetArchiveBlock &block   = _blocks[entry.firstBlock + i];
+        UInt32                   rawSize = (UInt32) std::min<UInt64>(remaining, _header->blockSize);
+        if (block.offset > _file.GetSize() || block.storedSize > _file.GetSize() - block.offset) return false;
+
+        const UInt8 *stored = _file.GetData() + block.offset;
+        if (block.storedSize == rawSize) {
+            memcpy(output, stored, rawSize);
+        } else if (!LZ4Decompress(stored, block.storedSize, output, rawSize)) {
+            AN_LOG(Error, "Corrupt block %u of %.*s", i, (int) entry.pathLength, _strings + entry.pathOffset);
+            return false;
+        }
+        output += rawSize;
+        remaining -= rawSize;
+    }
+    return remaining == 0;
+}
+
+bool AssetArchive::readText(int index, std::string &text) const {
+    text.resize(getSize(index));
+    return read(index, text.data());
+}
+
+bool AssetArchive::readView(int index, std::string &buffer, std::string_view &text) const {
+    if (!isCompressed(index)) {
+        const UInt8 *data = getData(index);
+        if (data == nullptr) return false;
+        text = { (const char *) data, (size_t) getSize(index) };
+        return true;
+    }
+
+    if (!readText(index, buffer)) return false;
+    text = buffer;
+    return true;
+}
+
+AssetArchiveWriter::AssetArchiveWriter(UInt32 blockSize, UInt32 alignment)
+    : _blockSize(blockSize), _alignment(std::bit_ceil(std::max<UInt32>(alignment, 1))) {}
+
+void AssetArchiveWriter::add(std::string_view path, std::vector<UInt8> data, bool bCompress) {
+    std::string stored(path);
+    for (char &c : stored) {
+        if (c == '\\') c = '/';
+    }
+    while (stored.starts_with("./")) stored.erase(0, 2);
+
+    auto [it, bInserted] = _indices.emplace(FoldPath(stored), _entries.size());
+    if (bInserted) {
+        _entries.push_back({ std::move(stored), std::move(data), bCompress });
+    } else {
+        _entries[it->second] = { std::move(stored), std::move(data), bCompress };
+    }
+}
+
+bool AssetArchiveWriter::write(const char *path, UInt64 *outArchiveSize) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        AN_LOG(Error, "Failed creating asset archive %s", path);
+        return false;
+    }
+
+    AssetArchiveHeader header{};
+    file.write((const char *) &header, sizeof header);
+    UInt64 offset = sizeof header;
+
+    auto pad = [&](UInt64 alignment) {
+        static const char kZeros[256] = {};
+        UInt64 padding = (alignment - offset % alignment) % alignment;
+        for (UInt64 left = padding; left > 0; left -= std::min<UInt64>(left, sizeof kZeros)) {
+            file.write(kZeros, (std::streamsize) std::min<UInt64>(left, sizeof kZeros));
+        }
+        offset += padding;
+    };
+
+    std::vector<AssetArchiveEntry> entries;
+    std::vector<AssetArchiveBlock> blocks;
+    std::string                    strings;
+    std::vector<std::vector<UInt8>> compressed;
+    entries.reserve(_entries.size());
+
+    for (const PendingEntry &pending : _entries) {
+        AssetArchiveEntry entry{};
+        entry.pathHash   = HashPath(FoldPath(pending.path));
+        entry.size       = pending.data.size();
+        entry.pathOffset = (UInt32) strings.size();
+        entry.pathLength = (UInt32) pending.path.size();
+        strings += pending.path;
+
+        /// compress each block on its own so a reader can decode any of them
+        size_t storedSize = 0;
+        compressed.clear();
+        if (pending.bCompress) {
+            for (size_t begin = 0; begin < pending.data.size(); begin += _blockSize) {
+                size_t             rawSize = std::min<size_t>(_blockSize, pending.data.size() - begin);
+                std::vector<UInt8> block(LZ4CompressBound(rawSize));
+                size_t             size = LZ4Compress(pending.data.data() + begin, rawSize, block.data(), block.size());
+                if (size >= rawSize) {
+                    block.assign(pending.data.begin() + begin, pending.data.begin() + begin + rawSize);
+                } else {
+                    block.resize(size);
+                }
+                storedSize += block.size();
+                compressed.push_back(std::move(block));
+            }
+        }
+
+        /// barely compressible data stays uncompressed and aligned so it is read in place
+        if (!compressed.empty() && storedSize * 16 < pending.data.size() * 15) {
+            entry.firstBlock = (UInt32) blocks.size();
+            entry.blockCount = (UInt32) compressed.size();
+            entry.dataOffset = offset;
+            for (const std::vector<UInt8> &block : compressed) {
+                blocks.push_back({ offset, (UInt32) block.size(), 0 });
+                file.write((const char *) block.data(), (std::streamsize) block.size());
+                offset += block.size();
+            }
+        } else {
+            pad(_alignment);
+            entry.dataOffset = offset;
+            file.write((const char *) pending.data.data(), (std::streamsize) pending.data.size());
+            offset += pending.data.size();
+        }
+        entries.push_back(entry);
+    }
+
+    /// a quarter of the slots at least stay empty so probes are short
+    UInt32              slotCount = std::bit_ceil(std::max<UInt32>(16, (UInt32) entries.size() * 4 / 3 + 1));
+    std::vector<UInt32> slots(slotCount);
+    for (UInt32 index = 0; index < entries.size(); ++index) {
+        UInt32 i = (UInt32) entries[index].pathHash & (slotCount - 1);
+        while (slots[i] != 0) i = (i + 1) & (slotCount - 1);
+        slots[i] = index + 1;
+    }
+
+    header.magic      = kAssetArchiveMagic;
+    header.version    = kAssetArchiveVersion;
+    header.entryCount = (UInt32) entries.size();
+    header.slotCount  = slotCount;
+    header.blockSize  = _blockSize;
+    header.blockCount = (UInt32) blocks.size();
+
+    pad(alignof(UInt64));
+    header.entriesOffset = offset;
+    file.write((const char *) entries.data(), (std::streamsize) (entries.size() * sizeof(AssetArchiveEntry)));
+    offset += entries.size() * sizeof(AssetArchiveEntry);
+
+    header.slotsOffset = offset;
+    file.write((const char *) slots.data(), (std::streamsize) (slots.size() * sizeof(UInt32)));
+    offset += slots.size() * sizeof(UInt32);
+
+    pad(alignof(UInt64));
+    header.blocksOffset = offset;
+    file.write((const char *) blocks.data(), (std::streamsize) (blocks.size() * sizeof(AssetArchiveBlock)));
+    offset += blocks.size() * sizeof(AssetArchiveBlock);
+
+    header.stringsOffset = offset;
+    header.stringsSize   = strings.size();
+    file.write(strings.data(), (std::streamsize) strings.size());
+    offset += strings.size();
+
+    file.seekp(0);
+    file.write((const char *) &header, sizeof header);
+    file.close();
+    if (file.fail()) {
+        AN_LOG(Error, "Failed writing asset archive %s", path);
+        return false;
+    }
+
+    if (outArchiveSize) *outArchiveSize = offset;
+    return true;
+}
+
+}
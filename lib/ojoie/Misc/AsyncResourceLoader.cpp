@@ -0,0 +1,367 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Misc/AsyncResourceLoader.hpp"
+#include "Threads/Threads.hpp"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+namespace AN {
+
+namespace {
+
+/// greater priority first, then the older load
+struct LoadOrder {
+    template<typename Load>
+    bool operator () (const Load *lhs, const Load *rhs) const {
+        if (lhs->priority != rhs->priority) return lhs->priority < rhs->priority;
+        return lhs->id > rhs->id;
+    }
+};
+
+/// share of the progress once a load is read and once it is decoded
+constexpr float kReadProgress   = 0.1f;
+constexpr float kDecodeProgress = 0.3f;
+
+}
+
+AsyncResourceLoader::AsyncResourceLoader(ResourceLoadBackend *backend, UInt32 workerCount)
+    : _backend(backend), _nextID(kInvalidResourceLoadID), bStop() {
+    _workerCount = workerCount ? workerCount : std::max(1U, std::thread::hardware_concurrency() / 2);
+}
+
+AsyncResourceLoader::~AsyncResourceLoader() {
+    {
+        std::lock_guard lock(_mutex);
+        bStop = true;
+    }
+    _readCondition.notify_all();
+    _decodeCondition.notify_all();
+    for (std::thread &thread : _threads) {
+        thread.join();
+    }
+
+    /// every load in a queue is in the map
+    for (auto &[id, load] : _loads) {
+        delete load;
+    }
+}
+
+AsyncResourceLoader::Load *AsyncResourceLoader::startLoad(const std::string &path, int priority) {
+    Load *load                = new Load();
+    load->path                = path;
+    load->priority            = priority;
+    load->state               = kStateReading;
+    load->bSucceeded          = false;
+    load->pendingDependencies = 0;
+    load->reportedProgress    = 0.f;
+    load->job                 = _backend->createJob(path);
+
+    if (++_nextID == kInvalidResourceLoadID) ++_nextID;
+    load->id         = _nextID;
+    _loads[load->id] = load;
+    _pathLoads[path] = load;
+
+    {
+        std::lock_guard lock(_mutex);
+        /// threads start with the first load so an unused loader costs nothing
+        if (_threads.empty()) {
+            _threads.emplace_back(&AsyncResourceLoader::ioThread, this);
+            for (UInt32 i = 0; i < _workerCount; ++i) {
+                _threads.emplace_back(&AsyncResourceLoader::workerThread, this);
+            }
+        }
+
+        if (load->job == nullptr) {
+            /// fails in the next update
+            _decoded.push_back(load);
+            return load;
+        }
+        _readQueue.push_back(load);
+        std::push_heap(_readQueue.begin(), _readQueue.end(), LoadOrder());
+    }
+    _readCondition.notify_one();
+    return load;
+}
+
+ResourceLoadID AsyncResourceLoader::load(const char *path, const AsyncResourceLoadOptions &options, ResourceLoadCompletion completion) {
+    Load *load;
+    if (auto it = _pathLoads.find(path); it != _pathLoads.end()) {
+        load = it->second;
+        if (raisePriority(load, options.priority)) sortQueues();
+    } else {
+        load = startLoad(path, options.priority);
+    }
+
+    if (completion) load->completions.push_back(std::move(completion));
+    if (options.progress) load->progressCallbacks.push_back(options.progress);
+    return load->id;
+}
+
+bool AsyncResourceLoader::raisePriority(Load *load, int priority) {
+    if (load->priority >= priority) return false;
+    {
+        std::lock_guard lock(_mutex);
+        load->priority = priority;
+    }
+    /// what a load waits for is as urgent as the load
+    for (Load *dependency : load->dependencies) {
+        raisePriority(dependency, priority);
+    }
+    return true;
+}
+
+void AsyncResourceLoader::sortQueues() {
+    {
+        std::lock_guard lock(_mutex);
+        std::make_heap(_readQueue.begin(), _readQueue.end(), LoadOrder());
+        std::make_heap(_decodeQueue.begin(), _decodeQueue.end(), LoadOrder());
+    }
+    std::make_heap(_finalizeQueue.begin(), _finalizeQueue.end(), LoadOrder());
+}
+
+bool AsyncResourceLoader::setPriority(ResourceLoadID id, int priority) {
+    auto it = _loads.find(id);
+    if (it == _loads.end()) return false;
+
+    Load *load = it->second;
+    {
+        std::lock_guard lock(_mutex);
+        load->priority = priority;
+    }
+    for (Load *dependency : load->dependencies) {
+        raisePriority(dependency, priority);
+    }
+    sortQueues();
+    return true;
+}
+
+float AsyncResourceLoader::getProgress(ResourceLoadID id) const {
+    auto it = _loads.find(id);
+    if (it == _loads.end()) return 1.f;
+
+    const Load *load = it->second;
+    State       state;
+    {
+        std::lock_guard lock(_mutex);
+        state = load->state;
+    }
+
+    switch (state) {
+        case kStateReading:
+            return 0.f;
+        case kStateDecoding:
+            return kReadProgress;
+        case kStateWaiting:
+            return kDecodeProgress;
+        case kStateFinalizing:
+            return kDecodeProgress + (1.f - kDecodeProgress) * load->job->getFinalizeProgress();
+        default:
+            return 0.f;
+    }
+}
+
+void AsyncResourceLoader::reportProgress(Load *load) {
+    if (load->progressCallbacks.empty()) return;
+    float progress = getProgress(load->id);
+    if (progress == load->reportedProgress) return;
+    load->reportedProgress = progress;
+    for (const auto &callback : load->progressCallbacks) {
+        callback(progress);
+    }
+}
+
+bool AsyncResourceLoader::dependsOn(Load *load, Load *dependency) const {
+    /// walk down the unfinished loads the load waits for, finished ones have no edges left
+    std::vector<Load *>        stack{ load };
+    std::unordered_set<Load *> visited;
+    while (!stack.empty()) {
+        Load *current = stack.back();
+        stack.pop_back();
+        if (current == dependency) return true;
+        if (!visited.insert(current).second) continue;
+        stack.insert(stack.end(), current->dependencies.begin(), current->dependencies.end());
+    }
+    return false;
+}
+
+bool AsyncResourceLoader::resolveDependencies(Load *load) {
+    bool bReordered = false;
+    for (const std::string &path : load->dependencyPaths) {
+        if (_backend->isLoaded(path)) continue;
+
+        Load *dependency;
+        if (auto it = _pathLoads.find(path); it != _pathLoads.end()) {
+            dependency = it->second;
+            /// a cycle finalizes in the order the loads decode
+            if (dependsOn(dependency, load)) continue;
+            if (std::find(load->dependencies.begin(), load->dependencies.end(), dependency) != load->dependencies.end()) continue;
+            bReordered = raisePriority(dependency, load->priority) || bReordered;
+        } else {
+            dependency = startLoad(path, load->priority);
+        }
+
+        dependency->dependents.push_back(load);
+        load->dependencies.push_back(dependency);
+        ++load->pendingDependencies;
+    }
+    load->dependencyPaths.clear();
+
+    if (load->pendingDependencies == 0) {
+        load->state = kStateFinalizing;
+        _finalizeQueue.push_back(load);
+        std::push_heap(_finalizeQueue.begin(), _finalizeQueue.end(), LoadOrder());
+    }
+    return bReordered;
+}
+
+void AsyncResourceLoader::finish(Load *load, bool bSucceeded) {
+    _loads.erase(load->id);
+    _pathLoads.erase(load->path);
+
+    /// a failed dependency does not fail the loads that need it, their references stay unresolved
+    for (Load *dependent : load->dependents) {
+        std::erase(dependent->dependencies, load);
+        if (--dependent->pendingDependencies == 0 && dependent->state == kStateWaiting) {
+            dependent->state = kStateFinalizing;
+            _finalizeQueue.push_back(dependent);
+            std::push_heap(_finalizeQueue.begin(), _finalizeQueue.end(), LoadOrder());
+        }
+    }
+
+    if (bSucceeded && load->reportedProgress != 1.f) {
+        for (const auto &callback : load->progressCallbacks) {
+            callback(1.f);
+        }
+    }
+
+    /// completions may start new loads
+    for (ResourceLoadCompletion &completion : load->completions) {
+        completion(bSucceeded);
+    }
+    delete load;
+}
+
+void AsyncResourceLoader::ioThread() {
+    SetCurrentThreadName("ResourceIO");
+    std::unique_lock lock(_mutex);
+    while (true) {
+        _readCondition.wait(lock, [this] { return bStop || !_readQueue.empty(); });
+        if (bStop) break;
+
+        std::pop_heap(_readQueue.begin(), _readQueue.end(), LoadOrder());
+        Load *load = _readQueue.back();
+        _readQueue.pop_back();
+
+        lock.unlock();
+        bool bRead = load->job->read();
+        lock.lock();
+
+        if (bRead) {
+            load->state = kStateDecoding;
+            _decodeQueue.push_back(load);
+            std::push_heap(_decodeQueue.begin(), _decodeQueue.end(), LoadOrder());
+            _decodeCondition.notify_one();
+        } else {
+            load->bSucceeded = false;
+            _decoded.push_back(load);
+            _doneCondition.notify_all();
+        }
+    }
+}
+
+void AsyncResourceLoader::workerThread() {
+    SetCurrentThreadName("ResourceLoader");
+    std::unique_lock lock(_mutex);
+    while (true) {
+        _decodeCondition.wait(lock, [this] { return bStop || !_decodeQueue.empty(); });
+        if (bStop) break;
+
+        std::pop_heap(_decodeQueue.begin(), _decodeQueue.end(), LoadOrder());
+        Load *load = _decodeQueue.back();
+        _decodeQueue.pop_back();
+
+        lock.unlock();
+        std::vector<std::string> dependencies;
+        bool                     bDecoded = load->job->decode(dependencies);
+        lock.lock();
+
+        load->bSucceeded      = bDecoded;
+        load->dependencyPaths = std::move(dependencies);
+        _decoded.push_back(load);
+        _doneCondition.notify_all();
+    }
+}
+
+UInt32 AsyncResourceLoader::update(float budgetSeconds) {
+    Timer timer;
+
+    {
+        std::lock_guard lock(_mutex);
+        for (Load *load : _decoded) {
+            if (load->bSucceeded) load->state = kStateWaiting;
+        }
+        _resolveQueue.insert(_resolveQueue.end(), _decoded.begin(), _decoded.end());
+        _decoded.clear();
+    }
+
+    /// resolving shares the budget, what is left waits for the next update
+    bool   bReordered = false;
+    size_t resolved   = 0;
+    while (resolved < _resolveQueue.size() && (resolved == 0 || timer.peek() < budgetSeconds)) {
+        Load *load = _resolveQueue[resolved++];
+        if (load->bSucceeded) {
+            bReordered = resolveDependencies(load) || bReordered;
+        } else {
+            load->state = kStateFailed;
+            finish(load, false);
+        }
+    }
+    _resolveQueue.erase(_resolveQueue.begin(), _resolveQueue.begin() + resolved);
+    if (bReordered) sortQueues();
+
+    /// the most urgent load ready to finalize takes each step, a step is never split
+    UInt32 steps = 0;
+    while (!_finalizeQueue.empty()) {
+        Load            *load = _finalizeQueue.front();
+        ResourceLoadStep step = load->job->finalizeStep();
+        ++steps;
+
+        if (step == kResourceLoadStepMore) {
+            reportProgress(load);
+        } else {
+            std::pop_heap(_finalizeQueue.begin(), _finalizeQueue.end(), LoadOrder());
+            _finalizeQueue.pop_back();
+            finish(load, step == kResourceLoadStepDone);
+        }
+
+        if (timer.peek() >= budgetSeconds) break;
+    }
+
+    /// callbacks may start loads
+    std::vector<Load *> reporting;
+    for (auto &[id, load] : _loads) {
+        if (!load->progressCallbacks.empty() && load->state != kStateFinalizing) reporting.push_back(load);
+    }
+    for (Load *load : reporting) {
+        reportProgress(load);
+    }
+    return steps;
+}
+
+void AsyncResourceLoader::flush() {
+    while (true) {
+        update(std::numeric_limits<float>::infinity());
+        if (_loads.empty()) break;
+
+        /// what is left waits for the threads
+        std::unique_lock lock(_mutex);
+        _doneCondition.wait(lock, [this] { return !_decoded.empty(); });
+    }
+}
+
+}
@@ -15,7 +15,9 @@
 #include <ojoie/IO/FileInputStream.hpp>
 #include <ojoie/Utility/Path.hpp>
 
+#include <cctype>
 #include <filesystem>
+#include <string_view>
 
 namespace AN {
 
@@ -25,6 +27,82 @@ static UInt64 GetResourceID()
     return id++;
 }
 
+/// a serialized asset, its objects are transferred and initialized one per step
+class SerializedAssetLoadJob : public ResourceLoadJob {
+
+    ResourceManager    *_manager;
+    std::string         _path;
+    SerializedAssetData _data;
+    SerializedAsset     _asset;
+    size_t              _step;
+
+public:
+
+    SerializedAssetLoadJob(ResourceManager *manager, std::string path)
+        : _manager(manager), _path(std::move(path)), _step() {}
+
+    virtual bool read() override {
+        return SerializedAsset::ReadAtPath(_path.c_str(), _data);
+    }
+
+    virtual bool decode(std::vector<std::string> &outDependencies) override {
+        if (!SerializedAsset::Parse(_data)) return false;
+        for (const std::string &uuid : _data.referencedUUIDs) {
+            std::string path = _manager->getPathOfUUID(uuid);
+            if (!path.empty()) outDependencies.push_back(std::move(path));
+        }
+        return true;
+    }
+
+    virtual ResourceLoadStep finalizeStep() override {
+        size_t objectCount = _data.objects.size();
+        if (_step == 0) {
+            _asset.BeginLoad(_path.c_str(), _data);
+            if (_asset.GetMainObject() == nullptr) return kResourceLoadStepFailed;
+        } else if (_step <= objectCount) {
+            _asset.LoadObject(_data, _step - 1);
+        } else if (_step <= objectCount * 2) {
+            if (!_manager->initLoadedObject(_asset.GetObjectList()[_step - objectCount - 1])) {
+                return kResourceLoadStepFailed;
+            }
+        } else {
+            _manager->registerResourceAtPath(_asset.GetMainObject(), _path.c_str());
+            return kResourceLoadStepDone;
+        }
+        ++_step;
+        return kResourceLoadStepMore;
+    }
+
+    virtual float getFinalizeProgress() const override {
+        return (float) _step / (float) (_data.objects.size() * 2 + 1);
+    }
+};
+
+class SerializedAssetLoadBackend : public ResourceLoadBackend {
+
+    ResourceManager *_manager;
+
+public:
+
+    explicit SerializedAssetLoadBackend(ResourceManager *manager) : _manager(manager) {}
+
+    virtual std::unique_ptr<ResourceLoadJob> createJob(const std::string &path) override {
+        return std::make_unique<SerializedAssetLoadJob>(_manager, path);
+    }
+
+    virtual bool isLoaded(const std::string &path) override {
+        return _manager->findResourceAtPath(path.c_str()) != nullptr;
+    }
+};
+
+ResourceManager::ResourceManager()
+    : bReloadEvicted(true), _residencyReleaseTick(), _residencyObjectsVersion(), _residencyBackoff(), _residencySkipped() {}
+
+ResourceManager::~ResourceManager() {
+    /// the loader joins its threads before the backend goes
+    _asyncLoader.reset();
+}
+
 void ResourceManager::loadBuiltinResources() {
 
 #define LOAD_BUILTIN_RESOURCE(cls, name) \
@@ -55,59 +133,242 @@ void ResourceManager::loadBuiltinResources() {
 
 void ResourceManager::RegisterResource(Object *object, const char *name)
 {
-    std::string key = std::string(object->getClassName()) + "_" + std::string(name);
-    resourceMap.insert({ key, object });
+    UInt64 nameKey = GetNameKey(object->getClassID(), internName(name));
+    if (!_resources.contains(nameKey)) {
+        bindName(object, nameKey);
+    }
     GetSerializeManager().RegisterSerializedObjectIdentifier(object, { {}, GetResourceID() });
 }
 
+UInt32 ResourceManager::internName(std::string_view name) {
+    if (auto it = _nameIDs.find(name); it != _nameIDs.end()) {
+        return it->second;
+    }
+    /// the deque never moves its strings, the views stay valid
+    const std::string &stored = _names.emplace_back(name);
+    UInt32 id = (UInt32) _names.size();
+    _nameIDs.emplace(stored, id);
+    return id;
+}
+
+UInt32 ResourceManager::findName(std::string_view name) const {
+    auto it = _nameIDs.find(name);
+    return it == _nameIDs.end() ? 0 : it->second;
+}
+
+UInt32 ResourceManager::findPath(const char *path) const {
+#ifdef AN_WIN
+    return findName(ConvertPath(path));
+#else
+    return findName(path);
+#endif
+}
+
+void ResourceManager::bindName(Object *object, UInt64 nameKey) {
+    ResourceEntry *entry = _entries.find(object->getInstanceID());
+    if (entry == nullptr) {
+        _entries.insert(object->getInstanceID(), { 0, 0 });
+        entry = _entries.find(object->getInstanceID());
+    }
+
+    if (entry->nameKey && entry->nameKey != nameKey) {
+        _resources.erase(entry->nameKey);
+    }
+    entry->nameKey = nameKey;
+    _resources.insertOrAssign(nameKey, object);
+}
+
+void ResourceManager::bindPath(Object *object, UInt32 pathID) {
+    /// the path moves from the object it belonged to
+    if (Object **owner = _pathResources.find(pathID); owner && *owner != object) {
+        if (ResourceEntry *ownerEntry = _entries.find((*owner)->getInstanceID())) {
+            ownerEntry->pathID = 0;
+        }
+    }
+
+    ResourceEntry *entry = _entries.find(object->getInstanceID());
+    if (entry == nullptr) {
+        _entries.insert(object->getInstanceID(), { 0, 0 });
+        entry = _entries.find(object->getInstanceID());
+    }
+
+    if (entry->pathID && entry->pathID != pathID) {
+        _pathResources.erase(entry->pathID);
+    }
+    entry->pathID = pathID;
+    _pathResources.insertOrAssign(pathID, object);
+}
+
+void ResourceManager::removeEntry(Object *object) {
+    ResourceEntry *entry = _entries.find(object->getInstanceID());
+    if (entry == nullptr) return;
+
+    if (Object **named = _resources.find(entry->nameKey); named && *named == object) {
+        _resources.erase(entry->nameKey);
+    }
+    if (Object **pathed = _pathResources.find(entry->pathID); pathed && *pathed == object) {
+        _pathResources.erase(entry->pathID);
+    }
+    _entries.erase(object->getInstanceID());
+    _residency.remove(object->getInstanceID());
+}
+
+Object *ResourceManager::findResourceAtPath(const char *path) const {
+    UInt32 pathID = findPath(path);
+    if (pathID == 0) return nullptr;
+    Object *const *object = _pathResources.find(pathID);
+    return object ? *object : nullptr;
+}
+
 Object *ResourceManager::getResourceAtPath(const char *path) {
-    std::string convertedPath = ConvertPath(path);
-    if (resourcePathMap.contains(convertedPath)) {
-        return resourcePathMap[convertedPath];
+    Object *object = findResourceAtPath(path);
+    if (object == nullptr && bReloadEvicted) {
+        UInt32 pathID = findPath(path);
+        if (pathID && _evictedPaths.contains(pathID)) {
+            object = loadResourceAtPath(path);
+        }
     }
-    return nullptr;
+    return object;
 }
 
 void ResourceManager::unloadResource(Object *asset)
 {
     if (asset)
     {
-        for (auto &&[k, v] : resourcePathMap)
-        {
-            if (v == asset)
-            {
-                resourcePathMap.erase(k);
-                break;
-            }
-        }
-
-        for (auto &&[k, v] : resourceMap)
-        {
-            if (v == asset)
-            {
-                resourceMap.erase(k);
-                break;
-            }
-        }
+        removeEntry(asset);
         DestroyObject(asset);
     }
 }
 
 void ResourceManager::resetResourcePath(Object *object, const char *pathIn) {
-    std::string convertedPath = ConvertPath(pathIn);
-    for (auto &[path, obj] : resourcePathMap) {
-        if (obj == object) {
-            resourcePathMap.erase(path);
-            resourcePathMap[convertedPath] = object;
-            return;
+    bindPath(object, internName(ConvertPath(pathIn)));
+}
+
+std::string ResourceManager::getResourcePath(Object *object) {
+    const ResourceEntry *entry = _entries.find(object->getInstanceID());
+    if (entry == nullptr || entry->pathID == 0) return {};
+    return _names[entry->pathID - 1];
+}
+
+bool ResourceManager::initLoadedObject(Object *object) {
+    if (!object->initAfterDecode()) {
+        DestroyObject(object);
+        return false;
+    }
+
+    if (object->isDerivedFrom<Component>())
+    {
+        Component *component = (Component *)object;
+        Message message;
+        message.sender = this;
+        message.data = (intptr_t)object;
+        message.name = kDidAddComponentMessage;
+        component->getActor().sendMessage(message);
+
+        if (!component->getActor().isActive()) {
+            component->deactivate();
         }
     }
-    resourcePathMap[convertedPath] = object;
+    return true;
 }
 
-Object *ResourceManager::loadResourceAtPath(const char *_path) {
-
+void ResourceManager::registerResourceAtPath(Object *mainObject, const char *_path) {
     Path path(_path);
+    UInt64 nameKey = GetNameKey(mainObject->getClassID(), internName(path.GetLastComponentWithoutExtension()));
+
+    /// if exist, destroy and replace it
+    if (Object **existing = _resources.find(nameKey); existing && *existing != mainObject) {
+        unloadResource(*existing);
+    }
+
+    /// insert in map
+    UInt32 pathID = internName(ConvertPath(_path));
+    bindName(mainObject, nameKey);
+    bindPath(mainObject, pathID);
+    _residency.add(mainObject->getInstanceID(), mainObject->getClassID(), mainObject->getRuntimeMemorySize(),
+                   _evictedPaths.erase(pathID));
+}
+
+void ResourceManager::evictResource(int instanceID) {
+    const ResourceEntry *entry = _entries.find(instanceID);
+    if (entry == nullptr) return;
+
+    Object *const *object = _pathResources.find(entry->pathID);
+    if (object == nullptr || (*object)->getInstanceID() != instanceID) {
+        object = _resources.find(entry->nameKey);
+    }
+    if (object == nullptr || (*object)->getInstanceID() != instanceID) return;
+
+    if (entry->pathID) _evictedPaths.insertOrAssign(entry->pathID, true);
+    unloadResource(*object);
+}
+
+void ResourceManager::setResidencyBudget(size_t bytes) {
+    _residency.setBudget(bytes);
+}
+
+void ResourceManager::setResidencyBudget(int classID, size_t bytes) {
+    _residency.setClassBudget(classID, bytes);
+}
+
+void ResourceManager::retainResource(Object *object) {
+    _residency.retain(object->getInstanceID());
+}
+
+void ResourceManager::releaseResource(Object *object) {
+    if (!_residency.isTracked(object->getInstanceID())) return;
+    _residency.release(object->getInstanceID(), object->getRuntimeMemorySize());
+}
+
+void ResourceManager::updateResidency() {
+    if (!_residency.isOverBudget()) {
+        _residencyBackoff = 0;
+        return;
+    }
+
+    /// the last trim found every unreferenced resource pinned by a live object, scanning again finds the same
+    /// until a resource is released or objects come and go, references changed in place are seen after the backoff
+    if (_residencyBackoff != 0 &&
+        _residency.getReleaseTick() == _residencyReleaseTick &&
+        Object::GetObjectsVersion() == _residencyObjectsVersion &&
+        ++_residencySkipped < _residencyBackoff) {
+        return;
+    }
+    _residencySkipped = 0;
+
+    /// materials, renderers and colliders point to resources without handles,
+    /// whatever a live object references is retained while trimming so it is never evicted
+    std::vector<Object *> references;
+    for (Object *object : Object::FindObjectsOfType<Object>()) {
+        object->getResourceReferences(references);
+    }
+
+    FlatHashMap<int, bool> pinnedIDs;
+    std::vector<Object *>  pinned;
+    for (Object *object : references) {
+        if (object == nullptr || !pinnedIDs.insert(object->getInstanceID(), true)) continue;
+        if (_residency.retain(object->getInstanceID())) {
+            pinned.push_back(object);
+        }
+    }
+
+    UInt32 evictions = _residency.trim([this](int instanceID) { evictResource(instanceID); });
+
+    for (Object *object : pinned) {
+        _residency.release(object->getInstanceID(), object->getRuntimeMemorySize());
+    }
+
+    if (evictions != 0) {
+        _residencyBackoff = 0;
+    } else {
+        _residencyBackoff = std::min<UInt32>(_residencyBackoff == 0 ? 2 : _residencyBackoff * 2, kMaxResidencyBackoff);
+    }
+    /// taken after the pinned releases above so they do not count as a change
+    _residencyReleaseTick    = _residency.getReleaseTick();
+    _residencyObjectsVersion = Object::GetObjectsVersion();
+}
+
+Object *ResourceManager::loadResourceAtPath(const char *_path) {
 
     SerializedAsset serializedAsset;
     if (!serializedAsset.LoadAtPath(_path))
@@ -116,52 +377,213 @@ Object *ResourceManager::loadResourceAtPath(const char *_path) {
     }
 
     Object *mainObject = serializedAsset.GetMainObject();
-    std::string className = mainObject->getClassName();
 
     for (Object *object : serializedAsset.GetObjectList())
     {
-        if (!object->initAfterDecode()) {
-            DestroyObject(object);
+        if (!initLoadedObject(object)) {
             return nullptr;
         }
+    }
 
-        if (object->isDerivedFrom<Component>())
-        {
-            Component *component = (Component *)object;
-            Message message;
-            message.sender = this;
-            message.data = (intptr_t)object;
-            message.name = kDidAddComponentMessage;
-            component->getActor().sendMessage(message);
-
-            if (!component->getActor().isActive()) {
-                component->deactivate();
-            }
+    registerResourceAtPath(mainObject, _path);
+    return mainObject;
+}
+
+ResourceLoadID ResourceManager::loadResourceAsync(const char *path, const AsyncResourceLoadOptions &options,
+                                                  std::function<void(Object *)> completion) {
+    if (_asyncLoader == nullptr) {
+        _loadBackend = std::make_unique<SerializedAssetLoadBackend>(this);
+        _asyncLoader = std::make_unique<AsyncResourceLoader>(_loadBackend.get());
+    }
+
+    std::string convertedPath = ConvertPath(path);
+    return _asyncLoader->load(convertedPath.c_str(), options, [this, convertedPath, completion = std::move(completion)](bool bSucceeded) {
+        if (completion) {
+            completion(bSucceeded ? getResourceAtPath(convertedPath.c_str()) : nullptr);
         }
+    });
+}
+
+float ResourceManager::getResourceLoadProgress(ResourceLoadID id) const {
+    return _asyncLoader ? _asyncLoader->getProgress(id) : 1.f;
+}
+
+bool ResourceManager::setResourceLoadPriority(ResourceLoadID id, int priority) {
+    return _asyncLoader && _asyncLoader->setPriority(id, priority);
+}
+
+void ResourceManager::updateAsyncLoads(float budgetSeconds) {
+    if (_asyncLoader) _asyncLoader->update(budgetSeconds);
+}
+
+void ResourceManager::flushAsyncLoads() {
+    if (_asyncLoader) _asyncLoader->flush();
+}
+
+/// the uuid of a meta line like uuid: "...", empty for other lines
+static std::string_view GetMetaUUID(std::string_view line) {
+    if (!line.starts_with("uuid:")) return {};
+
+    line.remove_prefix(5);
+    while (!line.empty() && (line.front() == ' ' || line.front() == '"')) line.remove_prefix(1);
+    while (!line.empty() && (line.back() == ' ' || line.back() == '"' || line.back() == '\r')) line.remove_suffix(1);
+    return line;
+}
+
+bool ResourceManager::mountArchive(const char *path, const char *rootDirectory) {
+    auto archive = std::make_unique<AssetArchive>();
+    if (!archive->open(path, rootDirectory ? rootDirectory : GetCurrentDirectory())) {
+        AN_LOG(Error, "Failed mounting asset archive %s", path);
+        return false;
     }
 
+    std::unique_lock lock(_archiveMutex);
+    _archives.push_back(std::move(archive));
+    return true;
+}
 
-    std::string key = std::string(className) + "_" + std::string(path.GetLastComponentWithoutExtension());
+bool ResourceManager::readArchivedFile(const char *path, std::string &buffer, std::string_view &text) const {
+    /// archives stay mounted, so a view into one outlives the lock
+    std::shared_lock lock(_archiveMutex);
+    for (auto it = _archives.rbegin(); it != _archives.rend(); ++it) {
+        int index = (*it)->find(path);
+        if (index >= 0) return (*it)->readView(index, buffer, text);
+    }
+    return false;
+}
 
-    /// if exist, destroy and replace it
-    if (auto it = resourceMap.find(key); it != resourceMap.end()) {
-        DestroyObject(it->second);
-        resourceMap.erase(it);
+static bool IsPathSeparator(char c) {
+    return c == '/' || c == '\\';
+}
+
+/// path is inside directory, ignoring case and slash direction like the archive lookup
+static bool IsPathUnder(std::string_view path, std::string_view directory) {
+    while (!directory.empty() && IsPathSeparator(directory.back())) directory.remove_suffix(1);
+    if (path.size() <= directory.size() || !IsPathSeparator(path[directory.size()])) return false;
+
+    for (size_t i = 0; i < directory.size(); ++i) {
+        char a = path[i], b = directory[i];
+        if (IsPathSeparator(a) && IsPathSeparator(b)) continue;
+        if (std::tolower((unsigned char) a) != std::tolower((unsigned char) b)) return false;
     }
+    return true;
+}
 
-    /// insert in map
-    resourceMap.insert({ key, mainObject });
-    resourcePathMap[ConvertPath(_path)] = mainObject;
-    return mainObject;
+/// the file name without its last extension, like std::filesystem::path::stem
+static std::string_view GetPathStem(std::string_view path) {
+    size_t slash = path.find_last_of("/\\");
+    if (slash != std::string_view::npos) path.remove_prefix(slash + 1);
+    size_t dot = path.rfind('.');
+    if (dot != std::string_view::npos && dot != 0) path = path.substr(0, dot);
+    return path;
+}
+
+/// the first document is a mapping of the object, its classname names the class
+static bool IsResourceOfClass(YamlDecoder &decoder, const char *className) {
+    YAMLNode *node = decoder.getCurrentNode();
+    if (node == nullptr) return false;
+
+    bool bMatch = false;
+    if (YAMLMapping *map = dynamic_cast<YAMLMapping *>(node); map && map->begin() != map->end()) {
+        map = dynamic_cast<YAMLMapping *>(map->begin()->second);
+        if (map) {
+            YAMLScalar *scalar = dynamic_cast<YAMLScalar *>(map->get("classname"));
+            bMatch = scalar && scalar->getStringValue() == className;
+        }
+    }
+    node->release();
+    return bMatch;
+}
+
+std::unique_ptr<YamlDecoder> ResourceManager::decodeArchivedResource(const char *className, const char *name,
+                                                                     std::string_view rootDir) const {
+    std::shared_lock lock(_archiveMutex);
+    std::string      buffer, entryPath;
+    std::string_view text;
+    for (auto it = _archives.rbegin(); it != _archives.rend(); ++it) {
+        const AssetArchive &archive = **it;
+        for (int index = 0; index < (int) archive.getEntryCount(); ++index) {
+            std::string_view path = archive.getPath(index);
+            if (GetPathStem(path) != name) continue;
+
+            entryPath = archive.getRootDirectory() + "/" + std::string(path);
+            if (!IsPathUnder(entryPath, rootDir) || !archive.readView(index, buffer, text)) continue;
+
+            /// the decoder holds the parsed document, the text is not needed after
+            auto decoder = std::make_unique<YamlDecoder>(text.data(), (int) text.size());
+            if (IsResourceOfClass(*decoder, className)) return decoder;
+        }
+    }
+    return nullptr;
+}
+
+std::string ResourceManager::getPathOfUUID(const std::string &uuid) {
+    /// built once from the metas, read only after
+    std::call_once(_uuidPathFlag, [this] {
+        /// the archived metas, then the loose ones
+        {
+            std::shared_lock lock(_archiveMutex);
+            std::string      buffer;
+            std::string_view text;
+            for (const auto &archive : _archives) {
+                for (int index = 0; index < (int) archive->getEntryCount(); ++index) {
+                    std::string_view entryPath = archive->getPath(index);
+                    if (!entryPath.ends_with(".meta") || !archive->readView(index, buffer, text)) continue;
+
+                    std::string_view rest = text, line;
+                    while (!rest.empty()) {
+                        size_t end = rest.find('\n');
+                        line = rest.substr(0, end);
+                        rest = end == std::string_view::npos ? std::string_view() : rest.substr(end + 1);
+
+                        std::string_view value = GetMetaUUID(line);
+                        if (value.empty()) continue;
+
+                        entryPath.remove_suffix(5);
+                        _uuidPathMap[std::string(value)] =
+                                ConvertPath(archive->getRootDirectory() + "/" + std::string(entryPath));
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::filesystem::path rootDir = GetCurrentDirectory() + "/Data/Assets";
+        std::error_code       error;
+        if (!exists(rootDir, error)) return;
+
+        for (const auto &entry : std::filesystem::recursive_directory_iterator{ rootDir, error }) {
+            if (entry.is_directory() || entry.path().extension() != ".meta") continue;
+
+            File file;
+            if (!file.Open(entry.path().string().c_str(), kFilePermissionRead)) continue;
+            while (!file.IsEOF()) {
+                std::string      line  = file.ReadLine();
+                std::string_view value = GetMetaUUID(line);
+                if (value.empty()) continue;
+
+                std::filesystem::path assetPath = entry.path();
+                assetPath.replace_extension();
+                _uuidPathMap[std::string(value)] = ConvertPath(assetPath.string());
+                break;
+            }
+        }
+    });
+
+    if (auto it = _uuidPathMap.find(uuid); it != _uuidPathMap.end()) {
+        return it->second;
+    }
+    return {};
 }
 
 Object *ResourceManager::loadResource(const char *className, const char *name, const char *searchPath) {
 
-    std::string key = std::string(className) + "_" + std::string(name);
+    Class *cls = Class::GetClass(className);
+    if (cls == nullptr) return nullptr;
+    UInt64 nameKey = GetNameKey(cls->getClassId(), internName(name));
 
-    if (auto it = resourceMap.find(key); it != resourceMap.end()) {
-        DestroyObject(it->second);
-        resourceMap.erase(it);
+    if (Object **existing = _resources.find(nameKey)) {
+        unloadResource(*existing);
     }
 
     std::filesystem::path rootDir;
@@ -171,47 +593,33 @@ Object *ResourceManager::loadResource(const char *className, const char *name, c
         rootDir = GetCurrentDirectory() + "/Data/Assets";
     }
 
-    std::string filePath;
+    /// mounted archives stand in for the loose files
+    std::unique_ptr<YamlDecoder> decoder = decodeArchivedResource(className, name, rootDir.string());
 
-    if (!exists(rootDir)) {
-        return nullptr;
-    }
+    if (decoder == nullptr) {
+        std::error_code error;
+        if (!exists(rootDir, error)) {
+            return nullptr;
+        }
 
-    for (const auto &entry : std::filesystem::recursive_directory_iterator{ rootDir }) {
-        if (entry.is_directory()) continue;
-        if (entry.path().stem() == name){
-            filePath = entry.path().string();
+        for (const auto &entry : std::filesystem::recursive_directory_iterator{ rootDir, error }) {
+            if (entry.is_directory() || entry.path().stem() != name) continue;
 
             File file;
-            if (!file.Open(filePath.c_str(), kFilePermissionRead)) continue;
+            if (!file.Open(entry.path().string().c_str(), kFilePermissionRead)) continue;
 
+            /// the document is parsed when the decoder is made, it is kept for the transfer
             FileInputStream fileInputStream(file);
-            YamlDecoder     decoder(fileInputStream);
-            YAMLNode       *node = decoder.getCurrentNode();
-
-            if (YAMLMapping *map= dynamic_cast<YAMLMapping *>(node); map) {
-                map = dynamic_cast<YAMLMapping *>(map->begin()->second);
-                if (map) {
-                    YAMLScalar *scalar = dynamic_cast<YAMLScalar *>(map->get("classname"));
-                    if (scalar && scalar->getStringValue() == className) {
-                        node->release();
-                        break;
-                    }
-                }
-            }
-            node->release();
+            decoder = std::make_unique<YamlDecoder>(fileInputStream);
+            if (IsResourceOfClass(*decoder, className)) break;
+            decoder.reset();
         }
     }
 
-    if (filePath.empty()) return nullptr;
-
-    File file;
-    if (!file.Open(filePath.c_str(), kFilePermissionRead)) return nullptr;
-    FileInputStream fileInputStream(file);
-    YamlDecoder     decoder(fileInputStream);
+    if (decoder == nullptr) return nullptr;
 
     Object *object = NewObject(className);
-    object->redirectTransferVirtual(decoder);
+    object->redirectTransferVirtual(*decoder);
 
     if (!object->initAfterDecode()) {
         DestroyObject(object);
@@ -219,20 +627,21 @@ Object *ResourceManager::loadResource(const char *className, const char *name, c
     }
 
     /// insert in map
-    resourceMap.insert({ key, object });
+    bindName(object, nameKey);
 
     return object;
 }
 
 Object *ResourceManager::getResource(const char *className, const char *name) {
+    Class *cls = Class::GetClass(className);
+    return cls ? getResource(cls->getClassId(), name) : nullptr;
+}
 
-    std::string key = std::string(className) + "_" + std::string(name);
-
-    if (auto it = resourceMap.find(key); it != resourceMap.end()) {
-        return it->second;
-    }
-
-    return nullptr;
+Object *ResourceManager::getResource(int classID, const char *name) {
+    UInt32 nameID = findName(name);
+    if (nameID == 0) return nullptr;
+    Object **object = _resources.find(GetNameKey(classID, nameID));
+    return object ? *object : nullptr;
 }
 
 ResourceManager &GetResourceManager() {
@@ -0,0 +1,143 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Misc/ResourceResidency.hpp"
+
+namespace AN {
+
+ResourceResidency::ResourceResidency() : _stats(), _budget(), _tick() {}
+
+void ResourceResidency::cache(int instanceID, Entry &entry) {
+    ClassResidency &classResidency = _classes[entry.classID];
+    classResidency.cached.set(instanceID, ++_tick);
+    classResidency.stats.cachedBytes += entry.size;
+    ++classResidency.stats.cachedCount;
+    _stats.cachedBytes += entry.size;
+    ++_stats.cachedCount;
+}
+
+void ResourceResidency::uncache(int instanceID, Entry &entry) {
+    ClassResidency &classResidency = _classes[entry.classID];
+    if (!classResidency.cached.erase(instanceID)) return;
+    classResidency.stats.cachedBytes -= entry.size;
+    --classResidency.stats.cachedCount;
+    _stats.cachedBytes -= entry.size;
+    --_stats.cachedCount;
+}
+
+void ResourceResidency::add(int instanceID, int classID, size_t size, bool bReloaded) {
+    remove(instanceID);
+
+    Entry entry{ classID, size, 0 };
+    _entries.insert(instanceID, entry);
+
+    ClassResidency &classResidency = _classes[classID];
+    classResidency.stats.residentBytes += size;
+    ++classResidency.stats.residentCount;
+    _stats.residentBytes += size;
+    ++_stats.residentCount;
+    if (bReloaded) {
+        ++classResidency.stats.reloads;
+        ++_stats.reloads;
+    }
+    cache(instanceID, *_entries.find(instanceID));
+}
+
+void ResourceResidency::remove(int instanceID) {
+    Entry *entry = _entries.find(instanceID);
+    if (entry == nullptr) return;
+
+    uncache(instanceID, *entry);
+    ClassResidency &classResidency = _classes[entry->classID];
+    classResidency.stats.residentBytes -= entry->size;
+    --classResidency.stats.residentCount;
+    _stats.residentBytes -= entry->size;
+    --_stats.residentCount;
+    _entries.erase(instanceID);
+}
+
+bool ResourceResidency::retain(int instanceID) {
+    Entry *entry = _entries.find(instanceID);
+    if (entry == nullptr) return false;
+    if (entry->refCount++ == 0) uncache(instanceID, *entry);
+    return true;
+}
+
+bool ResourceResidency::release(int instanceID, size_t size) {
+    Entry *entry = _entries.find(instanceID);
+    if (entry == nullptr || entry->refCount == 0) return false;
+    if (--entry->refCount) return true;
+
+    /// the resource may have grown or dropped its CPU copy while referenced
+    ClassResidency &classResidency = _classes[entry->classID];
+    classResidency.stats.residentBytes += size - entry->size;
+    _stats.residentBytes += size - entry->size;
+    entry->size = size;
+    cache(instanceID, *entry);
+    return true;
+}
+
+UInt32 ResourceResidency::getRefCount(int instanceID) const {
+    const Entry *entry = _entries.find(instanceID);
+    return entry ? entry->refCount : 0;
+}
+
+bool ResourceResidency::evictOne(ClassResidency *classResidency, const std::function<void(int)> &evict) {
+    /// without a class the least recently released of all classes goes
+    if (classResidency == nullptr) {
+        UInt64 oldest = UINT64_MAX;
+        for (auto &[classID, candidate] : _classes) {
+            const auto *last = candidate.cached.leastRecent();
+            if (last && last->second < oldest) {
+                oldest         = last->second;
+                classResidency = &candidate;
+            }
+        }
+        if (classResidency == nullptr) return false;
+    }
+
+    const auto *last = classResidency->cached.leastRecent();
+    if (last == nullptr) return false;
+
+    int    instanceID = last->first;
+    size_t size       = _entries.find(instanceID)->size;
+    remove(instanceID);
+    ++classResidency->stats.evictions;
+    classResidency->stats.evictedBytes += size;
+    ++_stats.evictions;
+    _stats.evictedBytes += size;
+
+    /// the entry is gone, the owner removing it again is a no-op
+    evict(instanceID);
+    return true;
+}
+
+bool ResourceResidency::isOverBudget() const {
+    if (_budget && _stats.residentBytes > _budget) return true;
+    for (const auto &[classID, classResidency] : _classes) {
+        if (classResidency.budget && classResidency.stats.residentBytes > classResidency.budget) return true;
+    }
+    return false;
+}
+
+UInt32 ResourceResidency::trim(const std::function<void(int instanceID)> &evict) {
+    UInt32 evictions = 0;
+    for (auto &[classID, classResidency] : _classes) {
+        while (classResidency.budget && classResidency.stats.residentBytes > classResidency.budget &&
+               evictOne(&classResidency, evict)) {
+            ++evictions;
+        }
+    }
+    while (_budget && _stats.residentBytes > _budget && evictOne(nullptr, evict)) {
+        ++evictions;
+    }
+    return evictions;
+}
+
+ResourceMemoryStats ResourceResidency::getStats(int classID) const {
+    auto it = _classes.find(classID);
+    return it == _classes.end() ? ResourceMemoryStats{} : it->second.stats;
+}
+
+}
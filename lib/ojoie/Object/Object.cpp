@@ -27,6 +27,7 @@ void setNextSerializedInstanceIDInternal(int id) {
 typedef std::unordered_map<int, Object *> ObjectMap;
 
 static ObjectMap gObjectMap;
+static UInt64 gObjectMapVersion;
 static std::shared_mutex sm;
 
 static void insertObjectInMap(Object *object) {
@@ -34,6 +35,7 @@ static void insertObjectInMap(Object *object) {
     ANAssert(object->getInstanceID() != 0);
     ANAssert(gObjectMap.find(object->getInstanceID()) == gObjectMap.end());
     gObjectMap.insert({ object->getInstanceID(), object });
+    ++gObjectMapVersion;
 }
 
 static void removeObjectInMap(Object *object) {
@@ -44,6 +46,7 @@ static void removeObjectInMap(Object *object) {
     }
     ANAssert(gObjectMap.find(object->getInstanceID()) != gObjectMap.end());
     gObjectMap.erase(object->getInstanceID());
+    ++gObjectMapVersion;
 }
 
 static Object *getInstance(int instanceID) {
@@ -185,6 +188,11 @@ std::vector<Object *> Object::FindObjectsOfType(int type) {
     return result;
 }
 
+UInt64 Object::GetObjectsVersion() {
+    std::shared_lock lock(sm);
+    return gObjectMapVersion;
+}
+
 std::string Object::debugDescription() {
     return std::format("Object: 0x{} class {}", (void *)this, getClass()->debugDescription());
 }
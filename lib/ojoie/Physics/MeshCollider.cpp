@@ -38,6 +38,46 @@ void MeshCollider::create(RigidBody *ignored) {
         if (m_Mesh == nullptr) return;
     }
 
+    /// physx needs float positions
+    std::vector<Vector3f> vertices;
+    const Vector3f       *points;
+    const void           *indexData;
+    UInt32                indexCount;
+    bool                  b16BitIndices;
+
+    if (m_Mesh->hasCPUData()) {
+        vertices.resize(m_Mesh->getVertexCount());
+        m_Mesh->extractVertices(vertices.data());
+        points        = vertices.data();
+        indexData     = m_Mesh->getIndicesData();
+        indexCount    = m_Mesh->getIndicesCount();
+        b16BitIndices = m_Mesh->getIndexFormat() == kIndexFormatUInt16;
+
+    } else {
+        /// a non readable mesh cooks from the copy it kept when releasing its cpu data
+        if (m_Mesh->getCollisionVertices().empty()) {
+#ifdef OJOIE_WITH_EDITOR
+            /// tools fallback for a mesh released without collision data, read it back from its asset once
+            AN_LOG(Warning, "MeshCollider reloads mesh '%s' from its asset, it kept no collision data",
+                   m_Mesh->getName().c_str());
+            if (!m_Mesh->reloadFromAsset()) {
+                AN_LOG(Error, "MeshCollider can not cook mesh '%s', it is not readable", m_Mesh->getName().c_str());
+                return;
+            }
+            m_Mesh->setKeepCollisionData(true);
+            m_Mesh->releaseCPUData();
+#else
+            AN_LOG(Error, "MeshCollider can not cook mesh '%s', it is not readable and kept no collision data",
+                   m_Mesh->getName().c_str());
+            return;
+#endif
+        }
+        points        = m_Mesh->getCollisionVertices().data();
+        indexData     = m_Mesh->getCollisionIndices().data();
+        indexCount    = m_Mesh->getCollisionIndices().size();
+        b16BitIndices = false;
+    }
+
     PxDefaultMemoryOutputStream writeBuffer;
 
     if (m_bConvex) {
@@ -45,8 +85,8 @@ void MeshCollider::create(RigidBody *ignored) {
         convexDesc.setToDefault();
 
         convexDesc.points.count     = m_Mesh->getVertexCount();
-        convexDesc.points.stride    = m_Mesh->getVertexBegin().getStride();
-        convexDesc.points.data      = m_Mesh->getVertexBegin().getPointer();
+        convexDesc.points.stride    = sizeof(Vector3f);
+        convexDesc.points.data      = points;
         convexDesc.flags            = PxConvexFlag::eCOMPUTE_CONVEX;
 
         PxConvexMeshCookingResult::Enum result;
@@ -67,14 +107,14 @@ void MeshCollider::create(RigidBody *ignored) {
         PxTriangleMeshDesc meshDesc;
         meshDesc.setToDefault();
         meshDesc.points.count  = m_Mesh->getVertexCount();
-        meshDesc.points.stride = m_Mesh->getVertexBegin().getStride();
-        meshDesc.points.data   = m_Mesh->getVertexBegin().getPointer();
+        meshDesc.points.stride = sizeof(Vector3f);
+        meshDesc.points.data   = points;
 
-        meshDesc.triangles.count  = m_Mesh->getIndicesCount() / 3;
-        meshDesc.triangles.stride = 3 * sizeof(UInt16);
-        meshDesc.triangles.data   = m_Mesh->getIndicesData();
+        meshDesc.triangles.count  = indexCount / 3;
+        meshDesc.triangles.stride = 3 * (b16BitIndices ? sizeof(UInt16) : sizeof(UInt32));
+        meshDesc.triangles.data   = indexData;
 
-        meshDesc.flags = PxMeshFlag::e16_BIT_INDICES;
+        meshDesc.flags = b16BitIndices ? PxMeshFlags(PxMeshFlag::e16_BIT_INDICES) : PxMeshFlags();
 
         PxTriangleMeshCookingResult::Enum result;
         bool status = gPxCooking->cookTriangleMesh(meshDesc, writeBuffer, &result);
@@ -93,8 +133,15 @@ void MeshCollider::create(RigidBody *ignored) {
 
 MeshCollider::MeshCollider(ObjectCreationMode mode) : Super(mode), m_bConvex(), m_Mesh() {}
 
+void MeshCollider::getResourceReferences(std::vector<Object *> &references) const {
+    Super::getResourceReferences(references);
+    references.push_back(m_Mesh);
+}
+
 void MeshCollider::setMesh(Mesh *mesh) {
     m_Mesh = mesh;
+    /// saved with the mesh, so loading it again keeps what cooking needs
+    if (m_Mesh) m_Mesh->setKeepCollisionData(true);
     cleanup();
     create(nullptr);
 }
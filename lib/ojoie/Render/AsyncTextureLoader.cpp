@@ -0,0 +1,161 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/AsyncTextureLoader.hpp"
+#include "Threads/Threads.hpp"
+
+#include <algorithm>
+
+namespace AN {
+
+namespace {
+
+/// greater priority first, then submission order
+struct JobOrder {
+    template<typename Job>
+    bool operator () (const Job *lhs, const Job *rhs) const {
+        if (lhs->options.priority != rhs->options.priority) return lhs->options.priority < rhs->options.priority;
+        return lhs->id > rhs->id;
+    }
+};
+
+}
+
+AsyncTextureLoader::AsyncTextureLoader(UInt32 threadCount) : _nextID(kInvalidTextureLoadID), _decoding(), bStop() {
+    _threadCount = threadCount ? threadCount : std::max(1U, std::thread::hardware_concurrency() / 2);
+}
+
+AsyncTextureLoader::~AsyncTextureLoader() {
+    {
+        std::lock_guard lock(_mutex);
+        bStop = true;
+    }
+    _workCondition.notify_all();
+    for (std::thread &thread : _threads) {
+        thread.join();
+    }
+
+    for (Job *job : _queue) delete job;
+    for (Job *job : _completed) delete job;
+}
+
+TextureLoadID AsyncTextureLoader::load(const char *path, const AsyncTextureLoadOptions &options, TextureLoadCompletion completion) {
+    Job *job        = new Job();
+    job->path       = path;
+    job->options    = options;
+    job->completion = std::move(completion);
+    job->bCancelled = false;
+
+    {
+        std::lock_guard lock(_mutex);
+        /// threads start with the first load so an unused loader costs nothing
+        if (_threads.empty()) {
+            for (UInt32 i = 0; i < _threadCount; ++i) {
+                _threads.emplace_back(&AsyncTextureLoader::workerThread, this);
+            }
+        }
+
+        if (++_nextID == kInvalidTextureLoadID) ++_nextID;
+        job->id = _nextID;
+        _jobs[job->id] = job;
+        _queue.push_back(job);
+        std::push_heap(_queue.begin(), _queue.end(), JobOrder());
+    }
+    _workCondition.notify_one();
+    return job->id;
+}
+
+bool AsyncTextureLoader::cancel(TextureLoadID id) {
+    std::lock_guard lock(_mutex);
+    auto it = _jobs.find(id);
+    if (it == _jobs.end()) return false;
+    /// whoever holds the job next releases it
+    it->second->bCancelled = true;
+    _jobs.erase(it);
+    return true;
+}
+
+bool AsyncTextureLoader::setPriority(TextureLoadID id, int priority) {
+    std::lock_guard lock(_mutex);
+    auto it = std::find_if(_queue.begin(), _queue.end(), [id](Job *job) { return job->id == id; });
+    if (it == _queue.end() || (*it)->bCancelled) return false;
+    (*it)->options.priority = priority;
+    std::make_heap(_queue.begin(), _queue.end(), JobOrder());
+    return true;
+}
+
+void AsyncTextureLoader::workerThread() {
+    SetCurrentThreadName("TextureLoader");
+    std::unique_lock lock(_mutex);
+    while (true) {
+        _workCondition.wait(lock, [this] { return bStop || !_queue.empty(); });
+        if (bStop) break;
+
+        std::pop_heap(_queue.begin(), _queue.end(), JobOrder());
+        Job *job = _queue.back();
+        _queue.pop_back();
+
+        if (!job->bCancelled) {
+            ++_decoding;
+            lock.unlock();
+            LoadTextureResult result = TextureLoader::LoadTexture(job->path.c_str(), job->options.sRGB,
+                                                                  job->options.bBuildMipChain);
+            lock.lock();
+            --_decoding;
+            job->result = std::move(result);
+        }
+
+        if (job->bCancelled) {
+            delete job;
+        } else {
+            _completed.push_back(job);
+        }
+        _doneCondition.notify_all();
+    }
+}
+
+UInt32 AsyncTextureLoader::update(UInt32 maxCount) {
+    std::vector<Job *> ready;
+    {
+        std::lock_guard lock(_mutex);
+        size_t taken = 0;
+        for (; taken < _completed.size() && ready.size() < maxCount; ++taken) {
+            Job *job = _completed[taken];
+            if (job->bCancelled) {
+                delete job;
+                continue;
+            }
+            _jobs.erase(job->id);
+            ready.push_back(job);
+        }
+        _completed.erase(_completed.begin(), _completed.begin() + taken);
+    }
+
+    /// completions may start new loads
+    for (Job *job : ready) {
+        job->completion(job->result);
+        delete job;
+    }
+    return (UInt32) ready.size();
+}
+
+void AsyncTextureLoader::flush() {
+    {
+        std::unique_lock lock(_mutex);
+        _doneCondition.wait(lock, [this] { return _queue.empty() && _decoding == 0; });
+    }
+    update();
+}
+
+UInt32 AsyncTextureLoader::getPendingCount() const {
+    std::lock_guard lock(_mutex);
+    return (UInt32) _jobs.size();
+}
+
+AsyncTextureLoader &GetAsyncTextureLoader() {
+    static AsyncTextureLoader asyncTextureLoader;
+    return asyncTextureLoader;
+}
+
+}
@@ -43,6 +43,10 @@ DXGI_FORMAT toDXGIFormat(PixelFormat format) {
 
         case kPixelFormatRGBA16Float:
             return DXGI_FORMAT_R16G16B16A16_FLOAT;
+        case kPixelFormatRGBA32Float:
+            return DXGI_FORMAT_R32G32B32A32_FLOAT;
+        case kPixelFormatR32Uint:
+            return DXGI_FORMAT_R32_UINT;
 
         case kPixelFormatBC7_RGBAUnorm:
             return DXGI_FORMAT_BC7_UNORM;
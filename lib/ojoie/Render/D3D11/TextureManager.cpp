@@ -6,6 +6,7 @@
 #include "Render/private/D3D11/TextureManager.hpp"
 #include "Core/Exception.hpp"
 #include "Render/Image.hpp"
+#include "Render/MipChain.hpp"
 
 #include "Render/Texture2D.hpp"
 
@@ -34,8 +35,9 @@ void TextureManager::uploadTexture2DData(const UInt8 *srcData,
 
     if (it == stagingTextureBuffers.end()) {
         D3D11_TEXTURE2D_DESC desc;
-        desc.Width = width;
-        desc.Height = height;
+        /// block compressed textures without mips are whole blocks, levels below 4x4 copy a full block
+        desc.Width = isDXT ? (width + 3) & ~3U : width;
+        desc.Height = isDXT ? (height + 3) & ~3U : height;
         desc.MipLevels = 1;
         desc.ArraySize = 1;
         desc.Format = toDXGIFormat(format);
@@ -64,16 +66,9 @@ void TextureManager::uploadTexture2DData(const UInt8 *srcData,
     char *mappedData = (char *)mapped.pData;
     char *dataPtr = (char *)srcData;
 
-    const int minSize = isDXT ? 4 : 1;
-    int mipWidth = std::max((int)width, minSize);
-    int mipHeight = std::max((int)height, minSize);
-    size_t mappedSize = mapped.RowPitch * mipHeight;
-
     // pitch for compressed formats is for full row of blocks
-    if (isDXT) {
-        mappedSize /= 4;
-        mipHeight /= 4;
-    }
+    const UInt32 rowCount = isDXT ? (height + 3) / 4 : height;
+    size_t mappedSize = (size_t) mapped.RowPitch * rowCount;
 
     if (imageBytes == mappedSize) {
 
@@ -81,8 +76,8 @@ void TextureManager::uploadTexture2DData(const UInt8 *srcData,
 
     } else {
 
-        const size_t dataRowPitch = imageBytes / height;
-        for (int y = 0; y < height; ++y) {
+        const size_t dataRowPitch = imageBytes / rowCount;
+        for (UInt32 y = 0; y < rowCount; ++y) {
             memcpy(mappedData, dataPtr, dataRowPitch);
             mappedData += mapped.RowPitch;
             dataPtr += dataRowPitch;
@@ -103,11 +98,16 @@ void TextureManager::uploadTexture2D(AN::TextureID tid
                                      , const UInt8 *srcData,
                                      UInt32 width, UInt32 height,
                                      AN::PixelFormat format,
+                                     UInt32 mipCount,
                                      bool generateMipmap,
                                      const AN::SamplerDescriptor &samplerDescriptor) {
 
     ANAssert((width != 0 && height != 0));
 
+    /// levels already in srcData are uploaded as they are, the GPU only fills a single level chain
+    mipCount = std::max(mipCount, 1U);
+    generateMipmap = generateMipmap && mipCount == 1;
+
     auto it = textureIdMap.find(tid);
 
     Texture *targetTex;
@@ -117,11 +117,8 @@ void TextureManager::uploadTexture2D(AN::TextureID tid
 
         tex = std::make_unique<Texture>();
 
-        UInt32 mipCount;
         if (generateMipmap) {
-            mipCount = (uint32_t) (std::floor(std::log2(std::max(width, height)))) + 1;
-        } else {
-            mipCount = 1;
+            mipCount = CalculateMipCount(width, height);
         }
 
         /// create texture if not exist
@@ -166,10 +163,17 @@ void TextureManager::uploadTexture2D(AN::TextureID tid
         targetTex = it->second.get();
     }
 
-    uploadTexture2DData(srcData, targetTex->_texture.Get(), width, height, format, 0);
-
     if (generateMipmap) {
+        uploadTexture2DData(srcData, targetTex->_texture.Get(), width, height, format, 0);
         GetD3D11Context()->GenerateMips(targetTex->_srv.Get());
+    } else {
+        const UInt8 *levelData = srcData;
+        for (UInt32 level = 0; level < mipCount; ++level) {
+            UInt32 levelWidth = CalculateMipSize(width, level), levelHeight = CalculateMipSize(height, level);
+            uploadTexture2DData(levelData, targetTex->_texture.Get(), levelWidth, levelHeight, format,
+                                D3D11CalcSubresource(level, 0, mipCount));
+            levelData += CalculatePixelFormatSize(format, levelWidth, levelHeight);
+        }
     }
 
     if (tex) {
@@ -177,6 +181,51 @@ void TextureManager::uploadTexture2D(AN::TextureID tid
     }
 }
 
+void TextureManager::updateTexture2DMips(TextureID tid, const UInt8 *srcData,
+                                         UInt32 width, UInt32 height,
+                                         PixelFormat format, UInt32 mipCount) {
+    auto it = textureIdMap.find(tid);
+    ANAssert(it != textureIdMap.end());
+    Texture *targetTex = it->second.get();
+
+    D3D11_TEXTURE2D_DESC desc;
+    targetTex->_texture->GetDesc(&desc);
+    UInt32 oldMipCount = desc.MipLevels;
+    if (oldMipCount == mipCount) return;
+
+    desc.Width     = width;
+    desc.Height    = height;
+    desc.MipLevels = mipCount;
+
+    ComPtr<ID3D11Texture2D>          texture;
+    ComPtr<ID3D11ShaderResourceView> srv;
+    HRESULT hr;
+    D3D_ASSERT(hr, GetD3D11Device()->CreateTexture2D(&desc, nullptr, &texture));
+    D3D11SetDebugName(texture.Get(), std::format("Texture2D-{}-{}x{}", tid, width, height));
+    D3D_ASSERT(hr, GetD3D11Device()->CreateShaderResourceView(texture.Get(), nullptr, &srv));
+    D3D11SetDebugName(srv.Get(), std::format("Texture2D-SRV-{}-{}x{}", tid, width, height));
+
+    /// both chains end at the same 1x1 level, level i of the new one is level i + oldMipCount - mipCount of the old one
+    UInt32       newLevels = mipCount > oldMipCount ? mipCount - oldMipCount : 0;
+    const UInt8 *levelData = srcData;
+    for (UInt32 level = 0; level < mipCount; ++level) {
+        UInt32 levelWidth = CalculateMipSize(width, level), levelHeight = CalculateMipSize(height, level);
+        if (level < newLevels) {
+            ANAssert(srcData != nullptr);
+            uploadTexture2DData(levelData, texture.Get(), levelWidth, levelHeight, format,
+                                D3D11CalcSubresource(level, 0, mipCount));
+            levelData += CalculatePixelFormatSize(format, levelWidth, levelHeight);
+        } else {
+            UInt32 oldLevel = level + oldMipCount - mipCount;
+            GetD3D11Context()->CopySubresourceRegion(texture.Get(), D3D11CalcSubresource(level, 0, mipCount), 0, 0, 0,
+                                                     targetTex->_texture.Get(), D3D11CalcSubresource(oldLevel, 0, oldMipCount),
+                                                     nullptr);
+        }
+    }
+
+    targetTex->_texture = std::move(texture);
+    targetTex->_srv     = std::move(srv);
+}
 
 void TextureManager::uploadTextureCube(TextureID tid, UInt8 *srcData,
                                        UInt32 faceSize, UInt32 size,
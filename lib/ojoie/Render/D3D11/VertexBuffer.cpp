@@ -150,7 +150,7 @@ void VertexBuffer::updateIndexBufferData(const IndexBufferData &sourceData) {
     ANAssert(m_IB);
     HRESULT hr;
 
-    int size = sourceData.count * kVBOIndexSize;
+    int size = CalculateIndexBufferSize(sourceData);
 
     const D3D11_MAP mapType = _indicesDynamic ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE;
     ID3D11Buffer   *mapIB;
@@ -196,7 +196,8 @@ void VertexBuffer::updateIndexData(const IndexBufferData &buffer) {
         D3D11SetDebugName(m_IB.Get(), std::format("IndexBuffer-{}", newSize));
     }
 
-    m_IBSize = newSize;
+    m_IBSize     = newSize;
+    _indexFormat = buffer.format;
     updateIndexBufferData(buffer);
 }
 
@@ -221,7 +222,7 @@ void VertexBuffer::drawIndexed(AN::CommandBuffer *_commandBuffer,
     bindVertexStream(_commandBuffer);
     D3D11::CommandBuffer *commandBuffer = (D3D11::CommandBuffer *) _commandBuffer;
     ID3D11DeviceContext  *ctx           = commandBuffer->getContext();
-    ctx->IASetIndexBuffer(m_IB.Get(), DXGI_FORMAT_R16_UINT, 0);
+    ctx->IASetIndexBuffer(m_IB.Get(), _indexFormat == kIndexFormatUInt32 ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT, 0);
     ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     _commandBuffer->drawIndexed(indexCount, indexOffset, vertexOffset);
 }
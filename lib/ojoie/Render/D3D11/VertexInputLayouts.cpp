@@ -130,6 +130,28 @@ static DXGI_FORMAT GetD3D11VertexDeclType(const ChannelInfo &info) {
         case kChannelFormatColor: {
             return DXGI_FORMAT_R8G8B8A8_UNORM;
         }
+        case kChannelFormatUNorm16: {
+            switch (info.dimension) {
+                case 2:
+                    return DXGI_FORMAT_R16G16_UNORM;
+                case 4:
+                    return DXGI_FORMAT_R16G16B16A16_UNORM;
+            }
+            break;
+        }
+        case kChannelFormatSNorm16: {
+            switch (info.dimension) {
+                case 2:
+                    return DXGI_FORMAT_R16G16_SNORM;
+                case 4:
+                    return DXGI_FORMAT_R16G16B16A16_SNORM;
+            }
+            break;
+        }
+        case kChannelFormatOctahedral16: {
+            /// decoded in the vertex shader, see DecodeNormalOS
+            return DXGI_FORMAT_R16G16_SNORM;
+        }
     }
     ANAssert("No matching D3D11 vertex decl type!");
     return DXGI_FORMAT_UNKNOWN;
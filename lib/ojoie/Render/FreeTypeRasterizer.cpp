@@ -0,0 +1,166 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/FreeTypeRasterizer.hpp"
+#include "Utility/Log.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_MODULE_H
+
+#include <fstream>
+
+namespace AN {
+
+FreeTypeRasterizer::FreeTypeRasterizer(UInt32 sdfSpread) : _library(), _sdfSpread(sdfSpread) {
+    FT_Library library;
+    if (FT_Init_FreeType(&library)) {
+        AN_LOG(Error, "%s", "Failed to init FreeType");
+        return;
+    }
+    _library = library;
+
+    /// the spread is a library property, set once before any thread renders
+    FT_Int spread = (FT_Int) sdfSpread;
+    FT_Property_Set(library, "sdf", "spread", &spread);
+    FT_Property_Set(library, "bsdf", "spread", &spread);
+}
+
+FreeTypeRasterizer::~FreeTypeRasterizer() {
+    for (auto &font : _fonts) {
+        for (void *face : font->faces) {
+            FT_Done_Face((FT_Face) face);
+        }
+    }
+    if (_library) {
+        FT_Done_FreeType((FT_Library) _library);
+    }
+}
+
+FontID FreeTypeRasterizer::loadFont(const char *path) {
+    if (_library == nullptr) return kInvalidFontID;
+
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream) {
+        AN_LOG(Error, "Cannot open font %s", path);
+        return kInvalidFontID;
+    }
+    auto font = std::make_unique<FontData>();
+    font->file.resize((size_t) stream.tellg());
+    stream.seekg(0);
+    stream.read((char *) font->file.data(), (std::streamsize) font->file.size());
+
+    std::lock_guard lock(_mutex);
+    FT_Face face;
+    if (FT_New_Memory_Face((FT_Library) _library, font->file.data(), (FT_Long) font->file.size(), 0, &face)) {
+        AN_LOG(Error, "FreeType cannot read font %s", path);
+        return kInvalidFontID;
+    }
+    font->name = face->family_name ? face->family_name : path;
+    font->faces.push_back(face);
+    _fonts.push_back(std::move(font));
+    return (FontID) _fonts.size() - 1;
+}
+
+const char *FreeTypeRasterizer::getFontName(FontID font) {
+    std::lock_guard lock(_mutex);
+    return font < _fonts.size() ? _fonts[font]->name.c_str() : nullptr;
+}
+
+void *FreeTypeRasterizer::acquireFace(FontID font) {
+    std::lock_guard lock(_mutex);
+    if (font >= _fonts.size()) return nullptr;
+    FontData &data = *_fonts[font];
+    if (!data.faces.empty()) {
+        void *face = data.faces.back();
+        data.faces.pop_back();
+        return face;
+    }
+    /// a face is used by one thread at a time, creating it touches the library
+    FT_Face face;
+    if (FT_New_Memory_Face((FT_Library) _library, data.file.data(), (FT_Long) data.file.size(), 0, &face)) {
+        return nullptr;
+    }
+    return face;
+}
+
+void FreeTypeRasterizer::releaseFace(FontID font, void *face) {
+    std::lock_guard lock(_mutex);
+    _fonts[font]->faces.push_back(face);
+}
+
+bool FreeTypeRasterizer::rasterize(FontID font, UInt32 codepoint, UInt32 pixelSize, bool bSDF, GlyphBitmap &outBitmap) {
+    FT_Face face = (FT_Face) acquireFace(font);
+    if (face == nullptr) return false;
+
+    bool         bSucceeded = false;
+    FT_GlyphSlot slot       = face->glyph;
+    FT_UInt      index      = FT_Get_Char_Index(face, codepoint);
+    if (index != 0 &&
+        FT_Set_Pixel_Sizes(face, 0, pixelSize) == 0 &&
+        FT_Load_Glyph(face, index, FT_LOAD_DEFAULT) == 0) {
+
+        /// an empty outline has nothing to render, SDF would fail on it
+        bool bEmpty = slot->format == FT_GLYPH_FORMAT_OUTLINE && slot->outline.n_points == 0;
+        if (bEmpty || FT_Render_Glyph(slot, bSDF ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL) == 0) {
+            const FT_Bitmap &bitmap = slot->bitmap;
+            UInt32 width = bEmpty ? 0 : bitmap.width, height = bEmpty ? 0 : bitmap.rows;
+
+            outBitmap.metrics.advance  = (float) slot->advance.x / 64.f;
+            outBitmap.metrics.bearingX = (Int16) slot->bitmap_left;
+            outBitmap.metrics.bearingY = (Int16) slot->bitmap_top;
+            outBitmap.metrics.width    = (UInt16) width;
+            outBitmap.metrics.height   = (UInt16) height;
+            outBitmap.pixels.resize((size_t) width * height);
+
+            for (UInt32 y = 0; y < height; ++y) {
+                const UInt8 *row = bitmap.buffer + (ptrdiff_t) y * bitmap.pitch;
+                UInt8       *dst = &outBitmap.pixels[(size_t) y * width];
+                if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO) {
+                    for (UInt32 x = 0; x < width; ++x) {
+                        dst[x] = (row[x >> 3] & (0x80 >> (x & 7))) ? 255 : 0;
+                    }
+                } else {
+                    memcpy(dst, row, width);
+                }
+            }
+            bSucceeded = true;
+        }
+    }
+
+    releaseFace(font, face);
+    return bSucceeded;
+}
+
+FontLineMetrics FreeTypeRasterizer::getLineMetrics(FontID font, UInt32 pixelSize) {
+    FontLineMetrics metrics{};
+    FT_Face face = (FT_Face) acquireFace(font);
+    if (face == nullptr) return metrics;
+
+    if (FT_Set_Pixel_Sizes(face, 0, pixelSize) == 0) {
+        metrics.ascender   = (float) face->size->metrics.ascender / 64.f;
+        metrics.descender  = (float) face->size->metrics.descender / 64.f;
+        metrics.lineHeight = (float) face->size->metrics.height / 64.f;
+    }
+    releaseFace(font, face);
+    return metrics;
+}
+
+float FreeTypeRasterizer::getKerning(FontID font, UInt32 left, UInt32 right, UInt32 pixelSize) {
+    FT_Face face = (FT_Face) acquireFace(font);
+    if (face == nullptr) return 0.f;
+
+    float kerning = 0.f;
+    FT_Vector delta;
+    if (FT_HAS_KERNING(face) &&
+        FT_Set_Pixel_Sizes(face, 0, pixelSize) == 0 &&
+        FT_Get_Kerning(face, FT_Get_Char_Index(face, left), FT_Get_Char_Index(face, right),
+                       FT_KERNING_DEFAULT, &delta) == 0) {
+        kerning = (float) delta.x / 64.f;
+    }
+    releaseFace(font, face);
+    return kerning;
+}
+
+}
@@ -0,0 +1,244 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/GlyphCache.hpp"
+#include "Threads/Threads.hpp"
+#include "Utility/Log.h"
+
+#include <algorithm>
+
+namespace AN {
+
+GlyphCache::GlyphCache(GlyphRasterizer *rasterizer, const GlyphCacheSettings &settings)
+    : _rasterizer(rasterizer), _settings(settings), _stats(), _frame(), _rasterizing(), bStop() {
+    _threadCount = settings.threadCount ? settings.threadCount : std::max(1U, std::thread::hardware_concurrency() / 2);
+}
+
+GlyphCache::~GlyphCache() {
+    {
+        std::lock_guard lock(_mutex);
+        bStop = true;
+    }
+    _workCondition.notify_all();
+    for (std::thread &thread : _threads) {
+        thread.join();
+    }
+
+    for (Job *job : _queue) delete job;
+    for (Job *job : _completed) delete job;
+    for (Job *job : _deferred) delete job;
+}
+
+GlyphKey GlyphCache::normalizeKey(const GlyphKey &key) const {
+    GlyphKey normalized = key;
+    if (key.bSDF) {
+        normalized.pixelSize = (UInt16) _settings.sdfPixelSize;
+    }
+    return normalized;
+}
+
+GlyphStatus GlyphCache::getGlyph(const GlyphKey &key, const CachedGlyph *&outGlyph) {
+    outGlyph = nullptr;
+    auto [it, bInserted] = _glyphs.try_emplace(normalizeKey(key));
+    Entry &entry = it->second;
+
+    if (bInserted) {
+        entry.status = kGlyphPending;
+        Job *job        = new Job();
+        job->key        = it->first;
+        job->bSucceeded = false;
+        {
+            std::lock_guard lock(_mutex);
+            /// threads start with the first glyph so an unused cache costs nothing
+            if (_threads.empty()) {
+                for (UInt32 i = 0; i < _threadCount; ++i) {
+                    _threads.emplace_back(&GlyphCache::workerThread, this);
+                }
+            }
+            _queue.push_back(job);
+        }
+        _workCondition.notify_one();
+        return kGlyphPending;
+    }
+
+    if (entry.status == kGlyphReady) {
+        outGlyph = &entry.glyph;
+        if (entry.glyph.page != kNoGlyphPage) {
+            _pages[entry.glyph.page].lastUsedFrame = _frame;
+        }
+    }
+    return entry.status;
+}
+
+void GlyphCache::workerThread() {
+    SetCurrentThreadName("GlyphRasterizer");
+    std::unique_lock lock(_mutex);
+    while (true) {
+        _workCondition.wait(lock, [this] { return bStop || !_queue.empty(); });
+        if (bStop) break;
+
+        Job *job = _queue.front();
+        _queue.pop_front();
+        ++_rasterizing;
+        lock.unlock();
+        job->bSucceeded = _rasterizer->rasterize(job->key.font, job->key.codepoint, job->key.pixelSize,
+                                                 job->key.bSDF, job->bitmap);
+        lock.lock();
+        --_rasterizing;
+        _completed.push_back(job);
+        _doneCondition.notify_all();
+    }
+}
+
+UInt32 GlyphCache::evictPage() {
+    /// the least recently used page not drawn this or the last frame
+    UInt32 victim = kNoGlyphPage;
+    for (UInt32 i = 0; i < _pages.size(); ++i) {
+        if (_pages[i].lastUsedFrame + 1 >= _frame) continue;
+        if (victim == kNoGlyphPage || _pages[i].lastUsedFrame < _pages[victim].lastUsedFrame) {
+            victim = i;
+        }
+    }
+    if (victim == kNoGlyphPage) return kNoGlyphPage;
+
+    for (auto it = _glyphs.begin(); it != _glyphs.end();) {
+        if (it->second.status == kGlyphReady && it->second.glyph.page == victim) {
+            it = _glyphs.erase(it);
+            --_stats.glyphCount;
+            ++_stats.evictedGlyphs;
+        } else {
+            ++it;
+        }
+    }
+
+    GlyphAtlasPage &page = _pages[victim];
+    std::fill(page.pixels.begin(), page.pixels.end(), 0);
+    page.packer.reset();
+    ++page.generation;
+    page.bDirty = true;
+    ++_stats.evictedPages;
+    return victim;
+}
+
+bool GlyphCache::place(Job *job) {
+    auto it = _glyphs.find(job->key);
+    if (it == _glyphs.end()) return true;
+    Entry &entry = it->second;
+
+    if (!job->bSucceeded) {
+        entry.status = kGlyphMissing;
+        return true;
+    }
+
+    const GlyphMetrics &metrics = job->bitmap.metrics;
+    if (metrics.width == 0 || metrics.height == 0) {
+        entry.glyph  = { metrics, kNoGlyphPage, 0, 0 };
+        entry.status = kGlyphReady;
+        ++_stats.glyphCount;
+        return true;
+    }
+
+    UInt32 width = metrics.width + _settings.padding, height = metrics.height + _settings.padding;
+    if (width > _settings.pageSize || height > _settings.pageSize) {
+        AN_LOG(Warning, "Glyph %u of %ux%u does not fit in a glyph page of %u",
+               job->key.codepoint, metrics.width, metrics.height, _settings.pageSize);
+        entry.status = kGlyphMissing;
+        return true;
+    }
+
+    UInt32 pageIndex = kNoGlyphPage, x = 0, y = 0;
+    for (UInt32 i = 0; i < _pages.size(); ++i) {
+        if (_pages[i].packer.pack(width, height, x, y)) {
+            pageIndex = i;
+            break;
+        }
+    }
+
+    if (pageIndex == kNoGlyphPage) {
+        if (_pages.size() < _settings.maxPages) {
+            GlyphAtlasPage &page = _pages.emplace_back();
+            page.pixels.assign((size_t) _settings.pageSize * _settings.pageSize, 0);
+            page.packer.reset(_settings.pageSize, _settings.pageSize);
+            page.generation = 0;
+            pageIndex       = (UInt32) _pages.size() - 1;
+        } else {
+            pageIndex = evictPage();
+            if (pageIndex == kNoGlyphPage) return false;
+        }
+        _pages[pageIndex].packer.pack(width, height, x, y);
+    }
+
+    GlyphAtlasPage &page = _pages[pageIndex];
+    for (UInt32 row = 0; row < metrics.height; ++row) {
+        memcpy(&page.pixels[(size_t) (y + row) * _settings.pageSize + x],
+               &job->bitmap.pixels[(size_t) row * metrics.width], metrics.width);
+    }
+    /// a glyph is placed because it was asked for lately
+    page.lastUsedFrame = _frame;
+    page.bDirty        = true;
+
+    entry.glyph  = { metrics, pageIndex, (UInt16) x, (UInt16) y };
+    entry.status = kGlyphReady;
+    ++_stats.glyphCount;
+    return true;
+}
+
+void GlyphCache::placeCompleted() {
+    std::vector<Job *> jobs;
+    jobs.swap(_deferred);
+    {
+        std::lock_guard lock(_mutex);
+        _stats.rasterized += (UInt32) _completed.size();
+        jobs.insert(jobs.end(), _completed.begin(), _completed.end());
+        _completed.clear();
+    }
+
+    for (Job *job : jobs) {
+        if (place(job)) {
+            delete job;
+        } else {
+            _deferred.push_back(job);
+        }
+    }
+}
+
+void GlyphCache::update(UInt32 frameIndex) {
+    _frame = frameIndex;
+    placeCompleted();
+}
+
+void GlyphCache::flush() {
+    {
+        std::unique_lock lock(_mutex);
+        _doneCondition.wait(lock, [this] { return _queue.empty() && _rasterizing == 0; });
+    }
+    placeCompleted();
+}
+
+void GlyphCache::clear() {
+    {
+        std::unique_lock lock(_mutex);
+        for (Job *job : _queue) delete job;
+        _queue.clear();
+        _doneCondition.wait(lock, [this] { return _rasterizing == 0; });
+        for (Job *job : _completed) delete job;
+        _completed.clear();
+    }
+    for (Job *job : _deferred) delete job;
+    _deferred.clear();
+    _glyphs.clear();
+    _pages.clear();
+    _stats.glyphCount = 0;
+}
+
+float GlyphCache::getOccupancy() const {
+    if (_pages.empty()) return 0.f;
+    float occupancy = 0.f;
+    for (const GlyphAtlasPage &page : _pages) {
+        occupancy += page.packer.getOccupancy();
+    }
+    return occupancy / (float) _pages.size();
+}
+
+}
@@ -17,6 +17,10 @@ UInt64 CalculatePixelFormatSize(PixelFormat pixelFormat, UInt32 width, UInt32 he
         case kPixelFormatRGBA8Unorm:
         case kPixelFormatRGBA8Unorm_sRGB:
             return 4 * width * height;
+        case kPixelFormatR32Uint:
+            return 4 * width * height;
+        case kPixelFormatRGBA32Float:
+            return 16 * width * height;
 
         case kPixelFormatBC1_RGBA:
         case kPixelFormatBC1_RGBA_sRGB:
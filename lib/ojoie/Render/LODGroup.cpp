@@ -0,0 +1,216 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/LODGroup.hpp"
+#include "Components/Transform.hpp"
+#include "Core/Actor.hpp"
+
+#include <algorithm>
+
+#ifdef OJOIE_WITH_EDITOR
+#include "IMGUI/IMGUI.hpp"
+#endif
+
+namespace AN {
+
+IMPLEMENT_AN_CLASS_INIT(LODGroup)
+LOAD_AN_CLASS(LODGroup)
+IMPLEMENT_AN_OBJECT_SERIALIZE(LODGroup)
+INSTANTIATE_TEMPLATE_TRANSFER(LODGroup)
+
+LODGroup::~LODGroup() {}
+
+LODGroup::LODGroup(ObjectCreationMode mode)
+    : Super(mode), m_ListNode(this), m_LocalReferencePoint(), m_Size(1.f), m_FadeTransitionWidth(), bAddToManager() {}
+
+void LODGroup::InitializeClass() {
+    GetClassStatic()->registerMessageCallback(kDidAddComponentMessage,
+                                              [](void *receiver, Message &message) {
+                                                  LODGroup *group = (LODGroup *) receiver;
+                                                  if (message.getData<Component *>() == group) {
+                                                      /// only do when the added component is self
+                                                      group->onAddLODGroup();
+                                                  }
+                                              });
+}
+
+void LODGroup::onAddLODGroup() {
+    bAddToManager = true;
+    GetLODGroupManager().addLODGroup(m_ListNode);
+}
+
+void LODGroup::dealloc() {
+    if (bAddToManager) {
+        GetLODGroupManager().removeLODGroup(m_ListNode);
+    }
+    resetRenderers();
+    unregisterRenderers();
+    Super::dealloc();
+}
+
+void LODGroup::resetRenderers() {
+    for (LOD &lod : m_LODs) {
+        for (Renderer *renderer : lod.renderers) {
+            if (renderer) {
+                renderer->setLODState(false, 1.f);
+            }
+        }
+    }
+}
+
+void LODGroup::registerRenderers() {
+    for (LOD &lod : m_LODs) {
+        for (Renderer *renderer : lod.renderers) {
+            if (renderer && std::find(renderer->m_LODGroups.begin(), renderer->m_LODGroups.end(), this) == renderer->m_LODGroups.end()) {
+                renderer->m_LODGroups.push_back(this);
+            }
+        }
+    }
+}
+
+void LODGroup::unregisterRenderers() {
+    for (LOD &lod : m_LODs) {
+        for (Renderer *renderer : lod.renderers) {
+            if (renderer) {
+                std::erase(renderer->m_LODGroups, this);
+            }
+        }
+    }
+}
+
+void LODGroup::removeRenderer(Renderer *renderer) {
+    for (LOD &lod : m_LODs) {
+        std::erase(lod.renderers, renderer);
+    }
+}
+
+void LODGroup::setLODs(std::span<const LOD> lods) {
+    resetRenderers();
+    unregisterRenderers();
+    m_LODs.assign(lods.begin(), lods.begin() + std::min<size_t>(lods.size(), kMaxLODLevels));
+    registerRenderers();
+}
+
+LODGroupData LODGroup::getLODGroupData() const {
+    LODGroupData data{};
+    data.groupID             = getInstanceID();
+    data.lodCount            = std::min<UInt32>(m_LODs.size(), kMaxLODLevels);
+    data.fadeTransitionWidth = std::clamp(m_FadeTransitionWidth, 0.f, 1.f);
+
+    for (UInt32 i = 0; i < data.lodCount; ++i) {
+        data.screenRelativeHeights[i] = m_LODs[i].screenRelativeHeight;
+    }
+
+    Transform *transform = getTransform();
+    if (transform) {
+        data.worldCenter = transform->getLocalToWorldMatrix() * Vector4f(m_LocalReferencePoint, 1.f);
+        Vector3f scale   = Math::abs(transform->getLocalScale());
+        for (Transform *parent = transform->getParent(); parent; parent = parent->getParent()) {
+            scale *= Math::abs(parent->getLocalScale());
+        }
+        data.worldSize = m_Size * std::max({ scale.x, scale.y, scale.z });
+    } else {
+        data.worldCenter = m_LocalReferencePoint;
+        data.worldSize   = m_Size;
+    }
+    return data;
+}
+
+void LODGroup::applySelection(const LODSelectionState &state) {
+    /// hide first, a renderer shared by several levels stays visible if any of them is selected
+    for (LOD &lod : m_LODs) {
+        for (Renderer *renderer : lod.renderers) {
+            if (renderer) {
+                renderer->setLODState(true, 0.f);
+            }
+        }
+    }
+
+    UInt32 count = std::min<UInt32>(m_LODs.size(), kMaxLODLevels);
+    if (state.lod < count && state.fade > 0.f) {
+        for (Renderer *renderer : m_LODs[state.lod].renderers) {
+            if (renderer) {
+                renderer->setLODState(false, state.fade);
+            }
+        }
+    }
+
+    if (state.fadeLOD < count && state.fade < 1.f) {
+        for (Renderer *renderer : m_LODs[state.fadeLOD].renderers) {
+            if (renderer && renderer->isLODCulled()) {
+                renderer->setLODState(false, state.fade - 1.f);
+            }
+        }
+    }
+}
+
+template<typename _Coder>
+void LODGroup::transfer(_Coder &coder) {
+    Super::transfer(coder);
+    TRANSFER(m_LocalReferencePoint);
+    TRANSFER(m_Size);
+    TRANSFER(m_FadeTransitionWidth);
+
+    if constexpr (_Coder::IsDecoding()) {
+        unregisterRenderers();
+    }
+
+    TRANSFER(m_LODs);
+
+    if constexpr (_Coder::IsDecoding()) {
+        registerRenderers();
+    }
+}
+
+void LODGroup::onInspectorGUI() {
+#ifdef OJOIE_WITH_EDITOR
+    ItemLabel("Size", kItemLabelLeft);
+    ImGui::DragFloat("##Size", &m_Size, 0.01f, 0.f, 10000.f);
+    ItemLabel("Fade Transition Width", kItemLabelLeft);
+    ImGui::SliderFloat("##Fade Transition Width", &m_FadeTransitionWidth, 0.f, 1.f);
+
+    for (UInt32 i = 0; i < m_LODs.size(); ++i) {
+        ImGui::PushID(i);
+        ItemLabel(std::format("LOD {} ({} renderers)", i, m_LODs[i].renderers.size()), kItemLabelLeft);
+        ImGui::SliderFloat("##Screen Relative Height", &m_LODs[i].screenRelativeHeight, 0.f, 1.f);
+        ImGui::PopID();
+    }
+#endif
+}
+
+void LODGroupManager::addLODGroup(LODGroupListNode &node) {
+    m_List.push_back(node);
+}
+
+void LODGroupManager::removeLODGroup(LODGroupListNode &node) {
+    node.removeFromList();
+}
+
+void LODGroupManager::update() {
+    m_Groups.clear();
+    m_GroupData.clear();
+    for (LODGroupListNode &node : m_List) {
+        LODGroup &group = *node;
+        if (group.getLODCount() == 0) continue;
+        m_Groups.push_back(&group);
+        m_GroupData.push_back(group.getLODGroupData());
+    }
+}
+
+void LODGroupManager::selectLODs(const LODSelectionParams &params, std::vector<LODSelectionState> &states) {
+    /// states are matched by group id, a mismatch after groups are added or removed resets the state
+    states.resize(m_GroupData.size());
+    SelectLODs(params, m_GroupData, states);
+
+    for (UInt32 i = 0; i < m_Groups.size(); ++i) {
+        m_Groups[i]->applySelection(states[i]);
+    }
+}
+
+LODGroupManager &GetLODGroupManager() {
+    static LODGroupManager lodGroupManager;
+    return lodGroupManager;
+}
+
+}
@@ -0,0 +1,87 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/LODSelection.hpp"
+#include "Threads/ParallelFor.hpp"
+#include "Utility/Assert.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace AN {
+
+/// groups per worker task, selection is cheap so keep the batches large
+static constexpr size_t kLODSelectionGrainSize = 256;
+
+float ComputeLODRelativeHeight(const LODSelectionParams &params, const LODGroupData &group) {
+    float distance = Math::length(group.worldCenter - params.cameraPosition);
+
+    /// camera inside the group always gets the finest level
+    if (distance <= group.worldSize * 0.5f) return FLT_MAX;
+
+    return group.worldSize * params.screenHeightScale / distance * params.lodBias;
+}
+
+static void SelectLOD(const LODSelectionParams &params, const LODGroupData &group, LODSelectionState &state) {
+    bool reset = state.groupID != group.groupID;
+    if (reset) {
+        state         = {};
+        state.groupID = group.groupID;
+    }
+
+    UInt32       count  = std::min<UInt32>(group.lodCount, kMaxLODLevels);
+    const float *thr    = group.screenRelativeHeights;
+    float        height = ComputeLODRelativeHeight(params, group);
+
+    UInt32 level;
+    if (reset) {
+        level = 0;
+        while (level < count && height < thr[level]) ++level;
+    } else {
+        /// switch only after the height crossed a threshold by the hysteresis margin
+        level = state.lod == kLODCulled ? count : std::min<UInt32>(state.lod, count);
+        float coarser = 1.f - params.hysteresis;
+        float finer   = 1.f + params.hysteresis;
+        while (level < count && height < thr[level] * coarser) ++level;
+        while (level > 0 && height >= thr[level - 1] * finer) --level;
+    }
+
+    state.relativeHeight = height;
+    state.fadeLOD        = kLODCulled;
+
+    if (level >= count) {
+        state.lod  = kLODCulled;
+        state.fade = 0.f;
+        return;
+    }
+
+    level      = std::max(level, std::min(params.maxLOD, count - 1));
+    state.lod  = (UInt8) level;
+    state.fade = 1.f;
+
+    if (group.fadeTransitionWidth > 0.f) {
+        /// fade into the next level in the lowest part of the band of this level,
+        /// the last level fades out to nothing
+        float lower = thr[level];
+        float upper = level == 0 ? std::max(1.f, lower) : thr[level - 1];
+        float zone  = group.fadeTransitionWidth * (upper - lower);
+        if (zone > 0.f && height < lower + zone) {
+            state.fade    = std::clamp((height - lower) / zone, 0.f, 1.f);
+            state.fadeLOD = level + 1 < count ? (UInt8) (level + 1) : (UInt8) kLODCulled;
+        }
+    }
+}
+
+void SelectLODs(const LODSelectionParams &params,
+                std::span<const LODGroupData> groups,
+                std::span<LODSelectionState> states) {
+    ANAssert(groups.size() == states.size());
+    ParallelFor(groups.size(), kLODSelectionGrainSize, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            SelectLOD(params, groups[i], states[i]);
+        }
+    });
+}
+
+}
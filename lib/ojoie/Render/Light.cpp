@@ -15,7 +15,8 @@ namespace AN {
 IMPLEMENT_AN_CLASS(Light)
 LOAD_AN_CLASS(Light)
 
-Light::Light(ObjectCreationMode mode) : Super(mode), m_ListNode(this), m_Color(1.f, 1.f, 1.f, 1.f), bAddToManager(), m_DepthBias(), m_NormalBias() {}
+Light::Light(ObjectCreationMode mode) : Super(mode), m_ListNode(this), m_Color(1.f, 1.f, 1.f, 1.f), bAddToManager(), m_DepthBias(), m_NormalBias(),
+      m_Range(10.f), m_SpotAngle(30.f), m_InnerSpotAngle(21.8f) {}
 
 bool Light::init() {
     if (!Super::init()) return false;
@@ -36,6 +37,25 @@ void Light::dealloc() {
     Super::dealloc();
 }
 
+LocalLightData Light::getLocalLightData() const {
+    LocalLightData data;
+    data.position = getTransform()->getPosition();
+    data.range    = m_Range;
+    data.color    = m_Color;
+
+    if (m_Type == kLightSpot) {
+        /// light points to -z like camera
+        data.spotDirection = Math::normalize(getTransform()->getRotation() * Vector3f(0.f, 0.f, -1.f));
+        data.spotCosOuter  = std::cos(Math::radians(m_SpotAngle * 0.5f));
+        data.spotCosInner  = std::max(std::cos(Math::radians(m_InnerSpotAngle * 0.5f)), data.spotCosOuter + 0.0001f);
+    } else {
+        data.spotDirection = Vector3f(0.f, 0.f, -1.f);
+        data.spotCosOuter  = -2.f;
+        data.spotCosInner  = -1.f;
+    }
+    return data;
+}
+
 void Light::onInspectorGUI() {
 #ifdef OJOIE_WITH_EDITOR
     ItemLabel("Light Color", kItemLabelLeft);
@@ -44,6 +64,16 @@ void Light::onInspectorGUI() {
     ImGui::DragFloat("##Depth Bias ", &m_DepthBias, 0.001f);
     ItemLabel("Normal Bias", kItemLabelLeft);
     ImGui::DragFloat("##Normal Bias ", &m_NormalBias, 0.001f);
+    if (m_Type != kLightDirectional) {
+        ItemLabel("Range", kItemLabelLeft);
+        ImGui::DragFloat("##Range ", &m_Range, 0.1f, 0.f, 1000.f);
+    }
+    if (m_Type == kLightSpot) {
+        ItemLabel("Spot Angle", kItemLabelLeft);
+        ImGui::DragFloat("##Spot Angle ", &m_SpotAngle, 0.1f, 1.f, 179.f);
+        ItemLabel("Inner Spot Angle", kItemLabelLeft);
+        ImGui::DragFloat("##Inner Spot Angle ", &m_InnerSpotAngle, 0.1f, 0.f, m_SpotAngle);
+    }
 #endif
 }
 
@@ -67,11 +97,15 @@ void LightManager::removeLight(LightListNode &node) {
 void LightManager::update() {
     /// get first directional light as main light
     Light *mainLight = nullptr;
+    m_LocalLights.clear();
     for (LightListNode &node : m_List) {
         Light &light = *node;
         if (light.getType() == kLightDirectional) {
-            mainLight = &light;
-            break;
+            if (mainLight == nullptr) {
+                mainLight = &light;
+            }
+        } else {
+            m_LocalLights.push_back(light.getLocalLightData());
         }
     }
 
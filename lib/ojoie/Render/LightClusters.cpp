@@ -0,0 +1,293 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/LightClusters.hpp"
+#include "Threads/ParallelFor.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LIGHT_CLUSTERS_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace AN {
+
+static constexpr UInt32 kEmptySliceRange = 1 << 16;
+
+LightClusters::LightClusters() {
+    setSettings(LightClusterSettings{});
+}
+
+void LightClusters::setSettings(const LightClusterSettings &settings) {
+    m_Settings = settings;
+    m_Settings.tilesX = std::max(m_Settings.tilesX, 1U);
+    m_Settings.tilesY = std::max(m_Settings.tilesY, 1U);
+    m_Settings.slices = std::clamp(m_Settings.slices, 1U, 0xffffU);
+    m_Settings.maxLightsPerCluster = std::clamp<UInt32>(m_Settings.maxLightsPerCluster, 1, kLightClusterMaxLights);
+
+    m_ClusterCount = m_Settings.tilesX * m_Settings.tilesY * m_Settings.slices;
+    m_PaddedTilesX = (m_Settings.tilesX + 3) & ~3U;
+
+    m_SliceMinX.resize(m_Settings.slices * m_PaddedTilesX);
+    m_SliceMaxX.resize(m_Settings.slices * m_PaddedTilesX);
+    m_SliceMinY.resize(m_Settings.slices * m_Settings.tilesY);
+    m_SliceMaxY.resize(m_Settings.slices * m_Settings.tilesY);
+    m_SliceDepth.resize(m_Settings.slices + 1);
+
+    m_ClusterCounts.assign(m_ClusterCount, 0);
+    m_ClusterSlots.resize(m_ClusterCount * m_Settings.maxLightsPerCluster);
+    m_DroppedCounts.assign(m_Settings.slices, 0);
+    m_ClusterGrid.assign(m_ClusterCount, 0);
+    m_LightIndices.clear();
+}
+
+void LightClusters::updateGrid(const LightClusterViewParams &viewParams) {
+    const UInt32 tilesX = m_Settings.tilesX, tilesY = m_Settings.tilesY, slices = m_Settings.slices;
+
+    m_TanY  = std::tan(viewParams.fovyRadians * 0.5f);
+    m_TanX  = m_TanY * viewParams.aspect;
+    m_NearZ = std::max(viewParams.nearZ, 1e-3f);
+    m_FarZ  = std::max(std::min(viewParams.farZ, m_Settings.maxDistance), m_NearZ * 1.01f);
+
+    float logRatio = std::log(m_FarZ / m_NearZ);
+    m_LogScale = (float) slices / logRatio;
+    m_LogBias  = -(float) slices * std::log(m_NearZ) / logRatio;
+
+    for (UInt32 s = 0; s <= slices; ++s) {
+        m_SliceDepth[s] = m_NearZ * std::pow(m_FarZ / m_NearZ, (float) s / (float) slices);
+    }
+    m_SliceDepth[slices] = m_FarZ;
+
+    for (UInt32 s = 0; s < slices; ++s) {
+        float d0 = m_SliceDepth[s], d1 = m_SliceDepth[s + 1];
+
+        /// tile bounds are planes through the eye, the froxel box spans both ends of the slice
+        float *minX = &m_SliceMinX[s * m_PaddedTilesX];
+        float *maxX = &m_SliceMaxX[s * m_PaddedTilesX];
+        for (UInt32 x = 0; x < m_PaddedTilesX; ++x) {
+            if (x >= tilesX) {
+                /// padding lanes never intersect
+                minX[x] = FLT_MAX;
+                maxX[x] = -FLT_MAX;
+                continue;
+            }
+            float n0 = -1.f + 2.f * (float) x / (float) tilesX;
+            float n1 = -1.f + 2.f * (float) (x + 1) / (float) tilesX;
+            minX[x]  = std::min(n0 * d0, n0 * d1) * m_TanX;
+            maxX[x]  = std::max(n1 * d0, n1 * d1) * m_TanX;
+        }
+
+        float *minY = &m_SliceMinY[s * tilesY];
+        float *maxY = &m_SliceMaxY[s * tilesY];
+        for (UInt32 y = 0; y < tilesY; ++y) {
+            float n0 = -1.f + 2.f * (float) y / (float) tilesY;
+            float n1 = -1.f + 2.f * (float) (y + 1) / (float) tilesY;
+            minY[y]  = std::min(n0 * d0, n0 * d1) * m_TanY;
+            maxY[y]  = std::max(n1 * d0, n1 * d1) * m_TanY;
+        }
+    }
+}
+
+UInt32 LightClusters::getSliceIndex(float viewDepth) const {
+    if (viewDepth <= m_NearZ) return 0;
+    int slice = (int) std::floor(std::log(viewDepth) * m_LogScale + m_LogBias);
+    return (UInt32) std::clamp(slice, 0, (int) m_Settings.slices - 1);
+}
+
+bool LightClusters::getClusterIndex(const Vector3f &positionVS, UInt32 &outCluster) const {
+    float depth = -positionVS.z;
+    if (depth < m_NearZ || depth > m_FarZ) return false;
+
+    float nx = positionVS.x / (depth * m_TanX);
+    float ny = positionVS.y / (depth * m_TanY);
+    if (std::abs(nx) > 1.f || std::abs(ny) > 1.f) return false;
+
+    UInt32 x = std::min((UInt32) ((nx * 0.5f + 0.5f) * (float) m_Settings.tilesX), m_Settings.tilesX - 1);
+    UInt32 y = std::min((UInt32) ((ny * 0.5f + 0.5f) * (float) m_Settings.tilesY), m_Settings.tilesY - 1);
+    outCluster = getClusterIndex(x, y, getSliceIndex(depth));
+    return true;
+}
+
+/// bounding sphere of the light volume in world space
+static Vector4f GetLightBoundingSphere(const LocalLightData &light) {
+    float cosAngle = light.spotCosOuter;
+    if (cosAngle <= 0.f) {
+        /// point light or spot wider than a hemisphere
+        return { light.position, light.range };
+    }
+
+    if (cosAngle < 0.70710678f) {
+        /// wider than 45 degrees, the rim circle bounds the cone
+        float sinAngle = std::sqrt(1.f - cosAngle * cosAngle);
+        return { light.position + light.spotDirection * (light.range * cosAngle), light.range * sinAngle };
+    }
+
+    /// the sphere passing the apex and the rim
+    float radius = light.range / (2.f * cosAngle);
+    return { light.position + light.spotDirection * radius, radius };
+}
+
+/// conservative range of tiles covering [center - radius, center + radius] over depth [a, b]
+static bool GetTileRange(float center, float radius, float a, float b, float tanHalf, UInt32 tiles,
+                         UInt32 &outFirst, UInt32 &outLast) {
+    float lo = center - radius, hi = center + radius;
+    float nMin = std::min(lo / (a * tanHalf), lo / (b * tanHalf));
+    float nMax = std::max(hi / (a * tanHalf), hi / (b * tanHalf));
+    if (nMax < -1.f || nMin > 1.f) return false;
+
+    nMin = std::max(nMin, -1.f);
+    nMax = std::min(nMax, 1.f);
+    outFirst = std::min((UInt32) ((nMin * 0.5f + 0.5f) * (float) tiles), tiles - 1);
+    outLast  = std::min((UInt32) ((nMax * 0.5f + 0.5f) * (float) tiles), tiles - 1);
+    return true;
+}
+
+/// bit i is set if the squared distance between centerX and the box [minX[i], maxX[i]] is at most remain
+static int TestTilesX4(const float *minX, const float *maxX, float centerX, float remain) {
+#ifdef LIGHT_CLUSTERS_USE_SSE
+    __m128 center = _mm_set1_ps(centerX);
+    __m128 zero   = _mm_setzero_ps();
+    __m128 dx     = _mm_add_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minX), center), zero),
+                               _mm_max_ps(_mm_sub_ps(center, _mm_loadu_ps(maxX)), zero));
+    return _mm_movemask_ps(_mm_cmple_ps(_mm_mul_ps(dx, dx), _mm_set1_ps(remain)));
+#else
+    int mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        float dx = std::max(minX[i] - centerX, 0.f) + std::max(centerX - maxX[i], 0.f);
+        mask |= (dx * dx <= remain) << i;
+    }
+    return mask;
+#endif
+}
+
+void LightClusters::assignSlice(UInt32 slice) {
+    const UInt32 tilesX = m_Settings.tilesX, tilesY = m_Settings.tilesY;
+    const UInt32 maxPerCluster = m_Settings.maxLightsPerCluster;
+    const UInt32 sliceClusters = tilesX * tilesY;
+
+    UInt32 *counts = &m_ClusterCounts[slice * sliceClusters];
+    UInt32 *slots  = &m_ClusterSlots[slice * sliceClusters * maxPerCluster];
+    std::fill(counts, counts + sliceClusters, 0);
+
+    const float *minX = &m_SliceMinX[slice * m_PaddedTilesX];
+    const float *maxX = &m_SliceMaxX[slice * m_PaddedTilesX];
+    const float *minY = &m_SliceMinY[slice * tilesY];
+    const float *maxY = &m_SliceMaxY[slice * tilesY];
+    const float  d0   = m_SliceDepth[slice], d1 = m_SliceDepth[slice + 1];
+
+    UInt32 dropped = 0;
+    for (UInt32 li = 0; li < m_LightSpheres.size(); ++li) {
+        UInt32 range = m_LightSliceRanges[li];
+        if (slice < (range >> 16) || slice > (range & 0xffff)) continue;
+
+        const Vector4f &sphere = m_LightSpheres[li];
+        float radius2 = sphere.w * sphere.w;
+
+        /// view space z of the slice is [-d1, -d0]
+        float dz = std::max(-d1 - sphere.z, 0.f) + std::max(sphere.z + d0, 0.f);
+        float remainZ = radius2 - dz * dz;
+        if (remainZ < 0.f) continue;
+
+        float a = std::max(d0, -sphere.z - sphere.w);
+        float b = std::min(d1, -sphere.z + sphere.w);
+
+        UInt32 x0, x1, y0, y1;
+        if (!GetTileRange(sphere.x, sphere.w, a, b, m_TanX, tilesX, x0, x1)) continue;
+        if (!GetTileRange(sphere.y, sphere.w, a, b, m_TanY, tilesY, y0, y1)) continue;
+
+        for (UInt32 y = y0; y <= y1; ++y) {
+            float dy = std::max(minY[y] - sphere.y, 0.f) + std::max(sphere.y - maxY[y], 0.f);
+            float remain = remainZ - dy * dy;
+            if (remain < 0.f) continue;
+
+            for (UInt32 x = x0 & ~3U; x <= x1; x += 4) {
+                int mask = TestTilesX4(minX + x, maxX + x, sphere.x, remain);
+                for (; mask; mask &= mask - 1) {
+                    UInt32 tile = x + std::countr_zero((unsigned) mask);
+                    if (tile < x0 || tile > x1) continue;
+
+                    UInt32 cluster = y * tilesX + tile;
+                    if (counts[cluster] < maxPerCluster) {
+                        slots[cluster * maxPerCluster + counts[cluster]++] = li;
+                    } else {
+                        ++dropped;
+                    }
+                }
+            }
+        }
+    }
+
+    m_DroppedCounts[slice] = dropped;
+}
+
+void LightClusters::build(const LightClusterViewParams &viewParams, std::span<const LocalLightData> lights) {
+    updateGrid(viewParams);
+
+    UInt32 lightCount = (UInt32) std::min<size_t>(lights.size(), m_Settings.maxLights);
+    m_LightSpheres.resize(lightCount);
+    m_LightSliceRanges.resize(lightCount);
+
+    for (UInt32 i = 0; i < lightCount; ++i) {
+        Vector4f sphere  = GetLightBoundingSphere(lights[i]);
+        Vector3f centerVS = viewParams.worldToCamera * Vector4f(Vector3f(sphere), 1.f);
+        m_LightSpheres[i] = Vector4f(centerVS, sphere.w);
+
+        float minDepth = -centerVS.z - sphere.w;
+        float maxDepth = -centerVS.z + sphere.w;
+        if (maxDepth < m_NearZ || minDepth > m_FarZ) {
+            m_LightSliceRanges[i] = kEmptySliceRange;
+        } else {
+            /// widen by one slice against rounding, the exact test in assignSlice rejects the extra
+            UInt32 first = getSliceIndex(minDepth), last = getSliceIndex(std::min(maxDepth, m_FarZ));
+            first = first > 0 ? first - 1 : 0;
+            last  = std::min(last + 1, m_Settings.slices - 1);
+            m_LightSliceRanges[i] = first << 16 | last;
+        }
+    }
+
+    /// every slice owns its clusters, so workers never write the same memory
+    ParallelFor(m_Settings.slices, 1, [this](size_t begin, size_t end) {
+        for (size_t slice = begin; slice < end; ++slice) {
+            assignSlice((UInt32) slice);
+        }
+    });
+
+    /// compact the fixed capacity lists
+    UInt32 total = 0;
+    for (UInt32 cluster = 0; cluster < m_ClusterCount; ++cluster) {
+        total += m_ClusterCounts[cluster];
+    }
+    m_LightIndices.resize(total);
+
+    const UInt32 maxPerCluster = m_Settings.maxLightsPerCluster;
+    UInt32 offset = 0;
+    for (UInt32 cluster = 0; cluster < m_ClusterCount; ++cluster) {
+        UInt32 count = m_ClusterCounts[cluster];
+        m_ClusterGrid[cluster] = offset << kLightClusterCountBits | count;
+        std::copy_n(&m_ClusterSlots[cluster * maxPerCluster], count, m_LightIndices.data() + offset);
+        offset += count;
+    }
+}
+
+UInt32 LightClusters::getDroppedLightCount() const {
+    UInt32 dropped = 0;
+    for (UInt32 count : m_DroppedCounts) {
+        dropped += count;
+    }
+    return dropped;
+}
+
+Vector4f LightClusters::getShaderParams0() const {
+    return { (float) m_Settings.tilesX, (float) m_Settings.tilesY, (float) m_Settings.slices, (float) kLightClusterIndexRowWidth };
+}
+
+Vector4f LightClusters::getShaderParams1() const {
+    return { m_TanX, m_TanY, m_LogScale, m_LogBias };
+}
+
+}
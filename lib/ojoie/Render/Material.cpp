@@ -3,6 +3,7 @@
 //
 
 #include "Render/Material.hpp"
+#include "Render/RenderCommandList.hpp"
 #include "Render/RenderContext.hpp"
 #include "Render/Texture.hpp"
 #include "Threads/Dispatch.hpp"
@@ -240,7 +241,8 @@ void RunInRenderQueue(_Func &&func) {
     }
 }
 
-static PropertySheet gPropertySheet;
+static PropertySheet    gPropertySheet;
+static ShaderKeywordSet gKeywordSet;
 
 Material::~Material() {}
 
@@ -256,10 +258,22 @@ bool Material::init(Shader *shader, std::string_view name) {
 bool Material::initAfterDecode()
 {
     if (!Super::initAfterDecode()) return false;
+    _keywordSet.reset();
+    for (const Name &keyword : _keywords) {
+        int index = GetShaderKeywordIndex(keyword);
+        if (index >= 0) _keywordSet.enable(index);
+    }
     setShader(_shader);
     return true;
 }
 
+void Material::getResourceReferences(std::vector<Object *> &references) const {
+    references.push_back(_shader);
+    for (const auto &[name, property] : _propertySheet.getTexEnvsMap()) {
+        references.push_back(property.tex);
+    }
+}
+
 void Material::setShader(Shader *shader) {
     _shader = shader;
     /// setting material default properties value according to shaderLab source
@@ -373,6 +387,39 @@ void Material::SetFloatGlobal(Name name, float value) {
     gPropertySheet.setFloat(name, value);
 }
 
+void Material::EnableKeywordGlobal(Name keyword) {
+    int index = GetShaderKeywordIndex(keyword);
+    if (index >= 0) gKeywordSet.enable(index);
+}
+
+void Material::DisableKeywordGlobal(Name keyword) {
+    int index = GetShaderKeywordIndex(keyword);
+    if (index >= 0) gKeywordSet.disable(index);
+}
+
+bool Material::IsKeywordEnabledGlobal(Name keyword) {
+    int index = GetShaderKeywordIndex(keyword);
+    return index >= 0 && gKeywordSet.isEnabled(index);
+}
+
+void Material::enableKeyword(Name keyword) {
+    int index = GetShaderKeywordIndex(keyword);
+    if (index < 0 || _keywordSet.isEnabled(index)) return;
+    _keywordSet.enable(index);
+    _keywords.push_back(keyword);
+}
+
+void Material::disableKeyword(Name keyword) {
+    int index = GetShaderKeywordIndex(keyword);
+    if (index < 0 || !_keywordSet.isEnabled(index)) return;
+    _keywordSet.disable(index);
+    std::erase(_keywords, keyword);
+}
+
+bool Material::isKeywordEnabled(Name keyword) const {
+    return std::find(_keywords.begin(), _keywords.end(), keyword) != _keywords.end();
+}
+
 static Shader *s_GlobalReplacementShader = nullptr;
 
 void Material::SetReplacementShader(Shader *shader, const char *RenderType) {
@@ -393,6 +440,50 @@ bool Material::hasPass(const char *pass) {
     return passIndex != -1;
 }
 
+/// bytes of a uniform buffer constant
+static UInt32 GetConstantSize(ShaderPropertyType type, int dimension) {
+    if (type == kShaderPropertyMatrix) return sizeof(float) * dimension * dimension;
+    if (type == kShaderPropertyInt) return sizeof(UInt32);
+    return sizeof(float) * dimension;
+}
+
+/// value of a uniform buffer constant in sheet, null if not found or the size does not match
+static const void *FindConstant(const PropertySheet &sheet, Name name, ShaderPropertyType type, int dimension) {
+    if (type == kShaderPropertyInt) {
+        return sheet.findInt(name);
+    }
+    if (type == kShaderPropertyFloat && dimension == 1) {
+        return sheet.findFloat(name);
+    }
+    if (type == kShaderPropertyFloat && dimension == 4) {
+        return sheet.findVector(name);
+    }
+    int count = 0;
+    const float *val = sheet.getValueProp(name, &count);
+    if (val == nullptr) return nullptr;
+    int expected = type == kShaderPropertyMatrix ? dimension * dimension : dimension;
+    return count == expected ? val : nullptr;
+}
+
+static SamplerDescriptor GetDefaultSamplerDescriptor(std::string_view samplerName) {
+    SamplerDescriptor samplerDescriptor = Texture::DefaultSamplerDescriptor();
+    if (samplerName.find("Clamp") != std::string_view::npos) {
+        samplerDescriptor.addressModeU = kSamplerAddressModeClampToEdge;
+        samplerDescriptor.addressModeV = kSamplerAddressModeClampToEdge;
+        samplerDescriptor.addressModeW = kSamplerAddressModeClampToEdge;
+    }
+    if (samplerName.find("Compare") != std::string_view::npos) {
+        samplerDescriptor.compareFunction = kCompareFunctionLess;
+    }
+
+    if (samplerName.find("Trilinear") != std::string_view::npos) {
+        samplerDescriptor.filter = kSamplerFilterTrilinear;
+    } else {
+        samplerDescriptor.filter = kSamplerFilterBilinear;
+    }
+    return samplerDescriptor;
+}
+
 void Material::applyMaterial(AN::CommandBuffer *commandBuffer, const char *pass) {
     Shader *shader = _shader;
     if (s_GlobalReplacementShader) {
@@ -417,21 +508,21 @@ void Material::applyMaterial(AN::CommandBuffer *_commandBuffer, UInt32 pass) {
 
     AN::CommandBuffer *commandBuffer = (AN::CommandBuffer *)_commandBuffer;
 
-    RenderPipelineState &renderPipelineState =
-            shader->getPassRenderPipelineState(pass, 0); /// TODO currently only support subPass 0
-
-    /// set render pipeline state
-    commandBuffer->setRenderPipelineState(renderPipelineState);
-
     /// default use subShader 0
     constexpr int subShader = 0;
 
+    /// TODO currently only support subPass 0
+    const Shader::Variant &variant = shader->getVariant(pass, subShader, _keywordSet | gKeywordSet);
+
+    /// set render pipeline state
+    commandBuffer->setRenderPipelineState(*variant.renderPipelineState);
+
     D3D11::GetUniformBuffers().resetBinds();
-    for (const auto &prop : shader->getProperties(pass, subShader)) {
+    for (const auto &prop : variant.propertyList) {
         switch (prop.propertyType) {
             case kShaderPropertyFloat:
             {
-                const Shader::BindingInfo *bindingInfo = shader->getUniformBufferInfo(pass, subShader, prop.stage, prop.binding, prop.set);
+                const Shader::BindingInfo *bindingInfo = variant.getUniformBufferInfo(prop.stage, prop.binding, prop.set);
                 int idx = D3D11::GetUniformBuffers().findAndBind(bindingInfo->name.getIndex(), bindingInfo->stage, bindingInfo->binding, bindingInfo->size);
                 if (prop.dimension == 1) {
                     const float *val = _propertySheet.findFloat(prop.name);
@@ -463,7 +554,7 @@ void Material::applyMaterial(AN::CommandBuffer *_commandBuffer, UInt32 pass) {
                 break;
             case kShaderPropertyMatrix:
             {
-                const Shader::BindingInfo *bindingInfo = shader->getUniformBufferInfo(pass, subShader, prop.stage, prop.binding, prop.set);
+                const Shader::BindingInfo *bindingInfo = variant.getUniformBufferInfo(prop.stage, prop.binding, prop.set);
                 int idx = D3D11::GetUniformBuffers().findAndBind(bindingInfo->name.getIndex(), bindingInfo->stage, bindingInfo->binding, bindingInfo->size);
 
                 int num;
@@ -478,7 +569,7 @@ void Material::applyMaterial(AN::CommandBuffer *_commandBuffer, UInt32 pass) {
 
             case kShaderPropertyInt:
             {
-                const Shader::BindingInfo *bindingInfo = shader->getUniformBufferInfo(pass, subShader, prop.stage, prop.binding, prop.set);
+                const Shader::BindingInfo *bindingInfo = variant.getUniformBufferInfo(prop.stage, prop.binding, prop.set);
                 int idx = D3D11::GetUniformBuffers().findAndBind(bindingInfo->name.getIndex(), bindingInfo->stage, bindingInfo->binding, bindingInfo->size);
                 const UInt32 *val = _propertySheet.findInt(prop.name);
                 if (!val) {
@@ -520,24 +611,7 @@ void Material::applyMaterial(AN::CommandBuffer *_commandBuffer, UInt32 pass) {
                 }
 
                 if (!texProp) {
-                    SamplerDescriptor samplerDescriptor = Texture::DefaultSamplerDescriptor();
-                    std::string_view samplerName = prop.name.string_view();
-                    if (samplerName.find("Clamp") != std::string_view::npos) {
-                        samplerDescriptor.addressModeU = kSamplerAddressModeClampToEdge;
-                        samplerDescriptor.addressModeV = kSamplerAddressModeClampToEdge;
-                        samplerDescriptor.addressModeW = kSamplerAddressModeClampToEdge;
-                    }
-                    if (samplerName.find("Compare") != std::string_view::npos) {
-                        samplerDescriptor.compareFunction = kCompareFunctionLess;
-                    }
-
-                    if (samplerName.find("Trilinear") != std::string_view::npos) {
-                        samplerDescriptor.filter = kSamplerFilterTrilinear;
-                    } else {
-                        samplerDescriptor.filter = kSamplerFilterBilinear;
-                    }
-
-                    commandBuffer->bindSampler(prop.binding, samplerDescriptor, prop.stage);
+                    commandBuffer->bindSampler(prop.binding, GetDefaultSamplerDescriptor(prop.name.string_view()), prop.stage);
                 } else {
                     auto tex = D3D11::GetTextureManager().getTexture(texProp->texID);
                     commandBuffer->bindSampler(prop.binding, tex->samplerDescriptor, prop.stage);
@@ -556,11 +630,212 @@ void Material::applyMaterial(AN::CommandBuffer *_commandBuffer, UInt32 pass) {
     }
 }
 
+template<typename T>
+static std::span<T> AllocateEncodedArray(RenderCommandList &list, size_t count) {
+    T *data = (T *) list.allocate(sizeof(T) * std::max<size_t>(count, 1), alignof(T));
+    for (size_t i = 0; i < count; ++i) {
+        new (data + i) T();
+    }
+    return { data, count };
+}
+
+const EncodedMaterial *Material::encodeMaterial(RenderCommandList &list, const char *pass, bool bPerDraw) {
+    Shader *shader = _shader;
+    if (s_GlobalReplacementShader) {
+        shader = s_GlobalReplacementShader;
+    }
+    if (shader == nullptr) return nullptr;
+
+    int passIndex = shader->getPassIndex(pass);
+    if (passIndex == -1) {
+        passIndex = 0;
+    }
+
+    /// default use subShader 0, variants are only compiled on the render thread
+    const Shader::Variant *variant = shader->findVariant(passIndex, 0, _keywordSet | gKeywordSet);
+    if (variant == nullptr || variant->renderPipelineState == nullptr) return nullptr;
+
+    const ShaderPropertyList &properties = variant->propertyList;
+
+    EncodedMaterial *encoded = AllocateEncodedArray<EncodedMaterial>(list, 1).data();
+    encoded->material      = this;
+    encoded->pass          = pass;
+    encoded->bPerDraw      = bPerDraw;
+    encoded->pipelineState = variant->renderPipelineState;
+
+    /// sized for the worst case, the spans are shrunk to what is used below
+    std::span<EncodedUniformBuffer> buffers   = AllocateEncodedArray<EncodedUniformBuffer>(list, variant->bindingInfos.size());
+    std::span<EncodedConstant>      constants = AllocateEncodedArray<EncodedConstant>(list, properties.size());
+    std::span<EncodedTexture>       textures  = AllocateEncodedArray<EncodedTexture>(list, properties.size());
+    std::span<EncodedSampler>       samplers  = AllocateEncodedArray<EncodedSampler>(list, properties.size());
+    std::vector<const Shader::BindingInfo *> bufferInfos;
+    size_t constantCount = 0, textureCount = 0, samplerCount = 0;
+
+    for (const auto &prop : properties) {
+        switch (prop.propertyType) {
+            case kShaderPropertyFloat:
+            case kShaderPropertyMatrix:
+            case kShaderPropertyInt:
+            {
+                const Shader::BindingInfo *bindingInfo = variant->getUniformBufferInfo(prop.stage, prop.binding, prop.set);
+                if (bindingInfo == nullptr) continue;
+
+                auto it = std::find(bufferInfos.begin(), bufferInfos.end(), bindingInfo);
+                if (it == bufferInfos.end()) {
+                    EncodedUniformBuffer &buffer = buffers[bufferInfos.size()];
+                    buffer.id      = bindingInfo->name.getIndex();
+                    buffer.size    = bindingInfo->size;
+                    buffer.binding = bindingInfo->binding;
+                    buffer.stage   = bindingInfo->stage;
+                    it = bufferInfos.insert(bufferInfos.end(), bindingInfo);
+                }
+
+                EncodedConstant &constant = constants[constantCount++];
+                constant.type      = prop.propertyType;
+                constant.buffer    = (UInt16) (it - bufferInfos.begin());
+                constant.dimension = prop.dimension;
+                constant.offset    = prop.offset;
+                constant.size      = GetConstantSize(prop.propertyType, prop.dimension);
+                constant.name      = prop.name;
+                constant.source    = EncodedConstant::kSourceGlobal;
+
+                if (bPerDraw) {
+                    const PerDrawProperty *perDraw = nullptr;
+                    for (const PerDrawProperty &property : GetPerDrawProperties()) {
+                        if (property.name == prop.name && property.size == constant.size) {
+                            perDraw = &property;
+                            break;
+                        }
+                    }
+                    if (perDraw) {
+                        constant.source        = EncodedConstant::kSourcePerDraw;
+                        constant.perDrawOffset = perDraw->offset;
+                        continue;
+                    }
+                }
+
+                /// material values are copied, the sheet may be written again before the list is replayed
+                if (const void *value = FindConstant(_propertySheet, prop.name, prop.propertyType, prop.dimension)) {
+                    void *data = list.allocate(constant.size, alignof(float));
+                    memcpy(data, value, constant.size);
+                    constant.source = EncodedConstant::kSourceMaterial;
+                    constant.data   = data;
+                }
+            }
+                break;
+            case kShaderPropertyBool:
+            case kShaderPropertyStruct:
+                /// we are ignoring struct
+                break;
+            case kShaderPropertyTexture:
+            {
+                EncodedTexture &texture = textures[textureCount++];
+                texture.name    = prop.name;
+                texture.binding = prop.binding;
+                texture.stage   = prop.stage;
+
+                PropertySheet::TextureProperty *texProp = _propertySheet.getTextureProperty(prop.name);
+                if (texProp) {
+                    texture.texID   = texProp->texID;
+                    texture.bGlobal = false;
+                } else {
+                    texture.texID   = D3D11::GetTextureManager().getTexture("white")->getTextureID();
+                    texture.bGlobal = true;
+                }
+            }
+                break;
+            case kShaderPropertySampler:
+            {
+                EncodedSampler &sampler = samplers[samplerCount++];
+                sampler.name    = prop.name;
+                sampler.binding = prop.binding;
+                sampler.stage   = prop.stage;
+
+                /// sampler name is sampler##tex
+                std::string_view texName = prop.name.string_view();
+                texName.remove_prefix(7);
+                PropertySheet::TextureProperty *texProp = _propertySheet.getTextureProperty(texName);
+                if (texProp) {
+                    sampler.descriptor = D3D11::GetTextureManager().getTexture(texProp->texID)->samplerDescriptor;
+                    sampler.bGlobal    = false;
+                } else {
+                    sampler.descriptor = GetDefaultSamplerDescriptor(prop.name.string_view());
+                    sampler.bGlobal    = true;
+                }
+            }
+                break;
+            default:
+                ANAssert(false && "invalid property type");
+        }
+    }
+
+    encoded->buffers   = buffers.first(bufferInfos.size());
+    encoded->constants = constants.first(constantCount);
+    encoded->textures  = textures.first(textureCount);
+    encoded->samplers  = samplers.first(samplerCount);
+    return encoded;
+}
+
+void Material::ApplyEncodedMaterial(AN::CommandBuffer *commandBuffer, const EncodedMaterial &encoded, const PerDrawData *perDraw) {
+    commandBuffer->setRenderPipelineState(*encoded.pipelineState);
+
+    D3D11::UniformBuffers &uniformBuffers = D3D11::GetUniformBuffers();
+    uniformBuffers.resetBinds();
+
+    /// a variant binds a few uniform buffers per stage
+    int bufferIndices[32];
+    ANAssert(encoded.buffers.size() <= std::size(bufferIndices));
+    for (size_t i = 0; i < encoded.buffers.size(); ++i) {
+        const EncodedUniformBuffer &buffer = encoded.buffers[i];
+        bufferIndices[i] = uniformBuffers.findAndBind(buffer.id, buffer.stage, buffer.binding, buffer.size);
+    }
+
+    for (const EncodedConstant &constant : encoded.constants) {
+        const void *data;
+        switch (constant.source) {
+            case EncodedConstant::kSourceMaterial:
+                data = constant.data;
+                break;
+            case EncodedConstant::kSourcePerDraw:
+                data = (const UInt8 *) perDraw + constant.perDrawOffset;
+                break;
+            default:
+                data = FindConstant(gPropertySheet, constant.name, constant.type, constant.dimension);
+                break;
+        }
+        if (data) {
+            uniformBuffers.setConstant(bufferIndices[constant.buffer], constant.offset, data, constant.size);
+        }
+    }
+
+    for (const EncodedTexture &texture : encoded.textures) {
+        TextureID texID = texture.texID;
+        if (texture.bGlobal) {
+            PropertySheet::TextureProperty *texProp = gPropertySheet.getTextureProperty(texture.name);
+            if (texProp) texID = texProp->texID;
+        }
+        commandBuffer->bindTexture(texture.binding, texID, texture.stage);
+    }
+
+    for (const EncodedSampler &sampler : encoded.samplers) {
+        if (sampler.bGlobal) {
+            PropertySheet::TextureProperty *texProp = gPropertySheet.getTextureProperty(sampler.name);
+            if (texProp) {
+                auto tex = D3D11::GetTextureManager().getTexture(texProp->texID);
+                commandBuffer->bindSampler(sampler.binding, tex->samplerDescriptor, sampler.stage);
+                continue;
+            }
+        }
+        commandBuffer->bindSampler(sampler.binding, sampler.descriptor, sampler.stage);
+    }
+}
+
 template<typename _Coder>
 void Material::transfer(_Coder &coder) {
     Super::transfer(coder);
     TRANSFER(_shader);
     TRANSFER(_propertySheet);
+    TRANSFER(_keywords);
 }
 
 #ifdef OJOIE_WITH_EDITOR
@@ -684,6 +959,29 @@ void Material::onInspectorGUI() {
         }
         ImGui::PopID();
     }
+
+    /// keywords declared by the passes of the first subShader
+    std::vector<Name> declaredKeywords;
+    for (UInt32 pass = 0; _shader->getSubShaderNum() > 0 && pass < _shader->getPassNum(0); ++pass) {
+        const ShaderKeywordSpace &keywordSpace = _shader->getKeywordSpace(pass, 0);
+        for (UInt32 bit = 0; bit < keywordSpace.getKeywordCount(); ++bit) {
+            const Name &keyword = keywordSpace.getKeyword(bit);
+            if (std::find(declaredKeywords.begin(), declaredKeywords.end(), keyword) == declaredKeywords.end()) {
+                declaredKeywords.push_back(keyword);
+            }
+        }
+    }
+
+    if (!declaredKeywords.empty()) {
+        ImGui::Separator();
+        ImGui::Text("Keywords");
+        for (const Name &keyword : declaredKeywords) {
+            bool bEnabled = isKeywordEnabled(keyword);
+            if (ImGui::Checkbox(keyword.c_str(), &bEnabled)) {
+                bEnabled ? enableKeyword(keyword) : disableKeyword(keyword);
+            }
+        }
+    }
 }
 #endif//OJOIE_WITH_EDITOR
 
@@ -2,7 +2,10 @@
 // Created by Aleudillonam on 8/7/2022.
 //
 #include "Render/Mesh/Mesh.hpp"
+#include "Geometry/MeshProcessing.hpp"
 #include "Render/Renderer.hpp"
+#include "Misc/ResourceManager.hpp"
+#include "Serialize/SerializedAsset.h"
 #include "Threads/Dispatch.hpp"
 #include <intrin.h>
 
@@ -11,7 +14,18 @@ namespace AN {
 IMPLEMENT_AN_CLASS(Mesh);
 LOAD_AN_CLASS(Mesh);
 
-Mesh::Mesh(AN::ObjectCreationMode mode) : Super(mode) {}
+Mesh::Mesh(AN::ObjectCreationMode mode)
+    : Super(mode),
+      m_IndexFormat(kIndexFormatUInt16),
+      m_VertexCompression(),
+      m_ChannelsLayout(VertexData::kVertexChannelsDefault),
+      m_BoneWeightsCompressed(),
+      m_UVDistributionMetric(),
+      m_UVDistributionMetricDirty(),
+      m_IsReadable(true),
+      m_CPUDataReleased(),
+      m_GPUMemorySize(),
+      m_KeepCollisionData() {}
 Mesh::~Mesh() {
     /// default has 1 subMesh
     _subMeshes.resize(1);
@@ -24,7 +38,9 @@ bool Mesh::init() {
 
 bool Mesh::initAfterDecode() {
     if (!Super::initAfterDecode()) return false;
+    m_ChannelsLayout = VertexData::GetCompressedChannelsLayout(m_VertexCompression);
     if (_vertexBuffer.init()) {
+        recalculateBounds();
         createVertexBuffer();
         return true;
     }
@@ -36,12 +52,29 @@ void Mesh::dealloc() {
     _vertexData.dealloc();
     _vertexBuffer.deinit();
     _indexBuffer.clear();
+    _indexBuffer32.clear();
     _subMeshes.clear();
+    m_BoneWeights.clear();
+    m_PackedBoneWeights.clear();
+    m_CollisionVertices.clear();
+    m_CollisionIndices.clear();
+    m_GPUMemorySize = 0;
     Super::dealloc();
 }
 
+bool Mesh::checkCPUData(const char *operation) const {
+    if (m_CPUDataReleased) {
+        AN_LOG(Error, "Not allowed to %s on mesh '%s', it is not readable and its cpu data was released",
+               operation, getName().c_str());
+        return false;
+    }
+    return true;
+}
+
 
 void Mesh::createVertexBuffer() {
+    if (m_CPUDataReleased) return;
+
     VertexBufferData vertexBuffer;
 
     for (int i = 0; i < kShaderChannelCount; i++)
@@ -55,12 +88,89 @@ void Mesh::createVertexBuffer() {
     vertexBuffer.vertexCount = getVertexCount();
 
 
-    IndexBufferData indexBuffer;
-    indexBuffer.indices = _indexBuffer.data();
-    indexBuffer.count   = _indexBuffer.size();
+    IndexBufferData indexBuffer = getIndexBufferData();
 
     _vertexBuffer.updateVertexData(vertexBuffer);
     _vertexBuffer.updateIndexData(indexBuffer);
+
+    m_GPUMemorySize = vertexBuffer.bufferSize + CalculateIndexBufferSize(indexBuffer);
+
+    /// destroy cpu data if is not readable
+    if (!m_IsReadable) {
+        /// the metric needs the data, settle it before
+        getUVDistributionMetric();
+        releaseCPUData();
+    }
+}
+
+void Mesh::releaseCPUData() {
+    if (m_CPUDataReleased) return;
+
+    if (m_KeepCollisionData && isAvailable(kShaderChannelVertex)) {
+        m_CollisionVertices.resize(getVertexCount());
+        extractVertices(m_CollisionVertices.data());
+        m_CollisionIndices.resize(getIndicesCount());
+        for (UInt32 i = 0; i < m_CollisionIndices.size(); ++i) {
+            m_CollisionIndices[i] = getIndex(i);
+        }
+    }
+
+    /// vertex count, channels and sub meshes stay so draws still know the layout
+    _vertexData.dealloc();
+    _indexBuffer.clear();
+    _indexBuffer.shrink_to_fit();
+    _indexBuffer32.clear();
+    _indexBuffer32.shrink_to_fit();
+    m_BoneWeights.clear();
+    m_BoneWeights.shrink_to_fit();
+    m_PackedBoneWeights.clear();
+    m_PackedBoneWeights.shrink_to_fit();
+    m_CPUDataReleased = true;
+}
+
+bool Mesh::reloadFromAsset() {
+    if (!m_CPUDataReleased) return true;
+
+    std::string path = GetResourceManager().getResourcePath(this);
+    if (path.empty()) {
+        AN_LOG(Error, "Failed reloading mesh '%s', it was not loaded from an asset", getName().c_str());
+        return false;
+    }
+
+    /// only the document of this mesh is decoded, other objects of the asset are left untouched
+    m_CPUDataReleased = false;
+    SerializedAsset serializedAsset;
+    if (!serializedAsset.LoadObjectAtPath(path.c_str(), this)) {
+        AN_LOG(Error, "Failed reloading mesh '%s' from %s", getName().c_str(), path.c_str());
+        m_CPUDataReleased = true;
+        return false;
+    }
+    m_ChannelsLayout = VertexData::GetCompressedChannelsLayout(m_VertexCompression);
+    return true;
+}
+
+UInt64 Mesh::getCPUMemorySize() const {
+    UInt64 size = _vertexData.getDataPtr() ? _vertexData.getDataSize() : 0;
+    size += _indexBuffer.capacity() * sizeof(UInt16) + _indexBuffer32.capacity() * sizeof(UInt32);
+    size += m_BoneWeights.capacity() * sizeof(BoneWeight) + m_PackedBoneWeights.capacity() * sizeof(PackedBoneWeight);
+    size += m_Bindposes.capacity() * sizeof(Matrix4x4f) + _subMeshes.capacity() * sizeof(SubMesh);
+    size += m_CollisionVertices.capacity() * sizeof(Vector3f) + m_CollisionIndices.capacity() * sizeof(UInt32);
+    return size;
+}
+
+size_t Mesh::getRuntimeMemorySize() const {
+    return Super::getRuntimeMemorySize() + getCPUMemorySize() + getGPUMemorySize();
+}
+
+MeshMemoryReport GetMeshMemoryReport() {
+    MeshMemoryReport report{};
+    for (Mesh *mesh : Object::FindObjectsOfType<Mesh>()) {
+        ++report.meshCount;
+        if (mesh->hasCPUData()) ++report.readableCount;
+        report.cpuBytes += mesh->getCPUMemorySize();
+        report.gpuBytes += mesh->getGPUMemorySize();
+    }
+    return report;
 }
 
 const VertexStreamsLayout &Mesh::getStreamsLayout() const {
@@ -68,14 +178,33 @@ const VertexStreamsLayout &Mesh::getStreamsLayout() const {
 }
 
 const VertexChannelsLayout &Mesh::getChannelsLayout() const {
-    return VertexData::kVertexChannelsDefault;
+    return m_ChannelsLayout;
 }
 
 UInt32 Mesh::formatVertices(UInt32 shaderChannels) {
     return resizeVertices(getVertexCount(), shaderChannels);
 }
 
+static void ZeroChannel(VertexData &vertexData, ShaderChannel channel, unsigned begin, unsigned count) {
+    const ChannelInfo &info   = vertexData.getChannel(channel);
+    size_t             size   = GetChannelFormatSize(info.format) * info.dimension;
+    size_t             stride = vertexData.getChannelStride(channel);
+    UInt8             *ptr    = vertexData.getDataPtr() + vertexData.getChannelOffset(channel) + begin * stride;
+    for (unsigned i = 0; i < count; ++i, ptr += stride) {
+        memset(ptr, 0, size);
+    }
+}
+
 void Mesh::initChannelsToDefault(unsigned begin, unsigned count, unsigned shaderChannels) {
+    /// compressed channels can not use the float iterators, zero is a valid value of every format
+    unsigned compressedChannels = shaderChannels & m_VertexCompression;
+    for (int i = 0; i < kShaderChannelCount; ++i) {
+        if (compressedChannels & (1 << i)) {
+            ZeroChannel(_vertexData, (ShaderChannel) i, begin, count);
+        }
+    }
+    shaderChannels &= ~compressedChannels;
+
     if (shaderChannels & VERTEX_FORMAT1(Vertex))
         std::fill(getVertexBegin() + begin, getVertexBegin() + begin + count, Vector3f(0, 0, 0));
     if (shaderChannels & VERTEX_FORMAT1(Normal))
@@ -88,7 +217,7 @@ void Mesh::initChannelsToDefault(unsigned begin, unsigned count, unsigned shader
         std::fill(getTangentBegin() + begin, getTangentBegin() + begin + count, Vector4f(0, 0, 0, 0));
 
     if (shaderChannels & VERTEX_FORMAT1(TexCoord1)) {
-        if (getAvailableChannels() & VERTEX_FORMAT1(TexCoord0))
+        if ((getAvailableChannels() & VERTEX_FORMAT1(TexCoord0)) && !(m_VertexCompression & VERTEX_FORMAT1(TexCoord0)))
             std::copy(getUvBegin(0) + begin, getUvBegin(0) + begin + count, getUvBegin(1) + begin);
         else
             std::fill(getUvBegin(1) + begin, getUvBegin(1) + begin + count, Vector2f(0, 0));
@@ -99,7 +228,8 @@ void Mesh::initChannelsToDefault(unsigned begin, unsigned count, unsigned shader
 UInt32 Mesh::resizeVertices(size_t count, UInt32 shaderChannels,
                             const VertexStreamsLayout  &streams,
                             const VertexChannelsLayout &channels) {
-    ANAssert(count <= std::numeric_limits<UInt16>::max());
+    if (!checkCPUData("resize vertices")) return 0;
+    ANAssert(count <= GetIndexFormatMaxVertexCount(m_IndexFormat));
 
     UInt32 prevChannels = _vertexData.getChannelMask();
 
@@ -116,19 +246,25 @@ UInt32 Mesh::resizeVertices(size_t count, UInt32 shaderChannels,
 void Mesh::setSubMeshCount(unsigned int count) {
     if (count == 0) {
         _indexBuffer.clear();
+        _indexBuffer32.clear();
         _subMeshes.clear();
         return;
     }
 
     if (count < _subMeshes.size()) {
-        _indexBuffer.resize(_subMeshes[count].indexOffset);
+        if (m_IndexFormat == kIndexFormatUInt32) {
+            _indexBuffer32.resize(_subMeshes[count].indexOffset);
+        } else {
+            _indexBuffer.resize(_subMeshes[count].indexOffset);
+        }
     }
     _subMeshes.resize(count);
 }
 
 void Mesh::setVertices(const Vector3f *data, size_t count) {
-    if (count > std::numeric_limits<UInt16>::max()) {
-        AN_LOG(Error, "Mesh.vertices is too large. A mesh may not have more than 65000 vertices.");
+    if (!checkCPUData("set vertices")) return;
+    if (count > GetIndexFormatMaxVertexCount(m_IndexFormat)) {
+        AN_LOG(Error, "Mesh.vertices is too large. A mesh with 16 bit indices may not have more than 65536 vertices, use kIndexFormatUInt32.");
         return;
     }
     size_t prevCount = getVertexCount();
@@ -148,15 +284,117 @@ void Mesh::setVertices(const Vector3f *data, size_t count) {
     if (getVertexCount() < count)
         count = getVertexCount();
 
-    strided_copy(data, data + count, getVertexBegin());
+    if (_vertexData.isChannelCompressed(kShaderChannelVertex)) {
+        /// quantize into the bounds of the new positions
+        AABB aabb = AABB::Empty();
+        for (size_t i = 0; i < count; ++i) {
+            aabb.encapsulate(data[i]);
+        }
+        if (!aabb.isEmpty()) {
+            _vertexData.setPositionQuantization(aabb.getMax() - aabb.getMin(), aabb.getMin());
+        }
+        _vertexData.writeChannel(kShaderChannelVertex, &data->x, 3);
+    } else {
+        strided_copy(data, data + count, getVertexBegin());
+    }
     //    SetChannelsDirty(VERTEX_FORMAT1(Vertex), false);
 
+    m_UVDistributionMetricDirty = true;
+
     // We do not recalc the bounds automatically when re-writing existing vertices
-    //    if (prevCount != count)
-    //        recalculateBounds();
+    if (prevCount != count)
+        recalculateBounds();
+}
+
+/// float view of a channel for the mesh processing kernels, compressed channels are decoded into storage
+template<typename T>
+static StrideIterator<T> GetFloatChannel(const VertexData &vertexData, ShaderChannel channel, std::vector<T> &storage) {
+    if (!vertexData.isChannelCompressed(channel)) return vertexData.MakeStrideIterator<T>(channel);
+    storage.resize(vertexData.getVertexCount());
+    vertexData.extractChannel(channel, (float *) storage.data(), sizeof(T) / sizeof(float));
+    return StrideIterator<T>(storage.data(), sizeof(T));
+}
+
+void Mesh::recalculateBounds() {
+    /// bounds of a released mesh were computed before the release
+    if (m_CPUDataReleased) return;
+    m_UVDistributionMetricDirty = true;
+    if (!isAvailable(kShaderChannelVertex)) {
+        m_LocalAABB = AABB();
+        return;
+    }
+    std::vector<Vector3f> vertices;
+    StrideIterator<Vector3f> vertexBegin = GetFloatChannel(_vertexData, kShaderChannelVertex, vertices);
+    AABB aabb = CalculateBounds(vertexBegin, getVertexCount());
+    m_LocalAABB = aabb.isEmpty() ? AABB() : aabb;
+}
+
+float Mesh::getUVDistributionMetric() const {
+    /// a released mesh keeps the metric computed before the release
+    if (!m_UVDistributionMetricDirty || m_CPUDataReleased) return m_UVDistributionMetric;
+    m_UVDistributionMetricDirty = false;
+
+    m_UVDistributionMetric = 0.f;
+    if (isAvailable(kShaderChannelVertex) && isAvailable(kShaderChannelTexCoord0)) {
+        std::vector<Vector3f> vertices;
+        std::vector<Vector2f> uvs;
+        m_UVDistributionMetric = CalculateUVDistributionMetric(GetFloatChannel(_vertexData, kShaderChannelVertex, vertices),
+                                                               GetFloatChannel(_vertexData, kShaderChannelTexCoord0, uvs),
+                                                               getIndexBufferData());
+    }
+    return m_UVDistributionMetric;
+}
+
+void Mesh::recalculateNormals(float smoothingAngle) {
+    if (!checkCPUData("recalculate normals")) return;
+    if (!isAvailable(kShaderChannelVertex)) return;
+    if (!isAvailable(kShaderChannelNormal))
+        formatVertices(getAvailableChannels() | VERTEX_FORMAT1(Normal));
+
+    std::vector<Vector3f> vertices, normals;
+    StrideIterator<Vector3f> vertexBegin = GetFloatChannel(_vertexData, kShaderChannelVertex, vertices);
+
+    if (_vertexData.isChannelCompressed(kShaderChannelNormal)) {
+        normals.resize(getVertexCount());
+        CalculateNormals(vertexBegin, getVertexCount(), getIndexBufferData(),
+                         StrideIterator<Vector3f>(normals.data(), sizeof(Vector3f)), smoothingAngle);
+        _vertexData.writeChannel(kShaderChannelNormal, (const float *) normals.data(), 3);
+    } else {
+        CalculateNormals(vertexBegin, getVertexCount(), getIndexBufferData(), getNormalBegin(), smoothingAngle);
+    }
+}
+
+void Mesh::recalculateTangents() {
+    if (!checkCPUData("recalculate tangents")) return;
+    if (!isAvailable(kShaderChannelVertex)) return;
+    if (!isAvailable(kShaderChannelTexCoord0)) {
+        AN_LOG(Error, "Failed recalculating tangents. The mesh has no uv.");
+        return;
+    }
+    if (!isAvailable(kShaderChannelNormal))
+        recalculateNormals();
+    if (!isAvailable(kShaderChannelTangent))
+        formatVertices(getAvailableChannels() | VERTEX_FORMAT1(Tangent));
+
+    std::vector<Vector3f> vertices, normals;
+    std::vector<Vector2f> uvs;
+    std::vector<Vector4f> tangents;
+    StrideIterator<Vector3f> vertexBegin = GetFloatChannel(_vertexData, kShaderChannelVertex, vertices);
+    StrideIterator<Vector3f> normalBegin = GetFloatChannel(_vertexData, kShaderChannelNormal, normals);
+    StrideIterator<Vector2f> uvBegin     = GetFloatChannel(_vertexData, kShaderChannelTexCoord0, uvs);
+
+    if (_vertexData.isChannelCompressed(kShaderChannelTangent)) {
+        tangents.resize(getVertexCount());
+        CalculateTangents(vertexBegin, normalBegin, uvBegin, getVertexCount(), getIndexBufferData(),
+                          StrideIterator<Vector4f>(tangents.data(), sizeof(Vector4f)));
+        _vertexData.writeChannel(kShaderChannelTangent, (const float *) tangents.data(), 4);
+    } else {
+        CalculateTangents(vertexBegin, normalBegin, uvBegin, getVertexCount(), getIndexBufferData(), getTangentBegin());
+    }
 }
 
 void Mesh::setNormals(const Vector3f *data, size_t count) {
+    if (!checkCPUData("set normals")) return;
     if (count == 0 || !data) {
         formatVertices(getAvailableChannels() & ~VERTEX_FORMAT1(Normal));
         //        SetChannelsDirty (VERTEX_FORMAT1(Normal), false);
@@ -171,12 +409,17 @@ void Mesh::setNormals(const Vector3f *data, size_t count) {
     if (!isAvailable(kShaderChannelNormal))
         formatVertices(getAvailableChannels() | VERTEX_FORMAT1(Normal));
 
-    strided_copy(data, data + count, getNormalBegin());
+    if (_vertexData.isChannelCompressed(kShaderChannelNormal)) {
+        _vertexData.writeChannel(kShaderChannelNormal, &data->x, 3);
+    } else {
+        strided_copy(data, data + count, getNormalBegin());
+    }
 
     //    SetChannelsDirty (VERTEX_FORMAT1(Normal), false);
 }
 
 void Mesh::setTangents(const Vector4f *data, size_t count) {
+    if (!checkCPUData("set tangents")) return;
     if (count == 0 || !data) {
         formatVertices(getAvailableChannels() & ~VERTEX_FORMAT1(Tangent));
         //        SetChannelsDirty (VERTEX_FORMAT1(Tangent), false);
@@ -191,13 +434,22 @@ void Mesh::setTangents(const Vector4f *data, size_t count) {
     if (!isAvailable(kShaderChannelTangent))
         formatVertices(getAvailableChannels() | VERTEX_FORMAT1(Tangent));
 
-    strided_copy(data, data + count, getTangentBegin());
+    if (_vertexData.isChannelCompressed(kShaderChannelTangent)) {
+        _vertexData.writeChannel(kShaderChannelTangent, &data->x, 4);
+    } else {
+        strided_copy(data, data + count, getTangentBegin());
+    }
     //    SetChannelsDirty( VERTEX_FORMAT1(Tangent), false );
 }
 
 void Mesh::setUV(int uvIndex, const Vector2f *data, size_t count) {
+    if (!checkCPUData("set uv")) return;
     ShaderChannel texCoordChannel = static_cast<ShaderChannel>(kShaderChannelTexCoord0 + uvIndex);
     unsigned      texCoordMask    = 1 << texCoordChannel;
+    if (uvIndex == 0) {
+        m_UVDistributionMetricDirty = true;
+    }
+
     if (count == 0 || !data) {
         formatVertices(getAvailableChannels() & ~texCoordMask);
         //        SetChannelsDirty (texCoordMask, false);
@@ -213,7 +465,11 @@ void Mesh::setUV(int uvIndex, const Vector2f *data, size_t count) {
     if (!isAvailable(texCoordChannel))
         formatVertices(getAvailableChannels() | texCoordMask);
 
-    strided_copy(data, data + count, getUvBegin(uvIndex));
+    if (_vertexData.isChannelCompressed(texCoordChannel)) {
+        _vertexData.writeChannel(texCoordChannel, &data->x, 2);
+    } else {
+        strided_copy(data, data + count, getUvBegin(uvIndex));
+    }
     //    SetChannelsDirty (texCoordMask, false);
 }
 
@@ -223,67 +479,251 @@ void Mesh::setBindposes(const Matrix4x4f *data, size_t count)
     memcpy(m_Bindposes.data(), data, sizeof(Matrix4x4f) * count);
 }
 
+static PackedBoneWeight PackBoneWeight(const BoneWeight &boneWeight) {
+    PackedBoneWeight packed;
+    float sum = boneWeight.weights[0] + boneWeight.weights[1] + boneWeight.weights[2] + boneWeight.weights[3];
+    int   total = 0, largest = 0;
+    for (int i = 0; i < 4; ++i) {
+        float weight = sum > 0.f ? boneWeight.weights[i] / sum : (i == 0 ? 1.f : 0.f);
+        packed.boneIndices[i] = (UInt16) std::clamp(boneWeight.boneIndices[i], 0, (int) std::numeric_limits<UInt16>::max());
+        packed.weights[i]     = (UInt8) std::lround(std::clamp(weight, 0.f, 1.f) * 255.f);
+        total += packed.weights[i];
+        if (boneWeight.weights[i] > boneWeight.weights[largest]) largest = i;
+    }
+    /// rounding error goes to the largest weight so that the weights still sum to 1
+    packed.weights[largest] = (UInt8) std::clamp(packed.weights[largest] + 255 - total, 0, 255);
+    return packed;
+}
+
+static BoneWeight UnpackBoneWeight(const PackedBoneWeight &packed) {
+    BoneWeight boneWeight;
+    for (int i = 0; i < 4; ++i) {
+        boneWeight.boneIndices[i] = packed.boneIndices[i];
+        boneWeight.weights[i]     = packed.weights[i] / 255.f;
+    }
+    return boneWeight;
+}
+
 void Mesh::setBoneWeights(const BoneWeight *data, size_t count)
 {
-    m_BoneWeights.resize(getVertexCount());
-
-    if (count != m_BoneWeights.size())
+    if (!checkCPUData("set bone weights")) return;
+    size_t vertexCount = getVertexCount();
+    if (count != vertexCount)
     {
         AN_LOG(Warning, "bindWeights size is not equal to vertices size");
     }
+    count = std::min(vertexCount, count);
 
-    memcpy(m_BoneWeights.data(), data, sizeof(BoneWeight) * std::min(m_BoneWeights.size(), count));
+    if (m_BoneWeightsCompressed) {
+        m_PackedBoneWeights.resize(vertexCount);
+        std::transform(data, data + count, m_PackedBoneWeights.begin(), PackBoneWeight);
+        return;
+    }
+
+    m_BoneWeights.resize(vertexCount);
+    memcpy(m_BoneWeights.data(), data, sizeof(BoneWeight) * count);
 }
 
-bool Mesh::setIndices(const UInt16 *indices, unsigned int count, unsigned int submesh) {
-    if (indices == NULL && count != 0) {
-        ANAssert("failed setting indices. indices is NULL");
-        return false;
+void Mesh::setBoneWeightsCompressed(bool compressed) {
+    if (compressed == m_BoneWeightsCompressed || !checkCPUData("compress bone weights")) return;
+
+    if (compressed) {
+        m_PackedBoneWeights.resize(m_BoneWeights.size());
+        std::transform(m_BoneWeights.begin(), m_BoneWeights.end(), m_PackedBoneWeights.begin(), PackBoneWeight);
+        m_BoneWeights.clear();
+        m_BoneWeights.shrink_to_fit();
+    } else {
+        m_BoneWeights.resize(m_PackedBoneWeights.size());
+        std::transform(m_PackedBoneWeights.begin(), m_PackedBoneWeights.end(), m_BoneWeights.begin(), UnpackBoneWeight);
+        m_PackedBoneWeights.clear();
+        m_PackedBoneWeights.shrink_to_fit();
     }
+    m_BoneWeightsCompressed = compressed;
+}
 
-    if (submesh >= getSubMeshCount()) {
-        AN_LOG(Error, "Failed setting triangles. Submesh index is out of bounds.");
-        return false;
+BoneWeight Mesh::getBoneWeight(UInt32 index) const {
+    return m_BoneWeightsCompressed ? UnpackBoneWeight(m_PackedBoneWeights[index]) : m_BoneWeights[index];
+}
+
+void Mesh::setVertexCompression(UInt32 compressedChannels) {
+    compressedChannels &= kMeshCompressibleChannels;
+    if (compressedChannels == m_VertexCompression || !checkCPUData("set vertex compression")) return;
+
+    if ((compressedChannels & ~m_VertexCompression) & VERTEX_FORMAT1(Vertex)) {
+        /// quantize into the bounds of the float positions
+        recalculateBounds();
+        _vertexData.setPositionQuantization(m_LocalAABB.getMax() - m_LocalAABB.getMin(), m_LocalAABB.getMin());
+    }
+
+    m_VertexCompression = compressedChannels;
+    m_ChannelsLayout    = VertexData::GetCompressedChannelsLayout(compressedChannels);
+
+    /// resize converts the existing data to the new layout
+    if (getVertexCount() > 0) {
+        resizeVertices(getVertexCount(), getAvailableChannels());
     }
+}
 
+VertexCompressionData Mesh::getVertexCompressionData() const {
+    VertexCompressionData data;
+    data.compression    = Vector4f(_vertexData.isChannelCompressed(kShaderChannelVertex) ? 1.f : 0.f,
+                                   _vertexData.isChannelCompressed(kShaderChannelNormal) ? 1.f : 0.f,
+                                   _vertexData.isChannelCompressed(kShaderChannelTangent) ? 1.f : 0.f,
+                                   0.f);
+    data.positionScale  = Vector4f(_vertexData.getPositionScale(), 0.f);
+    data.positionOffset = Vector4f(_vertexData.getPositionOffset(), 0.f);
+    return data;
+}
+
+void Mesh::extractVertices(Vector3f *dst) const {
+    if (!checkCPUData("extract vertices")) return;
+    _vertexData.extractChannel(kShaderChannelVertex, &dst->x, 3);
+}
 
-    int oldCount = _subMeshes[submesh].indexCount;
-    int oldOffset = _subMeshes[submesh].indexOffset;
+void Mesh::extractNormals(Vector3f *dst) const {
+    if (!checkCPUData("extract normals")) return;
+    _vertexData.extractChannel(kShaderChannelNormal, &dst->x, 3);
+}
+
+void Mesh::extractTangents(Vector4f *dst) const {
+    if (!checkCPUData("extract tangents")) return;
+    _vertexData.extractChannel(kShaderChannelTangent, &dst->x, 4);
+}
+
+void Mesh::extractUV(int uvIndex, Vector2f *dst) const {
+    if (!checkCPUData("extract uv")) return;
+    _vertexData.extractChannel((ShaderChannel) (kShaderChannelTexCoord0 + uvIndex), &dst->x, 2);
+}
+
+template<typename T, typename U>
+static void WriteSubMeshIndices(std::vector<T> &indexBuffer, std::vector<SubMesh> &subMeshes,
+                                const U *indices, unsigned int count, unsigned int submesh) {
+    int oldCount = subMeshes[submesh].indexCount;
+    int oldOffset = subMeshes[submesh].indexOffset;
     int diff = count - oldCount;
 
     if (diff > 0) {
         // growing
-        _indexBuffer.insert(_indexBuffer.begin() + oldOffset + oldCount, diff, 0);
+        indexBuffer.insert(indexBuffer.begin() + oldOffset + oldCount, diff, 0);
 
     } else {
         /// shrink
-        _indexBuffer.erase(_indexBuffer.begin() + oldOffset, _indexBuffer.begin() + oldOffset - diff);
+        indexBuffer.erase(indexBuffer.begin() + oldOffset, indexBuffer.begin() + oldOffset - diff);
     }
 
-
-
     // Update the sub mesh
-    _subMeshes[submesh].indexCount = count;
+    subMeshes[submesh].indexCount = count;
 
     // Synchronize subsequent sub meshes
-    for (int i = submesh + 1; i < _subMeshes.size(); ++i) {
-        _subMeshes[i].indexOffset = _subMeshes[i - 1].indexOffset + _subMeshes[i - 1].indexCount;
+    for (int i = submesh + 1; i < subMeshes.size(); ++i) {
+        subMeshes[i].indexOffset = subMeshes[i - 1].indexOffset + subMeshes[i - 1].indexCount;
     }
 
     // Write indices into the allocated data
-    memcpy(_indexBuffer.data() + oldOffset, indices, sizeof(UInt16) * count);
+    if constexpr (std::is_same_v<T, U>) {
+        memcpy(indexBuffer.data() + oldOffset, indices, sizeof(T) * count);
+    } else {
+        std::copy(indices, indices + count, indexBuffer.begin() + oldOffset);
+    }
+}
 
+bool Mesh::setIndices(const UInt16 *indices, unsigned int count, unsigned int submesh) {
+    if (indices == NULL && count != 0) {
+        ANAssert("failed setting indices. indices is NULL");
+        return false;
+    }
+
+    if (!checkCPUData("set indices")) return false;
+
+    if (submesh >= getSubMeshCount()) {
+        AN_LOG(Error, "Failed setting triangles. Submesh index is out of bounds.");
+        return false;
+    }
+
+    if (m_IndexFormat == kIndexFormatUInt32) {
+        WriteSubMeshIndices(_indexBuffer32, _subMeshes, indices, count, submesh);
+    } else {
+        WriteSubMeshIndices(_indexBuffer, _subMeshes, indices, count, submesh);
+    }
+    m_UVDistributionMetricDirty = true;
+    return true;
+}
+
+bool Mesh::setIndices(const UInt32 *indices, unsigned int count, unsigned int submesh) {
+    if (indices == NULL && count != 0) {
+        ANAssert("failed setting indices. indices is NULL");
+        return false;
+    }
+
+    if (!checkCPUData("set indices")) return false;
+
+    if (submesh >= getSubMeshCount()) {
+        AN_LOG(Error, "Failed setting triangles. Submesh index is out of bounds.");
+        return false;
+    }
+
+    m_UVDistributionMetricDirty = true;
+    if (m_IndexFormat == kIndexFormatUInt32) {
+        WriteSubMeshIndices(_indexBuffer32, _subMeshes, indices, count, submesh);
+        return true;
+    }
+
+    if (std::any_of(indices, indices + count, [](UInt32 index) { return index > std::numeric_limits<UInt16>::max(); })) {
+        AN_LOG(Error, "Failed setting triangles. Indices exceed 65535, set index format to kIndexFormatUInt32 first.");
+        return false;
+    }
+    WriteSubMeshIndices(_indexBuffer, _subMeshes, indices, count, submesh);
+    return true;
+}
+
+bool Mesh::setIndexFormat(IndexFormat format) {
+    if (format == m_IndexFormat) return true;
+    if (!checkCPUData("set index format")) return false;
+
+    if (format == kIndexFormatUInt16) {
+        if ((UInt32) getVertexCount() > GetIndexFormatMaxVertexCount(kIndexFormatUInt16)) {
+            AN_LOG(Error, "Failed setting index format. A mesh with 16 bit indices may not have more than 65536 vertices.");
+            return false;
+        }
+        _indexBuffer.assign(_indexBuffer32.begin(), _indexBuffer32.end());
+        _indexBuffer32.clear();
+        _indexBuffer32.shrink_to_fit();
+    } else {
+        _indexBuffer32.assign(_indexBuffer.begin(), _indexBuffer.end());
+        _indexBuffer.clear();
+        _indexBuffer.shrink_to_fit();
+    }
+
+    m_IndexFormat = format;
     return true;
 }
 
 template<typename _Coder>
 void Mesh::transfer(_Coder &coder) {
     Super::transfer(coder);
+    TRANSFER(m_IsReadable);
+    TRANSFER(m_KeepCollisionData);
+
+    if constexpr (_Coder::IsEncoding()) {
+        if (m_CPUDataReleased) {
+            /// fail the whole encode instead of writing a mesh without data
+            AN_LOG(Error, "Mesh '%s' is not readable and its cpu data was released, call reloadFromAsset before serializing",
+                   getName().c_str());
+            coder.setError();
+            return;
+        }
+    }
+
     TRANSFER(_vertexData);
+    TRANSFER(m_VertexCompression);
     TRANSFER(_subMeshes);
+    TRANSFER(m_IndexFormat);
     TRANSFER(_indexBuffer);
+    TRANSFER(_indexBuffer32);
 
+    TRANSFER(m_BoneWeightsCompressed);
     TRANSFER(m_BoneWeights);
+    TRANSFER(m_PackedBoneWeights);
 
     size_t bindposesSize = m_Bindposes.size() * sizeof(Matrix4x4f);
     coder.transferTypeless(bindposesSize, "bindposesSize", kHideInEditor);
@@ -5,6 +5,8 @@
 #include "Render/Mesh/MeshRenderer.hpp"
 #include "Render/RenderContext.hpp"
 #include "Render/CommandBuffer.hpp"
+#include "Render/Texture2D.hpp"
+#include "Render/TextureStreamer.hpp"
 
 #include "Components/Transform.hpp"
 #include "Core/Actor.hpp"
@@ -22,7 +24,7 @@ INSTANTIATE_TEMPLATE_TRANSFER(MeshRenderer)
 
 MeshRenderer::~MeshRenderer() {}
 
-MeshRenderer::MeshRenderer(ObjectCreationMode mode) : Super(mode) {}
+MeshRenderer::MeshRenderer(ObjectCreationMode mode) : Super(mode), bOccluder() {}
 
 void MeshRenderer::InitializeClass() {
     GetClassStatic()->registerMessageCallback(kDidAddComponentMessage,
@@ -40,6 +42,11 @@ void MeshRenderer::onAddMeshRenderer() {
     transform = getTransform();
 }
 
+void MeshRenderer::getResourceReferences(std::vector<Object *> &references) const {
+    Super::getResourceReferences(references);
+    references.push_back(_mesh);
+}
+
 void MeshRenderer::setMesh(Mesh *mesh) {
     _mesh = mesh;
 }
@@ -50,11 +57,47 @@ void MeshRenderer::Update(UInt32 frameIndex) {
         transformData[frameIndex].objectToWorld = transform->getLocalToWorldMatrix();
         transformData[frameIndex].worldToObject = transform->getWorldToLocalMatrix();
     }
+
+    if (_mesh) {
+        _worldAABB[frameIndex] = TransformAABB(_mesh->getBounds(), transformData[frameIndex].objectToWorld);
+        bHasWorldAABB = true;
+    } else {
+        bHasWorldAABB = false;
+    }
+}
+
+void MeshRenderer::requestTextureMips(UInt32 frameIndex, const Vector3f &cameraPosition, float screenPixelScale) {
+    if (_mesh == nullptr || !bHasWorldAABB) return;
+    float metric = _mesh->getUVDistributionMetric();
+    if (metric <= 0.f) return;
+
+    /// the metric is in object space, areas scale by the square of the mean axis scale
+    const Matrix4x4f &objectToWorld = transformData[frameIndex].objectToWorld;
+    float axisScale = Math::length(Vector3f(objectToWorld[0])) * Math::length(Vector3f(objectToWorld[1])) *
+                      Math::length(Vector3f(objectToWorld[2]));
+    metric *= std::pow(axisScale, 2.f / 3.f);
+
+    const AABB &aabb    = _worldAABB[frameIndex];
+    Vector3f    outside = Math::max(Math::abs(cameraPosition - aabb.center) - aabb.extent, Vector3f(0.f));
+    float       distance = Math::length(outside);
+
+    TextureStreamer &streamer = GetTextureStreamer();
+    for (Material *material : _materials) {
+        if (material == nullptr) continue;
+        for (const auto &[name, property] : material->getPropertySheet().getTexEnvsMap()) {
+            Texture2D *texture = property.tex ? property.tex->as<Texture2D>() : nullptr;
+            if (texture == nullptr || texture->getStreamingID() == kInvalidStreamingTextureID) continue;
+            streamer.requestMip(texture->getStreamingID(),
+                                CalculateRequiredMip(metric, texture->getDataWidth(), texture->getDataHeight(),
+                                                     distance, screenPixelScale));
+        }
+    }
 }
 
 void MeshRenderer::Render(RenderContext &renderContext, const char *pass) {
     if (_mesh == nullptr || transform == nullptr) return;
 
+    VertexCompressionData compression = _mesh->getVertexCompressionData();
     for (int i = 0; i < _mesh->getSubMeshCount(); ++i) {
         SubMesh &subMesh = _mesh->getSubMesh(i);
 
@@ -66,6 +109,10 @@ void MeshRenderer::Render(RenderContext &renderContext, const char *pass) {
                 mat.setVector("an_WorldTransformParams", { 0, 0, 0, 1.f });
                 mat.setMatrix("an_ObjectToWorld", transformData[renderContext.frameIndex].objectToWorld);
                 mat.setMatrix("an_WorldToObject", transformData[renderContext.frameIndex].worldToObject);
+                mat.setVector("an_LODFade", { m_LODFade, 0.f, 0.f, 0.f });
+                mat.setVector("an_VertexCompression", compression.compression);
+                mat.setVector("an_VertexPositionScale", compression.positionScale);
+                mat.setVector("an_VertexPositionOffset", compression.positionOffset);
 
                 mat.applyMaterial(renderContext.commandBuffer, pass);
 
@@ -82,11 +129,36 @@ void MeshRenderer::Render(RenderContext &renderContext, const char *pass) {
     }
 }
 
+void MeshRenderer::Encode(RenderCommandList &list, UInt32 frameIndex, const char *pass) {
+    if (_mesh == nullptr || transform == nullptr) return;
+
+    const PerDrawData *perDraw = nullptr;
+    for (int i = 0; i < _mesh->getSubMeshCount(); ++i) {
+        if (_materials.size() < i + 1 || _materials[i] == nullptr) continue;
+
+        Material *mat = _materials[i];
+        if (!mat->hasPass(pass)) continue;
+
+        if (perDraw == nullptr) {
+            /// all subMeshes share the same transform
+            VertexCompressionData compression = _mesh->getVertexCompressionData();
+            perDraw = list.allocatePerDraw(transformData[frameIndex].objectToWorld,
+                                           transformData[frameIndex].worldToObject,
+                                           m_LODFade, &compression);
+        }
+
+        SubMesh &subMesh = _mesh->getSubMesh(i);
+        list.drawIndexed(mat, pass, perDraw, &_mesh->getVertexBuffer(),
+                         subMesh.indexCount, subMesh.indexOffset, 0);
+    }
+}
+
 template<typename _Coder>
 void MeshRenderer::transfer(_Coder &coder)
 {
     Super::transfer(coder);
     TRANSFER(_mesh);
+    TRANSFER(bOccluder);
 }
 
 #ifdef OJOIE_WITH_EDITOR
@@ -143,6 +215,9 @@ void MeshRenderer::onInspectorGUI() {
         ImGui::EndDragDropTarget();
     }
 
+    ItemLabel("Occluder", kItemLabelLeft);
+    ImGui::Checkbox("##Occluder", &bOccluder);
+
     ImGui::Dummy({ 0.f, 10.f });
 
     auto getMaterialName = [](const Material *mat) {
@@ -3,12 +3,9 @@
 //
 
 #include "Render/Mesh/SkinnedMeshRenderer.h"
+#include "Render/Mesh/SkinningManager.hpp"
 #include "Render/RenderContext.hpp"
 
-#ifdef WITH_TBB
-#include <tbb/parallel_for.h>
-#endif
-
 
 namespace AN
 {
@@ -21,7 +18,8 @@ INSTANTIATE_TEMPLATE_TRANSFER(SkinnedMeshRenderer)
 SkinnedMeshRenderer::SkinnedMeshRenderer(ObjectCreationMode mode) 
     : Super(mode),
       m_Mesh(),
-      m_RootBone()
+      m_RootBone(),
+      bNeedsSkinning(true)
 {
 }
 
@@ -32,6 +30,7 @@ SkinnedMeshRenderer::~SkinnedMeshRenderer()
 void SkinnedMeshRenderer::SetBones(const std::vector<Transform *> &bones)
 {
     m_Bones = bones;
+    bNeedsSkinning = true;
     GetRootBone();
 }
 
@@ -63,6 +62,12 @@ int SkinnedMeshRenderer::GetRootBoneIndex()
     return m_RootBoneIndex;
 }
 
+void SkinnedMeshRenderer::getResourceReferences(std::vector<Object *> &references) const
+{
+    Super::getResourceReferences(references);
+    references.push_back(m_Mesh);
+}
+
 void SkinnedMeshRenderer::SetMesh(Mesh *mesh)
 {
     m_Mesh = mesh;
@@ -88,103 +93,27 @@ void SkinnedMeshRenderer::Update(UInt32 frameIndex)
     m_TransformData[frameIndex].objectToWorld = localToWorld;
     m_TransformData[frameIndex].worldToObject = worldToLocal;
 
-
-    bool boneTransformChanged = false;
-    for (int i = 0; i < m_Bones.size(); ++i)
+    /// skinned by the manager after all renderers are updated,
+    /// a culled renderer misses skeleton changes and is skinned again when it is shown
+    if (isLODCulled())
     {
-        if (m_Bones[i]->HasChanged())
-        {
-            boneTransformChanged = true;
-            m_Bones[i]->SetHasChanged(false);
-        }
-    }
-
-    if (!boneTransformChanged)
-    {
-        /// return early if bones transform not changed
-        return;
+        bNeedsSkinning = true;
     }
-
-    /// FIXME do CPU skinning in manager
-
-    /// cpu skinning
-    const BoneWeight *boneWeights = m_Mesh->getBoneWeightsData();
-    auto vertices = m_Mesh->getVertexBegin();
-    auto normals = m_Mesh->getNormalBegin();
-    auto tangents = m_Mesh->getTangentBegin();
-
-//    Matrix4x4f rootPose = GetRootBone()->GetLocalToWorldMatrixNoScale();
-    const Matrix4x4f *bindposes = m_Mesh->getBindposesData();
-
-    std::vector<Matrix4x4f> skinningMatrices(m_Bones.size());
-
-    Matrix4x4f rootPose = GetRootBone()->GetWorldToLocalMatrixNoScale();
-    for (int i = 0; i < skinningMatrices.size(); ++i)
+    else
     {
-        skinningMatrices[i] = rootPose * m_Bones[i]->getLocalToWorldMatrix() * bindposes[i];
+        GetSkinningManager().requestSkinning(this);
     }
+}
 
-    auto positionData = m_VertexData.MakeStrideIterator<Vector3f>(kShaderChannelVertex);
-    auto normalData = m_VertexData.MakeStrideIterator<Vector3f>(kShaderChannelNormal);
-    auto tangentData = m_VertexData.MakeStrideIterator<Vector4f>(kShaderChannelTangent);
-
-    auto skinMeshVertex = [&](int i)
-    {
-        const BoneWeight &boneWeight = boneWeights[i];
-        Vector3f vertex = vertices[i];
-        Vector3f normal = normals[i];
-        Vector3f tangent = tangents[i];
-
-        Vector3f resultPosition{}, resultNormal{}, resultTangent{};
-
-        for (int j = 0; j < 4; ++j)
-        {
-            const Matrix4x4f &skinningMatrix = skinningMatrices[boneWeight.boneIndices[j]];
-            float weight = boneWeight.weights[j];
-
-            Vector3f pos0 = skinningMatrix * Vector4f(vertex, 1.f);
-            Vector3f norm0 = skinningMatrix * Vector4f(normal, 0.f);
-            Vector3f tan0 = skinningMatrix * Vector4f(tangent, 0.f);
-
-            resultPosition += (pos0 * weight);
-            resultNormal += (norm0 * weight);
-            resultTangent += (tan0 * weight);
-        }
-
-        resultNormal = Math::normalize(resultNormal);
-        resultTangent = Math::normalize(resultTangent);
-
-        positionData[i] = resultPosition;
-        normalData[i] = resultNormal;
-        tangentData[i] = Vector4f(resultTangent, tangents[i].w);
-    };
-
-#ifdef WITH_TBB
-    tbb::parallel_for(
-            tbb::blocked_range<int>(0, m_Mesh->getVertexCount()),
-            [&](const tbb::blocked_range<int>& range)
-            {
-                for (int i = range.begin(); i !=range.end(); ++i)
-                {
-                    skinMeshVertex(i);
-                }
-            });
-
-#else
-    for (int i = 0; i < m_Mesh->getVertexCount(); ++i)
-    {
-        skinMeshVertex(i);
-    }
-#endif
-
-
+void SkinnedMeshRenderer::UploadVertexStream()
+{
     VertexBufferData vertexBufferData;
 
     for (int i = 0; i < kShaderChannelCount; i++)
-        vertexBufferData.channels[i] = m_Mesh->GetChannel(i);
+        vertexBufferData.channels[i] = m_VertexData.getChannel(i);
 
     for (int i = 0; i < kMaxVertexStreams; i++)
-        vertexBufferData.streams[i] = m_Mesh->GetStream(i);
+        vertexBufferData.streams[i] = m_VertexData.getStream(i);
 
     vertexBufferData.buffer      = m_VertexData.getDataPtr();
     vertexBufferData.bufferSize  = m_VertexData.getDataSize();
@@ -208,6 +137,10 @@ void SkinnedMeshRenderer::Render(RenderContext &renderContext, const char *pass)
                 mat.setVector("an_WorldTransformParams", { 0, 0, 0, 1.f });
                 mat.setMatrix("an_ObjectToWorld", m_TransformData[renderContext.frameIndex].objectToWorld);
                 mat.setMatrix("an_WorldToObject", m_TransformData[renderContext.frameIndex].worldToObject);
+                mat.setVector("an_LODFade", { m_LODFade, 0.f, 0.f, 0.f });
+
+                /// the skinned vertices are always float
+                mat.setVector("an_VertexCompression", { 0.f, 0.f, 0.f, 0.f });
 
                 mat.applyMaterial(renderContext.commandBuffer, pass);
 
@@ -219,6 +152,30 @@ void SkinnedMeshRenderer::Render(RenderContext &renderContext, const char *pass)
         }
     }
 }
+void SkinnedMeshRenderer::Encode(RenderCommandList &list, UInt32 frameIndex, const char *pass)
+{
+    if (m_Mesh == nullptr) return;
+
+    const PerDrawData *perDraw = nullptr;
+    for (int i = 0; i < m_Mesh->getSubMeshCount(); ++i) {
+        if (_materials.size() < i + 1 || _materials[i] == nullptr) continue;
+
+        Material *mat = _materials[i];
+        if (!mat->hasPass(pass)) continue;
+
+        if (perDraw == nullptr) {
+            /// the skinned vertices are always float, no compression data
+            perDraw = list.allocatePerDraw(m_TransformData[frameIndex].objectToWorld,
+                                           m_TransformData[frameIndex].worldToObject,
+                                           m_LODFade);
+        }
+
+        SubMesh &subMesh = m_Mesh->getSubMesh(i);
+        list.drawIndexed(mat, pass, perDraw, &m_VertexBuffer,
+                         subMesh.indexCount, subMesh.indexOffset, 0);
+    }
+}
+
 bool SkinnedMeshRenderer::init()
 {
     Super::init();
@@ -237,33 +194,52 @@ bool SkinnedMeshRenderer::initAfterDecode()
 
 void SkinnedMeshRenderer::InitVertexBuffer()
 {
+    /// cpu skinning reads the source mesh every update, a released mesh is reloaded and stays resident
+    if (!m_Mesh->hasCPUData() && !m_Mesh->reloadFromAsset())
+    {
+        AN_LOG(Error, "SkinnedMeshRenderer needs the cpu data of mesh '%s', which is not readable", m_Mesh->getName().c_str());
+        m_Mesh = nullptr;
+        return;
+    }
+
+    /// the mesh may have changed since the manager decoded it
+    GetSkinningManager().invalidateMesh(m_Mesh);
+    bNeedsSkinning = true;
+
     VertexStreamsLayout layout =  { { kShaderChannelsHot, kShaderChannelsCold, 0, 0 } };
     m_VertexData.resize(m_Mesh->getVertexCount(),
                         (1 << kShaderChannelVertex) | (1 << kShaderChannelNormal) |
                         (1 << kShaderChannelTangent) | (1 << kShaderChannelTexCoord0),
                         layout, VertexDataInfo::kVertexChannelsDefault);
 
-    strided_copy(m_Mesh->getVertexBegin(), m_Mesh->getVertexEnd(), m_VertexData.MakeStrideIterator<Vector3f>(kShaderChannelVertex));
-    strided_copy(m_Mesh->getNormalBegin(), m_Mesh->getNormalEnd(), m_VertexData.MakeStrideIterator<Vector3f>(kShaderChannelNormal));
-    strided_copy(m_Mesh->getUvBegin(), m_Mesh->getUvEnd(), m_VertexData.MakeStrideIterator<Vector2f>(kShaderChannelTexCoord0));
-    strided_copy(m_Mesh->getTangentBegin(), m_Mesh->getTangentEnd(), m_VertexData.MakeStrideIterator<Vector4f>(kShaderChannelTangent));
+    /// decode the source mesh, it may be compressed
+    std::vector<Vector3f> vertices(m_Mesh->getVertexCount()), normals(m_Mesh->getVertexCount());
+    std::vector<Vector2f> uv(m_Mesh->getVertexCount());
+    std::vector<Vector4f> tangents(m_Mesh->getVertexCount());
+    m_Mesh->extractVertices(vertices.data());
+    m_Mesh->extractNormals(normals.data());
+    m_Mesh->extractUV(0, uv.data());
+    m_Mesh->extractTangents(tangents.data());
+
+    strided_copy(vertices.data(), vertices.data() + vertices.size(), m_VertexData.MakeStrideIterator<Vector3f>(kShaderChannelVertex));
+    strided_copy(normals.data(), normals.data() + normals.size(), m_VertexData.MakeStrideIterator<Vector3f>(kShaderChannelNormal));
+    strided_copy(uv.data(), uv.data() + uv.size(), m_VertexData.MakeStrideIterator<Vector2f>(kShaderChannelTexCoord0));
+    strided_copy(tangents.data(), tangents.data() + tangents.size(), m_VertexData.MakeStrideIterator<Vector4f>(kShaderChannelTangent));
 
     m_VertexBuffer.init();
     m_VertexBuffer.setVertexStreamMode(0, kStreamModeDynamic);
     m_VertexBuffer.setVertexStreamMode(1, kStreamModeNoAccess);
 
-    IndexBufferData indexBufferData;
-    indexBufferData.indices = m_Mesh->getIndicesData();
-    indexBufferData.count = m_Mesh->getIndicesCount();
+    IndexBufferData indexBufferData = m_Mesh->getIndexBufferData();
 
 
     VertexBufferData vertexBufferData;
 
     for (int i = 0; i < kShaderChannelCount; i++)
-        vertexBufferData.channels[i] = m_Mesh->GetChannel(i);
+        vertexBufferData.channels[i] = m_VertexData.getChannel(i);
 
     for (int i = 0; i < kMaxVertexStreams; i++)
-        vertexBufferData.streams[i] = m_Mesh->GetStream(i);
+        vertexBufferData.streams[i] = m_VertexData.getStream(i);
 
     vertexBufferData.buffer      = m_VertexData.getDataPtr();
     vertexBufferData.bufferSize  = m_VertexData.getDataSize();
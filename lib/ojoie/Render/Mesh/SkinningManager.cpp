@@ -0,0 +1,335 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/Mesh/SkinningManager.hpp"
+#include "Render/Mesh/SkinnedMeshRenderer.h"
+#include "Render/Shader/Shader.hpp"
+#include "Threads/ParallelFor.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKINNING_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace AN {
+
+/// skeletons per worker range when computing palettes
+static constexpr size_t kSkeletonGrainSize = 8;
+
+/// decoded sources of meshes not skinned for this many frames are released
+static constexpr UInt32 kSourceEvictFrames = 120;
+
+#if SKINNING_USE_SSE
+
+/// a * b for column major matrices
+static inline void MultiplyMatrix(const float *a, const float *b, float *out) {
+    __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 4), a2 = _mm_loadu_ps(a + 8), a3 = _mm_loadu_ps(a + 12);
+    for (int c = 0; c < 4; ++c) {
+        const float *column = b + c * 4;
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(column[0])), _mm_mul_ps(a1, _mm_set1_ps(column[1]))),
+                              _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(column[2])), _mm_mul_ps(a3, _mm_set1_ps(column[3]))));
+        _mm_storeu_ps(out + c * 4, r);
+    }
+}
+
+static inline __m128 BlendColumn(const float *m0, const float *m1, const float *m2, const float *m3,
+                                 __m128 w0, __m128 w1, __m128 w2, __m128 w3) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m0), w0), _mm_mul_ps(_mm_loadu_ps(m1), w1)),
+                      _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m2), w2), _mm_mul_ps(_mm_loadu_ps(m3), w3)));
+}
+
+static inline __m128 TransformDirection(__m128 c0, __m128 c1, __m128 c2, const float *v) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(v[0])), _mm_mul_ps(c1, _mm_set1_ps(v[1]))),
+                      _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+}
+
+static inline __m128 Normalize3(__m128 v) {
+    __m128 sq  = _mm_mul_ps(v, v);
+    __m128 dot = _mm_add_ps(_mm_add_ps(_mm_shuffle_ps(sq, sq, _MM_SHUFFLE(0, 0, 0, 0)),
+                                       _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1))),
+                            _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2)));
+    return _mm_div_ps(v, _mm_sqrt_ps(_mm_max_ps(dot, _mm_set1_ps(1e-30f))));
+}
+
+static inline void Store3(float *dst, __m128 v) {
+    alignas(16) float tmp[4];
+    _mm_store_ps(tmp, v);
+    memcpy(dst, tmp, sizeof(float) * 3);
+}
+
+#endif
+
+void ComputeSkinningPalette(const Matrix4x4f *boneMatrices, const Matrix4x4f *bindposes,
+                            size_t count, Matrix4x4f *outPalette) {
+    for (size_t i = 0; i < count; ++i) {
+#if SKINNING_USE_SSE
+        MultiplyMatrix(&boneMatrices[i][0][0], &bindposes[i][0][0], &outPalette[i][0][0]);
+#else
+        outPalette[i] = boneMatrices[i] * bindposes[i];
+#endif
+    }
+}
+
+void SkinVertices(const SkinningJob &job, UInt32 begin, UInt32 end) {
+    const SkinningInput  &input  = job.input;
+    SkinningOutput        output = job.output;
+
+    bool bPositions = job.channels & VERTEX_FORMAT1(Vertex);
+    bool bNormals   = (job.channels & VERTEX_FORMAT1(Normal)) && input.normals;
+    bool bTangents  = (job.channels & VERTEX_FORMAT1(Tangent)) && input.tangents;
+
+    for (UInt32 i = begin; i < end; ++i) {
+        const BoneWeight &boneWeight = input.boneWeights[i];
+
+#if SKINNING_USE_SSE
+        const float *m0 = &job.palette[boneWeight.boneIndices[0]][0][0];
+        const float *m1 = &job.palette[boneWeight.boneIndices[1]][0][0];
+        const float *m2 = &job.palette[boneWeight.boneIndices[2]][0][0];
+        const float *m3 = &job.palette[boneWeight.boneIndices[3]][0][0];
+        __m128 w0 = _mm_set1_ps(boneWeight.weights[0]), w1 = _mm_set1_ps(boneWeight.weights[1]);
+        __m128 w2 = _mm_set1_ps(boneWeight.weights[2]), w3 = _mm_set1_ps(boneWeight.weights[3]);
+
+        /// one blended matrix instead of four transforms per attribute
+        __m128 c0 = BlendColumn(m0, m1, m2, m3, w0, w1, w2, w3);
+        __m128 c1 = BlendColumn(m0 + 4, m1 + 4, m2 + 4, m3 + 4, w0, w1, w2, w3);
+        __m128 c2 = BlendColumn(m0 + 8, m1 + 8, m2 + 8, m3 + 8, w0, w1, w2, w3);
+
+        if (bPositions) {
+            __m128 c3 = BlendColumn(m0 + 12, m1 + 12, m2 + 12, m3 + 12, w0, w1, w2, w3);
+            Store3(&output.positions[i].x, _mm_add_ps(TransformDirection(c0, c1, c2, &input.positions[i].x), c3));
+        }
+        if (bNormals) {
+            Store3(&output.normals[i].x, Normalize3(TransformDirection(c0, c1, c2, &input.normals[i].x)));
+        }
+        if (bTangents) {
+            Vector4f &tangent = output.tangents[i];
+            Store3(&tangent.x, Normalize3(TransformDirection(c0, c1, c2, &input.tangents[i].x)));
+            tangent.w = input.tangents[i].w;
+        }
+#else
+        Matrix4x4f matrix = job.palette[boneWeight.boneIndices[0]] * boneWeight.weights[0] +
+                            job.palette[boneWeight.boneIndices[1]] * boneWeight.weights[1] +
+                            job.palette[boneWeight.boneIndices[2]] * boneWeight.weights[2] +
+                            job.palette[boneWeight.boneIndices[3]] * boneWeight.weights[3];
+
+        if (bPositions) {
+            output.positions[i] = Vector3f(matrix * Vector4f(input.positions[i], 1.f));
+        }
+        if (bNormals) {
+            output.normals[i] = Math::normalize(Vector3f(matrix * Vector4f(input.normals[i], 0.f)));
+        }
+        if (bTangents) {
+            Vector3f tangent   = Math::normalize(Vector3f(matrix * Vector4f(Vector3f(input.tangents[i]), 0.f)));
+            output.tangents[i] = Vector4f(tangent, input.tangents[i].w);
+        }
+#endif
+    }
+}
+
+void SkinJobs(std::span<const SkinningJob> jobs, std::vector<SkinningBatch> &batches) {
+    batches.clear();
+    for (UInt32 i = 0; i < jobs.size(); ++i) {
+        for (UInt32 begin = 0; begin < jobs[i].vertexCount; begin += kSkinningBatchSize) {
+            batches.push_back({ i, begin, std::min(jobs[i].vertexCount, begin + kSkinningBatchSize) });
+        }
+    }
+
+    ParallelFor(batches.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const SkinningBatch &batch = batches[i];
+            SkinVertices(jobs[batch.job], batch.begin, batch.end);
+        }
+    });
+}
+
+/// union of the channels the vertex inputs of all passes read
+static UInt32 GetRequiredChannels(std::span<Material *const> materials) {
+    UInt32 channels = VERTEX_FORMAT1(Vertex);
+    for (Material *material : materials) {
+        if (material == nullptr || material->getShader() == nullptr) continue;
+        Shader *shader = material->getShader();
+        for (UInt32 subShader = 0; subShader < shader->getSubShaderNum(); ++subShader) {
+            for (UInt32 pass = 0; pass < shader->getPassNum(subShader); ++pass) {
+                for (const ShaderVertexInput &vertexInput : shader->getVertexInputs(pass, subShader)) {
+                    if (vertexInput.semantic == "NORMAL") channels |= VERTEX_FORMAT1(Normal);
+                    else if (vertexInput.semantic == "TANGENT") channels |= VERTEX_FORMAT1(Tangent);
+                }
+            }
+        }
+    }
+    return channels;
+}
+
+SkinningManager::SkinningManager() : m_FrameVersion(), m_SkinnedVertexCount() {}
+
+SkinningManager::SkinningSource &SkinningManager::getSource(Mesh *mesh) {
+    auto [it, inserted] = m_Sources.try_emplace(mesh);
+    SkinningSource &source = it->second;
+    source.lastUsedFrame   = m_FrameVersion;
+    if (!inserted) return source;
+
+    /// decode once, the mesh may be compressed
+    size_t vertexCount = mesh->getVertexCount();
+    source.positions.resize(vertexCount);
+    mesh->extractVertices(source.positions.data());
+    if (mesh->isAvailable(kShaderChannelNormal)) {
+        source.normals.resize(vertexCount);
+        mesh->extractNormals(source.normals.data());
+    }
+    if (mesh->isAvailable(kShaderChannelTangent)) {
+        source.tangents.resize(vertexCount);
+        mesh->extractTangents(source.tangents.data());
+    }
+
+    /// vertices without weights follow the first bone
+    source.boneWeights.assign(vertexCount, BoneWeight{ { 0, 0, 0, 0 }, { 1.f, 0.f, 0.f, 0.f } });
+    UInt32 weightCount = std::min<UInt32>(mesh->getBoneWeightsCount(), vertexCount);
+    UInt32 boneCount   = mesh->getBindposesCount();
+    for (UInt32 i = 0; i < weightCount; ++i) {
+        BoneWeight boneWeight = mesh->getBoneWeight(i);
+        for (int j = 0; j < 4; ++j) {
+            if ((UInt32) boneWeight.boneIndices[j] >= boneCount) {
+                boneWeight.boneIndices[j] = 0;
+                boneWeight.weights[j]     = 0.f;
+            }
+        }
+        source.boneWeights[i] = boneWeight;
+    }
+    return source;
+}
+
+UInt32 SkinningManager::getSkeleton(SkinnedMeshRenderer *renderer) {
+    Transform *rootBone = renderer->GetRootBone();
+    if (auto it = m_SkeletonMap.find(rootBone); it != m_SkeletonMap.end() &&
+                                                *m_Skeletons[it->second].bones == renderer->m_Bones) {
+        return it->second;
+    }
+
+    UInt32    index    = m_Skeletons.size();
+    Skeleton &skeleton = m_Skeletons.emplace_back();
+    skeleton.bones            = &renderer->m_Bones;
+    skeleton.boneMatrixOffset = m_BoneMatrices.size();
+    skeleton.bChanged         = false;
+
+    /// bones relative to the root, the renderer draws with the root transform
+    Matrix4x4f rootPose = rootBone->GetWorldToLocalMatrixNoScale();
+    for (Transform *bone : renderer->m_Bones) {
+        skeleton.bChanged |= bone->HasChanged();
+        m_BoneMatrices.push_back(rootPose * bone->getLocalToWorldMatrix());
+    }
+
+    m_SkeletonMap.try_emplace(rootBone, index);
+    return index;
+}
+
+void SkinningManager::update(UInt32 frameIndex) {
+    ++m_FrameVersion;
+    m_SkinnedVertexCount = 0;
+
+    m_Skeletons.clear();
+    m_SkeletonMap.clear();
+    m_BoneMatrices.clear();
+    m_Jobs.clear();
+    m_JobRenderers.clear();
+
+    /// gather skeletons, bone matrices are computed once per skeleton
+    m_RendererSkeletons.resize(m_Renderers.size());
+    for (UInt32 i = 0; i < m_Renderers.size(); ++i) {
+        m_RendererSkeletons[i] = getSkeleton(m_Renderers[i]);
+        if (auto it = m_Sources.find(m_Renderers[i]->m_Mesh); it != m_Sources.end()) {
+            it->second.lastUsedFrame = m_FrameVersion;
+        }
+    }
+
+    /// change flags are cleared after every renderer of the skeleton has seen them
+    for (Skeleton &skeleton : m_Skeletons) {
+        for (Transform *bone : *skeleton.bones) {
+            bone->SetHasChanged(false);
+        }
+    }
+
+    /// one palette per skeleton and mesh
+    UInt32 paletteSize = 0;
+    m_RendererPalettes.assign(m_Renderers.size(), kInvalidPalette);
+    for (UInt32 i = 0; i < m_Renderers.size(); ++i) {
+        Skeleton &skeleton = m_Skeletons[m_RendererSkeletons[i]];
+        /// the skeleton flag is shared, a renderer whose vertex data is stale is skinned on its own flag
+        if (!skeleton.bChanged && !m_Renderers[i]->bNeedsSkinning) continue;
+
+        Mesh *mesh = m_Renderers[i]->m_Mesh;
+        if (mesh->getBindposesCount() > skeleton.bones->size()) {
+            AN_LOG(Error, "Mesh '%s' has more bindposes than the SkinnedMeshRenderer has bones", mesh->getName().c_str());
+            continue;
+        }
+
+        auto it = std::find_if(skeleton.palettes.begin(), skeleton.palettes.end(),
+                               [mesh](const auto &palette) { return palette.first == mesh; });
+        if (it == skeleton.palettes.end()) {
+            skeleton.palettes.emplace_back(mesh, paletteSize);
+            it = skeleton.palettes.end() - 1;
+            paletteSize += skeleton.bones->size();
+        }
+        m_RendererPalettes[i] = it->second;
+    }
+
+    m_Palettes.resize(paletteSize);
+    ParallelFor(m_Skeletons.size(), kSkeletonGrainSize, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Skeleton &skeleton     = m_Skeletons[i];
+            const Matrix4x4f *boneMatrices = m_BoneMatrices.data() + skeleton.boneMatrixOffset;
+            size_t boneCount = skeleton.bones->size();
+            for (auto &[mesh, offset] : skeleton.palettes) {
+                size_t count = std::min<size_t>(boneCount, mesh->getBindposesCount());
+                ComputeSkinningPalette(boneMatrices, mesh->getBindposesData(), count, m_Palettes.data() + offset);
+                std::copy(boneMatrices + count, boneMatrices + boneCount, m_Palettes.begin() + offset + count);
+            }
+        }
+    });
+
+    for (UInt32 i = 0; i < m_Renderers.size(); ++i) {
+        SkinnedMeshRenderer *renderer = m_Renderers[i];
+        if (m_RendererPalettes[i] == kInvalidPalette) continue;
+
+        SkinningSource &source = getSource(renderer->m_Mesh);
+
+        SkinningJob job;
+        job.palette           = m_Palettes.data() + m_RendererPalettes[i];
+        job.input.positions   = source.positions.data();
+        job.input.normals     = source.normals.empty() ? nullptr : source.normals.data();
+        job.input.tangents    = source.tangents.empty() ? nullptr : source.tangents.data();
+        job.input.boneWeights = source.boneWeights.data();
+        job.output.positions  = renderer->m_VertexData.MakeStrideIterator<Vector3f>(kShaderChannelVertex);
+        job.output.normals    = renderer->m_VertexData.MakeStrideIterator<Vector3f>(kShaderChannelNormal);
+        job.output.tangents   = renderer->m_VertexData.MakeStrideIterator<Vector4f>(kShaderChannelTangent);
+        job.vertexCount       = source.positions.size();
+        job.channels          = GetRequiredChannels(renderer->getMaterials());
+        m_Jobs.push_back(job);
+        m_JobRenderers.push_back(renderer);
+        renderer->bNeedsSkinning = false;
+        m_SkinnedVertexCount += job.vertexCount;
+    }
+
+    SkinJobs(m_Jobs, m_Batches);
+
+    for (SkinnedMeshRenderer *renderer : m_JobRenderers) {
+        renderer->UploadVertexStream();
+    }
+
+    /// meshes no longer skinned release their decoded source
+    std::erase_if(m_Sources, [this](const auto &item) {
+        return m_FrameVersion - item.second.lastUsedFrame > kSourceEvictFrames;
+    });
+
+    m_Renderers.clear();
+}
+
+SkinningManager &GetSkinningManager() {
+    static SkinningManager skinningManager;
+    return skinningManager;
+}
+
+}
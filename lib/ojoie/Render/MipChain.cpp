@@ -0,0 +1,317 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/MipChain.hpp"
+#include "Threads/ParallelFor.hpp"
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIP_CHAIN_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace AN {
+
+/// the Kaiser filter reaches this many texels of the smaller level to each side
+static constexpr float kKaiserWidth = 3.f;
+static constexpr float kKaiserAlpha = 4.f;
+
+/// rows of a level filtered by one task
+static constexpr size_t kTexelsPerTask = 16384;
+
+static constexpr UInt32 kLinearToSRGBTableSize = 16384;
+
+/// working image, four linear floats per texel whatever the channel count
+struct MipImage {
+    UInt32             width, height;
+    std::vector<float> texels;
+
+    void resize(UInt32 w, UInt32 h) {
+        width  = w;
+        height = h;
+        texels.resize((size_t) w * h * 4);
+    }
+
+    float       *row(UInt32 y) { return texels.data() + (size_t) y * width * 4; }
+    const float *row(UInt32 y) const { return texels.data() + (size_t) y * width * 4; }
+};
+
+struct MipTap {
+    UInt32 index;
+    float  weight;
+};
+
+/// taps of every texel of one axis, texel i uses taps[offsets[i]] up to taps[offsets[i + 1]]
+struct MipAxisFilter {
+    std::vector<UInt32> offsets;
+    std::vector<MipTap> taps;
+};
+
+static UInt32 GetChannelCount(PixelFormat pixelFormat) {
+    switch (pixelFormat) {
+        case kPixelFormatR8Unorm:
+        case kPixelFormatR8Unorm_sRGB:
+            return 1;
+        case kPixelFormatRG8Unorm_sRGB:
+            return 2;
+        case kPixelFormatRGBA8Unorm:
+        case kPixelFormatRGBA8Unorm_sRGB:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+static bool IsSRGBPixelFormat(PixelFormat pixelFormat) {
+    return pixelFormat == kPixelFormatR8Unorm_sRGB || pixelFormat == kPixelFormatRG8Unorm_sRGB ||
+           pixelFormat == kPixelFormatRGBA8Unorm_sRGB;
+}
+
+static size_t GetRowGrain(UInt32 width) {
+    return std::max<size_t>(1, kTexelsPerTask / width);
+}
+
+static const float *GetSRGBToLinearTable() {
+    static const std::vector<float> table = [] {
+        std::vector<float> result(256);
+        for (int i = 0; i < 256; ++i) {
+            float c   = (float) i / 255.f;
+            result[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return result;
+    }();
+    return table.data();
+}
+
+static const UInt8 *GetLinearToSRGBTable() {
+    static const std::vector<UInt8> table = [] {
+        std::vector<UInt8> result(kLinearToSRGBTableSize + 1);
+        for (UInt32 i = 0; i <= kLinearToSRGBTableSize; ++i) {
+            float l   = (float) i / kLinearToSRGBTableSize;
+            float c   = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.f / 2.4f) - 0.055f;
+            result[i] = (UInt8) std::lround(std::clamp(c, 0.f, 1.f) * 255.f);
+        }
+        return result;
+    }();
+    return table.data();
+}
+
+static float BesselI0(float x) {
+    float sum = 1.f, term = 1.f;
+    for (int k = 1; k < 32 && term > sum * 1e-7f; ++k) {
+        term *= (x * x) / (4.f * (float) k * (float) k);
+        sum += term;
+    }
+    return sum;
+}
+
+static float KaiserSinc(float t) {
+    if (std::abs(t) >= kKaiserWidth) return 0.f;
+    float pt   = std::numbers::pi_v<float> * t;
+    float sinc = std::abs(t) < 1e-5f ? 1.f : std::sin(pt) / pt;
+    float x    = t / kKaiserWidth;
+    return sinc * BesselI0(kKaiserAlpha * std::sqrt(1.f - x * x)) / BesselI0(kKaiserAlpha);
+}
+
+static MipAxisFilter BuildAxisFilter(UInt32 srcSize, UInt32 dstSize, MipFilter filter) {
+    MipAxisFilter result;
+    result.offsets.reserve(dstSize + 1);
+    for (UInt32 i = 0; i < dstSize; ++i) {
+        result.offsets.push_back((UInt32) result.taps.size());
+        if (srcSize == dstSize) {
+            result.taps.push_back({ i, 1.f });
+            continue;
+        }
+        if (filter == kMipFilterBox) {
+            result.taps.push_back({ std::min(2 * i, srcSize - 1), 0.5f });
+            result.taps.push_back({ std::min(2 * i + 1, srcSize - 1), 0.5f });
+            continue;
+        }
+
+        /// texel centers are at +0.5, the clamped edge repeats the border texel
+        float  scale  = (float) srcSize / (float) dstSize;
+        float  center = ((float) i + 0.5f) * scale;
+        int    first  = (int) std::floor(center - kKaiserWidth * scale);
+        int    last   = (int) std::ceil(center + kKaiserWidth * scale);
+        size_t begin  = result.taps.size();
+        float  sum    = 0.f;
+        for (int s = first; s <= last; ++s) {
+            float weight = KaiserSinc(((float) s + 0.5f - center) / scale);
+            if (weight == 0.f) continue;
+            result.taps.push_back({ (UInt32) std::clamp(s, 0, (int) srcSize - 1), weight });
+            sum += weight;
+        }
+        for (size_t t = begin; t < result.taps.size(); ++t) {
+            result.taps[t].weight /= sum;
+        }
+    }
+    result.offsets.push_back((UInt32) result.taps.size());
+    return result;
+}
+
+static void Decode(const UInt8 *data, UInt32 channels, bool bSRGB, MipImage &image) {
+    const float *toLinear      = GetSRGBToLinearTable();
+    UInt32       colorChannels = channels == 4 ? 3 : channels;
+
+    ParallelFor(image.height, GetRowGrain(image.width), [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            const UInt8 *src = data + y * image.width * channels;
+            float       *dst = image.row((UInt32) y);
+            for (UInt32 x = 0; x < image.width; ++x, src += channels, dst += 4) {
+                dst[0] = dst[1] = dst[2] = 0.f;
+                dst[3] = 1.f;
+                for (UInt32 c = 0; c < channels; ++c) {
+                    dst[c] = bSRGB && c < colorChannels ? toLinear[src[c]] : (float) src[c] / 255.f;
+                }
+            }
+        }
+    });
+}
+
+static void Encode(const MipImage &image, UInt32 channels, bool bSRGB, float alphaScale, UInt8 *data) {
+    const UInt8 *toSRGB        = GetLinearToSRGBTable();
+    UInt32       colorChannels = channels == 4 ? 3 : channels;
+
+    ParallelFor(image.height, GetRowGrain(image.width), [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            const float *src = image.row((UInt32) y);
+            UInt8       *dst = data + y * image.width * channels;
+            for (UInt32 x = 0; x < image.width; ++x, src += 4, dst += channels) {
+                for (UInt32 c = 0; c < channels; ++c) {
+                    float value = c == 3 ? src[c] * alphaScale : src[c];
+                    value       = std::clamp(value, 0.f, 1.f);
+                    dst[c] = bSRGB && c < colorChannels ? toSRGB[(UInt32) (value * kLinearToSRGBTableSize + 0.5f)]
+                                                        : (UInt8) (value * 255.f + 0.5f);
+                }
+            }
+        }
+    });
+}
+
+/// dst texels are weighted sums of whole src texels, four floats at a time
+static inline void AccumulateTexel(float *dst, const float *src, float weight) {
+#ifdef MIP_CHAIN_USE_SSE
+    _mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(_mm_set1_ps(weight), _mm_loadu_ps(src))));
+#else
+    dst[0] += weight * src[0];
+    dst[1] += weight * src[1];
+    dst[2] += weight * src[2];
+    dst[3] += weight * src[3];
+#endif
+}
+
+static void Downsample(const MipImage &src, MipImage &dst, MipFilter filter) {
+    MipAxisFilter horizontal = BuildAxisFilter(src.width, dst.width, filter);
+    MipAxisFilter vertical   = BuildAxisFilter(src.height, dst.height, filter);
+
+    /// separable, rows of src are filtered on demand per dst row so no full size temporary is needed
+    ParallelFor(dst.height, GetRowGrain(dst.width), [&](size_t begin, size_t end) {
+        std::vector<float> rowSum((size_t) src.width * 4);
+        for (size_t y = begin; y < end; ++y) {
+            std::fill(rowSum.begin(), rowSum.end(), 0.f);
+            for (UInt32 t = vertical.offsets[y]; t < vertical.offsets[y + 1]; ++t) {
+                const float *srcRow = src.row(vertical.taps[t].index);
+                float        weight = vertical.taps[t].weight;
+                for (UInt32 x = 0; x < src.width; ++x) {
+                    AccumulateTexel(rowSum.data() + x * 4, srcRow + x * 4, weight);
+                }
+            }
+
+            float *dstRow = dst.row((UInt32) y);
+            for (UInt32 x = 0; x < dst.width; ++x) {
+                float *texel = dstRow + x * 4;
+                texel[0] = texel[1] = texel[2] = texel[3] = 0.f;
+                for (UInt32 t = horizontal.offsets[x]; t < horizontal.offsets[x + 1]; ++t) {
+                    AccumulateTexel(texel, rowSum.data() + horizontal.taps[t].index * 4, horizontal.taps[t].weight);
+                }
+            }
+        }
+    });
+}
+
+static float CalculateAlphaCoverage(const MipImage &image, float cutoff) {
+    size_t count = 0;
+    for (size_t i = 3; i < image.texels.size(); i += 4) {
+        count += image.texels[i] > cutoff;
+    }
+    return (float) count / (float) (image.width * image.height);
+}
+
+/// the scale that lets the same share of texels pass the cutoff, found from the alpha of the nth texel
+static float CalculateAlphaScale(const MipImage &image, float cutoff, float coverage) {
+    std::vector<float> alphas;
+    alphas.reserve((size_t) image.width * image.height);
+    for (size_t i = 3; i < image.texels.size(); i += 4) {
+        alphas.push_back(image.texels[i]);
+    }
+    size_t count = (size_t) std::lround(coverage * (float) alphas.size());
+    if (count == 0 || count > alphas.size()) return 1.f;
+
+    auto nth = alphas.begin() + (alphas.size() - count);
+    std::nth_element(alphas.begin(), nth, alphas.end());
+    if (*nth < 1e-4f) return 1.f;
+
+    /// half a step of 8 bits above the cutoff so the nth texel still passes after rounding
+    return (cutoff + 0.5f / 255.f) / *nth;
+}
+
+UInt32 CalculateMipCount(UInt32 width, UInt32 height) {
+    UInt32 size  = std::max(width, height);
+    UInt32 count = 1;
+    while (size > 1) {
+        size >>= 1;
+        ++count;
+    }
+    return count;
+}
+
+UInt64 CalculateMipOffset(PixelFormat pixelFormat, UInt32 width, UInt32 height, UInt32 level) {
+    UInt64 offset = 0;
+    for (UInt32 i = 0; i < level; ++i) {
+        offset += CalculatePixelFormatSize(pixelFormat, CalculateMipSize(width, i), CalculateMipSize(height, i));
+    }
+    return offset;
+}
+
+UInt64 CalculateMipChainSize(PixelFormat pixelFormat, UInt32 width, UInt32 height, UInt32 mipCount) {
+    return CalculateMipOffset(pixelFormat, width, height, std::max(mipCount, 1U));
+}
+
+bool IsMipChainFormatSupported(PixelFormat pixelFormat) {
+    return GetChannelCount(pixelFormat) != 0;
+}
+
+bool GenerateMipChain(UInt8 *data, UInt32 width, UInt32 height, PixelFormat pixelFormat, UInt32 mipCount,
+                      const MipChainSettings &settings) {
+    UInt32 channels = GetChannelCount(pixelFormat);
+    if (channels == 0 || width == 0 || height == 0) return false;
+    mipCount = std::min(mipCount, CalculateMipCount(width, height));
+    if (mipCount <= 1) return true;
+
+    bool bSRGB          = IsSRGBPixelFormat(pixelFormat);
+    bool bAlphaCoverage = settings.bPreserveAlphaCoverage && channels == 4;
+
+    /// every level is filtered from the float level above it, not from the rounded bytes
+    MipImage source, target;
+    source.resize(width, height);
+    Decode(data, channels, bSRGB, source);
+
+    float coverage = bAlphaCoverage ? CalculateAlphaCoverage(source, settings.alphaCutoff) : 0.f;
+
+    for (UInt32 level = 1; level < mipCount; ++level) {
+        target.resize(CalculateMipSize(width, level), CalculateMipSize(height, level));
+        Downsample(source, target, settings.filter);
+
+        float alphaScale = bAlphaCoverage ? CalculateAlphaScale(target, settings.alphaCutoff, coverage) : 1.f;
+        Encode(target, channels, bSRGB, alphaScale, data + CalculateMipOffset(pixelFormat, width, height, level));
+
+        std::swap(source, target);
+    }
+    return true;
+}
+
+}
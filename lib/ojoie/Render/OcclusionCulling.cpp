@@ -0,0 +1,358 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/OcclusionCulling.hpp"
+#include "Threads/ParallelFor.hpp"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCCLUSION_CULLING_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace AN {
+
+/// vertices closer than this are not rasterized, the occluder is then only partially drawn which stays conservative
+static constexpr float kMinClipW = 1e-5f;
+
+/// a hiz level is chosen so the tested rect spans at most this many texels per axis
+static constexpr UInt32 kMaxTestTexels = 4;
+
+static constexpr size_t kOccludeeGrainSize = 64;
+
+OcclusionCulling::OcclusionCulling() : m_ViewProj(1.f) {
+    setSettings(OcclusionCullingSettings{});
+}
+
+void OcclusionCulling::setSettings(const OcclusionCullingSettings &settings) {
+    m_Settings = settings;
+    m_Settings.width  = (std::max(m_Settings.width, 4U) + 3) & ~3U;
+    m_Settings.height = std::max(m_Settings.height, 1U);
+
+    m_HiZ.clear();
+    UInt32 width = m_Settings.width, height = m_Settings.height;
+    for (;;) {
+        HiZLevel &level = m_HiZ.emplace_back();
+        level.width  = width;
+        level.height = height;
+        level.depth.assign(width * height, 1.f);
+        if (width == 1 && height == 1) break;
+        width  = (width + 1) / 2;
+        height = (height + 1) / 2;
+    }
+
+    m_StripBins.resize((m_Settings.height + kStripHeight - 1) / kStripHeight);
+}
+
+void OcclusionCulling::beginFrame(const Matrix4x4f &viewProj) {
+    m_ViewProj = viewProj;
+    ExtractProjectionPlanes(viewProj, m_FrustumPlanes);
+
+    for (HiZLevel &level : m_HiZ) {
+        std::fill(level.depth.begin(), level.depth.end(), 1.f);
+    }
+    m_Stats = {};
+}
+
+float OcclusionCulling::getScreenArea(const AABB &bounds) const {
+    Vector2f minNDC(FLT_MAX), maxNDC(-FLT_MAX);
+    for (int i = 0; i < 8; ++i) {
+        Vector3f corner = bounds.center + bounds.extent * Vector3f(i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f);
+        Vector4f clip   = m_ViewProj * Vector4f(corner, 1.f);
+        if (clip.w <= kMinClipW) return 1.f;
+        Vector2f ndc = Vector2f(clip) / clip.w;
+        minNDC = Math::min(minNDC, ndc);
+        maxNDC = Math::max(maxNDC, ndc);
+    }
+    minNDC = Math::clamp(minNDC, Vector2f(-1.f), Vector2f(1.f));
+    maxNDC = Math::clamp(maxNDC, Vector2f(-1.f), Vector2f(1.f));
+    return (maxNDC.x - minNDC.x) * (maxNDC.y - minNDC.y) * 0.25f;
+}
+
+void OcclusionCulling::selectOccluders(std::span<const OccluderCandidate> candidates, std::vector<UInt32> &outIndices) const {
+    std::vector<std::pair<float, UInt32>> scored;
+    for (UInt32 i = 0; i < candidates.size(); ++i) {
+        const OccluderCandidate &candidate = candidates[i];
+        if (!candidate.bForced && !m_Settings.autoSelectOccluders) continue;
+        if (!IntersectAABBPlaneBounds(candidate.bounds, m_FrustumPlanes, kPlaneFrustumNum)) continue;
+
+        float area = getScreenArea(candidate.bounds);
+        if (candidate.bForced) {
+            area += 2.f; // above any auto selected one
+        } else if (area < m_Settings.minOccluderScreenSize) {
+            continue;
+        }
+        scored.emplace_back(area, i);
+    }
+
+    /// stable order for equal areas so the selection does not flicker
+    std::stable_sort(scored.begin(), scored.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+    scored.resize(std::min<size_t>(scored.size(), m_Settings.maxOccluders));
+
+    outIndices.clear();
+    for (const auto &item : scored) {
+        outIndices.push_back(item.second);
+    }
+}
+
+void OcclusionCulling::setupTriangles(const OccluderMesh &occluder, std::vector<ScreenTriangle> &outTriangles) const {
+    outTriangles.clear();
+
+    const float width  = (float) m_Settings.width;
+    const float height = (float) m_Settings.height;
+
+    thread_local std::vector<Vector4f> clipVertices;
+    clipVertices.resize(occluder.vertexCount);
+
+    Matrix4x4f mvp = m_ViewProj * occluder.objectToWorld;
+    for (UInt32 i = 0; i < occluder.vertexCount; ++i) {
+        clipVertices[i] = mvp * Vector4f(occluder.vertices[i], 1.f);
+    }
+
+    const UInt16 *indices16 = (const UInt16 *) occluder.indices;
+    const UInt32 *indices32 = (const UInt32 *) occluder.indices;
+    auto getIndex = [&](UInt32 i) -> UInt32 {
+        return occluder.indexFormat == kIndexFormatUInt32 ? indices32[i] : indices16[i];
+    };
+
+    for (UInt32 i = 0; i + 2 < occluder.indexCount; i += 3) {
+        UInt32 i0 = getIndex(i), i1 = getIndex(i + 1), i2 = getIndex(i + 2);
+        if (i0 >= occluder.vertexCount || i1 >= occluder.vertexCount || i2 >= occluder.vertexCount) continue;
+
+        const Vector4f *clip[3] = { &clipVertices[i0], &clipVertices[i1], &clipVertices[i2] };
+        if (clip[0]->w < kMinClipW || clip[1]->w < kMinClipW || clip[2]->w < kMinClipW) continue;
+
+        ScreenTriangle tri;
+        tri.maxDepth = 0.f;
+        for (int v = 0; v < 3; ++v) {
+            float invW = 1.f / clip[v]->w;
+            tri.x[v]     = (clip[v]->x * invW * 0.5f + 0.5f) * width;
+            tri.y[v]     = (clip[v]->y * invW * 0.5f + 0.5f) * height;
+            tri.maxDepth = std::max(tri.maxDepth, clip[v]->z * invW);
+        }
+
+        /// nothing behind the far plane can occlude
+        if (tri.maxDepth >= 1.f) continue;
+
+        float area = (tri.x[1] - tri.x[0]) * (tri.y[2] - tri.y[0]) - (tri.x[2] - tri.x[0]) * (tri.y[1] - tri.y[0]);
+        if (std::abs(area) < 1e-6f) continue;
+        if (area < 0.f) {
+            /// occluders are drawn double sided, make every triangle counter clockwise
+            std::swap(tri.x[1], tri.x[2]);
+            std::swap(tri.y[1], tri.y[2]);
+        }
+
+        float minX = std::min({ tri.x[0], tri.x[1], tri.x[2] });
+        float maxX = std::max({ tri.x[0], tri.x[1], tri.x[2] });
+        float minY = std::min({ tri.y[0], tri.y[1], tri.y[2] });
+        float maxY = std::max({ tri.y[0], tri.y[1], tri.y[2] });
+        if (maxX < 0.f || maxY < 0.f || minX >= width || minY >= height) continue;
+
+        tri.minY = (UInt32) std::max(minY, 0.f);
+        tri.maxY = (UInt32) std::min(maxY, height - 1.f);
+        outTriangles.push_back(tri);
+    }
+}
+
+void OcclusionCulling::rasterizeStrip(UInt32 strip) {
+    HiZLevel &buffer = m_HiZ[0];
+    const UInt32 width    = buffer.width;
+    const UInt32 rowBegin = strip * kStripHeight;
+    const UInt32 rowEnd   = std::min(rowBegin + kStripHeight, buffer.height);
+
+    for (const ScreenTriangle *tri : m_StripBins[strip]) {
+        /// edge function e = a * x + b * y + c, inside is positive, pixels are sampled at the center
+        /// so shared edges are watertight, occludee rects are grown by one pixel to stay conservative
+        float a[3], b[3], c[3];
+        for (int e = 0; e < 3; ++e) {
+            int n  = (e + 1) % 3;
+            a[e]   = tri->y[e] - tri->y[n];
+            b[e]   = tri->x[n] - tri->x[e];
+            c[e]   = -(a[e] * tri->x[e] + b[e] * tri->y[e]);
+        }
+
+        float  minX = std::min({ tri->x[0], tri->x[1], tri->x[2] });
+        float  maxX = std::max({ tri->x[0], tri->x[1], tri->x[2] });
+        UInt32 x0   = (UInt32) std::max(minX, 0.f) & ~3U;
+        UInt32 x1   = (UInt32) std::min(maxX, (float) (width - 1));
+
+        UInt32 y0 = std::max(rowBegin, tri->minY);
+        UInt32 y1 = std::min(rowEnd - 1, tri->maxY);
+        if (y0 > y1) continue;
+
+        for (UInt32 y = y0; y <= y1; ++y) {
+            float  py  = (float) y + 0.5f;
+            float *row = buffer.depth.data() + y * width;
+
+#ifdef OCCLUSION_CULLING_USE_SSE
+            __m128 depth = _mm_set1_ps(tri->maxDepth);
+            __m128 zero  = _mm_setzero_ps();
+            __m128 clear = _mm_set1_ps(1.f);
+            __m128 e0Row = _mm_set1_ps(b[0] * py + c[0]);
+            __m128 e1Row = _mm_set1_ps(b[1] * py + c[1]);
+            __m128 e2Row = _mm_set1_ps(b[2] * py + c[2]);
+            __m128 a0 = _mm_set1_ps(a[0]), a1 = _mm_set1_ps(a[1]), a2 = _mm_set1_ps(a[2]);
+
+            /// width is a multiple of 4, so the last group never goes past the row
+            for (UInt32 x = x0; x <= x1; x += 4) {
+                __m128 px = _mm_add_ps(_mm_set1_ps((float) x), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+                __m128 e0 = _mm_add_ps(_mm_mul_ps(a0, px), e0Row);
+                __m128 e1 = _mm_add_ps(_mm_mul_ps(a1, px), e1Row);
+                __m128 e2 = _mm_add_ps(_mm_mul_ps(a2, px), e2Row);
+                __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+                if (_mm_movemask_ps(inside) == 0) continue;
+
+                __m128 candidate = _mm_or_ps(_mm_and_ps(inside, depth), _mm_andnot_ps(inside, clear));
+                _mm_storeu_ps(row + x, _mm_min_ps(_mm_loadu_ps(row + x), candidate));
+            }
+#else
+            for (UInt32 x = x0; x <= x1; ++x) {
+                float px = (float) x + 0.5f;
+                if (a[0] * px + b[0] * py + c[0] >= 0.f &&
+                    a[1] * px + b[1] * py + c[1] >= 0.f &&
+                    a[2] * px + b[2] * py + c[2] >= 0.f) {
+                    row[x] = std::min(row[x], tri->maxDepth);
+                }
+            }
+#endif
+        }
+    }
+}
+
+void OcclusionCulling::buildHiZLevel(UInt32 level) {
+    const HiZLevel &src = m_HiZ[level - 1];
+    HiZLevel       &dst = m_HiZ[level];
+
+    ParallelFor(dst.height, kStripHeight, [&src, &dst](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            const float *r0  = src.depth.data() + std::min<size_t>(2 * y, src.height - 1) * src.width;
+            const float *r1  = src.depth.data() + std::min<size_t>(2 * y + 1, src.height - 1) * src.width;
+            float       *out = dst.depth.data() + y * dst.width;
+
+            UInt32 x = 0;
+#ifdef OCCLUSION_CULLING_USE_SSE
+            for (; 2 * x + 7 < src.width; x += 4) {
+                __m128 top = _mm_max_ps(_mm_loadu_ps(r0 + 2 * x), _mm_loadu_ps(r1 + 2 * x));
+                __m128 bot = _mm_max_ps(_mm_loadu_ps(r0 + 2 * x + 4), _mm_loadu_ps(r1 + 2 * x + 4));
+                __m128 even = _mm_shuffle_ps(top, bot, _MM_SHUFFLE(2, 0, 2, 0));
+                __m128 odd  = _mm_shuffle_ps(top, bot, _MM_SHUFFLE(3, 1, 3, 1));
+                _mm_storeu_ps(out + x, _mm_max_ps(even, odd));
+            }
+#endif
+            for (; x < dst.width; ++x) {
+                UInt32 a = 2 * x, b = std::min(2 * x + 1, src.width - 1);
+                out[x] = std::max(std::max(r0[a], r0[b]), std::max(r1[a], r1[b]));
+            }
+        }
+    });
+}
+
+void OcclusionCulling::renderOccluders(std::span<const OccluderMesh> occluders) {
+    Timer timer;
+
+    if (m_OccluderTriangles.size() < occluders.size()) {
+        m_OccluderTriangles.resize(occluders.size());
+    }
+    ParallelFor(occluders.size(), 1, [this, occluders](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            setupTriangles(occluders[i], m_OccluderTriangles[i]);
+        }
+    });
+
+    for (auto &bin : m_StripBins) {
+        bin.clear();
+    }
+    for (size_t i = 0; i < occluders.size(); ++i) {
+        for (const ScreenTriangle &tri : m_OccluderTriangles[i]) {
+            for (UInt32 strip = tri.minY / kStripHeight; strip <= tri.maxY / kStripHeight; ++strip) {
+                m_StripBins[strip].push_back(&tri);
+            }
+        }
+        m_Stats.occluderTriangleCount += m_OccluderTriangles[i].size();
+    }
+    m_Stats.occluderCount += occluders.size();
+    m_Stats.setupMs += timer.mark() * 1000.f;
+
+    /// strips do not overlap, so no two threads write the same pixel
+    ParallelFor(m_StripBins.size(), 1, [this](size_t begin, size_t end) {
+        for (size_t strip = begin; strip < end; ++strip) {
+            rasterizeStrip(strip);
+        }
+    });
+    m_Stats.rasterizeMs += timer.mark() * 1000.f;
+
+    for (UInt32 level = 1; level < m_HiZ.size(); ++level) {
+        buildHiZLevel(level);
+    }
+    m_Stats.buildHiZMs += timer.mark() * 1000.f;
+}
+
+OcclusionResult OcclusionCulling::testOccludee(const AABB &bounds) const {
+    if (!IntersectAABBPlaneBounds(bounds, m_FrustumPlanes, kPlaneFrustumNum)) return kOcclusionFrustumCulled;
+
+    const HiZLevel &buffer = m_HiZ[0];
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX, minZ = FLT_MAX;
+    for (int i = 0; i < 8; ++i) {
+        Vector3f corner = bounds.center + bounds.extent * Vector3f(i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f);
+        Vector4f clip   = m_ViewProj * Vector4f(corner, 1.f);
+        if (clip.w <= kMinClipW) return kOcclusionVisible;
+
+        float invW = 1.f / clip.w;
+        float x    = (clip.x * invW * 0.5f + 0.5f) * (float) buffer.width;
+        float y    = (clip.y * invW * 0.5f + 0.5f) * (float) buffer.height;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        minZ = std::min(minZ, clip.z * invW);
+    }
+    if (minZ <= 0.f) return kOcclusionVisible;
+
+    /// every pixel the projected bounds touch, plus one pixel guard band
+    /// for occluder pixels which are covered only at their centers
+    int x0 = std::max((int) std::floor(minX) - 1, 0);
+    int y0 = std::max((int) std::floor(minY) - 1, 0);
+    int x1 = std::min((int) std::floor(maxX) + 1, (int) buffer.width - 1);
+    int y1 = std::min((int) std::floor(maxY) + 1, (int) buffer.height - 1);
+    if (x0 > x1 || y0 > y1) return kOcclusionVisible;
+
+    UInt32 level = 0;
+    while (level + 1 < m_HiZ.size() &&
+           (((x1 >> level) - (x0 >> level) + 1) > (int) kMaxTestTexels ||
+            ((y1 >> level) - (y0 >> level) + 1) > (int) kMaxTestTexels)) {
+        ++level;
+    }
+
+    const HiZLevel &hiz = m_HiZ[level];
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        const float *row = hiz.depth.data() + y * hiz.width;
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            if (row[x] >= minZ) return kOcclusionVisible;
+        }
+    }
+    return kOcclusionOccluded;
+}
+
+void OcclusionCulling::testOccludees(std::span<const AABB> bounds, std::span<OcclusionResult> outResults) {
+    Timer timer;
+
+    ParallelFor(bounds.size(), kOccludeeGrainSize, [this, bounds, outResults](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            outResults[i] = testOccludee(bounds[i]);
+        }
+    });
+
+    m_Stats.occludeeCount += bounds.size();
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        m_Stats.frustumCulledCount   += outResults[i] == kOcclusionFrustumCulled;
+        m_Stats.occlusionCulledCount += outResults[i] == kOcclusionOccluded;
+    }
+    m_Stats.testMs += timer.mark() * 1000.f;
+}
+
+}
@@ -3,9 +3,13 @@
 //
 
 #include "Render/QualitySettings.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace AN {
 
+/// closest a manual split may get to the camera or the shadow distance
+static constexpr float kMinShadowCascadeSplit = 0.001f;
 
 static void InitializeDefaultQualitySettings(std::vector<QualitySetting> &settings) {
     settings.resize(4);
@@ -14,21 +18,46 @@ static void InitializeDefaultQualitySettings(std::vector<QualitySetting> &settin
     settings[0].targetResolution = { 800, 600 };
     settings[0].vSyncCount = 1;
     settings[0].antiAliasing = 0;
+    settings[0].shadowCascades = 1;
+    settings[0].shadowResolution = 1024;
+    settings[0].shadowDistance = 40.f;
+    settings[0].lodBias = 0.7f;
 
     settings[1].name = "Medium";
     settings[1].targetResolution = { 1920, 1080 };
     settings[1].vSyncCount = 0;
     settings[1].antiAliasing = 2;
+    settings[1].shadowCascades = 2;
+    settings[1].shadowResolution = 1024;
+    settings[1].shadowDistance = 60.f;
+    settings[1].lodBias = 1.f;
 
     settings[2].name = "High";
     settings[2].targetResolution = { 2048, 1080 };
     settings[2].vSyncCount = 0;
     settings[2].antiAliasing = 4;
+    settings[2].shadowCascades = 4;
+    settings[2].shadowResolution = 2048;
+    settings[2].shadowDistance = 100.f;
+    settings[2].lodBias = 1.5f;
 
     settings[3].name = "Ultra";
     settings[3].targetResolution = { 3840, 2160 };
     settings[3].vSyncCount = 0;
     settings[3].antiAliasing = 4;
+    settings[3].shadowCascades = 4;
+    settings[3].shadowResolution = 2048;
+    settings[3].shadowDistance = 150.f;
+    settings[3].lodBias = 2.f;
+
+    for (QualitySetting &setting : settings) {
+        setting.shadowCascadeSplitMode = kShadowCascadeSplitLogarithmic;
+        setting.shadowCascadeSplitLambda = 0.75f;
+        setting.shadowCascadeSplits[0] = 0.067f;
+        setting.shadowCascadeSplits[1] = 0.2f;
+        setting.shadowCascadeSplits[2] = 0.467f;
+        setting.maximumLODLevel = 0;
+    }
 }
 
 
@@ -38,6 +67,21 @@ QualitySettings::QualitySettings() {
 }
 
 void QualitySettings::checkConsistency() {
+    QualitySetting &setting = _settings[_current];
+    setting.shadowCascades = std::clamp<UInt32>(setting.shadowCascades, 1, kMaxShadowCascades);
+    setting.shadowResolution = std::clamp<UInt32>(setting.shadowResolution, 256, 8192);
+    setting.shadowDistance = std::max(setting.shadowDistance, 1.f);
+    setting.shadowCascadeSplitLambda = std::clamp(setting.shadowCascadeSplitLambda, 0.f, 1.f);
+    if (setting.shadowCascadeSplitMode != kShadowCascadeSplitManual) {
+        setting.shadowCascadeSplitMode = kShadowCascadeSplitLogarithmic;
+    }
+    /// manual splits are fractions of the shadow distance inside (0, 1), ascending
+    for (float &split : setting.shadowCascadeSplits) {
+        split = std::isnan(split) ? 0.5f : std::clamp(split, kMinShadowCascadeSplit, 1.f - kMinShadowCascadeSplit);
+    }
+    std::sort(std::begin(setting.shadowCascadeSplits), std::end(setting.shadowCascadeSplits));
+    setting.lodBias = std::max(setting.lodBias, 0.01f);
+    setting.maximumLODLevel = std::min<UInt32>(setting.maximumLODLevel, kMaxLODLevels - 1);
 
 }
 
@@ -69,6 +113,65 @@ void QualitySettings::setAntiAliasing(UInt32 aa) {
     applyExpensive();
 }
 
+void QualitySettings::setShadowCascades(UInt32 cascades) {
+    if (_settings[_current].shadowCascades == cascades) return;
+
+    _settings[_current].shadowCascades = cascades;
+    checkConsistency();
+}
+
+void QualitySettings::setShadowResolution(UInt32 resolution) {
+    if (_settings[_current].shadowResolution == resolution) return;
+
+    _settings[_current].shadowResolution = resolution;
+    checkConsistency();
+}
+
+void QualitySettings::setShadowDistance(float distance) {
+    if (_settings[_current].shadowDistance == distance) return;
+
+    _settings[_current].shadowDistance = distance;
+    checkConsistency();
+}
+
+void QualitySettings::setShadowCascadeSplitMode(ShadowCascadeSplitMode mode) {
+    _settings[_current].shadowCascadeSplitMode = mode;
+    checkConsistency();
+}
+
+void QualitySettings::setShadowCascadeSplitLambda(float lambda) {
+    _settings[_current].shadowCascadeSplitLambda = lambda;
+    checkConsistency();
+}
+
+void QualitySettings::setShadowCascadeSplits(const float *splits, UInt32 count) {
+    count = std::min<UInt32>(count, kMaxShadowCascades - 1);
+    std::copy(splits, splits + count, _settings[_current].shadowCascadeSplits);
+    _settings[_current].shadowCascadeSplitMode = kShadowCascadeSplitManual;
+    checkConsistency();
+}
+
+void QualitySettings::setLODBias(float bias) {
+    _settings[_current].lodBias = bias;
+    checkConsistency();
+}
+
+void QualitySettings::setMaximumLODLevel(UInt32 level) {
+    _settings[_current].maximumLODLevel = level;
+    checkConsistency();
+}
+
+ShadowCascadeSettings QualitySettings::getShadowCascadeSettings() const {
+    const QualitySetting &setting = _settings[_current];
+    ShadowCascadeSettings cascadeSettings{};
+    cascadeSettings.cascadeCount = setting.shadowCascades;
+    cascadeSettings.resolution = setting.shadowResolution;
+    cascadeSettings.shadowDistance = setting.shadowDistance;
+    cascadeSettings.splitMode = setting.shadowCascadeSplitMode;
+    cascadeSettings.splitLambda = setting.shadowCascadeSplitLambda;
+    std::copy(std::begin(setting.shadowCascadeSplits), std::end(setting.shadowCascadeSplits), cascadeSettings.manualSplits);
+    return cascadeSettings;
+}
 
 QualitySettings &GetQualitySettings() {
     static QualitySettings qualitySettings{};
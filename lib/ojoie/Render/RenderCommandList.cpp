@@ -0,0 +1,259 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/RenderCommandList.hpp"
+#include "Render/RenderContext.hpp"
+#include "Render/Material.hpp"
+#include "Render/VertexBuffer.hpp"
+#include "Allocator/MemoryManager.h"
+#include "Threads/ParallelFor.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace AN {
+
+TransientAllocator::TransientAllocator(size_t blockSize)
+    : m_BlockSize(blockSize), m_CurrentBlock() {}
+
+TransientAllocator::~TransientAllocator() {
+    for (Block &block : m_Blocks) {
+        free_internal(block.data);
+    }
+}
+
+void *TransientAllocator::allocate(size_t size, size_t align) {
+    ANAssert((align & (align - 1)) == 0);
+
+    while (m_CurrentBlock < m_Blocks.size()) {
+        Block &block = m_Blocks[m_CurrentBlock];
+        size_t offset = (block.used + (align - 1)) & ~(align - 1);
+        if (offset + size <= block.size) {
+            block.used = offset + size;
+            return block.data + offset;
+        }
+        ++m_CurrentBlock;
+    }
+
+    /// no room, allocate new block, large allocation get a dedicated block
+    Block block;
+    block.size = std::max(m_BlockSize, size);
+    block.data = (UInt8 *) malloc_internal(block.size, (int) std::max<size_t>(align, 16));
+    block.used = size;
+    m_Blocks.push_back(block);
+    m_CurrentBlock = m_Blocks.size() - 1;
+    return block.data;
+}
+
+void TransientAllocator::reset() {
+    for (Block &block : m_Blocks) {
+        block.used = 0;
+    }
+    m_CurrentBlock = 0;
+}
+
+size_t TransientAllocator::getUsedBytes() const {
+    size_t bytes = 0;
+    for (const Block &block : m_Blocks) {
+        bytes += block.used;
+    }
+    return bytes;
+}
+
+size_t TransientAllocator::getReservedBytes() const {
+    size_t bytes = 0;
+    for (const Block &block : m_Blocks) {
+        bytes += block.size;
+    }
+    return bytes;
+}
+
+void RenderCommandList::reset() {
+    m_Commands.clear();
+    m_EncodedMaterials.clear();
+    m_Allocator.reset();
+}
+
+const PerDrawData *RenderCommandList::allocatePerDraw(const Matrix4x4f &objectToWorld, const Matrix4x4f &worldToObject, float lodFade,
+                                                     const VertexCompressionData *compression) {
+    PerDrawData *perDraw          = m_Allocator.allocate<PerDrawData>();
+    perDraw->worldTransformParams = Vector4f(0.f, 0.f, 0.f, 1.f);
+    perDraw->objectToWorld        = objectToWorld;
+    perDraw->worldToObject        = worldToObject;
+    perDraw->lodFade              = Vector4f(lodFade, 0.f, 0.f, 0.f);
+    if (compression) {
+        perDraw->vertexCompression    = compression->compression;
+        perDraw->vertexPositionScale  = compression->positionScale;
+        perDraw->vertexPositionOffset = compression->positionOffset;
+    } else {
+        perDraw->vertexCompression    = Vector4f(0.f);
+        perDraw->vertexPositionScale  = Vector4f(1.f, 1.f, 1.f, 0.f);
+        perDraw->vertexPositionOffset = Vector4f(0.f);
+    }
+    return perDraw;
+}
+
+const EncodedMaterial *RenderCommandList::encodeMaterial(Material *material, const char *pass, bool bPerDraw) {
+    if (material == nullptr) return nullptr;
+
+    /// materials do not change while encoding, so draws of the same material and pass share one resolve
+    for (auto it = m_EncodedMaterials.rbegin(); it != m_EncodedMaterials.rend(); ++it) {
+        const EncodedMaterial *encoded = *it;
+        if (encoded->material == material && encoded->bPerDraw == bPerDraw &&
+            (encoded->pass == pass || strcmp(encoded->pass, pass) == 0)) {
+            return encoded;
+        }
+    }
+
+    const EncodedMaterial *encoded = material->encodeMaterial(*this, pass, bPerDraw);
+    if (encoded) {
+        m_EncodedMaterials.push_back(encoded);
+    }
+    return encoded;
+}
+
+void RenderCommandList::drawIndexed(Material *material, const char *pass, const PerDrawData *perDraw,
+                                    VertexBuffer *vertexBuffer, UInt32 indexCount, UInt32 indexOffset, UInt32 vertexOffset) {
+    RenderCommand &command = m_Commands.emplace_back();
+    command.type           = kRenderCommandDrawIndexed;
+    command.pass           = pass;
+    command.material       = material;
+    command.encoded        = encodeMaterial(material, pass, perDraw != nullptr);
+    command.perDraw        = perDraw;
+    command.vertexBuffer   = vertexBuffer;
+    command.count          = indexCount;
+    command.indexOffset    = indexOffset;
+    command.vertexOffset   = vertexOffset;
+    command.callback       = nullptr;
+    command.userdata       = nullptr;
+}
+
+void RenderCommandList::draw(Material *material, const char *pass, const PerDrawData *perDraw,
+                             VertexBuffer *vertexBuffer, UInt32 vertexCount) {
+    RenderCommand &command = m_Commands.emplace_back();
+    command.type           = kRenderCommandDraw;
+    command.pass           = pass;
+    command.material       = material;
+    command.encoded        = encodeMaterial(material, pass, perDraw != nullptr);
+    command.perDraw        = perDraw;
+    command.vertexBuffer   = vertexBuffer;
+    command.count          = vertexCount;
+    command.indexOffset    = 0;
+    command.vertexOffset   = 0;
+    command.callback       = nullptr;
+    command.userdata       = nullptr;
+}
+
+void RenderCommandList::callback(RenderCommandCallback callback, void *userdata, const char *pass) {
+    RenderCommand &command = m_Commands.emplace_back();
+    command.type           = kRenderCommandCallback;
+    command.pass           = pass;
+    command.material       = nullptr;
+    command.encoded        = nullptr;
+    command.perDraw        = nullptr;
+    command.vertexBuffer   = nullptr;
+    command.count          = 0;
+    command.indexOffset    = 0;
+    command.vertexOffset   = 0;
+    command.callback       = callback;
+    command.userdata       = userdata;
+}
+
+void RenderCommandList::append(const RenderCommandList &other) {
+    m_Commands.insert(m_Commands.end(), other.m_Commands.begin(), other.m_Commands.end());
+}
+
+std::span<const PerDrawProperty> GetPerDrawProperties() {
+    /// looked up in the name table once instead of per draw
+    static const PerDrawProperty properties[] = {
+        { "an_WorldTransformParams", offsetof(PerDrawData, worldTransformParams), sizeof(Vector4f) },
+        { "an_ObjectToWorld", offsetof(PerDrawData, objectToWorld), sizeof(Matrix4x4f) },
+        { "an_WorldToObject", offsetof(PerDrawData, worldToObject), sizeof(Matrix4x4f) },
+        { "an_LODFade", offsetof(PerDrawData, lodFade), sizeof(Vector4f) },
+        { "an_VertexCompression", offsetof(PerDrawData, vertexCompression), sizeof(Vector4f) },
+        { "an_VertexPositionScale", offsetof(PerDrawData, vertexPositionScale), sizeof(Vector4f) },
+        { "an_VertexPositionOffset", offsetof(PerDrawData, vertexPositionOffset), sizeof(Vector4f) },
+    };
+    return properties;
+}
+
+void RenderCommandList::execute(RenderContext &context) const {
+    CommandBuffer *commandBuffer = context.commandBuffer;
+    for (const RenderCommand &command : m_Commands) {
+        if (command.type == kRenderCommandCallback) {
+            command.callback(context, command.userdata, command.pass);
+            continue;
+        }
+
+        if (command.encoded) {
+            Material::ApplyEncodedMaterial(commandBuffer, *command.encoded, command.perDraw);
+        } else {
+            /// the shader variant was not selected when encoding, apply the material the slow way,
+            /// this selects the variant so later frames encode it
+            Material &mat = *command.material;
+            if (command.perDraw) {
+                for (const PerDrawProperty &property : GetPerDrawProperties()) {
+                    const UInt8 *value = (const UInt8 *) command.perDraw + property.offset;
+                    if (property.size == sizeof(Matrix4x4f)) {
+                        mat.setMatrix(property.name, *(const Matrix4x4f *) value);
+                    } else {
+                        mat.setVector(property.name, *(const Vector4f *) value);
+                    }
+                }
+            }
+            mat.applyMaterial(commandBuffer, command.pass);
+        }
+
+        if (command.type == kRenderCommandDrawIndexed) {
+            command.vertexBuffer->drawIndexed(commandBuffer, command.count, command.indexOffset, command.vertexOffset);
+        } else {
+            command.vertexBuffer->draw(commandBuffer, command.count);
+        }
+    }
+}
+
+void ParallelRenderEncoder::encode(size_t itemCount, size_t chunkSize, RenderEncodeFunc func, void *userdata) {
+    chunkSize    = std::max<size_t>(chunkSize, 1);
+    m_ChunkCount = (itemCount + chunkSize - 1) / chunkSize;
+
+    while (m_Lists.size() < m_ChunkCount) {
+        m_Lists.push_back(std::make_unique<RenderCommandList>());
+    }
+
+    /// every chunk is encoded by exactly one worker, so the list and its allocator are thread local
+    ParallelFor(m_ChunkCount, 1, [&](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; ++chunk) {
+            RenderCommandList &list = *m_Lists[chunk];
+            list.reset();
+
+            size_t first = chunk * chunkSize;
+            size_t last  = std::min(first + chunkSize, itemCount);
+            for (size_t i = first; i < last; ++i) {
+                func(list, i, userdata);
+            }
+        }
+    });
+}
+
+size_t ParallelRenderEncoder::getCommandCount() const {
+    size_t count = 0;
+    for (size_t i = 0; i < m_ChunkCount; ++i) {
+        count += m_Lists[i]->size();
+    }
+    return count;
+}
+
+void ParallelRenderEncoder::merge(RenderCommandList &outList) const {
+    for (size_t i = 0; i < m_ChunkCount; ++i) {
+        outList.append(*m_Lists[i]);
+    }
+}
+
+void ParallelRenderEncoder::execute(RenderContext &context) const {
+    for (size_t i = 0; i < m_ChunkCount; ++i) {
+        m_Lists[i]->execute(context);
+    }
+}
+
+}
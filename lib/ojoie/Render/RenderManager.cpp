@@ -4,6 +4,11 @@
 
 #include "Render/RenderManager.hpp"
 #include "Render/TextureManager.hpp"
+#include "Render/TextureStreamer.hpp"
+#include "Render/AsyncTextureLoader.hpp"
+#ifdef OJOIE_USE_FREETYPE
+#include "Render/Font.hpp"
+#endif
 #include "Camera/Camera.hpp"
 #include "Render/RenderLoop/ForwardRenderLoop.hpp"
 #include "Render/LayerManager.hpp"
@@ -11,6 +16,8 @@
 #include "Misc/ResourceManager.hpp"
 #include "IMGUI/IMGUIManager.hpp"
 #include "Render/Light.hpp"
+#include "Render/LODGroup.hpp"
+#include "Render/Mesh/SkinningManager.hpp"
 #include "Modules/Dylib.hpp"
 
 #include "Core/Actor.hpp"
@@ -28,6 +35,9 @@
 
 namespace AN {
 
+/// textures created and uploaded from finished async loads in one frame
+static constexpr UInt32 kMaxTextureLoadCompletionsPerFrame = 8;
+
 #ifdef OJOIE_WITH_EDITOR
 typedef RENDERDOC_API_1_0_0 RenderDocApi;
 #define RenderDocApiVersion eRENDERDOC_API_Version_1_0_0
@@ -226,6 +236,10 @@ void RenderManager::deinit() {
     sceneViewSelectedTarget.reset();
 #endif//OJOIE_WITH_EDITOR
 
+    GetTextureStreamer().shutdown();
+#ifdef OJOIE_USE_FREETYPE
+    GetFontManager().deinit();
+#endif
     delete _commandPool;
     resolveTexture.reset();
     screenRenderTarget.reset();
@@ -244,11 +258,22 @@ void RenderManager::performUpdate(UInt32 frameVersion) {
     UInt32 updateFrameIndex = frameVersion % kMaxFrameInFlight;
 
     GetLightManager().update();
+    GetLODGroupManager().update();
+
+    /// spread the uploads of large batches of async loads over frames
+    GetAsyncTextureLoader().update(kMaxTextureLoadCompletionsPerFrame);
 
+    /// mips requested by the cameras of the last rendered frame
+    GetTextureStreamer().update(frameVersion);
+#ifdef OJOIE_USE_FREETYPE
+    /// glyphs rasterized since the last frame, before the cameras lay out text
+    GetFontManager().update(frameVersion);
+#endif
     GetTextureManager().update(frameVersion);
     GetUniformBuffers().update();
     GetCameraManager().updateCameras(updateFrameIndex);
     updateRenderers(updateFrameIndex);
+    GetSkinningManager().update(updateFrameIndex);
 
     /// update IMGUI
     GetIMGUIManager().onNewFrame();
@@ -1,6 +1,7 @@
 
 #include "Render/Renderer.hpp"
 #include "Core/Actor.hpp"
+#include "Render/LODGroup.hpp"
 #include "Render/RenderManager.hpp"
 #include <unordered_set>
 
@@ -12,7 +13,7 @@ LOAD_AN_CLASS(Renderer)
 IMPLEMENT_AN_OBJECT_SERIALIZE(Renderer)
 INSTANTIATE_TEMPLATE_TRANSFER(Renderer)
 
-Renderer::Renderer(ObjectCreationMode mode) : Super(mode), bAddToManager() {}
+Renderer::Renderer(ObjectCreationMode mode) : Super(mode), bAddToManager(), bHasWorldAABB(), bLODCulled(), m_LODFade(1.f) {}
 
 Renderer::~Renderer() {}
 
@@ -40,13 +41,28 @@ void Renderer::setMaterial(UInt32 index, Material *material) {
     }
 }
 
+void Renderer::Encode(RenderCommandList &list, UInt32 frameIndex, const char *pass) {
+    list.callback([](RenderContext &context, void *userdata, const char *pass) {
+        ((Renderer *) userdata)->Render(context, pass);
+    }, this, pass);
+}
+
 void Renderer::dealloc() {
     if (bAddToManager) {
         GetRenderManager().removeRenderer(_rendererListNode);
     }
+    for (LODGroup *group : m_LODGroups) {
+        group->removeRenderer(this);
+    }
+    m_LODGroups.clear();
     Super::dealloc();
 }
 
+void Renderer::getResourceReferences(std::vector<Object *> &references) const {
+    Super::getResourceReferences(references);
+    references.insert(references.end(), _materials.begin(), _materials.end());
+}
+
 template<typename _Coder>
 void Renderer::transfer(_Coder &coder)
 {
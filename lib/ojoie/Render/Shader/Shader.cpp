@@ -15,6 +15,9 @@
 #include <ojoie/Render/RenderContext.hpp>
 
 #include <ojoie/Threads/Dispatch.hpp>
+#include <ojoie/Threads/ParallelFor.hpp>
+#include <ojoie/Render/Shader/ShaderCache.hpp>
+#include <ojoie/Render/Shader/ShaderIncludeCache.hpp>
 #include "HAL/File.hpp"
 #include "Render/private/D3D11/UniformBuffers.hpp"
 
@@ -27,6 +30,7 @@
 #include <spirv-tools/libspirv.hpp>
 #include <spirv-tools/optimizer.hpp>
 #endif//OJOIE_USE_SPIRV
+#include <atomic>
 #include <filesystem>
 
 namespace AN {
@@ -124,6 +128,7 @@ void Shader::transfer(_Coder &coder) {
     Super::transfer(coder);
     TRANSFER(_scriptPath);
     TRANSFER(_includes);
+    TRANSFER(_includeDependencies);
     TRANSFER(subShaders);
     TRANSFER(shaderLabProperties);
 }
@@ -142,15 +147,22 @@ void Shader::dealloc() {
 }
 
 
+static void DestroyVariantGPUObject(Shader::Variant &variant) {
+    if (variant.renderPipelineState != nullptr) {
+        variant.renderPipelineState->deinit();
+        delete variant.renderPipelineState;
+        variant.renderPipelineState = nullptr;
+    }
+}
+
 void Shader::destroyGPUObject() {
     /// may pending destroy the subShaders
     for (int i = 0; i < subShaders.size(); ++i) {
         for (int j = 0; j < subShaders[i].passes.size(); ++j) {
             auto &pass = subShaders[i].passes[j];
-            if (pass.renderPipelineState != nullptr) {
-                pass.renderPipelineState->deinit();
-                delete pass.renderPipelineState;
-                pass.renderPipelineState = nullptr;
+            DestroyVariantGPUObject(pass);
+            for (Variant &variant : pass.variants) {
+                DestroyVariantGPUObject(variant);
             }
         }
     }
@@ -171,22 +183,12 @@ bool Shader::setScript(std::string_view scriptPath, std::span<const char *> incl
 }
 
 bool Shader::setScriptText(const char *text, std::span<const char *> includes) {
+    _includeDependencies.clear();
     _includes.clear();
-
-    std::vector<const char *> includePaths;
     for (const char *inc : includes) {
         _includes.emplace_back(inc);
-        includePaths.push_back(inc);
     }
 
-#undef GetCurrentDirectory
-
-    /// adding default include path
-    std::string curDir = GetApplicationFolder();
-    std::string stdlibDir = curDir + "/Data/CGIncludes/stdlib";
-    includePaths.push_back(stdlibDir.c_str());
-
-
     ShaderLab::Lexer  lexer(text);
     ShaderLab::Parser parser(lexer);
 
@@ -203,64 +205,302 @@ bool Shader::setScriptText(const char *text, std::span<const char *> includes) {
 
     subShaders.clear();
 
-    int subShaderIndex = 0;
-    for (const ShaderLab::SubShader &shaderLabSubShader : shaderInfo.subShaders) {
+    for (UInt32 subShaderIndex = 0; subShaderIndex < shaderInfo.subShaders.size(); ++subShaderIndex) {
+        const ShaderLab::SubShader &shaderLabSubShader = shaderInfo.subShaders[subShaderIndex];
         subShaders.emplace_back();
         SubShader &subShader = subShaders.back();
         subShader.shaderLabTagMap = shaderLabSubShader.tagMap;
-        int passIndex = 0;
-        for (const ShaderLab::ShaderPass &shaderLabPass : shaderLabSubShader.passes) {
+        for (UInt32 passIndex = 0; passIndex < shaderLabSubShader.passes.size(); ++passIndex) {
             subShader.passes.emplace_back();
             Pass &pass = subShader.passes.back();
-            pass.shaderLabPass = shaderLabPass;
+            pass.shaderLabPass = shaderLabSubShader.passes[passIndex];
 
-            std::string realSource;
+            std::string &realSource = pass.source;
             realSource.reserve(shaderInfo.subShaderHLSLIncludes[subShaderIndex].size() +
                                shaderInfo.passHLSLSources[subShaderIndex][passIndex].size());
             realSource.append(shaderInfo.subShaderHLSLIncludes[subShaderIndex]);
             realSource.append("\r\n");
             realSource.append(shaderInfo.passHLSLSources[subShaderIndex][passIndex]);
+        }
+    }
+
+    if (!initKeywords()) return false;
+
+    /// only the variant without keywords is compiled here, the others on first use
+    std::vector<Variant *>    variants;
+    std::vector<const Pass *> passes;
+    for (SubShader &subShader : subShaders) {
+        for (Pass &pass : subShader.passes) {
+            pass.keywordMask = pass.keywordSpace.getDefaultMask();
+            variants.push_back(&pass);
+            passes.push_back(&pass);
+        }
+    }
+
+    bool bSucceeded = compileVariants(variants, passes);
+
+    /// passes without keywords never compile again
+    for (SubShader &subShader : subShaders) {
+        for (Pass &pass : subShader.passes) {
+            if (pass.keywordSpace.empty()) std::string().swap(pass.source);
+        }
+    }
+    return bSucceeded;
+}
+
+bool Shader::initKeywords() {
+    for (SubShader &subShader : subShaders) {
+        for (Pass &pass : subShader.passes) {
+            if (!pass.keywordSpace.init(pass.shaderLabPass.keywordDeclarations)) return false;
+            pass.variantIndices.clear();
+            for (UInt32 i = 0; i < pass.variants.size(); ++i) {
+                pass.variantIndices[pass.variants[i].keywordMask] = i;
+            }
+        }
+    }
+    return true;
+}
 
-            RC::ShaderCompiler shaderCompiler;
+bool Shader::compileVariants(std::span<Variant *const> variants, std::span<const Pass *const> passes) {
 
-            if (GetGraphicsAPI() == kGraphicsAPIVulkan) {
-                pass.vertex_spv = shaderCompiler.compileHLSLToSPIRV(kShaderStageVertex,
-                                                                    realSource.c_str(),
-                                                                    "vertex_main",
-                                                                    shaderInfo.name.c_str(),
-                                                                    includePaths);
+#undef GetCurrentDirectory
 
-                if (pass.vertex_spv.empty()) return false;
+    std::vector<const char *> includePaths;
+    for (const std::string &inc : _includes) {
+        includePaths.push_back(inc.c_str());
+    }
+    /// adding default include path
+    std::string curDir = GetApplicationFolder();
+    std::string stdlibDir = curDir + "/Data/CGIncludes/stdlib";
+    includePaths.push_back(stdlibDir.c_str());
 
-                pass.fragment_spv = shaderCompiler.compileHLSLToSPIRV(kShaderStageFragment,
-                                                                      realSource.c_str(),
-                                                                      "fragment_main",
-                                                                      shaderInfo.name.c_str(),
-                                                                      includePaths);
-                if (pass.fragment_spv.empty()) return false;
+    /// includes are expanded once per pass from the shared include cache, not by the preprocessor per stage
+    ShaderIncludeCache &includeCache = GetShaderIncludeCache();
+    std::unordered_map<const Pass *, std::string> expandedSources;
+    std::vector<std::string> dependencies;
+    for (const Pass *pass : passes) {
+        if (expandedSources.contains(pass)) continue;
+        includeCache.expand(pass->source, getName().string_view(), includePaths, expandedSources[pass], &dependencies);
+        for (std::string &dependency : dependencies) {
+            if (std::find(_includeDependencies.begin(), _includeDependencies.end(), dependency) == _includeDependencies.end()) {
+                _includeDependencies.push_back(std::move(dependency));
+            }
+        }
+    }
+
+    /// every stage of every variant is one job
+    struct StageJob {
+        Variant           *variant;
+        const Pass        *pass;
+        const std::string *source;
+        ShaderStage        stage;
+    };
+    std::vector<StageJob> jobs;
+    for (size_t i = 0; i < variants.size(); ++i) {
+        const std::string *source = &expandedSources[passes[i]];
+        jobs.push_back({ variants[i], passes[i], source, kShaderStageVertex });
+        jobs.push_back({ variants[i], passes[i], source, kShaderStageFragment });
+    }
+
+    bool bSPIRV = GetGraphicsAPI() == kGraphicsAPIVulkan;
+    ShaderCache &shaderCache = GetShaderCache();
+    std::atomic<bool> bFailed = false;
+
+    ParallelFor(jobs.size(), 1, [&](size_t begin, size_t end) {
+        /// compilers are per thread, see ShaderCompiler
+        RC::ShaderCompiler        shaderCompiler;
+        std::vector<const char *> defines;
+        for (size_t i = begin; i < end; ++i) {
+            const StageJob     &job   = jobs[i];
+            const char         *entry = job.stage == kShaderStageVertex ? "vertex_main" : "fragment_main";
+            std::vector<UInt8> &code  = job.stage == kShaderStageVertex ? job.variant->vertex_spv : job.variant->fragment_spv;
+
+            job.pass->keywordSpace.getDefines(job.variant->keywordMask, defines);
+
+            /// the expanded source carries the includes, so an edited include misses the cache,
+            /// a hit does not run the preprocessor at all
+            Hash128 key = ShaderCache::ComputeKey(*job.source, entry, RC::ShaderCompiler::GetTargetProfile(job.stage, bSPIRV),
+                                                  defines, shaderCompiler.getVersionString(bSPIRV));
+            if (shaderCache.isEnabled() && shaderCache.load(key, code)) {
+                continue;
+            }
 
+            std::string source;
+            if (!shaderCompiler.preprocessHLSL(job.source->c_str(), source, getName().c_str(), includePaths, defines)) {
+                bFailed = true;
+                continue;
+            }
+
+            if (bSPIRV) {
+                code = shaderCompiler.compileHLSLToSPIRV(job.stage, source.c_str(), entry, getName().c_str());
             } else {
-                pass.vertex_spv = shaderCompiler.compileHLSLToCSO(kShaderStageVertex,
-                                                                  realSource.c_str(),
-                                                                  "vertex_main",
-                                                                  shaderInfo.name.c_str(),
-                                                                  includePaths);
+                code = shaderCompiler.compileHLSLToCSO(job.stage, source.c_str(), entry, getName().c_str());
+            }
 
-                if (pass.vertex_spv.empty()) return false;
+            if (code.empty()) {
+                bFailed = true;
+                continue;
+            }
+            if (shaderCache.isEnabled()) {
+                shaderCache.store(key, code);
+            }
+        }
+    });
 
-                pass.fragment_spv = shaderCompiler.compileHLSLToCSO(kShaderStageFragment,
-                                                                    realSource.c_str(),
-                                                                    "fragment_main",
-                                                                    shaderInfo.name.c_str(),
-                                                                    includePaths);
-                if (pass.fragment_spv.empty()) return false;
+    return !bFailed;
+}
 
+Shader::Variant &Shader::getVariant(UInt32 passIndex, UInt32 subShaderIndex, const ShaderKeywordSet &keywords) {
+    Pass &pass = subShaders[subShaderIndex].passes[passIndex];
+    Variant *variant = &pass;
+
+    if (!pass.keywordSpace.empty()) {
+        UInt64 mask = pass.keywordSpace.getMask(keywords);
+        if (mask != pass.keywordMask) {
+            auto it = pass.variantIndices.find(mask);
+            if (it != pass.variantIndices.end()) {
+                /// kMissingVariant remembers a variant that cannot be built, the pass stands in for it
+                if (it->second != kMissingVariant) variant = &pass.variants[it->second];
+            } else if (pass.source.empty()) {
+                AN_LOG(Warning, "Shader %s pass %u variant %llx was stripped", getName().c_str(), passIndex, mask);
+                pass.variantIndices[mask] = kMissingVariant;
+            } else {
+                /// lazy compile, later frames find it in the table
+                pass.variants.emplace_back().keywordMask = mask;
+                Variant    *newVariant = &pass.variants.back();
+                const Pass *owner      = &pass;
+                if (compileVariants({ &newVariant, 1 }, { &owner, 1 }) &&
+                    createVariantGPUObject(*newVariant, pass)) {
+                    pass.variantIndices[mask] = pass.variants.size() - 1;
+                    variant = newVariant;
+                } else {
+                    AN_LOG(Error, "Shader %s pass %u variant %llx compile fail", getName().c_str(), passIndex, mask);
+                    DestroyVariantGPUObject(*newVariant);
+                    pass.variants.pop_back();
+                    pass.variantIndices[mask] = kMissingVariant;
+                }
             }
-            ++passIndex;
         }
-        ++subShaderIndex;
     }
-    return true;
+
+    variant->bUsed = true;
+    return *variant;
+}
+
+const Shader::Variant *Shader::findVariant(UInt32 passIndex, UInt32 subShaderIndex, const ShaderKeywordSet &keywords) const {
+    const Pass    &pass    = subShaders[subShaderIndex].passes[passIndex];
+    const Variant *variant = &pass;
+
+    if (!pass.keywordSpace.empty()) {
+        UInt64 mask = pass.keywordSpace.getMask(keywords);
+        if (mask != pass.keywordMask) {
+            auto it = pass.variantIndices.find(mask);
+            if (it == pass.variantIndices.end()) return nullptr;
+            if (it->second != kMissingVariant) variant = &pass.variants[it->second];
+        }
+    }
+
+    return variant->bUsed ? variant : nullptr;
+}
+
+bool Shader::prewarmVariants(std::span<const ShaderVariant> variants) {
+    std::vector<std::pair<UInt32, UInt32>> touchedPasses;
+    std::vector<std::pair<Pass *, UInt32>> pending; // pass and index of the new variant
+
+    for (const ShaderVariant &shaderVariant : variants) {
+        if (shaderVariant.subShader >= subShaders.size() ||
+            shaderVariant.pass >= subShaders[shaderVariant.subShader].passes.size()) {
+            continue;
+        }
+        Pass  &pass = subShaders[shaderVariant.subShader].passes[shaderVariant.pass];
+        UInt64 mask = pass.keywordSpace.getMask(shaderVariant.keywords);
+        if (pass.source.empty() || mask == pass.keywordMask || pass.variantIndices.contains(mask)) continue;
+
+        pass.variantIndices[mask] = pass.variants.size();
+        pass.variants.emplace_back().keywordMask = mask;
+        pending.emplace_back(&pass, pass.variants.size() - 1);
+    }
+    if (pending.empty()) return true;
+
+    /// variants stopped moving, compile them all at once
+    std::vector<Variant *>    compileVariantList;
+    std::vector<const Pass *> compilePasses;
+    for (auto [pass, index] : pending) {
+        compileVariantList.push_back(&pass->variants[index]);
+        compilePasses.push_back(pass);
+    }
+    bool bSucceeded = compileVariants(compileVariantList, compilePasses);
+
+    for (auto [pass, index] : pending) {
+        Variant &variant = pass->variants[index];
+        if (variant.vertex_spv.empty() || variant.fragment_spv.empty() || !createVariantGPUObject(variant, *pass)) {
+            DestroyVariantGPUObject(variant);
+            /// an empty mask entry is rebuilt below, the failed variant is left out
+            variant.vertex_spv.clear();
+            bSucceeded = false;
+        }
+    }
+
+    for (auto [pass, index] : pending) {
+        std::erase_if(pass->variants, [](const Variant &variant) {
+            return variant.renderPipelineState == nullptr && variant.vertex_spv.empty();
+        });
+    }
+    initKeywords();
+    return bSucceeded;
+}
+
+void Shader::getUsedVariants(std::vector<ShaderVariant> &outVariants) const {
+    outVariants.clear();
+    for (UInt32 subShaderIndex = 0; subShaderIndex < subShaders.size(); ++subShaderIndex) {
+        const auto &passes = subShaders[subShaderIndex].passes;
+        for (UInt32 passIndex = 0; passIndex < passes.size(); ++passIndex) {
+            const Pass &pass = passes[passIndex];
+            if (pass.bUsed) {
+                ShaderVariant &shaderVariant = outVariants.emplace_back(ShaderVariant{ subShaderIndex, passIndex });
+                pass.keywordSpace.getKeywords(pass.keywordMask, shaderVariant.keywords);
+            }
+            for (const Variant &variant : pass.variants) {
+                if (!variant.bUsed) continue;
+                ShaderVariant &shaderVariant = outVariants.emplace_back(ShaderVariant{ subShaderIndex, passIndex });
+                pass.keywordSpace.getKeywords(variant.keywordMask, shaderVariant.keywords);
+            }
+        }
+    }
+}
+
+void Shader::stripVariants(std::span<const ShaderVariant> keep) {
+    for (UInt32 subShaderIndex = 0; subShaderIndex < subShaders.size(); ++subShaderIndex) {
+        auto &passes = subShaders[subShaderIndex].passes;
+        for (UInt32 passIndex = 0; passIndex < passes.size(); ++passIndex) {
+            Pass &pass = passes[passIndex];
+
+            std::vector<UInt64> keepMasks;
+            for (const ShaderVariant &shaderVariant : keep) {
+                if (shaderVariant.subShader == subShaderIndex && shaderVariant.pass == passIndex) {
+                    keepMasks.push_back(pass.keywordSpace.getMask(shaderVariant.keywords));
+                }
+            }
+
+            std::erase_if(pass.variants, [&keepMasks](Variant &variant) {
+                if (std::find(keepMasks.begin(), keepMasks.end(), variant.keywordMask) != keepMasks.end()) return false;
+                DestroyVariantGPUObject(variant);
+                return true;
+            });
+            std::string().swap(pass.source);
+        }
+    }
+    initKeywords();
+}
+
+UInt32 Shader::getVariantCount() const {
+    UInt32 count = 0;
+    for (const SubShader &subShader : subShaders) {
+        for (const Pass &pass : subShader.passes) {
+            count += 1 + pass.variants.size();
+        }
+    }
+    return count;
 }
 
 
@@ -268,148 +508,157 @@ bool Shader::createGPUObject() {
     for (int i = 0; i < subShaders.size(); ++i) {
         for (int j = 0; j < subShaders[i].passes.size(); ++j) {
             auto &pass = subShaders[i].passes[j];
-            PipelineReflection pipelineReflection;
+            if (!createVariantGPUObject(pass, pass)) return false;
+            for (Variant &variant : pass.variants) {
+                if (!createVariantGPUObject(variant, pass)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool Shader::createVariantGPUObject(Variant &variant, const Pass &pass) {
+    PipelineReflection pipelineReflection;
 
-            if (GetGraphicsAPI() == kGraphicsAPIVulkan) {
+    if (GetGraphicsAPI() == kGraphicsAPIVulkan) {
 
-                if (!pipelineReflection.reflectSPIRV(pass.vertex_spv.data(), pass.vertex_spv.size())) return false;
-                if (!pipelineReflection.reflectSPIRV(pass.fragment_spv.data(), pass.fragment_spv.size())) return false;
+        if (!pipelineReflection.reflectSPIRV(variant.vertex_spv.data(), variant.vertex_spv.size())) return false;
+        if (!pipelineReflection.reflectSPIRV(variant.fragment_spv.data(), variant.fragment_spv.size())) return false;
 
 #ifdef OJOIE_USE_SPIRV
-                /// remove reflect info and debug info
-                /// remove reflect info is needed, due to some vulkan layer not support it
-                spvtools::Optimizer opt(SPV_ENV_UNIVERSAL_1_3);
-                auto print_msg_to_stderr = [](spv_message_level_t, const char*,
-                                              const spv_position_t&, const char* m) {
-                    AN_LOG(Error, "%s", m);
-                };
-                opt.SetMessageConsumer(print_msg_to_stderr);
-
-                opt.RegisterPass(spvtools::CreateStripNonSemanticInfoPass())
-                        .RegisterPass(spvtools::CreateStripDebugInfoPass());
-
-                std::vector<uint32_t> optimized_binary;
-                if (!opt.Run((const uint32_t *)pass.vertex_spv.data(),
-                             pass.vertex_spv.size() / sizeof(uint32_t),
-                             &optimized_binary))
-                    return false;
-
-                pass.vertex_spv.resize(optimized_binary.size() * sizeof(uint32_t));
-                memcpy(pass.vertex_spv.data(), optimized_binary.data(), pass.vertex_spv.size());
-
-                optimized_binary.clear();
-
-                /// optimizer cannot reuse, because I've tested it
-                spvtools::Optimizer fragOpt(SPV_ENV_UNIVERSAL_1_3);
-                fragOpt.RegisterPass(spvtools::CreateStripNonSemanticInfoPass())
-                        .RegisterPass(spvtools::CreateStripDebugInfoPass());
-                if (!fragOpt.Run((const uint32_t *)pass.fragment_spv.data(),
-                                 pass.fragment_spv.size() / sizeof(uint32_t),
-                                 &optimized_binary))
-                    return false;
-
-
-                pass.fragment_spv.resize(optimized_binary.size() * sizeof(uint32_t));
-                memcpy(pass.fragment_spv.data(), optimized_binary.data(), pass.fragment_spv.size());
+        /// remove reflect info and debug info
+        /// remove reflect info is needed, due to some vulkan layer not support it
+        spvtools::Optimizer opt(SPV_ENV_UNIVERSAL_1_3);
+        auto print_msg_to_stderr = [](spv_message_level_t, const char*,
+                                      const spv_position_t&, const char* m) {
+            AN_LOG(Error, "%s", m);
+        };
+        opt.SetMessageConsumer(print_msg_to_stderr);
+
+        opt.RegisterPass(spvtools::CreateStripNonSemanticInfoPass())
+                .RegisterPass(spvtools::CreateStripDebugInfoPass());
+
+        std::vector<uint32_t> optimized_binary;
+        if (!opt.Run((const uint32_t *)variant.vertex_spv.data(),
+                     variant.vertex_spv.size() / sizeof(uint32_t),
+                     &optimized_binary))
+            return false;
+
+        variant.vertex_spv.resize(optimized_binary.size() * sizeof(uint32_t));
+        memcpy(variant.vertex_spv.data(), optimized_binary.data(), variant.vertex_spv.size());
+
+        optimized_binary.clear();
+
+        /// optimizer cannot reuse, because I've tested it
+        spvtools::Optimizer fragOpt(SPV_ENV_UNIVERSAL_1_3);
+        fragOpt.RegisterPass(spvtools::CreateStripNonSemanticInfoPass())
+                .RegisterPass(spvtools::CreateStripDebugInfoPass());
+        if (!fragOpt.Run((const uint32_t *)variant.fragment_spv.data(),
+                         variant.fragment_spv.size() / sizeof(uint32_t),
+                         &optimized_binary))
+            return false;
+
+
+        variant.fragment_spv.resize(optimized_binary.size() * sizeof(uint32_t));
+        memcpy(variant.fragment_spv.data(), optimized_binary.data(), variant.fragment_spv.size());
 
 #endif//OJOIE_USE_SPIRV
 
-            } else {
-
-                if (!pipelineReflection.reflectCSO(pass.vertex_spv.data(), pass.vertex_spv.size(), kShaderStageVertex))
-                    return false;
-                if (!pipelineReflection.reflectCSO(pass.fragment_spv.data(), pass.fragment_spv.size(), kShaderStageFragment))
-                    return false;
-            }
+    } else {
 
+        if (!pipelineReflection.reflectCSO(variant.vertex_spv.data(), variant.vertex_spv.size(), kShaderStageVertex))
+            return false;
+        if (!pipelineReflection.reflectCSO(variant.fragment_spv.data(), variant.fragment_spv.size(), kShaderStageFragment))
+            return false;
+    }
 
-            pass.vertexInputs.assign(pipelineReflection.getVertexInputs().begin(), pipelineReflection.getVertexInputs().end());
-            pass.propertyList = pipelineReflection.buildPropertyList();
 
-            /// note that pipelineReflection ensure that resources is sorted by set and binding
-            for (const auto &resource : pipelineReflection.getResourcesSets()) {
-                BindingInfo bindingInfo{};
-                bindingInfo.set = resource.set;
-                bindingInfo.binding = resource.binding;
-                bindingInfo.name = resource.name;
-                bindingInfo.stage = resource.stage;
+    variant.vertexInputs.assign(pipelineReflection.getVertexInputs().begin(), pipelineReflection.getVertexInputs().end());
+    variant.propertyList = pipelineReflection.buildPropertyList();
+    variant.bindingInfos.clear();
 
-                if (resource.resourceType == kShaderResourceBufferUniform ||
-                    resource.resourceType == kShaderResourceBufferStorage) {
+    /// note that pipelineReflection ensure that resources is sorted by set and binding
+    for (const auto &resource : pipelineReflection.getResourcesSets()) {
+        BindingInfo bindingInfo{};
+        bindingInfo.set = resource.set;
+        bindingInfo.binding = resource.binding;
+        bindingInfo.name = resource.name;
+        bindingInfo.stage = resource.stage;
 
-                    bindingInfo.bindingType = kBindingTypeBuffer;
-                    bindingInfo.size = resource.block.size;
+        if (resource.resourceType == kShaderResourceBufferUniform ||
+            resource.resourceType == kShaderResourceBufferStorage) {
 
-                    if (GetGraphicsAPI() == kGraphicsAPID3D11) {
-                        D3D11::GetUniformBuffers().setBufferInfo(bindingInfo.name.getIndex(), bindingInfo.size);
-                    }
+            bindingInfo.bindingType = kBindingTypeBuffer;
+            bindingInfo.size = resource.block.size;
 
-                } else if (resource.resourceType == kShaderResourceImage ||
-                           resource.resourceType == kShaderResourceImageStorage ||
-                           resource.resourceType == kShaderResourceInputAttachment) {
-                    bindingInfo.bindingType = kBindingTypeTexture;
-                } else if (resource.resourceType == kShaderResourceSampler) {
-                    bindingInfo.bindingType = kBindingTypeSampler;
-                } else {
-                    /// not support type
-                    AN_LOG(Error, "not support shader resource type %d", bindingInfo.bindingType);
-                }
-                pass.bindingInfos.push_back(bindingInfo);
+            if (GetGraphicsAPI() == kGraphicsAPID3D11) {
+                D3D11::GetUniformBuffers().setBufferInfo(bindingInfo.name.getIndex(), bindingInfo.size);
             }
 
-            RenderPipelineStateDescriptor renderPipelineStateDescriptor{};
-            renderPipelineStateDescriptor.vertexFunction.entry = "vertex_main";
-            renderPipelineStateDescriptor.vertexFunction.code  = pass.vertex_spv.data();
-            renderPipelineStateDescriptor.vertexFunction.size  = pass.vertex_spv.size();
-
-            renderPipelineStateDescriptor.fragmentFunction.entry = "fragment_main";
-            renderPipelineStateDescriptor.fragmentFunction.code  = pass.fragment_spv.data();
-            renderPipelineStateDescriptor.fragmentFunction.size  = pass.fragment_spv.size();
-
-            RenderPipelineColorAttachmentDescriptor colorAttachmentDescriptor{};
-            colorAttachmentDescriptor.blendingEnabled             = pass.shaderLabPass.blending;
-            colorAttachmentDescriptor.rgbBlendOperation           = pass.shaderLabPass.blendOperation;
-            colorAttachmentDescriptor.sourceRGBBlendFactor        = pass.shaderLabPass.sourceBlendFactor;
-            colorAttachmentDescriptor.destinationRGBBlendFactor   = pass.shaderLabPass.destinationBlendFactor;
-            colorAttachmentDescriptor.writeMask                   = pass.shaderLabPass.colorWriteMask;
-            colorAttachmentDescriptor.sourceAlphaBlendFactor      = pass.shaderLabPass.sourceAlphaFactor;
-            colorAttachmentDescriptor.destinationAlphaBlendFactor = pass.shaderLabPass.destinationAlphaFactor;
-            colorAttachmentDescriptor.alphaBlendOperation         = kBlendOperationAdd;
-
-            renderPipelineStateDescriptor.colorAttachments.push_back(colorAttachmentDescriptor);
-
-            renderPipelineStateDescriptor.depthStencilDescriptor.depthTestEnabled = true;
-            renderPipelineStateDescriptor.depthStencilDescriptor.depthWriteEnabled = pass.shaderLabPass.ZWrite;
-            renderPipelineStateDescriptor.depthStencilDescriptor.depthCompareFunction = pass.shaderLabPass.ZTestOperation;
-            /// TODO stencil
-
-            /// anti-aliasing
-            UInt32 samples = GetQualitySettings().getCurrent().antiAliasing;
-            if (samples > 1) {
-                renderPipelineStateDescriptor.rasterSampleCount = samples;
-            } else {
-                renderPipelineStateDescriptor.rasterSampleCount = 1;
-            }
+        } else if (resource.resourceType == kShaderResourceImage ||
+                   resource.resourceType == kShaderResourceImageStorage ||
+                   resource.resourceType == kShaderResourceInputAttachment) {
+            bindingInfo.bindingType = kBindingTypeTexture;
+        } else if (resource.resourceType == kShaderResourceSampler) {
+            bindingInfo.bindingType = kBindingTypeSampler;
+        } else {
+            /// not support type
+            AN_LOG(Error, "not support shader resource type %d", bindingInfo.bindingType);
+        }
+        variant.bindingInfos.push_back(bindingInfo);
+    }
 
+    RenderPipelineStateDescriptor renderPipelineStateDescriptor{};
+    renderPipelineStateDescriptor.vertexFunction.entry = "vertex_main";
+    renderPipelineStateDescriptor.vertexFunction.code  = variant.vertex_spv.data();
+    renderPipelineStateDescriptor.vertexFunction.size  = variant.vertex_spv.size();
+
+    renderPipelineStateDescriptor.fragmentFunction.entry = "fragment_main";
+    renderPipelineStateDescriptor.fragmentFunction.code  = variant.fragment_spv.data();
+    renderPipelineStateDescriptor.fragmentFunction.size  = variant.fragment_spv.size();
+
+    RenderPipelineColorAttachmentDescriptor colorAttachmentDescriptor{};
+    colorAttachmentDescriptor.blendingEnabled             = pass.shaderLabPass.blending;
+    colorAttachmentDescriptor.rgbBlendOperation           = pass.shaderLabPass.blendOperation;
+    colorAttachmentDescriptor.sourceRGBBlendFactor        = pass.shaderLabPass.sourceBlendFactor;
+    colorAttachmentDescriptor.destinationRGBBlendFactor   = pass.shaderLabPass.destinationBlendFactor;
+    colorAttachmentDescriptor.writeMask                   = pass.shaderLabPass.colorWriteMask;
+    colorAttachmentDescriptor.sourceAlphaBlendFactor      = pass.shaderLabPass.sourceAlphaFactor;
+    colorAttachmentDescriptor.destinationAlphaBlendFactor = pass.shaderLabPass.destinationAlphaFactor;
+    colorAttachmentDescriptor.alphaBlendOperation         = kBlendOperationAdd;
+
+    renderPipelineStateDescriptor.colorAttachments.push_back(colorAttachmentDescriptor);
+
+    renderPipelineStateDescriptor.depthStencilDescriptor.depthTestEnabled = true;
+    renderPipelineStateDescriptor.depthStencilDescriptor.depthWriteEnabled = pass.shaderLabPass.ZWrite;
+    renderPipelineStateDescriptor.depthStencilDescriptor.depthCompareFunction = pass.shaderLabPass.ZTestOperation;
+    /// TODO stencil
+
+    /// anti-aliasing
+    UInt32 samples = GetQualitySettings().getCurrent().antiAliasing;
+    if (samples > 1) {
+        renderPipelineStateDescriptor.rasterSampleCount = samples;
+    } else {
+        renderPipelineStateDescriptor.rasterSampleCount = 1;
+    }
 
-            renderPipelineStateDescriptor.alphaToOneEnabled = false;
-            renderPipelineStateDescriptor.alphaToCoverageEnabled = false;
 
-            renderPipelineStateDescriptor.cullMode = pass.shaderLabPass.cullMode;
+    renderPipelineStateDescriptor.alphaToOneEnabled = false;
+    renderPipelineStateDescriptor.alphaToCoverageEnabled = false;
 
-            if (pass.renderPipelineState == nullptr) {
-                pass.renderPipelineState = new RenderPipelineState();
-            }
+    renderPipelineStateDescriptor.cullMode = pass.shaderLabPass.cullMode;
 
-            if (!pass.renderPipelineState->init(renderPipelineStateDescriptor, pipelineReflection)) return false;
+    if (variant.renderPipelineState == nullptr) {
+        variant.renderPipelineState = new RenderPipelineState();
+    }
+
+    if (!variant.renderPipelineState->init(renderPipelineStateDescriptor, pipelineReflection)) return false;
 
 #ifndef OJOIE_WITH_EDITOR
-            /// destroy shader code to save memory
-            std::vector<UInt8>().swap(pass.vertex_spv);
-            std::vector<UInt8>().swap(pass.fragment_spv);
+    /// destroy shader code to save memory
+    std::vector<UInt8>().swap(variant.vertex_spv);
+    std::vector<UInt8>().swap(variant.fragment_spv);
 #endif
-        }
-    }
     return true;
 }
 
@@ -424,7 +673,7 @@ bool Shader::initWithScriptText(const char *text, std::span<const char *> includ
 }
 
 bool Shader::initAfterDecode() {
-    if (!Super::initAfterDecode() || !createGPUObject()) return false;
+    if (!Super::initAfterDecode() || !initKeywords() || !createGPUObject()) return false;
     return true;
 }
 
@@ -436,6 +685,11 @@ std::span<const ShaderVertexInput> Shader::getVertexInputs(UInt32 passIndex, UIn
     return subShaders[subShaderIndex].passes[passIndex].vertexInputs;
 }
 
+bool Shader::dependsOnInclude(std::string_view path) const {
+    std::string normalized = ShaderIncludeCache::NormalizePath(path);
+    return std::find(_includeDependencies.begin(), _includeDependencies.end(), normalized) != _includeDependencies.end();
+}
+
 std::string Shader::getTextAssetPath() {
     return _scriptPath;
 }
@@ -456,6 +710,8 @@ void Shader::onInspectorGUI() {
         return;
     }
     
+    ImGui::Text("Variants %u", getVariantCount());
+
     ImGui::Text("Shader Properties");
     for (const auto &prop : properties) {
         ImGui::PushID(&prop);
@@ -0,0 +1,232 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/Shader/ShaderCache.hpp"
+#include "Utility/Log.h"
+#include "Utility/String.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace AN {
+
+namespace fs = std::filesystem;
+
+static constexpr UInt32 kShaderCacheMagic   = 0x43534E41; // ANSC
+static constexpr UInt32 kShaderCacheVersion = 1;
+static constexpr const char *kShaderCacheExtension = ".bin";
+
+/// every entry starts with this header, the key check rejects entries renamed or written by another build
+struct ShaderCacheEntryHeader {
+    UInt32  magic;
+    UInt32  version;
+    UInt64  size;
+    Hash128 key;
+};
+
+static bool ParseKey(const std::string &stem, Hash128 &key) {
+    if (stem.size() != 32) return false;
+    if (!std::all_of(stem.begin(), stem.end(), [](char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); })) {
+        return false;
+    }
+    UInt8 bytes[16];
+    HexStringToBytes(stem.c_str(), 16, bytes);
+    key.u64[0] = key.u64[1] = 0;
+    for (int i = 0; i < 8; ++i) {
+        key.u64[0] = (key.u64[0] << 8) | bytes[i];
+        key.u64[1] = (key.u64[1] << 8) | bytes[i + 8];
+    }
+    return true;
+}
+
+ShaderCache::ShaderCache()
+    : m_MaxSize(kDefaultMaxSize), m_TotalSize(), m_UseClock(), m_Hits(), m_Misses(), m_Evictions() {}
+
+std::string ShaderCache::getEntryPath(const Hash128 &key) const {
+    return (fs::path(m_Directory) / (key.toString() + kShaderCacheExtension)).string();
+}
+
+void ShaderCache::setDirectory(std::string_view directory, UInt64 maxSize) {
+    std::lock_guard lock(m_Mutex);
+    m_Directory = directory;
+    m_MaxSize   = maxSize;
+    m_TotalSize = 0;
+    m_UseClock  = 0;
+    m_Entries.clear();
+
+    if (m_Directory.empty()) return;
+
+    std::error_code error;
+    fs::create_directories(m_Directory, error);
+    if (error) {
+        AN_LOG(Error, "Cannot create shader cache directory %s: %s", m_Directory.c_str(), error.message().c_str());
+        m_Directory.clear();
+        return;
+    }
+
+    /// entries of earlier runs are ordered by modify time, load touches the file so it follows the last use
+    std::vector<std::tuple<fs::file_time_type, Hash128, UInt64>> found;
+    for (const fs::directory_entry &entry : fs::directory_iterator(m_Directory, error)) {
+        Hash128 key;
+        if (!entry.is_regular_file() || entry.path().extension() != kShaderCacheExtension ||
+            !ParseKey(entry.path().stem().string(), key)) {
+            continue;
+        }
+        found.emplace_back(entry.last_write_time(), key, entry.file_size());
+    }
+    std::sort(found.begin(), found.end(), [](const auto &a, const auto &b) { return std::get<0>(a) < std::get<0>(b); });
+
+    for (const auto &[time, key, size] : found) {
+        m_Entries[key] = { size, ++m_UseClock };
+        m_TotalSize += size;
+    }
+    evict();
+}
+
+Hash128 ShaderCache::ComputeKey(std::string_view source, std::string_view entry, std::string_view profile,
+                                std::span<const char *> defines, std::string_view compilerVersion) {
+    /// parts are separated by a null so that moving text between them changes the key
+    std::string text;
+    text.reserve(source.size() + 256);
+    text.append(source).push_back('\0');
+    text.append(entry).push_back('\0');
+    text.append(profile).push_back('\0');
+    for (const char *define : defines) {
+        text.append(define).push_back('\0');
+    }
+    text.push_back('\0');
+    text.append(compilerVersion);
+    return ComputeHash128(text);
+}
+
+bool ShaderCache::load(const Hash128 &key, std::vector<UInt8> &outBlob) {
+    std::string path;
+    {
+        std::lock_guard lock(m_Mutex);
+        auto it = m_Entries.find(key);
+        if (m_Directory.empty() || it == m_Entries.end()) {
+            ++m_Misses;
+            return false;
+        }
+        it->second.lastUse = ++m_UseClock;
+        path = getEntryPath(key);
+    }
+
+    /// read outside the lock, workers load entries in parallel
+    ShaderCacheEntryHeader header{};
+    std::ifstream          file(path, std::ios::binary);
+    bool bValid = file.read((char *) &header, sizeof header) && header.magic == kShaderCacheMagic &&
+                  header.version == kShaderCacheVersion && header.key == key;
+    if (bValid) {
+        outBlob.resize(header.size);
+        bValid = (bool) file.read((char *) outBlob.data(), (std::streamsize) header.size);
+    }
+    file.close();
+
+    if (!bValid) {
+        AN_LOG(Warning, "Shader cache entry %s is damaged and removed", path.c_str());
+        outBlob.clear();
+        std::lock_guard lock(m_Mutex);
+        if (auto it = m_Entries.find(key); it != m_Entries.end()) {
+            m_TotalSize -= it->second.size;
+            m_Entries.erase(it);
+        }
+        std::error_code error;
+        fs::remove(path, error);
+        ++m_Misses;
+        return false;
+    }
+
+    std::error_code error;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error);
+    ++m_Hits;
+    return true;
+}
+
+void ShaderCache::store(const Hash128 &key, std::span<const UInt8> blob) {
+    std::string path;
+    {
+        std::lock_guard lock(m_Mutex);
+        if (m_Directory.empty()) return;
+        path = getEntryPath(key);
+    }
+
+    /// write a temporary file and rename it, a reader never sees half an entry
+    std::string tempPath = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    ShaderCacheEntryHeader header{ kShaderCacheMagic, kShaderCacheVersion, blob.size(), key };
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write((const char *) &header, sizeof header);
+        file.write((const char *) blob.data(), (std::streamsize) blob.size());
+        if (!file) {
+            AN_LOG(Error, "Cannot write shader cache entry %s", tempPath.c_str());
+            return;
+        }
+    }
+    std::error_code error;
+    fs::rename(tempPath, path, error);
+    if (error) {
+        fs::remove(tempPath, error);
+        return;
+    }
+
+    std::lock_guard lock(m_Mutex);
+    UInt64 size  = sizeof header + blob.size();
+    Entry &entry = m_Entries[key];
+    m_TotalSize += size - entry.size;
+    entry = { size, ++m_UseClock };
+    evict();
+}
+
+void ShaderCache::evict() {
+    if (m_TotalSize <= m_MaxSize) return;
+
+    std::vector<std::pair<UInt64, Hash128>> order;
+    order.reserve(m_Entries.size());
+    for (const auto &[key, entry] : m_Entries) {
+        order.emplace_back(entry.lastUse, key);
+    }
+    std::sort(order.begin(), order.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    /// trim below the limit so that a full cache does not evict on every store
+    UInt64 target = m_MaxSize - m_MaxSize / 8;
+    for (const auto &[lastUse, key] : order) {
+        if (m_TotalSize <= target) break;
+        std::error_code error;
+        fs::remove(getEntryPath(key), error);
+        m_TotalSize -= m_Entries[key].size;
+        m_Entries.erase(key);
+        ++m_Evictions;
+    }
+}
+
+void ShaderCache::clear() {
+    std::lock_guard lock(m_Mutex);
+    for (const auto &[key, entry] : m_Entries) {
+        std::error_code error;
+        fs::remove(getEntryPath(key), error);
+    }
+    m_Entries.clear();
+    m_TotalSize = 0;
+}
+
+ShaderCacheStats ShaderCache::getStats() {
+    std::lock_guard lock(m_Mutex);
+    return { m_Hits, m_Misses, m_Evictions, m_TotalSize, (UInt32) m_Entries.size() };
+}
+
+void ShaderCache::resetStats() {
+    m_Hits      = 0;
+    m_Misses    = 0;
+    m_Evictions = 0;
+}
+
+ShaderCache &GetShaderCache() {
+    static ShaderCache shaderCache;
+    return shaderCache;
+}
+
+}
@@ -22,6 +22,7 @@
 
 #include <wrl/client.h>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <unordered_set>
 
@@ -30,10 +31,11 @@ using Microsoft::WRL::ComPtr;
 namespace AN::RC {
 
 #ifdef OJOIE_USE_VULKAN
-static ComPtr<IDxcLibrary>        gLibrary;
-static ComPtr<IDxcCompiler3>      gCompiler;
-static ComPtr<IDxcUtils>          gUtils;
-static ComPtr<IDxcIncludeHandler> gDefaultIncludeHandler;
+/// dxc objects are not thread safe, shaders compile on worker threads so each thread has its own
+static thread_local ComPtr<IDxcLibrary>        gLibrary;
+static thread_local ComPtr<IDxcCompiler3>      gCompiler;
+static thread_local ComPtr<IDxcUtils>          gUtils;
+static thread_local ComPtr<IDxcIncludeHandler> gDefaultIncludeHandler;
 
 
 class ANIncludeHandler : public IDxcIncludeHandler {
@@ -160,6 +162,74 @@ ShaderCompiler::ShaderCompiler() {
 }
 
 
+bool ShaderCompiler::preprocessHLSL(const char *source,
+                                    std::string &outSource,
+                                    const char *nameHint,
+                                    std::span<const char *> include,
+                                    std::span<const char *> defines) {
+    D3DInclude d3dInclude;
+    for (const char *inc : include) {
+        d3dInclude.addPath(inc);
+    }
+
+    std::vector<std::string>      defineStorage;
+    std::vector<D3D_SHADER_MACRO> macros;
+    defineStorage.reserve(defines.size());
+    for (const char *define : defines) {
+        std::string_view text(define);
+        size_t           equal = text.find('=');
+        defineStorage.emplace_back(text.substr(0, equal));
+        macros.push_back({ nullptr, equal == std::string_view::npos ? "1" : define + equal + 1 });
+    }
+    for (size_t i = 0; i < macros.size(); ++i) {
+        macros[i].Name = defineStorage[i].c_str();
+    }
+    macros.push_back({ nullptr, nullptr });
+
+    ComPtr<ID3DBlob> textBlob  = nullptr;
+    ComPtr<ID3DBlob> errorBlob = nullptr;
+    HRESULT hr = D3DPreprocess(source, strlen(source), nameHint, macros.data(), &d3dInclude, &textBlob, &errorBlob);
+    if (FAILED(hr)) {
+        AN_LOG(Error, "Shader preprocess failed :%s", errorBlob ? (char *) errorBlob->GetBufferPointer() : "");
+        return false;
+    }
+
+    /// the blob is null terminated
+    outSource.assign((const char *) textBlob->GetBufferPointer(), strnlen((const char *) textBlob->GetBufferPointer(), textBlob->GetBufferSize()));
+    return true;
+}
+
+const char *ShaderCompiler::GetTargetProfile(ShaderStage stage, bool spirv) {
+    switch (stage) {
+        case kShaderStageVertex:
+            return spirv ? "vs_6_6" : "vs_5_0";
+        case kShaderStageFragment:
+            return spirv ? "ps_6_6" : "ps_5_0";
+        default:
+            return nullptr;
+    }
+}
+
+std::string ShaderCompiler::getVersionString(bool spirv) {
+    if (spirv) {
+#ifdef OJOIE_USE_VULKAN
+        UInt32 major = 0, minor = 0;
+        ComPtr<IDxcVersionInfo> versionInfo;
+        if (gCompiler && SUCCEEDED(gCompiler.As(&versionInfo))) {
+            versionInfo->GetVersion(&major, &minor);
+        }
+        return std::format("dxc {}.{} spirv auto-binding-space 1", major, minor);
+#else
+        return "dxc unavailable";
+#endif
+    }
+#if AN_DEBUG
+    return std::format("d3dcompiler {} strict debug", D3D_COMPILER_VERSION);
+#else
+    return std::format("d3dcompiler {} strict", D3D_COMPILER_VERSION);
+#endif
+}
+
 std::vector<UInt8> ShaderCompiler::compileHLSLToSPIRV(ShaderStage        stage,
                                                       const char             *source,
                                                       const char             *entry,
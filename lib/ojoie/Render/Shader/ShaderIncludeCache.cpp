@@ -0,0 +1,376 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/Shader/ShaderIncludeCache.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+namespace AN {
+
+namespace fs = std::filesystem;
+
+static std::string_view Trim(std::string_view text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string_view::npos) return {};
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+static std::string_view FirstWord(std::string_view text) {
+    size_t end = 0;
+    while (end < text.size() && (isalnum((unsigned char) text[end]) || text[end] == '_')) ++end;
+    return text.substr(0, end);
+}
+
+/// line without comments, a block comment may go on over the next lines
+static std::string StripComments(std::string_view line, bool &bInBlockComment) {
+    std::string result;
+    for (size_t i = 0; i < line.size(); ++i) {
+        if (bInBlockComment) {
+            if (line[i] == '*' && i + 1 < line.size() && line[i + 1] == '/') {
+                bInBlockComment = false;
+                result.push_back(' ');
+                ++i;
+            }
+            continue;
+        }
+        if (line[i] == '/' && i + 1 < line.size()) {
+            if (line[i + 1] == '/') break;
+            if (line[i + 1] == '*') {
+                bInBlockComment = true;
+                ++i;
+                continue;
+            }
+        }
+        result.push_back(line[i]);
+    }
+    return result;
+}
+
+static bool ReadFile(const std::string &path, std::string &text) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+template<typename T>
+static bool Contains(const std::vector<T> &vector, const T &value) {
+    return std::find(vector.begin(), vector.end(), value) != vector.end();
+}
+
+static void AddUnique(std::vector<std::string> &vector, const std::string &value) {
+    if (!Contains(vector, value)) vector.push_back(value);
+}
+
+ShaderIncludeCache::ShaderIncludeCache() : m_FileLoads(), m_Expansions(), m_ExpandedHits() {}
+
+std::string ShaderIncludeCache::NormalizePath(std::string_view path) {
+    std::error_code error;
+    fs::path normalized = fs::weakly_canonical(fs::path(path), error);
+    if (error) normalized = fs::path(path).lexically_normal();
+    return normalized.make_preferred().string();
+}
+
+void ShaderIncludeCache::Parse(File &file) {
+    /// a file is guarded when all of it is inside #ifndef X #define X ... #endif
+    enum GuardState { kGuardStart, kGuardOpen, kGuardDefined, kGuardClosed, kNotGuarded };
+    GuardState       guard = kGuardStart;
+    std::string      guardName;
+
+    const std::string &text            = file.text;
+    bool               bInBlockComment = false;
+    UInt32             depth           = 0;
+    UInt32             lineNumber      = 0;
+    size_t             segmentStart    = 0;
+    size_t             lineStart       = 0;
+
+    file.bOnce = false;
+    file.segments.clear();
+
+    std::string stripped;
+    while (lineStart < text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+        size_t next    = lineEnd == std::string::npos ? text.size() : lineEnd + 1;
+        ++lineNumber;
+
+        stripped = StripComments(std::string_view(text).substr(lineStart, next - lineStart), bInBlockComment);
+        std::string_view content = Trim(stripped);
+        if (content.empty()) {
+            lineStart = next;
+            continue;
+        }
+        if (content[0] != '#') {
+            if (guard != kGuardDefined) guard = kNotGuarded;
+            lineStart = next;
+            continue;
+        }
+
+        content = Trim(content.substr(1));
+        std::string_view directive = FirstWord(content);
+        std::string_view argument  = Trim(content.substr(directive.size()));
+
+        if (directive == "if" || directive == "ifdef" || directive == "ifndef") {
+            if (guard == kGuardStart && directive == "ifndef") {
+                guard     = kGuardOpen;
+                guardName = FirstWord(argument);
+            } else if (guard != kGuardDefined) {
+                guard = kNotGuarded;
+            }
+            ++depth;
+        } else if (directive == "endif") {
+            if (depth > 0) --depth;
+            if (depth == 0 && guard == kGuardDefined) guard = kGuardClosed;
+        } else if (directive == "define" && guard == kGuardOpen) {
+            guard = FirstWord(argument) == guardName ? kGuardDefined : kNotGuarded;
+        } else {
+            if (guard != kGuardDefined || ((directive == "else" || directive == "elif") && depth == 1)) {
+                guard = kNotGuarded;
+            }
+            if (directive == "pragma" && FirstWord(argument) == "once") {
+                file.bOnce = true;
+            }
+            if (directive == "include" && argument.size() > 2 && (argument[0] == '"' || argument[0] == '<')) {
+                size_t end = argument.find(argument[0] == '"' ? '"' : '>', 1);
+                if (end != std::string_view::npos) {
+                    Segment &segment         = file.segments.emplace_back();
+                    segment.offset           = segmentStart;
+                    segment.size             = lineStart - segmentStart;
+                    segment.name             = argument.substr(1, end - 1);
+                    segment.bSystem          = argument[0] == '<';
+                    segment.directiveOffset  = lineStart;
+                    segment.directiveSize    = next - lineStart;
+                    segment.nextLine         = lineNumber + 1;
+                    segment.conditionalDepth = depth;
+                    segmentStart             = next;
+                }
+            }
+        }
+        lineStart = next;
+    }
+
+    Segment &last = file.segments.emplace_back();
+    last.offset   = segmentStart;
+    last.size     = text.size() - segmentStart;
+
+    if (guard == kGuardClosed) {
+        file.bOnce = true;
+        for (Segment &segment : file.segments) {
+            if (segment.conditionalDepth > 0) --segment.conditionalDepth;
+        }
+    }
+}
+
+std::shared_ptr<ShaderIncludeCache::File> ShaderIncludeCache::getFile(const std::string &path) {
+    if (auto it = m_Files.find(path); it != m_Files.end()) {
+        return it->second;
+    }
+
+    auto file = std::make_shared<File>();
+    if (!ReadFile(path, file->text)) return nullptr;
+    file->path      = path;
+    file->name      = fs::path(path).filename().string();
+    file->hash      = ComputeHash128(file->text);
+    file->bExpanded = false;
+    Parse(*file);
+
+    ++m_FileLoads;
+    m_Files[path] = file;
+    return file;
+}
+
+std::string ShaderIncludeCache::resolve(const Segment &segment, std::string_view directory, const Context &context) {
+    std::string resolveKey;
+    resolveKey.append(directory).append(segment.bSystem ? "<" : "\"").append(segment.name).append(context.key.toString());
+    if (auto it = m_Resolved.find(resolveKey); it != m_Resolved.end()) {
+        return it->second;
+    }
+
+    std::string     path;
+    std::error_code error;
+    if (!segment.bSystem && !directory.empty()) {
+        fs::path candidate = fs::path(directory) / segment.name;
+        if (fs::is_regular_file(candidate, error)) path = NormalizePath(candidate.string());
+    }
+    for (size_t i = 0; path.empty() && i < context.includePaths.size(); ++i) {
+        fs::path candidate = fs::path(context.includePaths[i]) / segment.name;
+        if (fs::is_regular_file(candidate, error)) path = NormalizePath(candidate.string());
+    }
+    m_Resolved[resolveKey] = path;
+    return path;
+}
+
+void ShaderIncludeCache::assemble(const File &file, std::string_view name, UInt32 depth, Context &context, std::string &out) {
+    std::string directory = file.path.empty() ? std::string() : fs::path(file.path).parent_path().string();
+
+    for (const Segment &segment : file.segments) {
+        out.append(file.text, segment.offset, segment.size);
+        if (segment.name.empty()) continue;
+
+        std::string           path    = resolve(segment, directory, context);
+        std::shared_ptr<File> include = path.empty() ? nullptr : getFile(path);
+        if (include == nullptr) {
+            out.append(file.text, segment.directiveOffset, segment.directiveSize);
+            continue;
+        }
+
+        if (!file.path.empty()) m_Dependents[path].insert(file.path);
+        AddUnique(context.dependencies, path);
+
+        if (Contains(context.stack, path)) {
+            context.bStackHit = true;
+            out.push_back('\n');
+            continue;
+        }
+        if (include->bOnce && context.emitted.contains(path)) {
+            /// the line of the directive stays so the lines after it keep their numbers
+            out.push_back('\n');
+            continue;
+        }
+
+        UInt32 includeDepth = depth + segment.conditionalDepth;
+        bool bBuilt = !include->bExpanded || include->expansionKey != context.key;
+        if (bBuilt) buildExpanded(*include, context);
+
+        bool bReuse = include->bExpanded &&
+                      std::none_of(include->expandedOnceFiles.begin(), include->expandedOnceFiles.end(),
+                                   [&](const std::string &once) { return context.emitted.contains(once); }) &&
+                      std::none_of(include->expandedDependencies.begin(), include->expandedDependencies.end(),
+                                   [&](const std::string &dependency) { return Contains(context.stack, dependency); });
+
+        out.append("#line 1 \"").append(include->name).append("\"\n");
+        if (bReuse) {
+            out.append(include->expanded);
+            if (!bBuilt) ++m_ExpandedHits;
+            /// guarded files inside an #if block may still be dropped by the preprocessor, they are not marked
+            if (includeDepth == 0) {
+                context.emitted.insert(include->expandedOnceFiles.begin(), include->expandedOnceFiles.end());
+            }
+            for (const std::string &dependency : include->expandedDependencies) {
+                AddUnique(context.dependencies, dependency);
+            }
+        } else {
+            if (include->bOnce && includeDepth == 0) context.emitted.insert(path);
+            context.stack.push_back(path);
+            assemble(*include, include->name, includeDepth, context, out);
+            context.stack.pop_back();
+        }
+        out.append("\n#line ").append(std::to_string(segment.nextLine)).append(" \"").append(name).append("\"\n");
+    }
+}
+
+void ShaderIncludeCache::buildExpanded(File &file, Context &parent) {
+    Context context{ parent.includePaths, parent.key };
+    context.stack = parent.stack;
+    context.stack.push_back(file.path);
+    context.bStackHit = false;
+    if (file.bOnce) context.emitted.insert(file.path);
+
+    std::string expanded;
+    expanded.reserve(file.text.size());
+    assemble(file, file.name, 0, context, expanded);
+    ++m_Expansions;
+
+    /// an include cycle makes the text depend on where the file was included from
+    if (context.bStackHit) {
+        parent.bStackHit = true;
+        return;
+    }
+
+    file.expanded = std::move(expanded);
+    file.expandedOnceFiles.assign(context.emitted.begin(), context.emitted.end());
+    file.expandedDependencies = std::move(context.dependencies);
+    file.expansionKey         = parent.key;
+    file.bExpanded            = true;
+}
+
+void ShaderIncludeCache::expand(std::string_view source, std::string_view name, std::span<const char *const> includePaths,
+                                std::string &outSource, std::vector<std::string> *outDependencies) {
+    File file{};
+    file.text = source;
+    Parse(file);
+
+    outSource.clear();
+    if (file.segments.size() == 1) {
+        outSource.assign(source);
+        if (outDependencies) outDependencies->clear();
+        return;
+    }
+
+    /// resolving <name> depends on the include paths, expansions are kept for one set of them
+    std::string pathsText;
+    for (const char *includePath : includePaths) {
+        pathsText.append(includePath).push_back('\0');
+    }
+
+    std::lock_guard lock(m_Mutex);
+    Context context{ includePaths, ComputeHash128(pathsText) };
+    context.bStackHit = false;
+    outSource.reserve(source.size() * 4);
+    assemble(file, name, 0, context, outSource);
+
+    if (outDependencies) *outDependencies = std::move(context.dependencies);
+}
+
+bool ShaderIncludeCache::invalidate(std::string_view path) {
+    std::string normalized = NormalizePath(path);
+
+    std::lock_guard lock(m_Mutex);
+    auto it = m_Files.find(normalized);
+    if (it == m_Files.end()) return false;
+    m_Resolved.clear();
+
+    /// saving a file without changes keeps everything
+    std::string text;
+    if (ReadFile(normalized, text) && ComputeHash128(text) == it->second->hash) return false;
+    m_Files.erase(it);
+
+    /// drop the expansions of the files including it, directly or not
+    std::vector<std::string>        pending{ normalized };
+    std::unordered_set<std::string> visited{ normalized };
+    while (!pending.empty()) {
+        std::string current = std::move(pending.back());
+        pending.pop_back();
+        auto dependents = m_Dependents.find(current);
+        if (dependents == m_Dependents.end()) continue;
+        for (const std::string &dependent : dependents->second) {
+            if (!visited.insert(dependent).second) continue;
+            if (auto file = m_Files.find(dependent); file != m_Files.end()) {
+                file->second->bExpanded = false;
+                std::string().swap(file->second->expanded);
+            }
+            pending.push_back(dependent);
+        }
+    }
+    return true;
+}
+
+void ShaderIncludeCache::clear() {
+    std::lock_guard lock(m_Mutex);
+    m_Files.clear();
+    m_Dependents.clear();
+    m_Resolved.clear();
+}
+
+ShaderIncludeCacheStats ShaderIncludeCache::getStats() {
+    std::lock_guard lock(m_Mutex);
+    return { m_FileLoads, m_Expansions, m_ExpandedHits, (UInt32) m_Files.size() };
+}
+
+void ShaderIncludeCache::resetStats() {
+    std::lock_guard lock(m_Mutex);
+    m_FileLoads    = 0;
+    m_Expansions   = 0;
+    m_ExpandedHits = 0;
+}
+
+ShaderIncludeCache &GetShaderIncludeCache() {
+    static ShaderIncludeCache shaderIncludeCache;
+    return shaderIncludeCache;
+}
+
+}
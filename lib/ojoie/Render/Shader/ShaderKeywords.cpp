@@ -0,0 +1,124 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/Shader/ShaderKeywords.hpp"
+#include "Utility/Log.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace AN {
+
+static std::mutex                    gKeywordMutex;
+static std::unordered_map<Name, int> gKeywordIndices;
+
+int GetShaderKeywordIndex(const Name &keyword) {
+    std::lock_guard lock(gKeywordMutex);
+    auto it = gKeywordIndices.find(keyword);
+    if (it != gKeywordIndices.end()) return it->second;
+
+    if (gKeywordIndices.size() >= kMaxShaderKeywords) {
+        AN_LOG(Error, "Shader keyword %s exceeds the limit of %u keywords", keyword.c_str(), kMaxShaderKeywords);
+        return -1;
+    }
+    int index = (int) gKeywordIndices.size();
+    gKeywordIndices.emplace(keyword, index);
+    return index;
+}
+
+bool ShaderKeywordSpace::init(std::span<const ShaderLab::KeywordDeclaration> declarations) {
+    m_Declarations.clear();
+    m_KeywordIndices.clear();
+    m_Keywords.clear();
+
+    for (const ShaderLab::KeywordDeclaration &declaration : declarations) {
+        Declaration &range   = m_Declarations.emplace_back();
+        range.firstBit       = m_Keywords.size();
+        range.bitCount       = 0;
+        range.bNoneDefault   = false;
+        range.bShaderFeature = declaration.bShaderFeature;
+
+        for (const Name &keyword : declaration.keywords) {
+            if (keyword == "_") {
+                /// the first choice is the default, "_" first makes it no keyword at all,
+                /// a later "_" cannot be selected by keywords and builds no variant
+                range.bNoneDefault = range.bNoneDefault || range.bitCount == 0;
+                continue;
+            }
+            if (m_Keywords.size() >= ShaderLab::kMaxPassKeywords) {
+                AN_LOG(Error, "Shader pass declares more than %u keywords", ShaderLab::kMaxPassKeywords);
+                return false;
+            }
+            m_Keywords.push_back(keyword);
+            m_KeywordIndices.push_back(GetShaderKeywordIndex(keyword));
+            ++range.bitCount;
+        }
+    }
+    return true;
+}
+
+UInt64 ShaderKeywordSpace::getMask(const ShaderKeywordSet &keywords) const {
+    UInt64 mask = 0;
+    for (const Declaration &declaration : m_Declarations) {
+        UInt32 end = declaration.firstBit + declaration.bitCount;
+        UInt32 bit = declaration.firstBit;
+        while (bit < end && (m_KeywordIndices[bit] < 0 || !keywords.isEnabled(m_KeywordIndices[bit]))) {
+            ++bit;
+        }
+        if (bit < end) {
+            mask |= 1ULL << bit;
+        } else if (!declaration.bNoneDefault && declaration.bitCount > 0) {
+            mask |= 1ULL << declaration.firstBit;
+        }
+    }
+    return mask;
+}
+
+UInt64 ShaderKeywordSpace::getMask(std::span<const Name> keywords) const {
+    ShaderKeywordSet set;
+    for (const Name &keyword : keywords) {
+        int index = GetShaderKeywordIndex(keyword);
+        if (index >= 0) set.enable(index);
+    }
+    return getMask(set);
+}
+
+void ShaderKeywordSpace::getKeywords(UInt64 mask, std::vector<Name> &outKeywords) const {
+    outKeywords.clear();
+    for (UInt32 bit = 0; bit < m_Keywords.size(); ++bit) {
+        if (mask & (1ULL << bit)) outKeywords.push_back(m_Keywords[bit]);
+    }
+}
+
+void ShaderKeywordSpace::getDefines(UInt64 mask, std::vector<const char *> &outDefines) const {
+    outDefines.clear();
+    for (UInt32 bit = 0; bit < m_Keywords.size(); ++bit) {
+        if (mask & (1ULL << bit)) outDefines.push_back(m_Keywords[bit].c_str());
+    }
+}
+
+void ShaderKeywordSpace::getAllMasks(std::vector<UInt64> &outMasks, bool includeShaderFeatures) const {
+    outMasks.assign(1, 0);
+    for (const Declaration &declaration : m_Declarations) {
+        /// choices of this declaration, 0 is "none"
+        std::vector<UInt64> choices;
+        if (declaration.bNoneDefault) choices.push_back(0);
+        for (UInt32 bit = declaration.firstBit; bit < declaration.firstBit + declaration.bitCount; ++bit) {
+            choices.push_back(1ULL << bit);
+        }
+        if (declaration.bShaderFeature && !includeShaderFeatures) {
+            choices.resize(std::min<size_t>(choices.size(), 1));
+        }
+        if (choices.empty()) continue;
+
+        std::vector<UInt64> masks;
+        masks.reserve(outMasks.size() * choices.size());
+        for (UInt64 mask : outMasks) {
+            for (UInt64 choice : choices) masks.push_back(mask | choice);
+        }
+        outMasks.swap(masks);
+    }
+}
+
+}
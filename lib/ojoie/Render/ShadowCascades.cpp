@@ -0,0 +1,138 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/ShadowCascades.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AN {
+
+static UInt32 ClampCascadeCount(UInt32 cascadeCount) {
+    return std::clamp<UInt32>(cascadeCount, 1, kMaxShadowCascades);
+}
+
+void ComputeShadowCascadeSplits(const ShadowCascadeSettings &settings, float nearZ, float farZ, float *outSplits) {
+    UInt32 count = ClampCascadeCount(settings.cascadeCount);
+
+    outSplits[0]     = nearZ;
+    outSplits[count] = farZ;
+
+    for (UInt32 i = 1; i < count; ++i) {
+        float split;
+        if (settings.splitMode == kShadowCascadeSplitManual) {
+            split = nearZ + (farZ - nearZ) * std::clamp(settings.manualSplits[i - 1], 0.f, 1.f);
+        } else {
+            float p           = (float) i / (float) count;
+            float logSplit    = nearZ * std::pow(farZ / nearZ, p);
+            float linearSplit = nearZ + (farZ - nearZ) * p;
+            split = settings.splitLambda * logSplit + (1.f - settings.splitLambda) * linearSplit;
+        }
+        /// keep splits ascending even with bad manual splits
+        outSplits[i] = std::max(split, outSplits[i - 1]);
+    }
+}
+
+UInt32 ComputeShadowCascades(const ShadowCascadeSettings &settings,
+                             const ShadowCascadeViewParams &viewParams,
+                             ShadowCascade *outCascades) {
+    UInt32 count         = ClampCascadeCount(settings.cascadeCount);
+    UInt32 tilesPerRow   = GetShadowAtlasTilesPerRow(count);
+    float  shadowFar     = std::min(viewParams.farZ, settings.shadowDistance);
+
+    float splits[kMaxShadowCascades + 1];
+    ComputeShadowCascadeSplits(settings, viewParams.nearZ, shadowFar, splits);
+
+    /// the light rotation only depends on the light direction, the translation is snapped below
+    Vector3f   lightDir = Math::normalize(viewParams.lightDirection);
+    Vector3f   up       = std::abs(lightDir.y) > 0.999f ? Vector3f(0.f, 0.f, 1.f) : Vector3f(0.f, 1.f, 0.f);
+    Matrix4x4f lightRotation    = Math::lookAt(Vector3f(0.f), -lightDir, up);
+    Matrix4x4f invLightRotation = Math::transpose(lightRotation);
+
+    float tanY = std::tan(viewParams.fovyRadians * 0.5f);
+    float tanX = tanY * viewParams.aspect;
+
+    for (UInt32 i = 0; i < count; ++i) {
+        ShadowCascade &cascade = outCascades[i];
+        float n = splits[i], f = splits[i + 1];
+
+        /// bounding sphere of the frustum slice, it does not change when the camera rotates,
+        /// so the cascade size is stable. camera looks down -z
+        float centerZ = (n + f) * 0.5f;
+        auto cornerDistance2 = [=](float d) {
+            float x = d * tanX, y = d * tanY, z = d - centerZ;
+            return x * x + y * y + z * z;
+        };
+        float radius = std::sqrt(std::max(cornerDistance2(n), cornerDistance2(f)));
+        radius = std::ceil(radius * 16.f) / 16.f;
+
+        float texelSize = 2.f * radius / (float) settings.resolution;
+
+        /// snap the center to the texel grid in light space
+        Vector3f centerWS = viewParams.cameraToWorld * Vector4f(0.f, 0.f, -centerZ, 1.f);
+        Vector3f centerLS = lightRotation * Vector4f(centerWS, 1.f);
+        centerLS.x = std::floor(centerLS.x / texelSize) * texelSize;
+        centerLS.y = std::floor(centerLS.y / texelSize) * texelSize;
+        Vector3f snappedCenterWS = invLightRotation * Vector4f(centerLS, 1.f);
+
+        cascade.view = Math::translate(-Vector3f(centerLS.x, centerLS.y, centerLS.z + radius)) * lightRotation;
+        cascade.proj = Math::ortho(-radius, radius, -radius, radius, 0.f, 2.f * radius);
+
+        cascade.splitSphere = Vector4f(snappedCenterWS, radius);
+        cascade.splitNear   = n;
+        cascade.splitFar    = f;
+        cascade.texelSize   = texelSize;
+        cascade.tileX       = i % tilesPerRow;
+        cascade.tileY       = i / tilesPerRow;
+
+        Math::Plane planes[kPlaneFrustumNum];
+        ExtractProjectionPlanes(cascade.proj * cascade.view, planes);
+        cascade.cullingPlanes[0] = planes[kPlaneFrustumLeft];
+        cascade.cullingPlanes[1] = planes[kPlaneFrustumRight];
+        cascade.cullingPlanes[2] = planes[kPlaneFrustumBottom];
+        cascade.cullingPlanes[3] = planes[kPlaneFrustumTop];
+        cascade.cullingPlanes[4] = planes[kPlaneFrustumFar];
+    }
+
+    return count;
+}
+
+void CullShadowCasters(const ShadowCascade &cascade, std::span<const AABB> casterBounds, std::vector<UInt32> &outIndices) {
+    for (UInt32 i = 0; i < casterBounds.size(); ++i) {
+        if (IntersectAABBPlaneBounds(casterBounds[i], cascade.cullingPlanes, kShadowCascadeCullingPlaneCount)) {
+            outIndices.push_back(i);
+        }
+    }
+}
+
+void FitShadowCascadeDepth(ShadowCascade &cascade, std::span<const AABB> casterBounds, std::span<const UInt32> indices) {
+    float radius    = cascade.splitSphere.w;
+    float nearPlane = 0.f;
+    for (UInt32 index : indices) {
+        AABB boundsLS = TransformAABB(casterBounds[index], cascade.view);
+        /// light view looks down -z, the nearest point has the largest z
+        nearPlane = std::min(nearPlane, -(boundsLS.center.z + boundsLS.extent.z));
+    }
+    cascade.proj = Math::ortho(-radius, radius, -radius, radius, nearPlane, 2.f * radius);
+}
+
+Matrix4x4f GetShadowCascadeWorldToShadow(const ShadowCascade &cascade, UInt32 cascadeCount) {
+    /// map clip space [-1, 1] to texture space [0, 1], saves a MAD in shader
+    Matrix4x4f textureScaleAndBias = Math::identity<Matrix4x4f>();
+    textureScaleAndBias[0][0] = 0.5f;
+    textureScaleAndBias[3][0] = 0.5f;
+    textureScaleAndBias[1][1] = -0.5f;
+    textureScaleAndBias[3][1] = 0.5f;
+
+    float tileScale = 1.f / (float) GetShadowAtlasTilesPerRow(cascadeCount);
+    Matrix4x4f tileScaleAndOffset = Math::identity<Matrix4x4f>();
+    tileScaleAndOffset[0][0] = tileScale;
+    tileScaleAndOffset[1][1] = tileScale;
+    tileScaleAndOffset[3][0] = (float) cascade.tileX * tileScale;
+    tileScaleAndOffset[3][1] = (float) cascade.tileY * tileScale;
+
+    return tileScaleAndOffset * textureScaleAndBias * cascade.proj * cascade.view;
+}
+
+}
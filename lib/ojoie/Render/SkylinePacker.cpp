@@ -0,0 +1,87 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/SkylinePacker.hpp"
+
+#include <algorithm>
+
+namespace AN {
+
+void SkylinePacker::reset(UInt32 width, UInt32 height) {
+    _width    = width;
+    _height   = height;
+    _usedArea = 0;
+    _skyline.clear();
+    _skyline.push_back({ 0, 0, width });
+}
+
+bool SkylinePacker::fit(size_t index, UInt32 width, UInt32 height, UInt32 &outY) const {
+    UInt32 x = _skyline[index].x;
+    if (x + width > _width) return false;
+
+    UInt32 y         = 0;
+    UInt32 remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = std::max(y, _skyline[i].y);
+        if (y + height > _height) return false;
+        remaining -= std::min(remaining, _skyline[i].width);
+    }
+    outY = y;
+    return true;
+}
+
+bool SkylinePacker::pack(UInt32 width, UInt32 height, UInt32 &outX, UInt32 &outY) {
+    if (width == 0 || height == 0) {
+        outX = outY = 0;
+        return true;
+    }
+
+    /// lowest top edge, then the narrowest node so wide gaps stay for wide rectangles
+    size_t bestIndex = _skyline.size();
+    UInt32 bestTop = UINT32_MAX, bestWidth = UINT32_MAX, bestY = 0;
+    for (size_t i = 0; i < _skyline.size(); ++i) {
+        UInt32 y;
+        if (!fit(i, width, height, y)) continue;
+        if (y + height < bestTop || (y + height == bestTop && _skyline[i].width < bestWidth)) {
+            bestIndex = i;
+            bestTop   = y + height;
+            bestWidth = _skyline[i].width;
+            bestY     = y;
+        }
+    }
+    if (bestIndex == _skyline.size()) return false;
+
+    outX = _skyline[bestIndex].x;
+    outY = bestY;
+    _usedArea += (UInt64) width * height;
+
+    /// the new node covers the nodes under the rectangle, the last one is cut
+    _skyline.insert(_skyline.begin() + bestIndex, { outX, bestY + height, width });
+    UInt32 right = outX + width;
+    size_t i     = bestIndex + 1;
+    while (i < _skyline.size() && _skyline[i].x < right) {
+        Node  &node      = _skyline[i];
+        UInt32 nodeRight = node.x + node.width;
+        if (nodeRight <= right) {
+            _skyline.erase(_skyline.begin() + i);
+            continue;
+        }
+        node.width = nodeRight - right;
+        node.x     = right;
+        break;
+    }
+
+    /// merge neighbors of the same height
+    for (size_t j = 0; j + 1 < _skyline.size();) {
+        if (_skyline[j].y == _skyline[j + 1].y) {
+            _skyline[j].width += _skyline[j + 1].width;
+            _skyline.erase(_skyline.begin() + j + 1);
+        } else {
+            ++j;
+        }
+    }
+    return true;
+}
+
+}
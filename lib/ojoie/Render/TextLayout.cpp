@@ -0,0 +1,286 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/TextLayout.hpp"
+#include "Render/CommandBuffer.hpp"
+#include "Render/VertexBuffer.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace AN {
+
+/// the quads index buffer of the dynamic vertex buffer is 16 bit
+static constexpr UInt32 kMaxTextVerticesPerChunk = (65536 / 4 - 4) * 4;
+
+static constexpr UInt32 kReplacementCodepoint = 0xFFFD;
+
+/// next codepoint of UTF-8 text, malformed bytes decode to U+FFFD one at a time
+static UInt32 DecodeUTF8(const char *&p, const char *end) {
+    UInt8 lead = (UInt8) *p++;
+    if (lead < 0x80) return lead;
+
+    UInt32 count, codepoint;
+    if ((lead & 0xE0) == 0xC0) {
+        count     = 1;
+        codepoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        count     = 2;
+        codepoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        count     = 3;
+        codepoint = lead & 0x07;
+    } else {
+        return kReplacementCodepoint;
+    }
+
+    if (end - p < (ptrdiff_t) count) return kReplacementCodepoint;
+    for (UInt32 i = 0; i < count; ++i) {
+        if (((UInt8) p[i] & 0xC0) != 0x80) return kReplacementCodepoint;
+        codepoint = (codepoint << 6) | ((UInt8) p[i] & 0x3F);
+    }
+    p += count;
+    return codepoint;
+}
+
+size_t TextLayoutCache::KeyHash::operator () (const Key &key) const {
+    UInt64 style = ((UInt64) key.style.font << 32) ^ ((UInt64) key.style.pixelSize << 1) ^ key.style.bSDF ^
+                   ((UInt64) std::bit_cast<UInt32>(key.style.wrapWidth) << 17);
+    return std::hash<std::string_view>()(key.text) ^ std::hash<UInt64>()(style * 0x9E3779B97F4A7C15ULL);
+}
+
+TextLayoutCache::TextLayoutCache(GlyphCache *glyphCache, UInt32 maxLayouts)
+    : _glyphCache(glyphCache), _maxLayouts(std::max(1U, maxLayouts)), _stats() {}
+
+bool TextLayoutCache::isValid(const TextLayout &layout) const {
+    for (const TextRun &run : layout.runs) {
+        if (run.page >= _glyphCache->getPageCount() ||
+            _glyphCache->getPage(run.page).generation != run.pageGeneration) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TextLayoutCache::build(std::string_view text, const TextStyle &style, TextLayout &outLayout) {
+    GlyphRasterizer *rasterizer  = _glyphCache->getRasterizer();
+    FontLineMetrics  lineMetrics = rasterizer->getLineMetrics(style.font, style.pixelSize);
+    GlyphKey         key{ style.font, 0, style.pixelSize, style.bSDF };
+    float            scale = _glyphCache->getScale(key);
+
+    outLayout.bComplete = true;
+    _placed.clear();
+
+    /// pen positions first, a wrap moves the glyphs after the last space down a line
+    float  penX = 0.f, width = 0.f;
+    UInt32 line = 0, previous = 0;
+    size_t breakIndex = SIZE_MAX;
+    float  breakX     = 0.f;
+    for (const char *p = text.data(), *end = text.data() + text.size(); p < end;) {
+        UInt32 codepoint = DecodeUTF8(p, end);
+        if (codepoint == '\r') continue;
+        if (codepoint == '\n') {
+            width      = std::max(width, penX);
+            penX       = 0.f;
+            previous   = 0;
+            breakIndex = SIZE_MAX;
+            ++line;
+            continue;
+        }
+
+        const CachedGlyph *glyph;
+        key.codepoint      = codepoint;
+        GlyphStatus status = _glyphCache->getGlyph(key, glyph);
+        if (status == kGlyphMissing) {
+            key.codepoint = '?';
+            status        = _glyphCache->getGlyph(key, glyph);
+        }
+        if (status != kGlyphReady) {
+            /// the advance is not known yet, the layout is redone when the glyph is placed
+            outLayout.bComplete = outLayout.bComplete && status == kGlyphMissing;
+            previous            = 0;
+            continue;
+        }
+
+        if (previous) {
+            penX += rasterizer->getKerning(style.font, previous, codepoint, style.pixelSize);
+        }
+        float advance = glyph->metrics.advance * scale;
+
+        if (style.wrapWidth > 0.f && codepoint != ' ' && penX + advance > style.wrapWidth && breakIndex != SIZE_MAX) {
+            float shift = breakIndex < _placed.size() ? _placed[breakIndex].x : penX;
+            width       = std::max(width, breakX);
+            for (size_t i = breakIndex; i < _placed.size(); ++i) {
+                _placed[i].x -= shift;
+                _placed[i].line = line + 1;
+            }
+            penX -= shift;
+            breakIndex = SIZE_MAX;
+            ++line;
+        }
+
+        _placed.push_back({ glyph, penX, line });
+        penX += advance;
+        if (codepoint == ' ') {
+            breakIndex = _placed.size();
+            breakX     = penX - advance;
+        }
+        previous = codepoint;
+    }
+    width = std::max(width, penX);
+
+    outLayout.width     = width;
+    outLayout.lineCount = text.empty() ? 0 : line + 1;
+    outLayout.height    = (float) outLayout.lineCount * lineMetrics.lineHeight;
+
+    /// group the quads by page so a batch copies each run at once
+    UInt32 pageCount = _glyphCache->getPageCount();
+    _pageVertexCounts.assign(pageCount, 0);
+    for (const PlacedGlyph &placed : _placed) {
+        if (placed.glyph->page != kNoGlyphPage) _pageVertexCounts[placed.glyph->page] += 4;
+    }
+
+    outLayout.runs.clear();
+    UInt32 vertexCount = 0;
+    for (UInt32 page = 0; page < pageCount; ++page) {
+        if (_pageVertexCounts[page] == 0) continue;
+        outLayout.runs.push_back({ page, _glyphCache->getPage(page).generation, vertexCount, 0 });
+        /// the count becomes the write position of the page
+        UInt32 count            = _pageVertexCounts[page];
+        _pageVertexCounts[page] = vertexCount;
+        vertexCount += count;
+    }
+    outLayout.vertices.resize(vertexCount);
+
+    float pageScale = 1.f / (float) _glyphCache->getSettings().pageSize;
+    for (const PlacedGlyph &placed : _placed) {
+        const CachedGlyph &glyph = *placed.glyph;
+        if (glyph.page == kNoGlyphPage) continue;
+
+        float baseline = lineMetrics.ascender + (float) placed.line * lineMetrics.lineHeight;
+        float x0 = placed.x + (float) glyph.metrics.bearingX * scale;
+        float y0 = baseline - (float) glyph.metrics.bearingY * scale;
+        float x1 = x0 + (float) glyph.metrics.width * scale;
+        float y1 = y0 + (float) glyph.metrics.height * scale;
+        float u0 = (float) glyph.x * pageScale, v0 = (float) glyph.y * pageScale;
+        float u1 = (float) (glyph.x + glyph.metrics.width) * pageScale;
+        float v1 = (float) (glyph.y + glyph.metrics.height) * pageScale;
+
+        TextVertex *quad = &outLayout.vertices[_pageVertexCounts[glyph.page]];
+        _pageVertexCounts[glyph.page] += 4;
+        quad[0] = { x0, y0, u0, v0, 0xFFFFFFFF };
+        quad[1] = { x1, y0, u1, v0, 0xFFFFFFFF };
+        quad[2] = { x1, y1, u1, v1, 0xFFFFFFFF };
+        quad[3] = { x0, y1, u0, v1, 0xFFFFFFFF };
+    }
+    for (TextRun &run : outLayout.runs) {
+        run.vertexCount = _pageVertexCounts[run.page] - run.firstVertex;
+    }
+}
+
+const TextLayout &TextLayoutCache::layout(std::string_view text, const TextStyle &style) {
+    auto it = _lookup.find({ text, style });
+    if (it != _lookup.end()) {
+        EntryList::iterator entry = it->second;
+        if (isValid(entry->layout)) {
+            ++_stats.hits;
+            _entries.splice(_entries.begin(), _entries, entry);
+            for (const TextRun &run : entry->layout.runs) {
+                _glyphCache->touchPage(run.page);
+            }
+            return entry->layout;
+        }
+        ++_stats.invalidations;
+        _lookup.erase(it);
+        _entries.erase(entry);
+    }
+    ++_stats.misses;
+
+    /// the least recently used entry is reused with the capacity of its vectors
+    if (_entries.size() >= _maxLayouts) {
+        auto last = std::prev(_entries.end());
+        _lookup.erase({ last->text, last->style });
+        _entries.splice(_entries.begin(), _entries, last);
+        ++_stats.evictions;
+    } else {
+        _entries.emplace_front();
+    }
+
+    Entry &entry = _entries.front();
+    build(text, style, entry.layout);
+    if (!entry.layout.bComplete) {
+        std::swap(_incomplete, entry.layout);
+        _entries.pop_front();
+        return _incomplete;
+    }
+
+    entry.text.assign(text);
+    entry.style = style;
+    _lookup.emplace(Key{ entry.text, entry.style }, _entries.begin());
+    return entry.layout;
+}
+
+void TextLayoutCache::clear() {
+    _lookup.clear();
+    _entries.clear();
+}
+
+void TextBatch::add(const TextLayout &layout, float x, float y, UInt32 color) {
+    for (const TextRun &run : layout.runs) {
+        if (_pages.size() <= run.page) _pages.resize(run.page + 1);
+        std::vector<TextVertex> &vertices = _pages[run.page];
+
+        size_t first = vertices.size();
+        vertices.insert(vertices.end(), layout.vertices.begin() + run.firstVertex,
+                        layout.vertices.begin() + run.firstVertex + run.vertexCount);
+        for (size_t i = first; i < vertices.size(); ++i) {
+            vertices[i].x += x;
+            vertices[i].y += y;
+            vertices[i].color = color;
+        }
+    }
+}
+
+void TextBatch::clear() {
+    for (std::vector<TextVertex> &vertices : _pages) {
+        vertices.clear();
+    }
+}
+
+const ChannelInfoArray &TextBatch::GetChannelInfo() {
+    static ChannelInfoArray channelInfo;
+    static bool             bInitialized = [] {
+        channelInfo[kShaderChannelVertex].offset    = offsetof(TextVertex, x);
+        channelInfo[kShaderChannelVertex].format    = kChannelFormatFloat;
+        channelInfo[kShaderChannelVertex].dimension = 2;
+
+        channelInfo[kShaderChannelTexCoord0].offset    = offsetof(TextVertex, u);
+        channelInfo[kShaderChannelTexCoord0].format    = kChannelFormatFloat;
+        channelInfo[kShaderChannelTexCoord0].dimension = 2;
+
+        channelInfo[kShaderChannelColor].offset    = offsetof(TextVertex, color);
+        channelInfo[kShaderChannelColor].format    = kChannelFormatColor;
+        channelInfo[kShaderChannelColor].dimension = 1;
+        return true;
+    }();
+    (void) bInitialized;
+    return channelInfo;
+}
+
+void TextBatch::draw(CommandBuffer *commandBuffer, UInt32 page) const {
+    if (page >= _pages.size()) return;
+    const std::vector<TextVertex> &vertices = _pages[page];
+    DynamicVertexBuffer           &buffer   = commandBuffer->getDynamicVertexBuffer();
+
+    for (size_t first = 0; first < vertices.size(); first += kMaxTextVerticesPerChunk) {
+        UInt32 count = (UInt32) std::min<size_t>(vertices.size() - first, kMaxTextVerticesPerChunk);
+        void  *data;
+        if (!buffer.getChunk(GetChannelInfo(), count, 0, kDrawQuads, &data, nullptr)) return;
+        memcpy(data, &vertices[first], count * sizeof(TextVertex));
+        buffer.releaseChunk(count, 0);
+        buffer.drawChunk(commandBuffer, count, 0, 0);
+    }
+}
+
+}
@@ -10,18 +10,120 @@
 
 #include "Render/private/D3D11/TextureManager.hpp"
 #include "Allocator/MemoryDefines.h"
+#include "Misc/ResourceManager.hpp"
+#include "Serialize/SerializedAsset.h"
+#include "Serialize/SerializeDefines.h"
+#include "Utility/String.hpp"
+
+#include <filesystem>
 
 namespace AN {
 
 IMPLEMENT_AN_CLASS(Texture2D);
 LOAD_AN_CLASS(Texture2D);
 
+namespace {
+
+/// coarse levels are uploaded from the CPU chain, finer ones are read from the asset on the streaming thread
+class Texture2DStreamingBackend : public TextureStreamingBackend {
+public:
+    virtual void prepareLoad(void *texture, UInt32 firstMip) override {
+        ((Texture2D *) texture)->prepareStreamedMips();
+    }
+
+    virtual bool loadMips(void *texture, UInt32 firstMip) override {
+        return ((Texture2D *) texture)->loadStreamedMips(firstMip);
+    }
+
+    virtual void applyMips(void *texture, UInt32 firstMip) override {
+        ((Texture2D *) texture)->applyStreamedMips(firstMip);
+    }
+
+    virtual void discardMips(void *texture) override {
+        ((Texture2D *) texture)->discardStreamedMips();
+    }
+};
+
+Texture2DStreamingBackend gTexture2DStreamingBackend;
+
+/// the mip chain of a serialized texture, read without creating the object
+struct SerializedMipChain {
+    UInt32      width, height;
+    UInt32      mipmapLevel;
+    PixelFormat pixelFormat;
+    size_t      size;
+    std::string hexData;
+
+    AN_SERIALIZE_NO_IDPTR(SerializedMipChain)
+};
+
+template<typename _Coder>
+void SerializedMipChain::transfer(_Coder &coder) {
+    coder.transfer(width, "width");
+    coder.transfer(height, "height");
+    coder.transfer(mipmapLevel, "mipmapLevel");
+    coder.transfer(pixelFormat, "pixelFormat");
+    coder.transferTypeless(size, "dataSize");
+    coder.transfer(hexData, "_typelessdata");
+}
+
+}
+
+static void DeallocGPUTexture(TextureID textureID) {
+    if (GetGraphicsAPI() == kGraphicsAPIVulkan) {
+#ifdef OJOIE_USE_VULKAN
+        VK::GetTextureManager().deallocTexture(textureID);
+#endif//OJOIE_USE_VULKAN
+    } else if (GetGraphicsAPI() == kGraphicsAPID3D11) {
+        D3D11::GetTextureManager().deallocTexture(textureID);
+    }
+}
+
 
 Texture2D::~Texture2D() {}
 
 Texture2D::Texture2D(ObjectCreationMode mode) : Super(mode) {
     _texData.data = nullptr;
     bUploadToGPU = false;
+    bStreaming = false;
+    m_StreamingID = kInvalidStreamingTextureID;
+    m_StreamingSource.localID = 0;
+    m_StreamingSource.data = nullptr;
+    m_StreamingSource.firstMip = 0;
+    m_StreamingSource.residentMip = 0;
+}
+
+TextureLoadID Texture2D::LoadAsync(const char *path, const AsyncTextureLoadOptions &options,
+                                   std::function<void(Texture2D *)> completion) {
+    std::string name = std::filesystem::path(path).stem().string();
+    return GetAsyncTextureLoader().load(path, options, [name, completion = std::move(completion)](LoadTextureResult &result) {
+        if (!result.isValid()) {
+            completion(nullptr);
+            return;
+        }
+
+        TextureDescriptor desc{};
+        desc.width       = result.getWidth();
+        desc.height      = result.getHeight();
+        desc.pixelFormat = result.getPixelFormat();
+        desc.mipmapLevel = result.getMipmapLevel();
+
+        Texture2D *texture = NewObject<Texture2D>();
+        if (!texture->init(desc)) {
+            DestroyObject(texture);
+            completion(nullptr);
+            return;
+        }
+        /// the chain was filtered on the loader thread
+        if (result.getDataMipCount() == texture->getMipCount()) {
+            texture->setMipChainData(result.getData());
+        } else {
+            texture->setPixelData(result.getData());
+        }
+        texture->setName(name.c_str());
+        texture->uploadToGPU();
+        completion(texture);
+    });
 }
 
 bool Texture2D::init() {
@@ -33,11 +135,11 @@ bool Texture2D::init(const TextureDescriptor &desc,
     if (!Super::init()) return false;
     _samplerDescriptor = samplerDescriptor;
 
-    _texData.size = CalculatePixelFormatSize(desc.pixelFormat, desc.width, desc.height);
     _texData.width = desc.width;
     _texData.height = desc.height;
     _texData.pixelFormat = desc.pixelFormat;
-    _texData.mipmapLevel = desc.mipmapLevel;
+    _texData.mipmapLevel = std::clamp(desc.mipmapLevel, 1U, CalculateMipCount(desc.width, desc.height));
+    _texData.size = CalculateMipChainSize(desc.pixelFormat, desc.width, desc.height, _texData.mipmapLevel);
 
     bIsReadable = false;
     bUploadToGPU = false;
@@ -49,73 +151,190 @@ bool Texture2D::init(const TextureDescriptor &desc,
 }
 
 void Texture2D::dealloc() {
-    if (bUploadToGPU) {
-        if (GetGraphicsAPI() == kGraphicsAPIVulkan) {
-#ifdef OJOIE_USE_VULKAN
-            VK::GetTextureManager().deallocTexture(getTextureID());
-#endif//OJOIE_USE_VULKAN
-        } else {
-            D3D11::GetTextureManager().deallocTexture(getTextureID());
-        }
+    if (m_StreamingID != kInvalidStreamingTextureID) {
+        GetTextureStreamer().removeTexture(m_StreamingID);
+        m_StreamingID = kInvalidStreamingTextureID;
+    }
 
+    if (bUploadToGPU) {
+        DeallocGPUTexture(getTextureID());
         bUploadToGPU = false;
     }
 
     ANSafeFree(_texData.data);
+    ANSafeFree(m_StreamingSource.data);
 
     Super::dealloc();
 }
 
+size_t Texture2D::getRuntimeMemorySize() const {
+    size_t size = Super::getRuntimeMemorySize();
+    if (_texData.data) size += _texData.size;
+    /// the gpu copy holds the resident levels of the chain
+    if (bUploadToGPU) {
+        size += _texData.size - CalculateMipOffset(_texData.pixelFormat, _texData.width, _texData.height, getResidentMip());
+    }
+    return size;
+}
+
 void Texture2D::uploadToGPU(bool generateMipmap) {
-    if (_texData.data) {
+    if (_texData.data == nullptr) {
+        AN_LOG(Error, "Not texture data to upload");
+        return;
+    }
 
-        if (bUploadToGPU && bSizeChanged) {
-            if (GetGraphicsAPI() == kGraphicsAPIVulkan) {
-#ifdef OJOIE_USE_VULKAN
-                VK::GetTextureManager().deallocTexture(getTextureID());
-#endif//OJOIE_USE_VULKAN
-            } else if (GetGraphicsAPI() == kGraphicsAPID3D11) {
-                D3D11::GetTextureManager().deallocTexture(getTextureID());
-            }
+    /// a streamed GPU texture holds fewer levels
+    bool bWasStreamed = m_StreamingID != kInvalidStreamingTextureID;
+    if (bWasStreamed) {
+        GetTextureStreamer().removeTexture(m_StreamingID);
+        m_StreamingID = kInvalidStreamingTextureID;
+    }
+
+    /// the finer levels are copied into the GPU texture in place, only done for D3D11
+    if (bStreaming && _texData.mipmapLevel > 1 && !generateMipmap &&
+        GetGraphicsAPI() == kGraphicsAPID3D11) {
+        if (bUploadToGPU) {
+            DeallocGPUTexture(getTextureID());
+            bUploadToGPU = false;
         }
+        ANSafeFree(m_StreamingSource.data);
+
+        /// the streamer uploads the always resident levels now
+        StreamingTextureDescriptor desc{ _texData.width, _texData.height, _texData.mipmapLevel, _texData.pixelFormat };
+        m_StreamingID = GetTextureStreamer().addTexture(desc, &gTexture2DStreamingBackend, this);
+        bSizeChanged = false;
+
+        /// a texture decoded from an asset reads its finer levels from there again
+        SerializedObjectIdentifier identifier = GetSerializeManager().GetSerializedObjectIdentifier(this);
+        if (!bIsReadable && identifier.uuid.IsValid()) {
+            m_StreamingSource.path.clear();
+            m_StreamingSource.localID = identifier.localID;
+            ANSafeFree(_texData.data);
+        }
+        return;
+    }
+
+    if (bUploadToGPU && (bSizeChanged || bWasStreamed)) {
+        DeallocGPUTexture(getTextureID());
+    }
 
-        if (GetGraphicsAPI() == kGraphicsAPIVulkan) {
+    if (GetGraphicsAPI() == kGraphicsAPIVulkan) {
 #ifdef OJOIE_USE_VULKAN
-            VK::GetTextureManager().uploadTexture2D(getTextureID(),
-                                                    _texData.data,
-                                                    _texData.width, _texData.height,
-                                                    _texData.pixelFormat,
-                                                    generateMipmap,
-                                                    _samplerDescriptor);
+        VK::GetTextureManager().uploadTexture2D(getTextureID(),
+                                                _texData.data,
+                                                _texData.width, _texData.height,
+                                                _texData.pixelFormat,
+                                                _texData.mipmapLevel,
+                                                generateMipmap,
+                                                _samplerDescriptor);
 #endif//OJOIE_USE_VULKAN
-        } else if (GetGraphicsAPI() == kGraphicsAPID3D11) {
-            D3D11::GetTextureManager().uploadTexture2D(getTextureID(),
-                                                    _texData.data,
-                                                    _texData.width, _texData.height,
-                                                    _texData.pixelFormat,
-                                                    generateMipmap,
-                                                    _samplerDescriptor);
+    } else if (GetGraphicsAPI() == kGraphicsAPID3D11) {
+        D3D11::GetTextureManager().uploadTexture2D(getTextureID(),
+                                                _texData.data,
+                                                _texData.width, _texData.height,
+                                                _texData.pixelFormat,
+                                                _texData.mipmapLevel,
+                                                generateMipmap,
+                                                _samplerDescriptor);
+    }
+
+
+
+    bSizeChanged = false;
+    bUploadToGPU = true;
+
+    /// destroy cpu data if is not readable
+    if (!bIsReadable) {
+        ANSafeFree(_texData.data);
+    }
+}
+
+void Texture2D::prepareStreamedMips() {
+    /// the path is bound after the texture is initialized, so it is looked up at the first load
+    if (_texData.data == nullptr && m_StreamingSource.path.empty()) {
+        m_StreamingSource.path = GetResourceManager().getResourcePath(this);
+        /// not the main object of its asset
+        if (m_StreamingSource.path.empty()) {
+            SerializedObjectIdentifier identifier = GetSerializeManager().GetSerializedObjectIdentifier(this);
+            m_StreamingSource.path = GetResourceManager().getPathOfUUID(identifier.uuid.ToString());
         }
+    }
+}
 
+bool Texture2D::loadStreamedMips(UInt32 firstMip) {
+    /// the whole chain is still in CPU memory
+    if (_texData.data) return true;
+    if (m_StreamingSource.path.empty()) return false;
+
+    std::unique_ptr<YamlDecoder> decoder = SerializedAsset::DecodeObjectAtPath(m_StreamingSource.path.c_str(),
+                                                                               m_StreamingSource.localID);
+    if (decoder == nullptr) return false;
+
+    SerializedMipChain chain{};
+    decoder->transfer(chain, getClassName());
+    if (chain.width != _texData.width || chain.height != _texData.height || chain.mipmapLevel != _texData.mipmapLevel ||
+        chain.pixelFormat != _texData.pixelFormat || chain.size != _texData.size || chain.hexData.size() < chain.size * 2) {
+        AN_LOG(Warning, "Texture2D %s changed in %s, cannot stream its levels",
+               getName().c_str(), m_StreamingSource.path.c_str());
+        return false;
+    }
 
+    /// the levels down to the last one, whatever is resident when they are applied
+    UInt64 offset = CalculateMipOffset(_texData.pixelFormat, _texData.width, _texData.height, firstMip);
+    UInt64 size   = _texData.size - offset;
+    UInt8 *data   = (UInt8 *)AN_MALLOC_ALIGNED(size, 4);
+    HexStringToBytes(chain.hexData.data() + offset * 2, size, data);
 
-        bSizeChanged = false;
-        bUploadToGPU = true;
+    ANSafeFree(m_StreamingSource.data);
+    m_StreamingSource.data     = data;
+    m_StreamingSource.firstMip = firstMip;
+    return true;
+}
 
-        /// destroy cpu data if is not readable
-        if (!bIsReadable) {
-            ANSafeFree(_texData.data);
+void Texture2D::applyStreamedMips(UInt32 firstMip) {
+    ANAssert(firstMip < _texData.mipmapLevel);
+    UInt32 width    = CalculateMipSize(_texData.width, firstMip);
+    UInt32 height   = CalculateMipSize(_texData.height, firstMip);
+    UInt32 mipCount = _texData.mipmapLevel - firstMip;
+
+    /// evicting only copies the coarser levels on the GPU, a load may still be writing the streamed levels then
+    bool         bFiner = !bUploadToGPU || firstMip < m_StreamingSource.residentMip;
+    const UInt8 *data   = nullptr;
+    if (bFiner) {
+        if (_texData.data) {
+            data = _texData.data + CalculateMipOffset(_texData.pixelFormat, _texData.width, _texData.height, firstMip);
+        } else if (m_StreamingSource.data && firstMip >= m_StreamingSource.firstMip) {
+            data = m_StreamingSource.data +
+                   CalculateMipOffset(_texData.pixelFormat, _texData.width, _texData.height, firstMip) -
+                   CalculateMipOffset(_texData.pixelFormat, _texData.width, _texData.height, m_StreamingSource.firstMip);
         }
+        ANAssert(data != nullptr);
+    }
+
+    if (!bUploadToGPU) {
+        D3D11::GetTextureManager().uploadTexture2D(getTextureID(), data, width, height, _texData.pixelFormat,
+                                                   mipCount, false, _samplerDescriptor);
+        bUploadToGPU = true;
     } else {
-        AN_LOG(Error, "Not texture data to upload");
+        D3D11::GetTextureManager().updateTexture2DMips(getTextureID(), data, width, height, _texData.pixelFormat, mipCount);
+    }
+    m_StreamingSource.residentMip = firstMip;
+
+    if (bFiner) {
+        ANSafeFree(m_StreamingSource.data);
     }
 }
 
+void Texture2D::discardStreamedMips() {
+    ANSafeFree(m_StreamingSource.data);
+}
+
 void Texture2D::resize(UInt32 width, UInt32 height) {
     if (_texData.width == width && _texData.height == height) return;
     _texData.width = width;
     _texData.height = height;
-    _texData.size = CalculatePixelFormatSize(_texData.pixelFormat, width, height);
+    _texData.mipmapLevel = std::min(_texData.mipmapLevel, CalculateMipCount(width, height));
+    _texData.size = CalculateMipChainSize(_texData.pixelFormat, width, height, _texData.mipmapLevel);
     bSizeChanged = true;
     ANSafeFree(_texData.data);
     _texData.data = (UInt8 *)AN_MALLOC_ALIGNED(_texData.size, 4);
@@ -126,10 +345,69 @@ UInt32 Texture2D::getDataSize() const {
 }
 
 void Texture2D::setPixelData(const UInt8 *data) {
+    ANAssert(_texData.data != nullptr);
+    /// compressed data comes with every level encoded
+    if (IsCompressedBCPixelFormat(_texData.pixelFormat)) {
+        setMipChainData(data);
+        return;
+    }
+    memcpy(_texData.data, data, getDataSize());
+    if (_texData.mipmapLevel > 1) {
+        buildMipChain();
+    }
+}
+
+void Texture2D::setMipChainData(const UInt8 *data) {
     ANAssert(_texData.data != nullptr);
     memcpy(_texData.data, data, _texData.size);
 }
 
+void *Texture2D::getMipData(UInt32 level) const {
+    if (_texData.data == nullptr || level >= _texData.mipmapLevel) return nullptr;
+    return _texData.data + CalculateMipOffset(_texData.pixelFormat, _texData.width, _texData.height, level);
+}
+
+bool Texture2D::buildMipChain() {
+    ANAssert(_texData.data != nullptr);
+    if (_texData.mipmapLevel <= 1) return true;
+
+    if (!GenerateMipChain(_texData.data, _texData.width, _texData.height,
+                          _texData.pixelFormat, _texData.mipmapLevel, _mipChainSettings)) {
+        AN_LOG(Warning, "Texture2D %s pixel format %d has no CPU mip filter, keep the first level only",
+               getName().c_str(), _texData.pixelFormat);
+        _texData.mipmapLevel = 1;
+        _texData.size = getDataSize();
+        return false;
+    }
+    return true;
+}
+
+bool Texture2D::compress(const TextureCompressionSettings &settings) {
+    ANAssert(_texData.data != nullptr);
+    if (!IsTextureCompressionSupported(_texData.pixelFormat, settings.format)) {
+        AN_LOG(Warning, "Texture2D %s cannot compress pixel format %d to %d",
+               getName().c_str(), _texData.pixelFormat, settings.format);
+        return false;
+    }
+    if (_texData.width % 4 != 0 || _texData.height % 4 != 0) {
+        AN_LOG(Warning, "Texture2D %s size %ux%u is not a multiple of 4, keep it uncompressed",
+               getName().c_str(), _texData.width, _texData.height);
+        return false;
+    }
+
+    UInt64 size = CalculateMipChainSize(settings.format, _texData.width, _texData.height, _texData.mipmapLevel);
+    UInt8 *data = (UInt8 *)AN_MALLOC_ALIGNED(size, 4);
+    CompressTexture(_texData.data, _texData.pixelFormat, _texData.width, _texData.height,
+                    _texData.mipmapLevel, data, settings);
+
+    ANSafeFree(_texData.data);
+    _texData.data = data;
+    _texData.size = size;
+    _texData.pixelFormat = settings.format;
+    bSizeChanged = true;
+    return true;
+}
+
 template<typename _Coder>
 void Texture2D::transfer(_Coder &coder) {
     Super::transfer(coder);
@@ -138,6 +416,7 @@ void Texture2D::transfer(_Coder &coder) {
     coder.transfer(_texData.height, "height");
     coder.transfer(_texData.mipmapLevel, "mipmapLevel");
     coder.transfer(_texData.pixelFormat, "pixelFormat");
+    coder.transfer(bStreaming, "streaming");
 
     coder.transferTypeless(_texData.size, "dataSize");
     if constexpr (_Coder::IsDecoding()) {
@@ -152,6 +431,17 @@ bool Texture2D::initAfterDecode() {
         return false;
     }
 
+    /// assets imported before the chain was stored only hold the first level
+    UInt64 chainSize = CalculateMipChainSize(_texData.pixelFormat, _texData.width, _texData.height, _texData.mipmapLevel);
+    if (_texData.data && _texData.mipmapLevel > 1 && _texData.size < chainSize) {
+        UInt8 *data = (UInt8 *)AN_MALLOC_ALIGNED(chainSize, 4);
+        memcpy(data, _texData.data, _texData.size);
+        ANSafeFree(_texData.data);
+        _texData.data = data;
+        _texData.size = chainSize;
+        buildMipChain();
+    }
+
     uploadToGPU();
 
     return true;
@@ -0,0 +1,817 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/TextureCompressor.hpp"
+#include "Render/MipChain.hpp"
+#include "Threads/ParallelFor.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace AN {
+
+/// blocks encoded by one task
+static constexpr size_t kBlocksPerTask = 256;
+
+/// BC7 4 bit index interpolation weights out of 64
+static constexpr int kBC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+/// texels of a 4x4 block, 0 to 255 per channel
+struct BlockTexels {
+    float texels[16][4];
+};
+
+struct BitWriter {
+    UInt8 *data;
+    UInt32 position = 0;
+
+    void write(UInt32 value, UInt32 bits) {
+        for (UInt32 i = 0; i < bits; ++i, ++position) {
+            if ((value >> i) & 1) data[position >> 3] |= (UInt8) (1 << (position & 7));
+        }
+    }
+};
+
+struct BitReader {
+    const UInt8 *data;
+    UInt32       position = 0;
+
+    UInt32 read(UInt32 bits) {
+        UInt32 value = 0;
+        for (UInt32 i = 0; i < bits; ++i, ++position) {
+            value |= (UInt32) ((data[position >> 3] >> (position & 7)) & 1) << i;
+        }
+        return value;
+    }
+};
+
+static UInt32 GetSourceChannelCount(PixelFormat pixelFormat) {
+    switch (pixelFormat) {
+        case kPixelFormatR8Unorm:
+        case kPixelFormatR8Unorm_sRGB:
+            return 1;
+        case kPixelFormatRG8Unorm_sRGB:
+            return 2;
+        case kPixelFormatRGBA8Unorm:
+        case kPixelFormatRGBA8Unorm_sRGB:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+static UInt32 GetBlockSize(PixelFormat pixelFormat) {
+    switch (pixelFormat) {
+        case kPixelFormatBC1_RGBA:
+        case kPixelFormatBC1_RGBA_sRGB:
+        case kPixelFormatBC4_RUnorm:
+            return 8;
+        case kPixelFormatBC3_RGBA:
+        case kPixelFormatBC3_RGBA_sRGB:
+        case kPixelFormatBC5_RGUnorm:
+        case kPixelFormatBC7_RGBAUnorm:
+        case kPixelFormatBC7_RGBAUnorm_sRGB:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+static float Square(float value) {
+    return value * value;
+}
+
+/// unit length for xyz normals, xy normals are only kept inside the unit circle
+static void NormalizeTexel(float *texel, UInt32 channels) {
+    float x = texel[0] / 127.5f - 1.f;
+    float y = texel[1] / 127.5f - 1.f;
+    float z = channels > 2 ? texel[2] / 127.5f - 1.f : 0.f;
+    float length = std::sqrt(x * x + y * y + z * z);
+    if (length < 1e-4f || (channels == 2 && length <= 1.f)) return;
+    texel[0] = (x / length + 1.f) * 127.5f;
+    texel[1] = (y / length + 1.f) * 127.5f;
+    if (channels > 2) texel[2] = (z / length + 1.f) * 127.5f;
+}
+
+/// texels past the edge repeat the last row and column
+static void LoadBlock(const UInt8 *level, UInt32 width, UInt32 height, UInt32 channels,
+                      UInt32 blockX, UInt32 blockY, bool bNormalMap, BlockTexels &block) {
+    for (UInt32 y = 0; y < 4; ++y) {
+        UInt32 sourceY = std::min(blockY * 4 + y, height - 1);
+        for (UInt32 x = 0; x < 4; ++x) {
+            UInt32       sourceX = std::min(blockX * 4 + x, width - 1);
+            const UInt8 *texel   = level + ((size_t) sourceY * width + sourceX) * channels;
+            float       *result  = block.texels[y * 4 + x];
+            result[0] = texel[0];
+            result[1] = channels > 1 ? texel[1] : 0.f;
+            result[2] = channels > 2 ? texel[2] : 0.f;
+            result[3] = channels > 3 ? texel[3] : 255.f;
+            if (bNormalMap && channels > 1) {
+                NormalizeTexel(result, channels);
+            }
+        }
+    }
+}
+
+/// principal axis of the masked texels through their mean, power iteration on the covariance
+static void ComputePrincipalAxis(const BlockTexels &block, const bool *mask, UInt32 dimensions,
+                                 float mean[4], float axis[4]) {
+    UInt32 count = 0;
+    std::fill_n(mean, 4, 0.f);
+    for (UInt32 i = 0; i < 16; ++i) {
+        if (mask && !mask[i]) continue;
+        for (UInt32 c = 0; c < dimensions; ++c) mean[c] += block.texels[i][c];
+        ++count;
+    }
+    for (UInt32 c = 0; c < dimensions; ++c) mean[c] /= (float) std::max(count, 1U);
+
+    float covariance[4][4] = {};
+    for (UInt32 i = 0; i < 16; ++i) {
+        if (mask && !mask[i]) continue;
+        float delta[4];
+        for (UInt32 c = 0; c < dimensions; ++c) delta[c] = block.texels[i][c] - mean[c];
+        for (UInt32 r = 0; r < dimensions; ++r) {
+            for (UInt32 c = 0; c < dimensions; ++c) covariance[r][c] += delta[r] * delta[c];
+        }
+    }
+
+    /// start from the row of the channel varying most, it is never orthogonal to the principal axis
+    UInt32 start = 0;
+    for (UInt32 c = 1; c < dimensions; ++c) {
+        if (covariance[c][c] > covariance[start][start]) start = c;
+    }
+    std::fill_n(axis, 4, 0.f);
+    for (UInt32 c = 0; c < dimensions; ++c) axis[c] = covariance[start][c];
+
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[4] = {};
+        for (UInt32 r = 0; r < dimensions; ++r) {
+            for (UInt32 c = 0; c < dimensions; ++c) next[r] += covariance[r][c] * axis[c];
+        }
+        float length = 0.f;
+        for (UInt32 c = 0; c < dimensions; ++c) length += next[c] * next[c];
+        if (length < 1e-12f) break;
+        length = 1.f / std::sqrt(length);
+        for (UInt32 c = 0; c < dimensions; ++c) axis[c] = next[c] * length;
+    }
+}
+
+static void ComputeAxisEndpoints(const BlockTexels &block, const bool *mask, UInt32 dimensions,
+                                 float first[4], float second[4]) {
+    float mean[4], axis[4];
+    ComputePrincipalAxis(block, mask, dimensions, mean, axis);
+
+    float minT = FLT_MAX, maxT = -FLT_MAX;
+    for (UInt32 i = 0; i < 16; ++i) {
+        if (mask && !mask[i]) continue;
+        float t = 0.f;
+        for (UInt32 c = 0; c < dimensions; ++c) t += (block.texels[i][c] - mean[c]) * axis[c];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    for (UInt32 c = 0; c < 4; ++c) {
+        first[c]  = c < dimensions ? std::clamp(mean[c] + axis[c] * minT, 0.f, 255.f) : 255.f;
+        second[c] = c < dimensions ? std::clamp(mean[c] + axis[c] * maxT, 0.f, 255.f) : 255.f;
+    }
+}
+
+/// least squares endpoints for fixed indices, weights[i] is the share of the first endpoint in texel i,
+/// negative weights leave the texel out
+static bool SolveEndpoints(const BlockTexels &block, UInt32 firstChannel, UInt32 channelCount,
+                           const float weights[16], float first[4], float second[4]) {
+    float aa = 0.f, bb = 0.f, ab = 0.f;
+    float ax[4] = {}, bx[4] = {};
+    for (UInt32 i = 0; i < 16; ++i) {
+        if (weights[i] < 0.f) continue;
+        float alpha = weights[i], beta = 1.f - weights[i];
+        aa += alpha * alpha;
+        bb += beta * beta;
+        ab += alpha * beta;
+        for (UInt32 c = 0; c < channelCount; ++c) {
+            ax[c] += alpha * block.texels[i][firstChannel + c];
+            bx[c] += beta * block.texels[i][firstChannel + c];
+        }
+    }
+    float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f) return false;
+    for (UInt32 c = 0; c < channelCount; ++c) {
+        first[c]  = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.f, 255.f);
+        second[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.f, 255.f);
+    }
+    return true;
+}
+
+/// ------------------------------------------------------------------ BC1
+
+struct BC1Block {
+    UInt16 color0, color1;
+    UInt32 indices;
+    float  error;
+};
+
+static UInt16 QuantizeRGB565(const float rgb[3]) {
+    int r = (int) std::lround(std::clamp(rgb[0], 0.f, 255.f) * 31.f / 255.f);
+    int g = (int) std::lround(std::clamp(rgb[1], 0.f, 255.f) * 63.f / 255.f);
+    int b = (int) std::lround(std::clamp(rgb[2], 0.f, 255.f) * 31.f / 255.f);
+    return (UInt16) ((r << 11) | (g << 5) | b);
+}
+
+static void ExpandRGB565(UInt16 color, int rgb[3]) {
+    int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+/// BC3 color always holds four colors, BC1 switches to three colors and transparent black when color0 <= color1
+static void DecodeBC1Palette(UInt16 color0, UInt16 color1, bool bForceFourColor, int palette[4][4]) {
+    ExpandRGB565(color0, palette[0]);
+    ExpandRGB565(color1, palette[1]);
+    palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+    if (bForceFourColor || color0 > color1) {
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+        }
+    } else {
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+            palette[3][c] = 0;
+        }
+        palette[3][3] = 0;
+    }
+}
+
+static void FitBC1Indices(const BlockTexels &block, const bool *transparent, bool bForceFourColor, BC1Block &result) {
+    /// transparent texels need the three color order, opaque blocks the four color one
+    if (transparent ? result.color0 > result.color1 : result.color0 < result.color1) {
+        std::swap(result.color0, result.color1);
+    }
+
+    int palette[4][4];
+    DecodeBC1Palette(result.color0, result.color1, bForceFourColor, palette);
+    UInt32 candidates = bForceFourColor || result.color0 > result.color1 ? 4 : 3;
+
+    result.indices = 0;
+    result.error   = 0.f;
+    for (UInt32 i = 0; i < 16; ++i) {
+        if (transparent && transparent[i]) {
+            result.indices |= 3U << (i * 2);
+            continue;
+        }
+        UInt32 bestIndex = 0;
+        float  bestError = FLT_MAX;
+        for (UInt32 p = 0; p < candidates; ++p) {
+            float error = Square(block.texels[i][0] - (float) palette[p][0]) +
+                          Square(block.texels[i][1] - (float) palette[p][1]) +
+                          Square(block.texels[i][2] - (float) palette[p][2]);
+            if (error < bestError) {
+                bestError = error;
+                bestIndex = p;
+            }
+        }
+        result.indices |= bestIndex << (i * 2);
+        result.error += bestError;
+    }
+}
+
+static void EncodeBC1(const BlockTexels &block, bool bForceFourColor, TextureCompressionQuality quality, UInt8 *out) {
+    bool transparent[16], opaque[16];
+    bool bThreeColor = false, bAnyOpaque = false;
+    for (UInt32 i = 0; i < 16; ++i) {
+        transparent[i] = !bForceFourColor && block.texels[i][3] < 128.f;
+        opaque[i]      = !transparent[i];
+        bThreeColor |= transparent[i];
+        bAnyOpaque |= opaque[i];
+    }
+
+    BC1Block best{};
+    if (!bAnyOpaque) {
+        best.indices = 0xFFFFFFFF;
+    } else {
+        const bool *transparentMask = bThreeColor ? transparent : nullptr;
+
+        float first[4], second[4];
+        ComputeAxisEndpoints(block, opaque, 3, first, second);
+        best.color0 = QuantizeRGB565(second);
+        best.color1 = QuantizeRGB565(first);
+        FitBC1Indices(block, transparentMask, bForceFourColor, best);
+
+        int iterations = quality == kTextureCompressionQualityFast ? 0 : quality == kTextureCompressionQualityNormal ? 2 : 6;
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+            bool  bFourColor = bForceFourColor || best.color0 > best.color1;
+            float weights[16];
+            for (UInt32 i = 0; i < 16; ++i) {
+                UInt32 index = (best.indices >> (i * 2)) & 3;
+                if (transparent[i]) {
+                    weights[i] = -1.f;
+                } else if (bFourColor) {
+                    constexpr float kFourColorWeights[4] = { 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+                    weights[i] = kFourColorWeights[index];
+                } else {
+                    constexpr float kThreeColorWeights[4] = { 1.f, 0.f, 0.5f, -1.f };
+                    weights[i] = kThreeColorWeights[index];
+                }
+            }
+            if (!SolveEndpoints(block, 0, 3, weights, first, second)) break;
+
+            BC1Block candidate{ QuantizeRGB565(first), QuantizeRGB565(second) };
+            FitBC1Indices(block, transparentMask, bForceFourColor, candidate);
+            if (candidate.error >= best.error) break;
+            best = candidate;
+        }
+
+        if (quality == kTextureCompressionQualityHigh) {
+            /// step single 565 components while the error drops
+            constexpr UInt16 kShifts[3] = { 11, 5, 0 };
+            constexpr UInt16 kMasks[3]  = { 31, 63, 31 };
+            for (int pass = 0; pass < 4; ++pass) {
+                bool bImproved = false;
+                for (int endpoint = 0; endpoint < 2; ++endpoint) {
+                    for (int channel = 0; channel < 3; ++channel) {
+                        for (int delta = -1; delta <= 1; delta += 2) {
+                            BC1Block candidate = best;
+                            UInt16  &color     = endpoint == 0 ? candidate.color0 : candidate.color1;
+                            int      value     = ((color >> kShifts[channel]) & kMasks[channel]) + delta;
+                            if (value < 0 || value > kMasks[channel]) continue;
+                            color = (UInt16) ((color & ~(kMasks[channel] << kShifts[channel])) | (value << kShifts[channel]));
+                            FitBC1Indices(block, transparentMask, bForceFourColor, candidate);
+                            if (candidate.error < best.error) {
+                                best      = candidate;
+                                bImproved = true;
+                            }
+                        }
+                    }
+                }
+                if (!bImproved) break;
+            }
+        }
+    }
+
+    out[0] = (UInt8) (best.color0 & 0xFF);
+    out[1] = (UInt8) (best.color0 >> 8);
+    out[2] = (UInt8) (best.color1 & 0xFF);
+    out[3] = (UInt8) (best.color1 >> 8);
+    for (int i = 0; i < 4; ++i) out[4 + i] = (UInt8) (best.indices >> (i * 8));
+}
+
+static void DecodeBC1(const UInt8 *data, bool bForceFourColor, UInt8 texels[16][4]) {
+    UInt16 color0  = (UInt16) (data[0] | (data[1] << 8));
+    UInt16 color1  = (UInt16) (data[2] | (data[3] << 8));
+    UInt32 indices = data[4] | (data[5] << 8) | (data[6] << 16) | ((UInt32) data[7] << 24);
+
+    int palette[4][4];
+    DecodeBC1Palette(color0, color1, bForceFourColor, palette);
+    for (UInt32 i = 0; i < 16; ++i) {
+        const int *color = palette[(indices >> (i * 2)) & 3];
+        for (int c = 0; c < 4; ++c) texels[i][c] = (UInt8) color[c];
+    }
+}
+
+/// ------------------------------------------------------------------ BC4
+
+struct BC4Block {
+    int    value0, value1;
+    UInt64 indices;
+    float  error;
+};
+
+/// eight interpolated values when value0 > value1, otherwise six plus 0 and 255
+static void DecodeBC4Palette(int value0, int value1, int palette[8]) {
+    palette[0] = value0;
+    palette[1] = value1;
+    if (value0 > value1) {
+        for (int i = 1; i < 7; ++i) palette[i + 1] = ((7 - i) * value0 + i * value1 + 3) / 7;
+    } else {
+        for (int i = 1; i < 5; ++i) palette[i + 1] = ((5 - i) * value0 + i * value1 + 2) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+static void FitBC4Indices(const BlockTexels &block, UInt32 channel, BC4Block &result) {
+    int palette[8];
+    DecodeBC4Palette(result.value0, result.value1, palette);
+
+    result.indices = 0;
+    result.error   = 0.f;
+    for (UInt32 i = 0; i < 16; ++i) {
+        UInt64 bestIndex = 0;
+        float  bestError = FLT_MAX;
+        for (UInt32 p = 0; p < 8; ++p) {
+            float error = Square(block.texels[i][channel] - (float) palette[p]);
+            if (error < bestError) {
+                bestError = error;
+                bestIndex = p;
+            }
+        }
+        result.indices |= bestIndex << (i * 3);
+        result.error += bestError;
+    }
+}
+
+/// refit the endpoints of the mode best is in, the order of the endpoints selects the mode
+static void RefineBC4(const BlockTexels &block, UInt32 channel, int iterations, BC4Block &best) {
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        bool  bEightValues = best.value0 > best.value1;
+        float weights[16];
+        for (UInt32 i = 0; i < 16; ++i) {
+            int index = (int) ((best.indices >> (i * 3)) & 7);
+            if (index < 2) {
+                weights[i] = index == 0 ? 1.f : 0.f;
+            } else if (bEightValues) {
+                weights[i] = (float) (8 - index) / 7.f;
+            } else {
+                weights[i] = index < 6 ? (float) (6 - index) / 5.f : -1.f;
+            }
+        }
+
+        float first[4], second[4];
+        if (!SolveEndpoints(block, channel, 1, weights, first, second)) break;
+
+        BC4Block candidate{ (int) std::lround(first[0]), (int) std::lround(second[0]) };
+        if (bEightValues ? candidate.value0 < candidate.value1 : candidate.value0 > candidate.value1) {
+            std::swap(candidate.value0, candidate.value1);
+        }
+        if (bEightValues && candidate.value0 == candidate.value1) break;
+
+        FitBC4Indices(block, channel, candidate);
+        if (candidate.error >= best.error) break;
+        best = candidate;
+    }
+}
+
+static void EncodeBC4(const BlockTexels &block, UInt32 channel, TextureCompressionQuality quality, UInt8 *out) {
+    float minValue = 255.f, maxValue = 0.f;
+    float innerMin = 255.f, innerMax = 0.f;
+    for (UInt32 i = 0; i < 16; ++i) {
+        float value = block.texels[i][channel];
+        minValue    = std::min(minValue, value);
+        maxValue    = std::max(maxValue, value);
+        if (value > 0.5f && value < 254.5f) {
+            innerMin = std::min(innerMin, value);
+            innerMax = std::max(innerMax, value);
+        }
+    }
+
+    BC4Block best{ (int) std::lround(maxValue), (int) std::lround(minValue) };
+    FitBC4Indices(block, channel, best);
+
+    if (quality != kTextureCompressionQualityFast && best.error > 0.f) {
+        int iterations = quality == kTextureCompressionQualityNormal ? 2 : 4;
+        RefineBC4(block, channel, iterations, best);
+
+        /// the six value mode reaches 0 and 255 exactly, its endpoints only span the texels between
+        if (innerMin <= innerMax) {
+            BC4Block candidate{ (int) std::lround(innerMin), (int) std::lround(innerMax) };
+            FitBC4Indices(block, channel, candidate);
+            RefineBC4(block, channel, iterations, candidate);
+            if (candidate.error < best.error) best = candidate;
+        }
+
+        if (quality == kTextureCompressionQualityHigh) {
+            BC4Block center = best;
+            bool     bEightValues = center.value0 > center.value1;
+            for (int delta0 = -2; delta0 <= 2; ++delta0) {
+                for (int delta1 = -2; delta1 <= 2; ++delta1) {
+                    BC4Block candidate{ std::clamp(center.value0 + delta0, 0, 255), std::clamp(center.value1 + delta1, 0, 255) };
+                    if ((candidate.value0 > candidate.value1) != bEightValues) continue;
+                    FitBC4Indices(block, channel, candidate);
+                    if (candidate.error < best.error) best = candidate;
+                }
+            }
+        }
+    }
+
+    out[0] = (UInt8) best.value0;
+    out[1] = (UInt8) best.value1;
+    for (int i = 0; i < 6; ++i) out[2 + i] = (UInt8) (best.indices >> (i * 8));
+}
+
+static void DecodeBC4(const UInt8 *data, UInt32 channel, UInt8 texels[16][4]) {
+    int palette[8];
+    DecodeBC4Palette(data[0], data[1], palette);
+    UInt64 indices = 0;
+    for (int i = 0; i < 6; ++i) indices |= (UInt64) data[2 + i] << (i * 8);
+    for (UInt32 i = 0; i < 16; ++i) {
+        texels[i][channel] = (UInt8) palette[(indices >> (i * 3)) & 7];
+    }
+}
+
+/// ------------------------------------------------------------------ BC7
+
+/// mode 6 only, one RGBA subset with 7 bit endpoints, a p bit per endpoint and 4 bit indices
+struct BC7Block {
+    int   endpoints[2][4]; // 8 bit values, the lowest bit is the p bit of the endpoint
+    UInt8 indices[16];
+    float error;
+};
+
+static float QuantizeBC7Endpoint(const float value[4], int pBit, int result[4]) {
+    float error = 0.f;
+    for (int c = 0; c < 4; ++c) {
+        int quantized = std::clamp((int) std::lround((value[c] - (float) pBit) * 0.5f), 0, 127);
+        result[c]     = quantized * 2 + pBit;
+        error += Square(value[c] - (float) result[c]);
+    }
+    return error;
+}
+
+static void FitBC7Indices(const BlockTexels &block, BC7Block &result) {
+    int palette[16][4];
+    for (int p = 0; p < 16; ++p) {
+        for (int c = 0; c < 4; ++c) {
+            palette[p][c] = ((64 - kBC7Weights4[p]) * result.endpoints[0][c] + kBC7Weights4[p] * result.endpoints[1][c] + 32) >> 6;
+        }
+    }
+
+    /// project on the endpoint line and only compare the entries around the projection
+    float direction[4], length = 0.f;
+    for (int c = 0; c < 4; ++c) {
+        direction[c] = (float) (result.endpoints[1][c] - result.endpoints[0][c]);
+        length += direction[c] * direction[c];
+    }
+    float scale = length > 0.f ? 15.f / length : 0.f;
+
+    result.error = 0.f;
+    for (UInt32 i = 0; i < 16; ++i) {
+        float t = 0.f;
+        for (int c = 0; c < 4; ++c) t += (block.texels[i][c] - (float) result.endpoints[0][c]) * direction[c];
+        int center = std::clamp((int) std::lround(t * scale), 0, 15);
+
+        int   bestIndex = 0;
+        float bestError = FLT_MAX;
+        for (int p = std::max(center - 1, 0); p <= std::min(center + 1, 15); ++p) {
+            float error = 0.f;
+            for (int c = 0; c < 4; ++c) error += Square(block.texels[i][c] - (float) palette[p][c]);
+            if (error < bestError) {
+                bestError = error;
+                bestIndex = p;
+            }
+        }
+        result.indices[i] = (UInt8) bestIndex;
+        result.error += bestError;
+    }
+}
+
+/// fast quality picks each p bit for its endpoint alone, the others compare the four combinations on the block
+static void TryBC7Endpoints(const BlockTexels &block, const float first[4], const float second[4],
+                            TextureCompressionQuality quality, BC7Block &best) {
+    if (quality == kTextureCompressionQualityFast) {
+        BC7Block candidate, other;
+        if (QuantizeBC7Endpoint(first, 1, other.endpoints[0]) < QuantizeBC7Endpoint(first, 0, candidate.endpoints[0])) {
+            std::copy_n(other.endpoints[0], 4, candidate.endpoints[0]);
+        }
+        if (QuantizeBC7Endpoint(second, 1, other.endpoints[1]) < QuantizeBC7Endpoint(second, 0, candidate.endpoints[1])) {
+            std::copy_n(other.endpoints[1], 4, candidate.endpoints[1]);
+        }
+        FitBC7Indices(block, candidate);
+        if (candidate.error < best.error) best = candidate;
+        return;
+    }
+
+    for (int pBits = 0; pBits < 4; ++pBits) {
+        BC7Block candidate;
+        QuantizeBC7Endpoint(first, pBits & 1, candidate.endpoints[0]);
+        QuantizeBC7Endpoint(second, pBits >> 1, candidate.endpoints[1]);
+        FitBC7Indices(block, candidate);
+        if (candidate.error < best.error) best = candidate;
+    }
+}
+
+static void EncodeBC7(const BlockTexels &block, TextureCompressionQuality quality, UInt8 *out) {
+    BC7Block best;
+    best.error = FLT_MAX;
+
+    float first[4], second[4];
+    ComputeAxisEndpoints(block, nullptr, 4, first, second);
+    TryBC7Endpoints(block, first, second, quality, best);
+
+    int iterations = quality == kTextureCompressionQualityFast ? 0 : quality == kTextureCompressionQualityNormal ? 2 : 6;
+    for (int iteration = 0; iteration < iterations && best.error > 0.f; ++iteration) {
+        float weights[16];
+        for (UInt32 i = 0; i < 16; ++i) weights[i] = (float) (64 - kBC7Weights4[best.indices[i]]) / 64.f;
+        if (!SolveEndpoints(block, 0, 4, weights, first, second)) break;
+
+        float previous = best.error;
+        TryBC7Endpoints(block, first, second, quality, best);
+        if (best.error >= previous) break;
+    }
+
+    if (quality == kTextureCompressionQualityHigh) {
+        /// step single 7 bit components while the error drops
+        for (int pass = 0; pass < 4 && best.error > 0.f; ++pass) {
+            bool bImproved = false;
+            for (int endpoint = 0; endpoint < 2; ++endpoint) {
+                for (int channel = 0; channel < 4; ++channel) {
+                    for (int delta = -2; delta <= 2; delta += 4) {
+                        BC7Block candidate = best;
+                        int      value     = candidate.endpoints[endpoint][channel] + delta;
+                        if (value < 0 || value > 255) continue;
+                        candidate.endpoints[endpoint][channel] = value;
+                        FitBC7Indices(block, candidate);
+                        if (candidate.error < best.error) {
+                            best      = candidate;
+                            bImproved = true;
+                        }
+                    }
+                }
+            }
+            if (!bImproved) break;
+        }
+    }
+
+    /// the highest index bit of texel 0 is implicit zero
+    if (best.indices[0] >= 8) {
+        for (int c = 0; c < 4; ++c) std::swap(best.endpoints[0][c], best.endpoints[1][c]);
+        for (UInt8 &index : best.indices) index = (UInt8) (15 - index);
+    }
+
+    memset(out, 0, 16);
+    BitWriter writer{ out };
+    writer.write(1 << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+        writer.write((UInt32) best.endpoints[0][c] >> 1, 7);
+        writer.write((UInt32) best.endpoints[1][c] >> 1, 7);
+    }
+    writer.write(best.endpoints[0][0] & 1, 1);
+    writer.write(best.endpoints[1][0] & 1, 1);
+    writer.write(best.indices[0], 3);
+    for (int i = 1; i < 16; ++i) writer.write(best.indices[i], 4);
+}
+
+static bool DecodeBC7(const UInt8 *data, UInt8 texels[16][4]) {
+    BitReader reader{ data };
+    if (reader.read(7) != 1 << 6) return false;
+
+    int endpoints[2][4];
+    for (int c = 0; c < 4; ++c) {
+        endpoints[0][c] = (int) reader.read(7) << 1;
+        endpoints[1][c] = (int) reader.read(7) << 1;
+    }
+    int pBit0 = (int) reader.read(1), pBit1 = (int) reader.read(1);
+    for (int c = 0; c < 4; ++c) {
+        endpoints[0][c] |= pBit0;
+        endpoints[1][c] |= pBit1;
+    }
+
+    for (UInt32 i = 0; i < 16; ++i) {
+        int weight = kBC7Weights4[reader.read(i == 0 ? 3 : 4)];
+        for (int c = 0; c < 4; ++c) {
+            texels[i][c] = (UInt8) (((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+        }
+    }
+    return true;
+}
+
+/// ------------------------------------------------------------------
+
+static void EncodeBlock(const BlockTexels &block, const TextureCompressionSettings &settings, UInt8 *out) {
+    switch (settings.format) {
+        case kPixelFormatBC1_RGBA:
+        case kPixelFormatBC1_RGBA_sRGB:
+            EncodeBC1(block, false, settings.quality, out);
+            break;
+        case kPixelFormatBC3_RGBA:
+        case kPixelFormatBC3_RGBA_sRGB:
+            EncodeBC4(block, 3, settings.quality, out);
+            EncodeBC1(block, true, settings.quality, out + 8);
+            break;
+        case kPixelFormatBC4_RUnorm:
+            EncodeBC4(block, 0, settings.quality, out);
+            break;
+        case kPixelFormatBC5_RGUnorm:
+            EncodeBC4(block, 0, settings.quality, out);
+            EncodeBC4(block, 1, settings.quality, out + 8);
+            break;
+        case kPixelFormatBC7_RGBAUnorm:
+        case kPixelFormatBC7_RGBAUnorm_sRGB:
+            EncodeBC7(block, settings.quality, out);
+            break;
+        default:
+            break;
+    }
+}
+
+static bool DecodeBlock(const UInt8 *data, PixelFormat format, UInt8 texels[16][4]) {
+    switch (format) {
+        case kPixelFormatBC1_RGBA:
+        case kPixelFormatBC1_RGBA_sRGB:
+            DecodeBC1(data, false, texels);
+            return true;
+        case kPixelFormatBC3_RGBA:
+        case kPixelFormatBC3_RGBA_sRGB:
+            DecodeBC1(data + 8, true, texels);
+            DecodeBC4(data, 3, texels);
+            return true;
+        case kPixelFormatBC4_RUnorm:
+            for (UInt32 i = 0; i < 16; ++i) texels[i][1] = texels[i][2] = 0, texels[i][3] = 255;
+            DecodeBC4(data, 0, texels);
+            return true;
+        case kPixelFormatBC5_RGUnorm:
+            for (UInt32 i = 0; i < 16; ++i) texels[i][2] = 0, texels[i][3] = 255;
+            DecodeBC4(data, 0, texels);
+            DecodeBC4(data + 8, 1, texels);
+            return true;
+        case kPixelFormatBC7_RGBAUnorm:
+        case kPixelFormatBC7_RGBAUnorm_sRGB:
+            return DecodeBC7(data, texels);
+        default:
+            return false;
+    }
+}
+
+static void CompressLevel(const UInt8 *src, UInt32 channels, UInt32 width, UInt32 height,
+                          UInt8 *dst, const TextureCompressionSettings &settings) {
+    UInt32 blocksX   = (width + 3) / 4;
+    UInt32 blocksY   = (height + 3) / 4;
+    UInt32 blockSize = GetBlockSize(settings.format);
+
+    ParallelFor(blocksY, std::max<size_t>(1, kBlocksPerTask / blocksX), [&](size_t begin, size_t end) {
+        BlockTexels block;
+        for (size_t blockY = begin; blockY < end; ++blockY) {
+            for (UInt32 blockX = 0; blockX < blocksX; ++blockX) {
+                LoadBlock(src, width, height, channels, blockX, (UInt32) blockY, settings.bNormalMap, block);
+                EncodeBlock(block, settings, dst + (blockY * blocksX + blockX) * blockSize);
+            }
+        }
+    });
+}
+
+bool IsTextureCompressionSupported(PixelFormat srcFormat, PixelFormat dstFormat) {
+    return GetSourceChannelCount(srcFormat) != 0 && GetBlockSize(dstFormat) != 0;
+}
+
+PixelFormat SelectCompressedPixelFormat(const UInt8 *src, UInt32 width, UInt32 height, PixelFormat srcFormat,
+                                        bool bNormalMap, TextureCompressionQuality quality) {
+    bool bSRGB = srcFormat == kPixelFormatR8Unorm_sRGB || srcFormat == kPixelFormatRG8Unorm_sRGB ||
+                 srcFormat == kPixelFormatRGBA8Unorm_sRGB;
+    bool bHigh = quality == kTextureCompressionQualityHigh;
+
+    switch (GetSourceChannelCount(srcFormat)) {
+        case 1:
+            /// BC4 has no sRGB variant, sRGB masks keep their curve in the red channel of BC1
+            return bSRGB ? kPixelFormatBC1_RGBA_sRGB : kPixelFormatBC4_RUnorm;
+        case 2:
+            if (bNormalMap || !bSRGB) return kPixelFormatBC5_RGUnorm;
+            return kPixelFormatBC7_RGBAUnorm_sRGB;
+        case 4:
+            break;
+        default:
+            return srcFormat;
+    }
+
+    if (bNormalMap) {
+        /// shaders unpack RGB normals, BC5 is left to an explicit setting
+        return bHigh ? kPixelFormatBC7_RGBAUnorm : kPixelFormatBC1_RGBA;
+    }
+
+    bool   bAlpha = false;
+    size_t count  = (size_t) width * height;
+    for (size_t i = 0; i < count && !bAlpha; ++i) {
+        bAlpha = src[i * 4 + 3] != 255;
+    }
+
+    if (bHigh) return bSRGB ? kPixelFormatBC7_RGBAUnorm_sRGB : kPixelFormatBC7_RGBAUnorm;
+    if (bAlpha) return bSRGB ? kPixelFormatBC3_RGBA_sRGB : kPixelFormatBC3_RGBA;
+    return bSRGB ? kPixelFormatBC1_RGBA_sRGB : kPixelFormatBC1_RGBA;
+}
+
+bool CompressTexture(const UInt8 *src, PixelFormat srcFormat, UInt32 width, UInt32 height, UInt32 mipCount,
+                     UInt8 *dst, const TextureCompressionSettings &settings) {
+    if (!IsTextureCompressionSupported(srcFormat, settings.format) || width == 0 || height == 0) return false;
+
+    UInt32 channels = GetSourceChannelCount(srcFormat);
+    mipCount        = std::clamp(mipCount, 1U, CalculateMipCount(width, height));
+    for (UInt32 level = 0; level < mipCount; ++level) {
+        CompressLevel(src + CalculateMipOffset(srcFormat, width, height, level), channels,
+                      CalculateMipSize(width, level), CalculateMipSize(height, level),
+                      dst + CalculateMipOffset(settings.format, width, height, level), settings);
+    }
+    return true;
+}
+
+bool DecompressTexture(const UInt8 *src, PixelFormat format, UInt32 width, UInt32 height, UInt8 *dstRGBA) {
+    UInt32 blockSize = GetBlockSize(format);
+    if (blockSize == 0) return false;
+
+    UInt32 blocksX = (width + 3) / 4;
+    UInt32 blocksY = (height + 3) / 4;
+    for (UInt32 blockY = 0; blockY < blocksY; ++blockY) {
+        for (UInt32 blockX = 0; blockX < blocksX; ++blockX) {
+            UInt8 texels[16][4];
+            if (!DecodeBlock(src + ((size_t) blockY * blocksX + blockX) * blockSize, format, texels)) return false;
+
+            for (UInt32 y = 0; y < 4 && blockY * 4 + y < height; ++y) {
+                for (UInt32 x = 0; x < 4 && blockX * 4 + x < width; ++x) {
+                    memcpy(dstRGBA + ((size_t) (blockY * 4 + y) * width + blockX * 4 + x) * 4, texels[y * 4 + x], 4);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+}
@@ -36,8 +36,22 @@ void TextureCube::setSourceTexture(UInt32 index, Texture2D *tex) {
     _sourceTextures[index] = tex;
 }
 
+bool TextureCube::initAfterDecode() {
+    /// faces hold their first level only, skip the mip chain of Texture2D
+    if (!Texture::initAfterDecode()) {
+        return false;
+    }
+
+    uploadToGPU(false);
+
+    return true;
+}
+
 void TextureCube::buildFromSources() {
     UInt32 faceSize = getDataSize();
+    if (_texData.size != faceSize * 6) {
+        ANSafeFree(_texData.data);
+    }
     if (!_texData.data) {
         _texData.data = (UInt8 *)AN_MALLOC_ALIGNED(faceSize * 6, 4);
     }
@@ -67,6 +81,7 @@ void TextureCube::uploadToGPU(bool generateMipmap) {
                                                     _texData.data,
                                                     _texData.width, _texData.height,
                                                     _texData.pixelFormat,
+                                                    1,
                                                     generateMipmap,
                                                     _samplerDescriptor);
 #endif//OJOIE_USE_VULKAN
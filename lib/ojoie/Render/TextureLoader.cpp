@@ -8,6 +8,7 @@
 
 #include "Render/Renderer.hpp"
 #include "Render/TextureLoader.hpp"
+#include "Render/MipChain.hpp"
 #include "Allocator/MemoryDefines.h"
 #include "HAL/File.hpp"
 
@@ -18,6 +19,16 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb/stb_image_write.h>
 
+#include <vector>
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#define TEXTURE_LOADER_USE_SSSE3 1
+#include <tmmintrin.h>
+#endif
+
+/// larger file buffers are released after the load
+static constexpr size_t kMaxKeptFileBufferSize = 64 << 20;
+
 
 
 
@@ -45,6 +56,10 @@ namespace AN {
 
 
 LoadTextureResult::~LoadTextureResult() {
+    release();
+}
+
+void LoadTextureResult::release() {
     if (data) {
         if (stb_free) {
             stbi_image_free(data);
@@ -59,105 +74,113 @@ LoadTextureResult::~LoadTextureResult() {
 
 namespace AN::TextureLoader {
 
-static int stb_io_read_callback(void *user,char *data,int size) {
-    File *file = (File *)user;
-    return file->Read(data, size);
-}
-
-static void stb_io_skip_callback(void *user,int n) {
-    File *file = (File *)user;
-    file->SetPosition(file->GetPosition() + n);
-}
-
-static int stb_io_eof_callback(void *user) {
-    File *file = (File *)user;
-    return file->GetFileLength() == file->GetPosition() + 1;
-}
-
 static void stbi_write_func_file_callback(void *context, void *data, int size) {
     File *file = (File *)context;
     file->Write(data, size);
 }
 
-LoadTextureResult __loadTexture(int width, int height, int nrChannels, bool sRgb, unsigned char *data) {
+void ExpandRGBToRGBA(const UInt8 *src, UInt8 *dst, size_t count) {
+    size_t i = 0;
+#ifdef TEXTURE_LOADER_USE_SSSE3
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha   = _mm_set1_epi32((int) 0xFF000000);
+    /// a load reads 16 bytes for 4 texels, stop before it passes the end
+    for (; i + 6 <= count; i += 4) {
+        __m128i rgb = _mm_loadu_si128((const __m128i *) (src + i * 3));
+        _mm_storeu_si128((__m128i *) (dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+    }
+#endif
+    /// one 4 byte load per texel, the byte after the texel is replaced by alpha
+    for (; i + 1 < count; ++i) {
+        UInt32 texel;
+        memcpy(&texel, src + i * 3, 4);
+        texel |= 0xFF000000u;
+        memcpy(dst + i * 4, &texel, 4);
+    }
+    for (; i < count; ++i) {
+        dst[i * 4]     = src[i * 3];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = 255;
+    }
+}
 
-    TextureDescriptor textureDescriptor{};
-    unsigned char *bufferMemory;
-    unsigned char *buffer = data;
+static void ExpandGrayAlphaToRGBA(const UInt8 *src, UInt8 *dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        UInt32 gray  = src[i * 2];
+        UInt32 texel = gray | gray << 8 | gray << 16 | (UInt32) src[i * 2 + 1] << 24;
+        memcpy(dst + i * 4, &texel, 4);
+    }
+}
 
-    bool stb_free = true;
+LoadTextureResult __loadTexture(int width, int height, int nrChannels, bool sRgb, unsigned char *data, bool bBuildMipChain) {
 
+    PixelFormat pixelFormat;
     if (nrChannels == 1) {
-        if (sRgb) {
-            textureDescriptor.pixelFormat = kPixelFormatR8Unorm_sRGB;
-        } else {
-            textureDescriptor.pixelFormat = kPixelFormatR8Unorm;
-        }
-
-    } else if (nrChannels == 3) {
-
-        if (sRgb) {
-            textureDescriptor.pixelFormat = kPixelFormatRGBA8Unorm_sRGB;
-        } else {
-            textureDescriptor.pixelFormat = kPixelFormatRGBA8Unorm;
-        }
-
-        uint64_t size = (uint64_t)width * (uint64_t)height;
-
-        bufferMemory = (UInt8 *)AN_MALLOC_ALIGNED(size * 4, 4);
-
-        for (uint64_t i = 0; i < size; ++i) {
-            bufferMemory[i * 4] = data[i * 3];
-            bufferMemory[i * 4 + 1] = data[i * 3 + 1];
-            bufferMemory[i * 4 + 2] = data[i * 3 + 2];
-            bufferMemory[i * 4 + 3] = 255;
-        }
+        pixelFormat = sRgb ? kPixelFormatR8Unorm_sRGB : kPixelFormatR8Unorm;
+    } else {
+        pixelFormat = sRgb ? kPixelFormatRGBA8Unorm_sRGB : kPixelFormatRGBA8Unorm;
+    }
 
-        buffer = bufferMemory;
-        stbi_image_free(data);
-        stb_free = false;
+    bool   generateMipmap = nrChannels >= 3;
+    UInt32 mipmapLevel    = generateMipmap ? CalculateMipCount(width, height) : 1;
 
-    } else if (nrChannels == 4) {
-        if (sRgb) {
-            textureDescriptor.pixelFormat = kPixelFormatRGBA8Unorm_sRGB;
-        } else {
-            textureDescriptor.pixelFormat = kPixelFormatRGBA8Unorm;
-        }
+    /// RGBA without a chain is uploaded from the stb memory as it is
+    if (nrChannels == 1 || (nrChannels == 4 && !(bBuildMipChain && mipmapLevel > 1))) {
+        return LoadTextureResult(true, data, width, height, pixelFormat, mipmapLevel);
     }
 
-    textureDescriptor.width = width;
-    textureDescriptor.height = height;
+    UInt32 dataMipCount = bBuildMipChain ? mipmapLevel : 1;
+    UInt64 texelCount   = (UInt64)width * (UInt64)height;
+    UInt8 *buffer       = (UInt8 *)AN_MALLOC_ALIGNED(CalculateMipChainSize(pixelFormat, width, height, dataMipCount), 4);
 
-    bool generateMipmap = nrChannels >= 3;
-    if (generateMipmap) {
-        textureDescriptor.mipmapLevel = (uint32_t)(std::floor(std::log2(std::max(width, height)))) + 1;
+    if (nrChannels == 3) {
+        ExpandRGBToRGBA(data, buffer, texelCount);
+    } else if (nrChannels == 2) {
+        ExpandGrayAlphaToRGBA(data, buffer, texelCount);
     } else {
-        textureDescriptor.mipmapLevel = 1;
+        memcpy(buffer, data, texelCount * 4);
     }
+    stbi_image_free(data);
 
-    return LoadTextureResult(stb_free, buffer, width, height, textureDescriptor.pixelFormat, textureDescriptor.mipmapLevel);
-}
-
-LoadTextureResult LoadTexture(const char *path, bool sRgb) {
-
-    int width, height, nrChannels;
+    if (dataMipCount > 1) {
+        GenerateMipChain(buffer, width, height, pixelFormat, dataMipCount);
+    }
 
-    stbi_io_callbacks io_callbacks;
-    io_callbacks.read = stb_io_read_callback;
-    io_callbacks.skip = stb_io_skip_callback;
-    io_callbacks.eof = stb_io_eof_callback;
+    return LoadTextureResult(false, buffer, width, height, pixelFormat, mipmapLevel, dataMipCount);
+}
 
+LoadTextureResult LoadTexture(const char *path, bool sRgb, bool bBuildMipChain) {
     File file;
     if (!file.Open(path, kFilePermissionRead)) {
         AN_LOG(Error, "cannot open texture file %s", path);
         return {};
     }
 
-    unsigned char *data = stbi_load_from_callbacks(&io_callbacks, &file, &width, &height, &nrChannels, 0);
+    /// kept per thread so loads on the worker threads do not allocate for every file
+    thread_local std::vector<UInt8> fileBuffer;
+    int length = file.GetFileLength();
+    if (length <= 0) {
+        ANLog("Failed to load texture at %s", path);
+        return {};
+    }
+    fileBuffer.resize(length);
+    if (file.Read(fileBuffer.data(), length) != length) {
+        AN_LOG(Error, "cannot read texture file %s", path);
+        return {};
+    }
+
+    int width, height, nrChannels;
+    unsigned char *data = stbi_load_from_memory(fileBuffer.data(), length, &width, &height, &nrChannels, 0);
+
+    /// do not hold on to the memory of an unusually large file
+    if (fileBuffer.capacity() > kMaxKeptFileBufferSize) {
+        std::vector<UInt8>().swap(fileBuffer);
+    }
 
     if (data) {
 
-        return __loadTexture(width, height, nrChannels, sRgb, data);
+        return __loadTexture(width, height, nrChannels, sRgb, data, bBuildMipChain);
 
     } else {
         ANLog("Failed to load texture at %s", path);
@@ -167,13 +190,13 @@ LoadTextureResult LoadTexture(const char *path, bool sRgb) {
     return {};
 }
 
-LoadTextureResult LoadTextureFromMemory(const unsigned char *mem, unsigned int len, bool sRgb) {
+LoadTextureResult LoadTextureFromMemory(const unsigned char *mem, unsigned int len, bool sRgb, bool bBuildMipChain) {
     int width, height, nrChannels;
     unsigned char *data = stbi_load_from_memory(mem, len, &width, &height, &nrChannels, 0);
 
     if (data) {
 
-        return __loadTexture(width, height, nrChannels, sRgb, data);
+        return __loadTexture(width, height, nrChannels, sRgb, data, bBuildMipChain);
 
     } else {
         ANLog("Failed to load texture from memory");
@@ -220,6 +243,9 @@ bool EncodeTexture(const char *path,
         case kImageEncodeTypeBMP:
             return stbi_write_bmp_to_func(stbi_write_func_file_callback, &file,
                                           width, height, channels, rawData);
+        case kImageEncodeTypeTGA:
+            return stbi_write_tga_to_func(stbi_write_func_file_callback, &file,
+                                          width, height, channels, rawData);
     }
 
     return false;
@@ -0,0 +1,324 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Render/TextureStreamer.hpp"
+#include "Render/MipChain.hpp"
+#include "Threads/Threads.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace AN {
+
+float CalculateRequiredMip(float uvDistributionMetric, UInt32 width, UInt32 height,
+                           float distance, float screenPixelScale) {
+    if (uvDistributionMetric <= 0.f || screenPixelScale <= 0.f) return 0.f;
+    /// texels along one world unit against pixels along one world unit
+    float texelsPerUnit = std::sqrt((float) width * (float) height / uvDistributionMetric);
+    float pixelsPerUnit = screenPixelScale / std::max(distance, 1e-4f);
+    return std::max(0.f, std::log2(texelsPerUnit / pixelsPerUnit));
+}
+
+TextureStreamer::TextureStreamer() : _stats(), _frame(), _runningLoads(), bStop() {}
+
+TextureStreamer::~TextureStreamer() {
+    shutdown();
+}
+
+UInt64 TextureStreamer::levelsSize(const Entry &entry, UInt32 firstMip) const {
+    const StreamingTextureDescriptor &desc = entry.desc;
+    return CalculateMipChainSize(desc.pixelFormat, desc.width, desc.height, desc.mipCount) -
+           CalculateMipOffset(desc.pixelFormat, desc.width, desc.height, firstMip);
+}
+
+StreamingTextureID TextureStreamer::addTexture(const StreamingTextureDescriptor &desc, TextureStreamingBackend *backend, void *texture) {
+    Entry entry{};
+    entry.texture  = texture;
+    entry.backend  = backend;
+    entry.desc     = desc;
+    entry.desc.mipCount = std::max(desc.mipCount, 1U);
+    entry.bUsed    = true;
+
+    UInt32 baseMip = 0;
+    while (baseMip + 1 < entry.desc.mipCount &&
+           std::max(CalculateMipSize(desc.width, baseMip), CalculateMipSize(desc.height, baseMip)) > _settings.residentSize) {
+        ++baseMip;
+    }
+    entry.baseMip          = baseMip;
+    entry.residentMip      = baseMip;
+    entry.requestedMip     = baseMip;
+    entry.lastRequestedMip = baseMip;
+    entry.targetMip        = baseMip;
+    entry.lastRequestFrame = _frame;
+
+    StreamingTextureID id;
+    {
+        std::lock_guard lock(_entryLock);
+        if (_freeIDs.empty()) {
+            id = (StreamingTextureID) _entries.size();
+            _entries.push_back(entry);
+        } else {
+            id = _freeIDs.back();
+            _freeIDs.pop_back();
+            entry.generation = _entries[id].generation + 1;
+            _entries[id]     = entry;
+        }
+    }
+
+    backend->applyMips(texture, baseMip);
+    return id;
+}
+
+void TextureStreamer::removeTexture(StreamingTextureID id) {
+    if (id >= _entries.size() || !_entries[id].bUsed) return;
+    if (_entries[id].bLoading) {
+        waitLoadsOf(id);
+    }
+
+    std::lock_guard lock(_entryLock);
+    _entries[id].bUsed   = false;
+    _entries[id].texture = nullptr;
+    _freeIDs.push_back(id);
+}
+
+void TextureStreamer::requestMip(StreamingTextureID id, float mip) {
+    UInt32 level = (UInt32) std::max(0.f, mip + _settings.mipBias);
+    std::lock_guard lock(_entryLock);
+    if (id >= _entries.size() || !_entries[id].bUsed) return;
+    Entry &entry       = _entries[id];
+    entry.requestedMip = std::min(entry.requestedMip, level);
+    entry.bRequested   = true;
+}
+
+void TextureStreamer::applyLoad(const Load &load) {
+    Entry &entry = _entries[load.id];
+    if (!entry.bUsed || entry.generation != load.generation) return;
+
+    entry.bLoading = false;
+    if (!load.bSucceeded) return;
+
+    /// the target may have become coarser while loading
+    UInt32 firstMip = std::max(load.firstMip, entry.targetMip);
+    if (firstMip < entry.residentMip) {
+        entry.backend->applyMips(entry.texture, firstMip);
+        entry.residentMip = firstMip;
+        ++_stats.loads;
+    } else {
+        entry.backend->discardMips(entry.texture);
+    }
+}
+
+void TextureStreamer::applyCompletedLoads() {
+    std::vector<Load> completed;
+    {
+        std::lock_guard lock(_loadMutex);
+        completed.swap(_completedLoads);
+    }
+    for (const Load &load : completed) {
+        applyLoad(load);
+    }
+}
+
+void TextureStreamer::waitLoadsOf(StreamingTextureID id) {
+    UInt32 generation = _entries[id].generation;
+    std::unique_lock lock(_loadMutex);
+    _completeCondition.wait(lock, [this, id, generation] {
+        for (const Load &load : _completedLoads) {
+            if (load.id == id && load.generation == generation) return true;
+        }
+        return !_thread.joinable();
+    });
+}
+
+void TextureStreamer::update(UInt32 frameIndex) {
+    _frame = frameIndex;
+    applyCompletedLoads();
+
+    UInt64 requestedMemory = 0, targetMemory = 0;
+    {
+        std::lock_guard lock(_entryLock);
+        for (Entry &entry : _entries) {
+            if (!entry.bUsed) continue;
+            if (entry.bRequested) {
+                entry.lastRequestedMip = std::min(entry.requestedMip, entry.baseMip);
+                entry.lastRequestFrame = frameIndex;
+                entry.requestedMip     = entry.baseMip;
+                entry.bRequested       = false;
+            }
+            if (frameIndex - entry.lastRequestFrame > _settings.requestFrames) {
+                entry.lastRequestedMip = entry.baseMip;
+            }
+            entry.targetMip  = entry.lastRequestedMip;
+            requestedMemory += levelsSize(entry, entry.targetMip);
+        }
+    }
+    targetMemory = requestedMemory;
+
+    /// over the budget drop single levels, first from the textures requested longest ago,
+    /// then from the ones whose finest level is largest
+    if (targetMemory > _settings.memoryBudget) {
+        auto levelSize = [this](const Entry &entry) {
+            return levelsSize(entry, entry.targetMip) - levelsSize(entry, entry.targetMip + 1);
+        };
+        auto compare = [this, &levelSize](UInt32 a, UInt32 b) {
+            const Entry &lhs = _entries[a], &rhs = _entries[b];
+            if (lhs.lastRequestFrame != rhs.lastRequestFrame) return lhs.lastRequestFrame > rhs.lastRequestFrame;
+            return levelSize(lhs) < levelSize(rhs);
+        };
+        std::priority_queue<UInt32, std::vector<UInt32>, decltype(compare)> queue(compare);
+        for (UInt32 i = 0; i < _entries.size(); ++i) {
+            if (_entries[i].bUsed && _entries[i].targetMip < _entries[i].baseMip) queue.push(i);
+        }
+        while (targetMemory > _settings.memoryBudget && !queue.empty()) {
+            UInt32 index = queue.top();
+            queue.pop();
+            Entry &entry  = _entries[index];
+            targetMemory -= levelSize(entry);
+            ++entry.targetMip;
+            if (entry.targetMip < entry.baseMip) queue.push(index);
+        }
+    }
+
+    /// evict before loading so the resident memory never goes over the budget
+    for (Entry &entry : _entries) {
+        if (entry.bUsed && entry.targetMip > entry.residentMip) {
+            entry.backend->applyMips(entry.texture, entry.targetMip);
+            entry.residentMip = entry.targetMip;
+            ++_stats.evictions;
+        }
+    }
+
+    issueLoads();
+
+    UInt64 residentMemory  = 0;
+    UInt32 reducedTextures = 0, textureCount = 0;
+    for (const Entry &entry : _entries) {
+        if (!entry.bUsed) continue;
+        residentMemory  += levelsSize(entry, entry.residentMip);
+        reducedTextures += entry.targetMip > entry.lastRequestedMip;
+        ++textureCount;
+    }
+    _stats.residentMemory  = residentMemory;
+    _stats.requestedMemory = requestedMemory;
+    _stats.textureCount    = textureCount;
+    _stats.reducedTextures = reducedTextures;
+}
+
+void TextureStreamer::issueLoads() {
+    std::vector<UInt32> candidates;
+    for (UInt32 i = 0; i < _entries.size(); ++i) {
+        const Entry &entry = _entries[i];
+        if (entry.bUsed && entry.targetMip < entry.residentMip && !entry.bLoading) {
+            candidates.push_back(i);
+        }
+    }
+
+    UInt32 inFlight;
+    {
+        std::lock_guard lock(_loadMutex);
+        inFlight = (UInt32) _pendingLoads.size() + _runningLoads + (UInt32) _completedLoads.size();
+    }
+    UInt32 slots = _settings.maxLoadsInFlight > inFlight ? _settings.maxLoadsInFlight - inFlight : 0;
+    if (candidates.empty() || slots == 0) {
+        _stats.loadsInFlight = inFlight;
+        return;
+    }
+
+    /// most recently requested first, then the ones missing most levels
+    std::sort(candidates.begin(), candidates.end(), [this](UInt32 a, UInt32 b) {
+        const Entry &lhs = _entries[a], &rhs = _entries[b];
+        if (lhs.lastRequestFrame != rhs.lastRequestFrame) return lhs.lastRequestFrame > rhs.lastRequestFrame;
+        return lhs.residentMip - lhs.targetMip > rhs.residentMip - rhs.targetMip;
+    });
+    if (candidates.size() > slots) candidates.resize(slots);
+
+    for (UInt32 index : candidates) {
+        Entry &entry = _entries[index];
+        Load   load{ index, entry.generation, entry.targetMip, entry.texture, entry.backend, false };
+        entry.bLoading = true;
+        entry.backend->prepareLoad(entry.texture, load.firstMip);
+
+        if (!_settings.bAsync) {
+            load.bSucceeded = entry.backend->loadMips(entry.texture, load.firstMip);
+            applyLoad(load);
+            continue;
+        }
+
+        std::lock_guard lock(_loadMutex);
+        if (!_thread.joinable()) {
+            bStop   = false;
+            _thread = std::thread(&TextureStreamer::streamingThread, this);
+        }
+        _pendingLoads.push_back(load);
+        ++inFlight;
+    }
+    _loadCondition.notify_one();
+    _stats.loadsInFlight = _settings.bAsync ? inFlight : 0;
+}
+
+void TextureStreamer::streamingThread() {
+    SetCurrentThreadName("TextureStreamer");
+    std::unique_lock lock(_loadMutex);
+    while (true) {
+        _loadCondition.wait(lock, [this] { return bStop || !_pendingLoads.empty(); });
+        if (bStop) break;
+
+        Load load = _pendingLoads.front();
+        _pendingLoads.pop_front();
+        ++_runningLoads;
+
+        lock.unlock();
+        load.bSucceeded = load.backend->loadMips(load.texture, load.firstMip);
+        lock.lock();
+
+        --_runningLoads;
+        _completedLoads.push_back(load);
+        _completeCondition.notify_all();
+    }
+}
+
+void TextureStreamer::flush() {
+    if (_thread.joinable()) {
+        std::unique_lock lock(_loadMutex);
+        _completeCondition.wait(lock, [this] { return _pendingLoads.empty() && _runningLoads == 0; });
+    }
+    applyCompletedLoads();
+}
+
+void TextureStreamer::shutdown() {
+    if (!_thread.joinable()) return;
+    {
+        std::lock_guard lock(_loadMutex);
+        bStop = true;
+        _pendingLoads.clear();
+    }
+    _loadCondition.notify_all();
+    _thread.join();
+    _completeCondition.notify_all();
+
+    _completedLoads.clear();
+    for (Entry &entry : _entries) {
+        entry.bLoading = false;
+    }
+}
+
+UInt32 TextureStreamer::getResidentMip(StreamingTextureID id) const {
+    return id < _entries.size() && _entries[id].bUsed ? _entries[id].residentMip : 0;
+}
+
+UInt32 TextureStreamer::getTargetMip(StreamingTextureID id) const {
+    return id < _entries.size() && _entries[id].bUsed ? _entries[id].targetMip : 0;
+}
+
+UInt32 TextureStreamer::getBaseMip(StreamingTextureID id) const {
+    return id < _entries.size() && _entries[id].bUsed ? _entries[id].baseMip : 0;
+}
+
+TextureStreamer &GetTextureStreamer() {
+    static TextureStreamer textureStreamer;
+    return textureStreamer;
+}
+
+}
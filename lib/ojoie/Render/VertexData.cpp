@@ -7,6 +7,8 @@
 #include "Utility/Utility.h"
 #include <ojoie/Utility/Log.h>
 
+#include <glm/gtc/packing.hpp>
+
 namespace AN {
 
 
@@ -17,7 +19,10 @@ static const uint8_t kVertexChannelFormatSizes[kChannelFormatCount] = {
     4,// kChannelFormatFloat
     2,// kChannelFormatFloat16
     4,// kChannelFormatColor
-    1 // kChannelFormatByte
+    1,// kChannelFormatByte
+    2,// kChannelFormatUNorm16
+    2,// kChannelFormatSNorm16
+    2 // kChannelFormatOctahedral16
 };
 
 size_t GetChannelFormatSize(uint8_t format) {
@@ -37,9 +42,176 @@ VertexChannelsLayout VertexDataInfo::kVertexChannelsDefault = { {
         MAKE_CHANNEL(Float, 4) // tangent
 } };
 
+VertexChannelsLayout VertexDataInfo::GetCompressedChannelsLayout(UInt32 compressedChannels) {
+    static const VertexChannelsLayout kVertexChannelsCompressed = { {
+            MAKE_CHANNEL(UNorm16, 4),     // position, 4 components since there is no 3 component 16 bit format
+            MAKE_CHANNEL(Octahedral16, 2),// normal
+            MAKE_CHANNEL(Color, 1),       // color
+            MAKE_CHANNEL(Float16, 2),     // texcoord0
+            MAKE_CHANNEL(Float16, 2),     // texcoord1
+            MAKE_CHANNEL(Octahedral16, 2) // tangent
+    } };
+
+    VertexChannelsLayout result = kVertexChannelsDefault;
+    for (int i = 0; i < kShaderChannelCount; ++i) {
+        if (compressedChannels & (1 << i)) {
+            result.channels[i] = kVertexChannelsCompressed.channels[i];
+        }
+    }
+    return result;
+}
+
+/// octahedral tangents keep y in the magnitude above this and the handedness in the sign
+static constexpr float kOctahedralSignBias = 2.f / 32767.f;
+
+static float SignNotZero(float value) {
+    return value >= 0.f ? 1.f : -1.f;
+}
+
+Vector2f OctahedralEncode(const Vector3f &direction) {
+    float    sum = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+    if (sum <= 0.f) return Vector2f(0.f);
+
+    Vector3f n = direction / sum;
+    if (n.z < 0.f) {
+        return Vector2f((1.f - std::abs(n.y)) * SignNotZero(n.x),
+                        (1.f - std::abs(n.x)) * SignNotZero(n.y));
+    }
+    return Vector2f(n.x, n.y);
+}
+
+Vector3f OctahedralDecode(const Vector2f &encoded) {
+    Vector3f n(encoded.x, encoded.y, 1.f - std::abs(encoded.x) - std::abs(encoded.y));
+    float    t = std::max(-n.z, 0.f);
+    n.x += n.x >= 0.f ? -t : t;
+    n.y += n.y >= 0.f ? -t : t;
+    return Math::normalize(n);
+}
+
+static void DecodeChannelValue(const UInt8 *src, UInt8 format, UInt8 dimension, ShaderChannel channel,
+                               const Vector3f &positionScale, const Vector3f &positionOffset, float *out) {
+    out[0] = out[1] = out[2] = out[3] = 0.f;
+    switch (format) {
+        case kChannelFormatFloat:
+            memcpy(out, src, dimension * sizeof(float));
+            break;
+        case kChannelFormatFloat16:
+            for (int c = 0; c < dimension; ++c) {
+                out[c] = Math::unpackHalf1x16(((const UInt16 *) src)[c]);
+            }
+            break;
+        case kChannelFormatColor:
+            for (int c = 0; c < 4; ++c) {
+                out[c] = Math::unpackUnorm1x8(src[c]);
+            }
+            break;
+        case kChannelFormatByte:
+            for (int c = 0; c < dimension; ++c) {
+                out[c] = Math::unpackUnorm1x8(src[c]);
+            }
+            break;
+        case kChannelFormatUNorm16:
+            for (int c = 0; c < dimension; ++c) {
+                out[c] = Math::unpackUnorm1x16(((const UInt16 *) src)[c]);
+            }
+            if (channel == kShaderChannelVertex) {
+                for (int c = 0; c < 3; ++c) {
+                    out[c] = out[c] * positionScale[c] + positionOffset[c];
+                }
+                out[3] = 0.f;
+            }
+            break;
+        case kChannelFormatSNorm16:
+            for (int c = 0; c < dimension; ++c) {
+                out[c] = Math::unpackSnorm1x16(((const UInt16 *) src)[c]);
+            }
+            break;
+        case kChannelFormatOctahedral16: {
+            Vector2f encoded(Math::unpackSnorm1x16(((const UInt16 *) src)[0]),
+                             Math::unpackSnorm1x16(((const UInt16 *) src)[1]));
+            float w = 0.f;
+            if (channel == kShaderChannelTangent) {
+                w         = SignNotZero(encoded.y);
+                encoded.y = (std::abs(encoded.y) - kOctahedralSignBias) / (1.f - kOctahedralSignBias) * 2.f - 1.f;
+            }
+            Vector3f direction = OctahedralDecode(encoded);
+            out[0] = direction.x;
+            out[1] = direction.y;
+            out[2] = direction.z;
+            out[3] = w;
+            break;
+        }
+        default:
+            ANAssert(false && "unknown vertex channel format");
+    }
+}
+
+static void EncodeChannelValue(const float *in, UInt8 format, UInt8 dimension, ShaderChannel channel,
+                               const Vector3f &positionScale, const Vector3f &positionOffset, UInt8 *dst) {
+    switch (format) {
+        case kChannelFormatFloat:
+            memcpy(dst, in, dimension * sizeof(float));
+            break;
+        case kChannelFormatFloat16:
+            for (int c = 0; c < dimension; ++c) {
+                ((UInt16 *) dst)[c] = Math::packHalf1x16(in[c]);
+            }
+            break;
+        case kChannelFormatColor:
+            for (int c = 0; c < 4; ++c) {
+                dst[c] = Math::packUnorm1x8(in[c]);
+            }
+            break;
+        case kChannelFormatByte:
+            for (int c = 0; c < dimension; ++c) {
+                dst[c] = Math::packUnorm1x8(in[c]);
+            }
+            break;
+        case kChannelFormatUNorm16:
+            for (int c = 0; c < dimension; ++c) {
+                float value = in[c];
+                if (channel == kShaderChannelVertex) {
+                    value = c < 3 && positionScale[c] != 0.f ? (value - positionOffset[c]) / positionScale[c] : 0.f;
+                }
+                ((UInt16 *) dst)[c] = Math::packUnorm1x16(value);
+            }
+            break;
+        case kChannelFormatSNorm16:
+            for (int c = 0; c < dimension; ++c) {
+                ((UInt16 *) dst)[c] = Math::packSnorm1x16(in[c]);
+            }
+            break;
+        case kChannelFormatOctahedral16: {
+            Vector2f encoded = OctahedralEncode(Vector3f(in[0], in[1], in[2]));
+            if (channel == kShaderChannelTangent) {
+                encoded.y = SignNotZero(in[3]) * (kOctahedralSignBias + (1.f - kOctahedralSignBias) * (encoded.y * 0.5f + 0.5f));
+            }
+            ((UInt16 *) dst)[0] = Math::packSnorm1x16(encoded.x);
+            ((UInt16 *) dst)[1] = Math::packSnorm1x16(encoded.y);
+            break;
+        }
+        default:
+            ANAssert(false && "unknown vertex channel format");
+    }
+}
+
+static void ConvertCopyChannel(size_t vertexCount, ShaderChannel channel,
+                               const UInt8 *srcPtr, UInt8 srcStride, UInt8 srcFormat, UInt8 srcDimension,
+                               UInt8 *dstPtr, UInt8 dstStride, UInt8 dstFormat, UInt8 dstDimension,
+                               const Vector3f &positionScale, const Vector3f &positionOffset) {
+    float value[4];
+    for (size_t i = 0; i < vertexCount; ++i) {
+        DecodeChannelValue(srcPtr, srcFormat, srcDimension, channel, positionScale, positionOffset, value);
+        EncodeChannelValue(value, dstFormat, dstDimension, channel, positionScale, positionOffset, dstPtr);
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
 static void CopyChannels(size_t vertexCount, unsigned copyChannels,
                          const StreamInfoArray &srcStreams, const ChannelInfoArray &srcChannels, const UInt8 *srcData,
-                         const StreamInfoArray &dstStreams, const ChannelInfoArray &dstChannels, UInt8 *dstData) {
+                         const StreamInfoArray &dstStreams, const ChannelInfoArray &dstChannels, UInt8 *dstData,
+                         const Vector3f &positionScale, const Vector3f &positionOffset) {
     for (unsigned chan = copyChannels, i = 0; chan && (i < kShaderChannelCount); i++, chan >>= 1) {
         if (0 == (chan & 1))
             continue;
@@ -52,7 +224,7 @@ static void CopyChannels(size_t vertexCount, unsigned copyChannels,
         UInt8        srcStride = srcChannel.calcStride(srcStreams);
         UInt8        dstStride = dstChannel.calcStride(dstStreams);
 
-        if (srcChannel.format == dstChannel.format) {
+        if (srcChannel.format == dstChannel.format && srcChannel.dimension == dstChannel.dimension) {
             size_t copySize = srcChannel.dimension * GetChannelFormatSize(srcChannel.format);
             switch (copySize) {
                 case 4: {
@@ -92,8 +264,10 @@ static void CopyChannels(size_t vertexCount, unsigned copyChannels,
                 }
             }
         } else {
-            //            ConvertCopyChannel(vertexCount, srcPtr, srcStride, srcChannel.format, srcChannel.dimension, dstPtr, dstStride, dstChannel.format, dstChannel.dimension);
-            AN_LOG(Error, "currently not support different vertex format conversion");
+            ConvertCopyChannel(vertexCount, (ShaderChannel) i,
+                               srcPtr, srcStride, srcChannel.format, srcChannel.dimension,
+                               dstPtr, dstStride, dstChannel.format, dstChannel.dimension,
+                               positionScale, positionOffset);
         }
     }
 }
@@ -225,7 +399,52 @@ VertexDataInfo::VertexDataInfo()
       m_DataSize(),
       m_VertexCount(),
       m_VertexSize(),
-      m_CurrentChannels() {}
+      m_CurrentChannels(),
+      m_PositionScale(1.f),
+      m_PositionOffset(0.f) {}
+
+Vector4f VertexDataInfo::getChannelValue(ShaderChannel channel, size_t index) const {
+    Vector4f value(0.f);
+    if (!hasChannel(channel) || index >= m_VertexCount) return value;
+
+    const ChannelInfo &info = m_Channels[channel];
+    const UInt8       *src  = m_Data + getChannelOffset(channel) + index * getChannelStride(channel);
+    DecodeChannelValue(src, info.format, info.dimension, channel, m_PositionScale, m_PositionOffset, &value.x);
+    return value;
+}
+
+void VertexDataInfo::extractChannel(ShaderChannel channel, float *dst, UInt32 dimension) const {
+    if (!hasChannel(channel)) return;
+
+    const ChannelInfo &info   = m_Channels[channel];
+    const UInt8       *src    = m_Data + getChannelOffset(channel);
+    size_t             stride = getChannelStride(channel);
+
+    float value[4];
+    for (size_t i = 0; i < m_VertexCount; ++i) {
+        DecodeChannelValue(src, info.format, info.dimension, channel, m_PositionScale, m_PositionOffset, value);
+        memcpy(dst, value, std::min<UInt32>(dimension, 4) * sizeof(float));
+        src += stride;
+        dst += dimension;
+    }
+}
+
+void VertexDataInfo::writeChannel(ShaderChannel channel, const float *src, UInt32 dimension) {
+    if (!hasChannel(channel)) return;
+
+    const ChannelInfo &info   = m_Channels[channel];
+    UInt8             *dst    = m_Data + getChannelOffset(channel);
+    size_t             stride = getChannelStride(channel);
+
+    float value[4];
+    for (size_t i = 0; i < m_VertexCount; ++i) {
+        value[0] = value[1] = value[2] = value[3] = 0.f;
+        memcpy(value, src, std::min<UInt32>(dimension, 4) * sizeof(float));
+        EncodeChannelValue(value, info.format, info.dimension, channel, m_PositionScale, m_PositionOffset, dst);
+        src += dimension;
+        dst += stride;
+    }
+}
 
 VertexData::~VertexData() {
     dealloc();
@@ -260,7 +479,8 @@ void VertexData::resize(size_t vertexCount, unsigned int channelMask,
     if (srcData) {
         unsigned copyChannels = srcChannelMask & m_CurrentChannels;
         size_t   toCopyCount  = std::min<size_t>(srcVertexCount, m_VertexCount);
-        CopyChannels(toCopyCount, copyChannels, srcStreams, srcChannels, srcData, m_Streams, m_Channels, m_Data);
+        CopyChannels(toCopyCount, copyChannels, srcStreams, srcChannels, srcData, m_Streams, m_Channels, m_Data,
+                     m_PositionScale, m_PositionOffset);
         AN_FREE(srcData);
     }
 }
@@ -301,6 +521,9 @@ void VertexData::transfer(Coder &coder) {
             updateStreams(m_CurrentChannels, m_VertexCount, kVertexStreamsDefault, kVertexChannelsDefault);
     }
 
+    coder.transfer(m_PositionScale, "m_PositionScale", kHideInEditor);
+    coder.transfer(m_PositionOffset, "m_PositionOffset", kHideInEditor);
+
     coder.transferTypeless(m_DataSize, "m_DataSize", kHideInEditor);
     if constexpr (Coder::IsDecoding()) {
         ANSafeFree(m_Data);
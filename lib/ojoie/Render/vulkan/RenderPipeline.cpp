@@ -110,6 +110,46 @@ getVertexInputAttributeDescription(const VK::RenderPipelineDescriptor &descripto
                         AN_LOG(Error, "not support vertex channel dimension %d", dimension);
                 }
                 break;
+            case kChannelFormatFloat16:
+                switch (dimension) {
+                    case 2:
+                        description.format = VK_FORMAT_R16G16_SFLOAT;
+                        break;
+                    case 4:
+                        description.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+                        break;
+                    default:
+                        AN_LOG(Error, "not support vertex channel dimension %d", dimension);
+                }
+                break;
+            case kChannelFormatUNorm16:
+                switch (dimension) {
+                    case 2:
+                        description.format = VK_FORMAT_R16G16_UNORM;
+                        break;
+                    case 4:
+                        description.format = VK_FORMAT_R16G16B16A16_UNORM;
+                        break;
+                    default:
+                        AN_LOG(Error, "not support vertex channel dimension %d", dimension);
+                }
+                break;
+            case kChannelFormatSNorm16:
+                switch (dimension) {
+                    case 2:
+                        description.format = VK_FORMAT_R16G16_SNORM;
+                        break;
+                    case 4:
+                        description.format = VK_FORMAT_R16G16B16A16_SNORM;
+                        break;
+                    default:
+                        AN_LOG(Error, "not support vertex channel dimension %d", dimension);
+                }
+                break;
+            case kChannelFormatOctahedral16:
+                /// decoded in the vertex shader, see DecodeNormalOS
+                description.format = VK_FORMAT_R16G16_SNORM;
+                break;
 
             default:
                 AN_LOG(Error, "%s", "not support channel format");
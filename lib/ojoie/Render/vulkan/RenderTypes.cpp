@@ -156,6 +156,38 @@ VkFormat toVkRenderType(PixelFormat pixelFormat) {
             return VK_FORMAT_R8G8B8A8_SRGB;
         case kPixelFormatRGBA8Unorm:
             return VK_FORMAT_R8G8B8A8_UNORM;
+        case kPixelFormatRGBA32Float:
+            return VK_FORMAT_R32G32B32A32_SFLOAT;
+        case kPixelFormatR32Uint:
+            return VK_FORMAT_R32_UINT;
+        case kPixelFormatBC1_RGBA:
+            return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case kPixelFormatBC1_RGBA_sRGB:
+            return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+        case kPixelFormatBC2_RGBA:
+            return VK_FORMAT_BC2_UNORM_BLOCK;
+        case kPixelFormatBC2_RGBA_sRGB:
+            return VK_FORMAT_BC2_SRGB_BLOCK;
+        case kPixelFormatBC3_RGBA:
+            return VK_FORMAT_BC3_UNORM_BLOCK;
+        case kPixelFormatBC3_RGBA_sRGB:
+            return VK_FORMAT_BC3_SRGB_BLOCK;
+        case kPixelFormatBC4_RUnorm:
+            return VK_FORMAT_BC4_UNORM_BLOCK;
+        case kPixelFormatBC4_RSnorm:
+            return VK_FORMAT_BC4_SNORM_BLOCK;
+        case kPixelFormatBC5_RGUnorm:
+            return VK_FORMAT_BC5_UNORM_BLOCK;
+        case kPixelFormatBC5_RGSnorm:
+            return VK_FORMAT_BC5_SNORM_BLOCK;
+        case kPixelFormatBC6H_RGBUfloat:
+            return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+        case kPixelFormatBC6H_RGBFloat:
+            return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+        case kPixelFormatBC7_RGBAUnorm:
+            return VK_FORMAT_BC7_UNORM_BLOCK;
+        case kPixelFormatBC7_RGBAUnorm_sRGB:
+            return VK_FORMAT_BC7_SRGB_BLOCK;
         default:
             throw AN::Exception("Invalid enum value");
     }
@@ -6,6 +6,8 @@
 #include "Render/private/vulkan/CommandPool.hpp"
 #include "Render/private/vulkan/Device.hpp"
 #include "Render/private/vulkan/RenderTypes.hpp"
+#include "Render/MipChain.hpp"
+#include "Render/Image.hpp"
 
 #include <ranges>
 
@@ -14,21 +16,6 @@ namespace AN::VK {
 /// max staging buffer with the same size
 constexpr static UInt64 kMinStagingTextureBufferSize = 128;
 
-static uint64_t pixelFormatSize(PixelFormat pixelFormat) {
-    switch (pixelFormat) {
-        case kPixelFormatR8Unorm:
-        case kPixelFormatR8Unorm_sRGB:
-            return 1;
-        case kPixelFormatRG8Unorm_sRGB:
-            return 2;
-        case kPixelFormatRGBA8Unorm:
-        case kPixelFormatRGBA8Unorm_sRGB:
-            return 4;
-        default:
-            throw AN::Exception("Invalid Enum Value");
-    }
-}
-
 static bool checkFormatSupport(VkPhysicalDevice gpu,
                                VkFormat format,
                                VkFormatFeatureFlags featureFlags) {
@@ -49,7 +36,7 @@ void TextureManager::uploadTexture2DData(const UInt8 *srcData, VkImage image,
                                          PixelFormat format,
                                          UInt32      mipLevel) {
 
-    UInt64 imageBytes = (UInt64) width * height * pixelFormatSize(format);
+    UInt64 imageBytes = CalculatePixelFormatSize(format, width, height);
 
     StagingTextureBuffers *stagingTextureBuffers;
 
@@ -163,18 +150,18 @@ void TextureManager::uploadTexture2DData(const UInt8 *srcData, VkImage image,
 
 void TextureManager::uploadTexture2D(TextureID tid, const UInt8 *srcData,
                                      UInt32 width, UInt32 height,
-                                     PixelFormat format, bool generateMipmap,
+                                     PixelFormat format, UInt32 mipCount, bool generateMipmap,
                                      const SamplerDescriptor &samplerDescriptor) {
 
     if (width == 0 || height == 0) {
         return;
     }
 
-    UInt32 mipCount;
+    /// levels already in srcData are uploaded as they are, the GPU only fills a single level chain
+    mipCount = std::max(mipCount, 1U);
+    generateMipmap = generateMipmap && mipCount == 1;
     if (generateMipmap) {
-        mipCount = (uint32_t) (std::floor(std::log2(std::max(width, height)))) + 1;
-    } else {
-        mipCount = 1;
+        mipCount = CalculateMipCount(width, height);
     }
 
     std::shared_lock shared_lock(textureIdMap_mutex);
@@ -207,11 +194,13 @@ void TextureManager::uploadTexture2D(TextureID tid, const UInt8 *srcData,
         VmaAllocationCreateInfo memory_info{};
         memory_info.usage = VMA_MEMORY_USAGE_AUTO;
 
-        if (!checkFormatSupport(GetDevice().vkPhysicalDevice(),
-                                image_info.format,
-                                VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
-                                VK_FORMAT_FEATURE_BLIT_DST_BIT |
-                                VK_FORMAT_FEATURE_TRANSFER_DST_BIT)) {
+        /// blits only generate mips, block compressed formats cannot be blitted to
+        VkFormatFeatureFlags featureFlags = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+        if (generateMipmap) {
+            featureFlags |= VK_FORMAT_FEATURE_BLIT_DST_BIT;
+        }
+
+        if (!checkFormatSupport(GetDevice().vkPhysicalDevice(), image_info.format, featureFlags)) {
 
             AN_LOG(Error, "vulkan image format not support, format enum value %d", image_info.format);
             return;
@@ -265,12 +254,18 @@ void TextureManager::uploadTexture2D(TextureID tid, const UInt8 *srcData,
 
     /// srcData may be null to create a empty texture when init
     if (srcData != nullptr) {
-        uploadTexture2DData(srcData, targetTex->image, width, height, format, 0);
-
         if (generateMipmap) {
+            uploadTexture2DData(srcData, targetTex->image, width, height, format, 0);
             CommandBuffer *commandBuffer = GetCommandPool().newCommandBuffer(GetDevice().getGraphicsQueue().getFamilyIndex());
             commandBuffer->generateMipmaps(targetTex->image, width, height, mipCount);
             commandBuffer->submit();
+        } else {
+            const UInt8 *levelData = srcData;
+            for (UInt32 level = 0; level < mipCount; ++level) {
+                UInt32 levelWidth = CalculateMipSize(width, level), levelHeight = CalculateMipSize(height, level);
+                uploadTexture2DData(levelData, targetTex->image, levelWidth, levelHeight, format, level);
+                levelData += CalculatePixelFormatSize(format, levelWidth, levelHeight);
+            }
         }
     }
 
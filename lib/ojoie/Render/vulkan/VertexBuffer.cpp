@@ -374,7 +374,7 @@ void VertexBuffer::updateIndexBufferData(const IndexBufferData &sourceData) {
         return;
     }
 
-    int size = sourceData.count * kVBOIndexSize;
+    int size = CalculateIndexBufferSize(sourceData);
 
     VmaAllocation mapAllocation;
 
@@ -442,6 +442,7 @@ void VertexBuffer::updateIndexData(const IndexBufferData &buffer) {
 //    setVersionAndCleanup(version);
 
     int newSize = CalculateIndexBufferSize(buffer);
+    _indexFormat = buffer.format;
 
     if (_indicesDynamic) {
         if (newSize > _dynIndexBufferSize[_currentVersion % kMaxFrameInFlight]) {
@@ -535,10 +536,11 @@ void VertexBuffer::bindVertexBuffer(AN::CommandBuffer *commandBuffer) {
 
 void VertexBuffer::bindIndexBuffer(AN::CommandBuffer *commandBuffer) {
     VK::CommandBuffer *vkCommand = (VK::CommandBuffer *)commandBuffer;
+    VkIndexType indexType = _indexFormat == kIndexFormatUInt32 ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
     if (_indicesDynamic) {
-        vkCommand->bindIndexBuffer(VK_INDEX_TYPE_UINT16, 0, _dynIndexBuffer[_renderVersion % kMaxFrameInFlight].buffer);
+        vkCommand->bindIndexBuffer(indexType, 0, _dynIndexBuffer[_renderVersion % kMaxFrameInFlight].buffer);
     } else {
-        vkCommand->bindIndexBuffer(VK_INDEX_TYPE_UINT16, 0, _indexBuffer);
+        vkCommand->bindIndexBuffer(indexType, 0, _indexBuffer);
     }
 }
 
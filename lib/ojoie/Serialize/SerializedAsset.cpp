@@ -2,14 +2,17 @@
 // Created by aojoie on 12/16/2023.
 //
 #include "Core/Actor.hpp"
+#include "Misc/ResourceManager.hpp"
 #include "Serialize/SerializedAsset.h"
 #include "Utility/Path.hpp"
-#include "IO/FileInputStream.hpp"
+#include "HAL/File.hpp"
 
 #include <ojoie/IO/FileOutputStream.hpp>
 #include <ojoie/Serialize/Coder/YamlEncoder.hpp>
 
+#include <algorithm>
 #include <format>
+#include <string_view>
 #include <unordered_map>
 
 namespace AN
@@ -36,6 +39,13 @@ bool SerializedAsset::GetSerializedObjectHook(const SerializedObjectIdentifier &
         return true;
     }
 
+    if (!identifier.uuid.IsValid() && self->m_UUID.IsValid())
+    {
+        // object of this asset which is not decoded now, see LoadObjectAtPath
+        object = GetSerializeManager().GetSerializedObject({ self->m_UUID, identifier.localID }, className);
+        return true;
+    }
+
     return false;
 }
 
@@ -106,13 +116,6 @@ bool SerializedAsset::SaveAtPath(const char *path)
         return false;
     }
 
-    File assetFile;
-
-    if (!assetFile.Open(path, kFilePermissionWrite))
-    {
-        return false;
-    }
-
     std::unordered_map<int, int> localIDGen;
     for (Object *object : m_ObjectList)
     {
@@ -124,6 +127,40 @@ bool SerializedAsset::SaveAtPath(const char *path)
         m_LocalIDToObjectMap[localID] = object;
     }
 
+    /// encode all objects before the file is touched, an object failing to encode must not leave a partial asset
+    std::vector<std::string> documents;
+    documents.reserve(m_ObjectList.size());
+
+    GetSerializeManager().HookGetSerializedObjectIdentifier(GetSerializedObjectIdentifierHook, this);
+
+    bool bEncoded = true;
+    for (Object *object : m_ObjectList)
+    {
+        YamlEncoder yamlEncoder;
+        object->redirectTransferVirtual(yamlEncoder);
+        if (yamlEncoder.hasError())
+        {
+            bEncoded = false;
+            break;
+        }
+        yamlEncoder.outputToString(documents.emplace_back());
+    }
+
+    GetSerializeManager().HookGetSerializedObjectIdentifier(nullptr, nullptr);
+
+    if (!bEncoded)
+    {
+        AN_LOG(Error, "Failed serializing asset %s, an object could not be encoded", path);
+        return false;
+    }
+
+    File assetFile;
+
+    if (!assetFile.Open(path, kFilePermissionWrite))
+    {
+        return false;
+    }
+
     GenerateMetaAtPath(path);
 
     for (Object *object : m_ObjectList)
@@ -135,16 +172,12 @@ bool SerializedAsset::SaveAtPath(const char *path)
         GetSerializeManager().RegisterSerializedObjectIdentifier(object, identifier);
     }
 
-    GetSerializeManager().HookGetSerializedObjectIdentifier(GetSerializedObjectIdentifierHook, this);
-
     assetFile.WriteLine("%YAML 1.1");
     assetFile.WriteLine("%TAG !AN! tag:an.com,2023:");
 
-    FileOutputStream fileOutputStream(assetFile);
-
-
-    for (Object *object : m_ObjectList)
+    for (size_t i = 0; i < m_ObjectList.size(); ++i)
     {
+        Object *object = m_ObjectList[i];
         UInt64 localID = m_ObjectToLocalIDMap[object];
 
         int sz = std::snprintf(nullptr, 0, "--- !AN!%s &%llu", object->getClassName(),localID);
@@ -153,142 +186,260 @@ bool SerializedAsset::SaveAtPath(const char *path)
         buffer[sz] = 0;
 
         assetFile.WriteLine(buffer);
-
-        YamlEncoder yamlEncoder;
-        object->redirectTransferVirtual(yamlEncoder);
-        yamlEncoder.outputToStream(fileOutputStream);
+        assetFile.Write(documents[i].data(), (int)documents[i].size());
     }
 
     assetFile.Close();
 
-    GetSerializeManager().HookGetSerializedObjectIdentifier(nullptr, nullptr);
-
     return true;
 }
 
-bool SerializedAsset::LoadAtPath(const char *path)
+static bool ReadFileText(const char *path, std::string &buffer, std::string_view &text)
 {
-    m_ObjectList.clear();
+    File file;
+    if (!file.Open(path, kFilePermissionRead))
+    {
+        return false;
+    }
 
-    Path metaPath(path);
-    metaPath.Append(".meta");
+    int length = file.GetFileLength();
+    buffer.resize(length);
+    text = buffer;
+    return length == 0 || file.Read(buffer.data(), length) == length;
+}
 
-    ObjectMeta objectMeta;
-    if (!metaPath.Exists())
+/// next line without the line break, false at the end of the text
+static bool NextLine(std::string_view text, size_t &position, std::string_view &line)
+{
+    if (position >= text.size())
     {
-        // meta not found, generate meta
-        AN_LOG(Info, "%s path meta not found, generating", path);
-        GenerateMetaAtPath(path);
+        return false;
     }
-    else
+
+    size_t end = text.find('\n', position);
+    if (end == std::string_view::npos)
     {
+        end = text.size();
+    }
 
-        File        file;
-        if (!file.Open(metaPath.ToString().c_str(), AN::kFilePermissionRead))
+    line = text.substr(position, end - position);
+    if (!line.empty() && line.back() == '\r')
+    {
+        line.remove_suffix(1);
+    }
+    position = end + 1;
+    return true;
+}
+
+/// uuids of references to other assets, written by TransferIDPtr as {uuid: ..., localID: ..., className: ...}
+static void ScanReferencedUUIDs(std::string_view text, const std::string &selfUUID, std::vector<std::string> &uuids)
+{
+    static constexpr std::string_view kUUIDKey = "uuid: ";
+    for (size_t position = text.find(kUUIDKey); position != std::string_view::npos; position = text.find(kUUIDKey, position))
+    {
+        position += kUUIDKey.size();
+        size_t end = text.find_first_of(",} \r\n", position);
+        std::string uuid(text.substr(position, end - position));
+        std::erase(uuid, '"');
+
+        if (!uuid.empty() && uuid != selfUUID && std::find(uuids.begin(), uuids.end(), uuid) == uuids.end())
         {
-            return false;
+            uuids.push_back(std::move(uuid));
         }
-        FileInputStream fileInputStream(file);
-        YamlDecoder decoder(fileInputStream);
-        objectMeta.transfer(decoder);
-
-        m_UUID = objectMeta.uuid;
     }
+}
 
-    File assetFile;
+bool SerializedAsset::ReadAtPath(const char *path, SerializedAssetData &data)
+{
+    Path metaPath(path);
+    metaPath.Append(".meta");
 
-    if (!assetFile.Open(path, kFilePermissionRead))
+    /// mounted archives replace the loose files
+    ResourceManager &resourceManager = GetResourceManager();
+    data.bHasMeta = resourceManager.readArchivedFile(metaPath.ToString().c_str(), data.metaBuffer, data.metaText);
+    if (!data.bHasMeta)
     {
-        return false;
+        data.bHasMeta = metaPath.Exists();
+        if (data.bHasMeta && !ReadFileText(metaPath.ToString().c_str(), data.metaBuffer, data.metaText))
+        {
+            return false;
+        }
     }
 
-//    assetFile.WriteLine("%YAML 1.1");
-//    assetFile.WriteLine("%TAG !AN! tag:an.com,2023:");
-    assetFile.ReadLine();
-    assetFile.ReadLine();
+    return resourceManager.readArchivedFile(path, data.textBuffer, data.text) || ReadFileText(path, data.textBuffer, data.text);
+}
 
-    std::string info;
-    std::string buffer;
+/// call func(className, localID, body) for every object document of the asset text, stops when func returns false
+template<typename Func>
+static bool ForEachObjectSection(std::string_view text, Func &&func)
+{
+    std::string_view line;
+    size_t           position = 0;
 
-    info = assetFile.ReadLine();
+    // skip "%YAML 1.1" and "%TAG !AN! tag:an.com,2023:"
+    NextLine(text, position, line);
+    NextLine(text, position, line);
 
-    while (!assetFile.IsEOF())
+    bool bHasLine = NextLine(text, position, line);
+    while (bHasLine && !line.empty())
     {
-        if (assetFile.IsEOF() || info.empty())
-        {
-            break;
-        }
-
         // limit className to 128 characters
         char   className[128];
         UInt64 localID = 0;
-        int    n       = sscanf(info.c_str(), "--- !AN!%120s &%llu", className, &localID);
+        std::string header(line);
+        int    n       = sscanf(header.c_str(), "--- !AN!%120s &%llu", className, &localID);
 
         if (n != 2)
         {
-            AN_LOG(Error, "Read asset file failed, file may be broken");
+            AN_LOG(Error, "%s", "Read asset file failed, file may be broken");
             return false;
         }
 
-        SerializedObjectIdentifier identifier{ m_UUID, localID };
-        Object *object = GetSerializeManager().GetSerializedObject(identifier, className);
-        m_ObjectToLocalIDMap[object] = localID;
-        m_LocalIDToObjectMap[localID] = object;
+        size_t begin = position, end = position;
+        while ((bHasLine = NextLine(text, position, line)) && !line.empty() && line.find("--- !AN!") == std::string_view::npos)
+        {
+            end = std::min(position, text.size());
+        }
 
-        if (m_MainObject == nullptr && objectMeta.mainObjectLocalID == localID)
+        if (!func(className, localID, text.substr(begin, end - begin)))
         {
-            m_MainObject = object;
+            break;
         }
+    }
+    return true;
+}
 
-        m_ObjectList.push_back(object);
+bool SerializedAsset::Parse(SerializedAssetData &data)
+{
+    if (data.bHasMeta)
+    {
+        YamlDecoder decoder(data.metaText.data(), (int)data.metaText.size());
+        data.meta.transfer(decoder);
+    }
+
+    std::string selfUUID = data.meta.uuid.IsValid() ? data.meta.uuid.ToString() : std::string();
+    bool bParsed = ForEachObjectSection(data.text, [&](const char *className, UInt64 localID, std::string_view body)
+    {
+        ScanReferencedUUIDs(body, selfUUID, data.referencedUUIDs);
+
+        SerializedAssetData::ObjectSection &section = data.objects.emplace_back();
+        section.className = className;
+        section.localID   = localID;
+        section.decoder   = std::make_unique<YamlDecoder>(body.data(), (int)body.size());
+        return true;
+    });
+
+    // the decoders hold the parsed documents
+    data.text     = {};
+    data.metaText = {};
+    data.textBuffer.clear();
+    data.textBuffer.shrink_to_fit();
+    data.metaBuffer.clear();
+    data.metaBuffer.shrink_to_fit();
+    return bParsed;
+}
+
+void SerializedAsset::BeginLoad(const char *path, SerializedAssetData &data)
+{
+    m_ObjectList.clear();
+
+    if (!data.bHasMeta)
+    {
+        // meta not found, generate meta
+        AN_LOG(Info, "%s path meta not found, generating", path);
+        GenerateMetaAtPath(path);
+    }
+    else
+    {
+        m_UUID = data.meta.uuid;
+    }
 
-        do
+    for (SerializedAssetData::ObjectSection &section : data.objects)
+    {
+        SerializedObjectIdentifier identifier{ m_UUID, section.localID };
+        Object *object = GetSerializeManager().GetSerializedObject(identifier, section.className.c_str());
+        m_ObjectToLocalIDMap[object] = section.localID;
+        m_LocalIDToObjectMap[section.localID] = object;
+
+        if (m_MainObject == nullptr && data.meta.mainObjectLocalID == section.localID)
         {
-            info = assetFile.ReadLine();
+            m_MainObject = object;
+        }
 
-            if (assetFile.IsEOF() || info.empty() || info.find("--- !AN!") != std::string::npos)
-            {
-                break;
-            }
-        }  while (true);
+        m_ObjectList.push_back(object);
     }
+}
 
+void SerializedAsset::LoadObject(SerializedAssetData &data, size_t index)
+{
     GetSerializeManager().HookGetSerializedObject(GetSerializedObjectHook, this);
+    m_ObjectList[index]->redirectTransferVirtual(*data.objects[index].decoder);
+    GetSerializeManager().HookGetSerializedObject(nullptr, nullptr);
 
-    int objectIndex = 0;
-    assetFile.SetPosition(0);
-    assetFile.ReadLine();
-    assetFile.ReadLine();
-    info = assetFile.ReadLine();
+    data.objects[index].decoder.reset();
+}
+
+std::unique_ptr<YamlDecoder> SerializedAsset::DecodeObjectAtPath(const char *path, UInt64 localID)
+{
+    SerializedAssetData data;
+    if (!ReadAtPath(path, data))
+    {
+        return nullptr;
+    }
 
-    while (!assetFile.IsEOF())
+    /// only the document of localID is parsed
+    std::unique_ptr<YamlDecoder> decoder;
+    ForEachObjectSection(data.text, [&](const char *className, UInt64 sectionLocalID, std::string_view body)
     {
-        if (assetFile.IsEOF() || info.empty())
+        if (sectionLocalID != localID)
         {
-            break;
+            return true;
         }
+        decoder = std::make_unique<YamlDecoder>(body.data(), (int)body.size());
+        return false;
+    });
+    return decoder;
+}
 
-        do
-        {
-            info = assetFile.ReadLine();
+bool SerializedAsset::LoadObjectAtPath(const char *path, Object *object)
+{
+    SerializedObjectIdentifier identifier = GetSerializeManager().GetSerializedObjectIdentifier(object);
+    if (!identifier.uuid.IsValid())
+    {
+        return false;
+    }
 
-            if (assetFile.IsEOF() || info.empty() || info.find("--- !AN!") != std::string::npos)
-            {
-                break;
-            }
+    std::unique_ptr<YamlDecoder> decoder = DecodeObjectAtPath(path, identifier.localID);
+    if (decoder == nullptr)
+    {
+        return false;
+    }
 
-            buffer.append(info);
-            buffer.append("\n");
-        }  while (true);
+    m_UUID = identifier.uuid;
+    m_ObjectToLocalIDMap[object] = identifier.localID;
+    m_LocalIDToObjectMap[identifier.localID] = object;
 
-        YamlDecoder     decoder(buffer.data(), buffer.size());
-        m_ObjectList[objectIndex++]->redirectTransferVirtual(decoder);
-        buffer.clear();
+    GetSerializeManager().HookGetSerializedObject(GetSerializedObjectHook, this);
+    object->redirectTransferVirtual(*decoder);
+    GetSerializeManager().HookGetSerializedObject(nullptr, nullptr);
+    return true;
+}
+
+bool SerializedAsset::LoadAtPath(const char *path)
+{
+    SerializedAssetData data;
+    if (!ReadAtPath(path, data) || !Parse(data))
+    {
+        return false;
     }
 
-    GetSerializeManager().HookGetSerializedObject(nullptr, nullptr);
+    BeginLoad(path, data);
+    for (size_t i = 0; i < data.objects.size(); ++i)
+    {
+        LoadObject(data, i);
+    }
 
     return true;
 }
 
-}
\ No newline at end of file
+}
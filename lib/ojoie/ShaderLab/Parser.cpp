@@ -5,6 +5,7 @@
 #include <ojoie/Utility/Log.h>
 #include "ShaderLab/Parser.hpp"
 
+#include <algorithm>
 #include <variant>
 
 namespace AN::ShaderLab {
@@ -327,6 +328,7 @@ __error:
 
 bool Parser::parseSubShader(ShaderInfo &info) {
     SubShader subShader{};
+    std::vector<KeywordDeclaration> includeKeywords;
     info.subShaderHLSLIncludes.emplace_back();
     info.passHLSLSources.emplace_back();
 
@@ -340,11 +342,12 @@ bool Parser::parseSubShader(ShaderInfo &info) {
 
     if (token.is(kToken_kw_HLSLINCLUDE)) {
         CHECK(parseHLSLInclude(info.subShaderHLSLIncludes.back()));
+        CHECK(parseKeywordPragmas(info.subShaderHLSLIncludes.back(), includeKeywords));
     }
 
     while (token.is(kToken_kw_Pass)) {
         info.passHLSLSources.back().emplace_back();
-        CHECK(parsePass(subShader, info.passHLSLSources.back().back()));
+        CHECK(parsePass(subShader, info.passHLSLSources.back().back(), includeKeywords));
     }
 
     CHECK(consume(kToken_right_curly_bracket));
@@ -355,7 +358,7 @@ __error:
     return false;
 }
 
-bool Parser::parsePass(SubShader &subShader, std::string &outSource) {
+bool Parser::parsePass(SubShader &subShader, std::string &outSource, const std::vector<KeywordDeclaration> &includeKeywords) {
     ShaderPass pass{};
     /// setting default values
     pass.ZWrite = true;
@@ -378,6 +381,9 @@ bool Parser::parsePass(SubShader &subShader, std::string &outSource) {
     CHECK(expect(kToken_kw_HLSLPROGRAM));
     CHECK(parseHLSLSource(outSource));
 
+    pass.keywordDeclarations = includeKeywords;
+    CHECK(parseKeywordPragmas(outSource, pass.keywordDeclarations));
+
     CHECK(consume(kToken_right_curly_bracket));
 
     subShader.passes.push_back(pass);
@@ -591,6 +597,76 @@ __error:
     return false;
 }
 
+bool Parser::parseKeywordPragmas(std::string &source, std::vector<KeywordDeclaration> &declarations) {
+    const auto isBlank = [](char ch) { return ch == ' ' || ch == '\t'; };
+    const auto isIdentifier = [](char ch) {
+        return ch == '_' || (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9');
+    };
+
+    size_t lineStart = 0;
+    while (lineStart < source.size()) {
+        size_t lineEnd = source.find('\n', lineStart);
+        if (lineEnd == std::string::npos) lineEnd = source.size();
+
+        std::string_view line(source.data() + lineStart, lineEnd - lineStart);
+        size_t pos = 0;
+        const auto skipBlank = [&] { while (pos < line.size() && isBlank(line[pos])) ++pos; };
+        const auto nextWord  = [&] {
+            skipBlank();
+            size_t begin = pos;
+            while (pos < line.size() && !isBlank(line[pos]) && line[pos] != '\r') ++pos;
+            return line.substr(begin, pos - begin);
+        };
+
+        skipBlank();
+        if (pos < line.size() && line[pos] == '#') {
+            ++pos;
+            std::string_view directive = nextWord() == "pragma" ? nextWord() : std::string_view{};
+            if (directive == "multi_compile" || directive == "shader_feature") {
+                KeywordDeclaration declaration{};
+                declaration.bShaderFeature = directive == "shader_feature";
+
+                for (std::string_view word = nextWord(); !word.empty(); word = nextWord()) {
+                    if (!std::all_of(word.begin(), word.end(), isIdentifier)) {
+                        errorWithMsg(1, std::format("invalid shader keyword {}", word).c_str());
+                        return false;
+                    }
+                    /// "_" and "__" declare the variant without any keyword of the line
+                    if (word.find_first_not_of('_') == std::string_view::npos) word = "_";
+                    declaration.keywords.emplace_back(word);
+                }
+
+                if (declaration.keywords.empty()) {
+                    errorWithMsg(1, std::format("#pragma {} without keywords", directive).c_str());
+                    return false;
+                }
+                /// a single feature keyword is either on or off
+                if (declaration.bShaderFeature && declaration.keywords.size() == 1 && declaration.keywords[0] != "_") {
+                    declaration.keywords.insert(declaration.keywords.begin(), Name("_"));
+                }
+                declarations.push_back(std::move(declaration));
+
+                /// keep the line so that compiler errors still point at the right row
+                for (size_t i = lineStart; i < lineEnd; ++i) {
+                    if (source[i] != '\r') source[i] = ' ';
+                }
+            }
+        }
+        lineStart = lineEnd + 1;
+    }
+
+    size_t keywordCount = 0;
+    for (const KeywordDeclaration &declaration : declarations) {
+        keywordCount += std::count_if(declaration.keywords.begin(), declaration.keywords.end(),
+                                      [](const Name &keyword) { return keyword != "_"; });
+    }
+    if (keywordCount > kMaxPassKeywords) {
+        errorWithMsg(1, std::format("a pass declares {} keywords, at most {} are supported", keywordCount, kMaxPassKeywords).c_str());
+        return false;
+    }
+    return true;
+}
+
 ShaderInfo Parser::parse() {
     ShaderInfo shaderInfo{};
     parseShader(shaderInfo);
@@ -48,8 +48,8 @@ Shader "AN/Default"
             v2f vertex_main(appdata v)
             {
                 v2f o;
-                float3 worldPos = TransformObjectToWorld(v.vertex.xyz);
-                half3 normalWS = TransformObjectToWorldNormal(v.normal);
+                float3 worldPos = TransformObjectToWorld(DecodePositionOS(v.vertex.xyz));
+                half3 normalWS = TransformObjectToWorldNormal(DecodeNormalOS(v.normal));
                 worldPos = ApplyShadowBias(worldPos, normalWS, _LightDirection.xyz);
 
                 o.vertexOut = TransformWorldToHClip(worldPos);
@@ -59,7 +59,7 @@ Shader "AN/Default"
 
             void fragment_main(v2f i)
             {
-
+                LODFadeCrossFade(i.vertexOut);
             }
 
 
@@ -83,6 +83,7 @@ Shader "AN/Default"
             #define vertex vertex_main // define vertex shader entry
             #define frag fragment_main // define fragment shader entry
 
+            #include "ClusteredLights.hlsl"
 
             struct appdata
             {
@@ -99,7 +100,7 @@ Shader "AN/Default"
                 float3 positionVS : TEXCOORD0;
                 float2 uv : TEXCOORD1;
                 float3 normalWS : TEXCOORD2;
-                float4 shadowCoord : TEXCOORD3;
+                float3 positionWS : TEXCOORD3;
                 float3 normalOS : TEXCOORD4;
                 float4 tangentOS : TEXCOORD5;
             };
@@ -109,6 +110,10 @@ Shader "AN/Default"
             v2f vertex(appdata v, uint VertexIndex : SV_VertexID)
             {
                 v2f o;
+                v.vertex = DecodePositionOS(v.vertex);
+                v.normal = DecodeNormalOS(v.normal);
+                v.tangent = DecodeTangentOS(v.tangent);
+
                 VertexPositionInputs vertex_position_inputs = GetVertexPositionInputs(v.vertex.xyz);
                 o.positionCS = vertex_position_inputs.positionCS;
                 o.positionVS = vertex_position_inputs.positionVS;
@@ -118,19 +123,23 @@ Shader "AN/Default"
                 VertexNormalInputs normalInputs = GetVertexNormalInputs(v.normal);
                 o.normalWS = normalInputs.normalWS;
                 o.normalOS = v.normal;
-                o.shadowCoord = TransformWorldToShadowCoord(vertex_position_inputs.positionWS);
+                // cascade is selected per pixel, so pass world position instead of shadow coord
+                o.positionWS = vertex_position_inputs.positionWS;
                 o.tangentOS = v.tangent;
                 return o;
             }
 
             half4 frag(v2f i, bool IsFacing : SV_IsFrontFace) : SV_TARGET
             {
+                LODFadeCrossFade(i.positionCS);
+
                 //i.shadowCoord.xyz  /= i.shadowCoord.w;
                 // i.shadowCoord.xy = i.shadowCoord.xy * 0.5 + 0.5;
                 // i.shadowCoord.y = 1.0 - i.shadowCoord.y;
                 float3 N = normalize(i.normalWS);
 //                 return half4(i.normalWS * 0.5 + 0.5, 1.0);
-                Light light = GetMainLight(i.shadowCoord, N);
+                float4 shadowCoord = TransformWorldToShadowCoord(i.positionWS);
+                Light light = GetMainLight(shadowCoord, N);
 
                 float3 V = normalize(mul((float3x3)AN_MATRIX_I_V, i.positionVS * (-1)));
                 float3 L = normalize(light.direction);
@@ -148,6 +157,18 @@ Shader "AN/Default"
                 float3 specular = light.color * _Specular.rgb * pow(saturate(NoH), _Gloss) *
                                   light.distanceAttenuation/*  * light.shadowAttenuation */;
 
+                // point and spot lights of the cluster
+                uint2 clusterRange = GetClusterLightRange(i.positionVS);
+                for (uint li = 0; li < clusterRange.y; ++li)
+                {
+                    Light additionalLight = GetClusterLight(GetClusterLightIndex(clusterRange.x + li), i.positionWS);
+                    float3 AL = normalize(additionalLight.direction);
+                    float3 AH = normalize(AL + V);
+                    float3 radiance = additionalLight.color * additionalLight.distanceAttenuation;
+                    diffuse += radiance * baseColor * saturate(dot(N, AL));
+                    specular += radiance * _Specular.rgb * pow(saturate(dot(N, AH)), _Gloss);
+                }
+
                 half3 colorOut = diffuse + ambient + specular;
 
                 return half4(colorOut, 1.0) * _MainColor;
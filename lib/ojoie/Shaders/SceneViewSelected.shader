@@ -50,7 +50,7 @@ Shader "Hidden/SceneViewSelected"
             v2f vertex(appdata v)
             {
                 v2f o;
-                VertexPositionInputs vertex_position_inputs = GetVertexPositionInputs(v.vertex.xyz);
+                VertexPositionInputs vertex_position_inputs = GetVertexPositionInputs(DecodePositionOS(v.vertex.xyz));
                 o.vertexOut = vertex_position_inputs.positionCS;
                 return o;
             }
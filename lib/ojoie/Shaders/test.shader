@@ -73,6 +73,10 @@ Shader "AN/DiffuseVertexLevel"
             v2f vertex(appdata v, uint VertexIndex : SV_VertexID)
             {
                 v2f o;
+                v.vertex.xyz = DecodePositionOS(v.vertex.xyz);
+                v.normal = DecodeNormalOS(v.normal);
+                v.tangent = DecodeTangentOS(v.tangent);
+
                 VertexPositionInputs vertex_position_inputs = GetVertexPositionInputs(v.vertex.xyz);
                 o.positionCS = vertex_position_inputs.positionCS;
                 o.positionWS = vertex_position_inputs.positionWS;
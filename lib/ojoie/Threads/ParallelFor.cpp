@@ -0,0 +1,44 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Threads/ParallelFor.hpp"
+
+#include <algorithm>
+
+#ifdef WITH_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
+namespace AN {
+
+void ParallelFor(size_t count, size_t grainSize, ParallelForFunc func, void *userdata) {
+    if (count == 0) return;
+    grainSize = std::max<size_t>(grainSize, 1);
+
+#ifdef WITH_TBB
+    if (count > grainSize) {
+        tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, count, grainSize),
+                [func, userdata](const tbb::blocked_range<size_t> &range) {
+                    func(userdata, range.begin(), range.end());
+                });
+        return;
+    }
+#endif
+
+    for (size_t begin = 0; begin < count; begin += grainSize) {
+        func(userdata, begin, std::min(begin + grainSize, count));
+    }
+}
+
+UInt32 GetParallelWorkerCount() {
+#ifdef WITH_TBB
+    return (UInt32) tbb::this_task_arena::max_concurrency();
+#else
+    return 1;
+#endif
+}
+
+}
@@ -0,0 +1,153 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Utility/Compression.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace AN {
+
+static constexpr size_t kMinMatch     = 4;
+static constexpr size_t kLastLiterals = 5;  // the block ends with at least this many literals
+static constexpr size_t kMatchLimit   = 12; // no match starts in the last this many bytes
+static constexpr size_t kMaxOffset    = 65535;
+static constexpr int    kHashBits     = 12;
+
+static inline UInt32 Read32(const UInt8 *p) {
+    UInt32 value;
+    memcpy(&value, p, sizeof value);
+    return value;
+}
+
+static inline UInt32 HashSequence(UInt32 sequence) {
+    return (sequence * 2654435761U) >> (32 - kHashBits);
+}
+
+static inline UInt8 *WriteLength(UInt8 *op, size_t length) {
+    for (; length >= 255; length -= 255) *op++ = 255;
+    *op++ = (UInt8) length;
+    return op;
+}
+
+size_t LZ4CompressBound(size_t srcSize) {
+    return srcSize + srcSize / 255 + 16;
+}
+
+size_t LZ4Compress(const void *src, size_t srcSize, void *dst, size_t dstCapacity) {
+    if (dstCapacity < LZ4CompressBound(srcSize)) return 0;
+
+    const UInt8 *in     = (const UInt8 *) src;
+    UInt8       *op     = (UInt8 *) dst;
+    size_t       anchor = 0;
+
+    if (srcSize > kMatchLimit) {
+        UInt32 table[1 << kHashBits] = {};
+        size_t matchEnd   = srcSize - kLastLiterals;
+        size_t lastStart  = srcSize - kMatchLimit;
+
+        for (size_t ip = 1; ip <= lastStart;) {
+            UInt32 sequence = Read32(in + ip);
+            UInt32 hash     = HashSequence(sequence);
+            size_t ref      = table[hash];
+            table[hash]     = (UInt32) ip;
+
+            if (ip - ref > kMaxOffset || Read32(in + ref) != sequence) {
+                ++ip;
+                continue;
+            }
+
+            /// grow the match back over literals, then forward
+            while (ip > anchor && ref > 0 && in[ip - 1] == in[ref - 1]) {
+                --ip;
+                --ref;
+            }
+            size_t length = kMinMatch;
+            while (ip + length < matchEnd && in[ip + length] == in[ref + length]) ++length;
+
+            size_t literals = ip - anchor;
+            UInt8 *token    = op++;
+            *token          = (UInt8) (std::min<size_t>(literals, 15) << 4);
+            if (literals >= 15) op = WriteLength(op, literals - 15);
+            memcpy(op, in + anchor, literals);
+            op += literals;
+
+            size_t offset = ip - ref;
+            *op++         = (UInt8) offset;
+            *op++         = (UInt8) (offset >> 8);
+
+            size_t matchLength = length - kMinMatch;
+            *token |= (UInt8) std::min<size_t>(matchLength, 15);
+            if (matchLength >= 15) op = WriteLength(op, matchLength - 15);
+
+            ip += length;
+            anchor = ip;
+            if (ip <= lastStart) table[HashSequence(Read32(in + ip - 2))] = (UInt32) (ip - 2);
+        }
+    }
+
+    size_t literals = srcSize - anchor;
+    *op++           = (UInt8) (std::min<size_t>(literals, 15) << 4);
+    if (literals >= 15) op = WriteLength(op, literals - 15);
+    memcpy(op, in + anchor, literals);
+    op += literals;
+    return (size_t) (op - (UInt8 *) dst);
+}
+
+bool LZ4Decompress(const void *src, size_t srcSize, void *dst, size_t dstSize) {
+    const UInt8 *ip    = (const UInt8 *) src;
+    const UInt8 *ipEnd = ip + srcSize;
+    UInt8       *op    = (UInt8 *) dst;
+    UInt8       *opEnd = op + dstSize;
+
+    while (true) {
+        if (ip >= ipEnd) return false;
+        UInt8 token = *ip++;
+
+        size_t literals = token >> 4;
+        if (literals == 15) {
+            UInt8 byte;
+            do {
+                if (ip >= ipEnd) return false;
+                byte = *ip++;
+                literals += byte;
+            } while (byte == 255);
+        }
+        if (literals > (size_t) (ipEnd - ip) || literals > (size_t) (opEnd - op)) return false;
+        memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+
+        /// the last sequence has only literals
+        if (ip == ipEnd) return op == opEnd;
+
+        if (ipEnd - ip < 2) return false;
+        size_t offset = ip[0] | (size_t) ip[1] << 8;
+        ip += 2;
+        if (offset == 0 || offset > (size_t) (op - (UInt8 *) dst)) return false;
+
+        size_t length = token & 15;
+        if (length == 15) {
+            UInt8 byte;
+            do {
+                if (ip >= ipEnd) return false;
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+        }
+        length += kMinMatch;
+        if (length > (size_t) (opEnd - op)) return false;
+
+        const UInt8 *match = op - offset;
+        if (offset >= length) {
+            memcpy(op, match, length);
+            op += length;
+        } else {
+            /// the match overlaps what it writes, a run
+            for (UInt8 *end = op + length; op < end;) *op++ = *match++;
+        }
+    }
+}
+
+}
@@ -0,0 +1,80 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include "Utility/Hash128.hpp"
+#include "Utility/String.hpp"
+
+#include <cstring>
+
+namespace AN {
+
+static inline UInt64 RotateLeft(UInt64 x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline UInt64 FinalMix(UInt64 k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+Hash128 ComputeHash128(const void *data, size_t size, UInt64 seed) {
+    const UInt8 *bytes  = (const UInt8 *) data;
+    const size_t blocks = size / 16;
+
+    UInt64 h1 = seed, h2 = seed;
+    const UInt64 c1 = 0x87c37b91114253d5ULL;
+    const UInt64 c2 = 0x4cf5ad432745937fULL;
+
+    for (size_t i = 0; i < blocks; ++i) {
+        UInt64 k1, k2;
+        memcpy(&k1, bytes + i * 16, 8);
+        memcpy(&k2, bytes + i * 16 + 8, 8);
+
+        k1 *= c1; k1 = RotateLeft(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = RotateLeft(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+        k2 *= c2; k2 = RotateLeft(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = RotateLeft(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    /// tail of up to 15 bytes, little endian like the blocks
+    const UInt8 *tail = bytes + blocks * 16;
+    UInt64 k1 = 0, k2 = 0;
+    size_t rest = size & 15;
+    for (size_t i = rest; i > 8; --i) k2 |= (UInt64) tail[i - 1] << ((i - 9) * 8);
+    for (size_t i = rest < 8 ? rest : 8; i > 0; --i) k1 |= (UInt64) tail[i - 1] << ((i - 1) * 8);
+    if (rest > 8) {
+        k2 *= c2; k2 = RotateLeft(k2, 33); k2 *= c1; h2 ^= k2;
+    }
+    if (rest > 0) {
+        k1 *= c1; k1 = RotateLeft(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    h1 ^= size;
+    h2 ^= size;
+    h1 += h2;
+    h2 += h1;
+    h1 = FinalMix(h1);
+    h2 = FinalMix(h2);
+    h1 += h2;
+    h2 += h1;
+    return { { h1, h2 } };
+}
+
+std::string Hash128::toString() const {
+    std::string result(32, '0');
+    /// most significant byte first so the string reads like the number
+    UInt8 bytes[16];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i]     = (UInt8) (u64[0] >> (56 - i * 8));
+        bytes[i + 8] = (UInt8) (u64[1] >> (56 - i * 8));
+    }
+    BytesToHexString(bytes, 16, result.data());
+    return result;
+}
+
+}
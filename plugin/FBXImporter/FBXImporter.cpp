@@ -666,6 +666,8 @@ bool FBXImporter::importMesh_traverse(UInt32 &meshIndex, FbxNode *node, AN::Erro
             importMesh.boneWeights.push_back(std::vector<Vector2f>(info.weight, info.weight + info.weightNum));
         }
 
+        importMesh.indexFormat = GetIndexFormatForVertexCount(vertices.size());
+
 
         for (int i = 0; i < numSubMeshes; ++i)
         {
@@ -718,6 +720,7 @@ bool FBXImporter::loadScene(const char *filePath, AN::Error *error)
 
     /// clear last import
     _importMeshes.clear();
+    _importAnimations.clear();
     _textureIDMap.clear();
     m_embeddedResources.clear();
 
@@ -783,6 +786,98 @@ std::span<const AN::ImportMesh> FBXImporter::getImportMeshes()
     return _importMeshes;
 }
 
+static void CollectSkeletonNodes(FbxNode *node, std::vector<FbxNode *> &nodes)
+{
+    FbxNodeAttribute *attribute = node->GetNodeAttribute();
+    if (attribute && attribute->GetAttributeType() == FbxNodeAttribute::eSkeleton)
+    {
+        nodes.push_back(node);
+    }
+    for (int i = 0; i < node->GetChildCount(); ++i)
+    {
+        CollectSkeletonNodes(node->GetChild(i), nodes);
+    }
+}
+
+bool FBXImporter::importAnimation(AN::Error *error)
+{
+    if (_scene == nullptr)
+    {
+        *error = AN::Error(1, "scene not loaded");
+        return false;
+    }
+
+    _importAnimations.clear();
+
+    std::vector<FbxNode *> skeletonNodes;
+    CollectSkeletonNodes(_scene->GetRootNode(), skeletonNodes);
+    if (skeletonNodes.empty())
+    {
+        return true;
+    }
+
+    FbxTime::EMode timeMode  = _scene->GetGlobalSettings().GetTimeMode();
+    double         frameRate = FbxTime::GetFrameRate(timeMode);
+
+    for (int stackIndex = 0; stackIndex < _scene->GetSrcObjectCount<FbxAnimStack>(); ++stackIndex)
+    {
+        FbxAnimStack *stack = _scene->GetSrcObject<FbxAnimStack>(stackIndex);
+        _scene->SetCurrentAnimationStack(stack);
+
+        FbxTimeSpan timeSpan = stack->GetLocalTimeSpan();
+        FbxLongLong first    = timeSpan.GetStart().GetFrameCount(timeMode);
+        FbxLongLong last     = timeSpan.GetStop().GetFrameCount(timeMode);
+        if (last < first)
+        {
+            continue;
+        }
+
+        ImportAnimation &animation = _importAnimations.emplace_back();
+        animation.name       = stack->GetName();
+        animation.sampleRate = (float) frameRate;
+        /// clips address frames with 16 bit
+        animation.frameCount = (UInt32) std::min<FbxLongLong>(last - first + 1, 65535);
+        if (animation.frameCount < last - first + 1)
+        {
+            AN_LOG(Warning, "Animation %s is truncated to 65535 frames", stack->GetName());
+        }
+
+        animation.tracks.resize(skeletonNodes.size());
+        for (size_t nodeIndex = 0; nodeIndex < skeletonNodes.size(); ++nodeIndex)
+        {
+            FbxNode              *node  = skeletonNodes[nodeIndex];
+            ImportAnimationTrack &track = animation.tracks[nodeIndex];
+            track.boneName = node->GetName();
+            track.positions.resize(animation.frameCount);
+            track.rotations.resize(animation.frameCount);
+            track.scales.resize(animation.frameCount);
+
+            for (UInt32 frame = 0; frame < animation.frameCount; ++frame)
+            {
+                FbxTime time;
+                time.SetFrame(first + frame, timeMode);
+
+                FbxAMatrix  transform   = node->EvaluateLocalTransform(time);
+                FbxVector4  translation = transform.GetT();
+                FbxQuaternion rotation  = transform.GetQ();
+                FbxVector4  scale       = transform.GetS();
+
+                track.positions[frame] = Vector3f(translation[0], translation[1], translation[2]) * (float) scaleFactor; // bone unit is cm
+                track.rotations[frame] = Math::normalize(Quaternionf((float) rotation[3], (float) rotation[0],
+                                                                     (float) rotation[1], (float) rotation[2]));
+                track.scales[frame]    = Vector3f(scale[0], scale[1], scale[2]);
+            }
+        }
+    }
+
+    return true;
+}
+
+std::span<const AN::ImportAnimation> FBXImporter::getImportAnimations()
+{
+    return _importAnimations;
+}
+
 UInt8 *FBXImporter::getTextureData(UInt32 id, UInt64 &size)
 {
     if (auto it = _textureIDMap.find(id); it != _textureIDMap.end())
@@ -32,6 +32,7 @@ class FBXImporter : public AN::FBXImporterImpl
     FbxScene *_scene{};
 
     std::vector<AN::ImportMesh> _importMeshes;
+    std::vector<AN::ImportAnimation> _importAnimations;
 
     bool importMesh_traverse(UInt32 &meshIndex, FbxNode *node, AN::Error *error);
 
@@ -46,6 +47,10 @@ public:
 
     virtual std::span<const AN::ImportMesh> getImportMeshes() override;
 
+    virtual bool importAnimation(AN::Error *error) override;
+
+    virtual std::span<const AN::ImportAnimation> getImportAnimations() override;
+
     virtual UInt8 *getTextureData(UInt32 id, UInt64 &size) override;
 
     // Callback function
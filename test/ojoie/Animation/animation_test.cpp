@@ -0,0 +1,229 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Animation/AnimationClip.hpp>
+#include <ojoie/Threads/ParallelFor.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace AN;
+
+static float AngleDegrees(const Quaternionf &a, const Quaternionf &b) {
+    float    sign = Math::dot(a, b) < 0.f ? -1.f : 1.f;
+    Vector4f chord(a.x - b.x * sign, a.y - b.y * sign, a.z - b.z * sign, a.w - b.w * sign);
+    return Math::degrees(4.f * std::asin(std::min(1.f, Math::length(chord) * 0.5f)));
+}
+
+static Quaternionf RandomRotation(std::mt19937 &rng) {
+    std::normal_distribution<float> normal;
+    return Math::normalize(Quaternionf(normal(rng), normal(rng), normal(rng), normal(rng)));
+}
+
+/// smooth motion of boneCount bones over frameCount frames, bone i is out of phase with bone i - 1
+static ImportAnimation WaveAnimation(UInt32 boneCount, UInt32 frameCount) {
+    ImportAnimation animation;
+    animation.name       = "Wave";
+    animation.sampleRate = 30.f;
+    animation.frameCount = frameCount;
+    for (UInt32 bone = 0; bone < boneCount; ++bone) {
+        ImportAnimationTrack &track = animation.tracks.emplace_back();
+        track.boneName = "Bone" + std::to_string(bone);
+        for (UInt32 frame = 0; frame < frameCount; ++frame) {
+            float phase = (float) frame / animation.sampleRate * 2.f + (float) bone * 0.3f;
+            track.positions.emplace_back(std::sin(phase) * 0.1f, 0.5f, std::cos(phase * 0.5f) * 0.05f);
+            track.rotations.push_back(Math::angleAxis(std::sin(phase) * 1.2f, Math::normalize(Vector3f(1.f, 0.3f, 0.f))));
+            track.scales.emplace_back(1.f);
+        }
+    }
+    return animation;
+}
+
+static std::vector<int> IdentityBinding(UInt32 count) {
+    std::vector<int> binding(count);
+    std::iota(binding.begin(), binding.end(), 0);
+    return binding;
+}
+
+TEST(Animation, QuantizeQuaternion) {
+    std::mt19937 rng(1);
+    float maxError = 0.f;
+    for (int i = 0; i < 10000; ++i) {
+        Quaternionf rotation = RandomRotation(rng);
+        maxError = std::max(maxError, AngleDegrees(rotation, DequantizeQuaternion(QuantizeQuaternion(rotation))));
+    }
+    RecordProperty("max_error_degrees", std::to_string(maxError));
+    EXPECT_LT(maxError, 0.02f);
+
+    /// each component can be the dropped one, negative quaternions decode to the same rotation
+    for (int largest = 0; largest < 4; ++largest) {
+        float components[4] = { 0.1f, -0.2f, 0.3f, -0.1f };
+        components[largest] = -0.9f;
+        Quaternionf rotation = Math::normalize(Quaternionf(components[3], components[0], components[1], components[2]));
+        EXPECT_LT(AngleDegrees(rotation, DequantizeQuaternion(QuantizeQuaternion(rotation))), 0.02f);
+    }
+}
+
+TEST(Animation, KeyReduction) {
+    ImportAnimation animation;
+    animation.name       = "Linear";
+    animation.frameCount = 60;
+
+    ImportAnimationTrack &track = animation.tracks.emplace_back();
+    track.boneName = "Bone";
+    for (UInt32 frame = 0; frame < animation.frameCount; ++frame) {
+        track.positions.emplace_back((float) frame * 0.1f, 0.f, 0.f);
+        track.rotations.push_back(Math::angleAxis(frame < 30 ? 0.f : 1.f, Vector3f(0.f, 1.f, 0.f)));
+        track.scales.emplace_back(2.f);
+    }
+
+    AnimationClip *clip = NewObject<AnimationClip>();
+    ASSERT_TRUE(clip->initWithImportAnimation(animation));
+    ASSERT_EQ(clip->getCurves().size(), 1);
+
+    /// straight line keeps its ends, the constant channel one key and the step four
+    const AnimationCurve &curve = clip->getCurves()[0];
+    EXPECT_EQ(curve.positionFrames, (std::vector<UInt16>{ 0, 59 }));
+    EXPECT_EQ(curve.scales.size(), 1);
+    EXPECT_EQ(curve.rotationFrames, (std::vector<UInt16>{ 0, 29, 30, 59 }));
+    EXPECT_NEAR(clip->getLength(), 59.f / 30.f, 1e-5f);
+
+    /// frames outside the clip clamp
+    AnimationPose pose;
+    pose.resize(1);
+    std::vector<int> binding = IdentityBinding(1);
+    clip->sample(-1.f, binding, pose);
+    EXPECT_EQ(pose.getPosition(0), Vector3f(0.f));
+    clip->sample(100.f, binding, pose);
+    EXPECT_NEAR(pose.getPosition(0).x, 5.9f, 1e-5f);
+    clip->sample(15.5f / 30.f, binding, pose);
+    EXPECT_NEAR(pose.getPosition(0).x, 1.55f, 1e-5f);
+    EXPECT_EQ(pose.getScale(0), Vector3f(2.f));
+
+    DestroyObject(clip);
+}
+
+TEST(Animation, SamplingAccuracy) {
+    const UInt32 boneCount = 13, frameCount = 120;
+    ImportAnimation animation = WaveAnimation(boneCount, frameCount);
+
+    AnimationCompressionSettings settings;
+    AnimationClip *clip = NewObject<AnimationClip>();
+    ASSERT_TRUE(clip->initWithImportAnimation(animation, settings));
+
+    UInt32 sourceKeys = boneCount * frameCount * 3;
+    RecordProperty("source_keys", (int) sourceKeys);
+    RecordProperty("reduced_keys", (int) clip->getKeyCount());
+    EXPECT_LT(clip->getKeyCount(), sourceKeys / 2);
+
+    /// every source frame is reproduced within the reduction tolerance plus the quantization error
+    AnimationPose pose;
+    pose.resize(boneCount);
+    std::vector<int> binding = IdentityBinding(boneCount);
+    float maxPositionError = 0.f, maxRotationError = 0.f;
+    for (UInt32 frame = 0; frame < frameCount; ++frame) {
+        clip->sample((float) frame / animation.sampleRate, binding, pose);
+        for (UInt32 bone = 0; bone < boneCount; ++bone) {
+            const ImportAnimationTrack &track = animation.tracks[bone];
+            maxPositionError = std::max(maxPositionError, Math::length(pose.getPosition(bone) - track.positions[frame]));
+            maxRotationError = std::max(maxRotationError, AngleDegrees(pose.getRotation(bone), track.rotations[frame]));
+            EXPECT_NEAR(Math::length(pose.getRotation(bone)), 1.f, 1e-5f);
+        }
+    }
+    RecordProperty("max_position_error", std::to_string(maxPositionError));
+    RecordProperty("max_rotation_error_degrees", std::to_string(maxRotationError));
+    EXPECT_LE(maxPositionError, settings.positionError + 1e-5f);
+    EXPECT_LE(maxRotationError, settings.rotationError + 0.02f);
+
+    /// unbound curves leave their bones alone
+    pose.resize(boneCount);
+    binding.assign(boneCount, -1);
+    binding[3] = 0;
+    clip->sample(1.f, binding, pose);
+    EXPECT_NE(pose.getPosition(0), Vector3f(0.f));
+    EXPECT_EQ(pose.getPosition(1), Vector3f(0.f));
+
+    DestroyObject(clip);
+}
+
+TEST(Animation, BlendPoses) {
+    std::mt19937 rng(2);
+    const UInt32 boneCount = 7;
+    AnimationPose a, b;
+    a.resize(boneCount);
+    b.resize(boneCount);
+    for (UInt32 bone = 0; bone < boneCount; ++bone) {
+        a.setBone(bone, Vector3f((float) bone), RandomRotation(rng), Vector3f(1.f));
+        b.setBone(bone, Vector3f(-(float) bone), RandomRotation(rng), Vector3f(3.f));
+    }
+    /// the same rotation with flipped sign
+    b.setBone(0, Vector3f(0.f), -a.getRotation(0), Vector3f(1.f));
+
+    AnimationPose blended = a;
+    BlendPoses(blended, b, 0.25f);
+    for (UInt32 bone = 0; bone < boneCount; ++bone) {
+        Quaternionf qa = a.getRotation(bone), qb = b.getRotation(bone);
+        if (Math::dot(qa, qb) < 0.f) qb = -qb;
+        Quaternionf expected = Math::normalize(Quaternionf(qa.w * 0.75f + qb.w * 0.25f, qa.x * 0.75f + qb.x * 0.25f,
+                                                           qa.y * 0.75f + qb.y * 0.25f, qa.z * 0.75f + qb.z * 0.25f));
+        EXPECT_LT(AngleDegrees(blended.getRotation(bone), expected), 0.01f);
+        EXPECT_NEAR(blended.getPosition(bone).x, (float) bone * 0.5f, 1e-5f);
+    }
+    EXPECT_LT(AngleDegrees(blended.getRotation(0), a.getRotation(0)), 0.01f);
+    EXPECT_NEAR(blended.getScale(1).y, 1.5f, 1e-5f);
+
+    /// end weights are exact
+    blended = a;
+    BlendPoses(blended, b, 0.f);
+    EXPECT_EQ(blended.data, a.data);
+    BlendPoses(blended, b, 1.f);
+    EXPECT_EQ(blended.data, b.data);
+}
+
+TEST(Animation, ThousandCharacters) {
+    /// 1000 characters of 50 bones, a base layer and a half weight override layer each
+    const UInt32 characterCount = 1000, boneCount = 50;
+    AnimationClip *walk = NewObject<AnimationClip>();
+    AnimationClip *wave = NewObject<AnimationClip>();
+    ASSERT_TRUE(walk->initWithImportAnimation(WaveAnimation(boneCount, 300)));
+    ImportAnimation waveAnimation = WaveAnimation(boneCount, 90);
+    waveAnimation.tracks.resize(boneCount / 2);
+    ASSERT_TRUE(wave->initWithImportAnimation(waveAnimation));
+
+    std::vector<int> binding = IdentityBinding(boneCount);
+    std::vector<AnimationPose> poses(characterCount), layerPoses(characterCount);
+    for (UInt32 i = 0; i < characterCount; ++i) {
+        poses[i].resize(boneCount);
+        layerPoses[i].resize(boneCount);
+    }
+
+    Timer timer;
+    const int frames = 10;
+    for (int frame = 0; frame < frames; ++frame) {
+        ParallelFor(characterCount, 4, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                float time = (float) (frame + i) / 30.f;
+                walk->sample(time, binding, poses[i]);
+                layerPoses[i].data = poses[i].data;
+                wave->sample(time, binding, layerPoses[i]);
+                BlendPoses(poses[i], layerPoses[i], 0.5f);
+            }
+        });
+    }
+    float frameMs = timer.mark() * 1000.f / frames;
+
+    RecordProperty("bones", (int) (characterCount * boneCount));
+    RecordProperty("workers", (int) GetParallelWorkerCount());
+    RecordProperty("frame_ms", std::to_string(frameMs));
+
+    EXPECT_NE(poses[0].getRotation(5), poses[1].getRotation(5));
+    EXPECT_NEAR(Math::length(poses[characterCount - 1].getRotation(boneCount - 1)), 1.f, 1e-5f);
+
+    DestroyObject(walk);
+    DestroyObject(wave);
+}
@@ -0,0 +1,190 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Asset/MeshOptimizer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace AN;
+
+/// n x n quads on the xy plane facing +z, triangles shuffled
+static ImportMesh MakeGrid(UInt32 n, UInt32 seed) {
+    ImportMesh mesh{};
+    for (UInt32 y = 0; y <= n; ++y) {
+        for (UInt32 x = 0; x <= n; ++x) {
+            mesh.positions.emplace_back((float) x, (float) y, 0.f);
+            mesh.texcoords[0].emplace_back((float) x / n, (float) y / n);
+        }
+    }
+
+    std::vector<std::array<UInt32, 3>> triangles;
+    for (UInt32 y = 0; y < n; ++y) {
+        for (UInt32 x = 0; x < n; ++x) {
+            UInt32 i = y * (n + 1) + x;
+            triangles.push_back({ i, i + 1, i + n + 2 });
+            triangles.push_back({ i, i + n + 2, i + n + 1 });
+        }
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(seed));
+
+    mesh.subMeshes.resize(1);
+    for (auto &tri : triangles) {
+        mesh.subMeshes[0].indices.insert(mesh.subMeshes[0].indices.end(), tri.begin(), tri.end());
+    }
+    return mesh;
+}
+
+/// triangles as position triples starting at the smallest position, rotating a triangle keeps its winding
+static std::vector<std::array<float, 9>> GetTriangles(const ImportMesh &mesh) {
+    std::vector<std::array<float, 9>> result;
+    for (const ImportSubMesh &subMesh : mesh.subMeshes) {
+        for (size_t t = 0; t < subMesh.indices.size(); t += 3) {
+            std::array<std::array<float, 3>, 3> tri;
+            for (int k = 0; k < 3; ++k) {
+                const Vector3f &p = mesh.positions[subMesh.indices[t + k]];
+                tri[k]            = { p.x, p.y, p.z };
+            }
+            std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+
+            std::array<float, 9> value;
+            for (int k = 0; k < 9; ++k) {
+                value[k] = tri[k / 3][k % 3];
+            }
+            result.push_back(value);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+TEST(MeshOptimizer, AnalyzeVertexCache) {
+    /// two triangles sharing an edge
+    std::vector<UInt32> indices = { 0, 1, 2, 2, 1, 3 };
+    VertexCacheStatistics stats = AnalyzeVertexCache(indices);
+    EXPECT_EQ(stats.triangleCount, 2);
+    EXPECT_EQ(stats.vertexCount, 4);
+    EXPECT_EQ(stats.transformedVertexCount, 4);
+    EXPECT_FLOAT_EQ(stats.acmr, 2.f);
+    EXPECT_FLOAT_EQ(stats.atvr, 1.f);
+
+    /// a cache of 3 evicts vertex 0 before it is used again
+    indices = { 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+    EXPECT_EQ(AnalyzeVertexCache(indices, 3).transformedVertexCount, 9);
+    EXPECT_EQ(AnalyzeVertexCache(indices, 16).transformedVertexCount, 6);
+}
+
+TEST(MeshOptimizer, VertexCache) {
+    ImportMesh mesh = MakeGrid(64, 1);
+    std::vector<UInt32> &indices = mesh.subMeshes[0].indices;
+
+    VertexCacheStatistics before = AnalyzeVertexCache(indices);
+    auto trianglesBefore = GetTriangles(mesh);
+
+    std::vector<UInt32> clusters;
+    OptimizeVertexCache(indices, mesh.positions.size(), kDefaultVertexCacheSize, &clusters);
+    VertexCacheStatistics after = AnalyzeVertexCache(indices);
+
+    EXPECT_GT(before.acmr, 1.5f);
+    EXPECT_LT(after.acmr, 0.8f);
+    EXPECT_LT(after.atvr, 1.5f);
+    EXPECT_EQ(GetTriangles(mesh), trianglesBefore);
+
+    ASSERT_FALSE(clusters.empty());
+    EXPECT_EQ(clusters.front(), 0);
+    EXPECT_TRUE(std::is_sorted(clusters.begin(), clusters.end()));
+}
+
+TEST(MeshOptimizer, Overdraw) {
+    /// two walls facing outward at z = 0 and z = -1
+    ImportMesh mesh = MakeGrid(16, 2);
+    UInt32 base = mesh.positions.size();
+    for (UInt32 i = 0; i < base; ++i) {
+        mesh.positions.push_back(mesh.positions[i] - Vector3f(0.f, 0.f, 1.f));
+        mesh.texcoords[0].push_back(mesh.texcoords[0][i]);
+    }
+    std::vector<UInt32> &indices = mesh.subMeshes[0].indices;
+    size_t frontCount = indices.size();
+    for (size_t i = 0; i < frontCount; i += 3) {
+        /// the back wall faces -z
+        indices.push_back(indices[i] + base);
+        indices.push_back(indices[i + 2] + base);
+        indices.push_back(indices[i + 1] + base);
+    }
+
+    auto trianglesBefore = GetTriangles(mesh);
+
+    std::vector<UInt32> clusters;
+    OptimizeVertexCache(indices, mesh.positions.size(), kDefaultVertexCacheSize, &clusters);
+    float acmr = AnalyzeVertexCache(indices).acmr;
+
+    /// one cluster puts the back wall behind the front one, sorting must keep the set of triangles
+    OptimizeOverdraw(indices, mesh.positions, clusters, kDefaultVertexCacheSize, 1.05f);
+    EXPECT_EQ(GetTriangles(mesh), trianglesBefore);
+    EXPECT_LT(AnalyzeVertexCache(indices).acmr, acmr * 1.25f);
+
+    /// a closed box is sorted by how much a cluster faces away from the center
+    ImportMesh box{};
+    box.positions = { { -1, -1, -1 }, { 1, -1, -1 }, { 1, 1, -1 }, { -1, 1, -1 },
+                      { -1, -1, 1 }, { 1, -1, 1 }, { 1, 1, 1 }, { -1, 1, 1 },
+                      { 0, 0, 0.5f }, { 0.2f, 0, 0.5f }, { 0, 0.2f, 0.5f } };
+    std::vector<UInt32> boxIndices = { 8, 9, 10,     // small inner triangle
+                                       4, 5, 6, 4, 6, 7 }; // +z face
+    std::vector<UInt32> boxClusters = { 0, 1 };
+    OptimizeOverdraw(boxIndices, box.positions, boxClusters, kDefaultVertexCacheSize, 1.05f);
+    EXPECT_EQ(boxIndices[0], 4);
+    EXPECT_EQ(boxIndices[6], 8);
+}
+
+TEST(MeshOptimizer, VertexFetch) {
+    std::vector<UInt32> indices = { 5, 3, 1, 1, 3, 0 };
+    std::vector<UInt32> remap;
+    OptimizeVertexFetch(indices, 7, remap);
+
+    EXPECT_EQ(indices, (std::vector<UInt32>{ 0, 1, 2, 2, 1, 3 }));
+    ASSERT_EQ(remap.size(), 7);
+    EXPECT_EQ(remap[5], 0);
+    EXPECT_EQ(remap[0], 3);
+
+    /// unreferenced vertices follow in their original order
+    EXPECT_EQ(remap[2], 4);
+    EXPECT_EQ(remap[4], 5);
+    EXPECT_EQ(remap[6], 6);
+}
+
+TEST(MeshOptimizer, ImportMesh) {
+    ImportMesh mesh = MakeGrid(48, 3);
+
+    /// split into two sub meshes sharing the vertices
+    mesh.subMeshes.resize(2);
+    std::vector<UInt32> &indices = mesh.subMeshes[0].indices;
+    mesh.subMeshes[1].indices.assign(indices.begin() + indices.size() / 2, indices.end());
+    indices.resize(indices.size() / 2);
+
+    auto trianglesBefore = GetTriangles(mesh);
+
+    MeshOptimizationStats stats = OptimizeImportMesh(mesh);
+    EXPECT_LT(stats.after.acmr, stats.before.acmr * 0.5f);
+    EXPECT_EQ(stats.after.triangleCount, stats.before.triangleCount);
+    EXPECT_GE(stats.optimizeMs, 0.f);
+    EXPECT_EQ(GetTriangles(mesh), trianglesBefore);
+
+    /// vertex streams follow the remap
+    for (size_t i = 0; i < mesh.positions.size(); ++i) {
+        EXPECT_FLOAT_EQ(mesh.texcoords[0][i].x * 48.f, mesh.positions[i].x);
+    }
+
+    /// first use order after fetch optimization
+    UInt32 next = 0;
+    for (const ImportSubMesh &subMesh : mesh.subMeshes) {
+        for (UInt32 index : subMesh.indices) {
+            EXPECT_LE(index, next);
+            if (index == next) ++next;
+        }
+    }
+}
@@ -0,0 +1,205 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Geometry/MeshProcessing.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace AN;
+
+template<typename T>
+static StrideIterator<T> Iter(std::vector<T> &data) {
+    return StrideIterator<T>(data.data(), sizeof(T));
+}
+
+static IndexBufferData Indices(const std::vector<UInt32> &indices) {
+    IndexBufferData data;
+    data.indices = indices.data();
+    data.count   = (int) indices.size();
+    data.format  = kIndexFormatUInt32;
+    return data;
+}
+
+/// n x n quads on the xy plane facing +z, uv follows xy
+struct Grid {
+    std::vector<Vector3f> positions;
+    std::vector<Vector2f> uvs;
+    std::vector<UInt32>   indices;
+
+    explicit Grid(UInt32 n, float uScale = 1.f) {
+        for (UInt32 y = 0; y <= n; ++y) {
+            for (UInt32 x = 0; x <= n; ++x) {
+                positions.emplace_back((float) x, (float) y, 0.f);
+                uvs.emplace_back(uScale * x / n, (float) y / n);
+            }
+        }
+        for (UInt32 y = 0; y < n; ++y) {
+            for (UInt32 x = 0; x < n; ++x) {
+                UInt32 i = y * (n + 1) + x;
+                indices.insert(indices.end(), { i, i + 1, i + n + 2, i, i + n + 2, i + n + 1 });
+            }
+        }
+    }
+};
+
+/// unit cube with 4 vertices per face so faces do not share vertices
+struct SplitCube {
+    std::vector<Vector3f> positions;
+    std::vector<UInt32>   indices;
+
+    SplitCube() {
+        for (int axis = 0; axis < 3; ++axis) {
+            for (float side : { -1.f, 1.f }) {
+                Vector3f n(0.f), u(0.f), v(0.f);
+                n[axis]           = side;
+                u[(axis + 1) % 3] = 1.f;
+                v[(axis + 2) % 3] = side;
+                UInt32 base       = (UInt32) positions.size();
+                positions.push_back(n - u - v);
+                positions.push_back(n + u - v);
+                positions.push_back(n + u + v);
+                positions.push_back(n - u + v);
+                indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+            }
+        }
+    }
+};
+
+TEST(MeshProcessing, Bounds) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> unit(-100.f, 100.f);
+
+    std::vector<Vector3f> positions(100001);
+    Vector3f minV(FLT_MAX), maxV(-FLT_MAX);
+    for (Vector3f &p : positions) {
+        p    = Vector3f(unit(rng), unit(rng), unit(rng));
+        minV = Math::min(minV, p);
+        maxV = Math::max(maxV, p);
+    }
+
+    AABB bounds = CalculateBounds(Iter(positions), positions.size());
+    EXPECT_EQ(bounds.getMin(), minV);
+    EXPECT_EQ(bounds.getMax(), maxV);
+
+    /// the last vertex alone
+    bounds = CalculateBounds(Iter(positions) + (positions.size() - 1), 1);
+    EXPECT_EQ(bounds.center, positions.back());
+
+    EXPECT_TRUE(CalculateBounds(Iter(positions), 0).isEmpty());
+}
+
+TEST(MeshProcessing, SmoothAndFlatNormals) {
+    SplitCube cube;
+    std::vector<Vector3f> normals(cube.positions.size());
+
+    /// corners are welded by position, the split faces all point away from the corner
+    CalculateNormals(Iter(cube.positions), cube.positions.size(), Indices(cube.indices), Iter(normals));
+    for (size_t i = 0; i < normals.size(); ++i) {
+        EXPECT_GT(Math::dot(normals[i], Math::normalize(cube.positions[i])), 0.9f);
+        for (int c = 0; c < 3; ++c) {
+            EXPECT_GT(normals[i][c] * cube.positions[i][c], 0.f);
+        }
+    }
+
+    /// welded vertices get the same normal
+    for (size_t i = 0; i < normals.size(); ++i) {
+        for (size_t j = i + 1; j < normals.size(); ++j) {
+            if (cube.positions[i] == cube.positions[j]) {
+                EXPECT_EQ(normals[i], normals[j]);
+            }
+        }
+    }
+
+    /// faces meet at 90 degrees
+    CalculateNormals(Iter(cube.positions), cube.positions.size(), Indices(cube.indices), Iter(normals), 60.f);
+    for (size_t i = 0; i < normals.size(); ++i) {
+        Vector3f faceNormal(0.f);
+        faceNormal[i / 8] = (i / 4) % 2 ? 1.f : -1.f;
+        EXPECT_GT(Math::dot(normals[i], faceNormal), 0.999f);
+    }
+}
+
+TEST(MeshProcessing, Tangents) {
+    Grid grid(4);
+    std::vector<Vector3f> normals(grid.positions.size());
+    std::vector<Vector4f> tangents(grid.positions.size());
+    CalculateNormals(Iter(grid.positions), grid.positions.size(), Indices(grid.indices), Iter(normals));
+    CalculateTangents(Iter(grid.positions), Iter(normals), Iter(grid.uvs), grid.positions.size(),
+                      Indices(grid.indices), Iter(tangents));
+
+    for (size_t i = 0; i < tangents.size(); ++i) {
+        EXPECT_GT(Math::dot(normals[i], Vector3f(0.f, 0.f, 1.f)), 0.999f);
+        EXPECT_GT(Math::dot(Vector3f(tangents[i]), Vector3f(1.f, 0.f, 0.f)), 0.999f);
+        EXPECT_EQ(tangents[i].w, 1.f);
+    }
+
+    /// mirrored u flips the tangent and the bitangent sign, the bitangent still points along +v
+    Grid mirrored(4, -1.f);
+    CalculateTangents(Iter(mirrored.positions), Iter(normals), Iter(mirrored.uvs), mirrored.positions.size(),
+                      Indices(mirrored.indices), Iter(tangents));
+    for (size_t i = 0; i < tangents.size(); ++i) {
+        EXPECT_GT(Math::dot(Vector3f(tangents[i]), Vector3f(-1.f, 0.f, 0.f)), 0.999f);
+        EXPECT_EQ(tangents[i].w, -1.f);
+        Vector3f bitangent = tangents[i].w * Math::cross(normals[i], Vector3f(tangents[i]));
+        EXPECT_GT(Math::dot(bitangent, Vector3f(0.f, 1.f, 0.f)), 0.999f);
+    }
+}
+
+TEST(MeshProcessing, UVDistributionMetric) {
+    /// 4x4 world units mapped to 1x1 and 2x1 of uv space
+    Grid grid(4), tiled(4, 2.f);
+    EXPECT_NEAR(CalculateUVDistributionMetric(Iter(grid.positions), Iter(grid.uvs), Indices(grid.indices)), 16.f, 1e-4f);
+    EXPECT_NEAR(CalculateUVDistributionMetric(Iter(tiled.positions), Iter(tiled.uvs), Indices(tiled.indices)), 8.f, 1e-4f);
+
+    std::vector<Vector2f> flat(grid.uvs.size(), Vector2f(0.5f, 0.5f));
+    EXPECT_EQ(CalculateUVDistributionMetric(Iter(grid.positions), Iter(flat), Indices(grid.indices)), 0.f);
+}
+
+TEST(MeshProcessing, UInt16Indices) {
+    Grid grid(2);
+    std::vector<UInt16> indices(grid.indices.begin(), grid.indices.end());
+
+    IndexBufferData data;
+    data.indices = indices.data();
+    data.count   = (int) indices.size();
+    data.format  = kIndexFormatUInt16;
+
+    std::vector<Vector3f> normals(grid.positions.size());
+    CalculateNormals(Iter(grid.positions), grid.positions.size(), data, Iter(normals), 0.f);
+    for (const Vector3f &normal : normals) {
+        EXPECT_GT(normal.z, 0.999f);
+    }
+}
+
+TEST(MeshProcessing, LargeMesh) {
+    /// 2M triangles
+    Grid grid(1024);
+    size_t vertexCount = grid.positions.size();
+    std::vector<Vector3f> normals(vertexCount);
+    std::vector<Vector4f> tangents(vertexCount);
+
+    Timer timer;
+    AABB bounds = CalculateBounds(Iter(grid.positions), vertexCount);
+    float boundsMs = timer.mark() * 1000.f;
+    CalculateNormals(Iter(grid.positions), vertexCount, Indices(grid.indices), Iter(normals));
+    float normalsMs = timer.mark() * 1000.f;
+    CalculateTangents(Iter(grid.positions), Iter(normals), Iter(grid.uvs), vertexCount,
+                      Indices(grid.indices), Iter(tangents));
+    float tangentsMs = timer.mark() * 1000.f;
+
+    RecordProperty("triangles", (int) (grid.indices.size() / 3));
+    RecordProperty("bounds_ms", std::to_string(boundsMs));
+    RecordProperty("normals_ms", std::to_string(normalsMs));
+    RecordProperty("tangents_ms", std::to_string(tangentsMs));
+
+    EXPECT_EQ(bounds.getMax(), Vector3f(1024.f, 1024.f, 0.f));
+    for (size_t i = 0; i < vertexCount; i += 997) {
+        EXPECT_GT(normals[i].z, 0.999f);
+        EXPECT_GT(tangents[i].x, 0.999f);
+    }
+}
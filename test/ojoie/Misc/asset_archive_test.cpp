@@ -0,0 +1,230 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Misc/AssetArchive.hpp>
+#include <ojoie/Utility/Compression.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace AN;
+
+namespace {
+
+std::vector<UInt8> MakeAssetText(UInt32 seed, size_t size) {
+    std::mt19937       random(seed);
+    std::string        text = "%YAML 1.1\n%TAG !AN! tag:an.com,2023:\n";
+    while (text.size() < size) {
+        text += "--- !AN!Material &" + std::to_string(random() % 100000) + "\nMaterial:\n  m_Name: Prop_" +
+                std::to_string(random() % 1000) + "\n  m_Color: {r: " + std::to_string(random() % 256) +
+                ", g: " + std::to_string(random() % 256) + ", b: 1}\n";
+    }
+    text.resize(size);
+    return { text.begin(), text.end() };
+}
+
+std::vector<UInt8> MakeNoise(UInt32 seed, size_t size) {
+    std::mt19937       random(seed);
+    std::vector<UInt8> data(size);
+    for (UInt8 &byte : data) byte = (UInt8) random();
+    return data;
+}
+
+bool RoundTrips(const std::vector<UInt8> &data) {
+    std::vector<UInt8> compressed(LZ4CompressBound(data.size()));
+    size_t             size = LZ4Compress(data.data(), data.size(), compressed.data(), compressed.size());
+    if (size == 0) return false;
+
+    std::vector<UInt8> decompressed(data.size());
+    return LZ4Decompress(compressed.data(), size, decompressed.data(), decompressed.size()) && decompressed == data;
+}
+
+struct TempDirectory {
+    std::filesystem::path path;
+
+    explicit TempDirectory(const char *name) : path(std::filesystem::temp_directory_path() / name) {
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+    }
+
+    ~TempDirectory() { std::filesystem::remove_all(path); }
+};
+
+}
+
+TEST(Compression, LZ4RoundTrips) {
+    for (size_t size = 0; size < 40; ++size) {
+        EXPECT_TRUE(RoundTrips(MakeAssetText((UInt32) size, size))) << size;
+    }
+    EXPECT_TRUE(RoundTrips(MakeAssetText(1, 200000)));
+    EXPECT_TRUE(RoundTrips(MakeNoise(2, 100000)));
+    /// long runs decode as overlapping matches
+    EXPECT_TRUE(RoundTrips(std::vector<UInt8>(100000, 'a')));
+
+    std::vector<UInt8> text = MakeAssetText(3, 65536);
+    std::vector<UInt8> compressed(LZ4CompressBound(text.size()));
+    size_t             size = LZ4Compress(text.data(), text.size(), compressed.data(), compressed.size());
+    EXPECT_LT(size, text.size() / 2);
+    EXPECT_EQ(LZ4Compress(text.data(), text.size(), compressed.data(), 16), 0U);
+
+    /// truncated or wrongly sized input is rejected, not read past
+    std::vector<UInt8> output(text.size());
+    EXPECT_FALSE(LZ4Decompress(compressed.data(), size - 1, output.data(), output.size()));
+    EXPECT_FALSE(LZ4Decompress(compressed.data(), size, output.data(), output.size() - 1));
+    compressed[size / 2] ^= 0xFF;
+    LZ4Decompress(compressed.data(), size, output.data(), output.size());
+}
+
+TEST(AssetArchive, ReadsWhatWasWritten) {
+    TempDirectory directory("ojoie_asset_archive_test");
+    std::string   archivePath = (directory.path / "Data.anpak").string();
+
+    std::vector<UInt8> text  = MakeAssetText(4, 300000);
+    std::vector<UInt8> noise = MakeNoise(5, 5000);
+    std::vector<UInt8> meta  = MakeAssetText(6, 100);
+
+    AssetArchiveWriter writer(16 * 1024);
+    writer.add("Data/Assets/Level.asset", text);
+    writer.add("Data\\Assets\\Level.asset.meta", meta);
+    writer.add("Data/Assets/Noise.bytes", noise);
+    writer.add("Data/Assets/Stored.bytes", text, false);
+    writer.add("Data/Assets/Empty.asset", {});
+    writer.add("./Data/Assets/Noise.bytes", noise);
+    EXPECT_EQ(writer.getEntryCount(), 5U);
+
+    UInt64 archiveSize;
+    ASSERT_TRUE(writer.write(archivePath.c_str(), &archiveSize));
+    EXPECT_LT(archiveSize, text.size() + text.size() / 2 + noise.size());
+
+    AssetArchive archive;
+    ASSERT_TRUE(archive.open(archivePath.c_str(), "C:/Game"));
+    EXPECT_EQ(archive.getEntryCount(), 5U);
+
+    int level = archive.find("Data/Assets/Level.asset");
+    ASSERT_GE(level, 0);
+    EXPECT_TRUE(archive.isCompressed(level));
+    EXPECT_EQ(archive.getData(level), nullptr);
+    std::string levelText;
+    ASSERT_TRUE(archive.readText(level, levelText));
+    EXPECT_EQ(levelText, std::string(text.begin(), text.end()));
+
+    /// paths under the root, any case and slash direction
+    EXPECT_EQ(archive.find("c:\\game\\DATA\\Assets\\level.asset"), level);
+    EXPECT_EQ(archive.find("./Data/Assets/Level.asset"), level);
+    EXPECT_GE(archive.find("C:/Game/Data/Assets/Level.asset.meta"), 0);
+    EXPECT_EQ(archive.find("Data/Assets/Level"), -1);
+    EXPECT_EQ(archive.find("D:/Game/Data/Assets/Level.asset"), -1);
+
+    /// incompressible and stored entries are read in place
+    for (const char *path : { "Data/Assets/Noise.bytes", "Data/Assets/Stored.bytes" }) {
+        int index = archive.find(path);
+        ASSERT_GE(index, 0) << path;
+        EXPECT_FALSE(archive.isCompressed(index));
+        const UInt8 *data = archive.getData(index);
+        ASSERT_NE(data, nullptr);
+        EXPECT_EQ((uintptr_t) data % kAssetArchiveAlignment, 0U);
+        const std::vector<UInt8> &expected = index == archive.find("Data/Assets/Noise.bytes") ? noise : text;
+        ASSERT_EQ(archive.getSize(index), expected.size());
+        EXPECT_EQ(memcmp(data, expected.data(), expected.size()), 0);
+
+        std::string      buffer;
+        std::string_view view;
+        ASSERT_TRUE(archive.readView(index, buffer, view));
+        EXPECT_EQ((const UInt8 *) view.data(), data);
+        EXPECT_TRUE(buffer.empty());
+    }
+
+    /// a compressed entry is viewed in the buffer it is decompressed into
+    std::string      levelBuffer;
+    std::string_view levelView;
+    ASSERT_TRUE(archive.readView(level, levelBuffer, levelView));
+    EXPECT_EQ(levelView.data(), levelBuffer.data());
+    EXPECT_EQ(levelView, levelText);
+
+    int empty = archive.find("Data/Assets/Empty.asset");
+    ASSERT_GE(empty, 0);
+    std::string emptyText = "x";
+    EXPECT_TRUE(archive.readText(empty, emptyText));
+    EXPECT_TRUE(emptyText.empty());
+
+    archive.close();
+    EXPECT_EQ(archive.find("Data/Assets/Level.asset"), -1);
+
+    std::ofstream((directory.path / "Bad.anpak").string(), std::ios::binary) << "not an archive at all, not even close";
+    EXPECT_FALSE(archive.open((directory.path / "Bad.anpak").string().c_str()));
+}
+
+TEST(AssetArchive, StartupBenchmark) {
+    const UInt32  count = 10000;
+    TempDirectory directory("ojoie_asset_archive_benchmark");
+    std::filesystem::path assetRoot = directory.path / "Data" / "Assets";
+
+    AssetArchiveWriter writer;
+    size_t             looseBytes = 0;
+    for (UInt32 i = 0; i < count; ++i) {
+        std::string           folderName = "Folder" + std::to_string(i % 50);
+        std::filesystem::path folder     = assetRoot / folderName;
+        if (i < 50) std::filesystem::create_directories(folder);
+
+        std::string        name  = "Prop_" + std::to_string(i) + ".asset";
+        std::vector<UInt8> asset = MakeAssetText(i, 1024 + i % 4096);
+        std::vector<UInt8> meta  = MakeAssetText(i + count, 96);
+        std::ofstream((folder / name).string(), std::ios::binary).write((const char *) asset.data(), asset.size());
+        std::ofstream((folder / (name + ".meta")).string(), std::ios::binary).write((const char *) meta.data(), meta.size());
+        looseBytes += asset.size() + meta.size();
+
+        std::string relative = "Data/Assets/" + folderName + "/" + name;
+        writer.add(relative, std::move(asset));
+        writer.add(relative + ".meta", std::move(meta));
+    }
+
+    std::string archivePath = (directory.path / "Data.anpak").string();
+    UInt64      archiveSize;
+    ASSERT_TRUE(writer.write(archivePath.c_str(), &archiveSize));
+
+    /// both read from the page cache, what is left is the walk, the opens and the copies
+    Timer       timer;
+    size_t      looseRead = 0;
+    std::string text;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator{ assetRoot }) {
+        if (!entry.is_regular_file()) continue;
+        std::ifstream file(entry.path(), std::ios::binary);
+        text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        looseRead += text.size();
+    }
+    float looseSeconds = timer.mark();
+
+    AssetArchive archive;
+    ASSERT_TRUE(archive.open(archivePath.c_str(), directory.path.string()));
+    size_t archiveRead = 0;
+    for (UInt32 i = 0; i < count; ++i) {
+        std::string path  = (directory.path / "Data" / "Assets" / ("Folder" + std::to_string(i % 50)) /
+                             ("Prop_" + std::to_string(i) + ".asset")).string();
+        int         index = archive.find(path);
+        ASSERT_GE(index, 0);
+        ASSERT_TRUE(archive.readText(index, text));
+        archiveRead += text.size();
+        index = archive.find(path + ".meta");
+        ASSERT_GE(index, 0);
+        ASSERT_TRUE(archive.readText(index, text));
+        archiveRead += text.size();
+    }
+    float archiveSeconds = timer.mark();
+
+    EXPECT_EQ(looseRead, looseBytes);
+    EXPECT_EQ(archiveRead, looseBytes);
+    EXPECT_LT(archiveSize, looseBytes);
+
+    RecordProperty("loose_bytes", std::to_string(looseBytes));
+    RecordProperty("archive_bytes", std::to_string(archiveSize));
+    RecordProperty("loose_startup_ms", std::to_string(looseSeconds * 1000.f));
+    RecordProperty("archive_startup_ms", std::to_string(archiveSeconds * 1000.f));
+    EXPECT_LT(archiveSeconds, looseSeconds);
+}
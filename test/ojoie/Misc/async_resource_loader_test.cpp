@@ -0,0 +1,231 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Misc/AsyncResourceLoader.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace AN;
+
+static void Spin(float seconds) {
+    Timer timer;
+    while (timer.peek() < seconds) {}
+}
+
+struct FakeAsset {
+    std::vector<std::string> dependencies;
+    UInt32                   steps     = 1;
+    bool                     bReadable = true;
+};
+
+/// assets described in memory, the finalize steps spin for stepSeconds
+class FakeBackend : public ResourceLoadBackend {
+public:
+    std::unordered_map<std::string, FakeAsset> assets; // not changed while loading
+    std::unordered_set<std::string>            loaded;
+    std::vector<std::string>                   finalized;
+    std::atomic<UInt32>                        decodedCount{};
+    float                                      stepSeconds = 0.f;
+
+    virtual std::unique_ptr<ResourceLoadJob> createJob(const std::string &path) override;
+
+    virtual bool isLoaded(const std::string &path) override {
+        return loaded.contains(path);
+    }
+};
+
+class FakeJob : public ResourceLoadJob {
+    FakeBackend     *_backend;
+    std::string      _path;
+    const FakeAsset &_asset;
+    UInt32           _step;
+
+public:
+    FakeJob(FakeBackend *backend, std::string path, const FakeAsset &asset)
+        : _backend(backend), _path(std::move(path)), _asset(asset), _step() {}
+
+    virtual bool read() override {
+        return _asset.bReadable;
+    }
+
+    virtual bool decode(std::vector<std::string> &outDependencies) override {
+        outDependencies = _asset.dependencies;
+        ++_backend->decodedCount;
+        return true;
+    }
+
+    virtual ResourceLoadStep finalizeStep() override {
+        Spin(_backend->stepSeconds);
+        if (++_step < _asset.steps) return kResourceLoadStepMore;
+        _backend->loaded.insert(_path);
+        _backend->finalized.push_back(_path);
+        return kResourceLoadStepDone;
+    }
+
+    virtual float getFinalizeProgress() const override {
+        return (float) _step / (float) _asset.steps;
+    }
+};
+
+std::unique_ptr<ResourceLoadJob> FakeBackend::createJob(const std::string &path) {
+    auto it = assets.find(path);
+    if (it == assets.end()) return nullptr;
+    return std::make_unique<FakeJob>(this, path, it->second);
+}
+
+static size_t IndexOf(const std::vector<std::string> &order, const std::string &path) {
+    return std::find(order.begin(), order.end(), path) - order.begin();
+}
+
+TEST(AsyncResourceLoader, DependenciesFinalizeFirst) {
+    FakeBackend backend;
+    backend.assets["Level"]    = { { "Material", "Mesh" }, 3 };
+    backend.assets["Material"] = { { "Shader", "Texture" }, 2 };
+    backend.assets["Mesh"]     = { {}, 1 };
+    backend.assets["Shader"]   = { {}, 1 };
+    backend.assets["Texture"]  = { { "Missing", "Broken" }, 1 };
+    backend.assets["Broken"]   = { {}, 1, false };
+    backend.assets["A"]        = { { "B" }, 1 };
+    backend.assets["B"]        = { { "A" }, 1 };
+
+    AsyncResourceLoader loader(&backend, 2);
+
+    std::vector<std::pair<std::string, bool>> completed;
+    std::vector<float>                        progress;
+    AsyncResourceLoadOptions                  options;
+    options.progress = [&](float value) { progress.push_back(value); };
+
+    ResourceLoadID level = loader.load("Level", options, [&](bool bSucceeded) { completed.emplace_back("Level", bSucceeded); });
+    ResourceLoadID again = loader.load("Level", {}, [&](bool bSucceeded) { completed.emplace_back("Level again", bSucceeded); });
+    EXPECT_EQ(level, again);
+    loader.load("Missing", {}, [&](bool bSucceeded) { completed.emplace_back("Missing", bSucceeded); });
+    loader.load("A", {}, [&](bool bSucceeded) { completed.emplace_back("A", bSucceeded); });
+
+    loader.flush();
+    EXPECT_EQ(loader.getPendingCount(), 0U);
+    EXPECT_FLOAT_EQ(loader.getProgress(level), 1.f);
+
+    const std::vector<std::string> &order = backend.finalized;
+    ASSERT_EQ(order.size(), 7U);
+    EXPECT_LT(IndexOf(order, "Shader"), IndexOf(order, "Material"));
+    EXPECT_LT(IndexOf(order, "Texture"), IndexOf(order, "Material"));
+    EXPECT_LT(IndexOf(order, "Material"), IndexOf(order, "Level"));
+    EXPECT_LT(IndexOf(order, "Mesh"), IndexOf(order, "Level"));
+    /// the cycle is broken where it closes
+    EXPECT_LT(IndexOf(order, "B"), IndexOf(order, "A"));
+
+    ASSERT_EQ(completed.size(), 4U);
+    for (auto &[name, bSucceeded] : completed) {
+        EXPECT_EQ(bSucceeded, name != "Missing") << name;
+    }
+    EXPECT_EQ(IndexOf(order, "Broken"), order.size());
+
+    ASSERT_FALSE(progress.empty());
+    EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+    EXPECT_FLOAT_EQ(progress.back(), 1.f);
+
+    /// a loaded dependency is not loaded again
+    backend.finalized.clear();
+    loader.load("Material", {}, {});
+    loader.flush();
+    EXPECT_EQ(backend.finalized, std::vector<std::string>{ "Material" });
+}
+
+TEST(AsyncResourceLoader, PriorityOrder) {
+    /// a step outlasts the budget so each update finalizes once
+    FakeBackend backend;
+    backend.stepSeconds = 0.002f;
+    for (UInt32 i = 0; i < 16; ++i) {
+        backend.assets["Asset" + std::to_string(i)] = { {}, 1 };
+    }
+    backend.assets["Urgent"]    = { { "UrgentDep" }, 1 };
+    backend.assets["UrgentDep"] = { {}, 1 };
+
+    AsyncResourceLoader         loader(&backend, 1);
+    std::vector<ResourceLoadID> ids;
+    for (UInt32 i = 0; i < 16; ++i) {
+        ids.push_back(loader.load(("Asset" + std::to_string(i)).c_str(), { (int) i % 4 }, {}));
+    }
+    loader.load("Urgent", {}, {});
+
+    /// everything decoded, the dependency starts in the first update
+    while (backend.decodedCount < 17) std::this_thread::yield();
+    loader.update(0.001f);
+    EXPECT_TRUE(loader.setPriority(ids[0], 10));
+    while (backend.decodedCount < 18) std::this_thread::yield();
+
+    loader.update(0.001f);
+    loader.update(0.001f);
+    ASSERT_EQ(backend.finalized.size(), 3U);
+    /// the first update finalized the oldest of priority 3
+    EXPECT_EQ(backend.finalized[0], "Asset3");
+    EXPECT_EQ(backend.finalized[1], "Asset0");
+
+    loader.flush();
+    EXPECT_LT(IndexOf(backend.finalized, "UrgentDep"), IndexOf(backend.finalized, "Urgent"));
+    EXPECT_FALSE(loader.setPriority(ids[0], 0));
+}
+
+TEST(AsyncResourceLoader, HitchFreeLargeAssetSet) {
+    const UInt32 assetCount = 3000;
+    const float  budget     = 0.002f;
+
+    /// every asset references up to three older ones, a shared tail of textures and shaders
+    FakeBackend backend;
+    backend.stepSeconds = 0.0001f;
+    for (UInt32 i = 0; i < assetCount; ++i) {
+        FakeAsset asset;
+        asset.steps = 1 + i % 4;
+        for (UInt32 k = 1; k <= 3 && i >= k * 7; ++k) {
+            asset.dependencies.push_back("Asset" + std::to_string(i - k * 7 + k));
+        }
+        backend.assets["Asset" + std::to_string(i)] = std::move(asset);
+    }
+
+    AsyncResourceLoader loader(&backend);
+    UInt32              completed = 0;
+    Timer               total;
+    for (UInt32 i = assetCount; i-- > 0;) {
+        loader.load(("Asset" + std::to_string(i)).c_str(), {}, [&](bool bSucceeded) { completed += bSucceeded; });
+    }
+
+    std::vector<float> updates;
+    while (loader.getPendingCount()) {
+        Timer frame;
+        loader.update(budget);
+        updates.push_back(frame.peek());
+        Spin(0.001f); // the rest of the frame
+    }
+    float seconds = total.peek();
+    std::sort(updates.begin(), updates.end());
+    float p99 = updates[updates.size() * 99 / 100];
+
+    EXPECT_EQ(completed, assetCount);
+    ASSERT_EQ(backend.finalized.size(), assetCount);
+    std::unordered_map<std::string, size_t> position;
+    for (size_t i = 0; i < backend.finalized.size(); ++i) {
+        position[backend.finalized[i]] = i;
+    }
+    for (auto &[path, asset] : backend.assets) {
+        for (const std::string &dependency : asset.dependencies) {
+            EXPECT_LT(position[dependency], position[path]) << path;
+        }
+    }
+
+    RecordProperty("p99_update_ms", std::to_string(p99 * 1000.f));
+    RecordProperty("max_update_ms", std::to_string(updates.back() * 1000.f));
+    RecordProperty("frames", std::to_string(updates.size()));
+    RecordProperty("assets_per_second", std::to_string((float) assetCount / seconds));
+    /// one step may start just before the budget ends, the loader threads may preempt the odd frame
+    EXPECT_LT(p99, budget + backend.stepSeconds + 0.001f);
+    EXPECT_GT(updates.size(), 100U);
+}
@@ -0,0 +1,203 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Animation/AnimationClip.hpp>
+#include <ojoie/Animation/Animator.hpp>
+#include <ojoie/Core/Actor.hpp>
+#include <ojoie/Misc/AssetArchive.hpp>
+#include <ojoie/Misc/ResourceManager.hpp>
+#include <ojoie/Serialize/SerializeManager.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace AN;
+
+namespace fs = std::filesystem;
+
+/// a clip of frameCount frames saved at directory/name.asset with its meta
+static std::string SaveClip(const fs::path &directory, const char *name, UInt32 frameCount = 4) {
+    ImportAnimation animation;
+    animation.name       = name;
+    animation.sampleRate = 30.f;
+    animation.frameCount = frameCount;
+    ImportAnimationTrack &track = animation.tracks.emplace_back();
+    track.boneName = "Bone";
+    for (UInt32 frame = 0; frame < animation.frameCount; ++frame) {
+        track.positions.emplace_back((float) frame, 0.f, 0.f);
+        track.rotations.push_back(Math::identity<Quaternionf>());
+        track.scales.emplace_back(1.f);
+    }
+
+    AnimationClip *clip = NewObject<AnimationClip>();
+    EXPECT_TRUE(clip->initWithImportAnimation(animation));
+    std::string path = (directory / (std::string(name) + ".asset")).string();
+    EXPECT_TRUE(GetSerializeManager().SerializeObjectAtPath(clip, path.c_str()));
+    return path;
+}
+
+static std::vector<UInt8> ReadBytes(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+/// clips are resources which need no graphics device, animators hold them by raw pointer
+class ResourceManagerResidencyTest : public ::testing::Test {
+protected:
+    fs::path directory;
+
+    void SetUp() override {
+        directory = fs::temp_directory_path() / ("ojoie_residency_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove_all(directory);
+        fs::create_directories(directory);
+        GetResourceManager().setReloadEvicted(false);
+    }
+
+    void TearDown() override {
+        GetResourceManager().setResidencyBudget(0);
+        GetResourceManager().setReloadEvicted(true);
+        fs::remove_all(directory);
+    }
+
+    std::string saveClip(const char *name) {
+        return SaveClip(directory, name);
+    }
+};
+
+TEST_F(ResourceManagerResidencyTest, KeepsResourcesLiveObjectsReference) {
+    ResourceManager &resourceManager = GetResourceManager();
+
+    std::string playedPath = saveClip("Played");
+    std::string handlePath = saveClip("Handle");
+    std::string unusedPath = saveClip("Unused");
+
+    auto *played = (AnimationClip *) resourceManager.loadResourceAtPath(playedPath.c_str());
+    auto *handled = (AnimationClip *) resourceManager.loadResourceAtPath(handlePath.c_str());
+    ASSERT_NE(played, nullptr);
+    ASSERT_NE(handled, nullptr);
+    ASSERT_NE(resourceManager.loadResourceAtPath(unusedPath.c_str()), nullptr);
+
+    /// the animator points to the clip without a handle
+    Actor *actor = NewObject<Actor>();
+    actor->init("Animated");
+    Animator *animator = actor->addComponent<Animator>();
+    animator->setClip(played);
+
+    ResourceHandle<AnimationClip> handle(handled);
+
+    UInt32 evictions = resourceManager.getMemoryStats().evictions;
+    resourceManager.setResidencyBudget(1);
+    resourceManager.updateResidency();
+
+    EXPECT_EQ(resourceManager.getMemoryStats().evictions, evictions + 1);
+    EXPECT_EQ(resourceManager.getResourceAtPath(unusedPath.c_str()), nullptr);
+    EXPECT_EQ(resourceManager.getResourceAtPath(playedPath.c_str()), played);
+    EXPECT_EQ(resourceManager.getResourceAtPath(handlePath.c_str()), handled);
+
+    /// still referenced over several frames
+    resourceManager.updateResidency();
+    EXPECT_EQ(resourceManager.getResourceAtPath(playedPath.c_str()), played);
+
+    /// once the animator is gone only the handle keeps its clip
+    DestroyActor(actor);
+    resourceManager.updateResidency();
+    EXPECT_EQ(resourceManager.getResourceAtPath(playedPath.c_str()), nullptr);
+    EXPECT_EQ(resourceManager.getResourceAtPath(handlePath.c_str()), handled);
+
+    handle.reset();
+    resourceManager.updateResidency();
+    EXPECT_EQ(resourceManager.getResourceAtPath(handlePath.c_str()), nullptr);
+    EXPECT_EQ(resourceManager.getMemoryStats().evictions, evictions + 3);
+}
+
+TEST_F(ResourceManagerResidencyTest, BacksOffWhileEverythingIsReferenced) {
+    ResourceManager &resourceManager = GetResourceManager();
+
+    std::string firstPath  = saveClip("First");
+    std::string secondPath = saveClip("Second");
+
+    auto *first  = (AnimationClip *) resourceManager.loadResourceAtPath(firstPath.c_str());
+    auto *second = (AnimationClip *) resourceManager.loadResourceAtPath(secondPath.c_str());
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+
+    Actor *actor = NewObject<Actor>();
+    actor->init("Animated");
+    Animator *animator = actor->addComponent<Animator>();
+    animator->setClip(second);
+
+    Actor *otherActor = NewObject<Actor>();
+    otherActor->init("OtherAnimated");
+    otherActor->addComponent<Animator>()->setClip(first);
+
+    /// over budget but nothing can go, the scan backs off
+    resourceManager.setResidencyBudget(1);
+    resourceManager.updateResidency();
+    EXPECT_EQ(resourceManager.getResourceAtPath(secondPath.c_str()), second);
+
+    /// a reference changed in place is only seen once the backoff ends
+    animator->setClip(first);
+    resourceManager.updateResidency();
+    EXPECT_EQ(resourceManager.getResourceAtPath(secondPath.c_str()), second);
+    resourceManager.updateResidency();
+    EXPECT_EQ(resourceManager.getResourceAtPath(secondPath.c_str()), nullptr);
+    EXPECT_EQ(resourceManager.getResourceAtPath(firstPath.c_str()), first);
+
+    DestroyActor(otherActor);
+    DestroyActor(actor);
+}
+
+TEST(ResourceManager, LoadsFromMountedArchive) {
+    ResourceManager &resourceManager = GetResourceManager();
+
+    /// the archive stays mapped while mounted, so the directory is only cleaned before
+    fs::path        directory = fs::temp_directory_path() / "ojoie_mounted_archive";
+    fs::path        assets    = directory / "Data" / "Assets";
+    std::error_code error;
+    fs::remove_all(directory, error);
+    fs::create_directories(assets);
+
+    std::string clipPath = SaveClip(assets, "Walk", 6);
+
+    /// the asset is stored for reading in place, the meta is compressed
+    AssetArchiveWriter writer;
+    writer.add("Data/Assets/Walk.asset", ReadBytes(clipPath), false);
+    writer.add("Data/Assets/Walk.asset.meta", ReadBytes(clipPath + ".meta"));
+    std::string archivePath = (directory / "Data.anpak").string();
+    ASSERT_TRUE(writer.write(archivePath.c_str()));
+
+    /// nothing loose is left to fall back to
+    fs::remove(clipPath);
+    fs::remove(clipPath + ".meta");
+    ASSERT_TRUE(resourceManager.mountArchive(archivePath.c_str(), directory.string().c_str()));
+
+    std::string      buffer;
+    std::string_view text;
+    ASSERT_TRUE(resourceManager.readArchivedFile(clipPath.c_str(), buffer, text));
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_TRUE(text.starts_with("%YAML"));
+    ASSERT_TRUE(resourceManager.readArchivedFile((clipPath + ".meta").c_str(), buffer, text));
+    EXPECT_FALSE(buffer.empty());
+
+    auto *clip = (AnimationClip *) resourceManager.loadResourceAtPath(clipPath.c_str());
+    ASSERT_NE(clip, nullptr);
+    EXPECT_EQ(clip->getFrameCount(), 6U);
+
+    /// by name, resolved from the archive entries under the search path
+    auto *named = (AnimationClip *) resourceManager.loadResource("AnimationClip", "Walk", assets.string().c_str());
+    ASSERT_NE(named, nullptr);
+    EXPECT_NE(named, clip);
+    EXPECT_EQ(named->getFrameCount(), 6U);
+    EXPECT_EQ(resourceManager.getResource<AnimationClip>("Walk"), named);
+
+    EXPECT_EQ(resourceManager.loadResource("AnimationClip", "Run", assets.string().c_str()), nullptr);
+    EXPECT_EQ(resourceManager.loadResource("Material", "Walk", assets.string().c_str()), nullptr);
+    EXPECT_EQ(resourceManager.loadResource("AnimationClip", "Walk", (directory / "Other").string().c_str()), nullptr);
+
+    resourceManager.unloadResource(named);
+    resourceManager.unloadResource(clip);
+}
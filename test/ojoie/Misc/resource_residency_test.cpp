@@ -0,0 +1,142 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Math/LRUCache.hpp>
+#include <ojoie/Misc/ResourceResidency.hpp>
+
+#include <vector>
+
+using namespace AN;
+
+namespace {
+
+constexpr int kTextureClass = 1;
+constexpr int kMeshClass    = 2;
+
+struct CopyCounter {
+    static inline int copies = 0;
+
+    int value;
+
+    explicit CopyCounter(int value) : value(value) {}
+    CopyCounter(const CopyCounter &other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter &&other) noexcept : value(other.value) {}
+    CopyCounter &operator = (const CopyCounter &other) { value = other.value; ++copies; return *this; }
+    CopyCounter &operator = (CopyCounter &&other) noexcept { value = other.value; return *this; }
+};
+
+}
+
+TEST(LRUCache, TouchesWithoutCopying) {
+    LRUCache<int, CopyCounter> cache;
+    CopyCounter::copies = 0;
+    for (int i = 0; i < 4; ++i) {
+        cache.set(i, CopyCounter(i * 10));
+    }
+
+    ASSERT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(cache.find(1)->value, 10);
+    cache.set(2, CopyCounter(25));
+    EXPECT_EQ(cache.peek(0)->value, 0);
+    EXPECT_EQ(CopyCounter::copies, 0);
+
+    std::vector<int> order;
+    for (const auto &[key, value] : cache.mapLRUView()) {
+        order.push_back(key);
+    }
+    EXPECT_EQ(order, (std::vector<int>{ 0, 3, 1, 2 }));
+    EXPECT_EQ(cache.leastRecent()->first, 0);
+
+    EXPECT_TRUE(cache.erase(0));
+    EXPECT_FALSE(cache.erase(0));
+    EXPECT_EQ(cache.leastRecent()->first, 3);
+    EXPECT_EQ(cache.size(), 3U);
+}
+
+TEST(ResourceResidency, ReferencedResourcesStayResident) {
+    ResourceResidency residency;
+    residency.setBudget(100);
+
+    residency.add(1, kTextureClass, 80);
+    residency.add(2, kTextureClass, 80);
+    EXPECT_TRUE(residency.retain(1));
+    EXPECT_TRUE(residency.retain(1));
+    EXPECT_FALSE(residency.retain(3));
+    EXPECT_EQ(residency.getStats().cachedCount, 1U);
+    EXPECT_TRUE(residency.isOverBudget());
+
+    std::vector<int> evicted;
+    auto evict = [&](int instanceID) { evicted.push_back(instanceID); };
+
+    /// only the unreferenced one may go, the retained one stays over budget
+    EXPECT_EQ(residency.trim(evict), 1U);
+    EXPECT_EQ(evicted, std::vector<int>{ 2 });
+    EXPECT_EQ(residency.trim(evict), 0U);
+    EXPECT_EQ(residency.getStats().residentBytes, 80U);
+
+    /// one reference is left
+    residency.release(1, 80);
+    EXPECT_EQ(residency.trim(evict), 0U);
+    EXPECT_EQ(residency.getRefCount(1), 1U);
+
+    /// the last release measures the size again
+    residency.release(1, 120);
+    EXPECT_EQ(residency.getStats().cachedBytes, 120U);
+    EXPECT_EQ(residency.trim(evict), 1U);
+    EXPECT_EQ(evicted, (std::vector<int>{ 2, 1 }));
+
+    EXPECT_FALSE(residency.isOverBudget());
+
+    const ResourceMemoryStats &stats = residency.getStats();
+    EXPECT_EQ(stats.residentBytes, 0U);
+    EXPECT_EQ(stats.residentCount, 0U);
+    EXPECT_EQ(stats.evictions, 2U);
+    EXPECT_EQ(stats.evictedBytes, 200U);
+}
+
+TEST(ResourceResidency, EvictsLeastRecentlyReleasedPerClassAndOverall) {
+    ResourceResidency residency;
+    residency.setClassBudget(kMeshClass, 250);
+    residency.setBudget(500);
+
+    for (int id = 1; id <= 4; ++id) {
+        residency.add(id, kMeshClass, 100);
+        residency.retain(id);
+    }
+    for (int id = 11; id <= 14; ++id) {
+        residency.add(id, kTextureClass, 100);
+        residency.retain(id);
+    }
+    for (int id : { 3, 12, 1, 4, 11, 2, 14, 13 }) {
+        residency.release(id, 100);
+    }
+
+    std::vector<int> evicted;
+    /// the owner unloads the object, removing it again must be harmless
+    auto evict = [&](int instanceID) {
+        evicted.push_back(instanceID);
+        residency.remove(instanceID);
+    };
+
+    /// meshes go down to their budget first, then the oldest of any class until the total fits
+    EXPECT_EQ(residency.trim(evict), 3U);
+    EXPECT_EQ(evicted, (std::vector<int>{ 3, 1, 12 }));
+
+    EXPECT_EQ(residency.getStats(kMeshClass).residentBytes, 200U);
+    EXPECT_EQ(residency.getStats(kMeshClass).evictions, 2U);
+    EXPECT_EQ(residency.getStats(kTextureClass).evictions, 1U);
+    EXPECT_EQ(residency.getStats().residentBytes, 500U);
+    EXPECT_EQ(residency.getStats().cachedCount, 5U);
+
+    /// an evicted resource loaded again is counted
+    residency.add(3, kMeshClass, 100, true);
+    EXPECT_EQ(residency.getStats().reloads, 1U);
+    EXPECT_EQ(residency.getStats(kMeshClass).reloads, 1U);
+    residency.trim(evict);
+    EXPECT_EQ(evicted.back(), 4);
+    EXPECT_FALSE(residency.isTracked(4));
+    EXPECT_TRUE(residency.isTracked(3));
+}
@@ -0,0 +1,169 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/AsyncTextureLoader.hpp>
+#include <ojoie/Render/MipChain.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <cmath>
+#include <filesystem>
+#include <vector>
+
+using namespace AN;
+
+static std::filesystem::path TestDirectory() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "async_texture_loader_test";
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+/// smooth color with a hard edge, compresses like a photo in JPG
+static std::vector<UInt8> MakeImage(UInt32 width, UInt32 height, UInt32 seed, bool bAlpha) {
+    std::vector<UInt8> image((size_t) width * height * 4);
+    for (UInt32 y = 0; y < height; ++y) {
+        for (UInt32 x = 0; x < width; ++x) {
+            UInt8 *texel = &image[((size_t) y * width + x) * 4];
+            texel[0] = (UInt8) (x * 255 / std::max(1U, width - 1));
+            texel[1] = (UInt8) (y * 255 / std::max(1U, height - 1));
+            texel[2] = (UInt8) (128 + 100 * std::sin((float) (x + seed) * 0.1f));
+            texel[3] = bAlpha ? (UInt8) ((x * 7 + y * 3 + seed) & 255) : 255;
+            if ((x + y + seed) % 64 < 8) texel[0] = 255 - texel[0];
+        }
+    }
+    return image;
+}
+
+static std::string WriteImage(const char *name, ImageEncodeType type, UInt32 width, UInt32 height, UInt32 seed, bool bAlpha) {
+    std::string        path  = (TestDirectory() / name).string();
+    std::vector<UInt8> image = MakeImage(width, height, seed, bAlpha);
+    EXPECT_TRUE(TextureLoader::EncodeTexture(path.c_str(), type, image.data(), width, height, kPixelFormatRGBA8Unorm, 90));
+    return path;
+}
+
+TEST(AsyncTextureLoader, ExpandRGBToRGBA) {
+    std::vector<UInt8> rgb(3 * 67);
+    for (size_t i = 0; i < rgb.size(); ++i) rgb[i] = (UInt8) (i * 37 + 11);
+
+    /// every count exercises a different split between the wide loop and the tail
+    for (size_t count = 0; count <= 67; ++count) {
+        std::vector<UInt8> rgba(count * 4 + 4, 7);
+        TextureLoader::ExpandRGBToRGBA(rgb.data(), rgba.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(rgba[i * 4], rgb[i * 3]) << count;
+            ASSERT_EQ(rgba[i * 4 + 1], rgb[i * 3 + 1]) << count;
+            ASSERT_EQ(rgba[i * 4 + 2], rgb[i * 3 + 2]) << count;
+            ASSERT_EQ(rgba[i * 4 + 3], 255) << count;
+        }
+        EXPECT_EQ(rgba[count * 4], 7);
+    }
+}
+
+TEST(AsyncTextureLoader, MatchesSyncLoad) {
+    /// odd sizes with alpha, and a JPG which decodes to RGB and expands
+    std::string png = WriteImage("match.png", kImageEncodeTypePNG, 37, 23, 1, true);
+    std::string jpg = WriteImage("match.jpg", kImageEncodeTypeJPG, 45, 31, 2, false);
+
+    AsyncTextureLoader loader(2);
+    for (const std::string &path : { png, jpg }) {
+        LoadTextureResult sync = TextureLoader::LoadTexture(path.c_str(), true);
+        ASSERT_TRUE(sync.isValid());
+        EXPECT_EQ(sync.getPixelFormat(), kPixelFormatRGBA8Unorm_sRGB);
+        EXPECT_EQ(sync.getDataMipCount(), 1);
+
+        UInt32 width = sync.getWidth(), height = sync.getHeight(), mipCount = sync.getMipmapLevel();
+        std::vector<UInt8> chain(CalculateMipChainSize(sync.getPixelFormat(), width, height, mipCount));
+        memcpy(chain.data(), sync.getData(), (size_t) width * height * 4);
+        ASSERT_TRUE(GenerateMipChain(chain.data(), width, height, sync.getPixelFormat(), mipCount));
+
+        bool bCompleted = false;
+        loader.load(path.c_str(), {}, [&](LoadTextureResult &result) {
+            bCompleted = true;
+            ASSERT_TRUE(result.isValid());
+            EXPECT_EQ(result.getDataMipCount(), mipCount);
+            EXPECT_EQ(memcmp(result.getData(), chain.data(), chain.size()), 0);
+        });
+        loader.flush();
+        EXPECT_TRUE(bCompleted);
+    }
+
+    for (size_t i = 3; i < (size_t) 45 * 31 * 4; i += 4) {
+        ASSERT_EQ(TextureLoader::LoadTexture(jpg.c_str()).getData()[i], 255);
+    }
+}
+
+TEST(AsyncTextureLoader, PrioritiesAndCancel) {
+    std::string large = WriteImage("large.png", kImageEncodeTypePNG, 2048, 2048, 3, true);
+    std::string small = WriteImage("small.tga", kImageEncodeTypeTGA, 16, 16, 4, true);
+
+    /// one thread busy with the large image while the rest is queued
+    AsyncTextureLoader loader(1);
+    std::vector<int>   order;
+    loader.load(large.c_str(), { true, false, 100 }, [&](LoadTextureResult &) { order.push_back(100); });
+
+    int                        priorities[] = { 1, 5, -2, 5, 9, 0 };
+    std::vector<TextureLoadID> ids;
+    for (int priority : priorities) {
+        ids.push_back(loader.load(small.c_str(), { true, false, priority },
+                                  [&order, priority](LoadTextureResult &result) {
+                                      EXPECT_TRUE(result.isValid());
+                                      order.push_back(priority);
+                                  }));
+    }
+    EXPECT_TRUE(loader.cancel(ids[3]));
+    EXPECT_FALSE(loader.cancel(ids[3]));
+    EXPECT_TRUE(loader.setPriority(ids[2], 20));
+    EXPECT_EQ(loader.getPendingCount(), 6);
+
+    loader.flush();
+    EXPECT_EQ(order, std::vector<int>({ 100, -2, 9, 5, 1, 0 }));
+    EXPECT_EQ(loader.getPendingCount(), 0);
+    EXPECT_FALSE(loader.cancel(ids[0]));
+
+    bool bMissing = false;
+    loader.load((TestDirectory() / "missing.png").string().c_str(), {}, [&](LoadTextureResult &result) {
+        bMissing = !result.isValid();
+    });
+    loader.flush();
+    EXPECT_TRUE(bMissing);
+}
+
+TEST(AsyncTextureLoader, Throughput) {
+    const UInt32             fileCount = 300, size = 256;
+    std::vector<std::string> paths;
+    for (UInt32 i = 0; i < fileCount; ++i) {
+        std::string name = "throughput_" + std::to_string(i);
+        switch (i % 3) {
+            case 0: paths.push_back(WriteImage((name + ".png").c_str(), kImageEncodeTypePNG, size, size, i, true)); break;
+            case 1: paths.push_back(WriteImage((name + ".jpg").c_str(), kImageEncodeTypeJPG, size, size, i, false)); break;
+            default: paths.push_back(WriteImage((name + ".tga").c_str(), kImageEncodeTypeTGA, size, size, i, true)); break;
+        }
+    }
+
+    Timer timer;
+    for (const std::string &path : paths) {
+        ASSERT_TRUE(TextureLoader::LoadTexture(path.c_str()).isValid());
+    }
+    float syncSeconds = timer.mark();
+
+    AsyncTextureLoader loader;
+    UInt32             loaded = 0;
+    for (bool bBuildMipChain : { false, true }) {
+        timer.mark();
+        for (const std::string &path : paths) {
+            loader.load(path.c_str(), { true, bBuildMipChain, 0 }, [&loaded](LoadTextureResult &result) {
+                loaded += result.isValid();
+            });
+        }
+        loader.flush();
+        float seconds = timer.mark();
+        RecordProperty(bBuildMipChain ? "async_with_mips_files_per_second" : "async_files_per_second",
+                       std::to_string(fileCount / seconds));
+    }
+    RecordProperty("sync_files_per_second", std::to_string(fileCount / syncSeconds));
+    EXPECT_EQ(loaded, fileCount * 2);
+
+    std::filesystem::remove_all(TestDirectory());
+}
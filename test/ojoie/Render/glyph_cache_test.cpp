@@ -0,0 +1,238 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/GlyphCache.hpp>
+#include <ojoie/Render/SkylinePacker.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#ifdef OJOIE_USE_FREETYPE
+#include <ojoie/Render/FreeTypeRasterizer.hpp>
+#endif
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace AN;
+
+/// square glyphs of a size derived from the codepoint, like CJK text, 0 has no glyph and 32 is a space
+class TestRasterizer : public GlyphRasterizer {
+public:
+    std::atomic<UInt32> calls{};
+
+    /// codepoints from 1000 are squares of pixelSize - 1
+    static UInt32 GlyphSize(UInt32 codepoint, UInt32 pixelSize) {
+        if (codepoint >= 1000) return pixelSize - 1;
+        return pixelSize / 2 + codepoint % (pixelSize / 2 + 1);
+    }
+
+    virtual bool rasterize(FontID font, UInt32 codepoint, UInt32 pixelSize, bool bSDF, GlyphBitmap &outBitmap) override {
+        ++calls;
+        if (codepoint == 0) return false;
+        UInt32 size = codepoint == 32 ? 0 : GlyphSize(codepoint, pixelSize);
+        outBitmap.metrics = { (float) size + 1.f, 0, (Int16) size, (UInt16) size, (UInt16) size };
+        outBitmap.pixels.assign((size_t) size * size, (UInt8) (codepoint & 255 | 1));
+        return true;
+    }
+
+    virtual FontLineMetrics getLineMetrics(FontID font, UInt32 pixelSize) override {
+        return { (float) pixelSize, -(float) pixelSize / 4.f, (float) pixelSize * 1.25f };
+    }
+};
+
+TEST(GlyphCache, SkylinePacking) {
+    std::mt19937 random(7);
+    for (bool bMixed : { false, true }) {
+        /// CJK sized squares, or latin glyphs of varied aspect
+        std::uniform_int_distribution<UInt32> cjk(24, 34), narrow(4, 20), tall(10, 36);
+        SkylinePacker              packer(1024, 1024);
+        std::vector<UInt8>         coverage(1024 * 1024);
+        UInt32                     failures = 0, packed = 0;
+
+        while (failures < 64) {
+            UInt32 width = bMixed ? narrow(random) : cjk(random), height = bMixed ? tall(random) : cjk(random), x, y;
+            if (!packer.pack(width, height, x, y)) {
+                ++failures;
+                continue;
+            }
+            ++packed;
+            ASSERT_LE(x + width, 1024U);
+            ASSERT_LE(y + height, 1024U);
+            for (UInt32 row = y; row < y + height; ++row) {
+                for (UInt32 column = x; column < x + width; ++column) {
+                    ASSERT_EQ(coverage[row * 1024 + column]++, 0) << "overlap at " << column << ", " << row;
+                }
+            }
+        }
+
+        float occupancy = packer.getOccupancy();
+        RecordProperty(bMixed ? "latin_occupancy" : "cjk_occupancy", std::to_string(occupancy));
+        RecordProperty(bMixed ? "latin_glyphs_per_page" : "cjk_glyphs_per_page", std::to_string(packed));
+        EXPECT_GT(occupancy, 0.85f);
+
+        packer.reset();
+        UInt32 x, y;
+        EXPECT_TRUE(packer.pack(1024, 1024, x, y));
+        EXPECT_FALSE(packer.pack(1, 1, x, y));
+    }
+}
+
+TEST(GlyphCache, PendingReadyAndMissing) {
+    TestRasterizer rasterizer;
+    GlyphCache     cache(&rasterizer, { 256, 2, 1, 48, 2 });
+
+    const CachedGlyph *glyph;
+    EXPECT_EQ(cache.getGlyph({ 0, 'A', 16, false }, glyph), kGlyphPending);
+    EXPECT_EQ(cache.getGlyph({ 0, 'A', 16, false }, glyph), kGlyphPending);
+    EXPECT_EQ(cache.getGlyph({ 0, 0, 16, false }, glyph), kGlyphPending);
+    EXPECT_EQ(cache.getGlyph({ 0, ' ', 16, false }, glyph), kGlyphPending);
+    cache.flush();
+    EXPECT_EQ(rasterizer.calls, 3U);
+
+    ASSERT_EQ(cache.getGlyph({ 0, 'A', 16, false }, glyph), kGlyphReady);
+    UInt32 size = TestRasterizer::GlyphSize('A', 16);
+    EXPECT_EQ(glyph->metrics.width, size);
+    EXPECT_EQ(glyph->page, 0U);
+    const GlyphAtlasPage &page = cache.getPage(0);
+    EXPECT_TRUE(page.bDirty);
+    EXPECT_EQ(page.pixels[(size_t) glyph->y * 256 + glyph->x], 'A' | 1);
+    EXPECT_EQ(page.pixels[(size_t) (glyph->y + size - 1) * 256 + glyph->x + size - 1], 'A' | 1);
+
+    EXPECT_EQ(cache.getGlyph({ 0, 0, 16, false }, glyph), kGlyphMissing);
+    EXPECT_EQ(glyph, nullptr);
+    ASSERT_EQ(cache.getGlyph({ 0, ' ', 16, false }, glyph), kGlyphReady);
+    EXPECT_EQ(glyph->page, kNoGlyphPage);
+
+    /// SDF glyphs rasterize once for every size
+    EXPECT_EQ(cache.getGlyph({ 0, 'B', 12, true }, glyph), kGlyphPending);
+    EXPECT_EQ(cache.getGlyph({ 0, 'B', 96, true }, glyph), kGlyphPending);
+    cache.flush();
+    EXPECT_EQ(rasterizer.calls, 4U);
+    ASSERT_EQ(cache.getGlyph({ 0, 'B', 96, true }, glyph), kGlyphReady);
+    EXPECT_EQ(glyph->metrics.width, TestRasterizer::GlyphSize('B', 48));
+    EXPECT_FLOAT_EQ(cache.getScale({ 0, 'B', 96, true }), 2.f);
+    EXPECT_EQ(cache.getStats().glyphCount, 3U);
+}
+
+TEST(GlyphCache, EvictsLeastRecentlyUsedPage) {
+    TestRasterizer rasterizer;
+    GlyphCache     cache(&rasterizer, { 128, 2, 1, 48, 1 });
+
+    /// glyphs of 63 pixels and the padding, four fill a page
+    auto request = [&](UInt32 first, UInt32 count) {
+        const CachedGlyph *glyph;
+        UInt32             ready = 0;
+        for (UInt32 codepoint = first; codepoint < first + count; ++codepoint) {
+            ready += cache.getGlyph({ 0, codepoint, 64, false }, glyph) == kGlyphReady;
+        }
+        return ready;
+    };
+
+    UInt32 frame = 1;
+    cache.update(frame);
+    request(1000, 4);
+    cache.flush();
+    ASSERT_EQ(cache.getPageCount(), 1U);
+    EXPECT_FLOAT_EQ(cache.getOccupancy(), 1.f);
+
+    frame = 3;
+    cache.update(frame);
+    request(2000, 4);
+    cache.flush();
+    ASSERT_EQ(cache.getPageCount(), 2U);
+    EXPECT_EQ(request(2000, 4), 4U);
+
+    /// page 1 was used last frame and page 0 long ago, new glyphs take page 0
+    cache.update(++frame);
+    EXPECT_EQ(request(3000, 2), 0U);
+    cache.flush();
+    EXPECT_EQ(cache.getStats().evictedPages, 1U);
+    EXPECT_EQ(cache.getStats().evictedGlyphs, 4U);
+    EXPECT_EQ(cache.getPage(0).generation, 1U);
+    EXPECT_EQ(cache.getPage(1).generation, 0U);
+    EXPECT_EQ(request(3000, 2), 2U);
+    EXPECT_EQ(request(2000, 4), 4U);
+    EXPECT_EQ(request(1000, 4), 0U);
+
+    /// two evicted glyphs fit beside the new ones, the others wait while both pages are on screen
+    cache.update(++frame);
+    cache.flush();
+    EXPECT_EQ(request(1000, 4), 2U);
+    EXPECT_EQ(cache.getStats().evictedPages, 1U);
+
+    frame += 2;
+    cache.update(frame);
+    EXPECT_EQ(cache.getStats().evictedPages, 2U);
+    EXPECT_EQ(request(1000, 4), 4U);
+    EXPECT_EQ(request(2000, 4), 0U);
+
+    cache.clear();
+    EXPECT_EQ(cache.getPageCount(), 0U);
+    EXPECT_EQ(cache.getStats().glyphCount, 0U);
+}
+
+#ifdef OJOIE_USE_FREETYPE
+
+/// a TTF to rasterize, OJOIE_TEST_FONT or a system font
+static std::string TestFontPath() {
+    if (const char *path = std::getenv("OJOIE_TEST_FONT")) return path;
+    for (const char *path : { "C:/Windows/Fonts/arial.ttf",
+                              "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+                              "/System/Library/Fonts/Supplemental/Arial.ttf" }) {
+        if (std::filesystem::exists(path)) return path;
+    }
+    return {};
+}
+
+TEST(GlyphCache, FreeTypeThroughput) {
+    std::string path = TestFontPath();
+    if (path.empty()) GTEST_SKIP() << "no font, set OJOIE_TEST_FONT";
+
+    FreeTypeRasterizer rasterizer;
+    FontID             font = rasterizer.loadFont(path.c_str());
+    ASSERT_NE(font, kInvalidFontID);
+
+    FontLineMetrics lineMetrics = rasterizer.getLineMetrics(font, 32);
+    EXPECT_GT(lineMetrics.ascender, 0.f);
+    EXPECT_LT(lineMetrics.descender, 0.f);
+
+    /// the ring of an O is dark in the middle and inside beyond the edge in the SDF
+    GlyphBitmap bitmap;
+    ASSERT_TRUE(rasterizer.rasterize(font, 'O', 48, true, bitmap));
+    UInt32 width = bitmap.metrics.width, height = bitmap.metrics.height;
+    ASSERT_GT(width, 2 * rasterizer.getSDFSpread());
+    EXPECT_LT(bitmap.pixels[(height / 2) * width + width / 2], 128);
+    EXPECT_LT(bitmap.pixels[0], 128);
+    EXPECT_TRUE(std::any_of(bitmap.pixels.begin(), bitmap.pixels.end(), [](UInt8 value) { return value > 128; }));
+
+    ASSERT_TRUE(rasterizer.rasterize(font, ' ', 16, false, bitmap));
+    EXPECT_EQ(bitmap.metrics.width, 0);
+    EXPECT_GT(bitmap.metrics.advance, 0.f);
+
+    for (bool bSDF : { false, true }) {
+        GlyphCache cache(&rasterizer, { 1024, 16, 1, 48, 0 });
+        Timer      timer;
+        const CachedGlyph *glyph;
+        for (UInt32 pixelSize = 12; pixelSize <= 48; pixelSize += 4) {
+            for (UInt32 codepoint = 33; codepoint < 127; ++codepoint) {
+                cache.getGlyph({ font, codepoint, (UInt16) pixelSize, bSDF }, glyph);
+            }
+        }
+        cache.flush();
+        float seconds = timer.mark();
+
+        EXPECT_GT(cache.getStats().glyphCount, 0U);
+        RecordProperty(bSDF ? "sdf_glyphs_per_second" : "glyphs_per_second",
+                       std::to_string(cache.getStats().rasterized / seconds));
+        RecordProperty(bSDF ? "sdf_occupancy" : "occupancy", std::to_string(cache.getOccupancy()));
+        EXPECT_EQ(cache.getGlyph({ font, 'g', 24, bSDF }, glyph), kGlyphReady);
+        EXPECT_GT(glyph->metrics.height, 0);
+    }
+}
+
+#endif//OJOIE_USE_FREETYPE
@@ -0,0 +1,146 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/LightClusters.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace AN;
+
+static LightClusterViewParams MakeViewParams() {
+    LightClusterViewParams viewParams;
+    viewParams.worldToCamera = Math::identity<Matrix4x4f>();// at origin looking down -z
+    viewParams.fovyRadians   = Math::radians(60.f);
+    viewParams.aspect        = 16.f / 9.f;
+    viewParams.nearZ         = 0.1f;
+    viewParams.farZ          = 1000.f;
+    return viewParams;
+}
+
+static LocalLightData MakePointLight(const Vector3f &position, float range) {
+    LocalLightData light{};
+    light.position     = position;
+    light.range        = range;
+    light.spotCosOuter = -2.f;
+    light.spotCosInner = -1.f;
+    light.color        = Vector4f(1.f);
+    return light;
+}
+
+static bool ClusterHasLight(const LightClusters &clusters, const Vector3f &positionVS, UInt32 light) {
+    UInt32 cluster;
+    if (!clusters.getClusterIndex(positionVS, cluster)) return false;
+    std::span<const UInt32> lights = clusters.getClusterLights(cluster);
+    return std::find(lights.begin(), lights.end(), light) != lights.end();
+}
+
+TEST(LightClusters, SinglePointLight) {
+    LightClusters clusters;
+    std::vector<LocalLightData> lights{ MakePointLight({ 0.f, 0.f, -10.f }, 1.f) };
+    clusters.build(MakeViewParams(), lights);
+
+    EXPECT_TRUE(ClusterHasLight(clusters, { 0.f, 0.f, -10.f }, 0));
+    EXPECT_TRUE(ClusterHasLight(clusters, { 0.5f, 0.f, -10.5f }, 0));
+    EXPECT_FALSE(ClusterHasLight(clusters, { 0.f, 0.f, -100.f }, 0));
+    EXPECT_FALSE(ClusterHasLight(clusters, { 5.f, 2.f, -10.f }, 0));
+
+    /// only a handful of froxels around the light
+    EXPECT_GT(clusters.getLightIndices().size(), 0);
+    EXPECT_LT(clusters.getLightIndices().size(), 64);
+}
+
+TEST(LightClusters, CulledLights) {
+    LightClusters clusters;
+    std::vector<LocalLightData> lights{
+        MakePointLight({ 0.f, 0.f, 10.f }, 2.f),     // behind the camera
+        MakePointLight({ 0.f, 0.f, -900.f }, 2.f),   // beyond max distance
+        MakePointLight({ 500.f, 0.f, -10.f }, 2.f),  // outside the frustum
+    };
+    clusters.build(MakeViewParams(), lights);
+    EXPECT_EQ(clusters.getLightIndices().size(), 0);
+}
+
+TEST(LightClusters, Conservative) {
+    /// no light is dropped, so the lists must cover every light
+    LightClusterSettings settings;
+    settings.maxLightsPerCluster = kLightClusterMaxLights;
+
+    LightClusters clusters;
+    clusters.setSettings(settings);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+    std::vector<LocalLightData> lights;
+    for (int i = 0; i < 2000; ++i) {
+        float depth = 1.f + (unit(rng) * 0.5f + 0.5f) * 200.f;
+        Vector3f position(unit(rng) * depth, unit(rng) * depth * 0.6f, -depth);
+        lights.push_back(MakePointLight(position, 0.5f + (unit(rng) * 0.5f + 0.5f) * 8.f));
+    }
+
+    LightClusterViewParams viewParams = MakeViewParams();
+    clusters.build(viewParams, lights);
+
+    /// every light touching a sample point must be in the list of the cluster containing it
+    UInt32 checked = 0;
+    for (int i = 0; i < 20000; ++i) {
+        float depth = 0.5f + (unit(rng) * 0.5f + 0.5f) * 210.f;
+        Vector3f point(unit(rng) * depth * 1.02f, unit(rng) * depth * 0.57f, -depth);
+
+        UInt32 cluster;
+        if (!clusters.getClusterIndex(point, cluster)) continue;
+        std::span<const UInt32> clusterLights = clusters.getClusterLights(cluster);
+
+        for (UInt32 li = 0; li < lights.size(); ++li) {
+            if (Math::distance(lights[li].position, point) < lights[li].range) {
+                ++checked;
+                EXPECT_NE(std::find(clusterLights.begin(), clusterLights.end(), li), clusterLights.end());
+            }
+        }
+    }
+    EXPECT_GT(checked, 0);
+    EXPECT_EQ(clusters.getDroppedLightCount(), 0);
+}
+
+TEST(LightClusters, SpotLight) {
+    LightClusters clusters;
+
+    LocalLightData spot = MakePointLight({ 0.f, 0.f, -5.f }, 10.f);
+    spot.spotDirection  = { 1.f, 0.f, 0.f };
+    spot.spotCosOuter   = std::cos(Math::radians(20.f));
+    spot.spotCosInner   = std::cos(Math::radians(15.f));
+
+    std::vector<LocalLightData> lights{ spot };
+    clusters.build(MakeViewParams(), lights);
+
+    EXPECT_TRUE(ClusterHasLight(clusters, { 5.f, 0.f, -5.f }, 0));
+    /// opposite side of the cone
+    EXPECT_FALSE(ClusterHasLight(clusters, { -5.f, 0.f, -5.f }, 0));
+}
+
+TEST(LightClusters, PerClusterLimit) {
+    LightClusterSettings settings;
+    settings.maxLightsPerCluster = 16;
+
+    LightClusters clusters;
+    clusters.setSettings(settings);
+
+    std::vector<LocalLightData> lights(100, MakePointLight({ 0.f, 0.f, -10.f }, 1.f));
+    clusters.build(MakeViewParams(), lights);
+
+    UInt32 cluster;
+    ASSERT_TRUE(clusters.getClusterIndex({ 0.f, 0.f, -10.f }, cluster));
+    std::span<const UInt32> clusterLights = clusters.getClusterLights(cluster);
+    ASSERT_EQ(clusterLights.size(), 16);
+
+    /// lights are kept in index order so the result is stable
+    for (UInt32 i = 0; i < 16; ++i) {
+        EXPECT_EQ(clusterLights[i], i);
+    }
+    EXPECT_GT(clusters.getDroppedLightCount(), 0);
+}
@@ -0,0 +1,71 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Core/Actor.hpp>
+#include <ojoie/Render/LODGroup.hpp>
+#include <ojoie/Render/Mesh/MeshRenderer.hpp>
+#include <ojoie/Render/RenderContext.hpp>
+
+#include <vector>
+
+using namespace AN;
+
+static LODSelectionParams MakeParams() {
+    LODSelectionParams params;
+    params.cameraPosition    = Vector3f(0.f);
+    params.screenHeightScale = 1.f;
+    params.lodBias           = 1.f;
+    params.maxLOD            = 0;
+    params.hysteresis        = 0.f;
+    return params;
+}
+
+TEST(LODGroup, ForgetsDestroyedRenderer) {
+    InitializeRenderContext(kGraphicsAPID3D11);
+
+    Actor *groupActor = NewObject<Actor>();
+    groupActor->init("LODGroupActor");
+    LODGroup *group = groupActor->addComponent<LODGroup>();
+
+    Actor *lod0Actor = NewObject<Actor>();
+    lod0Actor->init("LOD0Actor");
+    Renderer *lod0 = lod0Actor->addComponent<MeshRenderer>();
+
+    Actor *lod1Actor = NewObject<Actor>();
+    lod1Actor->init("LOD1Actor");
+    Renderer *lod1 = lod1Actor->addComponent<MeshRenderer>();
+
+    LOD lods[2];
+    lods[0].screenRelativeHeight = 0.5f;
+    lods[0].renderers            = { lod0 };
+    lods[1].screenRelativeHeight = 0.1f;
+    lods[1].renderers            = { lod0, lod1 };
+    group->setLODs(lods);
+
+    /// the group is still drawn every frame after one of its renderers is gone
+    DestroyActor(lod0Actor);
+    EXPECT_TRUE(group->getLODs()[0].renderers.empty());
+    ASSERT_EQ(group->getLODs()[1].renderers.size(), 1U);
+    EXPECT_EQ(group->getLODs()[1].renderers[0], lod1);
+
+    /// camera inside the group selects the finest level, which has nothing left to show
+    std::vector<LODSelectionState> states;
+    GetLODGroupManager().update();
+    GetLODGroupManager().selectLODs(MakeParams(), states);
+    ASSERT_EQ(states.size(), 1U);
+    EXPECT_EQ(states[0].lod, 0);
+    EXPECT_TRUE(lod1->isLODCulled());
+
+    /// destroying the group resets the renderer it still lists, the renderer then outlives it
+    DestroyActor(groupActor);
+    EXPECT_FALSE(lod1->isLODCulled());
+    GetLODGroupManager().update();
+    EXPECT_EQ(GetLODGroupManager().getLODGroupCount(), 0U);
+
+    DestroyActor(lod1Actor);
+
+    DeallocRenderContext();
+}
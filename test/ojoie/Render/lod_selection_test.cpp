@@ -0,0 +1,156 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/LODSelection.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace AN;
+
+static LODSelectionParams MakeParams() {
+    LODSelectionParams params;
+    params.cameraPosition    = Vector3f(0.f);
+    params.screenHeightScale = 0.5f / std::tan(Math::radians(60.f) * 0.5f);
+    params.lodBias           = 1.f;
+    params.maxLOD            = 0;
+    params.hysteresis        = 0.1f;
+    return params;
+}
+
+/// 3 levels at 50%, 20% and 5% of the screen height
+static LODGroupData MakeGroup(float distance) {
+    LODGroupData group{};
+    group.worldCenter              = Vector3f(0.f, 0.f, -distance);
+    group.worldSize                = 2.f;
+    group.groupID                  = 1;
+    group.lodCount                 = 3;
+    group.screenRelativeHeights[0] = 0.5f;
+    group.screenRelativeHeights[1] = 0.2f;
+    group.screenRelativeHeights[2] = 0.05f;
+    return group;
+}
+
+/// distance at which the group covers the relative height
+static float DistanceOfHeight(const LODSelectionParams &params, float height) {
+    return 2.f * params.screenHeightScale / height;
+}
+
+static LODSelectionState Select(const LODSelectionParams &params, const LODGroupData &group, LODSelectionState state) {
+    SelectLODs(params, std::span(&group, 1), std::span(&state, 1));
+    return state;
+}
+
+TEST(LODSelection, ScreenSize) {
+    LODSelectionParams params = MakeParams();
+
+    EXPECT_EQ(Select(params, MakeGroup(0.5f), {}).lod, 0);  // camera inside the group
+    EXPECT_EQ(Select(params, MakeGroup(DistanceOfHeight(params, 0.6f)), {}).lod, 0);
+    EXPECT_EQ(Select(params, MakeGroup(DistanceOfHeight(params, 0.3f)), {}).lod, 1);
+    EXPECT_EQ(Select(params, MakeGroup(DistanceOfHeight(params, 0.1f)), {}).lod, 2);
+    EXPECT_EQ(Select(params, MakeGroup(DistanceOfHeight(params, 0.01f)), {}).lod, kLODCulled);
+
+    LODSelectionState state = Select(params, MakeGroup(DistanceOfHeight(params, 0.3f)), {});
+    EXPECT_NEAR(state.relativeHeight, 0.3f, 1e-4f);
+    EXPECT_EQ(state.groupID, 1);
+}
+
+TEST(LODSelection, Hysteresis) {
+    LODSelectionParams params = MakeParams();
+
+    LODSelectionState state = Select(params, MakeGroup(DistanceOfHeight(params, 0.6f)), {});
+    ASSERT_EQ(state.lod, 0);
+
+    /// just below the threshold keeps the level
+    state = Select(params, MakeGroup(DistanceOfHeight(params, 0.48f)), state);
+    EXPECT_EQ(state.lod, 0);
+
+    /// below the margin switches
+    state = Select(params, MakeGroup(DistanceOfHeight(params, 0.44f)), state);
+    EXPECT_EQ(state.lod, 1);
+
+    /// back above the threshold but inside the margin keeps the coarser level
+    state = Select(params, MakeGroup(DistanceOfHeight(params, 0.52f)), state);
+    EXPECT_EQ(state.lod, 1);
+
+    state = Select(params, MakeGroup(DistanceOfHeight(params, 0.56f)), state);
+    EXPECT_EQ(state.lod, 0);
+
+    /// a state of another group is reset
+    LODGroupData other = MakeGroup(DistanceOfHeight(params, 0.48f));
+    other.groupID = 2;
+    state = Select(params, other, state);
+    EXPECT_EQ(state.groupID, 2);
+    EXPECT_EQ(state.lod, 1);
+}
+
+TEST(LODSelection, BiasAndMaxLOD) {
+    LODSelectionParams params = MakeParams();
+    LODGroupData group = MakeGroup(DistanceOfHeight(params, 0.3f));
+
+    params.lodBias = 2.f;
+    EXPECT_EQ(Select(params, group, {}).lod, 0);
+
+    params.lodBias = 0.5f;
+    EXPECT_EQ(Select(params, group, {}).lod, 2);
+
+    params.lodBias = 1.f;
+    params.maxLOD  = 2;
+    EXPECT_EQ(Select(params, MakeGroup(1.f), {}).lod, 2);
+
+    /// max lod never makes a culled group visible
+    EXPECT_EQ(Select(params, MakeGroup(DistanceOfHeight(params, 0.01f)), {}).lod, kLODCulled);
+}
+
+TEST(LODSelection, CrossFade) {
+    LODSelectionParams params = MakeParams();
+
+    /// level 1 band is [0.2, 0.5), the lowest 20% of it fades into level 2
+    LODGroupData group = MakeGroup(DistanceOfHeight(params, 0.23f));
+    group.fadeTransitionWidth = 0.2f;
+
+    LODSelectionState state = Select(params, group, {});
+    EXPECT_EQ(state.lod, 1);
+    EXPECT_EQ(state.fadeLOD, 2);
+    EXPECT_NEAR(state.fade, 0.5f, 1e-3f);
+
+    group.worldCenter = Vector3f(0.f, 0.f, -DistanceOfHeight(params, 0.4f));
+    state = Select(params, group, {});
+    EXPECT_EQ(state.lod, 1);
+    EXPECT_EQ(state.fadeLOD, kLODCulled);
+    EXPECT_FLOAT_EQ(state.fade, 1.f);
+
+    /// the last level fades out to nothing
+    group.worldCenter = Vector3f(0.f, 0.f, -DistanceOfHeight(params, 0.06f));
+    state = Select(params, group, {});
+    EXPECT_EQ(state.lod, 2);
+    EXPECT_EQ(state.fadeLOD, kLODCulled);
+    EXPECT_LT(state.fade, 1.f);
+}
+
+TEST(LODSelection, Batch) {
+    LODSelectionParams params = MakeParams();
+
+    std::vector<LODGroupData> groups;
+    for (UInt32 i = 0; i < 4000; ++i) {
+        LODGroupData group = MakeGroup(1.f + (float) i * 0.05f);
+        group.groupID = i + 1;
+        groups.push_back(group);
+    }
+
+    std::vector<LODSelectionState> states(groups.size());
+    SelectLODs(params, groups, states);
+
+    /// levels never get finer with distance
+    for (UInt32 i = 1; i < states.size(); ++i) {
+        EXPECT_EQ(states[i].groupID, i + 1);
+        UInt32 previous = states[i - 1].lod == kLODCulled ? 3 : states[i - 1].lod;
+        UInt32 current  = states[i].lod == kLODCulled ? 3 : states[i].lod;
+        EXPECT_GE(current, previous);
+    }
+    EXPECT_EQ(states.front().lod, 0);
+    EXPECT_EQ(states.back().lod, kLODCulled);
+}
@@ -0,0 +1,265 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Misc/ResourceManager.hpp>
+#include <ojoie/Render/Mesh/Mesh.hpp>
+#include <ojoie/Render/RenderContext.hpp>
+#include <ojoie/Serialize/Coder/YamlDecoder.hpp>
+#include <ojoie/Serialize/Coder/YamlEncoder.hpp>
+#include <ojoie/Serialize/SerializeManager.hpp>
+
+#include <filesystem>
+#include <vector>
+
+using namespace AN;
+
+namespace fs = std::filesystem;
+
+/// (n + 1)^2 vertices on the xy plane, 2 triangles per quad
+struct GridMesh {
+    std::vector<Vector3f> positions;
+    std::vector<UInt32>   indices;
+
+    explicit GridMesh(UInt32 n) {
+        for (UInt32 y = 0; y <= n; ++y) {
+            for (UInt32 x = 0; x <= n; ++x) {
+                positions.emplace_back((float) x, (float) y, 0.f);
+            }
+        }
+        for (UInt32 y = 0; y < n; ++y) {
+            for (UInt32 x = 0; x < n; ++x) {
+                UInt32 i = y * (n + 1) + x;
+                indices.insert(indices.end(), { i, i + 1, i + n + 2, i, i + n + 2, i + n + 1 });
+            }
+        }
+    }
+};
+
+/// pick the index format the importers pick, then fill the mesh
+static Mesh *MakeMesh(const GridMesh &grid) {
+    Mesh *mesh = NewObject<Mesh>();
+    EXPECT_TRUE(mesh->setIndexFormat(GetIndexFormatForVertexCount(grid.positions.size())));
+    mesh->setVertices(grid.positions.data(), grid.positions.size());
+    mesh->setSubMeshCount(1);
+    EXPECT_TRUE(mesh->setIndices(grid.indices.data(), grid.indices.size(), 0));
+    return mesh;
+}
+
+static Mesh *RoundTrip(Mesh *mesh) {
+    YamlEncoder encoder;
+    mesh->redirectTransferVirtual(encoder);
+    std::string text;
+    encoder.outputToString(text);
+
+    YamlDecoder decoder(text.data(), (int) text.size());
+    Mesh *decoded = NewObject<Mesh>();
+    decoded->redirectTransferVirtual(decoder);
+    return decoded;
+}
+
+TEST(Mesh, ChoosesIndexFormat) {
+    EXPECT_EQ(GetIndexFormatForVertexCount(0), kIndexFormatUInt16);
+    EXPECT_EQ(GetIndexFormatForVertexCount(65536), kIndexFormatUInt16);
+    EXPECT_EQ(GetIndexFormatForVertexCount(65537), kIndexFormatUInt32);
+
+    /// 256^2 vertices still fit 16 bit indices
+    GridMesh small(255);
+    Mesh    *smallMesh = MakeMesh(small);
+    EXPECT_EQ(smallMesh->getIndexFormat(), kIndexFormatUInt16);
+    EXPECT_EQ(smallMesh->getIndicesCount(), small.indices.size());
+    EXPECT_EQ(smallMesh->getIndex((UInt32) small.indices.size() - 1), small.indices.back());
+
+    /// indices past 65535 are rejected by a 16 bit mesh
+    UInt32 outOfRange[] = { 0, 1, 65536 };
+    EXPECT_FALSE(smallMesh->setIndices(outOfRange, 3, 0));
+
+    GridMesh large(300);
+    Mesh    *largeMesh = MakeMesh(large);
+    EXPECT_EQ(largeMesh->getIndexFormat(), kIndexFormatUInt32);
+    EXPECT_EQ(largeMesh->getIndex((UInt32) large.indices.size() - 1), large.indices.back());
+    EXPECT_GT(large.indices.back(), 65535U);
+
+    /// too many vertices to go back to 16 bit
+    EXPECT_FALSE(largeMesh->setIndexFormat(kIndexFormatUInt16));
+    EXPECT_EQ(largeMesh->getIndexFormat(), kIndexFormatUInt32);
+
+    DestroyObject(smallMesh);
+    DestroyObject(largeMesh);
+}
+
+TEST(Mesh, IndexFormatRoundTrip) {
+    for (UInt32 n : { 16U, 300U }) {
+        GridMesh grid(n);
+        Mesh    *mesh    = MakeMesh(grid);
+        Mesh    *decoded = RoundTrip(mesh);
+
+        EXPECT_EQ(decoded->getIndexFormat(), mesh->getIndexFormat());
+        EXPECT_EQ(decoded->getVertexCount(), mesh->getVertexCount());
+        ASSERT_EQ(decoded->getIndicesCount(), grid.indices.size());
+        ASSERT_EQ(decoded->getSubMeshCount(), 1U);
+        EXPECT_EQ(decoded->getSubMesh(0).indexCount, grid.indices.size());
+
+        bool same = true;
+        for (UInt32 i = 0; i < grid.indices.size(); ++i) {
+            same &= decoded->getIndex(i) == grid.indices[i];
+        }
+        EXPECT_TRUE(same);
+
+        DestroyObject(mesh);
+        DestroyObject(decoded);
+    }
+}
+
+class MeshReadableTest : public ::testing::Test {
+protected:
+    fs::path directory;
+
+    void SetUp() override {
+        InitializeRenderContext(kGraphicsAPID3D11);
+        directory = fs::temp_directory_path() / ("ojoie_mesh_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove_all(directory);
+        fs::create_directories(directory);
+    }
+
+    void TearDown() override {
+        fs::remove_all(directory);
+        DeallocRenderContext();
+    }
+
+    std::string assetPath(const char *name) const {
+        return (directory / name).string();
+    }
+};
+
+TEST_F(MeshReadableTest, ReleasesCPUDataAfterUpload) {
+    GridMesh grid(16);
+
+    Mesh *readable = MakeMesh(grid);
+    readable->init();
+    readable->createVertexBuffer();
+    EXPECT_TRUE(readable->isReadable());
+    EXPECT_TRUE(readable->hasCPUData());
+
+    MeshMemoryReport before = GetMeshMemoryReport();
+
+    Mesh *mesh = MakeMesh(grid);
+    mesh->init();
+    mesh->setReadable(false);
+    UInt64 cpuBytes = mesh->getCPUMemorySize();
+    mesh->createVertexBuffer();
+
+    /// counts and sub meshes stay, the data is gone
+    EXPECT_FALSE(mesh->hasCPUData());
+    EXPECT_EQ(mesh->getVertexCount(), readable->getVertexCount());
+    EXPECT_EQ(mesh->getSubMesh(0).indexCount, grid.indices.size());
+    EXPECT_LT(mesh->getCPUMemorySize(), cpuBytes);
+    EXPECT_EQ(mesh->getGPUMemorySize(), readable->getGPUMemorySize());
+
+    /// cpu side edits are rejected
+    EXPECT_FALSE(mesh->setIndices(grid.indices.data(), grid.indices.size(), 0));
+    EXPECT_FALSE(mesh->setIndexFormat(kIndexFormatUInt32));
+
+    MeshMemoryReport after = GetMeshMemoryReport();
+    EXPECT_EQ(after.meshCount, before.meshCount + 1);
+    EXPECT_EQ(after.readableCount, before.readableCount);
+    EXPECT_EQ(after.cpuBytes, before.cpuBytes + mesh->getCPUMemorySize());
+    EXPECT_EQ(after.gpuBytes, before.gpuBytes + mesh->getGPUMemorySize());
+
+    /// a released mesh fails the whole asset instead of writing it without data
+    std::string path = assetPath("Released.asset");
+    EXPECT_FALSE(GetSerializeManager().SerializeObjectAtPath(mesh, path.c_str()));
+    EXPECT_FALSE(fs::exists(path));
+
+    DestroyObject(readable);
+    DestroyObject(mesh);
+}
+
+TEST_F(MeshReadableTest, KeepsCollisionData) {
+    GridMesh grid(16);
+
+    Mesh *mesh = MakeMesh(grid);
+    mesh->init();
+    mesh->setReadable(false);
+    mesh->setKeepCollisionData(true);
+    mesh->createVertexBuffer();
+
+    EXPECT_FALSE(mesh->hasCPUData());
+    ASSERT_EQ(mesh->getCollisionVertices().size(), grid.positions.size());
+    ASSERT_EQ(mesh->getCollisionIndices(), grid.indices);
+    bool same = true;
+    for (UInt32 i = 0; i < grid.positions.size(); ++i) {
+        same &= Math::distance(mesh->getCollisionVertices()[i], grid.positions[i]) < 1e-3f;
+    }
+    EXPECT_TRUE(same);
+
+    /// the copy counts as cpu memory
+    EXPECT_GE(mesh->getCPUMemorySize(), grid.positions.size() * sizeof(Vector3f) + grid.indices.size() * sizeof(UInt32));
+
+    DestroyObject(mesh);
+}
+
+TEST_F(MeshReadableTest, ReloadFromAsset) {
+    GridMesh grid(16);
+    std::string path = assetPath("Grid.asset");
+
+    /// the saved mesh stays registered with the serialize manager, loading the asset decodes into it
+    Mesh *mesh = MakeMesh(grid);
+    mesh->init();
+    mesh->setReadable(false);
+    ASSERT_TRUE(GetSerializeManager().SerializeObjectAtPath(mesh, path.c_str()));
+
+    /// the readable flag is serialized, loading uploads and releases
+    ASSERT_EQ(GetResourceManager().loadResourceAtPath(path.c_str()), mesh);
+    EXPECT_FALSE(mesh->isReadable());
+    EXPECT_FALSE(mesh->hasCPUData());
+    EXPECT_GT(mesh->getGPUMemorySize(), 0U);
+
+    ASSERT_TRUE(mesh->reloadFromAsset());
+    EXPECT_TRUE(mesh->hasCPUData());
+    ASSERT_EQ(mesh->getIndicesCount(), grid.indices.size());
+    bool same = true;
+    for (UInt32 i = 0; i < grid.indices.size(); ++i) {
+        same &= mesh->getIndex(i) == grid.indices[i];
+    }
+    EXPECT_TRUE(same);
+
+    /// reloaded data can be serialized again
+    EXPECT_TRUE(GetSerializeManager().SerializeObjectAtPath(mesh, assetPath("Copy.asset").c_str()));
+
+    GetResourceManager().unloadResource(mesh);
+}
+
+TEST(Mesh, UVDistributionMetric) {
+    /// 16 x 16 world units mapped to the unit uv square
+    GridMesh              grid(16);
+    std::vector<Vector2f> uvs;
+    for (const Vector3f &position : grid.positions) {
+        uvs.emplace_back(position.x / 16.f, position.y / 16.f);
+    }
+
+    /// the usual order, vertices first, then uvs and indices
+    Mesh *mesh = NewObject<Mesh>();
+    mesh->setVertices(grid.positions.data(), grid.positions.size());
+    EXPECT_EQ(mesh->getUVDistributionMetric(), 0.f);
+
+    mesh->setUV(0, uvs.data(), uvs.size());
+    mesh->setSubMeshCount(1);
+    ASSERT_TRUE(mesh->setIndices(grid.indices.data(), grid.indices.size(), 0));
+    EXPECT_NEAR(mesh->getUVDistributionMetric(), 256.f, 1e-2f);
+
+    /// halving the uv range quadruples the world area per uv area
+    for (Vector2f &uv : uvs) uv *= 0.5f;
+    mesh->setUV(0, uvs.data(), uvs.size());
+    EXPECT_NEAR(mesh->getUVDistributionMetric(), 1024.f, 1e-1f);
+
+    /// rebuilt from the decoded data, initAfterDecode recalculates the bounds the same way
+    Mesh *decoded = RoundTrip(mesh);
+    decoded->recalculateBounds();
+    EXPECT_NEAR(decoded->getUVDistributionMetric(), 1024.f, 1e-1f);
+
+    DestroyObject(mesh);
+    DestroyObject(decoded);
+}
@@ -0,0 +1,123 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/MipChain.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <vector>
+
+using namespace AN;
+
+static std::vector<UInt8> MakeChain(PixelFormat format, UInt32 width, UInt32 height) {
+    return std::vector<UInt8>(CalculateMipChainSize(format, width, height, CalculateMipCount(width, height)));
+}
+
+static float Coverage(const UInt8 *rgba, size_t count, float cutoff) {
+    size_t passed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        passed += rgba[i * 4 + 3] > cutoff * 255.f;
+    }
+    return (float) passed / (float) count;
+}
+
+TEST(MipChain, CountAndLayout) {
+    EXPECT_EQ(CalculateMipCount(1, 1), 1);
+    EXPECT_EQ(CalculateMipCount(256, 64), 9);
+    EXPECT_EQ(CalculateMipCount(300, 7), 9);
+    EXPECT_EQ(CalculateMipSize(300, 8), 1);
+    EXPECT_EQ(CalculateMipSize(7, 2), 1);
+
+    EXPECT_EQ(CalculateMipChainSize(kPixelFormatRGBA8Unorm, 4, 4, 3), 64 + 16 + 4);
+    EXPECT_EQ(CalculateMipOffset(kPixelFormatRGBA8Unorm, 4, 4, 2), 64 + 16);
+    EXPECT_EQ(CalculateMipChainSize(kPixelFormatR8Unorm, 8, 2, 4), 16 + 4 + 2 + 1);
+
+    EXPECT_TRUE(IsMipChainFormatSupported(kPixelFormatRGBA8Unorm_sRGB));
+    EXPECT_FALSE(IsMipChainFormatSupported(kPixelFormatBC1_RGBA));
+}
+
+TEST(MipChain, UniformColorIsKept) {
+    for (MipFilter filter : { kMipFilterBox, kMipFilterKaiser }) {
+        const UInt32 width = 64, height = 16;
+        std::vector<UInt8> chain = MakeChain(kPixelFormatRGBA8Unorm_sRGB, width, height);
+        for (UInt32 i = 0; i < width * height; ++i) {
+            chain[i * 4 + 0] = 200;
+            chain[i * 4 + 1] = 100;
+            chain[i * 4 + 2] = 3;
+            chain[i * 4 + 3] = 128;
+        }
+        ASSERT_TRUE(GenerateMipChain(chain.data(), width, height, kPixelFormatRGBA8Unorm_sRGB, 7, { filter }));
+
+        /// the last level is 1x1
+        const UInt8 *last = chain.data() + CalculateMipOffset(kPixelFormatRGBA8Unorm_sRGB, width, height, 6);
+        EXPECT_EQ(last[0], 200);
+        EXPECT_EQ(last[1], 100);
+        EXPECT_EQ(last[2], 3);
+        EXPECT_EQ(last[3], 128);
+    }
+}
+
+TEST(MipChain, GammaCorrectAverage) {
+    /// black and white texels average to half the light, not half the sRGB value
+    UInt8 rgba[4 * 4 + 4] = { 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0 };
+    ASSERT_TRUE(GenerateMipChain(rgba, 2, 2, kPixelFormatRGBA8Unorm_sRGB, 2));
+    EXPECT_EQ(rgba[16], 188);
+    EXPECT_EQ(rgba[19], 128);
+
+    UInt8 linear[4 * 4 + 4] = { 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0 };
+    ASSERT_TRUE(GenerateMipChain(linear, 2, 2, kPixelFormatRGBA8Unorm, 2));
+    EXPECT_EQ(linear[16], 128);
+
+    UInt8 single[4 + 1] = { 0, 255, 255, 0 };
+    ASSERT_TRUE(GenerateMipChain(single, 2, 2, kPixelFormatR8Unorm_sRGB, 2));
+    EXPECT_EQ(single[4], 188);
+}
+
+TEST(MipChain, AlphaCoverage) {
+    /// sparse leaves, 30% of the texels are opaque
+    const UInt32 size = 128;
+    std::vector<UInt8> chain = MakeChain(kPixelFormatRGBA8Unorm, size, size);
+    UInt32 seed = 1234;
+    for (UInt32 i = 0; i < size * size; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        chain[i * 4 + 1] = 255;
+        chain[i * 4 + 3] = (seed >> 8) % 100 < 30 ? 255 : 0;
+    }
+    std::vector<UInt8> preserved = chain;
+
+    MipChainSettings settings;
+    settings.alphaCutoff = 0.6f;
+    ASSERT_TRUE(GenerateMipChain(chain.data(), size, size, kPixelFormatRGBA8Unorm, 4, settings));
+    settings.bPreserveAlphaCoverage = true;
+    ASSERT_TRUE(GenerateMipChain(preserved.data(), size, size, kPixelFormatRGBA8Unorm, 4, settings));
+
+    float coverage = Coverage(chain.data(), size * size, 0.6f);
+    EXPECT_NEAR(coverage, 0.3f, 0.02f);
+    for (UInt32 level = 1; level < 4; ++level) {
+        UInt64 offset = CalculateMipOffset(kPixelFormatRGBA8Unorm, size, size, level);
+        size_t count  = (size_t) CalculateMipSize(size, level) * CalculateMipSize(size, level);
+        EXPECT_LT(Coverage(chain.data() + offset, count, 0.6f), 0.15f);
+        /// box averages of binary alpha only take a few values, so the coverage cannot match closer
+        EXPECT_NEAR(Coverage(preserved.data() + offset, count, 0.6f), coverage, 0.07f);
+    }
+}
+
+TEST(MipChain, Benchmark) {
+    const UInt32 size = 2048;
+    std::vector<UInt8> chain = MakeChain(kPixelFormatRGBA8Unorm_sRGB, size, size);
+    for (size_t i = 0; i < (size_t) size * size * 4; ++i) {
+        chain[i] = (UInt8) (i * 2654435761u >> 24);
+    }
+    UInt32 mipCount = CalculateMipCount(size, size);
+
+    Timer timer;
+    ASSERT_TRUE(GenerateMipChain(chain.data(), size, size, kPixelFormatRGBA8Unorm_sRGB, mipCount, { kMipFilterBox }));
+    float boxMs = timer.mark() * 1000.f;
+    ASSERT_TRUE(GenerateMipChain(chain.data(), size, size, kPixelFormatRGBA8Unorm_sRGB, mipCount, { kMipFilterKaiser }));
+    float kaiserMs = timer.mark() * 1000.f;
+
+    RecordProperty("box_2048_ms", std::to_string(boxMs));
+    RecordProperty("kaiser_2048_ms", std::to_string(kaiserMs));
+}
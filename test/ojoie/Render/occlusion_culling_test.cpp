@@ -0,0 +1,199 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/OcclusionCulling.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace AN;
+
+/// camera at origin looking down -z
+static Matrix4x4f MakeViewProj() {
+    return Math::perspective(Math::radians(60.f), 2.f, 0.1f, 100.f);
+}
+
+/// 10x10 wall facing the camera at depth z
+struct Wall {
+    Vector3f vertices[4];
+    UInt16   indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+    explicit Wall(float z, float halfSize = 5.f) {
+        vertices[0] = { -halfSize, -halfSize, z };
+        vertices[1] = { halfSize, -halfSize, z };
+        vertices[2] = { halfSize, halfSize, z };
+        vertices[3] = { -halfSize, halfSize, z };
+    }
+
+    OccluderMesh getMesh() {
+        OccluderMesh mesh;
+        mesh.vertices      = StrideIterator<Vector3f>(vertices, sizeof(Vector3f));
+        mesh.vertexCount   = 4;
+        mesh.indices       = indices;
+        mesh.indexCount    = 6;
+        mesh.objectToWorld = Math::identity<Matrix4x4f>();
+        return mesh;
+    }
+};
+
+TEST(OcclusionCulling, WallHidesBoxBehind) {
+    OcclusionCulling culling;
+    culling.beginFrame(MakeViewProj());
+
+    Wall wall(-10.f);
+    OccluderMesh mesh = wall.getMesh();
+    culling.renderOccluders(std::span(&mesh, 1));
+
+    EXPECT_EQ(culling.testOccludee(AABB(Vector3f(0.f, 0.f, -20.f), Vector3f(1.f))), kOcclusionOccluded);
+    EXPECT_EQ(culling.testOccludee(AABB(Vector3f(0.f, 0.f, -5.f), Vector3f(1.f))), kOcclusionVisible);
+
+    /// intersecting the wall
+    EXPECT_EQ(culling.testOccludee(AABB(Vector3f(0.f, 0.f, -10.f), Vector3f(1.f))), kOcclusionVisible);
+
+    /// behind the wall but peeking over its top edge
+    EXPECT_EQ(culling.testOccludee(AABB(Vector3f(0.f, 9.f, -20.f), Vector3f(1.f))), kOcclusionVisible);
+
+    /// behind the camera
+    EXPECT_EQ(culling.testOccludee(AABB(Vector3f(0.f, 0.f, 20.f), Vector3f(1.f))), kOcclusionFrustumCulled);
+}
+
+TEST(OcclusionCulling, UInt32Indices) {
+    OcclusionCulling culling;
+    culling.beginFrame(MakeViewProj());
+
+    Wall   wall(-10.f);
+    UInt32 indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+    OccluderMesh mesh = wall.getMesh();
+    mesh.indices      = indices;
+    mesh.indexFormat  = kIndexFormatUInt32;
+    culling.renderOccluders(std::span(&mesh, 1));
+
+    EXPECT_EQ(culling.getStats().occluderTriangleCount, 2);
+    EXPECT_EQ(culling.testOccludee(AABB(Vector3f(0.f, 0.f, -20.f), Vector3f(1.f))), kOcclusionOccluded);
+}
+
+TEST(OcclusionCulling, Conservative) {
+    OcclusionCulling culling;
+    culling.beginFrame(MakeViewProj());
+
+    Wall wall(-10.f, 3.f);
+    OccluderMesh mesh = wall.getMesh();
+    culling.renderOccluders(std::span(&mesh, 1));
+
+    /// a box is only occluded if it lies completely inside the wall's shadow volume from the camera
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    UInt32 occluded = 0;
+    for (int i = 0; i < 5000; ++i) {
+        float    depth  = 11.f + (unit(rng) * 0.5f + 0.5f) * 40.f;
+        Vector3f center(unit(rng) * depth * 0.5f, unit(rng) * depth * 0.5f, -depth);
+        Vector3f extent(0.2f + (unit(rng) * 0.5f + 0.5f));
+        AABB     box(center, extent);
+        if (culling.testOccludee(box) != kOcclusionOccluded) continue;
+        ++occluded;
+
+        for (int c = 0; c < 8; ++c) {
+            Vector3f corner = center + extent * Vector3f(c & 1 ? 1.f : -1.f, c & 2 ? 1.f : -1.f, c & 4 ? 1.f : -1.f);
+            /// project the corner onto the wall plane along the view ray
+            Vector3f onWall = corner * (-10.f / corner.z);
+            EXPECT_LE(std::abs(onWall.x), 3.f);
+            EXPECT_LE(std::abs(onWall.y), 3.f);
+            EXPECT_LT(corner.z, -10.f);
+        }
+    }
+    EXPECT_GT(occluded, 0);
+}
+
+TEST(OcclusionCulling, HiZIsMaxOfChildren) {
+    OcclusionCullingSettings settings;
+    settings.width  = 100; // odd sized levels
+    settings.height = 60;
+
+    OcclusionCulling culling;
+    culling.setSettings(settings);
+    culling.beginFrame(MakeViewProj());
+
+    Wall near(-5.f, 1.f), far(-30.f, 20.f);
+    OccluderMesh meshes[] = { near.getMesh(), far.getMesh() };
+    culling.renderOccluders(meshes);
+
+    EXPECT_EQ(culling.getWidth(), 100);
+    ASSERT_GT(culling.getHiZLevelCount(), 1);
+    for (UInt32 level = 1; level < culling.getHiZLevelCount(); ++level) {
+        UInt32 srcWidth  = std::max(1U, (culling.getWidth() + (1 << (level - 1)) - 1) >> (level - 1));
+        UInt32 srcHeight = std::max(1U, (culling.getHeight() + (1 << (level - 1)) - 1) >> (level - 1));
+        for (UInt32 y = 0; y < srcHeight; ++y) {
+            for (UInt32 x = 0; x < srcWidth; ++x) {
+                EXPECT_GE(culling.getDepth(level, x / 2, y / 2), culling.getDepth(level - 1, x, y));
+            }
+        }
+    }
+
+    const OcclusionCullingStats &stats = culling.getStats();
+    EXPECT_EQ(stats.occluderCount, 2);
+    EXPECT_EQ(stats.occluderTriangleCount, 4);
+}
+
+TEST(OcclusionCulling, SelectOccluders) {
+    OcclusionCullingSettings settings;
+    settings.maxOccluders          = 2;
+    settings.minOccluderScreenSize = 0.1f;
+
+    OcclusionCulling culling;
+    culling.setSettings(settings);
+    culling.beginFrame(MakeViewProj());
+
+    std::vector<OccluderCandidate> candidates = {
+        { AABB(Vector3f(0.f, 0.f, -50.f), Vector3f(0.5f)), false }, // 0, too small
+        { AABB(Vector3f(0.f, 0.f, -10.f), Vector3f(5.f)), false },  // 1, large
+        { AABB(Vector3f(0.f, 0.f, -50.f), Vector3f(0.5f)), true },  // 2, small but flagged
+        { AABB(Vector3f(0.f, 0.f, -20.f), Vector3f(5.f)), false },  // 3, smaller than 1
+        { AABB(Vector3f(0.f, 0.f, 20.f), Vector3f(5.f)), true },    // 4, outside the view
+    };
+
+    std::vector<UInt32> selected;
+    culling.selectOccluders(candidates, selected);
+    ASSERT_EQ(selected.size(), 2);
+    EXPECT_EQ(selected[0], 2);
+    EXPECT_EQ(selected[1], 1);
+
+    settings.autoSelectOccluders = false;
+    culling.setSettings(settings);
+    culling.beginFrame(MakeViewProj());
+    culling.selectOccluders(candidates, selected);
+    ASSERT_EQ(selected.size(), 1);
+    EXPECT_EQ(selected[0], 2);
+}
+
+TEST(OcclusionCulling, BatchStats) {
+    OcclusionCulling culling;
+    culling.beginFrame(MakeViewProj());
+
+    Wall wall(-10.f);
+    OccluderMesh mesh = wall.getMesh();
+    culling.renderOccluders(std::span(&mesh, 1));
+
+    std::vector<AABB> bounds;
+    for (int i = 0; i < 1000; ++i) {
+        bounds.emplace_back(Vector3f(0.f, 0.f, -20.f), Vector3f(1.f)); // occluded
+        bounds.emplace_back(Vector3f(0.f, 0.f, -5.f), Vector3f(1.f));  // visible
+        bounds.emplace_back(Vector3f(0.f, 0.f, 20.f), Vector3f(1.f));  // behind camera
+    }
+
+    std::vector<OcclusionResult> results(bounds.size());
+    culling.testOccludees(bounds, results);
+
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        EXPECT_EQ(results[i], culling.testOccludee(bounds[i]));
+    }
+
+    const OcclusionCullingStats &stats = culling.getStats();
+    EXPECT_EQ(stats.occludeeCount, 3000);
+    EXPECT_EQ(stats.occlusionCulledCount, 1000);
+    EXPECT_EQ(stats.frustumCulledCount, 1000);
+    EXPECT_GE(stats.testMs, 0.f);
+}
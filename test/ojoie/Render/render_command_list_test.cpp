@@ -0,0 +1,156 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/Material.hpp>
+#include <ojoie/Render/RenderCommandList.hpp>
+#include <ojoie/Render/RenderContext.hpp>
+#include <ojoie/Render/Shader/Shader.hpp>
+
+#include <cstddef>
+#include <vector>
+
+using namespace AN;
+
+TEST(RenderCommandList, TransientAllocator) {
+    TransientAllocator allocator(256);
+
+    void *p0 = allocator.allocate(12, 4);
+    void *p1 = allocator.allocate(64, 64);
+    EXPECT_EQ((size_t) p1 % 64, 0);
+    EXPECT_NE(p0, p1);
+
+    /// larger than block size gets a dedicated block
+    void *p2 = allocator.allocate(1024, 16);
+    EXPECT_NE(p2, nullptr);
+    EXPECT_GE(allocator.getReservedBytes(), 1024 + 256);
+
+    size_t reserved = allocator.getReservedBytes();
+    allocator.reset();
+    EXPECT_EQ(allocator.getUsedBytes(), 0);
+
+    /// memory is recycled after reset
+    allocator.allocate(12, 4);
+    allocator.allocate(64, 64);
+    EXPECT_EQ(allocator.getReservedBytes(), reserved);
+}
+
+TEST(RenderCommandList, DeterministicOrder) {
+    constexpr size_t kItemCount = 20000;
+
+    ParallelRenderEncoder encoder;
+
+    for (int frame = 0; frame < 3; ++frame) {
+        encoder.encode(kItemCount, ParallelRenderEncoder::kDefaultChunkSize,
+                       [](RenderCommandList &list, size_t index) {
+                           Matrix4x4f matrix(1.f);
+                           matrix[3][0] = (float) index;
+                           const PerDrawData *perDraw = list.allocatePerDraw(matrix, matrix);
+                           list.drawIndexed(nullptr, "Forward", perDraw, nullptr, 3, (UInt32) index, 0);
+                       });
+
+        ASSERT_EQ(encoder.getCommandCount(), kItemCount);
+
+        RenderCommandList merged;
+        encoder.merge(merged);
+
+        auto commands = merged.getCommands();
+        ASSERT_EQ(commands.size(), kItemCount);
+        for (size_t i = 0; i < commands.size(); ++i) {
+            EXPECT_EQ(commands[i].type, kRenderCommandDrawIndexed);
+            EXPECT_EQ(commands[i].indexOffset, i);
+            EXPECT_EQ(commands[i].perDraw->objectToWorld[3][0], (float) i);
+        }
+    }
+}
+
+static std::vector<size_t> gReplayOrder;
+
+TEST(RenderCommandList, CallbackReplay) {
+    ParallelRenderEncoder encoder;
+    encoder.encode(1000, 7, [](RenderCommandList &list, size_t index) {
+        size_t *slot = (size_t *) list.allocate(sizeof(size_t), alignof(size_t));
+        *slot = index;
+        list.callback([](RenderContext &context, void *userdata, const char *pass) {
+            gReplayOrder.push_back(*(size_t *) userdata);
+        }, slot, "Forward");
+    });
+
+    EXPECT_EQ(encoder.getChunkCount(), (1000 + 6) / 7);
+
+    RenderContext context{};
+    gReplayOrder.clear();
+    encoder.execute(context);
+
+    ASSERT_EQ(gReplayOrder.size(), 1000);
+    for (size_t i = 0; i < gReplayOrder.size(); ++i) {
+        EXPECT_EQ(gReplayOrder[i], i);
+    }
+}
+
+static const EncodedConstant *FindConstant(const EncodedMaterial &encoded, const char *name) {
+    for (const EncodedConstant &constant : encoded.constants) {
+        if (constant.name == Name(name)) return &constant;
+    }
+    return nullptr;
+}
+
+TEST(RenderCommandList, EncodesMaterial) {
+    InitializeRenderContext(kGraphicsAPID3D11);
+
+    Shader *shader = NewObject<Shader>();
+    ASSERT_TRUE(shader->initWithScript(AN_SHADER_ROOT "/Default.shader"));
+
+    Material *material = NewObject<Material>();
+    material->init(shader, "EncodedMaterial");
+    material->setVector("_MainColor", Vector4f(0.25f, 0.5f, 0.75f, 1.f));
+
+    Matrix4x4f         matrix(1.f);
+    RenderCommandList  list;
+    const PerDrawData *perDraw = list.allocatePerDraw(matrix, matrix, 0.5f);
+
+    /// the variant is not selected yet, the command applies the material when replayed
+    list.drawIndexed(material, "Forward", perDraw, nullptr, 3, 0, 0);
+    EXPECT_EQ(list.getCommands()[0].encoded, nullptr);
+
+    UInt32 passIndex = shader->getPassIndex("Forward");
+    const Shader::Variant &variant = shader->getVariant(passIndex, 0, ShaderKeywordSet());
+
+    list.reset();
+    perDraw = list.allocatePerDraw(matrix, matrix, 0.5f);
+    list.drawIndexed(material, "Forward", perDraw, nullptr, 3, 0, 0);
+    list.drawIndexed(material, "Forward", perDraw, nullptr, 3, 3, 0);
+
+    /// later edits do not leak into what was encoded
+    material->setVector("_MainColor", Vector4f(1.f));
+
+    auto commands = list.getCommands();
+    ASSERT_EQ(commands.size(), 2U);
+    ASSERT_NE(commands[0].encoded, nullptr);
+    EXPECT_EQ(commands[0].encoded, commands[1].encoded);
+
+    const EncodedMaterial &encoded = *commands[0].encoded;
+    EXPECT_EQ(encoded.pipelineState, variant.renderPipelineState);
+
+    const EncodedConstant *mainColor = FindConstant(encoded, "_MainColor");
+    ASSERT_NE(mainColor, nullptr);
+    ASSERT_EQ(mainColor->source, EncodedConstant::kSourceMaterial);
+    EXPECT_FLOAT_EQ(((const float *) mainColor->data)[1], 0.5f);
+
+    const EncodedConstant *lodFade = FindConstant(encoded, "an_LODFade");
+    ASSERT_NE(lodFade, nullptr);
+    EXPECT_EQ(lodFade->source, EncodedConstant::kSourcePerDraw);
+    EXPECT_EQ(lodFade->perDrawOffset, offsetof(PerDrawData, lodFade));
+
+    /// camera and shadow globals are set between encoding and replay
+    const EncodedConstant *viewProj = FindConstant(encoded, "an_MatrixVP");
+    ASSERT_NE(viewProj, nullptr);
+    EXPECT_EQ(viewProj->source, EncodedConstant::kSourceGlobal);
+
+    DestroyObject(material);
+    DestroyObject(shader);
+
+    DeallocRenderContext();
+}
@@ -0,0 +1,135 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/Shader/ShaderCache.hpp>
+#include <ojoie/Utility/Hash128.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace AN;
+
+namespace fs = std::filesystem;
+
+class ShaderCacheTest : public ::testing::Test {
+protected:
+    fs::path    directory;
+    ShaderCache cache;
+
+    void SetUp() override {
+        directory = fs::temp_directory_path() / ("ojoie_shader_cache_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                                                  ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(directory);
+        cache.setDirectory(directory.string());
+    }
+
+    void TearDown() override {
+        cache.setDirectory("");
+        fs::remove_all(directory);
+    }
+
+    static std::vector<UInt8> Blob(size_t size, UInt8 value) {
+        return std::vector<UInt8>(size, value);
+    }
+};
+
+TEST(Hash128, KnownVector) {
+    EXPECT_EQ(ComputeHash128("The quick brown fox jumps over the lazy dog").toString(), "e34bbc7bbc071b6c7a433ca9c49a9347");
+    EXPECT_NE(ComputeHash128("a"), ComputeHash128("b"));
+    EXPECT_NE(ComputeHash128("a", 1, 0), ComputeHash128("a", 1, 1));
+}
+
+TEST_F(ShaderCacheTest, KeyCoversAllInputs) {
+    const char *defines[]  = { "SHADOWS", "LIGHTS=4" };
+    const char *defines2[] = { "SHADOWS", "LIGHTS=8" };
+    Hash128 key = ShaderCache::ComputeKey("float4 main();", "vertex_main", "vs_5_0", defines, "d3dcompiler 47");
+
+    EXPECT_EQ(key, ShaderCache::ComputeKey("float4 main();", "vertex_main", "vs_5_0", defines, "d3dcompiler 47"));
+    EXPECT_NE(key, ShaderCache::ComputeKey("float4 main(); ", "vertex_main", "vs_5_0", defines, "d3dcompiler 47"));
+    EXPECT_NE(key, ShaderCache::ComputeKey("float4 main();", "fragment_main", "vs_5_0", defines, "d3dcompiler 47"));
+    EXPECT_NE(key, ShaderCache::ComputeKey("float4 main();", "vertex_main", "ps_5_0", defines, "d3dcompiler 47"));
+    EXPECT_NE(key, ShaderCache::ComputeKey("float4 main();", "vertex_main", "vs_5_0", defines2, "d3dcompiler 47"));
+    EXPECT_NE(key, ShaderCache::ComputeKey("float4 main();", "vertex_main", "vs_5_0", {}, "d3dcompiler 47"));
+    EXPECT_NE(key, ShaderCache::ComputeKey("float4 main();", "vertex_main", "vs_5_0", defines, "d3dcompiler 48"));
+
+    /// text moved from one part to the next is a different key
+    EXPECT_NE(ShaderCache::ComputeKey("ab", "c", "vs_5_0", {}, ""), ShaderCache::ComputeKey("a", "bc", "vs_5_0", {}, ""));
+}
+
+TEST_F(ShaderCacheTest, StoreAndLoad) {
+    Hash128 key = ShaderCache::ComputeKey("source", "vertex_main", "vs_5_0", {}, "test");
+    std::vector<UInt8> blob;
+    EXPECT_FALSE(cache.load(key, blob));
+
+    cache.store(key, Blob(1000, 7));
+    ASSERT_TRUE(cache.load(key, blob));
+    EXPECT_EQ(blob, Blob(1000, 7));
+
+    /// entries of an earlier run are found again
+    ShaderCache other;
+    other.setDirectory(directory.string());
+    EXPECT_EQ(other.getStats().entryCount, 1);
+    ASSERT_TRUE(other.load(key, blob));
+    EXPECT_EQ(blob, Blob(1000, 7));
+
+    ShaderCacheStats stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.entryCount, 1);
+}
+
+TEST_F(ShaderCacheTest, DamagedEntryIsRemoved) {
+    Hash128 key = ShaderCache::ComputeKey("source", "fragment_main", "ps_5_0", {}, "test");
+    cache.store(key, Blob(256, 1));
+
+    fs::path path = directory / (key.toString() + ".bin");
+    ASSERT_TRUE(fs::exists(path));
+    fs::resize_file(path, 100);
+
+    std::vector<UInt8> blob;
+    EXPECT_FALSE(cache.load(key, blob));
+    EXPECT_FALSE(fs::exists(path));
+    EXPECT_EQ(cache.getStats().entryCount, 0);
+
+    /// an entry renamed to another key is rejected as well
+    Hash128 other = ShaderCache::ComputeKey("other", "fragment_main", "ps_5_0", {}, "test");
+    cache.store(key, Blob(256, 1));
+    fs::copy_file(path, directory / (other.toString() + ".bin"));
+    cache.setDirectory(directory.string());
+    EXPECT_FALSE(cache.load(other, blob));
+    EXPECT_TRUE(cache.load(key, blob));
+}
+
+TEST_F(ShaderCacheTest, LeastRecentlyUsedEviction) {
+    /// room for about four entries
+    cache.setDirectory(directory.string(), 4200);
+
+    std::vector<Hash128> keys;
+    for (int i = 0; i < 4; ++i) {
+        keys.push_back(ShaderCache::ComputeKey("source" + std::to_string(i), "vertex_main", "vs_5_0", {}, "test"));
+        cache.store(keys.back(), Blob(1000, (UInt8) i));
+    }
+    EXPECT_EQ(cache.getStats().evictions, 0);
+
+    /// using the first entry makes the second one the oldest
+    std::vector<UInt8> blob;
+    ASSERT_TRUE(cache.load(keys[0], blob));
+
+    Hash128 newKey = ShaderCache::ComputeKey("source4", "vertex_main", "vs_5_0", {}, "test");
+    cache.store(newKey, Blob(1000, 4));
+
+    ShaderCacheStats stats = cache.getStats();
+    EXPECT_GT(stats.evictions, 0);
+    EXPECT_LE(stats.size, 4200);
+    EXPECT_FALSE(cache.load(keys[1], blob));
+    EXPECT_TRUE(cache.load(keys[0], blob));
+    EXPECT_TRUE(cache.load(newKey, blob));
+    EXPECT_FALSE(fs::exists(directory / (keys[1].toString() + ".bin")));
+
+    cache.clear();
+    EXPECT_EQ(cache.getStats().entryCount, 0);
+    EXPECT_TRUE(fs::is_empty(directory));
+}
@@ -0,0 +1,217 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/Shader/ShaderIncludeCache.hpp>
+#include <ojoie/ShaderLab/Lexer.hpp>
+#include <ojoie/ShaderLab/Parser.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace AN;
+
+namespace fs = std::filesystem;
+
+class ShaderIncludeCacheTest : public ::testing::Test {
+protected:
+    fs::path                  directory;
+    std::string               directoryString;
+    std::vector<const char *> includePaths;
+    ShaderIncludeCache        cache;
+
+    void SetUp() override {
+        directory = fs::temp_directory_path() / ("ojoie_include_cache_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                                                  ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(directory);
+        fs::create_directories(directory / "lib");
+        directoryString = (directory / "lib").string();
+        includePaths    = { directoryString.c_str() };
+    }
+
+    void TearDown() override {
+        fs::remove_all(directory);
+    }
+
+    void write(const char *name, std::string_view text) {
+        std::ofstream file(directory / "lib" / name, std::ios::binary | std::ios::trunc);
+        file << text;
+    }
+
+    std::string expand(std::string_view source, std::vector<std::string> *dependencies = nullptr) {
+        std::string result;
+        cache.expand(source, "Test", includePaths, result, dependencies);
+        return result;
+    }
+};
+
+static size_t Count(std::string_view text, std::string_view pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string_view::npos; pos = text.find(pattern, pos + 1)) ++count;
+    return count;
+}
+
+TEST_F(ShaderIncludeCacheTest, GuardedFilesOnce) {
+    write("Guarded.hlsl", "// header\n#ifndef GUARDED_HLSL\n#define GUARDED_HLSL\n#include \"Once.hlsl\"\nfloat guarded;\n#endif//GUARDED_HLSL\n");
+    write("Once.hlsl", "#pragma once\nfloat once;\n");
+    write("Plain.hlsl", "float plain;\n");
+
+    std::vector<std::string> dependencies;
+    std::string result = expand("#include \"Guarded.hlsl\"\n#include <Once.hlsl>\n#include \"Plain.hlsl\"\n#include \"Plain.hlsl\"\nfloat4 main();\n",
+                                &dependencies);
+
+    EXPECT_EQ(Count(result, "float guarded;"), 1);
+    EXPECT_EQ(Count(result, "float once;"), 1);
+    EXPECT_EQ(Count(result, "float plain;"), 2);
+    EXPECT_EQ(Count(result, "#include"), 0);
+    EXPECT_NE(result.find("#line 1 \"Once.hlsl\""), std::string::npos);
+    EXPECT_NE(result.find("#line 5 \"Test\""), std::string::npos);
+    EXPECT_EQ(dependencies.size(), 3);
+
+    /// each file is read once, the second expansion reuses the expanded includes
+    EXPECT_EQ(expand("#include \"Guarded.hlsl\"\n"), expand("#include \"Guarded.hlsl\"\n"));
+    ShaderIncludeCacheStats stats = cache.getStats();
+    EXPECT_EQ(stats.fileLoads, 3);
+    EXPECT_EQ(stats.fileCount, 3);
+    EXPECT_GT(stats.expandedHits, 0);
+}
+
+TEST_F(ShaderIncludeCacheTest, ConditionalIncludes) {
+    write("Guarded.hlsl", "#ifndef GUARDED_HLSL\n#define GUARDED_HLSL\nfloat guarded;\n#endif\n");
+
+    /// the first include may be dropped by the preprocessor, so the second one stays
+    std::string result = expand("#ifdef FEATURE\n#include \"Guarded.hlsl\"\n#endif\n#include \"Guarded.hlsl\"\n");
+    EXPECT_EQ(Count(result, "float guarded;"), 2);
+
+    result = expand("#include \"Guarded.hlsl\"\n#ifdef FEATURE\n#include \"Guarded.hlsl\"\n#endif\n");
+    EXPECT_EQ(Count(result, "float guarded;"), 1);
+
+    /// a file with code after its #endif is not guarded
+    write("Open.hlsl", "#ifndef OPEN_HLSL\n#define OPEN_HLSL\n#endif\nfloat open;\n");
+    EXPECT_EQ(Count(expand("#include \"Open.hlsl\"\n#include \"Open.hlsl\"\n"), "float open;"), 2);
+
+    /// a missing include is left to the preprocessor
+    result = expand("#include \"Missing.hlsl\"\nfloat4 main();\n");
+    EXPECT_NE(result.find("#include \"Missing.hlsl\""), std::string::npos);
+}
+
+TEST_F(ShaderIncludeCacheTest, IncludeCycle) {
+    write("A.hlsl", "#include \"B.hlsl\"\nfloat a;\n");
+    write("B.hlsl", "#include \"A.hlsl\"\nfloat b;\n");
+
+    std::string result = expand("#include \"A.hlsl\"\n");
+    EXPECT_EQ(Count(result, "float a;"), 1);
+    EXPECT_EQ(Count(result, "float b;"), 1);
+}
+
+TEST_F(ShaderIncludeCacheTest, InvalidateOnlyDependents) {
+    write("Common.hlsl", "#pragma once\nfloat common;\n");
+    write("Lighting.hlsl", "#pragma once\n#include \"Common.hlsl\"\nfloat lighting;\n");
+    write("Noise.hlsl", "#pragma once\nfloat noise;\n");
+
+    expand("#include \"Lighting.hlsl\"\n#include \"Noise.hlsl\"\n");
+    ShaderIncludeCacheStats stats = cache.getStats();
+    EXPECT_EQ(stats.fileLoads, 3);
+    EXPECT_EQ(stats.expansions, 3);
+
+    /// saving without changes keeps everything
+    EXPECT_FALSE(cache.invalidate((directory / "lib" / "Common.hlsl").string()));
+
+    write("Common.hlsl", "#pragma once\nfloat common2;\n");
+    EXPECT_TRUE(cache.invalidate((directory / "lib" / "Common.hlsl").string()));
+    cache.resetStats();
+
+    std::string result = expand("#include \"Lighting.hlsl\"\n#include \"Noise.hlsl\"\n");
+    EXPECT_NE(result.find("float common2;"), std::string::npos);
+    EXPECT_NE(result.find("float noise;"), std::string::npos);
+
+    /// Common is read again, Common and Lighting expand again, Noise is reused as it was
+    stats = cache.getStats();
+    EXPECT_EQ(stats.fileLoads, 1);
+    EXPECT_EQ(stats.expansions, 2);
+    EXPECT_EQ(stats.expandedHits, 1);
+
+    /// a file never included invalidates nothing
+    EXPECT_FALSE(cache.invalidate((directory / "lib" / "Unknown.hlsl").string()));
+}
+
+#if defined(AN_SHADER_ROOT) && defined(AN_SHADER_STDLIB)
+
+TEST(ShaderIncludeCache, BuiltinShaders) {
+    /// pass sources as Shader::setScriptText builds them
+    std::vector<std::string> sources;
+    for (const fs::directory_entry &entry : fs::directory_iterator(AN_SHADER_ROOT)) {
+        if (entry.path().extension() != ".shader") continue;
+        std::ifstream     file(entry.path(), std::ios::binary);
+        std::stringstream text;
+        text << file.rdbuf();
+        std::string script = text.str();
+
+        ShaderLab::Lexer      lexer(script.c_str());
+        ShaderLab::Parser     parser(lexer);
+        ShaderLab::ShaderInfo info = parser.parse();
+        if (parser.hasError()) continue;
+        for (size_t subShader = 0; subShader < info.subShaders.size(); ++subShader) {
+            for (const std::string &pass : info.passHLSLSources[subShader]) {
+                sources.push_back(info.subShaderHLSLIncludes[subShader] + "\r\n" + pass);
+            }
+        }
+    }
+    ASSERT_FALSE(sources.empty());
+
+    const char *includePaths[] = { AN_SHADER_STDLIB };
+    const int   rounds         = 20;
+
+    /// without sharing, every stage reads and expands its includes again
+    Timer  timer;
+    size_t size = 0;
+    for (int round = 0; round < rounds; ++round) {
+        for (const std::string &source : sources) {
+            for (int stage = 0; stage < 2; ++stage) {
+                ShaderIncludeCache cache;
+                std::string        result;
+                cache.expand(source, "Builtin", includePaths, result);
+                size += result.size();
+            }
+        }
+    }
+    float uncachedMs = timer.mark() * 1000.f / rounds;
+
+    ShaderIncludeCache       cache;
+    std::vector<std::string> first(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        cache.expand(sources[i], "Builtin", includePaths, first[i]);
+    }
+    float coldMs = timer.mark() * 1000.f;
+
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < sources.size(); ++i) {
+            for (int stage = 0; stage < 2; ++stage) {
+                std::string result;
+                cache.expand(sources[i], "Builtin", includePaths, result);
+                EXPECT_EQ(result, first[i]);
+            }
+        }
+    }
+    float cachedMs = timer.mark() * 1000.f / rounds;
+
+    /// Core.hlsl is included by Core and again through Lighting, its guard keeps one copy
+    for (const std::string &result : first) {
+        EXPECT_LE(Count(result, "#define AN_COMMON_HLSL"), 1);
+    }
+
+    ShaderIncludeCacheStats stats = cache.getStats();
+    RecordProperty("passes", (int) sources.size());
+    RecordProperty("include_files", (int) stats.fileCount);
+    RecordProperty("uncached_ms", std::to_string(uncachedMs));
+    RecordProperty("cold_ms", std::to_string(coldMs));
+    RecordProperty("cached_ms", std::to_string(cachedMs));
+    EXPECT_EQ(stats.fileLoads, stats.fileCount);
+    EXPECT_GT(size, 0);
+}
+
+#endif
@@ -0,0 +1,155 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/QualitySettings.hpp>
+#include <ojoie/Render/ShadowCascades.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace AN;
+
+static ShadowCascadeSettings MakeSettings(UInt32 cascadeCount) {
+    ShadowCascadeSettings settings{};
+    settings.cascadeCount   = cascadeCount;
+    settings.resolution     = 1024;
+    settings.shadowDistance = 100.f;
+    settings.splitMode      = kShadowCascadeSplitLogarithmic;
+    settings.splitLambda    = 0.75f;
+    return settings;
+}
+
+static ShadowCascadeViewParams MakeViewParams(const Vector3f &lightDirection) {
+    ShadowCascadeViewParams viewParams;
+    viewParams.cameraToWorld  = Math::identity<Matrix4x4f>();// at origin looking down -z
+    viewParams.fovyRadians    = Math::radians(60.f);
+    viewParams.aspect         = 16.f / 9.f;
+    viewParams.nearZ          = 0.1f;
+    viewParams.farZ           = 1000.f;
+    viewParams.lightDirection = Math::normalize(lightDirection);
+    return viewParams;
+}
+
+static bool Contains(const std::vector<UInt32> &indices, UInt32 index) {
+    return std::find(indices.begin(), indices.end(), index) != indices.end();
+}
+
+TEST(ShadowCascades, Splits) {
+    ShadowCascadeSettings settings = MakeSettings(4);
+    settings.splitLambda = 1.f;
+
+    float splits[kMaxShadowCascades + 1];
+    ComputeShadowCascadeSplits(settings, 1.f, 1000.f, splits);
+    EXPECT_FLOAT_EQ(splits[0], 1.f);
+    EXPECT_NEAR(splits[1], std::pow(1000.f, 0.25f), 1e-3f);
+    EXPECT_NEAR(splits[2], std::pow(1000.f, 0.5f), 1e-3f);
+    EXPECT_FLOAT_EQ(splits[4], 1000.f);
+
+    settings.splitMode       = kShadowCascadeSplitManual;
+    settings.manualSplits[0] = 0.1f;
+    settings.manualSplits[1] = 0.3f;
+    settings.manualSplits[2] = 0.6f;
+    ComputeShadowCascadeSplits(settings, 0.f, 100.f, splits);
+    EXPECT_FLOAT_EQ(splits[1], 10.f);
+    EXPECT_FLOAT_EQ(splits[2], 30.f);
+    EXPECT_FLOAT_EQ(splits[3], 60.f);
+}
+
+TEST(ShadowCascades, ManualSplitsAreValidated) {
+    QualitySettings qualitySettings;
+    const float splits[] = { 0.6f, -1.f, 2.f };
+    qualitySettings.setShadowCascadeSplits(splits, 3);
+
+    const QualitySetting &setting = qualitySettings.getCurrent();
+    EXPECT_EQ(setting.shadowCascadeSplitMode, kShadowCascadeSplitManual);
+    EXPECT_GT(setting.shadowCascadeSplits[0], 0.f);
+    EXPECT_FLOAT_EQ(setting.shadowCascadeSplits[1], 0.6f);
+    EXPECT_LT(setting.shadowCascadeSplits[2], 1.f);
+
+    qualitySettings.setShadowCascadeSplitMode((ShadowCascadeSplitMode) 42);
+    EXPECT_EQ(qualitySettings.getCurrent().shadowCascadeSplitMode, kShadowCascadeSplitLogarithmic);
+}
+
+TEST(ShadowCascades, CasterCounts) {
+    ShadowCascadeSettings settings = MakeSettings(4);
+    ShadowCascade cascades[kMaxShadowCascades];
+    ASSERT_EQ(ComputeShadowCascades(settings, MakeViewParams({ 0.3f, 1.f, 0.2f }), cascades), 4);
+
+    std::vector<AABB> bounds;
+    bounds.emplace_back(Vector3f(0.f, 0.f, -2.f), Vector3f(0.5f));   // 0, near the camera
+    bounds.emplace_back(Vector3f(0.f, 0.f, -80.f), Vector3f(0.5f));  // 1, only in the last cascade
+    bounds.emplace_back(Vector3f(0.f, 0.f, -500.f), Vector3f(0.5f)); // 2, beyond shadow distance
+    bounds.emplace_back(Vector3f(500.f, 0.f, 0.f), Vector3f(0.5f));  // 3, far to the side
+
+    UInt32 total = 0;
+    for (UInt32 i = 0; i < 4; ++i) {
+        std::vector<UInt32> casters;
+        CullShadowCasters(cascades[i], bounds, casters);
+        EXPECT_FALSE(Contains(casters, 2));
+        EXPECT_FALSE(Contains(casters, 3));
+        total += casters.size();
+    }
+
+    std::vector<UInt32> casters;
+    CullShadowCasters(cascades[0], bounds, casters);
+    EXPECT_TRUE(Contains(casters, 0));
+    EXPECT_FALSE(Contains(casters, 1));
+
+    casters.clear();
+    CullShadowCasters(cascades[3], bounds, casters);
+    EXPECT_TRUE(Contains(casters, 1));
+
+    EXPECT_GE(total, 2);
+    EXPECT_LE(total, 5);
+}
+
+TEST(ShadowCascades, CasterOutsideViewFrustum) {
+    ShadowCascade cascades[kMaxShadowCascades];
+    ComputeShadowCascades(MakeSettings(2), MakeViewParams({ 0.f, 1.f, 0.f }), cascades);
+
+    std::vector<AABB> bounds;
+    bounds.emplace_back(Vector3f(0.f, 50.f, -3.f), Vector3f(1.f));  // above the view, between light and cascade
+    bounds.emplace_back(Vector3f(0.f, -50.f, -3.f), Vector3f(1.f)); // below the cascade, can not cast into it
+
+    std::vector<UInt32> casters;
+    CullShadowCasters(cascades[0], bounds, casters);
+    ASSERT_EQ(casters.size(), 1);
+    EXPECT_EQ(casters[0], 0);
+
+    FitShadowCascadeDepth(cascades[0], bounds, casters);
+    Vector4f clip = cascades[0].proj * cascades[0].view * Vector4f(bounds[0].center, 1.f);
+    EXPECT_GE(clip.z, 0.f);
+    EXPECT_LE(clip.z, 1.f);
+}
+
+TEST(ShadowCascades, TexelSnapping) {
+    ShadowCascadeSettings   settings   = MakeSettings(2);
+    ShadowCascadeViewParams viewParams = MakeViewParams({ 0.3f, 1.f, 0.2f });
+
+    ShadowCascade reference[kMaxShadowCascades];
+    ComputeShadowCascades(settings, viewParams, reference);
+
+    for (int step = 0; step < 16; ++step) {
+        float angle = (float) step * 0.4f;
+        viewParams.cameraToWorld = Math::translate(Vector3f(step * 0.137f, 0.f, step * -0.291f)) *
+                                   Math::rotate(angle, Vector3f(0.f, 1.f, 0.f));
+
+        ShadowCascade cascades[kMaxShadowCascades];
+        ComputeShadowCascades(settings, viewParams, cascades);
+
+        for (UInt32 i = 0; i < 2; ++i) {
+            /// size does not depend on camera orientation
+            EXPECT_FLOAT_EQ(cascades[i].texelSize, reference[i].texelSize);
+
+            /// light space translation is a whole number of texels
+            for (int axis = 0; axis < 2; ++axis) {
+                float texels = cascades[i].view[3][axis] / cascades[i].texelSize;
+                EXPECT_NEAR(texels, std::round(texels), 1e-2f);
+            }
+        }
+    }
+}
@@ -0,0 +1,136 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Core/Actor.hpp>
+#include <ojoie/Render/Mesh/SkinnedMeshRenderer.h>
+#include <ojoie/Render/Mesh/SkinningManager.hpp>
+#include <ojoie/Render/RenderCommandList.hpp>
+#include <ojoie/Render/RenderContext.hpp>
+#include <ojoie/Render/Shader/Shader.hpp>
+
+using namespace AN;
+
+/// one triangle skinned to the actor transform
+static Mesh *MakeSkinnedTriangle() {
+    const Vector3f   vertices[] = { { 0.f, 0.f, 0.f }, { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f } };
+    const Vector3f   normals[]  = { { 0.f, 0.f, 1.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f, 1.f } };
+    const UInt16     indices[]  = { 0, 1, 2 };
+    const Matrix4x4f bindpose   = Math::identity<Matrix4x4f>();
+
+    BoneWeight weights[3]{};
+    for (BoneWeight &weight : weights) {
+        weight.weights[0]     = 1.f;
+        weight.boneIndices[0] = 0;
+    }
+
+    Mesh *mesh = NewObject<Mesh>();
+    mesh->init();
+    mesh->setVertices(vertices, 3);
+    mesh->setNormals(normals, 3);
+    mesh->setSubMeshCount(1);
+    mesh->setIndices(indices, 3, 0);
+    mesh->setBindposes(&bindpose, 1);
+    mesh->setBoneWeights(weights, 3);
+    mesh->createVertexBuffer();
+    return mesh;
+}
+
+TEST(SkinnedMeshRenderer, EncodesLODFade) {
+    InitializeRenderContext(kGraphicsAPID3D11);
+
+    Shader *shader = NewObject<Shader>();
+    ASSERT_TRUE(shader->initWithScript(AN_SHADER_ROOT "/Default.shader"));
+
+    Material *material = NewObject<Material>();
+    material->init(shader, "SkinnedMaterial");
+    ASSERT_TRUE(material->hasPass("ShadowCaster"));
+
+    Mesh *mesh = MakeSkinnedTriangle();
+
+    Actor *actor = NewObject<Actor>();
+    actor->init("SkinnedActor");
+
+    SkinnedMeshRenderer *renderer = actor->addComponent<SkinnedMeshRenderer>();
+    renderer->SetBones({ actor->getTransform() });
+    renderer->SetMesh(mesh);
+    renderer->setMaterial(0, material);
+
+    /// what the lod group sets while the coarser level fades in
+    renderer->setLODState(false, -0.25f);
+    renderer->Update(0);
+
+    RenderCommandList list;
+    renderer->Encode(list, 0, "ShadowCaster");
+
+    ASSERT_EQ(list.size(), 1U);
+    const RenderCommand &command = list.getCommands()[0];
+    ASSERT_NE(command.perDraw, nullptr);
+
+    /// an_LODFade is set from the per draw data when the list is executed
+    EXPECT_FLOAT_EQ(command.perDraw->lodFade.x, -0.25f);
+    EXPECT_FLOAT_EQ(command.perDraw->vertexCompression.x, 0.f);
+
+    DestroyActor(actor);
+    DestroyObject(material);
+    DestroyObject(mesh);
+    DestroyObject(shader);
+
+    DeallocRenderContext();
+}
+
+TEST(SkinnedMeshRenderer, SkinsShownRendererOnStoppedSkeleton) {
+    InitializeRenderContext(kGraphicsAPID3D11);
+
+    Mesh *mesh = MakeSkinnedTriangle();
+
+    Actor *actor = NewObject<Actor>();
+    actor->init("SkinnedActor");
+
+    /// two lod levels on one skeleton
+    SkinnedMeshRenderer *lod0 = actor->addComponent<SkinnedMeshRenderer>();
+    lod0->SetBones({ actor->getTransform() });
+    lod0->SetMesh(mesh);
+
+    Actor *lod1Actor = NewObject<Actor>();
+    lod1Actor->init("SkinnedLOD1Actor");
+    SkinnedMeshRenderer *lod1 = lod1Actor->addComponent<SkinnedMeshRenderer>();
+    lod1->SetBones({ actor->getTransform() });
+    lod1->SetMesh(mesh);
+
+    SkinningManager &manager = GetSkinningManager();
+
+    lod1->setLODState(true, 0.f);
+    lod0->Update(0);
+    lod1->Update(0);
+    manager.update(0);
+    EXPECT_EQ(manager.getSkinnedVertexCount(), 3U);
+
+    /// the skeleton stopped, the level shown now was never skinned in its pose
+    lod0->setLODState(true, 0.f);
+    lod1->setLODState(false, 1.f);
+    lod0->Update(0);
+    lod1->Update(0);
+    manager.update(0);
+    EXPECT_EQ(manager.getSkinnedVertexCount(), 3U);
+
+    /// nothing moved since
+    lod0->Update(0);
+    lod1->Update(0);
+    manager.update(0);
+    EXPECT_EQ(manager.getSkinnedVertexCount(), 0U);
+
+    /// a new mesh is skinned even though the skeleton did not move
+    lod1->SetMesh(mesh);
+    lod1->Update(0);
+    manager.update(0);
+    EXPECT_EQ(manager.getSkinnedVertexCount(), 3U);
+
+    DestroyActor(lod1Actor);
+    DestroyActor(actor);
+    DestroyObject(mesh);
+
+    DeallocRenderContext();
+}
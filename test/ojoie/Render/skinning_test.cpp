@@ -0,0 +1,183 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/Mesh/SkinningManager.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace AN;
+
+static Matrix4x4f RandomBoneMatrix(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    Vector3f axis = Math::normalize(Vector3f(unit(rng), unit(rng), unit(rng)) + Vector3f(0.f, 0.f, 2.f));
+    return Math::translate(Vector3f(unit(rng), unit(rng), unit(rng)) * 5.f) *
+           Math::rotate(unit(rng) * 3.14f, axis);
+}
+
+struct SkinnedVertices {
+    std::vector<Vector3f>   positions, normals;
+    std::vector<Vector4f>   tangents;
+    std::vector<BoneWeight> boneWeights;
+
+    SkinnedVertices(UInt32 count, int boneCount, std::mt19937 &rng) {
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+        std::uniform_int_distribution<int>    bone(0, boneCount - 1);
+        for (UInt32 i = 0; i < count; ++i) {
+            positions.emplace_back(unit(rng), unit(rng), unit(rng));
+            normals.push_back(Math::normalize(Vector3f(unit(rng), unit(rng), 1.5f)));
+            tangents.emplace_back(Math::normalize(Vector3f(1.5f, unit(rng), unit(rng))), i % 2 ? 1.f : -1.f);
+
+            BoneWeight boneWeight;
+            float sum = 0.f;
+            for (int j = 0; j < 4; ++j) {
+                boneWeight.boneIndices[j] = bone(rng);
+                boneWeight.weights[j]     = unit(rng) * 0.5f + 0.5f;
+                sum += boneWeight.weights[j];
+            }
+            for (float &weight : boneWeight.weights) weight /= sum;
+            boneWeights.push_back(boneWeight);
+        }
+    }
+
+    SkinningInput input() const {
+        return { positions.data(), normals.data(), tangents.data(), boneWeights.data() };
+    }
+};
+
+struct SkinnedOutput {
+    std::vector<Vector3f> positions, normals;
+    std::vector<Vector4f> tangents;
+
+    explicit SkinnedOutput(UInt32 count) : positions(count), normals(count), tangents(count) {}
+
+    SkinningOutput output() {
+        return { StrideIterator<Vector3f>(positions.data(), sizeof(Vector3f)),
+                 StrideIterator<Vector3f>(normals.data(), sizeof(Vector3f)),
+                 StrideIterator<Vector4f>(tangents.data(), sizeof(Vector4f)) };
+    }
+};
+
+TEST(Skinning, Palette) {
+    std::mt19937 rng(1);
+    std::vector<Matrix4x4f> bones, bindposes, palette(16);
+    for (int i = 0; i < 16; ++i) {
+        bones.push_back(RandomBoneMatrix(rng));
+        bindposes.push_back(Math::inverse(RandomBoneMatrix(rng)));
+    }
+    ComputeSkinningPalette(bones.data(), bindposes.data(), bones.size(), palette.data());
+    for (int i = 0; i < 16; ++i) {
+        Matrix4x4f expected = bones[i] * bindposes[i];
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                EXPECT_NEAR(palette[i][c][r], expected[c][r], 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(Skinning, MatchesReference) {
+    std::mt19937 rng(2);
+    const UInt32 count = 3000;
+    std::vector<Matrix4x4f> palette;
+    for (int i = 0; i < 8; ++i) palette.push_back(RandomBoneMatrix(rng));
+    SkinnedVertices vertices(count, palette.size(), rng);
+    SkinnedOutput   skinned(count);
+
+    SkinningJob job{ palette.data(), vertices.input(), skinned.output(), count,
+                     VERTEX_FORMAT3(Vertex, Normal, Tangent) };
+    std::vector<SkinningBatch> batches;
+    SkinJobs({ &job, 1 }, batches);
+    EXPECT_EQ(batches.size(), (count + kSkinningBatchSize - 1) / kSkinningBatchSize);
+
+    /// four weighted transforms per vertex
+    for (UInt32 i = 0; i < count; ++i) {
+        const BoneWeight &boneWeight = vertices.boneWeights[i];
+        Vector3f position(0.f), normal(0.f), tangent(0.f);
+        for (int j = 0; j < 4; ++j) {
+            const Matrix4x4f &matrix = palette[boneWeight.boneIndices[j]];
+            position += Vector3f(matrix * Vector4f(vertices.positions[i], 1.f)) * boneWeight.weights[j];
+            normal += Vector3f(matrix * Vector4f(vertices.normals[i], 0.f)) * boneWeight.weights[j];
+            tangent += Vector3f(matrix * Vector4f(Vector3f(vertices.tangents[i]), 0.f)) * boneWeight.weights[j];
+        }
+        EXPECT_LT(Math::length(skinned.positions[i] - position), 1e-4f);
+        EXPECT_GT(Math::dot(skinned.normals[i], Math::normalize(normal)), 0.9999f);
+        EXPECT_GT(Math::dot(Vector3f(skinned.tangents[i]), Math::normalize(tangent)), 0.9999f);
+        EXPECT_EQ(skinned.tangents[i].w, vertices.tangents[i].w);
+    }
+}
+
+TEST(Skinning, SkipsUnusedChannels) {
+    std::mt19937 rng(3);
+    const UInt32 count = 100;
+    std::vector<Matrix4x4f> palette = { RandomBoneMatrix(rng), RandomBoneMatrix(rng) };
+    SkinnedVertices vertices(count, palette.size(), rng);
+    SkinnedOutput   skinned(count);
+
+    SkinningJob job{ palette.data(), vertices.input(), skinned.output(), count, VERTEX_FORMAT1(Vertex) };
+    SkinVertices(job, 0, count);
+    for (UInt32 i = 0; i < count; ++i) {
+        EXPECT_NE(skinned.positions[i], Vector3f(0.f));
+        EXPECT_EQ(skinned.normals[i], Vector3f(0.f));
+        EXPECT_EQ(skinned.tangents[i], Vector4f(0.f));
+    }
+
+    /// a mesh without normals is never skinned for them
+    job.channels      = VERTEX_FORMAT2(Vertex, Normal);
+    job.input.normals = nullptr;
+    SkinVertices(job, 0, count);
+    EXPECT_EQ(skinned.normals[0], Vector3f(0.f));
+}
+
+TEST(Skinning, ThousandCharacters) {
+    /// 1000 characters of 2000 vertices on 50 bones, 20 of them share each skeleton
+    const UInt32 characterCount = 1000, vertexCount = 2000, boneCount = 50, skeletonCount = 50;
+    std::mt19937 rng(4);
+
+    std::vector<Matrix4x4f> boneMatrices, bindposes;
+    for (UInt32 i = 0; i < skeletonCount * boneCount; ++i) boneMatrices.push_back(RandomBoneMatrix(rng));
+    for (UInt32 i = 0; i < boneCount; ++i) bindposes.push_back(Math::inverse(RandomBoneMatrix(rng)));
+
+    SkinnedVertices vertices(vertexCount, boneCount, rng);
+    std::vector<SkinnedOutput> outputs(characterCount, SkinnedOutput(vertexCount));
+
+    Timer timer;
+    std::vector<Matrix4x4f> palettes(skeletonCount * boneCount);
+    for (UInt32 i = 0; i < skeletonCount; ++i) {
+        ComputeSkinningPalette(boneMatrices.data() + i * boneCount, bindposes.data(), boneCount,
+                               palettes.data() + i * boneCount);
+    }
+    float paletteMs = timer.mark() * 1000.f;
+
+    std::vector<SkinningJob> jobs;
+    for (UInt32 i = 0; i < characterCount; ++i) {
+        jobs.push_back({ palettes.data() + (i % skeletonCount) * boneCount, vertices.input(), outputs[i].output(),
+                         vertexCount, VERTEX_FORMAT3(Vertex, Normal, Tangent) });
+    }
+    std::vector<SkinningBatch> batches;
+    timer.mark();
+    SkinJobs(jobs, batches);
+    float skinMs = timer.mark() * 1000.f;
+
+    jobs.clear();
+    for (UInt32 i = 0; i < characterCount; ++i) {
+        jobs.push_back({ palettes.data() + (i % skeletonCount) * boneCount, vertices.input(), outputs[i].output(),
+                         vertexCount, VERTEX_FORMAT1(Vertex) });
+    }
+    timer.mark();
+    SkinJobs(jobs, batches);
+    float positionsOnlyMs = timer.mark() * 1000.f;
+
+    RecordProperty("vertices", (int) (characterCount * vertexCount));
+    RecordProperty("palette_ms", std::to_string(paletteMs));
+    RecordProperty("skin_ms", std::to_string(skinMs));
+    RecordProperty("positions_only_ms", std::to_string(positionsOnlyMs));
+
+    /// characters on the same skeleton match
+    EXPECT_EQ(outputs[0].positions[vertexCount - 1], outputs[skeletonCount].positions[vertexCount - 1]);
+    EXPECT_NE(outputs[0].positions[vertexCount - 1], outputs[1].positions[vertexCount - 1]);
+}
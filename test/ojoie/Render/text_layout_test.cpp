@@ -0,0 +1,218 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/TextLayout.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace AN;
+
+/// monospaced glyphs pixelSize / 2 wide and advance, 'A' followed by 'V' kerns by -2, '#' has no glyph
+class TestRasterizer : public GlyphRasterizer {
+public:
+    virtual bool rasterize(FontID font, UInt32 codepoint, UInt32 pixelSize, bool bSDF, GlyphBitmap &outBitmap) override {
+        if (codepoint == '#') return false;
+        UInt16 width = codepoint == ' ' ? 0 : (UInt16) (pixelSize / 2), height = codepoint == ' ' ? 0 : (UInt16) pixelSize;
+        outBitmap.metrics = { (float) (pixelSize / 2), 1, (Int16) (pixelSize * 3 / 4), width, height };
+        outBitmap.pixels.assign((size_t) width * height, 255);
+        return true;
+    }
+
+    virtual FontLineMetrics getLineMetrics(FontID font, UInt32 pixelSize) override {
+        return { (float) pixelSize * 0.75f, -(float) pixelSize * 0.25f, (float) pixelSize * 1.25f };
+    }
+
+    virtual float getKerning(FontID font, UInt32 left, UInt32 right, UInt32 pixelSize) override {
+        return left == 'A' && right == 'V' ? -2.f : 0.f;
+    }
+};
+
+/// lay out until every glyph is placed
+static const TextLayout &LayoutReady(GlyphCache &glyphCache, TextLayoutCache &cache, std::string_view text, const TextStyle &style) {
+    while (!cache.layout(text, style).bComplete) {
+        glyphCache.flush();
+    }
+    return cache.layout(text, style);
+}
+
+TEST(TextLayout, PositionsKerningAndWrap) {
+    TestRasterizer  rasterizer;
+    GlyphCache      glyphCache(&rasterizer, { 256, 2, 1, 32, 2 });
+    TextLayoutCache cache(&glyphCache);
+    TextStyle       style{ 0, 16, false, 0.f };
+
+    const TextLayout &first = cache.layout("AVA", style);
+    EXPECT_FALSE(first.bComplete);
+    EXPECT_TRUE(first.vertices.empty());
+    glyphCache.flush();
+
+    const TextLayout &layout = cache.layout("AVA", style);
+    ASSERT_TRUE(layout.bComplete);
+    ASSERT_EQ(layout.vertices.size(), 12U);
+    ASSERT_EQ(layout.runs.size(), 1U);
+    EXPECT_EQ(layout.lineCount, 1U);
+    EXPECT_FLOAT_EQ(layout.width, 22.f);
+    EXPECT_FLOAT_EQ(layout.height, 20.f);
+
+    /// bearing 1, the top 12 above the baseline at the ascender 12
+    EXPECT_FLOAT_EQ(layout.vertices[0].x, 1.f);
+    EXPECT_FLOAT_EQ(layout.vertices[0].y, 0.f);
+    EXPECT_FLOAT_EQ(layout.vertices[2].x, 9.f);
+    EXPECT_FLOAT_EQ(layout.vertices[2].y, 16.f);
+    EXPECT_FLOAT_EQ(layout.vertices[4].x, 1.f + 8.f - 2.f);
+    EXPECT_FLOAT_EQ(layout.vertices[8].x, 1.f + 14.f);
+
+    const CachedGlyph *glyph;
+    ASSERT_EQ(glyphCache.getGlyph({ 0, 'A', 16, false }, glyph), kGlyphReady);
+    EXPECT_FLOAT_EQ(layout.vertices[0].u, (float) glyph->x / 256.f);
+    EXPECT_FLOAT_EQ(layout.vertices[2].v, (float) (glyph->y + 16) / 256.f);
+    EXPECT_EQ(cache.getStats().misses, 2U);
+
+    /// the same text and style is a hit
+    EXPECT_EQ(&cache.layout("AVA", style), &layout);
+    EXPECT_EQ(cache.getStats().hits, 1U);
+
+    /// missing glyphs fall back to '?', new lines and wrapped words
+    const TextLayout &missing = LayoutReady(glyphCache, cache, "a#b", style);
+    EXPECT_EQ(missing.vertices.size(), 12U);
+
+    const TextLayout &lines = LayoutReady(glyphCache, cache, "ab\ncd", style);
+    EXPECT_EQ(lines.lineCount, 2U);
+    EXPECT_FLOAT_EQ(lines.vertices[8].y, 20.f);
+
+    TextStyle         wrapped = style;
+    wrapped.wrapWidth         = 40.f;
+    const TextLayout &words   = LayoutReady(glyphCache, cache, "aaa bbb ccc", wrapped);
+    EXPECT_EQ(words.lineCount, 3U);
+    EXPECT_LE(words.width, 40.f);
+    EXPECT_FLOAT_EQ(words.vertices[12].x, 1.f);
+    EXPECT_FLOAT_EQ(words.vertices[12].y, 20.f);
+    EXPECT_FLOAT_EQ(words.vertices[24].y, 40.f);
+
+    /// UTF-8 is decoded to codepoints
+    const TextLayout &utf8 = LayoutReady(glyphCache, cache, "\xE4\xBD\xA0\xE5\xA5\xBD", style);
+    EXPECT_EQ(utf8.vertices.size(), 8U);
+    EXPECT_EQ(glyphCache.getGlyph({ 0, 0x4F60, 16, false }, glyph), kGlyphReady);
+}
+
+TEST(TextLayout, EvictionAndInvalidation) {
+    TestRasterizer  rasterizer;
+    GlyphCache      glyphCache(&rasterizer, { 64, 1, 1, 32, 1 });
+    TextLayoutCache cache(&glyphCache, 2);
+    TextStyle       style{ 0, 16, false, 0.f };
+
+    glyphCache.update(1);
+    LayoutReady(glyphCache, cache, "ab", style);
+    LayoutReady(glyphCache, cache, "ba", style);
+    LayoutReady(glyphCache, cache, "ab", style);
+    EXPECT_EQ(cache.getLayoutCount(), 2U);
+    EXPECT_EQ(cache.getStats().evictions, 0U);
+
+    /// "ba" is the least recently used
+    LayoutReady(glyphCache, cache, "aa", style);
+    EXPECT_EQ(cache.getStats().evictions, 1U);
+    UInt32 misses = cache.getStats().misses;
+    cache.layout("ab", style);
+    EXPECT_EQ(cache.getStats().misses, misses);
+    cache.layout("ba", style);
+    EXPECT_EQ(cache.getStats().misses, misses + 1);
+
+    /// a large glyph does not fit beside the first row and evicts the single page, the layouts made from it are stale
+    LayoutReady(glyphCache, cache, "cdef", style);
+    LayoutReady(glyphCache, cache, "ab", style);
+    glyphCache.update(10);
+    const TextLayout &large = cache.layout("x", { 0, 48, false, 0.f });
+    EXPECT_FALSE(large.bComplete);
+    glyphCache.flush();
+    EXPECT_EQ(glyphCache.getStats().evictedPages, 1U);
+    cache.layout("ab", style);
+    EXPECT_EQ(cache.getStats().invalidations, 1U);
+
+    cache.clear();
+    EXPECT_EQ(cache.getLayoutCount(), 0U);
+}
+
+TEST(TextLayout, Batch) {
+    TestRasterizer  rasterizer;
+    GlyphCache      glyphCache(&rasterizer, { 256, 2, 1, 32, 1 });
+    TextLayoutCache cache(&glyphCache);
+
+    const TextLayout &layout = LayoutReady(glyphCache, cache, "ab", { 0, 16, false, 0.f });
+    TextBatch         batch;
+    batch.add(layout, 100.f, 50.f, 0xFF00FF00);
+    batch.add(layout, 0.f, 0.f);
+    ASSERT_EQ(batch.getPageCount(), 1U);
+    const std::vector<TextVertex> &vertices = batch.getVertices(0);
+    ASSERT_EQ(vertices.size(), 16U);
+    EXPECT_FLOAT_EQ(vertices[0].x, layout.vertices[0].x + 100.f);
+    EXPECT_FLOAT_EQ(vertices[0].y, layout.vertices[0].y + 50.f);
+    EXPECT_EQ(vertices[0].color, 0xFF00FF00);
+    EXPECT_FLOAT_EQ(vertices[8].x, layout.vertices[0].x);
+    EXPECT_EQ(vertices[8].color, 0xFFFFFFFF);
+
+    batch.clear();
+    EXPECT_TRUE(batch.getVertices(0).empty());
+}
+
+TEST(TextLayout, Throughput) {
+    TestRasterizer  rasterizer;
+    GlyphCache      glyphCache(&rasterizer, { 1024, 2, 1, 32, 1 });
+    TextLayoutCache cache(&glyphCache, 4096);
+    TextStyle       style{ 0, 18, false, 0.f };
+
+    /// HUD and editor labels, most are unchanged from frame to frame
+    std::vector<std::string> labels;
+    for (UInt32 i = 0; i < 400; ++i) {
+        labels.push_back("Inspector field " + std::to_string(i) + ": Transform Position Rotation Scale");
+    }
+    size_t glyphCount = 0;
+    for (const std::string &label : labels) {
+        LayoutReady(glyphCache, cache, label, style);
+        glyphCount += label.size() - std::count(label.begin(), label.end(), ' ');
+    }
+    LayoutReady(glyphCache, cache, "FPS: 0123456789.", style);
+
+    const UInt32 frames = 200;
+    TextBatch    batch;
+    Timer        timer;
+    TextLayoutStats before = cache.getStats();
+    for (UInt32 frame = 0; frame < frames; ++frame) {
+        glyphCache.update(frame);
+        batch.clear();
+        float y = 0.f;
+        for (const std::string &label : labels) {
+            batch.add(cache.layout(label, style), 0.f, y += 20.f);
+        }
+        /// a counter changes every frame
+        std::string fps = "FPS: " + std::to_string(60.f + (float) frame * 0.01f);
+        batch.add(cache.layout(fps, style), 0.f, 0.f);
+        if (frame + 1 == frames) glyphCount += fps.size() - 1;
+    }
+    float hitSeconds = timer.mark();
+    UInt32 hits = cache.getStats().hits - before.hits, misses = cache.getStats().misses - before.misses;
+
+    /// every layout from scratch
+    TextLayoutCache uncached(&glyphCache, 1);
+    timer.mark();
+    for (UInt32 frame = 0; frame < 20; ++frame) {
+        for (UInt32 i = 0; i < labels.size(); ++i) {
+            uncached.layout(labels[(i + frame) % labels.size()], style);
+        }
+    }
+    float missSeconds = timer.mark();
+
+    float hitRate = (float) hits / (float) (hits + misses);
+    RecordProperty("hit_rate", std::to_string(hitRate));
+    RecordProperty("cached_layouts_per_second", std::to_string((float) (hits + misses) / hitSeconds));
+    RecordProperty("uncached_layouts_per_second", std::to_string(20.f * (float) labels.size() / missSeconds));
+    EXPECT_GT(hitRate, 0.99f);
+    EXPECT_EQ(misses, frames);
+    EXPECT_EQ(cache.getStats().invalidations, 0U);
+    EXPECT_EQ(batch.getVertices(0).size(), glyphCount * 4);
+}
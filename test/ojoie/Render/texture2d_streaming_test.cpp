@@ -0,0 +1,77 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Misc/ResourceManager.hpp>
+#include <ojoie/Render/RenderContext.hpp>
+#include <ojoie/Render/Texture2D.hpp>
+#include <ojoie/Serialize/SerializeManager.hpp>
+
+#include <filesystem>
+#include <vector>
+
+using namespace AN;
+
+namespace fs = std::filesystem;
+
+TEST(Texture2D, StreamsLevelsFromAsset) {
+    InitializeRenderContext(kGraphicsAPID3D11);
+
+    fs::path directory = fs::temp_directory_path() / "ojoie_texture_streaming";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+    std::string path = (directory / "Streamed.asset").string();
+
+    TextureStreamer         &streamer = GetTextureStreamer();
+    TextureStreamingSettings settings;
+    settings.bAsync        = false;
+    settings.requestFrames = 0;
+    streamer.setSettings(settings);
+
+    TextureDescriptor desc{};
+    desc.width       = 256;
+    desc.height      = 256;
+    desc.pixelFormat = kPixelFormatRGBA8Unorm;
+    desc.mipmapLevel = CalculateMipCount(256, 256);
+
+    std::vector<UInt8> pixels(256 * 256 * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) pixels[i] = (UInt8) (i * 7);
+
+    /// the saved texture stays registered with the serialize manager, loading the asset decodes into it
+    Texture2D *texture = NewObject<Texture2D>();
+    ASSERT_TRUE(texture->init(desc));
+    texture->setPixelData(pixels.data());
+    texture->setStreaming(true);
+    ASSERT_TRUE(GetSerializeManager().SerializeObjectAtPath(texture, path.c_str()));
+    ASSERT_EQ(GetResourceManager().loadResourceAtPath(path.c_str()), texture);
+
+    /// only the levels up to 64x64 are on the GPU and nothing is kept on the CPU
+    const UInt64 chainSize = CalculateMipChainSize(desc.pixelFormat, 256, 256, desc.mipmapLevel);
+    const UInt64 baseSize  = chainSize - CalculateMipOffset(desc.pixelFormat, 256, 256, 2);
+    StreamingTextureID id  = texture->getStreamingID();
+    ASSERT_NE(id, kInvalidStreamingTextureID);
+    EXPECT_EQ(texture->getResidentMip(), 2U);
+    EXPECT_EQ(texture->getPixelData(), nullptr);
+    size_t baseMemory = texture->getRuntimeMemorySize();
+
+    /// the finer levels are read from the asset
+    streamer.requestMip(id, 0.f);
+    streamer.update(1);
+    EXPECT_EQ(texture->getResidentMip(), 0U);
+    EXPECT_EQ(texture->getPixelData(), nullptr);
+    EXPECT_EQ(texture->getRuntimeMemorySize(), baseMemory + chainSize - baseSize);
+
+    /// not requested any more, the GPU texture goes back to the coarse levels
+    streamer.update(3);
+    EXPECT_EQ(texture->getResidentMip(), 2U);
+    EXPECT_EQ(texture->getRuntimeMemorySize(), baseMemory);
+    EXPECT_EQ(streamer.getStats().loads, 1U);
+
+    GetResourceManager().unloadResource(texture);
+    streamer.setSettings({});
+
+    fs::remove_all(directory);
+    DeallocRenderContext();
+}
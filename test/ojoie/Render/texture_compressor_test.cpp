@@ -0,0 +1,188 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/MipChain.hpp>
+#include <ojoie/Render/TextureCompressor.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace AN;
+
+/// smooth gradients with a few hard edges and some noise, like a photo texture
+static std::vector<UInt8> MakeImage(UInt32 width, UInt32 height, bool bAlpha) {
+    std::vector<UInt8> image((size_t) width * height * 4);
+    UInt32 seed = 77;
+    for (UInt32 y = 0; y < height; ++y) {
+        for (UInt32 x = 0; x < width; ++x) {
+            seed = seed * 1664525u + 1013904223u;
+            float noise = (float) ((seed >> 16) & 15) - 7.5f;
+            float u = (float) x / (float) width, v = (float) y / (float) height;
+            UInt8 *texel = &image[((size_t) y * width + x) * 4];
+            texel[0] = (UInt8) std::clamp(255.f * u + noise, 0.f, 255.f);
+            texel[1] = (UInt8) std::clamp(255.f * v + noise, 0.f, 255.f);
+            texel[2] = (UInt8) std::clamp(128.f + 100.f * std::sin(u * 12.f) * std::cos(v * 9.f) + noise, 0.f, 255.f);
+            texel[3] = bAlpha ? (UInt8) std::clamp(255.f * (1.f - u * v) + noise, 0.f, 255.f) : 255;
+            if (((x / 37) + (y / 29)) % 5 == 0) {
+                texel[0] = 255 - texel[0];
+            }
+        }
+    }
+    return image;
+}
+
+static float PSNR(const std::vector<UInt8> &a, const std::vector<UInt8> &b, UInt32 channels) {
+    double error = 0.0;
+    size_t count = a.size() / 4;
+    for (size_t i = 0; i < count; ++i) {
+        for (UInt32 c = 0; c < channels; ++c) {
+            double delta = (double) a[i * 4 + c] - (double) b[i * 4 + c];
+            error += delta * delta;
+        }
+    }
+    error /= (double) (count * channels);
+    return error == 0.0 ? 99.f : (float) (10.0 * std::log10(255.0 * 255.0 / error));
+}
+
+static float RoundTrip(const std::vector<UInt8> &image, UInt32 width, UInt32 height, PixelFormat format,
+                       TextureCompressionQuality quality, UInt32 channels, std::vector<UInt8> *decoded = nullptr) {
+    std::vector<UInt8> compressed(CalculatePixelFormatSize(format, width, height));
+    std::vector<UInt8> result(image.size());
+    TextureCompressionSettings settings;
+    settings.format  = format;
+    settings.quality = quality;
+    EXPECT_TRUE(CompressTexture(image.data(), kPixelFormatRGBA8Unorm, width, height, 1, compressed.data(), settings));
+    EXPECT_TRUE(DecompressTexture(compressed.data(), format, width, height, result.data()));
+    if (decoded) *decoded = result;
+    return PSNR(image, result, channels);
+}
+
+TEST(TextureCompressor, FormatQuality) {
+    const UInt32       size   = 128;
+    std::vector<UInt8> opaque = MakeImage(size, size, false);
+    std::vector<UInt8> alpha  = MakeImage(size, size, true);
+
+    struct Case {
+        PixelFormat                format;
+        const std::vector<UInt8> *image;
+        UInt32                     channels;
+        float                      minPSNR;
+    } cases[] = {
+        { kPixelFormatBC1_RGBA, &opaque, 3, 34.f },
+        { kPixelFormatBC3_RGBA, &alpha, 4, 35.f },
+        { kPixelFormatBC4_RUnorm, &opaque, 1, 44.f },
+        { kPixelFormatBC5_RGUnorm, &opaque, 2, 46.f },
+        { kPixelFormatBC7_RGBAUnorm, &alpha, 4, 36.f },
+    };
+
+    for (const Case &test : cases) {
+        float fast   = RoundTrip(*test.image, size, size, test.format, kTextureCompressionQualityFast, test.channels);
+        float normal = RoundTrip(*test.image, size, size, test.format, kTextureCompressionQualityNormal, test.channels);
+        float high   = RoundTrip(*test.image, size, size, test.format, kTextureCompressionQualityHigh, test.channels);
+        RecordProperty("psnr_format_" + std::to_string(test.format),
+                       std::to_string(fast) + " / " + std::to_string(normal) + " / " + std::to_string(high));
+
+        EXPECT_GT(normal, test.minPSNR) << "format " << test.format;
+        EXPECT_GE(normal, fast - 0.05f) << "format " << test.format;
+        EXPECT_GE(high, normal - 0.05f) << "format " << test.format;
+    }
+}
+
+TEST(TextureCompressor, PunchThroughAlpha) {
+    /// BC1 keeps cutout alpha with its three color blocks
+    const UInt32       size  = 8;
+    std::vector<UInt8> image = MakeImage(size, size, false);
+    for (UInt32 i = 0; i < size * size; i += 3) image[i * 4 + 3] = 0;
+
+    std::vector<UInt8> decoded;
+    RoundTrip(image, size, size, kPixelFormatBC1_RGBA, kTextureCompressionQualityNormal, 3, &decoded);
+    for (UInt32 i = 0; i < size * size; ++i) {
+        EXPECT_EQ(decoded[i * 4 + 3], i % 3 == 0 ? 0 : 255);
+    }
+}
+
+TEST(TextureCompressor, SmallLevelsAndChain) {
+    /// levels below 4x4 repeat their edge texels into the block
+    const UInt32       width = 16, height = 8;
+    UInt32             mipCount = CalculateMipCount(width, height);
+    std::vector<UInt8> chain(CalculateMipChainSize(kPixelFormatRGBA8Unorm, width, height, mipCount), 200);
+    std::vector<UInt8> compressed(CalculateMipChainSize(kPixelFormatBC7_RGBAUnorm, width, height, mipCount));
+
+    TextureCompressionSettings settings;
+    settings.format = kPixelFormatBC7_RGBAUnorm;
+    ASSERT_TRUE(CompressTexture(chain.data(), kPixelFormatRGBA8Unorm, width, height, mipCount, compressed.data(), settings));
+    EXPECT_EQ(compressed.size(), 128 + 32 + 16 + 16 + 16);
+
+    for (UInt32 level = 0; level < mipCount; ++level) {
+        UInt32             levelWidth = CalculateMipSize(width, level), levelHeight = CalculateMipSize(height, level);
+        std::vector<UInt8> decoded((size_t) levelWidth * levelHeight * 4);
+        ASSERT_TRUE(DecompressTexture(compressed.data() + CalculateMipOffset(settings.format, width, height, level),
+                                      settings.format, levelWidth, levelHeight, decoded.data()));
+        for (UInt8 value : decoded) EXPECT_EQ(value, 200);
+    }
+
+    EXPECT_FALSE(IsTextureCompressionSupported(kPixelFormatRGBA32Float, kPixelFormatBC1_RGBA));
+    EXPECT_FALSE(IsTextureCompressionSupported(kPixelFormatRGBA8Unorm, kPixelFormatBC6H_RGBFloat));
+}
+
+TEST(TextureCompressor, NormalMaps) {
+    /// a bumpy normal map, BC5 keeps XY and the shader rebuilds Z
+    const UInt32       size = 64;
+    std::vector<UInt8> image((size_t) size * size * 4);
+    for (UInt32 y = 0; y < size; ++y) {
+        for (UInt32 x = 0; x < size; ++x) {
+            float nx = 0.5f * std::sin((float) x * 0.3f), ny = 0.5f * std::cos((float) y * 0.2f);
+            float nz = std::sqrt(std::max(0.f, 1.f - nx * nx - ny * ny));
+            UInt8 *texel = &image[((size_t) y * size + x) * 4];
+            texel[0] = (UInt8) std::lround((nx + 1.f) * 127.5f);
+            texel[1] = (UInt8) std::lround((ny + 1.f) * 127.5f);
+            texel[2] = (UInt8) std::lround((nz + 1.f) * 127.5f);
+            texel[3] = 255;
+        }
+    }
+    EXPECT_EQ(SelectCompressedPixelFormat(image.data(), size, size, kPixelFormatRGBA8Unorm, true, kTextureCompressionQualityNormal),
+              kPixelFormatBC1_RGBA);
+
+    TextureCompressionSettings settings;
+    settings.format     = kPixelFormatBC5_RGUnorm;
+    settings.bNormalMap = true;
+    std::vector<UInt8> compressed(CalculatePixelFormatSize(settings.format, size, size));
+    std::vector<UInt8> decoded(image.size());
+    ASSERT_TRUE(CompressTexture(image.data(), kPixelFormatRGBA8Unorm, size, size, 1, compressed.data(), settings));
+    ASSERT_TRUE(DecompressTexture(compressed.data(), settings.format, size, size, decoded.data()));
+
+    float maxAngle = 0.f;
+    for (size_t i = 0; i < (size_t) size * size; ++i) {
+        float ax = image[i * 4] / 127.5f - 1.f, ay = image[i * 4 + 1] / 127.5f - 1.f;
+        float bx = decoded[i * 4] / 127.5f - 1.f, by = decoded[i * 4 + 1] / 127.5f - 1.f;
+        float az = std::sqrt(std::max(0.f, 1.f - ax * ax - ay * ay)), bz = std::sqrt(std::max(0.f, 1.f - bx * bx - by * by));
+        float dot = std::clamp((ax * bx + ay * by + az * bz) / std::sqrt((ax * ax + ay * ay + az * az) * (bx * bx + by * by + bz * bz)), -1.f, 1.f);
+        maxAngle = std::max(maxAngle, std::acos(dot) * 57.29578f);
+    }
+    RecordProperty("bc5_max_normal_error_degrees", std::to_string(maxAngle));
+    EXPECT_LT(maxAngle, 3.f);
+}
+
+TEST(TextureCompressor, Throughput) {
+    const UInt32       size  = 1024;
+    std::vector<UInt8> image = MakeImage(size, size, true);
+    std::vector<UInt8> compressed(CalculatePixelFormatSize(kPixelFormatBC7_RGBAUnorm, size, size));
+
+    for (PixelFormat format : { kPixelFormatBC1_RGBA, kPixelFormatBC3_RGBA, kPixelFormatBC7_RGBAUnorm }) {
+        for (TextureCompressionQuality quality : { kTextureCompressionQualityFast, kTextureCompressionQualityNormal }) {
+            TextureCompressionSettings settings;
+            settings.format  = format;
+            settings.quality = quality;
+
+            Timer timer;
+            ASSERT_TRUE(CompressTexture(image.data(), kPixelFormatRGBA8Unorm, size, size, 1, compressed.data(), settings));
+            float seconds = timer.mark();
+            RecordProperty("mpixels_per_second_format_" + std::to_string(format) + "_quality_" + std::to_string(quality),
+                           std::to_string((float) size * size / 1e6f / seconds));
+        }
+    }
+}
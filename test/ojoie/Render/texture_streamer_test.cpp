@@ -0,0 +1,260 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/MipChain.hpp>
+#include <ojoie/Render/TextureStreamer.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace AN;
+
+/// keeps the resident levels of each texture in a CPU buffer instead of a GPU texture
+struct CPUTexture {
+    StreamingTextureDescriptor desc;
+    std::vector<UInt8>         levels;
+    UInt32                     firstMip = ~0U;
+};
+
+class CPUStreamingBackend : public TextureStreamingBackend {
+public:
+    UInt32             loadDelayMs = 0;
+    std::atomic<int>   running{}, maxRunning{};
+    std::atomic<int>   loadCount{};
+    int                prepareCount = 0, discardCount = 0;
+
+    virtual void prepareLoad(void *texture, UInt32 firstMip) override {
+        ++prepareCount;
+    }
+
+    virtual void discardMips(void *texture) override {
+        ++discardCount;
+    }
+
+    virtual bool loadMips(void *texture, UInt32 firstMip) override {
+        int now = ++running;
+        int max = maxRunning;
+        while (now > max && !maxRunning.compare_exchange_weak(max, now)) {}
+        if (loadDelayMs) std::this_thread::sleep_for(std::chrono::milliseconds(loadDelayMs));
+        ++loadCount;
+        --running;
+        return true;
+    }
+
+    virtual void applyMips(void *texture, UInt32 firstMip) override {
+        CPUTexture *cpuTexture = (CPUTexture *) texture;
+        const StreamingTextureDescriptor &desc = cpuTexture->desc;
+        cpuTexture->firstMip = firstMip;
+        cpuTexture->levels.assign(CalculateMipChainSize(desc.pixelFormat, desc.width, desc.height, desc.mipCount) -
+                                  CalculateMipOffset(desc.pixelFormat, desc.width, desc.height, firstMip), 0);
+    }
+};
+
+static CPUTexture MakeTexture(UInt32 size) {
+    CPUTexture texture;
+    texture.desc = { size, size, CalculateMipCount(size, size), kPixelFormatRGBA8Unorm };
+    return texture;
+}
+
+static UInt64 ResidentBytes(const std::vector<CPUTexture> &textures) {
+    UInt64 bytes = 0;
+    for (const CPUTexture &texture : textures) bytes += texture.levels.size();
+    return bytes;
+}
+
+static TextureStreamingSettings SyncSettings(UInt64 budget) {
+    TextureStreamingSettings settings;
+    settings.memoryBudget     = budget;
+    settings.maxLoadsInFlight = 64;
+    settings.bAsync           = false;
+    return settings;
+}
+
+TEST(TextureStreamer, RequiredMip) {
+    /// 1024 texels over a 1x1 quad seen 1024 pixels tall needs the first level
+    EXPECT_NEAR(CalculateRequiredMip(1.f, 1024, 1024, 1.f, 1024.f), 0.f, 1e-5f);
+    EXPECT_NEAR(CalculateRequiredMip(1.f, 1024, 1024, 4.f, 1024.f), 2.f, 1e-5f);
+    /// the same uvs stretched over 4x4 units halve the density twice
+    EXPECT_NEAR(CalculateRequiredMip(16.f, 1024, 1024, 1.f, 256.f), 0.f, 1e-5f);
+    EXPECT_EQ(CalculateRequiredMip(1.f, 256, 256, 0.1f, 1024.f), 0.f);
+    EXPECT_EQ(CalculateRequiredMip(0.f, 256, 256, 10.f, 1024.f), 0.f);
+}
+
+TEST(TextureStreamer, InitialLevelsAndRequests) {
+    CPUStreamingBackend backend;
+    TextureStreamer     streamer;
+    streamer.setSettings(SyncSettings(64ULL << 20));
+
+    CPUTexture         texture = MakeTexture(1024);
+    StreamingTextureID id      = streamer.addTexture(texture.desc, &backend, &texture);
+    /// 64x64 is the first always resident level
+    EXPECT_EQ(streamer.getBaseMip(id), 4);
+    EXPECT_EQ(texture.firstMip, 4);
+
+    streamer.requestMip(id, 1.7f);
+    streamer.requestMip(id, 2.5f);
+    streamer.update(1);
+    EXPECT_EQ(texture.firstMip, 1);
+    EXPECT_EQ(streamer.getStats().residentMemory, texture.levels.size());
+
+    /// the finest request of a frame wins and later frames keep the last request
+    streamer.requestMip(id, 0.f);
+    streamer.update(2);
+    streamer.update(3);
+    EXPECT_EQ(texture.firstMip, 0);
+
+    /// a small texture is always fully resident
+    CPUTexture small = MakeTexture(32);
+    streamer.addTexture(small.desc, &backend, &small);
+    EXPECT_EQ(small.firstMip, 0);
+
+    streamer.removeTexture(id);
+    streamer.update(4);
+    EXPECT_EQ(streamer.getStats().textureCount, 1);
+}
+
+TEST(TextureStreamer, StaysInBudget) {
+    CPUStreamingBackend     backend;
+    TextureStreamer         streamer;
+    std::vector<CPUTexture> textures;
+    for (UInt32 i = 0; i < 8; ++i) textures.push_back(MakeTexture(1024));
+
+    /// room for two full chains, every texture wants its first level
+    const UInt64 fullChain = CalculateMipChainSize(kPixelFormatRGBA8Unorm, 1024, 1024, 11);
+    streamer.setSettings(SyncSettings(fullChain * 2));
+    std::vector<StreamingTextureID> ids;
+    for (CPUTexture &texture : textures) ids.push_back(streamer.addTexture(texture.desc, &backend, &texture));
+
+    for (UInt32 frame = 1; frame < 10; ++frame) {
+        for (StreamingTextureID id : ids) streamer.requestMip(id, 0.f);
+        streamer.update(frame);
+        EXPECT_LE(ResidentBytes(textures), fullChain * 2);
+        EXPECT_EQ(streamer.getStats().residentMemory, ResidentBytes(textures));
+    }
+
+    /// the budget is shared evenly, each texture gives up its largest level first
+    for (const CPUTexture &texture : textures) EXPECT_EQ(texture.firstMip, 1);
+    EXPECT_EQ(streamer.getStats().reducedTextures, 8);
+    EXPECT_GT(streamer.getStats().requestedMemory, fullChain * 2);
+
+    /// a smaller budget takes levels back
+    streamer.setSettings(SyncSettings(fullChain / 2));
+    for (StreamingTextureID id : ids) streamer.requestMip(id, 0.f);
+    streamer.update(10);
+    EXPECT_LE(ResidentBytes(textures), fullChain / 2);
+    EXPECT_GT(streamer.getStats().evictions, 0);
+}
+
+TEST(TextureStreamer, RecentRequestsFirst) {
+    CPUStreamingBackend     backend;
+    TextureStreamer         streamer;
+    std::vector<CPUTexture> textures{ MakeTexture(1024), MakeTexture(1024) };
+
+    const UInt64 fullChain = CalculateMipChainSize(kPixelFormatRGBA8Unorm, 1024, 1024, 11);
+    TextureStreamingSettings settings = SyncSettings(fullChain + fullChain / 8);
+    settings.requestFrames = 100;
+    streamer.setSettings(settings);
+    StreamingTextureID a = streamer.addTexture(textures[0].desc, &backend, &textures[0]);
+    StreamingTextureID b = streamer.addTexture(textures[1].desc, &backend, &textures[1]);
+
+    streamer.requestMip(a, 0.f);
+    streamer.update(1);
+    EXPECT_EQ(textures[0].firstMip, 0);
+
+    /// b is in view now, a was last seen a frame ago and gives its levels to b
+    streamer.requestMip(b, 0.f);
+    streamer.update(2);
+    EXPECT_EQ(textures[1].firstMip, 0);
+    EXPECT_GT(textures[0].firstMip, 0);
+    EXPECT_LE(ResidentBytes(textures), settings.memoryBudget);
+}
+
+TEST(TextureStreamer, UnrequestedTexturesDropLevels) {
+    CPUStreamingBackend backend;
+    TextureStreamer     streamer;
+    TextureStreamingSettings settings = SyncSettings(64ULL << 20);
+    settings.requestFrames = 5;
+    streamer.setSettings(settings);
+
+    CPUTexture         texture = MakeTexture(512);
+    StreamingTextureID id      = streamer.addTexture(texture.desc, &backend, &texture);
+    streamer.requestMip(id, 0.f);
+    streamer.update(1);
+    EXPECT_EQ(texture.firstMip, 0);
+
+    for (UInt32 frame = 2; frame <= 6; ++frame) {
+        streamer.update(frame);
+        EXPECT_EQ(texture.firstMip, 0);
+    }
+    streamer.update(7);
+    EXPECT_EQ(texture.firstMip, streamer.getBaseMip(id));
+    EXPECT_EQ(streamer.getStats().evictions, 1);
+}
+
+TEST(TextureStreamer, AsyncLoads) {
+    CPUStreamingBackend backend;
+    backend.loadDelayMs = 2;
+    TextureStreamer streamer;
+    TextureStreamingSettings settings;
+    settings.maxLoadsInFlight = 3;
+    streamer.setSettings(settings);
+
+    std::vector<CPUTexture> textures;
+    for (UInt32 i = 0; i < 10; ++i) textures.push_back(MakeTexture(256));
+    std::vector<StreamingTextureID> ids;
+    for (CPUTexture &texture : textures) ids.push_back(streamer.addTexture(texture.desc, &backend, &texture));
+
+    /// loads finish on the streaming thread and are applied in a later update
+    for (StreamingTextureID id : ids) streamer.requestMip(id, 0.f);
+    streamer.update(1);
+    EXPECT_EQ(streamer.getStats().loadsInFlight, 3);
+    for (const CPUTexture &texture : textures) EXPECT_EQ(texture.firstMip, 2);
+
+    UInt32 frame = 2;
+    while (streamer.getStats().loads < textures.size() && frame < 1000) {
+        streamer.flush();
+        for (StreamingTextureID id : ids) streamer.requestMip(id, 0.f);
+        streamer.update(frame++);
+        EXPECT_LE(streamer.getStats().loadsInFlight, 3);
+    }
+    for (const CPUTexture &texture : textures) EXPECT_EQ(texture.firstMip, 0);
+    EXPECT_LE(backend.maxRunning.load(), 1);
+    EXPECT_EQ(backend.loadCount.load(), 10);
+
+    /// removing a texture waits for its load
+    CPUTexture         extra = MakeTexture(256);
+    StreamingTextureID id    = streamer.addTexture(extra.desc, &backend, &extra);
+    streamer.requestMip(id, 0.f);
+    streamer.update(frame);
+    streamer.removeTexture(id);
+    streamer.shutdown();
+    EXPECT_EQ(extra.firstMip, 2);
+}
+
+TEST(TextureStreamer, DiscardsLoadsNotApplied) {
+    CPUStreamingBackend backend;
+    backend.loadDelayMs = 200;
+    TextureStreamer          streamer;
+    TextureStreamingSettings settings;
+    settings.requestFrames = 0;
+    streamer.setSettings(settings);
+
+    CPUTexture         texture = MakeTexture(256);
+    StreamingTextureID id      = streamer.addTexture(texture.desc, &backend, &texture);
+    streamer.requestMip(id, 0.f);
+    streamer.update(1);
+    EXPECT_EQ(backend.prepareCount, 1);
+
+    /// no longer requested while the load runs, the loaded levels are dropped instead of applied
+    streamer.update(3);
+    streamer.flush();
+    EXPECT_EQ(backend.loadCount.load(), 1);
+    EXPECT_EQ(backend.discardCount, 1);
+    EXPECT_EQ(texture.firstMip, 2);
+    EXPECT_EQ(streamer.getStats().loads, 0);
+}
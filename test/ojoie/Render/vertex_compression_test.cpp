@@ -0,0 +1,105 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Render/VertexData.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace AN;
+
+static constexpr UInt32 kTestChannels = VERTEX_FORMAT5(Vertex, Normal, TexCoord0, TexCoord1, Tangent);
+
+static Vector3f RandomDirection(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    Vector3f direction;
+    do {
+        direction = Vector3f(unit(rng), unit(rng), unit(rng));
+    } while (Math::length(direction) < 0.1f);
+    return Math::normalize(direction);
+}
+
+TEST(VertexCompression, OctahedralRoundTrip) {
+    std::mt19937 rng(1);
+    for (int i = 0; i < 10000; ++i) {
+        Vector3f direction = RandomDirection(rng);
+        Vector2f encoded   = OctahedralEncode(direction);
+        EXPECT_LE(std::abs(encoded.x), 1.f);
+        EXPECT_LE(std::abs(encoded.y), 1.f);
+        EXPECT_GT(Math::dot(OctahedralDecode(encoded), direction), 0.99999f);
+    }
+
+    /// the poles and the folded edges
+    EXPECT_GT(Math::dot(OctahedralDecode(OctahedralEncode(Vector3f(0.f, 0.f, -1.f))), Vector3f(0.f, 0.f, -1.f)), 0.9999f);
+    EXPECT_GT(Math::dot(OctahedralDecode(OctahedralEncode(Vector3f(1.f, 0.f, 0.f))), Vector3f(1.f, 0.f, 0.f)), 0.9999f);
+}
+
+TEST(VertexCompression, LayoutSize) {
+    VertexData vertexData;
+    vertexData.resize(16, kTestChannels | VERTEX_FORMAT1(Color));
+    size_t floatSize = vertexData.getVertexSize();
+
+    vertexData.resize(16, kTestChannels | VERTEX_FORMAT1(Color), VertexDataInfo::kVertexStreamsDefault,
+                      VertexDataInfo::GetCompressedChannelsLayout(kTestChannels));
+    EXPECT_LT(vertexData.getVertexSize() * 2, floatSize);
+    EXPECT_TRUE(vertexData.isChannelCompressed(kShaderChannelVertex));
+    EXPECT_FALSE(vertexData.isChannelCompressed(kShaderChannelColor));
+}
+
+TEST(VertexCompression, ConvertChannels) {
+    const UInt32 count = 1000;
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+    std::vector<Vector3f> positions(count), normals(count);
+    std::vector<Vector2f> uvs(count);
+    std::vector<Vector4f> tangents(count);
+    for (UInt32 i = 0; i < count; ++i) {
+        positions[i] = Vector3f(unit(rng) * 10.f, unit(rng) * 2.f + 5.f, unit(rng));
+        normals[i]   = RandomDirection(rng);
+        uvs[i]       = Vector2f(unit(rng) * 0.5f + 0.5f, unit(rng) * 0.5f + 0.5f);
+        tangents[i]  = Vector4f(RandomDirection(rng), i % 2 ? 1.f : -1.f);
+    }
+
+    VertexData vertexData;
+    vertexData.resize(count, kTestChannels);
+    vertexData.writeChannel(kShaderChannelVertex, &positions[0].x, 3);
+    vertexData.writeChannel(kShaderChannelNormal, &normals[0].x, 3);
+    vertexData.writeChannel(kShaderChannelTexCoord0, &uvs[0].x, 2);
+    vertexData.writeChannel(kShaderChannelTangent, &tangents[0].x, 4);
+
+    /// quantize into [-10, 10] x [3, 7] x [-1, 1]
+    vertexData.setPositionQuantization(Vector3f(20.f, 4.f, 2.f), Vector3f(-10.f, 3.f, -1.f));
+    vertexData.resize(count, kTestChannels, VertexDataInfo::kVertexStreamsDefault,
+                      VertexDataInfo::GetCompressedChannelsLayout(kTestChannels));
+
+    for (UInt32 i = 0; i < count; ++i) {
+        Vector3f position = vertexData.getChannelValue(kShaderChannelVertex, i);
+        EXPECT_NEAR(position.x, positions[i].x, 20.f / 65535.f);
+        EXPECT_NEAR(position.y, positions[i].y, 4.f / 65535.f);
+        EXPECT_NEAR(position.z, positions[i].z, 2.f / 65535.f);
+
+        Vector3f normal = vertexData.getChannelValue(kShaderChannelNormal, i);
+        EXPECT_GT(Math::dot(normal, normals[i]), 0.9999f);
+
+        Vector2f uv = vertexData.getChannelValue(kShaderChannelTexCoord0, i);
+        EXPECT_NEAR(uv.x, uvs[i].x, 1e-3f);
+        EXPECT_NEAR(uv.y, uvs[i].y, 1e-3f);
+
+        Vector4f tangent = vertexData.getChannelValue(kShaderChannelTangent, i);
+        EXPECT_GT(Math::dot(Vector3f(tangent), Vector3f(tangents[i])), 0.999f);
+        EXPECT_EQ(tangent.w, tangents[i].w);
+    }
+
+    /// back to float keeps the quantized values
+    std::vector<Vector3f> extracted(count);
+    vertexData.extractChannel(kShaderChannelVertex, &extracted[0].x, 3);
+    vertexData.resize(count, kTestChannels);
+    EXPECT_FALSE(vertexData.isChannelCompressed(kShaderChannelVertex));
+    for (UInt32 i = 0; i < count; ++i) {
+        EXPECT_EQ(Vector3f(vertexData.getChannelValue(kShaderChannelVertex, i)), extracted[i]);
+    }
+}
@@ -0,0 +1,186 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/ShaderLab/Lexer.hpp>
+#include <ojoie/ShaderLab/Parser.hpp>
+#include <ojoie/Render/Shader/ShaderKeywords.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <unordered_map>
+
+using namespace AN;
+using namespace AN::ShaderLab;
+
+static const char *s_KeywordShader = R"(Shader "Test/Keywords"
+{
+    SubShader
+    {
+        HLSLINCLUDE
+        #pragma multi_compile _ FOG_LINEAR FOG_EXP
+        float4 fog;
+        ENDHLSL
+
+        Pass
+        {
+            HLSLPROGRAM
+            #pragma shader_feature NORMAL_MAP
+            #pragma multi_compile SHADOWS_HARD SHADOWS_SOFT
+            float4 vertex_main() : SV_Position { return 0; }
+            ENDHLSL
+        }
+
+        Pass
+        {
+            HLSLPROGRAM
+            float4 vertex_main() : SV_Position { return 0; }
+            ENDHLSL
+        }
+    }
+}
+)";
+
+static ShaderInfo ParseShader(const char *source, bool &bHasError) {
+    Lexer      lexer(source);
+    Parser     parser(lexer);
+    ShaderInfo info = parser.parse();
+    bHasError = parser.hasError();
+    return info;
+}
+
+static ShaderKeywordSet MakeKeywordSet(std::initializer_list<const char *> keywords) {
+    ShaderKeywordSet set;
+    for (const char *keyword : keywords) {
+        set.enable(GetShaderKeywordIndex(keyword));
+    }
+    return set;
+}
+
+TEST(ShaderKeywords, ParsePragmas) {
+    bool       bHasError;
+    ShaderInfo info = ParseShader(s_KeywordShader, bHasError);
+    ASSERT_FALSE(bHasError);
+    ASSERT_EQ(info.subShaders[0].passes.size(), 2);
+
+    /// HLSLINCLUDE declarations reach every pass
+    const std::vector<KeywordDeclaration> &declarations = info.subShaders[0].passes[0].keywordDeclarations;
+    ASSERT_EQ(declarations.size(), 3);
+    EXPECT_EQ(declarations[0].keywords, (std::vector<Name>{ "_", "FOG_LINEAR", "FOG_EXP" }));
+    EXPECT_FALSE(declarations[0].bShaderFeature);
+    EXPECT_EQ(declarations[1].keywords, (std::vector<Name>{ "_", "NORMAL_MAP" }));
+    EXPECT_TRUE(declarations[1].bShaderFeature);
+    EXPECT_EQ(declarations[2].keywords, (std::vector<Name>{ "SHADOWS_HARD", "SHADOWS_SOFT" }));
+    EXPECT_EQ(info.subShaders[0].passes[1].keywordDeclarations.size(), 1);
+
+    /// pragma lines are blanked, the rows of the rest stay
+    const std::string &source = info.passHLSLSources[0][0];
+    EXPECT_EQ(source.find("#pragma"), std::string::npos);
+    EXPECT_NE(source.find("vertex_main"), std::string::npos);
+    EXPECT_EQ(std::count(source.begin(), source.end(), '\n'), 3);
+    EXPECT_EQ(info.subShaderHLSLIncludes[0].find("multi_compile"), std::string::npos);
+
+    ParseShader(R"(Shader "Bad" { SubShader { Pass { HLSLPROGRAM
+        #pragma multi_compile
+        ENDHLSL } } })", bHasError);
+    EXPECT_TRUE(bHasError);
+    ParseShader(R"(Shader "Bad" { SubShader { Pass { HLSLPROGRAM
+        #pragma shader_feature A-B
+        ENDHLSL } } })", bHasError);
+    EXPECT_TRUE(bHasError);
+}
+
+TEST(ShaderKeywords, VariantMask) {
+    bool       bHasError;
+    ShaderInfo info = ParseShader(s_KeywordShader, bHasError);
+    ASSERT_FALSE(bHasError);
+
+    ShaderKeywordSpace space;
+    ASSERT_TRUE(space.init(info.subShaders[0].passes[0].keywordDeclarations));
+    ASSERT_EQ(space.getKeywordCount(), 5);
+
+    /// bits: FOG_LINEAR FOG_EXP NORMAL_MAP SHADOWS_HARD SHADOWS_SOFT
+    EXPECT_EQ(space.getDefaultMask(), 0b01000);
+    EXPECT_EQ(space.getMask(MakeKeywordSet({ "FOG_EXP" })), 0b01010);
+    EXPECT_EQ(space.getMask(MakeKeywordSet({ "FOG_EXP", "FOG_LINEAR", "SHADOWS_SOFT" })), 0b10001);
+    EXPECT_EQ(space.getMask(MakeKeywordSet({ "NORMAL_MAP", "UNDECLARED" })), 0b01100);
+
+    /// material and global keywords combine
+    EXPECT_EQ(space.getMask(MakeKeywordSet({ "NORMAL_MAP" }) | MakeKeywordSet({ "SHADOWS_SOFT" })), 0b10100);
+
+    std::vector<Name> keywords;
+    space.getKeywords(0b10001, keywords);
+    EXPECT_EQ(keywords, (std::vector<Name>{ "FOG_LINEAR", "SHADOWS_SOFT" }));
+    EXPECT_EQ(space.getMask(keywords), 0b10001);
+
+    std::vector<const char *> defines;
+    space.getDefines(0b00100, defines);
+    ASSERT_EQ(defines.size(), 1);
+    EXPECT_STREQ(defines[0], "NORMAL_MAP");
+
+    /// 3 fog x 2 shadow combinations, the feature stays off unless asked for
+    std::vector<UInt64> masks;
+    space.getAllMasks(masks);
+    EXPECT_EQ(masks.size(), 6);
+    space.getAllMasks(masks, true);
+    EXPECT_EQ(masks.size(), 12);
+    std::sort(masks.begin(), masks.end());
+    EXPECT_EQ(std::unique(masks.begin(), masks.end()), masks.end());
+}
+
+TEST(ShaderKeywords, VariantLookup) {
+    bool       bHasError;
+    ShaderInfo info = ParseShader(s_KeywordShader, bHasError);
+    ASSERT_FALSE(bHasError);
+
+    ShaderKeywordSpace space;
+    ASSERT_TRUE(space.init(info.subShaders[0].passes[0].keywordDeclarations));
+
+    /// the table Shader::Pass keeps, mask to variant index
+    std::vector<UInt64> masks;
+    space.getAllMasks(masks, true);
+    std::unordered_map<UInt64, UInt32> variantIndices;
+    for (UInt32 i = 0; i < masks.size(); ++i) variantIndices[masks[i]] = i;
+
+    const char *names[] = { "FOG_LINEAR", "FOG_EXP", "NORMAL_MAP", "SHADOWS_SOFT", "GLOBAL_UNUSED" };
+    std::vector<ShaderKeywordSet> materials(64);
+    for (UInt32 i = 0; i < materials.size(); ++i) {
+        for (UInt32 bit = 0; bit < std::size(names); ++bit) {
+            if (i & (1 << bit)) materials[i].enable(GetShaderKeywordIndex(names[bit]));
+        }
+    }
+    ShaderKeywordSet globals = MakeKeywordSet({ "GLOBAL_UNUSED" });
+
+    /// what applyMaterial does per draw
+    const int drawCount = 1000000;
+    UInt64    checksum  = 0;
+    int       misses    = 0;
+    Timer     timer;
+    for (int i = 0; i < drawCount; ++i) {
+        auto it = variantIndices.find(space.getMask(materials[i & 63] | globals));
+        if (it == variantIndices.end()) {
+            ++misses;
+        } else {
+            checksum += it->second;
+        }
+    }
+    float nsPerDraw = timer.mark() * 1e9f / drawCount;
+
+    RecordProperty("variants", (int) masks.size());
+    RecordProperty("lookup_ns", std::to_string(nsPerDraw));
+    EXPECT_EQ(misses, 0);
+    EXPECT_GT(checksum, 0);
+}
+
+TEST(ShaderKeywords, KeywordLimit) {
+    KeywordDeclaration declaration{};
+    for (int i = 0; i < kMaxPassKeywords + 1; ++i) {
+        declaration.keywords.emplace_back(("KEYWORD_" + std::to_string(i)).c_str());
+    }
+    ShaderKeywordSpace space;
+    EXPECT_FALSE(space.init({ &declaration, 1 }));
+    declaration.keywords.pop_back();
+    EXPECT_TRUE(space.init({ &declaration, 1 }));
+    EXPECT_EQ(space.getDefaultMask(), 1);
+}
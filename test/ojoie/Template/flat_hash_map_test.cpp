@@ -0,0 +1,134 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <ojoie/Template/FlatHashMap.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace AN;
+
+TEST(FlatHashMap, MatchesUnorderedMap) {
+    FlatHashMap<UInt64, int>           map;
+    std::unordered_map<UInt64, int>    reference;
+    std::mt19937_64                    random(7);
+
+    EXPECT_EQ(map.find(1), nullptr);
+    EXPECT_FALSE(map.erase(1));
+
+    /// a small key range makes inserts, hits and erases collide
+    for (int i = 0; i < 200000; ++i) {
+        UInt64 key = random() % 5000;
+        switch (random() % 4) {
+            case 0:
+                EXPECT_EQ(map.insert(key, i), reference.emplace(key, i).second);
+                break;
+            case 1:
+                map.insertOrAssign(key, i);
+                reference[key] = i;
+                break;
+            case 2:
+                EXPECT_EQ(map.erase(key), reference.erase(key) == 1);
+                break;
+            default: {
+                const int *value = map.find(key);
+                auto       it    = reference.find(key);
+                ASSERT_EQ(value != nullptr, it != reference.end());
+                if (value) EXPECT_EQ(*value, it->second);
+            }
+        }
+        ASSERT_EQ(map.size(), reference.size());
+    }
+
+    size_t visited = 0;
+    map.forEach([&](UInt64 key, int value) {
+        EXPECT_EQ(reference[key], value);
+        ++visited;
+    });
+    EXPECT_EQ(visited, reference.size());
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(0), nullptr);
+}
+
+TEST(FlatHashMap, ResourceLookupBenchmark) {
+    const UInt32 count = 50000;
+
+    std::vector<std::string> classNames{ "Shader", "Texture2D", "Material", "Mesh", "AnimationClip" };
+    std::vector<std::string> names;
+    for (UInt32 i = 0; i < count; ++i) {
+        names.push_back("Environment/Props/Prop_" + std::to_string(i));
+    }
+
+    /// the old keys, className + "_" + name built on every call
+    std::unordered_map<std::string, UInt32> stringKeys;
+    for (UInt32 i = 0; i < count; ++i) {
+        stringKeys.insert({ classNames[i % 5] + "_" + names[i], i });
+    }
+
+    /// interned names, class id and name id packed in one key
+    std::unordered_map<std::string_view, UInt32> nameIDs;
+    FlatHashMap<UInt64, UInt32>                  resources;
+    FlatHashMap<int, UInt64>                     entries;
+    for (UInt32 i = 0; i < count; ++i) {
+        nameIDs.emplace(names[i], i + 1);
+        UInt64 key = (UInt64) (i % 5) << 32 | (i + 1);
+        resources.insert(key, i);
+        entries.insert((int) i, key);
+    }
+
+    const UInt32 rounds = 10;
+    UInt64       sum    = 0;
+    Timer        timer;
+    for (UInt32 round = 0; round < rounds; ++round) {
+        for (UInt32 i = 0; i < count; ++i) {
+            sum += stringKeys.find(classNames[i % 5] + "_" + names[i])->second;
+        }
+    }
+    float stringSeconds = timer.mark();
+
+    for (UInt32 round = 0; round < rounds; ++round) {
+        for (UInt32 i = 0; i < count; ++i) {
+            UInt32 nameID = nameIDs.find(names[i])->second;
+            sum += *resources.find((UInt64) (i % 5) << 32 | nameID);
+        }
+    }
+    float internedSeconds = timer.mark();
+
+    /// unloading a tenth, the old way scanned the map for the object
+    for (UInt32 i = 0; i < count; i += 10) {
+        for (auto it = stringKeys.begin(); it != stringKeys.end(); ++it) {
+            if (it->second == i) {
+                stringKeys.erase(it);
+                break;
+            }
+        }
+    }
+    float scanSeconds = timer.mark();
+
+    for (UInt32 i = 0; i < count; i += 10) {
+        UInt64 key = *entries.find((int) i);
+        resources.erase(key);
+        entries.erase((int) i);
+    }
+    float eraseSeconds = timer.mark();
+
+    EXPECT_EQ(resources.size(), count - count / 10);
+    EXPECT_EQ(stringKeys.size(), resources.size());
+    EXPECT_GT(sum, 0U);
+
+    RecordProperty("string_key_lookups_per_second", std::to_string((float) (rounds * count) / stringSeconds));
+    RecordProperty("interned_lookups_per_second", std::to_string((float) (rounds * count) / internedSeconds));
+    RecordProperty("scan_unloads_per_second", std::to_string((float) (count / 10) / scanSeconds));
+    RecordProperty("indexed_unloads_per_second", std::to_string((float) (count / 10) / eraseSeconds));
+    EXPECT_LT(internedSeconds, stringSeconds);
+    EXPECT_LT(eraseSeconds, scanSeconds);
+}
@@ -7,6 +7,7 @@
 #include "EditorPanel.hpp"
 
 #include <ojoie/Render/Texture2D.hpp>
+#include <ojoie/Render/Mesh/Mesh.hpp>
 #include <ojoie/Template/delegate.hpp>
 #include <filesystem>
 #include <optional>
@@ -43,6 +44,17 @@ class ProjectPanel : public Panel {
 
     std::vector<Collections> m_Collections;
 
+    /// applied to the files dropped into the panel
+    struct ImportSettings {
+        bool bStreamTextures = false;
+        /// vertex channels quantized on imported meshes
+        UInt32 meshCompressedChannels = kMeshCompressibleChannels;
+        /// pack skin weights into 8 bits
+        bool bCompressBoneWeights = true;
+    };
+
+    ImportSettings m_ImportSettings;
+
     bool dragAndDropUpdating = false;
 
     void ContextMenu();
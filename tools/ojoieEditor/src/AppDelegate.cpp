@@ -11,6 +11,8 @@
 #include <ojoie/Core/Screen.hpp>
 #include <ojoie/Render/QualitySettings.hpp>
 #include <ojoie/Render/Material.hpp>
+#include <ojoie/Render/Shader/ShaderCache.hpp>
+#include <ojoie/Render/Shader/ShaderIncludeCache.hpp>
 #include <ojoie/Core/Game.hpp>
 #include <ojoie/Camera/Camera.hpp>
 #include <ojoie/Input/InputManager.hpp>
@@ -107,6 +109,8 @@ void AppDelegate::applicationDidFinishLaunching(AN::Application *application) {
     SetProjectRoot(projectRoot.c_str());
     SetCurrentDirectory(projectRoot.c_str());
 
+    /// shaders recompiled by the editor reuse stages compiled in earlier sessions
+    GetShaderCache().setDirectory((std::filesystem::path(projectRoot) / "Library" / "ShaderCache").string());
 
     s_FileWatcher.onFileChange.bind([](const ChangeRecord &record) {
         Dispatch::async(Dispatch::Main, [record] {
@@ -137,6 +141,28 @@ void AppDelegate::applicationDidFinishLaunching(AN::Application *application) {
                             AN_LOG(Debug, "recompile shader fail");
                         }
                     }
+                } else if (path.extension() == ".hlsl" || path.extension() == ".hlsli" || path.extension() == ".cginc") {
+                    /// only shaders including the edited file recompile
+                    if (GetShaderIncludeCache().invalidate(record.path)) {
+                        for (Shader *shader : Object::FindObjectsOfType<Shader>()) {
+                            std::string scriptPath = shader->getTextAssetPath();
+                            if (scriptPath.empty() || !shader->dependsOnInclude(record.path)) continue;
+                            if (shader->setScript(scriptPath)) {
+                                shader->destroyGPUObject();
+                                shader->createGPUObject();
+                                AN_LOG(Debug, "recompile shader %s success", shader->getName().c_str());
+                                std::string assetPath = GetResourceManager().getResourcePath(shader);
+                                if (!assetPath.empty()) {
+                                    GetSerializeManager().SerializeObjectAtPath(shader, assetPath.c_str());
+                                }
+                            } else {
+                                ANAssert(shader->setScriptText(s_ErrorShaderCode));
+                                shader->destroyGPUObject();
+                                shader->createGPUObject();
+                                AN_LOG(Debug, "recompile shader %s fail", shader->getName().c_str());
+                            }
+                        }
+                    }
                 }
             }
         });
@@ -26,6 +26,8 @@
 #include <imgui_stdlib.h>
 
 #include <ojoie/Asset/FBXImporter.hpp>
+#include <ojoie/Animation/Animator.hpp>
+#include <ojoie/Asset/MeshOptimizer.hpp>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -167,6 +169,22 @@ void ProjectPanel::ContextMenu() {
             ImGui::EndMenu();
         }
 
+        if (ImGui::BeginMenu("Import Settings")) {
+            ImGui::MenuItem("Stream Textures", 0, &m_ImportSettings.bStreamTextures);
+            if (ImGui::BeginMenu("Mesh Compression")) {
+                UInt32 &channels = m_ImportSettings.meshCompressedChannels;
+                ImGui::CheckboxFlags("Position", &channels, VERTEX_FORMAT1(Vertex));
+                ImGui::CheckboxFlags("Normal", &channels, VERTEX_FORMAT1(Normal));
+                ImGui::CheckboxFlags("Tangent", &channels, VERTEX_FORMAT1(Tangent));
+                ImGui::CheckboxFlags("UV0", &channels, VERTEX_FORMAT1(TexCoord0));
+                ImGui::CheckboxFlags("UV1", &channels, VERTEX_FORMAT1(TexCoord1));
+                ImGui::Separator();
+                ImGui::MenuItem("Bone Weights", 0, &m_ImportSettings.bCompressBoneWeights);
+                ImGui::EndMenu();
+            }
+            ImGui::EndMenu();
+        }
+
         if (ImGui::MenuItem("Show in Explorer", 0, false, !mCurrentDirectory.empty())) {
             ShellExecuteW(NULL, L"open", mCurrentDirectory.c_str(), NULL, NULL, SW_SHOWDEFAULT);
         }
@@ -775,11 +793,18 @@ void ProjectPanel::onGUI() {
                             auto meshes = importer.getImportMeshes();
 
                             ANAssert(meshes.size() > 0);
-                            const ImportMesh &importMesh = meshes[0];
+                            ImportMesh importMesh = meshes[0];
+
+                            MeshOptimizationStats optimizationStats = OptimizeImportMesh(importMesh);
+                            AN_LOG(Debug, "Optimize mesh ACMR %.3f -> %.3f, ATVR %.3f -> %.3f in %.2fms",
+                                   optimizationStats.before.acmr, optimizationStats.after.acmr,
+                                   optimizationStats.before.atvr, optimizationStats.after.atvr,
+                                   optimizationStats.optimizeMs);
 
                             Mesh *mesh = NewObject<Mesh>();
                             mesh->init();
                             mesh->setName(path.stem().string().c_str());
+                            mesh->setIndexFormat(importMesh.indexFormat);
 
                             if (!importMesh.bones.empty() && !importMesh.boneWeights.empty())
                             {
@@ -894,6 +919,12 @@ void ProjectPanel::onGUI() {
                                 armature->getTransform()->setLocalRotation(importMesh.rootBone.localRotation);
                             }
 
+                            mesh->setVertexCompression(m_ImportSettings.meshCompressedChannels);
+                            mesh->setBoneWeightsCompressed(m_ImportSettings.bCompressBoneWeights);
+
+                            /// static meshes only need their gpu copy, skinned meshes are skinned on the cpu
+                            mesh->setReadable(!importMesh.bones.empty());
+
                             std::filesystem::path assetPath(mCurrentDirectory);
                             assetPath.append(path.filename().string());
                             assetPath.replace_extension("asset");
@@ -901,6 +932,34 @@ void ProjectPanel::onGUI() {
                             GetResourceManager().resetResourcePath(mesh, assetPath.string().c_str());
                             mesh->createVertexBuffer();
 
+                            /// clips are key reduced and saved next to the mesh, the prefab plays the first one
+                            if (importer.importAnimation(nullptr))
+                            {
+                                Animator *animator = nullptr;
+                                for (const ImportAnimation &importAnimation : importer.getImportAnimations())
+                                {
+                                    AnimationClip *clip = NewObject<AnimationClip>();
+                                    if (!clip->initWithImportAnimation(importAnimation))
+                                    {
+                                        DestroyObject(clip);
+                                        continue;
+                                    }
+                                    AN_LOG(Debug, "Import animation %s %u frames, %u keys after reduction",
+                                           importAnimation.name.c_str(), importAnimation.frameCount, clip->getKeyCount());
+
+                                    std::filesystem::path clipPath(mCurrentDirectory);
+                                    clipPath.append(std::format("{}_{}.asset", path.stem().string(), importAnimation.name));
+                                    GetSerializeManager().SerializeObjectAtPath(clip, clipPath.string().c_str());
+                                    GetResourceManager().resetResourcePath(clip, clipPath.string().c_str());
+
+                                    if (model != nullptr && animator == nullptr)
+                                    {
+                                        animator = model->addComponent<Animator>();
+                                        animator->setClip(clip);
+                                    }
+                                }
+                            }
+
                             if (model != nullptr)
                             {
                                 assetPath.replace_extension("prefab");
@@ -911,7 +970,12 @@ void ProjectPanel::onGUI() {
                 }
             }
             else {
-                auto result = TextureLoader::LoadTexture(path.string().c_str(), true);
+                /// normal maps are found by name, they stay linear and keep unit length through compression
+                std::string stem = path.stem().string();
+                std::transform(stem.begin(), stem.end(), stem.begin(), [](unsigned char c) { return (char) std::tolower(c); });
+                bool bNormalMap = stem.find("normal") != std::string::npos;
+
+                auto result = TextureLoader::LoadTexture(path.string().c_str(), !bNormalMap);
                 if (result.isValid()) {
                     Texture2D *texture = NewObject<Texture2D>();
                     TextureDescriptor textureDescriptor;
@@ -924,6 +988,14 @@ void ProjectPanel::onGUI() {
                     texture->setPixelData(result.getData());
                     texture->setName(path.stem().string().c_str());
 
+                    TextureCompressionSettings compressionSettings;
+                    compressionSettings.bNormalMap = bNormalMap;
+                    compressionSettings.format = SelectCompressedPixelFormat(result.getData(), result.getWidth(), result.getHeight(),
+                                                                             result.getPixelFormat(), bNormalMap,
+                                                                             compressionSettings.quality);
+                    texture->compress(compressionSettings);
+                    texture->setStreaming(m_ImportSettings.bStreamTextures);
+
                     std::filesystem::path assetPath(mCurrentDirectory);
                     assetPath.append(path.filename().string());
                     assetPath.replace_extension("asset");
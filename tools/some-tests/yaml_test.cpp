@@ -190,6 +190,7 @@ void encoderObject() {
 
     ObjectPtr<Mesh> mesh = MakeObjectPtr<Mesh>();
     mesh->init();
+    mesh->setIndexFormat(importMesh.indexFormat);
     mesh->resizeVertices(importMesh.positions.size(), kShaderChannelVertex | kShaderChannelTexCoord0 |
                                                               kShaderChannelNormal | kShaderChannelTangent);
 
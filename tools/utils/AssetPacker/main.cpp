@@ -0,0 +1,98 @@
+//
+// Created by aojoie on 10/19/2026.
+//
+
+#include <ojoie/Misc/AssetArchive.hpp>
+#include <ojoie/Utility/Timer.hpp>
+
+#include <argparse/argparse.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace AN;
+using std::cout, std::endl;
+
+/// pack the files under the inputs into one archive, run from the directory the game runs in:
+/// AssetPacker Data -o Data.anpak
+int main(int argc, const char *argv[]) {
+    argparse::ArgumentParser program("AssetPacker");
+
+    program.add_argument("inputs")
+            .help("directories or files to pack, entries are named by their path relative to --root")
+            .nargs(argparse::nargs_pattern::at_least_one);
+
+    program.add_argument("-o", "--output")
+            .help("archive to write")
+            .default_value(std::string("Data.anpak"));
+
+    program.add_argument("--root")
+            .help("directory the game runs in, the current directory by default")
+            .default_value(std::string("."));
+
+    program.add_argument("--store")
+            .help("extensions stored uncompressed so they are read in place, like .bytes")
+            .nargs(argparse::nargs_pattern::any)
+            .default_value(std::vector<std::string>());
+
+    program.add_argument("--block-size")
+            .help("bytes compressed together, a reader decodes whole blocks")
+            .default_value((int) kAssetArchiveBlockSize)
+            .scan<'i', int>();
+
+    try {
+        program.parse_args(argc, argv);
+    } catch (const std::runtime_error &err) {
+        std::cerr << err.what() << endl << program;
+        return -1;
+    }
+
+    std::filesystem::path    root   = program.get<std::string>("--root");
+    std::vector<std::string> stored = program.get<std::vector<std::string>>("--store");
+    AssetArchiveWriter       writer((UInt32) program.get<int>("--block-size"));
+
+    auto addFile = [&](const std::filesystem::path &path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Open file " << path.string() << " error" << endl;
+            return false;
+        }
+        std::vector<UInt8> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        bool bCompress = std::find(stored.begin(), stored.end(), path.extension().string()) == stored.end();
+        writer.add(std::filesystem::relative(path, root).generic_string(), std::move(data), bCompress);
+        return true;
+    };
+
+    Timer  timer;
+    UInt64 inputSize = 0;
+    for (const std::string &input : program.get<std::vector<std::string>>("inputs")) {
+        std::error_code error;
+        if (std::filesystem::is_regular_file(input, error)) {
+            if (!addFile(input)) return -1;
+            inputSize += std::filesystem::file_size(input, error);
+            continue;
+        }
+        for (const auto &entry : std::filesystem::recursive_directory_iterator{ input, error }) {
+            if (!entry.is_regular_file()) continue;
+            if (!addFile(entry.path())) return -1;
+            inputSize += entry.file_size();
+        }
+        if (error) {
+            std::cerr << "Read directory " << input << " error: " << error.message() << endl;
+            return -1;
+        }
+    }
+
+    std::string output = program.get<std::string>("--output");
+    UInt64      archiveSize;
+    if (!writer.write(output.c_str(), &archiveSize)) {
+        std::cerr << "Write archive " << output << " error" << endl;
+        return -1;
+    }
+
+    cout << "Packed " << writer.getEntryCount() << " files, " << inputSize << " bytes into " << output << ", "
+         << archiveSize << " bytes in " << timer.mark() << "s" << endl;
+    return 0;
+}
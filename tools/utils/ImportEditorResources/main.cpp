@@ -7,6 +7,7 @@
 #include <ojoie/Serialize/Coder/YamlDecoder.hpp>
 #include <ojoie/Serialize/SerializeDefines.h>
 #include <ojoie/Asset/FBXImporter.hpp>
+#include <ojoie/Asset/MeshOptimizer.hpp>
 #include <ojoie/Render/Mesh/Mesh.hpp>
 
 #include <ojoie/Render/TextureCube.hpp>
@@ -106,10 +107,12 @@ void encoderObject() {
     auto meshes = importer.getImportMeshes();
 
     ANAssert(meshes.size() > 0);
-    const ImportMesh &importMesh = meshes[0];
+    ImportMesh importMesh = meshes[0];
+    OptimizeImportMesh(importMesh);
 
     ObjectPtr<Mesh> mesh = MakeObjectPtr<Mesh>();
     mesh->init();
+    mesh->setIndexFormat(importMesh.indexFormat);
     mesh->resizeVertices(importMesh.positions.size(), kShaderChannelVertex | kShaderChannelTexCoord0 |
                                                               kShaderChannelNormal | kShaderChannelTangent);
 
@@ -122,6 +125,7 @@ void encoderObject() {
     for (int i = 0; i < importMesh.subMeshes.size(); ++i) {
         mesh->setIndices(importMesh.subMeshes[i].indices.data(), importMesh.subMeshes[i].indices.size(), i);
     }
+    mesh->setVertexCompression(kMeshCompressibleChannels);
 
     File file;
     file.Open("Data/Assets/BusterDrone.asset", AN::kFilePermissionWrite);
@@ -5,11 +5,14 @@
 #include <iostream>
 
 #include <ojoie/Render/Shader/Shader.hpp>
+#include <ojoie/Render/Shader/ShaderCache.hpp>
+#include <ojoie/Render/Shader/ShaderIncludeCache.hpp>
 #include <ojoie/Render/RenderContext.hpp>
 #include <ojoie/Core/Configuration.hpp>
 #include <ojoie/Render/RenderTypes.hpp>
 #include <ojoie/Serialize/Coder/YamlEncoder.hpp>
 #include <ojoie/IO/FileOutputStream.hpp>
+#include <ojoie/Utility/Timer.hpp>
 
 #include <format>
 #include <filesystem>
@@ -26,6 +29,12 @@ int main() {
 
     const char *rootPath = AN_SHADER_ROOT;
 
+    /// a second run only compiles shaders whose expanded source changed
+    GetShaderCache().setDirectory("Library/ShaderCache");
+
+    Timer timer;
+    int shaderCount = 0;
+
     for (auto const& entry : std::filesystem::recursive_directory_iterator{ rootPath }) {
         if (entry.is_directory() || entry.path().extension() != ".shader") continue;
 
@@ -43,9 +52,18 @@ int main() {
         yamlEncoder.outputToStream(fileOutputStream);
 
         DestroyObject(shader);
-
+        ++shaderCount;
     }
 
+    ShaderCacheStats stats = GetShaderCache().getStats();
+    cout << std::format("compiled {} shaders in {:.1f} ms, cache hits {} misses {}, cache size {} KB",
+                        shaderCount, timer.mark() * 1000.f, stats.hits, stats.misses, stats.size >> 10)
+         << endl;
+    ShaderIncludeCacheStats includeStats = GetShaderIncludeCache().getStats();
+    cout << std::format("include files read {}, expanded {}, expanded includes reused {}",
+                        includeStats.fileLoads, includeStats.expansions, includeStats.expandedHits)
+         << endl;
+
     DeallocRenderContext();
 
 